@@ -0,0 +1,40 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "brave/components/omnibox/browser/topsites_provider.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/browser_window.h"
+#include "chrome/browser/ui/location_bar/location_bar.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "components/omnibox/browser/omnibox_view.h"
+
+using BraveAutocompleteBrowserTest = InProcessBrowserTest;
+
+IN_PROC_BROWSER_TEST_F(BraveAutocompleteBrowserTest,
+                       BraveProvidersRecordTime) {
+  base::HistogramTester histogram_tester;
+  OmniboxView* omnibox =
+      browser()->window()->GetLocationBar()->GetOmniboxView();
+
+  // Type the query one keystroke at a time, as the provider runs for each.
+  const std::string query = "brave.c";
+  for (size_t length = 1; length <= query.length(); ++length) {
+    omnibox->SetUserText(base::ASCIIToUTF16(query.substr(0, length)));
+    ui_test_utils::WaitForAutocompleteDone(browser());
+  }
+
+  // Timings vary with the machine, only that they are recorded is checked.
+  size_t sample_count = 0;
+  for (const auto& bucket : histogram_tester.GetAllSamples(
+           TopSitesProvider::kProviderTimeHistogram)) {
+    sample_count += bucket.count;
+  }
+  EXPECT_GE(sample_count, query.length());
+}
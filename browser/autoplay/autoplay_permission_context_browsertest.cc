@@ -24,6 +24,7 @@
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/test/browser_test_utils.h"
+#include "content/public/test/test_utils.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_types.h"
@@ -228,6 +229,8 @@ class AutoplayWhitelistServiceTest : public ExtensionBrowserTest {
   }
 
   void WaitForAutoplayWhitelistServiceThread() {
+    // Local data files load in the thread pool, replying to this thread.
+    content::RunAllTasksUntilIdle();
     scoped_refptr<base::ThreadTestHelper> io_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
     ASSERT_TRUE(io_helper->Run());
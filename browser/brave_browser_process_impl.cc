@@ -9,8 +9,10 @@
 
 #include "base/bind.h"
 #include "base/path_service.h"
+#include "base/rand_util.h"
 #include "base/task/post_task.h"
 #include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_stats_updater.h"
 #include "brave/browser/component_updater/brave_component_updater_configurator.h"
 #include "brave/browser/component_updater/brave_component_updater_delegate.h"
@@ -24,6 +26,7 @@
 #include "brave/components/brave_shields/browser/extension_whitelist_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
 #include "brave/components/brave_shields/browser/referrer_whitelist_service.h"
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "chrome/browser/io_thread.h"
 #include "chrome/common/chrome_paths.h"
@@ -46,6 +49,15 @@
 
 BraveBrowserProcessImpl* g_brave_browser_process = nullptr;
 
+namespace {
+
+// Background pings start at a random point in this window once startup is
+// done, so that restarts across many installs don't cluster.
+constexpr base::TimeDelta kBackgroundPingsMaxJitter =
+    base::TimeDelta::FromSeconds(30);
+
+}  // namespace
+
 using content::BrowserThread;
 
 BraveBrowserProcessImpl::~BraveBrowserProcessImpl() {}
@@ -57,23 +69,34 @@ BraveBrowserProcessImpl::BraveBrowserProcessImpl(StartupData* startup_data)
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
   brave_referrals_service_ = brave::BraveReferralsServiceFactory(local_state());
+#endif
+  brave_stats_updater_ = brave::BraveStatsUpdaterFactory(local_state());
+
+  // The deferred shields lists also start after startup, so the pings
+  // don't compete with them or with session restore for the network.
+  BrowserThread::PostAfterStartupTask(
+      FROM_HERE, base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(&BraveBrowserProcessImpl::ScheduleBackgroundPings,
+                     base::Unretained(this)));
+}
+
+void BraveBrowserProcessImpl::ScheduleBackgroundPings() {
   base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
       FROM_HERE,
-      base::BindOnce(
-          [](brave::BraveReferralsService* referrals_service) {
-            referrals_service->Start();
-          },
-          base::Unretained(brave_referrals_service_.get())),
-      base::TimeDelta::FromSeconds(3));
-#endif
+      base::BindOnce(&BraveBrowserProcessImpl::StartBackgroundPings,
+                     base::Unretained(this)),
+      base::TimeDelta::FromMilliseconds(
+          base::RandInt(0, kBackgroundPingsMaxJitter.InMilliseconds())));
+}
 
-  brave_stats_updater_ = brave::BraveStatsUpdaterFactory(local_state());
-  base::SequencedTaskRunnerHandle::Get()->PostTask(
-      FROM_HERE, base::BindOnce(
-                     [](brave::BraveStatsUpdater* stats_updater) {
-                       stats_updater->Start();
-                     },
-                     base::Unretained(brave_stats_updater_.get())));
+void BraveBrowserProcessImpl::StartBackgroundPings() {
+  TRACE_EVENT0("browser", "BraveBrowserProcessImpl::StartBackgroundPings");
+  // The stats updater waits for the referrals service to check for a promo
+  // code before its first ping.
+#if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
+  brave_referrals_service_->Start();
+#endif
+  brave_stats_updater_->Start();
 }
 
 brave_component_updater::BraveComponent::Delegate*
@@ -116,21 +139,50 @@ BraveBrowserProcessImpl::component_updater() {
 
 void BraveBrowserProcessImpl::ResourceDispatcherHostCreated() {
   BrowserProcessImpl::ResourceDispatcherHostCreated();
-  ad_block_service()->Start();
-  ad_block_custom_filters_service()->Start();
-  ad_block_regional_service_manager()->Start();
-  https_everywhere_service()->Start();
 
+  // Every service is created now because the IO thread reaches them through
+  // g_brave_browser_process. Only loading their data is staged.
+  ad_block_service();
+  ad_block_custom_filters_service();
+  ad_block_regional_service_manager();
+  https_everywhere_service();
   autoplay_whitelist_service();
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   extension_whitelist_service();
 #endif
   referrer_whitelist_service();
   tracking_protection_service();
-  // Now start the local data files service, which calls all observers.
+  shields_request_matcher();
+
+  StartShieldsServices();
+  BrowserThread::PostAfterStartupTask(
+      FROM_HERE, base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(&BraveBrowserProcessImpl::StartDeferredShieldsServices,
+                     base::Unretained(this)));
+}
+
+void BraveBrowserProcessImpl::StartShieldsServices() {
+  TRACE_EVENT0("browser", "BraveBrowserProcessImpl::StartShieldsServices");
+  // The default ad block list and tracking protection block the most
+  // requests, so they start loading before the first navigation. So do
+  // custom filters and HTTPS Everywhere, as requests from a restored session
+  // made before they load would skip the user's own rules and upgrades.
+  ad_block_service()->Start();
+  ad_block_custom_filters_service()->Start();
+  https_everywhere_service()->Start();
+  // Starts the local data files service, which calls all observers. Besides
+  // tracking protection these are the whitelists, which share its component.
   local_data_files_service()->Start();
 }
 
+void BraveBrowserProcessImpl::StartDeferredShieldsServices() {
+  TRACE_EVENT0("browser",
+               "BraveBrowserProcessImpl::StartDeferredShieldsServices");
+  // Loaded once startup is done, so their lists don't compete with session
+  // restore and the first paint.
+  ad_block_regional_service_manager()->Start();
+}
+
 ProfileManager* BraveBrowserProcessImpl::profile_manager() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   if (!created_profile_manager_)
@@ -217,6 +269,18 @@ BraveBrowserProcessImpl::https_everywhere_service() {
   return https_everywhere_service_.get();
 }
 
+brave_shields::ShieldsRequestMatcher*
+BraveBrowserProcessImpl::shields_request_matcher() {
+  if (!shields_request_matcher_)
+    shields_request_matcher_ =
+        std::make_unique<brave_shields::ShieldsRequestMatcher>(
+            ad_block_service(),
+            ad_block_regional_service_manager(),
+            ad_block_custom_filters_service(),
+            tracking_protection_service());
+  return shields_request_matcher_.get();
+}
+
 brave_component_updater::LocalDataFilesService*
 BraveBrowserProcessImpl::local_data_files_service() {
   if (!local_data_files_service_)
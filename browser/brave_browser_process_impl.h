@@ -36,6 +36,7 @@ class AutoplayWhitelistService;
 class ExtensionWhitelistService;
 class HTTPSEverywhereService;
 class ReferrerWhitelistService;
+class ShieldsRequestMatcher;
 class TrackingProtectionService;
 }  // namespace brave_shields
 
@@ -67,6 +68,7 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
   brave_shields::ReferrerWhitelistService* referrer_whitelist_service();
   brave_shields::TrackingProtectionService* tracking_protection_service();
   brave_shields::HTTPSEverywhereService* https_everywhere_service();
+  brave_shields::ShieldsRequestMatcher* shields_request_matcher();
   brave_component_updater::LocalDataFilesService* local_data_files_service();
 #if BUILDFLAG(ENABLE_TOR)
   extensions::BraveTorClientUpdater* tor_client_updater();
@@ -78,6 +80,14 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
  private:
   void CreateProfileManager();
 
+  // Shields data is loaded in two stages. The second one runs after startup.
+  void StartShieldsServices();
+  void StartDeferredShieldsServices();
+
+  // The referrals service and stats updater start after startup, with jitter.
+  void ScheduleBackgroundPings();
+  void StartBackgroundPings();
+
   BraveComponent::Delegate* brave_component_updater_delegate();
 
   std::unique_ptr<BraveComponent::Delegate> brave_component_updater_delegate_;
@@ -96,6 +106,8 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
       tracking_protection_service_;
   std::unique_ptr<brave_shields::HTTPSEverywhereService>
       https_everywhere_service_;
+  std::unique_ptr<brave_shields::ShieldsRequestMatcher>
+      shields_request_matcher_;
   std::unique_ptr<brave_component_updater::LocalDataFilesService>
       local_data_files_service_;
   std::unique_ptr<brave::BraveStatsUpdater> brave_stats_updater_;
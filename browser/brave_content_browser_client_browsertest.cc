@@ -8,6 +8,7 @@
 #include "base/path_service.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/browser/brave_content_browser_client.h"
+#include "brave/browser/extensions/brave_component_loader.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/brave_switches.h"
 #include "brave/common/extensions/extension_constants.h"
@@ -63,6 +64,12 @@ class BraveContentBrowserClientTest : public InProcessBrowserTest {
 
     ASSERT_TRUE(embedded_test_server()->Start());
 
+    // WebTorrent is only added once startup completes, which the tests
+    // don't wait for.
+    static_cast<extensions::BraveComponentLoader*>(
+        extensions::ExtensionSystem::Get(browser()->profile())->
+            extension_service()->component_loader())->AddWebTorrentExtension();
+
     magnet_html_url_ = embedded_test_server()->GetURL("a.com", "/magnet.html");
     magnet_url_ = GURL(
         "magnet:?xt=urn:btih:dd8255ecdc7ca55fb0bbf81323d87062db1f6d1c&dn=Big+"
@@ -5,11 +5,16 @@
 
 #include "brave/browser/brave_tab_helpers.h"
 
+#include "base/macros.h"
 #include "brave/browser/brave_drm_tab_helper.h"
 #include "brave/components/brave_ads/browser/ads_tab_helper.h"
 #include "brave/components/brave_rewards/browser/buildflags/buildflags.h"
 #include "brave/components/brave_shields/browser/buildflags/buildflags.h"  // For STP
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_user_data.h"
 
 #if !defined(OS_ANDROID)
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
@@ -26,7 +31,9 @@ using brave_shields::TrackingProtectionHelper;
 
 namespace brave {
 
-void AttachTabHelpers(content::WebContents* web_contents) {
+namespace {
+
+void AttachTabHelpersNow(content::WebContents* web_contents) {
 #if !defined(OS_ANDROID)
   brave_shields::BraveShieldsWebContentsObserver::CreateForWebContents(
       web_contents);
@@ -45,4 +52,61 @@ void AttachTabHelpers(content::WebContents* web_contents) {
   brave_ads::AdsTabHelper::CreateForWebContents(web_contents);
 }
 
+// Holds off the Brave tab helpers for a tab that has no document yet, such as
+// a lazily restored or discarded tab, until its renderer starts, it navigates
+// or it is shown. Observers added while a notification is being dispatched
+// still receive it, so the helpers see the event that attached them.
+class DeferredTabHelpers
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<DeferredTabHelpers> {
+ public:
+  ~DeferredTabHelpers() override {}
+
+ private:
+  friend class content::WebContentsUserData<DeferredTabHelpers>;
+
+  explicit DeferredTabHelpers(content::WebContents* web_contents)
+      : WebContentsObserver(web_contents) {}
+
+  // content::WebContentsObserver overrides.
+  void RenderFrameCreated(content::RenderFrameHost* host) override {
+    Attach();
+  }
+
+  void DidStartNavigation(
+      content::NavigationHandle* navigation_handle) override {
+    Attach();
+  }
+
+  void OnVisibilityChanged(content::Visibility visibility) override {
+    if (visibility == content::Visibility::VISIBLE)
+      Attach();
+  }
+
+  void Attach() {
+    content::WebContents* contents = web_contents();
+    // Deletes |this|.
+    contents->RemoveUserData(UserDataKey());
+    AttachTabHelpersNow(contents);
+  }
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+
+  DISALLOW_COPY_AND_ASSIGN(DeferredTabHelpers);
+};
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(DeferredTabHelpers)
+
+}  // namespace
+
+void AttachTabHelpers(content::WebContents* web_contents) {
+  if (!web_contents->GetMainFrame()->IsRenderFrameLive() &&
+      web_contents->GetVisibility() != content::Visibility::VISIBLE) {
+    DeferredTabHelpers::CreateForWebContents(web_contents);
+    return;
+  }
+
+  AttachTabHelpersNow(web_contents);
+}
+
 }  // namespace brave
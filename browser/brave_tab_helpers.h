@@ -11,6 +11,8 @@ class WebContents;
 
 namespace brave {
 
+// Tabs that are hidden and have no document yet, like lazily restored or
+// discarded ones, get their helpers when they first navigate or are shown.
 void AttachTabHelpers(content::WebContents* web_contents);
 
 }  // namespace brave
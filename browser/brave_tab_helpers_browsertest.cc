@@ -0,0 +1,129 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <vector>
+
+#include "base/time/time.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/browser_tabrestore.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "components/sessions/core/serialized_navigation_entry.h"
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+
+using brave_shields::BraveShieldsWebContentsObserver;
+
+namespace {
+
+bool HasTabHelpers(content::WebContents* contents) {
+  return BraveShieldsWebContentsObserver::FromWebContents(contents) != nullptr;
+}
+
+// Records whether the Brave tab helpers were there when the tab's main frame
+// was created and when it started navigating.
+class TabHelpersRecorder : public content::WebContentsObserver {
+ public:
+  explicit TabHelpersRecorder(content::WebContents* contents)
+      : WebContentsObserver(contents) {}
+
+  void RenderFrameCreated(content::RenderFrameHost* host) override {
+    if (host->GetParent())
+      return;
+    render_frame_created_ = true;
+    helpers_at_render_frame_created_ = HasTabHelpers(web_contents());
+  }
+
+  void DidStartNavigation(
+      content::NavigationHandle* navigation_handle) override {
+    if (!navigation_handle->IsInMainFrame())
+      return;
+    navigation_started_ = true;
+    helpers_at_navigation_start_ = HasTabHelpers(web_contents());
+  }
+
+  bool render_frame_created_ = false;
+  bool helpers_at_render_frame_created_ = false;
+  bool navigation_started_ = false;
+  bool helpers_at_navigation_start_ = false;
+};
+
+}  // namespace
+
+class BraveTabHelpersBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    ASSERT_TRUE(embedded_test_server()->Start());
+  }
+
+  // Adds a background tab the way session restore does, without loading it.
+  content::WebContents* AddUnloadedTab() {
+    const GURL url = embedded_test_server()->GetURL("/title1.html");
+    sessions::SerializedNavigationEntry entry;
+    entry.set_virtual_url(url);
+    entry.set_original_request_url(url);
+    entry.set_is_restored(true);
+    std::vector<sessions::SerializedNavigationEntry> navigations = { entry };
+
+    content::WebContents* contents = chrome::AddRestoredTab(
+        browser(), navigations, browser()->tab_strip_model()->count(), 0,
+        "", false, false, true,
+        base::TimeTicks::UnixEpoch(), nullptr,
+        "", true /* from_session_restore */);
+    EXPECT_FALSE(contents->GetMainFrame()->IsRenderFrameLive());
+    EXPECT_NE(contents->GetVisibility(), content::Visibility::VISIBLE);
+    return contents;
+  }
+};
+
+IN_PROC_BROWSER_TEST_F(BraveTabHelpersBrowserTest, ActiveTabHasHelpers) {
+  EXPECT_TRUE(HasTabHelpers(
+      browser()->tab_strip_model()->GetActiveWebContents()));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveTabHelpersBrowserTest,
+                       UnloadedTabGetsHelpersOnNavigation) {
+  content::WebContents* contents = AddUnloadedTab();
+  EXPECT_FALSE(HasTabHelpers(contents));
+
+  TabHelpersRecorder recorder(contents);
+  contents->GetController().LoadIfNecessary();
+  EXPECT_TRUE(content::WaitForLoadStop(contents));
+
+  EXPECT_TRUE(HasTabHelpers(contents));
+  ASSERT_TRUE(recorder.navigation_started_);
+  EXPECT_TRUE(recorder.helpers_at_navigation_start_);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveTabHelpersBrowserTest,
+                       UnloadedTabGetsHelpersOnRenderFrameCreated) {
+  content::WebContents* contents = AddUnloadedTab();
+  EXPECT_FALSE(HasTabHelpers(contents));
+
+  // Helpers that set up the renderer, like shields, need to see the frame
+  // that attached them being created.
+  TabHelpersRecorder recorder(contents);
+  contents->GetController().LoadIfNecessary();
+  EXPECT_TRUE(content::WaitForLoadStop(contents));
+
+  ASSERT_TRUE(recorder.render_frame_created_);
+  EXPECT_TRUE(recorder.helpers_at_render_frame_created_);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveTabHelpersBrowserTest,
+                       UnloadedTabGetsHelpersWhenShown) {
+  content::WebContents* contents = AddUnloadedTab();
+  EXPECT_FALSE(HasTabHelpers(contents));
+
+  contents->WasShown();
+
+  EXPECT_TRUE(HasTabHelpers(contents));
+}
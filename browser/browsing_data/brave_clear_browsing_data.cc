@@ -7,8 +7,12 @@
 
 #include <vector>
 
+#include "base/bind.h"
+#include "base/logging.h"
 #include "base/run_loop.h"
 #include "base/scoped_observer.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "base/trace_event/common/trace_event_common.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/browsing_data/chrome_browsing_data_remover_delegate.h"
@@ -26,6 +30,12 @@ namespace {
 
 using content::BraveClearBrowsingData;
 
+// Longest time shutdown waits for data to be cleared. Removal for every
+// profile runs concurrently, so this bounds the wait however many profiles
+// are loaded.
+constexpr base::TimeDelta kClearOnExitTimeout =
+    base::TimeDelta::FromSeconds(15);
+
 class BrowsingDataRemovalWatcher
     : public content::BrowsingDataRemover::Observer {
  public:
@@ -42,9 +52,11 @@ class BrowsingDataRemovalWatcher
                                           int* remove_mask,
                                           int* origin_mask);
   void Wait();
+  void OnTimeout();
 
   int num_profiles_to_clear_ = 0;
   base::RunLoop run_loop_;
+  base::OneShotTimer timeout_timer_;
   // Keep track of the set of BrowsingDataRemover instances this object has
   // attached itself to as an observer. When ScopedObserver is destroyed it
   // removes this object as an observer from all those instances.
@@ -119,7 +131,9 @@ bool BrowsingDataRemovalWatcher::GetClearBrowsingDataOnExitSettings(
 // its tasks it will reply back to us by calling the OnBrowsingDataRemoverDone
 // method below. When that happens we decrement the counter of profiles that
 // need to be cleared. Once the counter reaches 0 we exit the RunLoop and let
-// shutdown proceed.
+// shutdown proceed. The removals for all profiles are started before waiting,
+// so they run concurrently, and the wait is bounded by kClearOnExitTimeout so
+// a slow profile can't hang shutdown.
 void BrowsingDataRemovalWatcher::ClearBrowsingDataForLoadedProfiles(
     BraveClearBrowsingData::OnExitTestingCallback* testing_callback) {
   ProfileManager* profile_manager = g_browser_process->profile_manager();
@@ -149,8 +163,20 @@ void BrowsingDataRemovalWatcher::ClearBrowsingDataForLoadedProfiles(
 }
 
 void BrowsingDataRemovalWatcher::Wait() {
-  if (num_profiles_to_clear_ > 0)
-    run_loop_.Run();
+  if (num_profiles_to_clear_ <= 0)
+    return;
+
+  timeout_timer_.Start(FROM_HERE, kClearOnExitTimeout,
+                       base::BindOnce(&BrowsingDataRemovalWatcher::OnTimeout,
+                                      base::Unretained(this)));
+  run_loop_.Run();
+  timeout_timer_.Stop();
+}
+
+void BrowsingDataRemovalWatcher::OnTimeout() {
+  LOG(WARNING) << "Stopped waiting for browsing data to be cleared on exit, "
+               << num_profiles_to_clear_ << " profile(s) remaining.";
+  run_loop_.Quit();
 }
 
 void BrowsingDataRemovalWatcher::OnBrowsingDataRemoverDone() {
@@ -20,7 +20,8 @@ class BraveClearBrowsingData {
  public:
   // Clears browsing data for all loaded non-off-the-record profiles.
   // Profile's *OnExit preferences determine what gets cleared.
-  // Note: this method will wait until browsing data has been cleared.
+  // Note: this method will wait until browsing data has been cleared, or for a
+  // bounded time if that takes too long.
   static void ClearOnExit();
 
   // Used for testing only.
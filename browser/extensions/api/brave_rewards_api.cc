@@ -11,7 +11,10 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_rewards/tip_dialog.h"
 #include "brave/common/extensions/api/brave_rewards.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
@@ -31,6 +34,115 @@ using brave_rewards::RewardsServiceFactory;
 namespace extensions {
 namespace api {
 
+namespace {
+
+// The rewards panel reads the same handful of ledger values every time it
+// opens, so they are kept briefly per window to make reopening it cheap
+constexpr base::TimeDelta kPanelStateTTL = base::TimeDelta::FromSeconds(3);
+
+const char kPanelStateCacheKey[] = "brave_rewards_panel_state_cache";
+
+class PanelStateCache : public base::SupportsUserData::Data {
+ public:
+  PanelStateCache() {}
+  ~PanelStateCache() override {}
+
+  static PanelStateCache* FromProfile(Profile* profile) {
+    auto* cache = static_cast<PanelStateCache*>(
+        profile->GetUserData(kPanelStateCacheKey));
+    if (!cache) {
+      cache = new PanelStateCache();
+      profile->SetUserData(kPanelStateCacheKey, base::WrapUnique(cache));
+    }
+    return cache;
+  }
+
+  // Drops the cached state for every window, after the panel changes a
+  // value it holds
+  static void Invalidate(Profile* profile) {
+    auto* cache = static_cast<PanelStateCache*>(
+        profile->GetUserData(kPanelStateCacheKey));
+    if (cache)
+      cache->entries_.clear();
+  }
+
+  const base::Value* Get(int window_id) const {
+    auto it = entries_.find(window_id);
+    if (it == entries_.end() ||
+        base::TimeTicks::Now() - it->second.time > kPanelStateTTL) {
+      return nullptr;
+    }
+    return &it->second.state;
+  }
+
+  void Set(int window_id, const base::Value& state) {
+    const base::TimeTicks now = base::TimeTicks::Now();
+    // Entries for closed windows are never read again
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (now - it->second.time > kPanelStateTTL)
+        it = entries_.erase(it);
+      else
+        ++it;
+    }
+
+    Entry& entry = entries_[window_id];
+    entry.time = now;
+    entry.state = state.Clone();
+  }
+
+ private:
+  struct Entry {
+    base::TimeTicks time;
+    base::Value state;
+  };
+
+  std::map<int, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(PanelStateCache);
+};
+
+std::unique_ptr<base::DictionaryValue> GetRecurringTipsAsDictionary(
+    const ::brave_rewards::ContentSiteList& list) {
+  auto result = std::make_unique<base::DictionaryValue>();
+  auto recurringTips = std::make_unique<base::ListValue>();
+
+  for (auto const& item : list) {
+    auto tip = std::make_unique<base::DictionaryValue>();
+    tip->SetString("publisherKey", item.id);
+    tip->SetInteger("amount", item.weight);
+    recurringTips->Append(std::move(tip));
+  }
+
+  result->SetList("recurringTips", std::move(recurringTips));
+  return result;
+}
+
+std::unique_ptr<base::ListValue> GetNotificationsAsList(
+    RewardsService* rewards_service) {
+  auto list = std::make_unique<base::ListValue>();
+
+  auto notifications = rewards_service->GetAllNotifications();
+
+  for (auto const& notification : notifications) {
+    auto item = std::make_unique<base::DictionaryValue>();
+    item->SetString("id", notification.second.id_);
+    item->SetInteger("type", notification.second.type_);
+    item->SetInteger("timestamp", notification.second.timestamp_);
+
+    auto args = std::make_unique<base::ListValue>();
+    for (auto const& arg : notification.second.args_) {
+      args->AppendString(arg);
+    }
+
+    item->SetList("args", std::move(args));
+    list->Append(std::move(item));
+  }
+
+  return list;
+}
+
+}  // namespace
+
 BraveRewardsCreateWalletFunction::~BraveRewardsCreateWalletFunction() {
 }
 
@@ -39,6 +151,7 @@ ExtensionFunction::ResponseAction BraveRewardsCreateWalletFunction::Run() {
   auto* rewards_service = RewardsServiceFactory::GetForProfile(profile);
   if (rewards_service) {
     rewards_service->CreateWallet();
+    PanelStateCache::Invalidate(profile);
   }
   return RespondNow(NoArguments());
 }
@@ -209,6 +322,7 @@ BraveRewardsGetWalletPropertiesFunction::Run() {
   Profile* profile = Profile::FromBrowserContext(browser_context());
   auto* rewards_service = RewardsServiceFactory::GetForProfile(profile);
   if (rewards_service) {
+    rewards_service->WakeLedger();
     rewards_service->FetchWalletProperties();
   }
   return RespondNow(NoArguments());
@@ -221,6 +335,7 @@ ExtensionFunction::ResponseAction BraveRewardsGetCurrentReportFunction::Run() {
   Profile* profile = Profile::FromBrowserContext(browser_context());
   auto* rewards_service = RewardsServiceFactory::GetForProfile(profile);
   if (rewards_service) {
+    rewards_service->WakeLedger();
     rewards_service->GetCurrentBalanceReport();
   }
   return RespondNow(NoArguments());
@@ -234,6 +349,7 @@ ExtensionFunction::ResponseAction BraveRewardsGetGrantsFunction::Run() {
   RewardsService* rewards_service =
     RewardsServiceFactory::GetForProfile(profile);
   if (rewards_service) {
+    rewards_service->WakeLedger();
     rewards_service->FetchGrants(std::string(), std::string());
   }
   return RespondNow(NoArguments());
@@ -378,6 +494,7 @@ ExtensionFunction::ResponseAction BraveRewardsSaveSettingFunction::Run() {
       rewards_service->SetRewardsMainEnabled(
           std::stoi(params->value.c_str()));
     }
+    PanelStateCache::Invalidate(profile);
   }
 
   return RespondNow(NoArguments());
@@ -399,6 +516,7 @@ BraveRewardsSaveRecurringTipFunction::Run() {
   if (rewards_service_) {
     rewards_service_->SaveRecurringTip(params->publisher_key,
                                        params->new_amount);
+    PanelStateCache::Invalidate(profile);
   }
 
   return RespondNow(NoArguments());
@@ -419,6 +537,7 @@ BraveRewardsRemoveRecurringTipFunction::Run() {
 
   if (rewards_service_) {
     rewards_service_->RemoveRecurringTip(params->publisher_key);
+    PanelStateCache::Invalidate(profile);
   }
 
   return RespondNow(NoArguments());
@@ -446,20 +565,7 @@ BraveRewardsGetRecurringTipsFunction::Run() {
 
 void BraveRewardsGetRecurringTipsFunction::OnGetRecurringTips(
     std::unique_ptr<::brave_rewards::ContentSiteList> list) {
-  std::unique_ptr<base::DictionaryValue> result(new base::DictionaryValue());
-  auto recurringTips = std::make_unique<base::ListValue>();
-
-  if (!list->empty()) {
-    for (auto const& item : *list) {
-      auto tip = std::make_unique<base::DictionaryValue>();
-      tip->SetString("publisherKey", item.id);
-      tip->SetInteger("amount", item.weight);
-      recurringTips->Append(std::move(tip));
-    }
-  }
-
-  result->SetList("recurringTips", std::move(recurringTips));
-  Respond(OneArgument(std::move(result)));
+  Respond(OneArgument(GetRecurringTipsAsDictionary(*list)));
 }
 
 BraveRewardsGetPublisherBannerFunction::
@@ -556,30 +662,11 @@ BraveRewardsGetAllNotificationsFunction::Run() {
   RewardsService* rewards_service =
     RewardsServiceFactory::GetForProfile(profile);
 
-  auto list = std::make_unique<base::ListValue>();
-
   if (!rewards_service) {
-    return RespondNow(OneArgument(std::move(list)));
-  }
-
-  auto notifications = rewards_service->GetAllNotifications();
-
-  for (auto const& notification : notifications) {
-    auto item = std::make_unique<base::DictionaryValue>();
-    item->SetString("id", notification.second.id_);
-    item->SetInteger("type", notification.second.type_);
-    item->SetInteger("timestamp", notification.second.timestamp_);
-
-    auto args = std::make_unique<base::ListValue>();
-    for (auto const& arg : notification.second.args_) {
-      args->AppendString(arg);
-    }
-
-    item->SetList("args", std::move(args));
-    list->Append(std::move(item));
+    return RespondNow(OneArgument(std::make_unique<base::ListValue>()));
   }
 
-  return RespondNow(OneArgument(std::move(list)));
+  return RespondNow(OneArgument(GetNotificationsAsList(rewards_service)));
 }
 
 BraveRewardsGetInlineTipSettingFunction::
@@ -610,5 +697,113 @@ void BraveRewardsGetInlineTipSettingFunction::OnInlineTipSetting(bool value) {
   Respond(OneArgument(std::make_unique<base::Value>(value)));
 }
 
+BraveRewardsGetPanelStateFunction::BraveRewardsGetPanelStateFunction()
+    : window_id_(-1),
+      pending_requests_(0),
+      requesting_(false),
+      has_defaults_(false),
+      state_(base::Value::Type::DICTIONARY) {
+}
+
+BraveRewardsGetPanelStateFunction::~BraveRewardsGetPanelStateFunction() {
+}
+
+ExtensionFunction::ResponseAction BraveRewardsGetPanelStateFunction::Run() {
+  std::unique_ptr<brave_rewards::GetPanelState::Params> params(
+      brave_rewards::GetPanelState::Params::Create(*args_));
+  EXTENSION_FUNCTION_VALIDATE(params.get());
+  window_id_ = params->window_id;
+
+  Profile* profile = Profile::FromBrowserContext(browser_context());
+  RewardsService* rewards_service =
+    RewardsServiceFactory::GetForProfile(profile);
+
+  if (!rewards_service) {
+    return RespondNow(Error("Rewards service is not initialized"));
+  }
+
+  // Opening the panel is what brings a dormant ledger up
+  rewards_service->WakeLedger();
+
+  const base::Value* cached_state =
+      PanelStateCache::FromProfile(profile)->Get(window_id_);
+  if (cached_state) {
+    return RespondNow(OneArgument(CreateResult(*cached_state)));
+  }
+
+  // The ledger is queried for every value at once and the panel gets a
+  // single reply once all of them are back
+  pending_requests_ = 4;
+  requesting_ = true;
+  rewards_service->GetRewardsMainEnabled(base::Bind(
+        &BraveRewardsGetPanelStateFunction::OnGetRewardsMainEnabled,
+        this));
+  rewards_service->GetAutoContribute(base::BindOnce(
+        &BraveRewardsGetPanelStateFunction::OnGetACEnabled,
+        this));
+  rewards_service->GetPendingContributionsTotalUI(base::Bind(
+        &BraveRewardsGetPanelStateFunction::OnGetPendingTotal,
+        this));
+  rewards_service->GetRecurringTipsUI(base::BindOnce(
+        &BraveRewardsGetPanelStateFunction::OnGetRecurringTips,
+        this));
+  requesting_ = false;
+  return did_respond() ? AlreadyResponded() : RespondLater();
+}
+
+void BraveRewardsGetPanelStateFunction::OnGetRewardsMainEnabled(
+    bool enabled) {
+  state_.SetKey("enabledMain", base::Value(enabled));
+  OnStateReady();
+}
+
+void BraveRewardsGetPanelStateFunction::OnGetACEnabled(bool enabled) {
+  state_.SetKey("enabledAC", base::Value(enabled));
+  OnStateReady();
+}
+
+void BraveRewardsGetPanelStateFunction::OnGetPendingTotal(double amount) {
+  state_.SetKey("pendingContributionsTotal", base::Value(amount));
+  OnStateReady();
+}
+
+void BraveRewardsGetPanelStateFunction::OnGetRecurringTips(
+    std::unique_ptr<::brave_rewards::ContentSiteList> list) {
+  state_.SetKey("recurringTips",
+      base::Value::FromUniquePtrValue(GetRecurringTipsAsDictionary(*list)));
+  OnStateReady();
+}
+
+void BraveRewardsGetPanelStateFunction::OnStateReady() {
+  DCHECK_GT(pending_requests_, 0);
+  // The service answers straight away with default values while the ledger
+  // isn't connected, whereas the ledger always replies later
+  if (requesting_)
+    has_defaults_ = true;
+  if (--pending_requests_ > 0)
+    return;
+
+  if (!has_defaults_) {
+    Profile* profile = Profile::FromBrowserContext(browser_context());
+    PanelStateCache::FromProfile(profile)->Set(window_id_, state_);
+  }
+  Respond(OneArgument(CreateResult(state_)));
+}
+
+std::unique_ptr<base::Value> BraveRewardsGetPanelStateFunction::CreateResult(
+    const base::Value& state) {
+  Profile* profile = Profile::FromBrowserContext(browser_context());
+  RewardsService* rewards_service =
+    RewardsServiceFactory::GetForProfile(profile);
+
+  // Notifications are kept in memory by the service, so they are always
+  // read fresh rather than cached with the ledger values
+  auto result = base::Value::ToUniquePtrValue(state.Clone());
+  result->SetKey("notifications",
+      base::Value::FromUniquePtrValue(
+          GetNotificationsAsList(rewards_service)));
+  return result;
+}
+
 }  // namespace api
 }  // namespace extensions
@@ -10,6 +10,7 @@
 #include <string>
 
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "brave/components/brave_rewards/browser/content_site.h"
 #include "brave/components/brave_rewards/browser/publisher_banner.h"
 #include "extensions/browser/extension_function.h"
@@ -279,6 +280,34 @@ class BraveRewardsGetInlineTipSettingFunction :
   void OnInlineTipSetting(bool value);
 };
 
+class BraveRewardsGetPanelStateFunction : public UIThreadExtensionFunction {
+ public:
+  BraveRewardsGetPanelStateFunction();
+  DECLARE_EXTENSION_FUNCTION("braveRewards.getPanelState", UNKNOWN)
+
+ protected:
+  ~BraveRewardsGetPanelStateFunction() override;
+
+  ResponseAction Run() override;
+
+ private:
+  void OnGetRewardsMainEnabled(bool enabled);
+  void OnGetACEnabled(bool enabled);
+  void OnGetPendingTotal(double amount);
+  void OnGetRecurringTips(
+      std::unique_ptr<::brave_rewards::ContentSiteList> list);
+  void OnStateReady();
+  std::unique_ptr<base::Value> CreateResult(const base::Value& state);
+
+  int window_id_;
+  int pending_requests_;
+  // True while the values are being requested, and once any of them was
+  // answered without the ledger, in which case the state isn't cached
+  bool requesting_;
+  bool has_defaults_;
+  base::Value state_;
+};
+
 }  // namespace api
 }  // namespace extensions
 
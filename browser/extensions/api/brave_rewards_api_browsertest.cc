@@ -0,0 +1,96 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "base/values.h"
+#include "brave/browser/extensions/api/brave_rewards_api.h"
+#include "chrome/browser/extensions/extension_function_test_utils.h"
+#include "chrome/browser/extensions/extension_tab_util.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "extensions/browser/api_test_utils.h"
+#include "extensions/common/extension_builder.h"
+
+// npm run test -- brave_browser_tests --filter=BraveRewardsAPIBrowserTest.*
+
+namespace extensions {
+
+using api::BraveRewardsGetPanelStateFunction;
+using api::BraveRewardsSaveSettingFunction;
+using extension_function_test_utils::RunFunction;
+using extension_function_test_utils::RunFunctionAndReturnSingleResult;
+
+class BraveRewardsAPIBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+    extension_ = ExtensionBuilder("Test").Build();
+  }
+
+  std::unique_ptr<base::Value> GetPanelState() {
+    scoped_refptr<BraveRewardsGetPanelStateFunction> function(
+        new BraveRewardsGetPanelStateFunction());
+    function->set_extension(extension_.get());
+    function->set_has_callback(true);
+    const int window_id = ExtensionTabUtil::GetWindowId(browser());
+    return RunFunctionAndReturnSingleResult(
+        function.get(), "[" + std::to_string(window_id) + "]", browser());
+  }
+
+  void SaveSetting(const std::string& key, const std::string& value) {
+    scoped_refptr<BraveRewardsSaveSettingFunction> function(
+        new BraveRewardsSaveSettingFunction());
+    function->set_extension(extension_.get());
+    EXPECT_TRUE(RunFunction(function.get(),
+                            "[\"" + key + "\", \"" + value + "\"]",
+                            browser(),
+                            api_test_utils::NONE));
+  }
+
+ private:
+  scoped_refptr<const Extension> extension_;
+};
+
+IN_PROC_BROWSER_TEST_F(BraveRewardsAPIBrowserTest, GetPanelStateReturnsAll) {
+  std::unique_ptr<base::Value> state = GetPanelState();
+  ASSERT_TRUE(state);
+  ASSERT_TRUE(state->is_dict());
+  EXPECT_TRUE(state->FindKeyOfType("enabledMain", base::Value::Type::BOOLEAN));
+  EXPECT_TRUE(state->FindKeyOfType("enabledAC", base::Value::Type::BOOLEAN));
+  EXPECT_TRUE(state->FindKeyOfType("pendingContributionsTotal",
+                                   base::Value::Type::DOUBLE));
+  EXPECT_TRUE(state->FindKeyOfType("recurringTips",
+                                   base::Value::Type::DICTIONARY));
+  EXPECT_TRUE(state->FindKeyOfType("notifications",
+                                   base::Value::Type::LIST));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveRewardsAPIBrowserTest,
+                       SaveSettingInvalidatesPanelState) {
+  std::unique_ptr<base::Value> state = GetPanelState();
+  ASSERT_TRUE(state);
+  const base::Value* enabled = state->FindKey("enabledMain");
+  ASSERT_TRUE(enabled);
+  EXPECT_FALSE(enabled->GetBool());
+
+  // Read again well within the time the state is cached for
+  SaveSetting("enabledMain", "1");
+  state = GetPanelState();
+  ASSERT_TRUE(state);
+  enabled = state->FindKey("enabledMain");
+  ASSERT_TRUE(enabled);
+  EXPECT_TRUE(enabled->GetBool());
+
+  SaveSetting("enabledMain", "0");
+  state = GetPanelState();
+  ASSERT_TRUE(state);
+  enabled = state->FindKey("enabledMain");
+  ASSERT_TRUE(enabled);
+  EXPECT_FALSE(enabled->GetBool());
+}
+
+}  // namespace extensions
@@ -8,11 +8,14 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/strings/string_number_conversions.h"
 #include "brave/common/extensions/api/brave_shields.h"
 #include "brave/common/extensions/extension_constants.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/extensions/api/content_settings/content_settings_api_constants.h"
 #include "chrome/browser/extensions/api/content_settings/content_settings_helpers.h"
@@ -27,6 +30,7 @@
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "content/public/browser/web_contents.h"
 #include "extensions/browser/extension_util.h"
+#include "url/origin.h"
 
 using brave_shields::BraveShieldsWebContentsObserver;
 
@@ -50,6 +54,35 @@ bool RemoveContentType(base::ListValue* args,
   return *content_type != CONTENT_SETTINGS_TYPE_DEFAULT;
 }
 
+// The secondary URLs the shields panel uses to tell first party rules from
+// third party ones.
+const char kFingerprintingFirstPartyURL[] = "https://firstParty/*";
+const char kCookiesFirstPartyURL[] = "https://firstParty/";
+
+std::string GetShieldsSetting(HostContentSettingsMap* map,
+                              const GURL& primary_url,
+                              const GURL& secondary_url,
+                              const std::string& resource_identifier) {
+  return content_settings::ContentSettingToString(map->GetContentSetting(
+      primary_url, secondary_url, CONTENT_SETTINGS_TYPE_PLUGINS,
+      resource_identifier));
+}
+
+// Returns "block_third_party" when first party requests are treated
+// differently from third party ones.
+std::string GetThirdPartyShieldsSetting(HostContentSettingsMap* map,
+                                        const GURL& primary_url,
+                                        const GURL& first_party_url,
+                                        const std::string& resource_id) {
+  const std::string setting =
+      GetShieldsSetting(map, primary_url, primary_url, resource_id);
+  if (setting != GetShieldsSetting(map, primary_url, first_party_url,
+                                   resource_id)) {
+    return "block_third_party";
+  }
+  return setting;
+}
+
 }  // namespace
 
 namespace extensions {
@@ -77,11 +110,127 @@ ExtensionFunction::ResponseAction BraveShieldsAllowScriptsOnceFunction::Run() {
                             base::NumberToString(params->tab_id)));
   }
 
+  // Tabs that have not loaded yet get their observer when they navigate.
+  BraveShieldsWebContentsObserver::CreateForWebContents(contents);
   BraveShieldsWebContentsObserver::FromWebContents(
       contents)->AllowScriptsOnce(params->origins, contents);
   return RespondNow(NoArguments());
 }
 
+BraveShieldsGetShieldsStateFunction::~BraveShieldsGetShieldsStateFunction() {
+}
+
+ExtensionFunction::ResponseAction BraveShieldsGetShieldsStateFunction::Run() {
+  std::unique_ptr<brave_shields::GetShieldsState::Params> params(
+      brave_shields::GetShieldsState::Params::Create(*args_));
+  EXTENSION_FUNCTION_VALIDATE(params.get());
+
+  content::WebContents* contents = nullptr;
+  if (!ExtensionTabUtil::GetTabById(
+        params->tab_id,
+        Profile::FromBrowserContext(browser_context()),
+        include_incognito_information(),
+        nullptr,
+        nullptr,
+        &contents,
+        nullptr)) {
+    return RespondNow(Error(tabs_constants::kTabNotFoundError,
+                            base::NumberToString(params->tab_id)));
+  }
+
+  // The tab's own profile, so incognito tabs read their session settings.
+  HostContentSettingsMap* map = HostContentSettingsMapFactory::GetForProfile(
+      Profile::FromBrowserContext(contents->GetBrowserContext()));
+  const GURL& url = contents->GetLastCommittedURL();
+  const GURL origin = url.GetOrigin();
+
+  brave_shields::ShieldsState state;
+  state.id = params->tab_id;
+  state.url = url.spec();
+  state.origin = url::Origin::Create(url).Serialize();
+  state.hostname = url.host();
+  state.brave_shields = url.SchemeIsHTTPOrHTTPS() ?
+      GetShieldsSetting(map, origin, origin, ::brave_shields::kBraveShields) :
+      "block";
+  state.ads = GetShieldsSetting(map, origin, origin, ::brave_shields::kAds);
+  state.trackers =
+      GetShieldsSetting(map, origin, origin, ::brave_shields::kTrackers);
+  state.http_upgradable_resources = GetShieldsSetting(
+      map, origin, origin, ::brave_shields::kHTTPUpgradableResources);
+  state.javascript = content_settings::ContentSettingToString(
+      map->GetContentSetting(origin, origin, CONTENT_SETTINGS_TYPE_JAVASCRIPT,
+                             std::string()));
+  state.fingerprinting = GetThirdPartyShieldsSetting(
+      map, origin, GURL(kFingerprintingFirstPartyURL),
+      ::brave_shields::kFingerprinting);
+  state.cookies = GetThirdPartyShieldsSetting(
+      map, origin, GURL(kCookiesFirstPartyURL), ::brave_shields::kCookies);
+
+  state.blocked_counts.tab_id = params->tab_id;
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(contents);
+  if (observer) {
+    const BraveShieldsWebContentsObserver::BlockedCounts& counts =
+        observer->blocked_counts();
+    state.blocked_counts.ads = counts.ads;
+    state.blocked_counts.trackers = counts.trackers;
+    state.blocked_counts.https_upgrades = counts.https_upgrades;
+    state.blocked_counts.javascript = counts.javascript;
+    state.blocked_counts.fingerprinting = counts.fingerprinting;
+  }
+
+  return RespondNow(ArgumentList(
+      brave_shields::GetShieldsState::Results::Create(state)));
+}
+
+BraveShieldsSetContentSettingsFunction::
+    ~BraveShieldsSetContentSettingsFunction() {
+}
+
+ExtensionFunction::ResponseAction
+BraveShieldsSetContentSettingsFunction::Run() {
+  std::unique_ptr<brave_shields::SetContentSettings::Params> params(
+      brave_shields::SetContentSettings::Params::Create(*args_));
+  EXTENSION_FUNCTION_VALIDATE(params.get());
+
+  // Incognito profiles can't access regular mode ever, they only exist in
+  // split mode.
+  if (browser_context()->IsOffTheRecord())
+    return RespondNow(
+        Error(content_settings_api_constants::kIncognitoContextError));
+
+  std::vector<::brave_shields::ShieldsSettingRule> rules;
+  rules.reserve(params->rules.size());
+  for (const auto& rule : params->rules) {
+    ::brave_shields::ShieldsSettingRule shields_rule;
+    std::string error;
+    shields_rule.primary_pattern =
+        content_settings_helpers::ParseExtensionPattern(rule.primary_pattern,
+                                                        &error);
+    if (!shields_rule.primary_pattern.IsValid())
+      return RespondNow(Error(error));
+    shields_rule.secondary_pattern = ContentSettingsPattern::Wildcard();
+    if (rule.secondary_pattern.get()) {
+      shields_rule.secondary_pattern =
+          content_settings_helpers::ParseExtensionPattern(
+              *rule.secondary_pattern, &error);
+      if (!shields_rule.secondary_pattern.IsValid())
+        return RespondNow(Error(error));
+    }
+    EXTENSION_FUNCTION_VALIDATE(!rule.resource_identifier.empty());
+    shields_rule.resource_identifier = rule.resource_identifier;
+    EXTENSION_FUNCTION_VALIDATE(content_settings::ContentSettingFromString(
+        rule.setting, &shields_rule.setting));
+    rules.push_back(std::move(shields_rule));
+  }
+
+  ::brave_shields::SetShieldsSettings(
+      HostContentSettingsMapFactory::GetForProfile(
+          Profile::FromBrowserContext(browser_context())),
+      rules);
+  return RespondNow(NoArguments());
+}
+
 ExtensionFunction::ResponseAction
 BraveShieldsContentSettingGetFunction::Run() {
   ContentSettingsType content_type;
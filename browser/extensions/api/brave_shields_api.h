@@ -20,6 +20,27 @@ class BraveShieldsAllowScriptsOnceFunction : public UIThreadExtensionFunction {
   ResponseAction Run() override;
 };
 
+class BraveShieldsGetShieldsStateFunction : public UIThreadExtensionFunction {
+ public:
+  DECLARE_EXTENSION_FUNCTION("braveShields.getShieldsState", UNKNOWN)
+
+ protected:
+  ~BraveShieldsGetShieldsStateFunction() override;
+
+  ResponseAction Run() override;
+};
+
+class BraveShieldsSetContentSettingsFunction
+    : public UIThreadExtensionFunction {
+ public:
+  DECLARE_EXTENSION_FUNCTION("braveShields.setContentSettings", UNKNOWN)
+
+ protected:
+  ~BraveShieldsSetContentSettingsFunction() override;
+
+  ResponseAction Run() override;
+};
+
 class BraveShieldsContentSettingGetFunction
     : public UIThreadExtensionFunction {
  public:
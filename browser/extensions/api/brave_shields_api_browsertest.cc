@@ -2,10 +2,14 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <vector>
+
 #include "base/path_service.h"
+#include "base/time/time.h"
 #include "brave/browser/extensions/api/brave_shields_api.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/extensions/extension_constants.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/extensions/api/content_settings/content_settings_api.h"
@@ -17,12 +21,15 @@
 #include "chrome/browser/extensions/extension_tab_util.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/browser_tabrestore.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
 #include "chrome/test/base/in_process_browser_test.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test_utils.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_types.h"
+#include "components/sessions/core/serialized_navigation_entry.h"
 #include "extensions/common/extension_builder.h"
 #include "net/dns/mock_host_resolver.h"
 
@@ -79,7 +86,8 @@ class BraveShieldsAPIBrowserTest : public InProcessBrowserTest {
       return WaitForLoadStop(active_contents());
     }
 
-    void AllowScriptOriginOnce(const std::string& origin) {
+    void RunAllowScriptsOnce(const std::string& origin,
+                             content::WebContents* contents) {
       // run extension function to temporarily allow origin
       scoped_refptr<BraveShieldsAllowScriptsOnceFunction> function(
           new BraveShieldsAllowScriptsOnceFunction());
@@ -88,18 +96,40 @@ class BraveShieldsAPIBrowserTest : public InProcessBrowserTest {
 
       const GURL url(embedded_test_server()->GetURL(origin, "/simple.js"));
       const std::string allow_origin = url.GetOrigin().spec();
-      int tabId = extensions::ExtensionTabUtil::GetTabId(active_contents());
+      int tabId = extensions::ExtensionTabUtil::GetTabId(contents);
 
       RunFunctionAndReturnSingleResult(
           function.get(),
           "[[\"" + allow_origin + "\"], " + std::to_string(tabId) + "]",
           browser());
+    }
+
+    void AllowScriptOriginOnce(const std::string& origin) {
+      RunAllowScriptsOnce(origin, active_contents());
 
       // reload page with a.com temporarily allowed
       active_contents()->GetController().Reload(content::ReloadType::NORMAL,
           true);
     }
 
+    // Adds a background tab the way session restore does, without loading it,
+    // so its Brave tab helpers are not attached yet.
+    content::WebContents* AddUnloadedTab(const std::string& origin,
+                                         const std::string& path) {
+      const GURL url = embedded_test_server()->GetURL(origin, path);
+      sessions::SerializedNavigationEntry entry;
+      entry.set_virtual_url(url);
+      entry.set_original_request_url(url);
+      entry.set_is_restored(true);
+      std::vector<sessions::SerializedNavigationEntry> navigations = { entry };
+
+      return chrome::AddRestoredTab(
+          browser(), navigations, browser()->tab_strip_model()->count(), 0,
+          "", false, false, true,
+          base::TimeTicks::UnixEpoch(), nullptr,
+          "", true /* from_session_restore */);
+    }
+
   private:
     HostContentSettingsMap* content_settings_;
     scoped_refptr<const extensions::Extension> extension_;
@@ -143,6 +173,24 @@ IN_PROC_BROWSER_TEST_F(BraveShieldsAPIBrowserTest, AllowScriptsOnce) {
     "All script loadings should be blocked after navigating away.";
 }
 
+IN_PROC_BROWSER_TEST_F(BraveShieldsAPIBrowserTest,
+                       AllowScriptsOnceBeforeTabLoads) {
+  BlockScripts();
+
+  content::WebContents* contents =
+      AddUnloadedTab("a.com", "/load_js_from_origins.html");
+  ASSERT_FALSE(
+      brave_shields::BraveShieldsWebContentsObserver::FromWebContents(
+          contents));
+
+  RunAllowScriptsOnce("a.com", contents);
+
+  contents->GetController().LoadIfNecessary();
+  EXPECT_TRUE(WaitForLoadStop(contents));
+  EXPECT_EQ(contents->GetAllFrames().size(), 2u) <<
+    "Scripts from a.com should be allowed once the tab loads.";
+}
+
 IN_PROC_BROWSER_TEST_F(BraveShieldsAPIBrowserTest, AllowScriptsOnceIframe) {
   BlockScripts();
 
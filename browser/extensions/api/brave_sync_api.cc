@@ -9,6 +9,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
+#include "base/no_destructor.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
 #include "brave/common/extensions/api/brave_sync.h"
 #include "brave/components/brave_sync/client/brave_sync_client.h"
 #include "brave/components/brave_sync/brave_sync_service.h"
@@ -32,6 +36,25 @@ BraveSyncService* GetBraveSyncService(BrowserContext* browser_context) {
       Profile::FromBrowserContext(browser_context));
 }
 
+// Records from the sync extension are converted off the UI thread, since
+// initial sync can send tens of thousands of them. A single sequence keeps
+// batches in the order the extension sent them, so the replies reach the
+// sync service in that order too.
+scoped_refptr<base::SequencedTaskRunner> GetRecordsTaskRunner() {
+  static base::NoDestructor<scoped_refptr<base::SequencedTaskRunner>>
+      task_runner(base::CreateSequencedTaskRunnerWithTraits(
+          {base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}));
+  return *task_runner;
+}
+
+::brave_sync::RecordsListPtr ConvertRecords(
+    std::vector<brave_sync::SyncRecord> ext_records) {
+  auto records = std::make_unique<::brave_sync::RecordsList>();
+  ::brave_sync::ConvertSyncRecords(&ext_records, *records.get());
+  return records;
+}
+
 }  // namespace
 ExtensionFunction::ResponseAction BraveSyncGetInitDataFunction::Run() {
   std::unique_ptr<brave_sync::GetInitData::Params> params(
@@ -99,18 +122,32 @@ ExtensionFunction::ResponseAction BraveSyncGetExistingObjectsFunction::Run() {
       brave_sync::GetExistingObjects::Params::Create(*args_));
   EXTENSION_FUNCTION_VALIDATE(params.get());
 
-  auto records = std::make_unique<std::vector<::brave_sync::SyncRecordPtr>>();
-  ::brave_sync::ConvertSyncRecords(params->records, *records.get());
+  base::PostTaskAndReplyWithResult(GetRecordsTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&ConvertRecords, std::move(params->records)),
+      base::BindOnce(&BraveSyncGetExistingObjectsFunction::OnRecordsConverted,
+                     this,
+                     params->category_name,
+                     base::Time::FromJsTime(params->last_record_timestamp),
+                     params->is_truncated));
 
-  BraveSyncService* sync_service = GetBraveSyncService(browser_context());
-  DCHECK(sync_service);
-  sync_service->GetSyncClient()->sync_message_handler()->OnGetExistingObjects(
-    params->category_name,
-    std::move(records),
-    base::Time::FromJsTime(params->last_record_timestamp),
-    params->is_truncated);
+  return RespondLater();
+}
 
-  return RespondNow(NoArguments());
+void BraveSyncGetExistingObjectsFunction::OnRecordsConverted(
+    const std::string& category_name,
+    const base::Time& last_record_timestamp,
+    bool is_truncated,
+    ::brave_sync::RecordsListPtr records) {
+  BraveSyncService* sync_service = GetBraveSyncService(browser_context());
+  if (sync_service) {
+    sync_service->GetSyncClient()->sync_message_handler()->OnGetExistingObjects(
+      category_name,
+      std::move(records),
+      last_record_timestamp,
+      is_truncated);
+  }
+
+  Respond(NoArguments());
 }
 
 ExtensionFunction::ResponseAction BraveSyncResolvedSyncRecordsFunction::Run() {
@@ -118,16 +155,25 @@ ExtensionFunction::ResponseAction BraveSyncResolvedSyncRecordsFunction::Run() {
       brave_sync::ResolvedSyncRecords::Params::Create(*args_));
   EXTENSION_FUNCTION_VALIDATE(params.get());
 
-  auto records = std::make_unique<std::vector<::brave_sync::SyncRecordPtr>>();
-  ::brave_sync::ConvertSyncRecords(params->records, *records.get());
+  base::PostTaskAndReplyWithResult(GetRecordsTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&ConvertRecords, std::move(params->records)),
+      base::BindOnce(&BraveSyncResolvedSyncRecordsFunction::OnRecordsConverted,
+                     this,
+                     params->category_name));
+
+  return RespondLater();
+}
 
+void BraveSyncResolvedSyncRecordsFunction::OnRecordsConverted(
+    const std::string& category_name,
+    ::brave_sync::RecordsListPtr records) {
   BraveSyncService* sync_service = GetBraveSyncService(browser_context());
-  DCHECK(sync_service);
-  sync_service->GetSyncClient()->sync_message_handler()->OnResolvedSyncRecords(
-    params->category_name,
-    std::move(records));
+  if (sync_service) {
+    sync_service->GetSyncClient()->sync_message_handler()->
+        OnResolvedSyncRecords(category_name, std::move(records));
+  }
 
-  return RespondNow(NoArguments());
+  Respond(NoArguments());
 }
 
 ExtensionFunction::ResponseAction
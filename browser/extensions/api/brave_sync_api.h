@@ -6,6 +6,10 @@
 #ifndef BRAVE_BROWSER_EXTENSIONS_API_BRAVE_SYNC_API_H_
 #define BRAVE_BROWSER_EXTENSIONS_API_BRAVE_SYNC_API_H_
 
+#include <string>
+
+#include "base/time/time.h"
+#include "brave/components/brave_sync/jslib_messages_fwd.h"
 #include "extensions/browser/extension_function.h"
 
 namespace extensions {
@@ -45,12 +49,20 @@ class BraveSyncGetExistingObjectsFunction : public UIThreadExtensionFunction {
   ~BraveSyncGetExistingObjectsFunction() override {}
   DECLARE_EXTENSION_FUNCTION("braveSync.getExistingObjects", UNKNOWN)
   ResponseAction Run() override;
+
+  void OnRecordsConverted(const std::string& category_name,
+                          const base::Time& last_record_timestamp,
+                          bool is_truncated,
+                          ::brave_sync::RecordsListPtr records);
 };
 
 class BraveSyncResolvedSyncRecordsFunction : public UIThreadExtensionFunction {
   ~BraveSyncResolvedSyncRecordsFunction() override {}
   DECLARE_EXTENSION_FUNCTION("braveSync.resolvedSyncRecords", UNKNOWN)
   ResponseAction Run() override;
+
+  void OnRecordsConverted(const std::string& category_name,
+                          ::brave_sync::RecordsListPtr records);
 };
 
 class BraveSyncSaveBookmarksBaseOrderFunction
@@ -5,6 +5,7 @@
 #include "brave/browser/extensions/api/brave_sync_event_router.h"
 
 #include "brave/common/extensions/api/brave_sync.h"
+#include "brave/common/extensions/extension_constants.h"
 #include "chrome/browser/profiles/profile.h"
 #include "extensions/browser/extension_event_histogram_value.h"
 
@@ -18,11 +19,24 @@ BraveSyncEventRouter::BraveSyncEventRouter(Profile* profile) :
 
 BraveSyncEventRouter::~BraveSyncEventRouter() {}
 
+bool BraveSyncEventRouter::HasListener(const std::string& event_name) const {
+  return event_router_->ExtensionHasEventListener(brave_sync_extension_id,
+                                                  event_name);
+}
+
+void BraveSyncEventRouter::DispatchEvent(std::unique_ptr<Event> event) {
+  event_router_->DispatchEventToExtension(brave_sync_extension_id,
+                                          std::move(event));
+}
+
 void BraveSyncEventRouter::GotInitData(
     const brave_sync::Uint8Array& seed,
     const brave_sync::Uint8Array& device_id,
     const extensions::api::brave_sync::Config& config,
     const std::string& sync_words) {
+  if (!HasListener(extensions::api::brave_sync::OnGotInitData::kEventName))
+    return;
+
   const std::vector<int> arg_seed(seed.begin(), seed.end());
   const std::vector<int> arg_device_id(device_id.begin(), device_id.end());
 
@@ -36,13 +50,17 @@ void BraveSyncEventRouter::GotInitData(
      new Event(extensions::events::FOR_TEST,
        extensions::api::brave_sync::OnGotInitData::kEventName,
        std::move(args)));
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 void BraveSyncEventRouter::FetchSyncRecords(
     const std::vector<std::string>& category_names,
     const base::Time& startAt,
     const int max_records) {
+  if (!HasListener(
+          extensions::api::brave_sync::OnFetchSyncRecords::kEventName))
+    return;
+
   std::unique_ptr<base::ListValue> args(
      extensions::api::brave_sync::OnFetchSyncRecords::Create(category_names,
        startAt.ToJsTime(), static_cast<double>(max_records))
@@ -51,10 +69,13 @@ void BraveSyncEventRouter::FetchSyncRecords(
      new Event(extensions::events::FOR_TEST,
        extensions::api::brave_sync::OnFetchSyncRecords::kEventName,
        std::move(args)));
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 void BraveSyncEventRouter::FetchSyncDevices() {
+  if (!HasListener(extensions::api::brave_sync::OnFetchSyncDevices::kEventName))
+    return;
+
   std::unique_ptr<base::ListValue> args(
      extensions::api::brave_sync::OnFetchSyncDevices::Create()
        .release());
@@ -63,12 +84,16 @@ void BraveSyncEventRouter::FetchSyncDevices() {
      new Event(extensions::events::FOR_TEST,
        extensions::api::brave_sync::OnFetchSyncDevices::kEventName,
        std::move(args)));
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 void BraveSyncEventRouter::ResolveSyncRecords(
     const std::string& category_name,
     const std::vector<RecordAndExistingObject>& records_and_existing_objects) {
+  if (!HasListener(
+          extensions::api::brave_sync::OnResolveSyncRecords::kEventName))
+    return;
+
   for (const auto & entry : records_and_existing_objects) {
     DCHECK(!entry.server_record.object_data.empty());
     DCHECK(!entry.local_record ||
@@ -87,12 +112,15 @@ void BraveSyncEventRouter::ResolveSyncRecords(
        extensions::api::brave_sync::OnResolveSyncRecords::kEventName,
        std::move(args)));
 
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 void BraveSyncEventRouter::SendSyncRecords(
     const std::string& category_name,
-    const std::vector<api::brave_sync::SyncRecord>& records) {
+    const std::vector<uint8_t>& records) {
+  if (!HasListener(extensions::api::brave_sync::OnSendSyncRecords::kEventName))
+    return;
+
   std::unique_ptr<base::ListValue> args(
      extensions::api::brave_sync::OnSendSyncRecords::Create(
           category_name,
@@ -102,12 +130,16 @@ void BraveSyncEventRouter::SendSyncRecords(
        extensions::api::brave_sync::OnSendSyncRecords::kEventName,
        std::move(args)));
 
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 void BraveSyncEventRouter::SendGetBookmarksBaseOrder(
     const std::string& device_id,
     const std::string& platform) {
+  if (!HasListener(
+          extensions::api::brave_sync::OnSendGetBookmarksBaseOrder::kEventName))
+    return;
+
   std::unique_ptr<base::ListValue> args(
      extensions::api::brave_sync::OnSendGetBookmarksBaseOrder::Create(
         device_id, platform).release());
@@ -116,10 +148,13 @@ void BraveSyncEventRouter::SendGetBookmarksBaseOrder(
        extensions::api::brave_sync::OnSendGetBookmarksBaseOrder::kEventName,
        std::move(args)));
 
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 void BraveSyncEventRouter::NeedSyncWords(const std::string& seed) {
+  if (!HasListener(extensions::api::brave_sync::OnNeedSyncWords::kEventName))
+    return;
+
   std::unique_ptr<base::ListValue> args(
      extensions::api::brave_sync::OnNeedSyncWords::Create(seed)
        .release());
@@ -127,10 +162,13 @@ void BraveSyncEventRouter::NeedSyncWords(const std::string& seed) {
      new Event(extensions::events::FOR_TEST,
        extensions::api::brave_sync::OnNeedSyncWords::kEventName,
        std::move(args)));
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 void BraveSyncEventRouter::LoadClient() {
+  if (!HasListener(extensions::api::brave_sync::OnLoadClient::kEventName))
+    return;
+
   std::unique_ptr<base::ListValue> args(
      extensions::api::brave_sync::OnLoadClient::Create()
        .release());
@@ -139,16 +177,19 @@ void BraveSyncEventRouter::LoadClient() {
      new Event(extensions::events::FOR_TEST,
        extensions::api::brave_sync::OnLoadClient::kEventName,
        std::move(args)));
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 void BraveSyncEventRouter::ClearOrderMap() {
+  if (!HasListener(extensions::api::brave_sync::OnClearOrderMap::kEventName))
+    return;
+
   auto args = std::make_unique<base::ListValue>();
   std::unique_ptr<Event> event(
      new Event(extensions::events::FOR_TEST,
        extensions::api::brave_sync::OnClearOrderMap::kEventName,
        std::move(args)));
-  event_router_->BroadcastEvent(std::move(event));
+  DispatchEvent(std::move(event));
 }
 
 } // namespace extensions
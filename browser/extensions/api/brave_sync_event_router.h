@@ -5,7 +5,11 @@
 #ifndef BRAVE_BROWSER_EXTENSIONS_API_BRAVE_SYNC_EVENT_ROUTER_H_
 #define BRAVE_BROWSER_EXTENSIONS_API_BRAVE_SYNC_EVENT_ROUTER_H_
 
+#include <stdint.h>
+
+#include <memory>
 #include <string>
+#include <vector>
 #include "extensions/browser/event_router.h"
 
 class Profile;
@@ -33,6 +37,10 @@ class BraveSyncEventRouter {
   BraveSyncEventRouter(Profile* profile);
   ~BraveSyncEventRouter();
 
+  // Whether the sync extension listens for |event_name|. Events nobody
+  // listens for are dropped before their arguments are built.
+  bool HasListener(const std::string& event_name) const;
+
   void GotInitData(
     const brave_sync::Uint8Array& seed,
     const brave_sync::Uint8Array& device_id,
@@ -49,8 +57,9 @@ class BraveSyncEventRouter {
   void ResolveSyncRecords(const std::string &category_name,
     const std::vector<RecordAndExistingObject>& records_and_existing_objects);
 
+  // |records| are encoded by brave_sync::EncodeSyncRecords
   void SendSyncRecords(const std::string& category_name,
-                       const std::vector<api::brave_sync::SyncRecord>& records);
+                       const std::vector<uint8_t>& records);
 
   void SendGetBookmarksBaseOrder(const std::string& device_id,
                                  const std::string& platform);
@@ -62,6 +71,10 @@ class BraveSyncEventRouter {
   void LoadClient();
 
 private:
+  // Events only go to the sync extension, rather than being broadcast to
+  // every extension in the profile
+  void DispatchEvent(std::unique_ptr<Event> event);
+
   EventRouter* event_router_;
 };
 
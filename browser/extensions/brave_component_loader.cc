@@ -7,7 +7,9 @@
 
 #include <string>
 
+#include "base/bind.h"
 #include "base/command_line.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/component_updater/brave_component_installer.h"
 #include "brave/common/brave_switches.h"
@@ -17,10 +19,12 @@
 #include "brave/components/brave_rewards/browser/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/resources/extension/grit/brave_rewards_extension_resources.h"
 #include "brave/components/brave_webtorrent/grit/brave_webtorrent_resources.h"
+#include "chrome/browser/prefs/session_startup_pref.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/webui/components_ui.h"
 #include "chrome/common/pref_names.h"
 #include "components/grit/brave_components_resources.h"
+#include "content/public/browser/browser_thread.h"
 #include "extensions/browser/extension_prefs.h"
 
 namespace extensions {
@@ -44,7 +48,8 @@ BraveComponentLoader::BraveComponentLoader(
     : ComponentLoader(extension_service, profile_prefs, local_state, profile),
       profile_(profile),
       profile_prefs_(profile_prefs),
-      testing_callbacks_(nullptr) {
+      testing_callbacks_(nullptr),
+      weak_factory_(this) {
 // TODO(bridiver) - this doesn't belong here
 #if !defined(OS_ANDROID)
   ObserveOpenPdfExternallySetting();
@@ -92,6 +97,25 @@ void BraveComponentLoader::ForceAddHangoutServicesExtension() {
   ComponentLoader::AddHangoutServicesExtension();
 }
 
+bool BraveComponentLoader::IsWebTorrentExtensionEnabled() const {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  return !command_line.HasSwitch(switches::kDisableWebTorrentExtension) &&
+      (!profile_prefs_->FindPreference(kWebTorrentEnabled) ||
+      profile_prefs_->GetBoolean(kWebTorrentEnabled));
+}
+
+void BraveComponentLoader::AddWebTorrentExtension() {
+  if (!IsWebTorrentExtensionEnabled() ||
+      Exists(brave_webtorrent_extension_id)) {
+    return;
+  }
+  base::FilePath brave_webtorrent_path(FILE_PATH_LITERAL(""));
+  brave_webtorrent_path =
+    brave_webtorrent_path.Append(FILE_PATH_LITERAL("brave_webtorrent"));
+  Add(IDR_BRAVE_WEBTORRENT, brave_webtorrent_path);
+}
+
 void BraveComponentLoader::AddDefaultComponentExtensions(
     bool skip_session_components) {
   ComponentLoader::AddDefaultComponentExtensions(skip_session_components);
@@ -120,13 +144,19 @@ void BraveComponentLoader::AddDefaultComponentExtensions(
   }
 #endif
 
-  if (!command_line.HasSwitch(switches::kDisableWebTorrentExtension) &&
-      (!profile_prefs_->FindPreference(kWebTorrentEnabled) ||
-      profile_prefs_->GetBoolean(kWebTorrentEnabled))) {
-    base::FilePath brave_webtorrent_path(FILE_PATH_LITERAL(""));
-    brave_webtorrent_path =
-      brave_webtorrent_path.Append(FILE_PATH_LITERAL("brave_webtorrent"));
-    Add(IDR_BRAVE_WEBTORRENT, brave_webtorrent_path);
+  // WebTorrent keeps a persistent background page that is only needed once
+  // a torrent is opened, so it is added after startup. Restored sessions may
+  // contain torrent tabs, which need the extension right away.
+  if (IsWebTorrentExtensionEnabled()) {
+    if (SessionStartupPref::GetStartupPref(profile_prefs_).type ==
+        SessionStartupPref::LAST) {
+      AddWebTorrentExtension();
+    } else {
+      content::BrowserThread::PostAfterStartupTask(
+          FROM_HERE, base::SequencedTaskRunnerHandle::Get(),
+          base::BindOnce(&BraveComponentLoader::AddWebTorrentExtension,
+                         weak_factory_.GetWeakPtr()));
+    }
   }
 }
 
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
 #include "chrome/browser/extensions/component_loader.h"
 #include "components/prefs/pref_change_registrar.h"
 
@@ -40,6 +41,8 @@ class BraveComponentLoader : public ComponentLoader {
   // ForceAddHangoutServicesExtension ignores whether or not a preference for
   // hangouts is set.  If the buildflag is not set, it won't add though.
   void ForceAddHangoutServicesExtension();
+  // Adds the WebTorrent extension unless it is disabled or already added.
+  void AddWebTorrentExtension();
 
   static bool IsPdfjsDisabled();
 
@@ -65,10 +68,13 @@ class BraveComponentLoader : public ComponentLoader {
 
   void set_testing_callbacks(TestingCallbacks* testing_callbacks);
 
+  bool IsWebTorrentExtensionEnabled() const;
+
   Profile* profile_;
   PrefService* profile_prefs_;
   PrefChangeRegistrar registrar_;
   TestingCallbacks* testing_callbacks_;
+  base::WeakPtrFactory<BraveComponentLoader> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(BraveComponentLoader);
 };
 
@@ -30,7 +30,9 @@ void BraveExternalProcessImporterClient::OnCookiesImportStart(
   if (cancelled_)
     return;
 
+  // Importers may send cookies in several batches, each with its own start
   total_cookies_count_ = total_cookies_count;
+  cookies_.clear();
   cookies_.reserve(total_cookies_count);
 }
 
@@ -41,8 +43,10 @@ void BraveExternalProcessImporterClient::OnCookiesImportGroup(
 
   cookies_.insert(cookies_.end(), cookies_group.begin(),
                   cookies_group.end());
-  if (cookies_.size() >= total_cookies_count_)
+  if (cookies_.size() >= total_cookies_count_) {
     bridge_->SetCookies(cookies_);
+    cookies_.clear();
+  }
 }
 
 void BraveExternalProcessImporterClient::OnStatsImportReady(
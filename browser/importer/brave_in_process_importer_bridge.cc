@@ -3,18 +3,56 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "brave/browser/importer/brave_in_process_importer_bridge.h"
+
+#include "base/bind.h"
 #include "chrome/browser/importer/external_process_importer_host.h"
 
 BraveInProcessImporterBridge::BraveInProcessImporterBridge(
     ProfileWriter* writer,
     base::WeakPtr<ExternalProcessImporterHost> host) :
   InProcessImporterBridge(writer, host),
-  writer_(static_cast<BraveProfileWriter*>(writer)) {
+  writer_(static_cast<BraveProfileWriter*>(writer)),
+  cookie_batches_pending_(0),
+  cookies_ended_pending_(false),
+  ended_pending_(false) {
 }
 
 void BraveInProcessImporterBridge::SetCookies(
     const std::vector<net::CanonicalCookie>& cookies) {
-  writer_->AddCookies(cookies);
+  cookie_batches_pending_++;
+  writer_->AddCookies(cookies,
+      base::BindOnce(&BraveInProcessImporterBridge::OnCookiesAdded, this));
+}
+
+void BraveInProcessImporterBridge::OnCookiesAdded(size_t cookies_set) {
+  DCHECK_GT(cookie_batches_pending_, 0u);
+  if (--cookie_batches_pending_ > 0)
+    return;
+  if (cookies_ended_pending_) {
+    cookies_ended_pending_ = false;
+    InProcessImporterBridge::NotifyItemEnded(importer::COOKIES);
+  }
+  if (ended_pending_) {
+    ended_pending_ = false;
+    InProcessImporterBridge::NotifyEnded();
+  }
+}
+
+void BraveInProcessImporterBridge::NotifyItemEnded(
+    importer::ImportItem item) {
+  if (item == importer::COOKIES && cookie_batches_pending_ > 0) {
+    cookies_ended_pending_ = true;
+    return;
+  }
+  InProcessImporterBridge::NotifyItemEnded(item);
+}
+
+void BraveInProcessImporterBridge::NotifyEnded() {
+  if (cookie_batches_pending_ > 0) {
+    ended_pending_ = true;
+    return;
+  }
+  InProcessImporterBridge::NotifyEnded();
 }
 
 void BraveInProcessImporterBridge::UpdateStats(const BraveStats& stats) {
@@ -30,6 +30,8 @@ class BraveInProcessImporterBridge : public InProcessImporterBridge {
   void UpdateReferral(const BraveReferral& referral) override;
   void UpdateWindows(const ImportedWindowState& windowState) override;
   void UpdateSettings(const SessionStoreSettings& settings) override;
+  void NotifyItemEnded(importer::ImportItem item) override;
+  void NotifyEnded() override;
 
   void FinishLedgerImport();
   void Cancel();
@@ -37,8 +39,16 @@ class BraveInProcessImporterBridge : public InProcessImporterBridge {
  private:
   ~BraveInProcessImporterBridge() override;
 
+  void OnCookiesAdded(size_t cookies_set);
+
   BraveProfileWriter* const writer_;  // weak
 
+  // The end of the cookie import, and of the import as a whole, is reported
+  // once the cookies have actually been set rather than when they are received
+  size_t cookie_batches_pending_;
+  bool cookies_ended_pending_;
+  bool ended_pending_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveInProcessImporterBridge);
 };
 
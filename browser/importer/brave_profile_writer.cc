@@ -24,6 +24,7 @@
 #include "brave/browser/importer/brave_in_process_importer_bridge.h"
 #include "brave/browser/search_engines/search_engine_provider_util.h"
 
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
@@ -52,12 +53,35 @@
 #include "services/network/public/mojom/cookie_manager.mojom.h"
 #include "ui/base/ui_base_types.h"
 
+namespace {
+
+const size_t kMaxCookiesInFlight = 100;
+
+// Rewards keeps recent ledger state changes in a journal next to the
+// snapshot, so both have to be copied for the backup to be complete.
+bool BackupLedgerState(const base::FilePath& from, const base::FilePath& to) {
+  if (!base::CopyFile(from, to)) {
+    return false;
+  }
+
+  const base::FilePath journal = from.AddExtensionASCII(".journal");
+  if (!base::PathExists(journal)) {
+    return true;
+  }
+
+  return base::CopyFile(journal, to.AddExtensionASCII(".journal"));
+}
+
+}  // namespace
+
 BraveProfileWriter::BraveProfileWriter(Profile* profile)
     : ProfileWriter(profile),
       task_runner_(base::CreateSequencedTaskRunnerWithTraits({
           base::MayBlock(), base::TaskPriority::BEST_EFFORT,
           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
-      consider_for_backup_(false) {
+      consider_for_backup_(false),
+      cookies_in_flight_(0),
+      cookies_set_(0) {
 }
 
 BraveProfileWriter::~BraveProfileWriter() {
@@ -65,22 +89,54 @@ BraveProfileWriter::~BraveProfileWriter() {
 }
 
 void BraveProfileWriter::AddCookies(
-    const std::vector<net::CanonicalCookie>& cookies) {
-  network::mojom::CookieManagerPtr cookie_manager;
-  content::BrowserContext::GetDefaultStoragePartition(profile_)
-      ->GetNetworkContext()
-      ->GetCookieManager(mojo::MakeRequest(&cookie_manager));
+    const std::vector<net::CanonicalCookie>& cookies,
+    AddCookiesCallback callback) {
+  if (add_cookies_callbacks_.empty())
+    cookies_set_ = 0;
+  add_cookies_callbacks_.push_back(std::move(callback));
+  pending_cookies_.insert(pending_cookies_.end(),
+                          cookies.begin(), cookies.end());
+
+  if (!cookie_manager_) {
+    content::BrowserContext::GetDefaultStoragePartition(profile_)
+        ->GetNetworkContext()
+        ->GetCookieManager(mojo::MakeRequest(&cookie_manager_));
+  }
+
+  SetPendingCookies();
+}
 
+void BraveProfileWriter::SetPendingCookies() {
   net::CookieOptions options;
   options.set_include_httponly();  // modify_http_only
-  for (auto& cookie : cookies) {
-    cookie_manager->SetCanonicalCookie(
-        cookie,
+  while (!pending_cookies_.empty() &&
+         cookies_in_flight_ < kMaxCookiesInFlight) {
+    cookie_manager_->SetCanonicalCookie(
+        pending_cookies_.front(),
         "https",  // secure_source
         options,
-        // Fire and forget
-        network::mojom::CookieManager::SetCanonicalCookieCallback());
+        base::BindOnce(&BraveProfileWriter::OnCookieSet, AsWeakPtr()));
+    pending_cookies_.pop_front();
+    cookies_in_flight_++;
   }
+
+  if (pending_cookies_.empty() && cookies_in_flight_ == 0 &&
+      !add_cookies_callbacks_.empty()) {
+    VLOG(1) << "Imported " << cookies_set_ << " cookies";
+    cookie_manager_.reset();
+    std::vector<AddCookiesCallback> callbacks;
+    callbacks.swap(add_cookies_callbacks_);
+    for (auto& callback : callbacks)
+      std::move(callback).Run(cookies_set_);
+  }
+}
+
+void BraveProfileWriter::OnCookieSet(bool success) {
+  DCHECK_GT(cookies_in_flight_, 0u);
+  cookies_in_flight_--;
+  if (success)
+    cookies_set_++;
+  SetPendingCookies();
 }
 
 void BraveProfileWriter::UpdateStats(const BraveStats& stats) {
@@ -137,7 +193,7 @@ void BraveProfileWriter::BackupWallet() {
   base::PostTaskAndReplyWithResult(
     task_runner_.get(),
     FROM_HERE,
-    base::Bind(&base::CopyFile,
+    base::Bind(&BackupLedgerState,
       profile_default_directory.AppendASCII("ledger_state"),
       profile_default_directory.AppendASCII(backup_filename.str())),
     base::Bind(&BraveProfileWriter::OnWalletBackupComplete,
@@ -10,10 +10,13 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "chrome/browser/importer/profile_writer.h"
 #include "net/cookies/canonical_cookie.h"
+#include "services/network/public/mojom/cookie_manager.mojom.h"
 #include "brave/components/brave_rewards/browser/rewards_service_observer.h"
 #include "brave/common/importer/brave_ledger.h"
 
@@ -28,7 +31,12 @@ class BraveProfileWriter : public ProfileWriter,
  public:
   explicit BraveProfileWriter(Profile* profile);
 
-  virtual void AddCookies(const std::vector<net::CanonicalCookie>& cookies);
+  // Run with the number of cookies set once every cookie added so far has
+  // been handled by the cookie manager. Cookies may be added in several
+  // batches, each of which is queued behind the ones before it.
+  using AddCookiesCallback = base::OnceCallback<void(size_t cookies_set)>;
+  virtual void AddCookies(const std::vector<net::CanonicalCookie>& cookies,
+                          AddCookiesCallback callback);
   virtual void UpdateStats(const BraveStats& stats);
   virtual void UpdateLedger(const BraveLedger& ledger);
   virtual void UpdateReferral(const BraveReferral& referral);
@@ -61,6 +69,9 @@ class BraveProfileWriter : public ProfileWriter,
   ~BraveProfileWriter() override;
 
  private:
+  void SetPendingCookies();
+  void OnCookieSet(bool success);
+
   brave_rewards::RewardsService* rewards_service_;
   BraveInProcessImporterBridge* bridge_ptr_;
   double new_contribution_amount_;
@@ -69,6 +80,14 @@ class BraveProfileWriter : public ProfileWriter,
   // Only used when wallet exists and first action is guaranteed
   // to be FetchWalletProperties(). See notes in brave_profile_writer.cc
   bool consider_for_backup_;
+
+  // Cookies are set a bounded number at a time, so that a large import does
+  // not queue every cookie on the network service at once
+  network::mojom::CookieManagerPtr cookie_manager_;
+  base::circular_deque<net::CanonicalCookie> pending_cookies_;
+  size_t cookies_in_flight_;
+  size_t cookies_set_;
+  std::vector<AddCookiesCallback> add_cookies_callbacks_;
 };
 
 #endif  // BRAVE_BROWSER_IMPORTER_BRAVE_PROFILE_WRITER_H_
@@ -7,19 +7,25 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/base64url.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
+#include "base/timer/timer.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
+#include "brave/common/brave_switches.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
-#include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
-#include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
-#include "brave/components/brave_shields/browser/tracking_protection_service.h"
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "content/public/browser/browser_thread.h"
@@ -96,29 +102,16 @@ void OnBeforeURLRequestAdBlockTP(
   }
   DCHECK_NE(ctx->request_identifier, 0UL);
 
-  bool did_match_exception = false;
-  std::string tab_host = ctx->tab_origin.host();
-  if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-          ctx->request_url, ctx->resource_type, tab_host,
-          &did_match_exception, &ctx->cancel_request_explicitly)) {
-    ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->ad_block_regional_service_manager()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly)) {
-    ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->ad_block_custom_filters_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly)) {
+  const brave_shields::ShieldsMatchRequest request(
+      ctx->request_url, ctx->resource_type, ctx->tab_origin.host());
+  const brave_shields::ShieldsMatchResult result =
+      g_brave_browser_process->shields_request_matcher()->Match(request);
+  if (result.cancel_request_explicitly) {
+    ctx->cancel_request_explicitly = true;
+  }
+  if (result.IsBlockedByAdBlock()) {
     ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->tracking_protection_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly)) {
+  } else if (result.IsBlockedByTrackingProtection()) {
     ctx->blocked_by = kTrackerBlocked;
   }
 
@@ -133,6 +126,89 @@ void OnBeforeURLRequestAdBlockTP(
   }
 }
 
+namespace {
+
+// Bounds how long requests are held in total, so a missing or broken list
+// does not stall page loads.
+constexpr base::TimeDelta kPreShieldsHoldTimeout =
+    base::TimeDelta::FromSeconds(3);
+
+// Holds subresource requests made before the default ad block list has
+// loaded and resumes them once it has, so they are not let through against
+// an empty client. Once the timeout fires nothing more is held, since the
+// list is then unlikely to arrive soon. Only used on the IO thread.
+class PreShieldsRequestQueue {
+ public:
+  PreShieldsRequestQueue() : expired_(false) {}
+
+  bool ShouldHold(const BraveRequestInfo& ctx) const {
+    if (expired_ || ctx.resource_type == content::RESOURCE_TYPE_MAIN_FRAME)
+      return false;
+    return !g_brave_browser_process->ad_block_service()->IsReadyOnIOThread();
+  }
+
+  void Hold(const ResponseCallback& next_callback,
+            std::shared_ptr<BraveRequestInfo> ctx) {
+    if (held_requests_.empty()) {
+      g_brave_browser_process->ad_block_service()->RunWhenReadyOnIOThread(
+          base::BindOnce(&PreShieldsRequestQueue::ReleaseAll,
+                         base::Unretained(this), false));
+      timer_.Start(FROM_HERE, kPreShieldsHoldTimeout,
+                   base::BindOnce(&PreShieldsRequestQueue::ReleaseAll,
+                                  base::Unretained(this), true));
+    }
+    held_requests_.push_back(
+        {next_callback, std::move(ctx), base::TimeTicks::Now()});
+  }
+
+ private:
+  struct HeldRequest {
+    ResponseCallback next_callback;
+    std::shared_ptr<BraveRequestInfo> ctx;
+    base::TimeTicks hold_time;
+  };
+
+  void ReleaseAll(bool timed_out) {
+    if (held_requests_.empty())
+      return;
+    if (timed_out)
+      expired_ = true;
+    timer_.Stop();
+
+    std::vector<HeldRequest> held_requests;
+    held_requests.swap(held_requests_);
+    const base::TimeTicks now = base::TimeTicks::Now();
+    for (const auto& held_request : held_requests) {
+      UMA_HISTOGRAM_TIMES("Brave.Shields.PreShieldsRequestWaitTime",
+                          now - held_request.hold_time);
+      UMA_HISTOGRAM_BOOLEAN("Brave.Shields.PreShieldsRequestTimedOut",
+                            timed_out);
+      OnBeforeURLRequestAdBlockTP(held_request.ctx);
+      held_request.next_callback.Run();
+    }
+  }
+
+  std::vector<HeldRequest> held_requests_;
+  base::OneShotTimer timer_;
+  bool expired_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreShieldsRequestQueue);
+};
+
+bool IsHoldRequestsUntilShieldsReadyEnabled() {
+  static const bool enabled =
+      base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kHoldRequestsUntilShieldsReady);
+  return enabled;
+}
+
+PreShieldsRequestQueue* GetPreShieldsRequestQueue() {
+  static base::NoDestructor<PreShieldsRequestQueue> queue;
+  return queue.get();
+}
+
+}  // namespace
+
 int OnBeforeURLRequest_AdBlockTPPreWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -163,6 +239,12 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
     return net::OK;
   }
 
+  if (IsHoldRequestsUntilShieldsReadyEnabled() &&
+      GetPreShieldsRequestQueue()->ShouldHold(*ctx)) {
+    GetPreShieldsRequestQueue()->Hold(next_callback, ctx);
+    return net::ERR_IO_PENDING;
+  }
+
   OnBeforeURLRequestAdBlockTP(ctx);
 
   return net::OK;
@@ -25,9 +25,8 @@ void OnBeforeURLRequest_HttpseFileWork(
     std::shared_ptr<BraveRequestInfo> ctx) {
   base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
                                                 base::BlockingType::WILL_BLOCK);
-  DCHECK_NE(ctx->request_identifier, 0U);
   g_brave_browser_process->https_everywhere_service()->
-    GetHTTPSURL(&ctx->request_url, ctx->request_identifier, &ctx->new_url_spec);
+    GetHTTPSURL(&ctx->request_url, &ctx->new_url_spec);
 }
 
 void OnBeforeURLRequest_HttpsePostFileWork(
@@ -35,6 +34,10 @@ void OnBeforeURLRequest_HttpsePostFileWork(
     std::shared_ptr<BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
+  if (!ctx->new_url_spec.empty()) {
+    ctx->httpse_redirects_count++;
+  }
+
   if (!ctx->new_url_spec.empty() &&
     ctx->new_url_spec != ctx->request_url.spec()) {
     brave_shields::DispatchBlockedEventFromIO(ctx->request_url,
@@ -60,6 +63,11 @@ int OnBeforeURLRequest_HttpsePreFileWork(
     return net::OK;
   }
 
+  // Stop upgrading a request that keeps getting redirected back to http.
+  if (ctx->httpse_redirects_count >= kHTTPSEMaxRedirectsCount) {
+    return net::OK;
+  }
+
   bool is_valid_url = true;
   is_valid_url = ctx->request_url.is_valid();
   std::string scheme = ctx->request_url.scheme();
@@ -71,10 +79,12 @@ int OnBeforeURLRequest_HttpsePreFileWork(
   }
 
   if (is_valid_url) {
-    if (!g_brave_browser_process->https_everywhere_service()->
-        GetHTTPSURLFromCacheOnly(&ctx->request_url,
-                                 ctx->request_identifier,
-                                 &ctx->new_url_spec)) {
+    // Upgrades are only counted once the lookup has run on the task runner,
+    // so a request that was already upgraded skips the cache and is counted
+    // again there.
+    if (ctx->httpse_redirects_count > 0 ||
+        !g_brave_browser_process->https_everywhere_service()->
+        GetHTTPSURLFromCacheOnly(&ctx->request_url, &ctx->new_url_spec)) {
       g_brave_browser_process->https_everywhere_service()->
         GetTaskRunner()->PostTaskAndReply(FROM_HERE,
           base::Bind(OnBeforeURLRequest_HttpseFileWork, ctx),
@@ -82,13 +92,13 @@ int OnBeforeURLRequest_HttpsePreFileWork(
               &OnBeforeURLRequest_HttpsePostFileWork),
               next_callback, ctx));
       return net::ERR_IO_PENDING;
-    } else {
-      if (!ctx->new_url_spec.empty()) {
-        brave_shields::DispatchBlockedEventFromIO(ctx->request_url,
-            ctx->render_frame_id, ctx->render_process_id,
-            ctx->frame_tree_node_id,
-            brave_shields::kHTTPUpgradableResources);
-      }
+    } else if (!ctx->new_url_spec.empty() &&
+               ctx->new_url_spec != ctx->request_url.spec()) {
+      // An empty URL from the cache means there is no rule to apply.
+      brave_shields::DispatchBlockedEventFromIO(ctx->request_url,
+          ctx->render_frame_id, ctx->render_process_id,
+          ctx->frame_tree_node_id,
+          brave_shields::kHTTPUpgradableResources);
     }
   }
 
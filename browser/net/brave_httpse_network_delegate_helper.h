@@ -9,6 +9,10 @@
 
 namespace brave {
 
+// A request that has already been upgraded this many times is assumed to be
+// in an http <-> https redirect loop and is left alone.
+constexpr int kHTTPSEMaxRedirectsCount = 4;
+
 int OnBeforeURLRequest_HttpsePreFileWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
@@ -48,4 +48,20 @@ TEST_F(BraveHTTPSENetworkDelegateHelperTest, AlreadySetNewURLNoOp) {
   EXPECT_EQ(ret, net::OK);
 }
 
+TEST_F(BraveHTTPSENetworkDelegateHelperTest, RedirectLoopNoOp) {
+  std::shared_ptr<brave::BraveRequestInfo>
+      brave_request_info(new brave::BraveRequestInfo());
+  brave_request_info->request_url =
+      GURL("http://bradhatesprimes.brave.com/composite_numbers_ftw");
+  brave_request_info->tab_origin = GURL("http://brad.brave.com/");
+  brave_request_info->httpse_redirects_count = brave::kHTTPSEMaxRedirectsCount;
+  brave::ResponseCallback callback;
+  int ret =
+    OnBeforeURLRequest_HttpsePreFileWork(callback, brave_request_info);
+  EXPECT_TRUE(brave_request_info->new_url_spec.empty());
+  EXPECT_EQ(brave_request_info->httpse_redirects_count,
+            brave::kHTTPSEMaxRedirectsCount);
+  EXPECT_EQ(ret, net::OK);
+}
+
 }  // namespace
@@ -6,9 +6,12 @@
 #include "brave/browser/net/brave_network_delegate_base.h"
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
+#include "base/metrics/histogram.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
@@ -18,14 +21,11 @@
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/browser_process.h"
-#include "chrome/browser/content_settings/tab_specific_content_settings.h"
 #include "chrome/browser/profiles/profile_manager.h"
 #include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
-#include "content/public/browser/render_frame_host.h"
-#include "content/public/browser/web_contents.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/url_request/url_request.h"
 
@@ -35,17 +35,7 @@ using net::URLRequest;
 
 namespace {
 
-content::WebContents* GetWebContentsFromProcessAndFrameId(int render_process_id,
-                                                          int render_frame_id) {
-  if (render_process_id) {
-    content::RenderFrameHost* rfh =
-        content::RenderFrameHost::FromID(render_process_id, render_frame_id);
-    return content::WebContents::FromRenderFrameHost(rfh);
-  }
-  // TODO(iefremov): Seems like a typo?
-  // issues/2263
-  return content::WebContents::FromFrameTreeNodeId(render_frame_id);
-}
+const char kHelperHistogramPrefix[] = "Brave.NetworkDelegate.";
 
 std::string GetTagFromPrefName(const std::string& pref_name) {
   if (pref_name == kFBEmbedControlType) {
@@ -100,6 +90,7 @@ void RemoveTrackableSecurityHeadersForThirdParty(
 BraveNetworkDelegateBase::BraveNetworkDelegateBase(
     extensions::EventRouterForwarder* event_router)
     : ChromeNetworkDelegate(event_router),
+      sync_headers_received_callbacks_count_(0),
       allow_google_auth_(true) {
   // Initialize the preference change registrar.
   base::PostTaskWithTraits(
@@ -145,10 +136,9 @@ int BraveNetworkDelegateBase::OnBeforeURLRequest(
     return ChromeNetworkDelegate::OnBeforeURLRequest(
         request, std::move(callback), new_url);
   }
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
-  brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
+  std::shared_ptr<brave::BraveRequestInfo> ctx =
+      GetRequestContext(request, brave::kOnBeforeRequest);
   ctx->new_url = new_url;
-  ctx->event_type = brave::kOnBeforeRequest;
   callbacks_[request->identifier()] = std::move(callback);
   RunNextCallback(request, ctx);
   return net::ERR_IO_PENDING;
@@ -162,9 +152,8 @@ int BraveNetworkDelegateBase::OnBeforeStartTransaction(
     return ChromeNetworkDelegate::OnBeforeStartTransaction(
         request, std::move(callback), headers);
   }
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
-  brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
-  ctx->event_type = brave::kOnBeforeStartTransaction;
+  std::shared_ptr<brave::BraveRequestInfo> ctx =
+      GetRequestContext(request, brave::kOnBeforeStartTransaction);
   ctx->headers = headers;
   callbacks_[request->identifier()] = std::move(callback);
   RunNextCallback(request, ctx);
@@ -186,14 +175,45 @@ int BraveNetworkDelegateBase::OnHeadersReceived(
         override_response_headers, allowed_unsafe_redirect_url);
   }
 
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
+  std::shared_ptr<brave::BraveRequestInfo> ctx =
+      GetRequestContext(request, brave::kOnHeadersReceived);
   callbacks_[request->identifier()] = std::move(callback);
-  brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
-  ctx->event_type = brave::kOnHeadersReceived;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
 
+  if (sync_headers_received_callbacks_count_ ==
+      headers_received_callbacks_.size()) {
+    // No helper can complete re-entrantly, so the chain may run right here.
+    // A helper returning ERR_IO_PENDING resumes it through |next_callback|
+    // once URLRequestHttpJob::awaiting_callback_ has been set.
+    brave::ResponseCallback next_callback =
+        base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
+                   base::Unretained(this), request, ctx);
+    while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
+      const HelperMetrics& metrics =
+          headers_received_metrics_[ctx->next_url_request_index];
+      brave::OnHeadersReceivedCallback helper =
+          headers_received_callbacks_[ctx->next_url_request_index++];
+      TRACE_EVENT0("net", metrics.name);
+      const base::TimeTicks start = base::TimeTicks::Now();
+      int rv = helper.Run(request, ctx->original_response_headers,
+                          ctx->override_response_headers,
+                          ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+      OnHelperRun(metrics, start, rv, ctx.get());
+      if (rv != net::OK) {
+        return rv;
+      }
+    }
+    return ChromeNetworkDelegate::OnHeadersReceived(
+        request,
+        base::BindOnce(
+            &BraveNetworkDelegateBase::RunCallbackForRequestIdentifier,
+            base::Unretained(this), ctx->request_identifier),
+        ctx->original_response_headers, ctx->override_response_headers,
+        ctx->allowed_unsafe_redirect_url);
+  }
+
   // Return ERR_IO_PENDING and run callbacks later by posting a task.
   // URLRequestHttpJob::awaiting_callback_ will be set to true after we
   // return net::ERR_IO_PENDING here, callbacks need to be run later than this
@@ -209,24 +229,17 @@ bool BraveNetworkDelegateBase::OnCanGetCookies(
     const URLRequest& request,
     const net::CookieList& cookie_list,
     bool allowed_from_caller) {
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
-  ctx->allow_google_auth = allow_google_auth_;
-  brave::BraveRequestInfo::FillCTXFromRequest(&request, ctx);
-  ctx->event_type = brave::kOnCanGetCookies;
+  std::shared_ptr<brave::BraveRequestInfo> ctx =
+      GetCookieContext(request, brave::kOnCanGetCookies);
   bool allow = std::all_of(can_get_cookies_callbacks_.begin(),
                            can_get_cookies_callbacks_.end(),
                            [&ctx](brave::OnCanGetCookiesCallback callback) {
                              return callback.Run(ctx);
                            });
 
-  base::RepeatingCallback<content::WebContents*(void)> wc_getter =
-      base::BindRepeating(&GetWebContentsFromProcessAndFrameId,
-                          ctx->render_process_id, ctx->render_frame_id);
-  base::PostTaskWithTraits(
-      FROM_HERE, {BrowserThread::UI},
-      base::BindOnce(&TabSpecificContentSettings::CookiesRead, wc_getter,
-                     request.url(), request.site_for_cookies(), cookie_list,
-                     !allow));
+  cookie_access_reporter_.OnCookiesRead(
+      ctx->render_process_id, ctx->render_frame_id, request.url(),
+      request.site_for_cookies(), cookie_list, !allow);
 
   return allow;
 }
@@ -236,10 +249,8 @@ bool BraveNetworkDelegateBase::OnCanSetCookie(
     const net::CanonicalCookie& cookie,
     net::CookieOptions* options,
     bool allowed_from_caller) {
-  std::shared_ptr<brave::BraveRequestInfo> ctx(new brave::BraveRequestInfo());
-  ctx->allow_google_auth = allow_google_auth_;
-  brave::BraveRequestInfo::FillCTXFromRequest(&request, ctx);
-  ctx->event_type = brave::kOnCanSetCookies;
+  std::shared_ptr<brave::BraveRequestInfo> ctx =
+      GetCookieContext(request, brave::kOnCanSetCookies);
 
   bool allow = std::all_of(can_set_cookies_callbacks_.begin(),
                            can_set_cookies_callbacks_.end(),
@@ -247,14 +258,9 @@ bool BraveNetworkDelegateBase::OnCanSetCookie(
                              return callback.Run(ctx);
                            });
 
-  base::RepeatingCallback<content::WebContents*(void)> wc_getter =
-      base::BindRepeating(&GetWebContentsFromProcessAndFrameId,
-                          ctx->render_process_id, ctx->render_frame_id);
-  base::PostTaskWithTraits(
-      FROM_HERE, {BrowserThread::UI},
-      base::BindOnce(&TabSpecificContentSettings::CookieChanged, wc_getter,
-                     request.url(), request.site_for_cookies(), cookie,
-                     !allow));
+  cookie_access_reporter_.OnCookieChanged(
+      ctx->render_process_id, ctx->render_frame_id, request.url(),
+      request.site_for_cookies(), cookie, !allow);
 
   return allow;
 }
@@ -267,10 +273,97 @@ void BraveNetworkDelegateBase::RunCallbackForRequestIdentifier(
   std::move(it->second).Run(rv);
 }
 
+void BraveNetworkDelegateBase::AddBeforeURLRequestCallback(
+    const char* helper_name,
+    const brave::OnBeforeURLRequestCallback& callback) {
+  before_url_request_callbacks_.push_back(callback);
+  before_url_request_metrics_.push_back(CreateHelperMetrics(helper_name));
+}
+
+void BraveNetworkDelegateBase::AddBeforeStartTransactionCallback(
+    const char* helper_name,
+    const brave::OnBeforeStartTransactionCallback& callback) {
+  before_start_transaction_callbacks_.push_back(callback);
+  before_start_transaction_metrics_.push_back(
+      CreateHelperMetrics(helper_name));
+}
+
+void BraveNetworkDelegateBase::AddSyncHeadersReceivedCallback(
+    const char* helper_name,
+    const brave::OnHeadersReceivedCallback& callback) {
+  headers_received_callbacks_.push_back(callback);
+  headers_received_metrics_.push_back(CreateHelperMetrics(helper_name));
+  sync_headers_received_callbacks_count_++;
+}
+
+// static
+BraveNetworkDelegateBase::HelperMetrics
+BraveNetworkDelegateBase::CreateHelperMetrics(const char* helper_name) {
+  // Looked up once here, so recording costs no more than the macros do.
+  // Helpers mostly run in well under a millisecond, so their run time has
+  // the buckets of UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES. The callback
+  // delay has those of UMA_HISTOGRAM_MEDIUM_TIMES.
+  const std::string prefix = kHelperHistogramPrefix + std::string(helper_name);
+  HelperMetrics metrics;
+  metrics.name = helper_name;
+  metrics.run_time = base::Histogram::FactoryMicrosecondsTimeGet(
+      prefix + ".RunTime", base::TimeDelta::FromMicroseconds(1),
+      base::TimeDelta::FromSeconds(1), 50,
+      base::HistogramBase::kUmaTargetedHistogramFlag);
+  metrics.callback_delay = base::Histogram::FactoryTimeGet(
+      prefix + ".CallbackDelay", base::TimeDelta::FromMilliseconds(10),
+      base::TimeDelta::FromMinutes(3), 50,
+      base::HistogramBase::kUmaTargetedHistogramFlag);
+  return metrics;
+}
+
+const BraveNetworkDelegateBase::HelperMetrics&
+BraveNetworkDelegateBase::GetHelperMetrics(
+    brave::BraveNetworkDelegateEventType event_type,
+    size_t index) const {
+  switch (event_type) {
+    case brave::kOnBeforeStartTransaction:
+      return before_start_transaction_metrics_[index];
+    case brave::kOnHeadersReceived:
+      return headers_received_metrics_[index];
+    default:
+      DCHECK_EQ(brave::kOnBeforeRequest, event_type);
+      return before_url_request_metrics_[index];
+  }
+}
+
+void BraveNetworkDelegateBase::OnHelperRun(const HelperMetrics& metrics,
+                                           base::TimeTicks start,
+                                           int rv,
+                                           brave::BraveRequestInfo* ctx) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  // Dropped on clients without a high resolution clock.
+  metrics.run_time->AddTimeMicrosecondsGranularity(now - start);
+  if (rv == net::ERR_IO_PENDING) {
+    ctx->helper_pending_since = now;
+    TRACE_EVENT_ASYNC_BEGIN0("net", metrics.name,
+                             ctx->request_identifier);
+  }
+}
+
+void BraveNetworkDelegateBase::OnHelperResumed(brave::BraveRequestInfo* ctx) {
+  if (ctx->helper_pending_since.is_null()) {
+    return;
+  }
+  // The pending helper is the last one the chain ran.
+  const HelperMetrics& metrics =
+      GetHelperMetrics(ctx->event_type, ctx->next_url_request_index - 1);
+  metrics.callback_delay->AddTime(base::TimeTicks::Now() -
+                                  ctx->helper_pending_since);
+  TRACE_EVENT_ASYNC_END0("net", metrics.name, ctx->request_identifier);
+  ctx->helper_pending_since = base::TimeTicks();
+}
+
 void BraveNetworkDelegateBase::RunNextCallback(
     URLRequest* request,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  OnHelperResumed(ctx.get());
 
   if (!ContainsKey(callbacks_, ctx->request_identifier)) {
     return;
@@ -282,16 +375,22 @@ void BraveNetworkDelegateBase::RunNextCallback(
 
   // Continue processing callbacks until we hit one that returns PENDING
   int rv = net::OK;
+  // Every callback of the chain resumes it the same way.
+  brave::ResponseCallback next_callback =
+      base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
+                 base::Unretained(this), request, ctx);
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
     while (before_url_request_callbacks_.size() !=
            ctx->next_url_request_index) {
+      const HelperMetrics& metrics =
+          before_url_request_metrics_[ctx->next_url_request_index];
       brave::OnBeforeURLRequestCallback callback =
           before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-                     base::Unretained(this), request, ctx);
+      TRACE_EVENT0("net", metrics.name);
+      const base::TimeTicks start = base::TimeTicks::Now();
       rv = callback.Run(next_callback, ctx);
+      OnHelperRun(metrics, start, rv, ctx.get());
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -302,12 +401,14 @@ void BraveNetworkDelegateBase::RunNextCallback(
   } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
     while (before_start_transaction_callbacks_.size() !=
            ctx->next_url_request_index) {
+      const HelperMetrics& metrics =
+          before_start_transaction_metrics_[ctx->next_url_request_index];
       brave::OnBeforeStartTransactionCallback callback =
           before_start_transaction_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-                     base::Unretained(this), request, ctx);
+      TRACE_EVENT0("net", metrics.name);
+      const base::TimeTicks start = base::TimeTicks::Now();
       rv = callback.Run(request, ctx->headers, next_callback, ctx);
+      OnHelperRun(metrics, start, rv, ctx.get());
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -317,14 +418,16 @@ void BraveNetworkDelegateBase::RunNextCallback(
     }
   } else if (ctx->event_type == brave::kOnHeadersReceived) {
     while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
+      const HelperMetrics& metrics =
+          headers_received_metrics_[ctx->next_url_request_index];
       brave::OnHeadersReceivedCallback callback =
           headers_received_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-                     base::Unretained(this), request, ctx);
+      TRACE_EVENT0("net", metrics.name);
+      const base::TimeTicks start = base::TimeTicks::Now();
       rv = callback.Run(request, ctx->original_response_headers,
                         ctx->override_response_headers,
                         ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+      OnHelperRun(metrics, start, rv, ctx.get());
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -378,10 +481,42 @@ void BraveNetworkDelegateBase::RunNextCallback(
   }
 }
 
+std::shared_ptr<brave::BraveRequestInfo>
+BraveNetworkDelegateBase::GetRequestContext(
+    const URLRequest* request,
+    brave::BraveNetworkDelegateEventType event_type) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  std::shared_ptr<brave::BraveRequestInfo>& ctx =
+      request_contexts_[request->identifier()];
+  if (!ctx) {
+    ctx = std::make_shared<brave::BraveRequestInfo>();
+  }
+  // Re-read the URL and the shields settings on every event, both can change
+  // between the events of one request.
+  brave::BraveRequestInfo::FillCTXFromRequest(request, ctx);
+  brave::BraveRequestInfo::ResetCTXForEvent(event_type, ctx);
+  return ctx;
+}
+
+std::shared_ptr<brave::BraveRequestInfo>
+BraveNetworkDelegateBase::GetCookieContext(
+    const URLRequest& request,
+    brave::BraveNetworkDelegateEventType event_type) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  // Cookie checks can run while another event of |request| is still pending
+  // on the shared context, so they get a context of their own.
+  auto ctx = std::make_shared<brave::BraveRequestInfo>();
+  brave::BraveRequestInfo::FillCTXFromRequest(&request, ctx);
+  ctx->event_type = event_type;
+  ctx->allow_google_auth = allow_google_auth_;
+  return ctx;
+}
+
 void BraveNetworkDelegateBase::OnURLRequestDestroyed(URLRequest* request) {
   if (ContainsKey(callbacks_, request->identifier())) {
     callbacks_.erase(request->identifier());
   }
+  request_contexts_.erase(request->identifier());
   ChromeNetworkDelegate::OnURLRequestDestroyed(request);
 }
 
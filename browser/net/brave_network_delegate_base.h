@@ -13,6 +13,8 @@
 
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
+#include "base/time/time.h"
+#include "brave/browser/net/cookie_access_reporter.h"
 #include "brave/browser/net/url_context.h"
 #include "chrome/browser/net/chrome_network_delegate.h"
 #include "content/public/browser/browser_thread.h"
@@ -20,6 +22,10 @@
 
 class PrefChangeRegistrar;
 
+namespace base {
+class HistogramBase;
+}
+
 namespace extensions {
 class EventRouterForwarder;
 }
@@ -78,19 +84,72 @@ class BraveNetworkDelegateBase : public ChromeNetworkDelegate {
  protected:
   void RunNextCallback(net::URLRequest* request,
                        std::shared_ptr<brave::BraveRequestInfo> ctx);
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
-  std::vector<brave::OnBeforeStartTransactionCallback>
-      before_start_transaction_callbacks_;
-  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
+  // Helpers run in the order they are added. |helper_name| must be a string
+  // literal, it names the helper's trace events in the "net" category and
+  // its Brave.NetworkDelegate.<helper_name>.* histograms.
+  void AddBeforeURLRequestCallback(
+      const char* helper_name,
+      const brave::OnBeforeURLRequestCallback& callback);
+  void AddBeforeStartTransactionCallback(
+      const char* helper_name,
+      const brave::OnBeforeStartTransactionCallback& callback);
+  // Registers a headers received helper that never runs |next_callback|
+  // before returning. While every helper is registered this way the chain
+  // runs inline in OnHeadersReceived instead of from a posted task.
+  void AddSyncHeadersReceivedCallback(
+      const char* helper_name,
+      const brave::OnHeadersReceivedCallback& callback);
   std::vector<brave::OnCanGetCookiesCallback> can_get_cookies_callbacks_;
   std::vector<brave::OnCanSetCookiesCallback> can_set_cookies_callbacks_;
 
  private:
+  // Trace name and histograms of a registered helper, kept at the same index
+  // as its callback.
+  struct HelperMetrics {
+    const char* name;
+    // Time spent in the helper before it returned.
+    base::HistogramBase* run_time;
+    // Time from the helper returning ERR_IO_PENDING to it resuming the chain.
+    base::HistogramBase* callback_delay;
+  };
+
+  static HelperMetrics CreateHelperMetrics(const char* helper_name);
+  const HelperMetrics& GetHelperMetrics(
+      brave::BraveNetworkDelegateEventType event_type,
+      size_t index) const;
+  // Records a helper that started at |start| and returned |rv|.
+  void OnHelperRun(const HelperMetrics& metrics,
+                   base::TimeTicks start,
+                   int rv,
+                   brave::BraveRequestInfo* ctx);
+  // Records the delay of the helper |ctx| is waiting on, if any.
+  void OnHelperResumed(brave::BraveRequestInfo* ctx);
+  // Returns the context of |request|, refreshed and reset for |event_type|.
+  std::shared_ptr<brave::BraveRequestInfo> GetRequestContext(
+      const net::URLRequest* request,
+      brave::BraveNetworkDelegateEventType event_type);
+  // Returns a new context of |request| for the cookie event |event_type|.
+  std::shared_ptr<brave::BraveRequestInfo> GetCookieContext(
+      const net::URLRequest& request,
+      brave::BraveNetworkDelegateEventType event_type);
   void InitPrefChangeRegistrarOnUI();
   void OnPreferenceChanged(const std::string& pref_name);
   void UpdateAdBlockFromPref(const std::string& pref_name);
 
+  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
+  std::vector<brave::OnBeforeStartTransactionCallback>
+      before_start_transaction_callbacks_;
+  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
+  std::vector<HelperMetrics> before_url_request_metrics_;
+  std::vector<HelperMetrics> before_start_transaction_metrics_;
+  std::vector<HelperMetrics> headers_received_metrics_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  size_t sync_headers_received_callbacks_count_;
+  brave::CookieAccessReporter cookie_access_reporter_;
+  // One context per in-flight request, shared by its non-cookie events and
+  // freed in OnURLRequestDestroyed.
+  std::map<uint64_t, std::shared_ptr<brave::BraveRequestInfo>>
+      request_contexts_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       user_pref_change_registrar_;
 
@@ -37,48 +37,45 @@
 BraveProfileNetworkDelegate::BraveProfileNetworkDelegate(
     extensions::EventRouterForwarder* event_router) :
     BraveNetworkDelegateBase(event_router) {
-  brave::OnBeforeURLRequestCallback
-  callback =
-      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_SiteHacksWork",
+      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork));
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_AdBlockTPPreWork",
+      base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork));
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_HttpsePreFileWork",
+      base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork));
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_CommonStaticRedirectWork",
+      base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork));
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
-  callback = base::Bind(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_RewardsWork",
+      base::Bind(brave_rewards::OnBeforeURLRequest));
 #endif
 
 #if BUILDFLAG(ENABLE_TOR)
-  callback = base::Bind(brave::OnBeforeURLRequest_TorWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_TorWork",
+      base::Bind(brave::OnBeforeURLRequest_TorWork));
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
-  callback = base::BindRepeating(
-      brave::OnBeforeURLRequest_TranslateRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_TranslateRedirectWork",
+      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork));
 #endif
 
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  AddBeforeStartTransactionCallback(
+      "OnBeforeStartTransaction_SiteHacksWork",
+      base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork));
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::Bind(
-          webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+  AddSyncHeadersReceivedCallback(
+      "OnHeadersReceived_TorrentRedirectWork",
+      base::Bind(webtorrent::OnHeadersReceived_TorrentRedirectWork));
 #endif
 
   brave::OnCanGetCookiesCallback get_cookies_callback =
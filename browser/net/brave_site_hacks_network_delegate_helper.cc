@@ -8,6 +8,9 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_util.h"
 #include "brave/common/network_constants.h"
@@ -29,6 +32,53 @@ namespace brave {
 
 namespace {
 
+// Hack bits for the hosts in SiteHacks.
+enum SiteHackType {
+  kCookieOverrideHack = 1 << 0,
+  kBlockTwitterRedirectHack = 1 << 1,
+};
+
+// The site hack patterns, compiled once and dispatched on the host they
+// apply to, so a request to any other host costs a single lookup.
+class SiteHacks {
+ public:
+  SiteHacks()
+      : forbes_pattern_(URLPattern::SCHEME_ALL, kForbesPattern),
+        twitter_redirect_pattern_(URLPattern::SCHEME_ALL,
+                                  kTwitterRedirectURL),
+        twitter_referrer_pattern_(URLPattern::SCHEME_ALL, kTwitterReferrer) {
+    hacks_by_host_[forbes_pattern_.host()] |= kCookieOverrideHack;
+    hacks_by_host_[twitter_redirect_pattern_.host()] |=
+        kBlockTwitterRedirectHack;
+  }
+
+  static const SiteHacks& GetInstance() {
+    static base::NoDestructor<SiteHacks> instance;
+    return *instance;
+  }
+
+  int GetHacksForHost(const std::string& host) const {
+    auto it = hacks_by_host_.find(host);
+    return it == hacks_by_host_.end() ? 0 : it->second;
+  }
+
+  const URLPattern& forbes_pattern() const { return forbes_pattern_; }
+  const URLPattern& twitter_redirect_pattern() const {
+    return twitter_redirect_pattern_;
+  }
+  const URLPattern& twitter_referrer_pattern() const {
+    return twitter_referrer_pattern_;
+  }
+
+ private:
+  const URLPattern forbes_pattern_;
+  const URLPattern twitter_redirect_pattern_;
+  const URLPattern twitter_referrer_pattern_;
+  base::flat_map<std::string, int> hacks_by_host_;
+
+  DISALLOW_COPY_AND_ASSIGN(SiteHacks);
+};
+
 bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx,
                                  net::URLRequest* request) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
@@ -37,16 +87,12 @@ bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx,
   if (tab_origin.SchemeIs(kChromeExtensionScheme)) {
     return false;
   }
-  bool allow_referrers = brave_shields::IsAllowContentSettingFromIO(
-      request, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kReferrers);
-  bool shields_up = brave_shields::IsAllowContentSettingFromIO(
-      request, tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kBraveShields);
+  // The settings were resolved for the tab origin when |ctx| was filled.
   const std::string original_referrer = request->referrer();
   Referrer new_referrer;
-  if (brave_shields::ShouldSetReferrer(allow_referrers, shields_up,
-          GURL(original_referrer), tab_origin, request->url(), target_origin,
+  if (brave_shields::ShouldSetReferrer(ctx->allow_referrers,
+          ctx->allow_brave_shields, GURL(original_referrer), tab_origin,
+          request->url(), target_origin,
           Referrer::NetReferrerPolicyToBlinkReferrerPolicy(
               request->referrer_policy()), &new_referrer)) {
     request->SetReferrer(new_referrer.url.spec());
@@ -55,15 +101,6 @@ bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx,
   return false;
 }
 
-}  // namespace
-
-int OnBeforeURLRequest_SiteHacksWork(
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx) {
-  ApplyPotentialReferrerBlock(ctx, const_cast<net::URLRequest*>(ctx->request));
-  return net::OK;
-}
-
 void CheckForCookieOverride(const GURL& url, const URLPattern& pattern,
     net::HttpRequestHeaders* headers, const std::string& extra_cookies) {
   if (pattern.MatchesURL(url)) {
@@ -76,28 +113,43 @@ void CheckForCookieOverride(const GURL& url, const URLPattern& pattern,
   }
 }
 
-bool IsBlockTwitterSiteHack(net::URLRequest* request,
+bool IsBlockTwitterSiteHack(const SiteHacks& site_hacks,
+    net::URLRequest* request,
     net::HttpRequestHeaders* headers) {
-  URLPattern redirectURLPattern(URLPattern::SCHEME_ALL, kTwitterRedirectURL);
-  URLPattern referrerPattern(URLPattern::SCHEME_ALL, kTwitterReferrer);
-  if (redirectURLPattern.MatchesURL(request->url())) {
+  if (site_hacks.twitter_redirect_pattern().MatchesURL(request->url())) {
     std::string referrer;
     if (headers->GetHeader(kRefererHeader, &referrer) &&
-        referrerPattern.MatchesURL(GURL(referrer))) {
+        site_hacks.twitter_referrer_pattern().MatchesURL(GURL(referrer))) {
       return true;
     }
   }
   return false;
 }
 
+}  // namespace
+
+int OnBeforeURLRequest_SiteHacksWork(
+    const ResponseCallback& next_callback,
+    std::shared_ptr<BraveRequestInfo> ctx) {
+  ApplyPotentialReferrerBlock(ctx, const_cast<net::URLRequest*>(ctx->request));
+  return net::OK;
+}
+
 int OnBeforeStartTransaction_SiteHacksWork(net::URLRequest* request,
         net::HttpRequestHeaders* headers,
         const ResponseCallback& next_callback,
         std::shared_ptr<BraveRequestInfo> ctx) {
-  CheckForCookieOverride(request->url(),
-      URLPattern(URLPattern::SCHEME_ALL, kForbesPattern), headers,
-      kForbesExtraCookies);
-  if (IsBlockTwitterSiteHack(request, headers)) {
+  const SiteHacks& site_hacks = SiteHacks::GetInstance();
+  const int hacks = site_hacks.GetHacksForHost(request->url().host());
+  if (!hacks)
+    return net::OK;
+
+  if (hacks & kCookieOverrideHack) {
+    CheckForCookieOverride(request->url(), site_hacks.forbes_pattern(),
+        headers, kForbesExtraCookies);
+  }
+  if ((hacks & kBlockTwitterRedirectHack) &&
+      IsBlockTwitterSiteHack(site_hacks, request, headers)) {
     return net::ERR_ABORTED;
   }
   return net::OK;
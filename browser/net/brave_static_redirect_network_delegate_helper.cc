@@ -5,109 +5,86 @@
 
 #include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
+#include "base/macros.h"
+#include "base/no_destructor.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
+#include "brave/common/url_pattern_host_index.h"
 #include "extensions/common/url_pattern.h"
 
 namespace brave {
 
-int OnBeforeURLRequest_StaticRedirectWork(
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx) {
-  GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingFileCheckPrefix);
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
+namespace {
+
+enum class StaticRedirect {
+  kGeoLocation,
+  kSafeBrowsing,
+  kSafeBrowsingFileCheck,
+  kCRXDownload,
+  kCRLSet,
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
-  static URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateElementJSPattern);
-  static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateLanguagePattern);
+  kTranslate,
+  kTranslateLanguage,
+#endif
+};
+
+// All static redirect rules in priority order, indexed by host so most
+// requests are rejected with a single lookup.
+class StaticRedirectTable {
+ public:
+  StaticRedirectTable() {
+    Add(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern,
+        StaticRedirect::kGeoLocation);
+    AddHostOnly(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix,
+                StaticRedirect::kSafeBrowsing);
+    AddHostOnly(URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix,
+                StaticRedirect::kSafeBrowsingFileCheck);
+    const int http_or_https = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+    Add(http_or_https, kCRXDownloadPrefix, StaticRedirect::kCRXDownload);
+    Add(http_or_https, kCRLSetPrefix1, StaticRedirect::kCRLSet);
+    Add(http_or_https, kCRLSetPrefix2, StaticRedirect::kCRLSet);
+    Add(http_or_https, kCRLSetPrefix3, StaticRedirect::kCRLSet);
+    Add(http_or_https, kCRLSetPrefix4, StaticRedirect::kCRLSet);
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
+    Add(URLPattern::SCHEME_HTTPS, kTranslateElementJSPattern,
+        StaticRedirect::kTranslate);
+    Add(URLPattern::SCHEME_HTTPS, kTranslateLanguagePattern,
+        StaticRedirect::kTranslateLanguage);
 #endif
-  if (geo_pattern.MatchesURL(ctx->request_url)) {
-    ctx->new_url_spec = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY).spec();
-    return net::OK;
-  }
-
-  if (safeBrowsing_pattern.MatchesHost(ctx->request_url)) {
-    replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
-  }
-
-  if (safebrowsingfilecheck_pattern.MatchesHost(ctx->request_url)) {
-    replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
-  }
-
-  if (crxDownload_pattern.MatchesURL(ctx->request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crxdownload.brave.com");
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
   }
 
-  if (crlSet_pattern1.MatchesURL(ctx->request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
+  bool Match(const GURL& url, StaticRedirect* redirect) const {
+    size_t position = patterns_.Match(url);
+    if (position == URLPatternHostIndex::kNoMatch)
+      return false;
+    *redirect = redirects_[position];
+    return true;
   }
 
-  if (crlSet_pattern2.MatchesURL(ctx->request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
+ private:
+  void Add(int schemes, const char* pattern, StaticRedirect redirect) {
+    patterns_.Add(URLPattern(schemes, pattern));
+    redirects_.push_back(redirect);
   }
 
-  if (crlSet_pattern3.MatchesURL(ctx->request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
+  void AddHostOnly(int schemes, const char* pattern, StaticRedirect redirect) {
+    patterns_.AddHostOnly(URLPattern(schemes, pattern));
+    redirects_.push_back(redirect);
   }
 
-  if (crlSet_pattern4.MatchesURL(ctx->request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
-    return net::OK;
-  }
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
-  if (translate_pattern.MatchesURL(ctx->request_url)) {
-    replacements.SetQueryStr(ctx->request_url.query_piece());
-    replacements.SetPathStr(ctx->request_url.path_piece());
-    ctx->new_url_spec =
-      GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements).spec();
-    return net::OK;
-  }
+  URLPatternHostIndex patterns_;
+  std::vector<StaticRedirect> redirects_;
 
-  if (translate_language_pattern.MatchesURL(ctx->request_url)) {
-    ctx->new_url_spec = GURL(kBraveTranslateLanguageEndpoint).spec();
-    return net::OK;
-  }
-#endif
+  DISALLOW_COPY_AND_ASSIGN(StaticRedirectTable);
+};
 
 #if !defined(NDEBUG)
-  GURL gurl = ctx->request_url;
+void CheckAllowedURL(const GURL& gurl) {
   static std::vector<URLPattern> allowed_patterns({
       // Brave updates
       URLPattern(URLPattern::SCHEME_HTTPS, "https://go-updater.brave.com/*"),
@@ -180,8 +157,62 @@ int OnBeforeURLRequest_StaticRedirectWork(
   // http://192.168.0.27:60000/upnp/dev/e16bf493-ed87-5798-ffff-ffffeb4f1c34/desc
   // And also I don't know where they're from, but there's always 3 requests
   // similar to this: http://vijscbncpv/
+}
 #endif
 
+}  // namespace
+
+int OnBeforeURLRequest_StaticRedirectWork(
+    const ResponseCallback& next_callback,
+    std::shared_ptr<BraveRequestInfo> ctx) {
+  static base::NoDestructor<StaticRedirectTable> static_redirects;
+  StaticRedirect redirect;
+  if (!static_redirects->Match(ctx->request_url, &redirect)) {
+#if !defined(NDEBUG)
+    CheckAllowedURL(ctx->request_url);
+#endif
+    return net::OK;
+  }
+
+  GURL::Replacements replacements;
+  switch (redirect) {
+    case StaticRedirect::kGeoLocation:
+      ctx->new_url_spec = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY).spec();
+      break;
+    case StaticRedirect::kSafeBrowsing:
+      replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
+      ctx->new_url_spec =
+          ctx->request_url.ReplaceComponents(replacements).spec();
+      break;
+    case StaticRedirect::kSafeBrowsingFileCheck:
+      replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
+      ctx->new_url_spec =
+          ctx->request_url.ReplaceComponents(replacements).spec();
+      break;
+    case StaticRedirect::kCRXDownload:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr("crxdownload.brave.com");
+      ctx->new_url_spec =
+          ctx->request_url.ReplaceComponents(replacements).spec();
+      break;
+    case StaticRedirect::kCRLSet:
+      replacements.SetSchemeStr("https");
+      replacements.SetHostStr("crlsets.brave.com");
+      ctx->new_url_spec =
+          ctx->request_url.ReplaceComponents(replacements).spec();
+      break;
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE)
+    case StaticRedirect::kTranslate:
+      replacements.SetQueryStr(ctx->request_url.query_piece());
+      replacements.SetPathStr(ctx->request_url.path_piece());
+      ctx->new_url_spec =
+        GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements).spec();
+      break;
+    case StaticRedirect::kTranslateLanguage:
+      ctx->new_url_spec = GURL(kBraveTranslateLanguageEndpoint).spec();
+      break;
+#endif
+  }
   return net::OK;
 }
 
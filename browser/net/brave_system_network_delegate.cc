@@ -10,13 +10,12 @@
 BraveSystemNetworkDelegate::BraveSystemNetworkDelegate(
     extensions::EventRouterForwarder* event_router) :
     BraveNetworkDelegateBase(event_router) {
-  brave::OnBeforeURLRequestCallback callback =
-      base::Bind(
-          brave::OnBeforeURLRequest_StaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
-  callback = base::Bind(
-          brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_StaticRedirectWork",
+      base::Bind(brave::OnBeforeURLRequest_StaticRedirectWork));
+  AddBeforeURLRequestCallback(
+      "OnBeforeURLRequest_CommonStaticRedirectWork",
+      base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork));
 }
 
 BraveSystemNetworkDelegate::~BraveSystemNetworkDelegate() {
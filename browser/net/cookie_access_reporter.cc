@@ -0,0 +1,158 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/cookie_access_reporter.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "chrome/browser/content_settings/tab_specific_content_settings.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+
+using content::BrowserThread;
+
+namespace brave {
+
+namespace {
+
+// How long cookie accesses are collected before they are sent to the UI
+// thread. Only feeds the page info cookie indicators, so a short lag is fine.
+constexpr base::TimeDelta kCookieAccessReportDelay =
+    base::TimeDelta::FromMilliseconds(100);
+
+content::WebContents* GetWebContentsFromProcessAndFrameId(int render_process_id,
+                                                          int render_frame_id) {
+  if (render_process_id) {
+    content::RenderFrameHost* rfh =
+        content::RenderFrameHost::FromID(render_process_id, render_frame_id);
+    return content::WebContents::FromRenderFrameHost(rfh);
+  }
+  // TODO(iefremov): Seems like a typo?
+  // issues/2263
+  return content::WebContents::FromFrameTreeNodeId(render_frame_id);
+}
+
+}  // namespace
+
+CookieAccessReporter::CookieAccess::CookieAccess() = default;
+CookieAccessReporter::CookieAccess::CookieAccess(CookieAccess&& other) =
+    default;
+CookieAccessReporter::CookieAccess&
+CookieAccessReporter::CookieAccess::operator=(CookieAccess&& other) = default;
+CookieAccessReporter::CookieAccess::~CookieAccess() = default;
+
+CookieAccessReporter::CookieAccessReporter() {}
+
+CookieAccessReporter::~CookieAccessReporter() {
+  Flush();
+}
+
+void CookieAccessReporter::OnCookiesRead(int render_process_id,
+                                         int render_frame_id,
+                                         const GURL& url,
+                                         const GURL& site_for_cookies,
+                                         const net::CookieList& cookie_list,
+                                         bool blocked_by_policy) {
+  AddAccess(render_process_id, render_frame_id, true, url, site_for_cookies,
+            cookie_list, blocked_by_policy);
+}
+
+void CookieAccessReporter::OnCookieChanged(int render_process_id,
+                                           int render_frame_id,
+                                           const GURL& url,
+                                           const GURL& site_for_cookies,
+                                           const net::CanonicalCookie& cookie,
+                                           bool blocked_by_policy) {
+  AddAccess(render_process_id, render_frame_id, false, url, site_for_cookies,
+            {cookie}, blocked_by_policy);
+}
+
+// static
+void CookieAccessReporter::AddToBatch(CookieAccessBatch* batch,
+                                      const FrameKey& frame,
+                                      CookieAccess access) {
+  std::vector<CookieAccess>& accesses = (*batch)[frame];
+  // Subresources from the same origin usually read the same cookies over and
+  // over, fold them into the previous read.
+  if (access.is_read && !accesses.empty()) {
+    CookieAccess& last = accesses.back();
+    if (last.is_read && last.blocked_by_policy == access.blocked_by_policy &&
+        last.url == access.url &&
+        last.site_for_cookies == access.site_for_cookies) {
+      last.cookie_list.insert(last.cookie_list.end(),
+                              access.cookie_list.begin(),
+                              access.cookie_list.end());
+      return;
+    }
+  }
+  accesses.push_back(std::move(access));
+}
+
+void CookieAccessReporter::AddAccess(int render_process_id,
+                                     int render_frame_id,
+                                     bool is_read,
+                                     const GURL& url,
+                                     const GURL& site_for_cookies,
+                                     const net::CookieList& cookie_list,
+                                     bool blocked_by_policy) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  CookieAccess access;
+  access.is_read = is_read;
+  access.url = url;
+  access.site_for_cookies = site_for_cookies;
+  access.cookie_list = cookie_list;
+  access.blocked_by_policy = blocked_by_policy;
+  AddToBatch(&pending_, FrameKey(render_process_id, render_frame_id),
+             std::move(access));
+  ScheduleFlush();
+}
+
+void CookieAccessReporter::ScheduleFlush() {
+  if (flush_timer_.IsRunning()) {
+    return;
+  }
+  flush_timer_.Start(FROM_HERE, kCookieAccessReportDelay,
+                     base::Bind(&CookieAccessReporter::Flush,
+                                base::Unretained(this)));
+}
+
+void CookieAccessReporter::Flush() {
+  if (pending_.empty()) {
+    return;
+  }
+  CookieAccessBatch batch;
+  batch.swap(pending_);
+  base::PostTaskWithTraits(
+      FROM_HERE, {BrowserThread::UI},
+      base::BindOnce(&CookieAccessReporter::ReportOnUIThread,
+                     std::move(batch)));
+}
+
+// static
+void CookieAccessReporter::ReportOnUIThread(CookieAccessBatch batch) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  for (const auto& frame : batch) {
+    base::RepeatingCallback<content::WebContents*(void)> wc_getter =
+        base::BindRepeating(&GetWebContentsFromProcessAndFrameId,
+                            frame.first.first, frame.first.second);
+    for (const CookieAccess& access : frame.second) {
+      if (access.is_read) {
+        TabSpecificContentSettings::CookiesRead(
+            wc_getter, access.url, access.site_for_cookies,
+            access.cookie_list, access.blocked_by_policy);
+      } else {
+        TabSpecificContentSettings::CookieChanged(
+            wc_getter, access.url, access.site_for_cookies,
+            access.cookie_list.front(), access.blocked_by_policy);
+      }
+    }
+  }
+}
+
+}  // namespace brave
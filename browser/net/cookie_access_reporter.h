@@ -0,0 +1,87 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_COOKIE_ACCESS_REPORTER_H_
+#define BRAVE_BROWSER_NET_COOKIE_ACCESS_REPORTER_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/timer/timer.h"
+#include "net/cookies/canonical_cookie.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+// Collects the cookie reads and writes seen by the network delegate on the IO
+// thread and hands them to TabSpecificContentSettings in one UI task per
+// tick, instead of posting a task for every single access.
+class CookieAccessReporter {
+ public:
+  struct CookieAccess {
+    CookieAccess();
+    CookieAccess(CookieAccess&& other);
+    CookieAccess& operator=(CookieAccess&& other);
+    ~CookieAccess();
+
+    bool is_read = false;
+    GURL url;
+    GURL site_for_cookies;
+    // Every cookie read for |url| in the batch, or the single cookie set.
+    net::CookieList cookie_list;
+    bool blocked_by_policy = false;
+
+    DISALLOW_COPY_AND_ASSIGN(CookieAccess);
+  };
+
+  // Keyed by (render_process_id, render_frame_id).
+  using FrameKey = std::pair<int, int>;
+  using CookieAccessBatch = std::map<FrameKey, std::vector<CookieAccess>>;
+
+  CookieAccessReporter();
+  ~CookieAccessReporter();
+
+  void OnCookiesRead(int render_process_id,
+                     int render_frame_id,
+                     const GURL& url,
+                     const GURL& site_for_cookies,
+                     const net::CookieList& cookie_list,
+                     bool blocked_by_policy);
+  void OnCookieChanged(int render_process_id,
+                       int render_frame_id,
+                       const GURL& url,
+                       const GURL& site_for_cookies,
+                       const net::CanonicalCookie& cookie,
+                       bool blocked_by_policy);
+
+  // Appends |access| to the accesses of |frame| in |batch|. A read that
+  // repeats the previous read of the frame is folded into it.
+  static void AddToBatch(CookieAccessBatch* batch,
+                         const FrameKey& frame,
+                         CookieAccess access);
+
+ private:
+  void AddAccess(int render_process_id,
+                 int render_frame_id,
+                 bool is_read,
+                 const GURL& url,
+                 const GURL& site_for_cookies,
+                 const net::CookieList& cookie_list,
+                 bool blocked_by_policy);
+  void ScheduleFlush();
+  void Flush();
+  static void ReportOnUIThread(CookieAccessBatch batch);
+
+  CookieAccessBatch pending_;
+  base::OneShotTimer flush_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(CookieAccessReporter);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_COOKIE_ACCESS_REPORTER_H_
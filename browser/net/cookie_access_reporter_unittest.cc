@@ -0,0 +1,113 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/cookie_access_reporter.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/time/time.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_options.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=CookieAccessReporterTest.*
+
+using brave::CookieAccessReporter;
+
+namespace {
+
+const char kFirstPartyUrl[] = "https://firstparty.com/";
+const char kSubresourceUrl[] = "https://firstparty.com/script.js";
+const char kOtherSubresourceUrl[] = "https://firstparty.com/style.css";
+
+const CookieAccessReporter::FrameKey kFrame(1, 2);
+const CookieAccessReporter::FrameKey kOtherFrame(1, 3);
+
+net::CanonicalCookie CreateCookie(const std::string& cookie_line) {
+  std::unique_ptr<net::CanonicalCookie> cookie = net::CanonicalCookie::Create(
+      GURL(kSubresourceUrl), cookie_line, base::Time::Now(),
+      net::CookieOptions());
+  return *cookie;
+}
+
+CookieAccessReporter::CookieAccess CreateAccess(bool is_read,
+                                                const std::string& url,
+                                                const std::string& cookie_line,
+                                                bool blocked_by_policy) {
+  CookieAccessReporter::CookieAccess access;
+  access.is_read = is_read;
+  access.url = GURL(url);
+  access.site_for_cookies = GURL(kFirstPartyUrl);
+  access.cookie_list.push_back(CreateCookie(cookie_line));
+  access.blocked_by_policy = blocked_by_policy;
+  return access;
+}
+
+}  // namespace
+
+TEST(CookieAccessReporterTest, FoldsRepeatedReads) {
+  CookieAccessReporter::CookieAccessBatch batch;
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(true, kSubresourceUrl, "a=1", false));
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(true, kSubresourceUrl, "b=2", false));
+
+  ASSERT_EQ(1u, batch[kFrame].size());
+  const CookieAccessReporter::CookieAccess& access = batch[kFrame].front();
+  EXPECT_TRUE(access.is_read);
+  ASSERT_EQ(2u, access.cookie_list.size());
+  EXPECT_EQ("a", access.cookie_list[0].Name());
+  EXPECT_EQ("b", access.cookie_list[1].Name());
+}
+
+TEST(CookieAccessReporterTest, KeepsReadsOfOtherUrlsApart) {
+  CookieAccessReporter::CookieAccessBatch batch;
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(true, kSubresourceUrl, "a=1", false));
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(true, kOtherSubresourceUrl, "a=1", false));
+
+  EXPECT_EQ(2u, batch[kFrame].size());
+}
+
+TEST(CookieAccessReporterTest, KeepsReadsWithOtherOutcomeApart) {
+  CookieAccessReporter::CookieAccessBatch batch;
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(true, kSubresourceUrl, "a=1", false));
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(true, kSubresourceUrl, "a=1", true));
+
+  EXPECT_EQ(2u, batch[kFrame].size());
+}
+
+TEST(CookieAccessReporterTest, NeverFoldsCookieChanges) {
+  CookieAccessReporter::CookieAccessBatch batch;
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(false, kSubresourceUrl, "a=1", false));
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(false, kSubresourceUrl, "a=1", false));
+  // A read after a change is a new entry, so the order is kept.
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(true, kSubresourceUrl, "a=1", false));
+
+  ASSERT_EQ(3u, batch[kFrame].size());
+  EXPECT_FALSE(batch[kFrame][0].is_read);
+  EXPECT_FALSE(batch[kFrame][1].is_read);
+  EXPECT_TRUE(batch[kFrame][2].is_read);
+}
+
+TEST(CookieAccessReporterTest, KeepsFramesApart) {
+  CookieAccessReporter::CookieAccessBatch batch;
+  CookieAccessReporter::AddToBatch(&batch, kFrame,
+      CreateAccess(true, kSubresourceUrl, "a=1", false));
+  CookieAccessReporter::AddToBatch(&batch, kOtherFrame,
+      CreateAccess(true, kSubresourceUrl, "a=1", false));
+
+  EXPECT_EQ(1u, batch[kFrame].size());
+  EXPECT_EQ(1u, batch[kOtherFrame].size());
+}
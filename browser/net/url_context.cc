@@ -13,6 +13,7 @@
 #include "brave/common/url_constants.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/profiles/profile_manager.h"
 #include "components/prefs/testing_pref_service.h"
@@ -52,24 +53,33 @@ void BraveRequestInfo::FillCTXFromRequest(const net::URLRequest* request,
                                      ctx->frame_tree_node_id).GetOrigin();
   }
   ctx->tab_origin = ctx->tab_url.GetOrigin();
-  ctx->allow_brave_shields = brave_shields::IsAllowContentSettingFromIO(
-      request, ctx->tab_origin, ctx->tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kBraveShields) &&
+  const brave_shields::ShieldsSettingsSnapshot settings =
+      brave_shields::GetShieldsSettingsFromIO(request, ctx->tab_origin);
+  ctx->allow_brave_shields = settings.allow_brave_shields &&
     !request->site_for_cookies().SchemeIs(kChromeExtensionScheme);
-  ctx->allow_ads = brave_shields::IsAllowContentSettingFromIO(
-      request, ctx->tab_origin, ctx->tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kAds);
+  ctx->allow_ads = settings.allow_ads;
   ctx->allow_http_upgradable_resource =
-      brave_shields::IsAllowContentSettingFromIO(request, ctx->tab_origin,
-          ctx->tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kHTTPUpgradableResources);
-  ctx->allow_1p_cookies = brave_shields::IsAllowContentSettingFromIO(
-      request, ctx->tab_origin, GURL("https://firstParty/"),
-      CONTENT_SETTINGS_TYPE_PLUGINS, brave_shields::kCookies);
-  ctx->allow_3p_cookies = brave_shields::IsAllowContentSettingFromIO(
-      request, ctx->tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kCookies);
+      settings.allow_http_upgradable_resource;
+  ctx->allow_1p_cookies = settings.allow_1p_cookies;
+  ctx->allow_3p_cookies = settings.allow_3p_cookies;
+  ctx->allow_referrers = settings.allow_referrers;
   ctx->request = request;
 }
 
+void BraveRequestInfo::ResetCTXForEvent(
+    BraveNetworkDelegateEventType event_type,
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  ctx->event_type = event_type;
+  ctx->next_url_request_index = 0;
+  ctx->new_url_spec.clear();
+  ctx->new_url = nullptr;
+  ctx->headers = nullptr;
+  ctx->original_response_headers = nullptr;
+  ctx->override_response_headers = nullptr;
+  ctx->allowed_unsafe_redirect_url = nullptr;
+  ctx->blocked_by = kNotBlocked;
+  ctx->cancel_request_explicitly = false;
+  ctx->helper_pending_since = base::TimeTicks();
+}
+
 }  // namespace brave
@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 
+#include "base/time/time.h"
 #include "chrome/browser/net/chrome_network_delegate.h"
 #include "content/public/common/resource_type.h"
 #include "net/url_request/url_request.h"
@@ -60,6 +61,7 @@ struct BraveRequestInfo {
   bool allow_http_upgradable_resource = false;
   bool allow_1p_cookies = true;
   bool allow_3p_cookies = false;
+  bool allow_referrers = false;
   bool allow_google_auth = true;
   int render_process_id = 0;
   int render_frame_id = 0;
@@ -73,6 +75,11 @@ struct BraveRequestInfo {
   BraveNetworkDelegateEventType event_type = kUnknownEventType;
   BlockedBy blocked_by = kNotBlocked;
   bool cancel_request_explicitly = false;
+  // Number of times HTTPS Everywhere has upgraded this request. Kept across
+  // events and redirects since the context lives as long as the request.
+  int httpse_redirects_count = 0;
+  // Set while the chain waits on a helper that returned ERR_IO_PENDING.
+  base::TimeTicks helper_pending_since;
   // Default to invalid type for resource_type, so delegate helpers
   // can properly detect that the info couldn't be obtained.
   static constexpr content::ResourceType kInvalidResourceType =
@@ -82,6 +89,11 @@ struct BraveRequestInfo {
   static void FillCTXFromRequest(const net::URLRequest* request,
     std::shared_ptr<brave::BraveRequestInfo> ctx);
 
+  // Clears the per-event results and arguments before |ctx| is reused for
+  // another event of the same request.
+  static void ResetCTXForEvent(BraveNetworkDelegateEventType event_type,
+    std::shared_ptr<brave::BraveRequestInfo> ctx);
+
  private:
   // Please don't add any more friends here if it can be avoided.
   // We should also remove the ones below.
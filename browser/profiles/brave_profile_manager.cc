@@ -5,9 +5,11 @@
 
 #include "brave/browser/profiles/brave_profile_manager.h"
 
+#include <map>
 #include <memory>
 #include <string>
 
+#include "base/macros.h"
 #include "base/metrics/histogram_macros.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/tor/buildflags.h"
@@ -19,9 +21,12 @@
 #include "brave/components/brave_rewards/browser/rewards_service_factory.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_sync/brave_sync_service_factory.h"
 #include "brave/content/browser/webui/brave_shared_resources_data_source.h"
 #include "chrome/browser/browser_process.h"
+#include "chrome/browser/chrome_notification_types.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/common/chrome_constants.h"
 #include "chrome/common/pref_names.h"
 #include "chrome/grit/generated_resources.h"
@@ -30,6 +35,9 @@
 #include "components/safe_browsing/common/safe_browsing_prefs.h"
 #include "components/signin/core/browser/signin_pref_names.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/notification_observer.h"
+#include "content/public/browser/notification_registrar.h"
+#include "content/public/browser/notification_source.h"
 #include "content/public/browser/url_data_source.h"
 #include "content/public/common/webrtc_ip_handling_policy.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -40,8 +48,52 @@
 
 using content::BrowserThread;
 
+// Registers the content settings map of each profile with the shields
+// settings cache, and takes it out again before the profile goes away, so
+// the cache never holds on to a map that has been destroyed.
+class BraveProfileManager::ShieldsSettingsCacheObserver
+    : public content::NotificationObserver {
+ public:
+  ShieldsSettingsCacheObserver() {}
+  ~ShieldsSettingsCacheObserver() override {}
+
+  void StartObserving(Profile* profile) {
+    HostContentSettingsMap* map =
+        HostContentSettingsMapFactory::GetForProfile(profile);
+    brave_shields::ShieldsSettingsCache::GetInstance()->StartObserving(map);
+    maps_[profile] = map;
+    registrar_.Add(this, chrome::NOTIFICATION_PROFILE_DESTROYED,
+                   content::Source<Profile>(profile));
+  }
+
+  // content::NotificationObserver:
+  void Observe(int type,
+               const content::NotificationSource& source,
+               const content::NotificationDetails& details) override {
+    DCHECK_EQ(chrome::NOTIFICATION_PROFILE_DESTROYED, type);
+    Profile* profile = content::Source<Profile>(source).ptr();
+    auto it = maps_.find(profile);
+    if (it == maps_.end())
+      return;
+    brave_shields::ShieldsSettingsCache::GetInstance()->StopObserving(
+        it->second);
+    maps_.erase(it);
+    registrar_.Remove(this, chrome::NOTIFICATION_PROFILE_DESTROYED,
+                      content::Source<Profile>(profile));
+  }
+
+ private:
+  std::map<Profile*, HostContentSettingsMap*> maps_;
+  content::NotificationRegistrar registrar_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsCacheObserver);
+};
+
 BraveProfileManager::BraveProfileManager(const base::FilePath& user_data_dir)
-  : ProfileManager(user_data_dir) {}
+  : ProfileManager(user_data_dir),
+    shields_settings_observer_(new ShieldsSettingsCacheObserver()) {}
+
+BraveProfileManager::~BraveProfileManager() {}
 
 // static
 base::FilePath BraveProfileManager::GetTorProfilePath() {
@@ -114,6 +166,7 @@ void BraveProfileManager::DoFinalInitForServices(Profile* profile,
   brave_sync::BraveSyncServiceFactory::GetForProfile(profile);
   brave_ads::AdsServiceFactory::GetForProfile(profile);
   brave_rewards::RewardsServiceFactory::GetForProfile(profile);
+  shields_settings_observer_->StartObserving(profile);
   content::URLDataSource::Add(profile,
       std::make_unique<brave_content::BraveSharedResourcesDataSource>());
 }
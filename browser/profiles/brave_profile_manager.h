@@ -5,11 +5,14 @@
 #ifndef BRAVE_BROWSER_PROFILES_BRAVE_PROFILE_MANAGER_H_
 #define BRAVE_BROWSER_PROFILES_BRAVE_PROFILE_MANAGER_H_
 
+#include <memory>
+
 #include "chrome/browser/profiles/profile_manager.h"
 
 class BraveProfileManager : public ProfileManager {
  public:
    explicit BraveProfileManager(const base::FilePath& user_data_dir);
+   ~BraveProfileManager() override;
 
    // Returns the full path to be used for tor profiles.
    static base::FilePath GetTorProfilePath();
@@ -28,8 +31,12 @@ class BraveProfileManager : public ProfileManager {
    void DoFinalInitForServices(Profile* profile,
                                bool go_off_the_record) override;
  private:
+   class ShieldsSettingsCacheObserver;
+
    void LaunchTorProcess(Profile* profile);
 
+   std::unique_ptr<ShieldsSettingsCacheObserver> shields_settings_observer_;
+
    DISALLOW_COPY_AND_ASSIGN(BraveProfileManager);
 };
 #endif  // BRAVE_BROWSER_PROFILES_BRAVE_PROFILE_MANAGER_H_
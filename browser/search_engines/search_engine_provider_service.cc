@@ -28,8 +28,8 @@ SearchEngineProviderService::SearchEngineProviderService(
       base::Bind(&SearchEngineProviderService::OnPreferenceChanged,
                  base::Unretained(this)));
 
-  auto data = TemplateURLPrepopulateData::GetPrepopulatedEngine(
-      otr_profile->GetPrefs(),
+  const TemplateURLData* data = brave::GetPrepopulatedEngine(
+      otr_profile,
       TemplateURLPrepopulateData::PREPOPULATED_ENGINE_ID_DUCKDUCKGO);
   alternative_search_engine_url_.reset(new TemplateURL(*data));
 }
@@ -51,13 +51,25 @@ SearchEngineProviderService::UseAlternativeSearchEngineProvider() const {
 }
 
 void SearchEngineProviderService::ChangeToAlternativeSearchEngineProvider() {
-  otr_template_url_service_->SetUserSelectedDefaultSearchProvider(
-      alternative_search_engine_url_.get());
+  SetOTRDefaultSearchProvider(alternative_search_engine_url_->data());
 }
 
 void SearchEngineProviderService::ChangeToNormalWindowSearchEngineProvider() {
-  TemplateURL normal_url(
+  SetOTRDefaultSearchProvider(
       original_template_url_service_->GetDefaultSearchProvider()->data());
-  otr_template_url_service_->SetUserSelectedDefaultSearchProvider(
-      &normal_url);
+}
+
+void SearchEngineProviderService::SetOTRDefaultSearchProvider(
+    const TemplateURLData& data) {
+  const TemplateURL* current =
+      otr_template_url_service_->GetDefaultSearchProvider();
+  if (current &&
+      current->data().prepopulate_id == data.prepopulate_id &&
+      current->data().keyword() == data.keyword() &&
+      current->data().url() == data.url()) {
+    return;
+  }
+
+  TemplateURL url(data);
+  otr_template_url_service_->SetUserSelectedDefaultSearchProvider(&url);
 }
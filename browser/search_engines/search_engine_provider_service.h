@@ -15,6 +15,7 @@
 class Profile;
 class TemplateURL;
 class TemplateURLService;
+struct TemplateURLData;
 
 class SearchEngineProviderService : public KeyedService {
  public:
@@ -29,6 +30,9 @@ class SearchEngineProviderService : public KeyedService {
   bool UseAlternativeSearchEngineProvider() const;
   void ChangeToAlternativeSearchEngineProvider();
   void ChangeToNormalWindowSearchEngineProvider();
+  // Makes |data| the default provider of |otr_template_url_service_| unless
+  // it already is, so observers aren't notified of a change that isn't one.
+  void SetOTRDefaultSearchProvider(const TemplateURLData& data);
 
   // Points off the record profile.
   Profile* otr_profile_;
@@ -4,6 +4,12 @@
 
 #include "brave/browser/search_engines/search_engine_provider_util.h"
 
+#include <map>
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/ptr_util.h"
+#include "base/supports_user_data.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/search_engines/brave_prepopulated_engines.h"
 #include "chrome/browser/profiles/profile.h"
@@ -14,6 +20,57 @@
 
 namespace brave {
 
+namespace {
+
+const char kPrepopulatedEnginesCacheKey[] = "brave_prepopulated_engines_cache";
+
+class PrepopulatedEnginesCache : public base::SupportsUserData::Data {
+ public:
+  static PrepopulatedEnginesCache* FromProfile(Profile* profile) {
+    Profile* original_profile = profile->GetOriginalProfile();
+    auto* cache = static_cast<PrepopulatedEnginesCache*>(
+        original_profile->GetUserData(kPrepopulatedEnginesCacheKey));
+    if (!cache) {
+      cache = new PrepopulatedEnginesCache();
+      original_profile->SetUserData(kPrepopulatedEnginesCacheKey,
+                                    base::WrapUnique(cache));
+    }
+    return cache;
+  }
+
+  const TemplateURLData* GetEngine(PrefService* prefs, int prepopulate_id) {
+    auto it = engines_.find(prepopulate_id);
+    if (it == engines_.end()) {
+      it = engines_.emplace(prepopulate_id,
+          TemplateURLPrepopulateData::GetPrepopulatedEngine(
+              prefs, prepopulate_id)).first;
+    }
+    return it->second.get();
+  }
+
+  int GetDefaultPrepopulateId(PrefService* prefs) {
+    if (default_prepopulate_id_ ==
+        TemplateURLPrepopulateData::PREPOPULATED_ENGINE_ID_INVALID) {
+      default_prepopulate_id_ =
+          TemplateURLPrepopulateData::GetPrepopulatedDefaultSearch(prefs)
+              ->prepopulate_id;
+    }
+    return default_prepopulate_id_;
+  }
+
+ private:
+  PrepopulatedEnginesCache() = default;
+
+  // Engines that don't exist are kept as nullptr.
+  std::map<int, std::unique_ptr<TemplateURLData>> engines_;
+  int default_prepopulate_id_ =
+      TemplateURLPrepopulateData::PREPOPULATED_ENGINE_ID_INVALID;
+
+  DISALLOW_COPY_AND_ASSIGN(PrepopulatedEnginesCache);
+};
+
+}  // namespace
+
 bool UseAlternativeSearchEngineProviderEnabled(Profile* profile) {
   return profile->GetOriginalProfile()->GetPrefs()->GetBoolean(
       kUseAlternativeSearchEngineProvider);
@@ -29,9 +86,15 @@ void ToggleUseAlternativeSearchEngineProvider(Profile* profile) {
 }
 
 bool IsRegionForQwant(Profile* profile) {
-  return TemplateURLPrepopulateData::GetPrepopulatedDefaultSearch(
-      profile->GetPrefs())->prepopulate_id ==
-      TemplateURLPrepopulateData::PREPOPULATED_ENGINE_ID_QWANT;
+  return PrepopulatedEnginesCache::FromProfile(profile)
+             ->GetDefaultPrepopulateId(profile->GetPrefs()) ==
+         TemplateURLPrepopulateData::PREPOPULATED_ENGINE_ID_QWANT;
+}
+
+const TemplateURLData* GetPrepopulatedEngine(Profile* profile,
+                                             int prepopulate_id) {
+  return PrepopulatedEnginesCache::FromProfile(profile)->GetEngine(
+      profile->GetPrefs(), prepopulate_id);
 }
 
 }  // namespace brave
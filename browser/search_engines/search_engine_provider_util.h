@@ -6,6 +6,7 @@
 #define BRAVE_BROWSER_SEARCH_ENGINES_SEARCH_ENGINE_PROVIDER_UTIL_H_
 
 class Profile;
+struct TemplateURLData;
 
 namespace user_prefs {
 class PrefRegistrySyncable;
@@ -19,6 +20,13 @@ void ToggleUseAlternativeSearchEngineProvider(Profile* profile);
 
 bool IsRegionForQwant(Profile* profile);
 
+// Returns the prepopulated engine |prepopulate_id| for |profile|, or nullptr
+// if there is none. Prepopulated engines only depend on the country the
+// profile was created in, so they are looked up once per original profile and
+// shared by its private, tor and guest windows.
+const TemplateURLData* GetPrepopulatedEngine(Profile* profile,
+                                             int prepopulate_id);
+
 }  // namespace brave
 
 #endif  // BRAVE_BROWSER_SEARCH_ENGINES_SEARCH_ENGINE_PROVIDER_UTIL_H_
@@ -23,12 +23,11 @@ TorWindowSearchEngineProviderService(Profile* otr_profile)
 
   // Configure previously used provider because effective tor profile is
   // off the recored profile.
-  auto provider_data =
-      TemplateURLPrepopulateData::GetPrepopulatedEngine(
-          otr_profile->GetPrefs(), GetInitialSearchEngineProvider());
-  TemplateURL provider_url(*provider_data);
-  otr_template_url_service_->SetUserSelectedDefaultSearchProvider(
-      &provider_url);
+  const TemplateURLData* provider_data =
+      brave::GetPrepopulatedEngine(otr_profile,
+                                   GetInitialSearchEngineProvider());
+  if (provider_data)
+    SetOTRDefaultSearchProvider(*provider_data);
 
   // Monitor otr(off the record) profile's search engine changing to caching
   // in original profile.
@@ -50,10 +49,7 @@ int TorWindowSearchEngineProviderService::
 GetInitialSearchEngineProvider() const {
   int initial_id = alternative_search_engine_provider_in_tor_.GetValue();
 
-  bool region_for_qwant =
-      TemplateURLPrepopulateData::GetPrepopulatedDefaultSearch(
-          otr_profile_->GetPrefs())->prepopulate_id ==
-          TemplateURLPrepopulateData::PREPOPULATED_ENGINE_ID_QWANT;
+  bool region_for_qwant = brave::IsRegionForQwant(otr_profile_);
 
   // If this is first run, |initial_id| is invalid. Then, use qwant or ddg
   // depends on default prepopulate data.
@@ -15,6 +15,8 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/site_instance.h"
 #include "content/public/browser/storage_partition.h"
+#include "net/http/http_network_session.h"
+#include "net/http/http_transaction_factory.h"
 #include "net/proxy_resolution/proxy_resolution_service.h"
 #include "net/url_request/url_request_context.h"
 #include "net/url_request/url_request_context_getter.h"
@@ -53,14 +55,21 @@ void TorProfileServiceImpl::SetNewTorCircuitOnIOThread(
   const TorConfig tor_config = tor_launcher_factory_->GetTorConfig();
   if (tor_config.empty())
     return;
-  auto* proxy_resolution_service =
-    getter->GetURLRequestContext()->proxy_resolution_service();
+  net::URLRequestContext* context = getter->GetURLRequestContext();
+  auto* proxy_resolution_service = context->proxy_resolution_service();
   DCHECK(proxy_resolution_service);
   TorProxyConfigService::TorSetProxy(proxy_resolution_service,
                                      tor_config.proxy_string(),
                                      host,
                                      &tor_proxy_map_,
                                      true);
+
+  // Idle sockets for the old credentials can never be reused, but still count
+  // against the pool limits. Sockets to the local Tor proxy are cheap to
+  // reopen, and reuse their circuit, so close every idle one.
+  net::HttpTransactionFactory* factory = context->http_transaction_factory();
+  if (factory && factory->GetSession())
+    factory->GetSession()->CloseIdleConnections();
 }
 
 void TorProfileServiceImpl::SetNewTorCircuit(const GURL& request_url,
@@ -106,10 +115,11 @@ int TorProfileServiceImpl::SetProxy(net::ProxyResolutionService* service,
     LOG(ERROR) << "Tor not configured -- blocking connection";
     return net::ERR_SOCKS_CONNECTION_FAILED;
   }
-  base::PostTaskWithTraits(FROM_HERE, {BrowserThread::IO},
-      base::Bind(&TorProxyConfigService::TorSetProxy,
-      service, tor_config.proxy_string(),
-      isolation_key, &tor_proxy_map_, new_circuit));
+  // Applied before returning so the request is resolved with the proxy for its
+  // own isolation key rather than whichever one was set last
+  TorProxyConfigService::TorSetProxy(service, tor_config.proxy_string(),
+                                     isolation_key, &tor_proxy_map_,
+                                     new_circuit);
   return net::OK;
 }
 
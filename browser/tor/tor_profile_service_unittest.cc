@@ -8,6 +8,9 @@
 #include <string>
 
 #include "base/macros.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/time/time.h"
+#include "brave/browser/tor/tor_proxy_config_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
@@ -49,3 +52,36 @@ TEST_F(TorProfileServiceTest, CircuitIsolationKey) {
     EXPECT_EQ(expected_key, actual_key);
   }
 }
+
+TEST_F(TorProfileServiceTest, TorProxyMapNewIdentity) {
+  base::test::ScopedTaskEnvironment scoped_task_environment;
+  tor::TorProxyConfigService::TorProxyMap map;
+
+  // Known sites keep their password until a new identity is asked for
+  const std::string password = map.Get("torproject.org");
+  EXPECT_EQ(password, map.Get("torproject.org"));
+  EXPECT_NE(password, map.Get("bbc.co.uk"));
+
+  map.Erase("torproject.org");
+  EXPECT_NE(password, map.Get("torproject.org"));
+}
+
+TEST_F(TorProfileServiceTest, TorProxyMapExpiry) {
+  base::test::ScopedTaskEnvironment scoped_task_environment(
+      base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME,
+      base::test::ScopedTaskEnvironment::NowSource::MAIN_THREAD_MOCK_TIME);
+  tor::TorProxyConfigService::TorProxyMap map;
+
+  const std::string first = map.Get("torproject.org");
+  scoped_task_environment.FastForwardBy(base::TimeDelta::FromMinutes(5));
+  const std::string second = map.Get("bbc.co.uk");
+  EXPECT_EQ(first, map.Get("torproject.org"));
+
+  // Each entry lasts ten minutes from when it was created
+  scoped_task_environment.FastForwardBy(base::TimeDelta::FromMinutes(6));
+  EXPECT_NE(first, map.Get("torproject.org"));
+  EXPECT_EQ(second, map.Get("bbc.co.uk"));
+
+  scoped_task_environment.FastForwardBy(base::TimeDelta::FromMinutes(5));
+  EXPECT_NE(second, map.Get("bbc.co.uk"));
+}
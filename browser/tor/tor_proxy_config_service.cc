@@ -80,6 +80,16 @@ void TorProxyConfigService::TorSetProxy(
     tor_proxy_map->Erase(site_url);
   std::unique_ptr<TorProxyConfigService>
     config(new TorProxyConfigService(tor_proxy, site_url, tor_proxy_map));
+
+  // Resetting the config service drops the resolver state for every request
+  // on |service|, so only do it when the isolation key or circuit changes
+  // the proxy credentials
+  net::ProxyConfigWithAnnotation new_config;
+  if (service->config() &&
+      config->GetLatestProxyConfig(&new_config) == CONFIG_VALID &&
+      service->config()->value().Equals(new_config.value())) {
+    return;
+  }
   service->ResetConfigService(std::move(config));
 }
 
@@ -92,7 +102,10 @@ TorProxyConfigService::ConfigAvailability
   return CONFIG_VALID;
 }
 
-TorProxyConfigService::TorProxyMap::TorProxyMap() = default;
+TorProxyConfigService::TorProxyMap::TorProxyMap()
+    : last_generation_(0) {
+}
+
 TorProxyConfigService::TorProxyMap::~TorProxyMap() {
   timer_.Stop();
 }
@@ -106,64 +119,59 @@ std::string TorProxyConfigService::TorProxyMap::GenerateNewPassword() {
 
 std::string TorProxyConfigService::TorProxyMap::Get(
     const std::string& username) {
-  // Clear any expired entries, in case this one has expired.
-  ClearExpiredEntries();
-
-  // Check for an entry for this username.
+  // Check for an entry for this username.  Expired entries the timer has not
+  // swept yet are replaced here.
+  const base::Time now = base::Time::Now();
   auto found = map_.find(username);
-  if (found != map_.end())
-    return found->second.first;
+  if (found != map_.end()) {
+    if (now - found->second.created < kTenMins)
+      return found->second.password;
+    map_.erase(found);
+  }
 
   // No entry yet.  Check our watch and create one.
-  const base::Time now = base::Time::Now();
   const std::string password = GenerateNewPassword();
-  map_.emplace(username, std::make_pair(password, now));
-  queue_.emplace(now, username);
-
-  // Reschedule the timer for ten minutes from now so that this entry
-  // won't last more than about ten minutes even if the user stops
-  // using Tor for a while.
-  timer_.Stop();
-  timer_.Start(FROM_HERE, kTenMins, this,
-               &TorProxyConfigService::TorProxyMap::ClearExpiredEntries);
+  const uint64_t generation = ++last_generation_;
+  map_[username] = { password, now, generation };
+  queue_.push_back({ now, username, generation });
+  ScheduleExpiry();
 
   return password;
 }
 
 void TorProxyConfigService::TorProxyMap::Erase(const std::string& username) {
-  // Just erase it from the map.  There will remain an entry in the
-  // queue, but it is harmless.  If anyone creates a new entry in the
-  // map, the old entry in the queue will cease to affect it because
-  // the timestamps won't match, and they will simultaneously create a
-  // new entry in the queue.
+  // Just erase it from the map.  Its entry in the queue no longer matches
+  // the generation of any map entry, so it is dropped when it expires.
   map_.erase(username);
 }
 
+void TorProxyConfigService::TorProxyMap::ScheduleExpiry() {
+  // A single timer runs for the oldest entry, so that entries don't last
+  // more than about ten minutes even if the user stops using Tor for a
+  // while.
+  if (timer_.IsRunning() || queue_.empty())
+    return;
+  const base::TimeDelta delay = std::max(base::TimeDelta(),
+      queue_.front().created + kTenMins - base::Time::Now());
+  timer_.Start(FROM_HERE, delay, this,
+               &TorProxyConfigService::TorProxyMap::ClearExpiredEntries);
+}
+
 void TorProxyConfigService::TorProxyMap::ClearExpiredEntries() {
+  // Entries are queued in the order they were created, so the oldest one is
+  // always at the front.
   const base::Time cutoff = base::Time::Now() - kTenMins;
-  for (; !queue_.empty(); queue_.pop()) {
-    // Check the timestamp.  If it's not older than the cutoff, stop.
-    const std::pair<base::Time, std::string>* entry = &queue_.top();
-    const base::Time timestamp = entry->first;
-    if (!(timestamp < cutoff))
-      break;
-
-    // Remove the corresponding entry in the map if there is one and
-    // if its timestamp is not newer.
-    const std::string& username = entry->second;
-    auto found = map_.find(username);
-    if (found != map_.end()) {
-      // If the timestamp on the map entry is the same as the
-      // timestamp on the queue entry, then delete the map entry.
-      // Otherwise, we assume the map entry was created by an explicit
-      // request for a new identity, which will have its own entry in
-      // the queue in order to last the full ten minutes.
-      const base::Time map_timestamp = found->second.second;
-      if (map_timestamp == timestamp) {
-        map_.erase(username);
-      }
-    }
+  while (!queue_.empty() && !(cutoff < queue_.front().created)) {
+    const QueueEntry& entry = queue_.front();
+    // Only remove the map entry this queue entry was created for.  A newer
+    // one, from an explicit request for a new identity, has its own entry
+    // in the queue in order to last the full ten minutes.
+    auto found = map_.find(entry.username);
+    if (found != map_.end() && found->second.generation == entry.generation)
+      map_.erase(found);
+    queue_.pop_front();
   }
+  ScheduleExpiry();
 }
 
 }  // namespace tor
@@ -6,12 +6,14 @@
 #ifndef BRAVE_BROWSER_TOR_TOR_PROXY_CONFIG_SERVICE_H_
 #define BRAVE_BROWSER_TOR_TOR_PROXY_CONFIG_SERVICE_H_
 
+#include <stdint.h>
+
 #include <string>
 #include <map>
-#include <queue>
 #include <utility>
 
 #include "base/compiler_specific.h"
+#include "base/containers/circular_deque.h"
 #include "base/timer/timer.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_export.h"
@@ -43,8 +45,23 @@ class TorProxyConfigService : public net::ProxyConfigService {
     static std::string GenerateNewPassword();
     // Clear expired entries in the queue from the map.
     void ClearExpiredEntries();
-    std::map<std::string, std::pair<std::string, base::Time> > map_;
-    std::priority_queue<std::pair<base::Time, std::string> > queue_;
+    // Starts |timer_| for the oldest queued entry if it isn't running.
+    void ScheduleExpiry();
+
+    struct MapEntry {
+      std::string password;
+      base::Time created;
+      uint64_t generation;
+    };
+    struct QueueEntry {
+      base::Time created;
+      std::string username;
+      uint64_t generation;
+    };
+
+    std::map<std::string, MapEntry> map_;
+    base::circular_deque<QueueEntry> queue_;
+    uint64_t last_generation_;
     base::OneShotTimer timer_;
     DISALLOW_COPY_AND_ASSIGN(TorProxyMap);
   };
@@ -4,6 +4,10 @@
 
 #include "brave/browser/ui/brave_actions/brave_action_icon_with_badge_image_source.h"
 
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/browser/ui/brave_actions/constants.h"
 #include "cc/paint/paint_flags.h"
@@ -22,47 +26,37 @@
 
 using namespace brave_actions;
 
-base::Optional<int> BraveActionIconWithBadgeImageSource::GetCustomGraphicSize() {
-  return kBraveActionGraphicSize;
-}
-
-base::Optional<int> BraveActionIconWithBadgeImageSource::GetCustomGraphicXOffset() {
-  return std::floor(
-    (size().width() - kBraveActionRightMargin - kBraveActionGraphicSize) / 2.0
-  );
-}
-
-base::Optional<int> BraveActionIconWithBadgeImageSource::GetCustomGraphicYOffset() {
-  return std::floor(
-    (size().height() - kBraveActionGraphicSize) / 2.0
-  );
-}
-
-void BraveActionIconWithBadgeImageSource::PaintBadge(gfx::Canvas* canvas) {
-    if (!badge_ || badge_->text.empty())
-    return;
+namespace {
 
-  SkColor text_color = SkColorGetA(badge_->text_color) == SK_AlphaTRANSPARENT
-                           ? SK_ColorWHITE
-                           : badge_->text_color;
+// Always use same height to avoid jumping up and down with different
+// characters which will differ slightly,
+// but vary the width so we cover as little of the icon as possible.
+constexpr int kBadgeHeight = 12;
+constexpr int kBadgeMaxWidth = 14;
+constexpr int kVPadding = 1;
+constexpr int kVMarginTop = 2;
+constexpr int kTextHeightTarget = kBadgeHeight - (kVPadding * 2);
 
-  SkColor background_color = SkColorSetA(badge_->background_color, SK_AlphaOPAQUE);
+// Badge texts whose fitted font is remembered. Blocked counts climb one at a
+// time while a page loads, so recent counts are what get painted again.
+constexpr size_t kMaximumCachedBadgeLayouts = 64;
 
-  // Always use same height to avoid jumping up and down with different
-  // characters which will differ slightly,
-  // but vary the width so we cover as little of the icon as possible.
-  constexpr int kBadgeHeight = 12;
-  constexpr int kBadgeMaxWidth = 14;
-  constexpr int kVPadding = 1;
-  constexpr int kVMarginTop = 2;
-  const int kTextHeightTarget = kBadgeHeight - (kVPadding * 2);
+struct BadgeLayout {
+  gfx::FontList font;
+  int text_width = 0;
+  int text_height = 0;
   int h_padding = 2;
-  int text_max_width = kBadgeMaxWidth - (h_padding * 2);
+};
+
+// Finds the font that best fits |utf16_text| in the badge, which takes
+// several text measurements.
+BadgeLayout ComputeBadgeLayout(const base::string16& utf16_text) {
+  BadgeLayout layout;
+  int text_max_width = kBadgeMaxWidth - (layout.h_padding * 2);
 
   ui::ResourceBundle* rb = &ui::ResourceBundle::GetSharedInstance();
   gfx::FontList base_font = rb->GetFontList(ui::ResourceBundle::BaseFont)
                                 .DeriveWithHeightUpperBound(kTextHeightTarget);
-  base::string16 utf16_text = base::UTF8ToUTF16(badge_->text);
 
   // Calculate best font size to fit maximum Width and constant Height
   int text_height = 0;
@@ -80,7 +74,7 @@ void BraveActionIconWithBadgeImageSource::PaintBadge(gfx::Canvas* canvas) {
   if (text_width > text_max_width) {
     // Too wide
     // Reduce the padding
-    h_padding -= 1;
+    layout.h_padding -= 1;
     text_max_width += 2; // 2 * padding delta
     // If still cannot squeeze it in, reduce font size
     if (text_width > text_max_width) {
@@ -121,6 +115,55 @@ void BraveActionIconWithBadgeImageSource::PaintBadge(gfx::Canvas* canvas) {
     }
   }
 
+  layout.font = base_font;
+  layout.text_width = text_width;
+  layout.text_height = text_height;
+  return layout;
+}
+
+// Badges are only painted on the UI thread.
+const BadgeLayout& GetBadgeLayout(const std::string& text) {
+  static base::NoDestructor<base::MRUCache<std::string, BadgeLayout>>
+      layouts(kMaximumCachedBadgeLayouts);
+  auto it = layouts->Get(text);
+  if (it == layouts->end())
+    it = layouts->Put(text, ComputeBadgeLayout(base::UTF8ToUTF16(text)));
+  return it->second;
+}
+
+}  // namespace
+
+base::Optional<int> BraveActionIconWithBadgeImageSource::GetCustomGraphicSize() {
+  return kBraveActionGraphicSize;
+}
+
+base::Optional<int> BraveActionIconWithBadgeImageSource::GetCustomGraphicXOffset() {
+  return std::floor(
+    (size().width() - kBraveActionRightMargin - kBraveActionGraphicSize) / 2.0
+  );
+}
+
+base::Optional<int> BraveActionIconWithBadgeImageSource::GetCustomGraphicYOffset() {
+  return std::floor(
+    (size().height() - kBraveActionGraphicSize) / 2.0
+  );
+}
+
+void BraveActionIconWithBadgeImageSource::PaintBadge(gfx::Canvas* canvas) {
+    if (!badge_ || badge_->text.empty())
+    return;
+
+  SkColor text_color = SkColorGetA(badge_->text_color) == SK_AlphaTRANSPARENT
+                           ? SK_ColorWHITE
+                           : badge_->text_color;
+
+  SkColor background_color = SkColorSetA(badge_->background_color, SK_AlphaOPAQUE);
+
+  const BadgeLayout& layout = GetBadgeLayout(badge_->text);
+  const int h_padding = layout.h_padding;
+  const int text_width = layout.text_width;
+  const int text_height = layout.text_height;
+
   // Calculate badge size. It is clamped to a min width just because it looks
   // silly if it is too skinny.
   int badge_width = text_width + h_padding * 2;
@@ -153,7 +196,8 @@ void BraveActionIconWithBadgeImageSource::PaintBadge(gfx::Canvas* canvas) {
   // l, t, r, b
   rect.Inset(0, kVerticalPadding, 0, kVerticalPadding);
   // Draw string with ellipsis if it does not fit
-  canvas->DrawStringRectWithFlags(utf16_text, base_font, text_color, rect,
+  canvas->DrawStringRectWithFlags(base::UTF8ToUTF16(badge_->text),
+                                  layout.font, text_color, rect,
                                   gfx::Canvas::TEXT_ALIGN_CENTER);
 }
 
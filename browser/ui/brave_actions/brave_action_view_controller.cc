@@ -9,6 +9,8 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/ui/brave_actions/brave_action_icon_with_badge_image_source.h"
 #include "brave/common/extensions/extension_constants.h"
 #include "chrome/browser/extensions/extension_action.h"
@@ -20,6 +22,8 @@
 #include "chrome/browser/ui/browser.h"
 #include "chrome/browser/ui/toolbar/toolbar_action_view_delegate.h"
 #include "components/vector_icons/vector_icons.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
 #include "ui/base/theme_provider.h"
 #include "ui/gfx/canvas.h"
 #include "ui/gfx/image/canvas_image_source.h"
@@ -27,6 +31,46 @@
 #include "ui/gfx/paint_vector_icon.h"
 #include "ui/gfx/scoped_canvas.h"
 
+namespace {
+
+constexpr base::TimeDelta kPreloadedPopupLifetime =
+    base::TimeDelta::FromSeconds(30);
+
+}  // namespace
+
+// Ends the trace started by a click once the popup has painted.
+class BraveActionViewController::PopupFirstPaintObserver
+    : public content::WebContentsObserver {
+ public:
+  explicit PopupFirstPaintObserver(content::WebContents* web_contents)
+      : content::WebContentsObserver(web_contents) {
+    TRACE_EVENT_ASYNC_BEGIN0("browser", "BraveAction::PopupFirstPaint", this);
+    // A preloaded popup may have painted before it was opened.
+    if (web_contents->CompletedFirstVisuallyNonEmptyPaint())
+      ReportFirstPaint();
+  }
+  ~PopupFirstPaintObserver() override {
+    ReportFirstPaint();
+  }
+
+  // content::WebContentsObserver:
+  void DidFirstVisuallyNonEmptyPaint() override {
+    ReportFirstPaint();
+  }
+
+ private:
+  void ReportFirstPaint() {
+    if (first_paint_reported_)
+      return;
+    first_paint_reported_ = true;
+    TRACE_EVENT_ASYNC_END0("browser", "BraveAction::PopupFirstPaint", this);
+  }
+
+  bool first_paint_reported_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(PopupFirstPaintObserver);
+};
+
 bool BraveActionViewController::IsEnabled(
     content::WebContents* web_contents) const {
   bool is_enabled = ExtensionActionViewController::IsEnabled(web_contents);
@@ -55,19 +99,58 @@ bool BraveActionViewController::TriggerPopupWithUrl(
     PopupShowAction show_action,
     const GURL& popup_url,
     bool grant_tab_permissions) {
-  std::unique_ptr<extensions::ExtensionViewHost> host =
-      extensions::ExtensionViewHostFactory::CreatePopupHost(popup_url,
-                                                            browser_);
+  std::unique_ptr<extensions::ExtensionViewHost> host;
+  if (preloaded_popup_host_ && preloaded_popup_url_ == popup_url)
+    host = std::move(preloaded_popup_host_);
+  DiscardPreloadedPopup();
+  if (!host) {
+    host = extensions::ExtensionViewHostFactory::CreatePopupHost(popup_url,
+                                                                 browser_);
+  }
   if (!host)
     return false;
 
   popup_host_ = host.get();
   popup_host_observer_.Add(popup_host_);
+  popup_first_paint_observer_ =
+      std::make_unique<PopupFirstPaintObserver>(popup_host_->host_contents());
   ShowPopup(std::move(host), grant_tab_permissions, show_action);
   return true;
 }
 
+void BraveActionViewController::PreloadPopup() {
+  if (preloaded_popup_host_ || is_showing_popup())
+    return;
+  content::WebContents* web_contents = view_delegate_->GetCurrentWebContents();
+  if (!web_contents || !IsEnabled(web_contents))
+    return;
+  int tab_id = SessionTabHelper::IdForTab(web_contents).id();
+  const GURL popup_url = extension_action()->GetPopupUrl(tab_id);
+  if (popup_url.is_empty())
+    return;
+
+  preloaded_popup_host_ =
+      extensions::ExtensionViewHostFactory::CreatePopupHost(popup_url,
+                                                            browser_);
+  if (!preloaded_popup_host_)
+    return;
+  // The panel reads its per-tab state from the extension's background page
+  // once loaded, so it stays valid if the active tab changes before a click.
+  preloaded_popup_host_->CreateRenderViewSoon();
+  preloaded_popup_url_ = popup_url;
+  preloaded_popup_timer_.Start(FROM_HERE, kPreloadedPopupLifetime,
+      base::BindOnce(&BraveActionViewController::DiscardPreloadedPopup,
+                     base::Unretained(this)));
+}
+
+void BraveActionViewController::DiscardPreloadedPopup() {
+  preloaded_popup_timer_.Stop();
+  preloaded_popup_host_.reset();
+  preloaded_popup_url_ = GURL();
+}
+
 void BraveActionViewController::OnPopupClosed() {
+  popup_first_paint_observer_.reset();
   popup_host_observer_.Remove(popup_host_);
   popup_host_ = nullptr;
   view_delegate_->OnPopupClosed();
@@ -8,10 +8,17 @@
 
 #include <memory>
 
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/ui/extensions/extension_action_view_controller.h"
+#include "url/gurl.h"
 
 class BraveActionIconWithBadgeImageSource;
 
+namespace extensions {
+class ExtensionViewHost;
+}
+
 namespace ui {
 class MenuModel;
 }
@@ -29,7 +36,13 @@ class BraveActionViewController : public ExtensionActionViewController {
                        const gfx::Size& size) override;
     bool DisabledClickOpensMenu() const override;
     ui::MenuModel* GetContextMenu() override;
+    // Starts loading the popup for the active tab, e.g. when the button is
+    // hovered, so that a following click shows it without waiting for the
+    // page to load.
+    void PreloadPopup();
  private:
+    class PopupFirstPaintObserver;
+
     ExtensionActionViewController* GetPreferredPopupViewController() override;
     bool TriggerPopupWithUrl(PopupShowAction show_action,
                            const GURL& popup_url,
@@ -39,6 +52,14 @@ class BraveActionViewController : public ExtensionActionViewController {
     std::unique_ptr<BraveActionIconWithBadgeImageSource> GetIconImageSource(
         content::WebContents* web_contents,
         const gfx::Size& size);
+    void DiscardPreloadedPopup();
+
+    std::unique_ptr<extensions::ExtensionViewHost> preloaded_popup_host_;
+    GURL preloaded_popup_url_;
+    // Drops a preloaded popup that was not opened, so an unused page is not
+    // kept around after the pointer moves on.
+    base::OneShotTimer preloaded_popup_timer_;
+    std::unique_ptr<PopupFirstPaintObserver> popup_first_paint_observer_;
     DISALLOW_COPY_AND_ASSIGN(BraveActionViewController);
 };
 
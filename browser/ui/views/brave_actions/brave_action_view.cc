@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "brave/browser/ui/brave_actions/brave_action_view_controller.h"
 #include "brave/browser/ui/brave_actions/constants.h"
 #include "chrome/browser/themes/theme_properties.h"
 #include "chrome/browser/ui/layout_constants.h"
@@ -37,3 +38,9 @@ void BraveActionView::OnBoundsChanged(const gfx::Rect& previous_bounds) {
 
   MenuButton::OnBoundsChanged(previous_bounds);
 }
+
+void BraveActionView::OnMouseEntered(const ui::MouseEvent& event) {
+  ToolbarActionView::OnMouseEntered(event);
+  // BraveActionsContainer only creates BraveActionViewControllers.
+  static_cast<BraveActionViewController*>(view_controller())->PreloadPopup();
+}
@@ -18,6 +18,8 @@ class BraveActionView : public ToolbarActionView {
   using ToolbarActionView::ToolbarActionView;
   // views::MenuButton:
   void OnBoundsChanged(const gfx::Rect& previous_bounds) override;
+  // Preloads the popup so it can be shown as soon as the button is clicked.
+  void OnMouseEntered(const ui::MouseEvent& event) override;
   DISALLOW_COPY_AND_ASSIGN(BraveActionView);
 };
 
@@ -9,6 +9,7 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/one_shot_event.h"
 #include "brave/browser/ui/brave_actions/brave_action_view_controller.h"
 #include "brave/browser/ui/views/brave_actions/brave_action_view.h"
@@ -30,6 +31,14 @@
 #include "ui/views/layout/grid_layout.h"
 #include "ui/views/view.h"
 
+namespace {
+
+// Roughly one frame.
+constexpr base::TimeDelta kActionUpdateDelay =
+    base::TimeDelta::FromMilliseconds(16);
+
+}  // namespace
+
 BraveActionsContainer::BraveActionInfo::BraveActionInfo()
     : position_(ACTION_ANY_POSITION) {}
 
@@ -199,7 +208,17 @@ void BraveActionsContainer::UpdateActionState(const std::string& id) {
     actions_[id].view_controller_->UpdateState();
 }
 
+void BraveActionsContainer::UpdatePendingActionStates() {
+  std::set<std::string> ids;
+  ids.swap(pending_action_updates_);
+  for (const auto& id : ids)
+    UpdateActionState(id);
+}
+
 void BraveActionsContainer::Update() {
+  // Every action is updated below, so pending updates are not needed anymore.
+  pending_action_updates_.clear();
+  pending_action_updates_timer_.Stop();
   // Update state of each action and also determine if there are any buttons to
   // show
   bool can_show = false;
@@ -302,8 +321,18 @@ void BraveActionsContainer::OnExtensionActionUpdated(
     ExtensionAction* extension_action,
     content::WebContents* web_contents,
     content::BrowserContext* browser_context) {
-  if (IsContainerAction(extension_action->extension_id()))
-    UpdateActionState(extension_action->extension_id());
+  if (!IsContainerAction(extension_action->extension_id()))
+    return;
+  // Changes for background tabs are picked up by Update() once the tab is
+  // shown.
+  if (web_contents && web_contents != GetCurrentWebContents())
+    return;
+  pending_action_updates_.insert(extension_action->extension_id());
+  if (!pending_action_updates_timer_.IsRunning()) {
+    pending_action_updates_timer_.Start(FROM_HERE, kActionUpdateDelay,
+        base::BindOnce(&BraveActionsContainer::UpdatePendingActionStates,
+                       base::Unretained(this)));
+  }
 }
 // end ExtensionActionAPI::Observer
 
@@ -8,8 +8,10 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 
+#include "base/timer/timer.h"
 #include "chrome/browser/ui/views/toolbar/toolbar_action_view.h"
 #include "chrome/browser/ui/toolbar/toolbar_action_view_controller.h"
 #include "chrome/browser/ui/browser.h"
@@ -120,9 +122,16 @@ class BraveActionsContainer : public views::View,
   void ShowAction(const std::string& id, bool show);
   bool IsActionShown(const std::string& id) const;
   void UpdateActionState(const std::string& id);
+  // Updates the actions whose state changed since the last frame.
+  void UpdatePendingActionStates();
 
   bool should_hide_ = false;
 
+  // Actions can be updated many times a second, e.g. with each blocked
+  // resource, so they are repainted at most once per frame.
+  std::set<std::string> pending_action_updates_;
+  base::OneShotTimer pending_action_updates_timer_;
+
   // The Browser this LocationBarView is in.  Note that at least
   // chromeos::SimpleWebViewDialog uses a LocationBarView outside any browser
   // window, so this may be NULL.
@@ -49,6 +49,10 @@ class BasicUI::BasicUIWebContentsObserver
     host_->UpdateWebUIProperties();
   }
 
+  void OnVisibilityChanged(content::Visibility visibility) override {
+    host_->OnVisibilityChanged(visibility);
+  }
+
  private:
   BasicUI* host_;
 
@@ -80,6 +84,12 @@ content::RenderViewHost* BasicUI::GetRenderViewHost() {
   return nullptr;
 }
 
+bool BasicUI::IsVisible() const {
+  auto* web_contents = web_ui()->GetWebContents();
+  return web_contents &&
+         web_contents->GetVisibility() == content::Visibility::VISIBLE;
+}
+
 bool BasicUI::IsSafeToSetWebUIProperties() const {
   // Allow `web_ui()->CanCallJavascript()` to be false.
   // Allow `web_ui()->CanCallJavascript()` to be true if
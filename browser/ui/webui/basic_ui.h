@@ -12,6 +12,7 @@
 
 #include "base/compiler_specific.h"
 #include "base/macros.h"
+#include "content/public/browser/visibility.h"
 #include "content/public/browser/web_ui_controller.h"
 
 namespace content {
@@ -43,7 +44,11 @@ class BasicUI : public content::WebUIController {
   // Called when subclass can set its webui properties.
   virtual void UpdateWebUIProperties() {}
 
+  // Called when the tab hosting this webui is shown, hidden or occluded.
+  virtual void OnVisibilityChanged(content::Visibility visibility) {}
+
  protected:
+  bool IsVisible() const;
   bool IsSafeToSetWebUIProperties() const;
   content::RenderViewHost* GetRenderViewHost();
 
@@ -5,11 +5,19 @@
 
 #include "brave/browser/ui/webui/brave_adblock_ui.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/webui_url_constants.h"
 #include "brave/components/brave_adblock/resources/grit/brave_adblock_generated_map.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_filter_validator.h"
+#include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/grit/brave_components_resources.h"
@@ -22,6 +30,17 @@
 
 namespace {
 
+bool GetStringList(const base::Value& value, std::vector<std::string>* out) {
+  if (!value.is_list())
+    return false;
+  for (const auto& item : value.GetList()) {
+    if (!item.is_string())
+      return false;
+    out->push_back(item.GetString());
+  }
+  return true;
+}
+
 class AdblockDOMHandler : public content::WebUIMessageHandler {
  public:
   AdblockDOMHandler();
@@ -34,12 +53,17 @@ class AdblockDOMHandler : public content::WebUIMessageHandler {
   void HandleEnableFilterList(const base::ListValue* args);
   void HandleGetCustomFilters(const base::ListValue* args);
   void HandleGetRegionalLists(const base::ListValue* args);
+  void HandleSpliceCustomFilters(const base::ListValue* args);
   void HandleUpdateCustomFilters(const base::ListValue* args);
+  void OnGetRegionalStats(
+      brave_shields::AdBlockRegionalServiceManager::RegionalStats stats);
+
+  base::WeakPtrFactory<AdblockDOMHandler> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(AdblockDOMHandler);
 };
 
-AdblockDOMHandler::AdblockDOMHandler() {}
+AdblockDOMHandler::AdblockDOMHandler() : weak_factory_(this) {}
 
 AdblockDOMHandler::~AdblockDOMHandler() {}
 
@@ -56,6 +80,10 @@ void AdblockDOMHandler::RegisterMessages() {
       "brave_adblock.getRegionalLists",
       base::BindRepeating(&AdblockDOMHandler::HandleGetRegionalLists,
                           base::Unretained(this)));
+  web_ui()->RegisterMessageCallback(
+      "brave_adblock.spliceCustomFilters",
+      base::BindRepeating(&AdblockDOMHandler::HandleSpliceCustomFilters,
+                          base::Unretained(this)));
   web_ui()->RegisterMessageCallback(
       "brave_adblock.updateCustomFilters",
       base::BindRepeating(&AdblockDOMHandler::HandleUpdateCustomFilters,
@@ -87,15 +115,83 @@ void AdblockDOMHandler::HandleGetCustomFilters(const base::ListValue* args) {
 
 void AdblockDOMHandler::HandleGetRegionalLists(const base::ListValue* args) {
   DCHECK_EQ(args->GetSize(), 0U);
+  // The lists are sent once the stats of the enabled ones are in.
+  g_brave_browser_process->ad_block_regional_service_manager()
+      ->GetRegionalStats(base::BindOnce(&AdblockDOMHandler::OnGetRegionalStats,
+                                        weak_factory_.GetWeakPtr()));
+}
+
+void AdblockDOMHandler::OnGetRegionalStats(
+    brave_shields::AdBlockRegionalServiceManager::RegionalStats stats) {
   if (!web_ui()->CanCallJavascript())
     return;
   std::unique_ptr<base::ListValue> regional_lists =
       g_brave_browser_process->ad_block_regional_service_manager()
           ->GetRegionalLists();
+  if (!regional_lists)
+    return;
+
+  for (auto& regional_list : regional_lists->GetList()) {
+    const std::string* uuid = regional_list.FindStringKey("uuid");
+    auto it = uuid ? stats.find(*uuid) : stats.end();
+    if (it == stats.end())
+      continue;
+    // Doubles, as base::Value has no 64-bit integers.
+    base::Value list_stats(base::Value::Type::DICTIONARY);
+    list_stats.SetKey("rules_loaded",
+        base::Value(static_cast<double>(it->second.rules_loaded)));
+    list_stats.SetKey("memory_bytes",
+        base::Value(static_cast<double>(it->second.memory_bytes)));
+    list_stats.SetKey("requests_checked",
+        base::Value(static_cast<double>(it->second.requests_checked)));
+    list_stats.SetKey("requests_matched",
+        base::Value(static_cast<double>(it->second.requests_matched)));
+    list_stats.SetKey("match_time_ms",
+        base::Value(it->second.match_time.InMillisecondsF()));
+    regional_list.SetKey("stats", std::move(list_stats));
+  }
+
   web_ui()->CallJavascriptFunctionUnsafe("brave_adblock.onGetRegionalLists",
                                          *regional_lists);
 }
 
+void AdblockDOMHandler::HandleSpliceCustomFilters(const base::ListValue* args) {
+  DCHECK_EQ(args->GetSize(), 3U);
+  const auto& list = args->GetList();
+  if (list.size() != 3 || !list[0].is_int() || list[0].GetInt() < 0)
+    return;
+  std::vector<std::string> removed;
+  std::vector<std::string> inserted;
+  if (!GetStringList(list[1], &removed) || !GetStringList(list[2], &inserted))
+    return;
+
+  const bool success =
+      g_brave_browser_process->ad_block_custom_filters_service()
+          ->SpliceCustomFilters(list[0].GetInt(), removed, inserted);
+
+  // Only the edited lines are checked, errors on other lines were reported
+  // when they were typed.
+  base::Value errors(base::Value::Type::LIST);
+  if (success) {
+    for (const std::string& rule : inserted) {
+      brave_shields::FilterSyntaxError error =
+          brave_shields::ValidateFilterSyntax(rule);
+      if (error == brave_shields::FILTER_SYNTAX_OK)
+        continue;
+      base::Value rule_error(base::Value::Type::DICTIONARY);
+      rule_error.SetKey("rule", base::Value(rule));
+      rule_error.SetKey("error", base::Value(
+          brave_shields::FilterSyntaxErrorToString(error)));
+      errors.GetList().push_back(std::move(rule_error));
+    }
+  }
+
+  if (!web_ui()->CanCallJavascript())
+    return;
+  web_ui()->CallJavascriptFunctionUnsafe(
+      "brave_adblock.onCustomFiltersSpliced", base::Value(success), errors);
+}
+
 void AdblockDOMHandler::HandleUpdateCustomFilters(const base::ListValue* args) {
   DCHECK_EQ(args->GetSize(), 1U);
   std::string custom_filters;
@@ -4,6 +4,9 @@
 
 #include "brave/browser/ui/webui/brave_new_tab_ui.h"
 
+#include "base/metrics/histogram_macros.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/search_engines/search_engine_provider_util.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/webui_url_constants.h"
@@ -18,10 +21,21 @@
 #include "content/public/browser/web_ui_message_handler.h"
 
 namespace {
+
+// Stats prefs are written for every batch of blocked resources, so refreshes
+// of an open page are coalesced to at most one per interval.
+constexpr base::TimeDelta kStatsUpdateInterval =
+    base::TimeDelta::FromSeconds(1);
+
 class NewTabDOMHandler : public content::WebUIMessageHandler {
  public:
-  NewTabDOMHandler() = default;
-  ~NewTabDOMHandler() override = default;
+  NewTabDOMHandler() : open_time_(base::TimeTicks::Now()) {
+    TRACE_EVENT_ASYNC_BEGIN0("browser", "BraveNewTabUI::FirstPaint", this);
+  }
+  ~NewTabDOMHandler() override {
+    if (!first_paint_reported_)
+      TRACE_EVENT_ASYNC_END0("browser", "BraveNewTabUI::FirstPaint", this);
+  }
 
  private:
   // WebUIMessageHandler implementation.
@@ -31,6 +45,19 @@ class NewTabDOMHandler : public content::WebUIMessageHandler {
         base::BindRepeating(
             &NewTabDOMHandler::HandleToggleAlternativeSearchEngineProvider,
             base::Unretained(this)));
+    web_ui()->RegisterMessageCallback(
+        "newTabPageFirstPaint",
+        base::BindRepeating(&NewTabDOMHandler::HandleFirstPaint,
+                            base::Unretained(this)));
+  }
+
+  void HandleFirstPaint(const base::ListValue* args) {
+    if (first_paint_reported_)
+      return;
+    first_paint_reported_ = true;
+    TRACE_EVENT_ASYNC_END0("browser", "BraveNewTabUI::FirstPaint", this);
+    UMA_HISTOGRAM_TIMES("Brave.NewTab.TimeToFirstPaint",
+                        base::TimeTicks::Now() - open_time_);
   }
 
   void HandleToggleAlternativeSearchEngineProvider(
@@ -39,6 +66,9 @@ class NewTabDOMHandler : public content::WebUIMessageHandler {
         Profile::FromWebUI(web_ui()));
   }
 
+  const base::TimeTicks open_time_;
+  bool first_paint_reported_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(NewTabDOMHandler);
 };
 
@@ -52,11 +82,11 @@ BraveNewTabUI::BraveNewTabUI(content::WebUI* web_ui, const std::string& name)
   pref_change_registrar_ = std::make_unique<PrefChangeRegistrar>();
   pref_change_registrar_->Init(prefs);
   pref_change_registrar_->Add(kAdsBlocked,
-    base::Bind(&BraveNewTabUI::OnPreferenceChanged, base::Unretained(this)));
+    base::Bind(&BraveNewTabUI::OnStatsChanged, base::Unretained(this)));
   pref_change_registrar_->Add(kTrackersBlocked,
-    base::Bind(&BraveNewTabUI::OnPreferenceChanged, base::Unretained(this)));
+    base::Bind(&BraveNewTabUI::OnStatsChanged, base::Unretained(this)));
   pref_change_registrar_->Add(kHttpsUpgrades,
-    base::Bind(&BraveNewTabUI::OnPreferenceChanged, base::Unretained(this)));
+    base::Bind(&BraveNewTabUI::OnStatsChanged, base::Unretained(this)));
   pref_change_registrar_->Add(kUseAlternativeSearchEngineProvider,
     base::Bind(&BraveNewTabUI::OnPreferenceChanged, base::Unretained(this)));
   pref_change_registrar_->Add(kAlternativeSearchEngineProviderInTor,
@@ -101,6 +131,9 @@ void BraveNewTabUI::CustomizeNewTabWebUIProperties(content::RenderViewHost* rend
 
 void BraveNewTabUI::UpdateWebUIProperties() {
   if (IsSafeToSetWebUIProperties()) {
+    // Every stat is read fresh below, so a queued refresh is redundant.
+    stats_update_timer_.Stop();
+    stats_pending_ = false;
     CustomizeNewTabWebUIProperties(GetRenderViewHost());
     web_ui()->CallJavascriptFunctionUnsafe("brave_new_tab.statsUpdated");
   }
@@ -109,3 +142,28 @@ void BraveNewTabUI::UpdateWebUIProperties() {
 void BraveNewTabUI::OnPreferenceChanged() {
   UpdateWebUIProperties();
 }
+
+void BraveNewTabUI::OnVisibilityChanged(content::Visibility visibility) {
+  if (visibility == content::Visibility::VISIBLE && stats_pending_)
+    UpdateWebUIProperties();
+}
+
+void BraveNewTabUI::OnStatsChanged() {
+  if (!IsVisible()) {
+    stats_pending_ = true;
+    return;
+  }
+  if (stats_update_timer_.IsRunning())
+    return;
+  stats_update_timer_.Start(FROM_HERE, kStatsUpdateInterval,
+      base::Bind(&BraveNewTabUI::OnStatsUpdateTimer,
+                 base::Unretained(this)));
+}
+
+void BraveNewTabUI::OnStatsUpdateTimer() {
+  if (!IsVisible()) {
+    stats_pending_ = true;
+    return;
+  }
+  UpdateWebUIProperties();
+}
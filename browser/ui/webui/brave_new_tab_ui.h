@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "base/timer/timer.h"
 #include "brave/browser/ui/webui/basic_ui.h"
 
 class PrefChangeRegistrar;
@@ -19,11 +20,18 @@ class BraveNewTabUI : public BasicUI {
  private:
   // BasicUI overrides
   void UpdateWebUIProperties() override;
+  void OnVisibilityChanged(content::Visibility visibility) override;
 
   void CustomizeNewTabWebUIProperties(content::RenderViewHost* render_view_host);
   void OnPreferenceChanged();
+  void OnStatsChanged();
+  void OnStatsUpdateTimer();
 
   std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
+  // Limits stats refreshes to one per interval while blocking is busy.
+  base::OneShotTimer stats_update_timer_;
+  // Stats changed while the page was hidden and are sent once it is shown.
+  bool stats_pending_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(BraveNewTabUI);
 };
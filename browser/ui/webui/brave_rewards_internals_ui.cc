@@ -76,6 +76,8 @@ void RewardsInternalsDOMHandler::Init() {
   profile_ = Profile::FromWebUI(web_ui());
   rewards_service_ =
       brave_rewards::RewardsServiceFactory::GetForProfile(profile_);
+  if (rewards_service_)
+    rewards_service_->WakeLedger();
   PrefService* prefs = profile_->GetPrefs();
   pref_change_registrar_ = std::make_unique<PrefChangeRegistrar>();
   pref_change_registrar_->Init(prefs);
@@ -136,6 +138,17 @@ void RewardsInternalsDOMHandler::OnGetRewardsInternalsInfo(
     info_dict.SetString("personaId", info->persona_id);
     info_dict.SetString("userId", info->user_id);
     info_dict.SetInteger("bootStamp", info->boot_stamp);
+    auto perf_stats = std::make_unique<base::ListValue>();
+    for (const auto& item : info->perf_stats) {
+      auto perf_stat = std::make_unique<base::DictionaryValue>();
+      perf_stat->SetString("name", item.first);
+      perf_stat->SetDouble("count", item.second.count);
+      perf_stat->SetDouble("totalMs", item.second.total.InMillisecondsF());
+      perf_stat->SetDouble("maxMs", item.second.max.InMillisecondsF());
+      perf_stat->SetDouble("lastMs", item.second.last.InMillisecondsF());
+      perf_stats->Append(std::move(perf_stat));
+    }
+    info_dict.SetList("perfStats", std::move(perf_stats));
   }
   web_ui()->CallJavascriptFunctionUnsafe(
       "brave_rewards_internals.onGetRewardsInternalsInfo", info_dict);
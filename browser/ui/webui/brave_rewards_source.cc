@@ -4,7 +4,11 @@
 
 #include "brave/browser/ui/webui/brave_rewards_source.h"
 
-#include "base/memory/ref_counted_memory.h"
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/task/post_task.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
@@ -14,6 +18,14 @@
 
 namespace {
 
+// Images used to be cached on disk here as well, which kept the publishers
+// a user had visited in the profile past clearing browsing data.
+const base::FilePath::CharType kDiskCacheDirectory[] =
+    FILE_PATH_LITERAL("rewards_image_cache");
+
+// Enough for the favicons of a long activity list and a few banners.
+const size_t kMaximumMemoryCacheSize = 8 * 1024 * 1024;
+
 typedef base::RepeatingCallback<void(BitmapFetcherService::RequestId request_id,
                                      const GURL& url,
                                      const SkBitmap& bitmap)>
@@ -52,7 +64,16 @@ scoped_refptr<base::RefCountedMemory> BitmapToMemory(const SkBitmap* image) {
 }  // namespace
 
 BraveRewardsSource::BraveRewardsSource(Profile* profile)
-    : profile_(profile->GetOriginalProfile()) {}
+    : profile_(profile->GetOriginalProfile()),
+      images_(base::MRUCache<std::string,
+                  scoped_refptr<base::RefCountedMemory>>::NO_AUTO_EVICT),
+      images_size_(0) {
+  base::PostTaskWithTraits(FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(base::IgnoreResult(&base::DeleteFile),
+                     profile_->GetPath().Append(kDiskCacheDirectory), true));
+}
 
 BraveRewardsSource::~BraveRewardsSource() {
 }
@@ -71,45 +92,57 @@ void BraveRewardsSource::StartDataRequest(
     return;
   }
 
-  auto it = find(resource_fetchers_.begin(), resource_fetchers_.end(), url);
-  if (it != resource_fetchers_.end()) {
-    LOG(WARNING) << "Already fetching specified Brave Rewards resource, url: "
-                 << url;
+  auto cached = images_.Get(path);
+  if (cached != images_.end()) {
+    got_data_callback.Run(cached->second.get());
     return;
   }
 
+  GotDataCallbacks& callbacks = pending_requests_[path];
+  callbacks.push_back(got_data_callback);
+  if (callbacks.size() > 1) {
+    // Answered along with the request already fetching it.
+    return;
+  }
+
+  FetchImage(path);
+}
+
+void BraveRewardsSource::FetchImage(const std::string& path) {
   BitmapFetcherService* image_service =
       BitmapFetcherServiceFactory::GetForBrowserContext(profile_);
-  if (image_service) {
-    net::NetworkTrafficAnnotationTag traffic_annotation =
-        net::DefineNetworkTrafficAnnotation("brave_rewards_resource_fetcher", R"(
-        semantics {
-          sender:
-            "Brave Rewards resource fetcher"
-          description:
-            "Fetches resources related to Brave Rewards."
-          trigger:
-            "User visits a media publisher's site."
-          data: "Brave Rewards related resources."
-          destination: WEBSITE
-        }
-        policy {
-          cookies_allowed: NO
-          setting:
-            "This feature cannot be disabled by settings."
-          policy_exception_justification:
-            "Not implemented."
-        })");
-    resource_fetchers_.emplace_back(path);
-    request_ids_.push_back(image_service->RequestImage(
-        url,
-        // Image Service takes ownership of the observer.
-        new RewardsResourceFetcherObserver(
-            url,
-            base::BindRepeating(&BraveRewardsSource::OnBitmapFetched,
-                                base::Unretained(this), got_data_callback)),
-        traffic_annotation));
+  if (!image_service) {
+    OnImageReady(path, nullptr);
+    return;
   }
+
+  net::NetworkTrafficAnnotationTag traffic_annotation =
+      net::DefineNetworkTrafficAnnotation("brave_rewards_resource_fetcher", R"(
+      semantics {
+        sender:
+          "Brave Rewards resource fetcher"
+        description:
+          "Fetches resources related to Brave Rewards."
+        trigger:
+          "User visits a media publisher's site."
+        data: "Brave Rewards related resources."
+        destination: WEBSITE
+      }
+      policy {
+        cookies_allowed: NO
+        setting:
+          "This feature cannot be disabled by settings."
+        policy_exception_justification:
+          "Not implemented."
+      })");
+  request_ids_.push_back(image_service->RequestImage(
+      GURL(path),
+      // Image Service takes ownership of the observer.
+      new RewardsResourceFetcherObserver(
+          GURL(path),
+          base::BindRepeating(&BraveRewardsSource::OnBitmapFetched,
+                              base::Unretained(this), path)),
+      traffic_annotation));
 }
 
 std::string BraveRewardsSource::GetMimeType(const std::string&) const {
@@ -119,7 +152,8 @@ std::string BraveRewardsSource::GetMimeType(const std::string&) const {
 }
 
 bool BraveRewardsSource::AllowCaching() const {
-  return false;
+  // Images are addressed by their source URL, which changes along with them.
+  return true;
 }
 
 bool BraveRewardsSource::ShouldReplaceExistingSource() const {
@@ -137,26 +171,61 @@ bool BraveRewardsSource::ShouldServiceRequest(
 }
 
 void BraveRewardsSource::OnBitmapFetched(
-    const content::URLDataSource::GotDataCallback& got_data_callback,
+    const std::string& path,
     BitmapFetcherService::RequestId request_id,
     const GURL& url,
     const SkBitmap& bitmap) {
+  auto it_ids = find(request_ids_.begin(), request_ids_.end(), request_id);
+  if (it_ids != request_ids_.end()) {
+    request_ids_.erase(it_ids);
+  }
+
   if (bitmap.isNull()) {
     LOG(ERROR) << "Failed to retrieve Brave Rewards resource, url: " << url;
-    got_data_callback.Run(nullptr);
+    OnImageReady(path, nullptr);
     return;
   }
 
-  got_data_callback.Run(BitmapToMemory(&bitmap).get());
+  scoped_refptr<base::RefCountedMemory> image = BitmapToMemory(&bitmap);
+  AddToMemoryCache(path, image);
+  OnImageReady(path, image);
+}
 
-  auto it_url =
-      find(resource_fetchers_.begin(), resource_fetchers_.end(), url.spec());
-  if (it_url != resource_fetchers_.end()) {
-    resource_fetchers_.erase(it_url);
+void BraveRewardsSource::OnImageReady(
+    const std::string& path,
+    scoped_refptr<base::RefCountedMemory> image) {
+  auto it = pending_requests_.find(path);
+  if (it == pending_requests_.end()) {
+    return;
   }
 
-  auto it_ids = find(request_ids_.begin(), request_ids_.end(), request_id);
-  if (it_ids != request_ids_.end()) {
-    request_ids_.erase(it_ids);
+  GotDataCallbacks callbacks = std::move(it->second);
+  pending_requests_.erase(it);
+
+  for (const auto& callback : callbacks) {
+    callback.Run(image.get());
+  }
+}
+
+void BraveRewardsSource::AddToMemoryCache(
+    const std::string& path,
+    scoped_refptr<base::RefCountedMemory> image) {
+  if (image->size() > kMaximumMemoryCacheSize) {
+    return;
+  }
+
+  auto existing = images_.Peek(path);
+  if (existing != images_.end()) {
+    images_size_ -= existing->second->size();
+    images_.Erase(existing);
+  }
+
+  images_size_ += image->size();
+  images_.Put(path, std::move(image));
+
+  while (images_size_ > kMaximumMemoryCacheSize) {
+    auto oldest = images_.rbegin();
+    images_size_ -= oldest->second->size();
+    images_.Erase(oldest);
   }
 }
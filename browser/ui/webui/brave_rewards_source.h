@@ -5,10 +5,15 @@
 #ifndef BRAVE_BROWSER_UI_WEBUI_BRAVE_REWARDS_SOURCE_H_
 #define BRAVE_BROWSER_UI_WEBUI_BRAVE_REWARDS_SOURCE_H_
 
+#include <stddef.h>
+
+#include <map>
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted_memory.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service.h"
 #include "content/public/browser/url_data_source.h"
 
@@ -16,6 +21,12 @@ class GURL;
 class Profile;
 class SkBitmap;
 
+// Serves the images shown by the rewards pages from chrome://rewards-image.
+//
+// Encoded images are kept in memory only, so pages listing many publishers
+// render from the cache when they are opened again, without leaving the
+// publishers a user visited on disk. Requests for an image that is already
+// being fetched wait for that fetch instead of starting another one.
 class BraveRewardsSource : public content::URLDataSource {
  public:
   explicit BraveRewardsSource(Profile* profile);
@@ -37,15 +48,28 @@ class BraveRewardsSource : public content::URLDataSource {
                             int render_process_id) const override;
 
  private:
+  using GotDataCallbacks =
+      std::vector<content::URLDataSource::GotDataCallback>;
+
+  void FetchImage(const std::string& path);
   void OnBitmapFetched(
-      const content::URLDataSource::GotDataCallback& got_data_callback,
+      const std::string& path,
       BitmapFetcherService::RequestId request_id,
       const GURL& url,
       const SkBitmap& bitmap);
+  void OnImageReady(const std::string& path,
+                    scoped_refptr<base::RefCountedMemory> image);
+  void AddToMemoryCache(const std::string& path,
+                        scoped_refptr<base::RefCountedMemory> image);
 
   Profile* profile_;
-  std::vector<std::string> resource_fetchers_;
+  // Requests waiting on each image being fetched, by path.
+  std::map<std::string, GotDataCallbacks> pending_requests_;
   std::vector<BitmapFetcherService::RequestId> request_ids_;
+  // Encoded images by path, evicted once they add up to more than
+  // kMaximumMemoryCacheSize bytes.
+  base::MRUCache<std::string, scoped_refptr<base::RefCountedMemory>> images_;
+  size_t images_size_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveRewardsSource);
 };
@@ -40,6 +40,33 @@ using content::WebUIMessageHandler;
 
 namespace {
 
+std::unique_ptr<base::DictionaryValue> ContributeSiteToValue(
+    const brave_rewards::ContentSite& item) {
+  auto publisher = std::make_unique<base::DictionaryValue>();
+  publisher->SetString("id", item.id);
+  publisher->SetDouble("percentage", item.percentage);
+  publisher->SetString("publisherKey", item.id);
+  publisher->SetBoolean("verified", item.verified);
+  publisher->SetInteger("excluded", item.excluded);
+  publisher->SetString("name", item.name);
+  publisher->SetString("provider", item.provider);
+  publisher->SetString("url", item.url);
+  publisher->SetString("favIcon", item.favicon_url);
+  return publisher;
+}
+
+// Compares the fields the contribute list shows
+bool IsSameContributeSite(const brave_rewards::ContentSite& a,
+                          const brave_rewards::ContentSite& b) {
+  return a.percentage == b.percentage &&
+         a.verified == b.verified &&
+         a.excluded == b.excluded &&
+         a.name == b.name &&
+         a.provider == b.provider &&
+         a.url == b.url &&
+         a.favicon_url == b.favicon_url;
+}
+
 // The handler for Javascript messages for Brave about: pages
 class RewardsDOMHandler : public WebUIMessageHandler,
     public brave_rewards::RewardsNotificationServiceObserver,
@@ -209,6 +236,12 @@ class RewardsDOMHandler : public WebUIMessageHandler,
 
   brave_rewards::RewardsService* rewards_service_;  // NOT OWNED
   brave_ads::AdsService* ads_service_;
+
+  // The contribute list last sent to the page, keyed by publisher id, so
+  // normalization after a visit only sends the rows that changed
+  std::map<std::string, brave_rewards::ContentSite> contribute_list_;
+  bool contribute_list_sent_ = false;
+
   base::WeakPtrFactory<RewardsDOMHandler> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(RewardsDOMHandler);
@@ -334,8 +367,10 @@ void RewardsDOMHandler::Init() {
   ads_service_ =
       brave_ads::AdsServiceFactory::GetForProfile(profile);
 
-  if (rewards_service_)
+  if (rewards_service_) {
     rewards_service_->AddObserver(this);
+    rewards_service_->WakeLedger();
+  }
 }
 
 void RewardsDOMHandler::OnGetAllBalanceReports(
@@ -786,20 +821,13 @@ void RewardsDOMHandler::OnContentSiteList(
     std::unique_ptr<brave_rewards::ContentSiteList> list,
     uint32_t record) {
   if (web_ui()->CanCallJavascript()) {
+    contribute_list_.clear();
     auto publishers = std::make_unique<base::ListValue>();
     for (auto const& item : *list) {
-      auto publisher = std::make_unique<base::DictionaryValue>();
-      publisher->SetString("id", item.id);
-      publisher->SetDouble("percentage", item.percentage);
-      publisher->SetString("publisherKey", item.id);
-      publisher->SetBoolean("verified", item.verified);
-      publisher->SetInteger("excluded", item.excluded);
-      publisher->SetString("name", item.name);
-      publisher->SetString("provider", item.provider);
-      publisher->SetString("url", item.url);
-      publisher->SetString("favIcon", item.favicon_url);
-      publishers->Append(std::move(publisher));
+      publishers->Append(ContributeSiteToValue(item));
+      contribute_list_.emplace(item.id, item);
     }
+    contribute_list_sent_ = true;
 
     web_ui()->CallJavascriptFunctionUnsafe(
         "brave_rewards.contributeList", *publishers);
@@ -950,6 +978,9 @@ void RewardsDOMHandler::GetOneTimeTips(const base::ListValue *args) {
 
 void RewardsDOMHandler::GetContributionList(const base::ListValue *args) {
   if (rewards_service_) {
+    // The page asks for the list when it loads, so it is sent whole until
+    // this request is answered
+    contribute_list_sent_ = false;
     OnContentSiteUpdated(rewards_service_);
   }
 }
@@ -1053,7 +1084,40 @@ void RewardsDOMHandler::OnRewardsMainEnabled(
 void RewardsDOMHandler::OnPublisherListNormalized(
     brave_rewards::RewardsService* rewards_service,
     const brave_rewards::ContentSiteList& list) {
-  OnContentSiteList(std::make_unique<brave_rewards::ContentSiteList>(list), 0);
+  if (!contribute_list_sent_) {
+    OnContentSiteList(
+        std::make_unique<brave_rewards::ContentSiteList>(list), 0);
+    return;
+  }
+
+  if (!web_ui()->CanCallJavascript()) {
+    return;
+  }
+
+  std::map<std::string, brave_rewards::ContentSite> contribute_list;
+  base::ListValue updated;
+  for (const auto& item : list) {
+    auto it = contribute_list_.find(item.id);
+    if (it == contribute_list_.end() ||
+        !IsSameContributeSite(it->second, item)) {
+      updated.Append(ContributeSiteToValue(item));
+    }
+    contribute_list.emplace(item.id, item);
+  }
+
+  base::ListValue removed;
+  for (const auto& item : contribute_list_) {
+    if (contribute_list.find(item.first) == contribute_list.end())
+      removed.AppendString(item.first);
+  }
+
+  contribute_list_ = std::move(contribute_list);
+  if (updated.empty() && removed.empty()) {
+    return;
+  }
+
+  web_ui()->CallJavascriptFunctionUnsafe(
+      "brave_rewards.contributeListChanged", updated, removed);
 }
 
 void RewardsDOMHandler::GetAddressesForPaymentId(
@@ -98,8 +98,10 @@ void RewardsTipDOMHandler::Init() {
   Profile* profile = Profile::FromWebUI(web_ui());
   rewards_service_ =
       brave_rewards::RewardsServiceFactory::GetForProfile(profile);
-  if (rewards_service_)
+  if (rewards_service_) {
     rewards_service_->AddObserver(this);
+    rewards_service_->WakeLedger();
+  }
 }
 
 void RewardsTipDOMHandler::RegisterMessages() {
@@ -565,6 +565,8 @@ void CustomizeWebUIHTMLSource(const std::string &name,
         { "adsBlocked", IDS_ADBLOCK_TOTAL_ADS_BLOCKED },
         { "customFiltersTitle", IDS_ADBLOCK_CUSTOM_FILTERS_TITLE },
         { "customFiltersInstructions", IDS_ADBLOCK_CUSTOM_FILTERS_INSTRUCTIONS },                // NOLINT
+        { "customFiltersInvalid", IDS_ADBLOCK_CUSTOM_FILTERS_INVALID },
+        { "regionalListStats", IDS_ADBLOCK_REGIONAL_LIST_STATS },
       }
     }, {
       std::string("tip"), {
@@ -602,6 +604,12 @@ void CustomizeWebUIHTMLSource(const std::string &name,
         { "currentReconcile", IDS_BRAVE_REWARDS_INTERNALS_CURRENT_RECONCILE },
         { "invalid", IDS_BRAVE_REWARDS_INTERNALS_INVALID },
         { "keyInfoSeed", IDS_BRAVE_REWARDS_INTERNALS_KEY_INFO_SEED },
+        { "perfStatAverage", IDS_BRAVE_REWARDS_INTERNALS_PERF_STAT_AVERAGE },
+        { "perfStatCount", IDS_BRAVE_REWARDS_INTERNALS_PERF_STAT_COUNT },
+        { "perfStatLast", IDS_BRAVE_REWARDS_INTERNALS_PERF_STAT_LAST },
+        { "perfStatMax", IDS_BRAVE_REWARDS_INTERNALS_PERF_STAT_MAX },
+        { "perfStatName", IDS_BRAVE_REWARDS_INTERNALS_PERF_STAT_NAME },
+        { "perfStats", IDS_BRAVE_REWARDS_INTERNALS_PERF_STATS },
         { "personaId", IDS_BRAVE_REWARDS_INTERNALS_PERSONA_ID },
         { "refreshButton", IDS_BRAVE_REWARDS_INTERNALS_REFRESH_BUTTON },
         { "retryLevel", IDS_BRAVE_REWARDS_INTERNALS_RETRY_LEVEL },
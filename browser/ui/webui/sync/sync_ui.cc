@@ -3,6 +3,11 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include "brave/browser/ui/webui/sync/sync_ui.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "base/bind.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/common/webui_url_constants.h"
@@ -51,6 +56,13 @@ class SyncUIDOMHandler : public WebUIMessageHandler,
   void OnSyncStateChanged(brave_sync::BraveSyncService *sync_service) override;
   void OnHaveSyncWords(brave_sync::BraveSyncService *sync_service,
                        const std::string& sync_words) override;
+  void OnSyncDevicesChanged(
+      brave_sync::BraveSyncService* sync_service,
+      const std::vector<brave_sync::SyncDevice>& changed_devices,
+      const std::vector<std::string>& deleted_device_ids) override;
+  void OnSyncRecordsApplyProgress(brave_sync::BraveSyncService* sync_service,
+                                  size_t applied,
+                                  size_t total) override;
 
   // this should grab actual data from controller and update the page
   void LoadSyncSettingsView();
@@ -244,6 +256,33 @@ void SyncUIDOMHandler::OnHaveSyncWords(
       "sync_ui_exports.haveSyncWords", base::Value(sync_words));
 }
 
+void SyncUIDOMHandler::OnSyncDevicesChanged(
+    brave_sync::BraveSyncService* sync_service,
+    const std::vector<brave_sync::SyncDevice>& changed_devices,
+    const std::vector<std::string>& deleted_device_ids) {
+  base::Value bv_changed_devices(base::Value::Type::LIST);
+  for (const auto& device : changed_devices)
+    bv_changed_devices.GetList().push_back(std::move(*device.ToValue()));
+
+  base::Value bv_deleted_device_ids(base::Value::Type::LIST);
+  for (const auto& device_id : deleted_device_ids)
+    bv_deleted_device_ids.GetList().push_back(base::Value(device_id));
+
+  web_ui()->CallJavascriptFunctionUnsafe(
+      "sync_ui_exports.devicesChanged",
+      bv_changed_devices, bv_deleted_device_ids);
+}
+
+void SyncUIDOMHandler::OnSyncRecordsApplyProgress(
+    brave_sync::BraveSyncService* sync_service,
+    size_t applied,
+    size_t total) {
+  web_ui()->CallJavascriptFunctionUnsafe(
+      "sync_ui_exports.syncRecordsApplyProgress",
+      base::Value(static_cast<double>(applied)),
+      base::Value(static_cast<double>(total)));
+}
+
 } // namespace
 
 SyncUI::SyncUI(content::WebUI* web_ui, const std::string& name)
@@ -15,8 +15,12 @@
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "base/task/post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time.h"
 #include "brave/browser/widevine/brave_widevine_bundle_unzipper.h"
 #include "brave/common/pref_names.h"
 #include "brave/grit/brave_generated_resources.h"
@@ -30,7 +34,11 @@
 #include "content/public/common/cdm_info.h"
 #include "content/public/browser/cdm_registry.h"
 #include "content/public/common/service_manager_connection.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_response.h"
 #include "services/service_manager/public/cpp/connector.h"
 #include "third_party/widevine/cdm/widevine_cdm_common.h"
 #include "url/gurl.h"
@@ -39,6 +47,85 @@
 namespace {
 
 constexpr int kWidevineBackgroundUpdateDelayInMins = 5;
+constexpr int kMaxBundleDownloadRetries = 3;
+constexpr base::TimeDelta kBundleDownloadRetryDelay =
+    base::TimeDelta::FromSeconds(5);
+
+const base::FilePath::CharType kPartialBundleFileName[] =
+    FILE_PATH_LITERAL("WidevineBundle.zip.partial");
+const base::FilePath::CharType kPartialBundleETagFileName[] =
+    FILE_PATH_LITERAL("WidevineBundle.zip.etag");
+
+struct PartialBundle {
+  base::FilePath path;
+  int64_t size = 0;
+  std::string etag;
+};
+
+base::FilePath GetPartialBundleETagPath(const base::FilePath& path) {
+  return path.DirName().Append(kPartialBundleETagFileName);
+}
+
+// Returns what is left of an earlier download, or an empty file to start.
+PartialBundle GetPartialBundle() {
+  PartialBundle partial_bundle;
+  base::FilePath user_data_dir;
+  if (!base::PathService::Get(chrome::DIR_USER_DATA, &user_data_dir))
+    return partial_bundle;
+
+  const base::FilePath path = user_data_dir.Append(kPartialBundleFileName);
+  if (!base::PathExists(path) && base::WriteFile(path, "", 0) != 0)
+    return partial_bundle;
+  if (!base::GetFileSize(path, &partial_bundle.size))
+    return partial_bundle;
+  base::ReadFileToString(GetPartialBundleETagPath(path), &partial_bundle.etag);
+  partial_bundle.path = path;
+  return partial_bundle;
+}
+
+void ResetPartialBundle(const base::FilePath& path, const std::string& etag) {
+  base::WriteFile(path, "", 0);
+  const base::FilePath etag_path = GetPartialBundleETagPath(path);
+  if (etag.empty())
+    base::DeleteFile(etag_path, false);
+  else
+    base::WriteFile(etag_path, etag.data(), etag.size());
+}
+
+void DeletePartialBundle(const base::FilePath& path) {
+  base::DeleteFile(path, false);
+  base::DeleteFile(GetPartialBundleETagPath(path), false);
+}
+
+// Returns the bundle length given by a 416 response, or -1.
+int64_t GetUnsatisfiedRangeLength(const net::HttpResponseHeaders& headers) {
+  std::string content_range;
+  int64_t length = -1;
+  if (!headers.EnumerateHeader(nullptr, "Content-Range", &content_range) ||
+      !base::StartsWith(content_range, "bytes */",
+                        base::CompareCase::INSENSITIVE_ASCII) ||
+      !base::StringToInt64(content_range.substr(8), &length)) {
+    return -1;
+  }
+  return length;
+}
+
+bool AppendToPartialBundle(const base::FilePath& path,
+                           const std::string& data) {
+  return base::AppendToFile(path, data.data(), data.size());
+}
+
+// Checks that nothing went missing, the unzipper checks the zip itself.
+bool VerifyPartialBundle(const base::FilePath& path, int64_t bundle_size) {
+  int64_t size = 0;
+  if (!base::GetFileSize(path, &size) || size == 0)
+    return false;
+  if (bundle_size >= 0 && size != bundle_size)
+    return false;
+  // The bundle is complete, the next download is a new one.
+  base::DeleteFile(GetPartialBundleETagPath(path), false);
+  return true;
+}
 
 base::Optional<base::FilePath> GetTargetWidevineBundleDir() {
   base::FilePath widevine_cdm_dir;
@@ -94,18 +181,42 @@ void BraveWidevineBundleManager::InstallWidevineBundle(
 
   done_callback_ = std::move(done_callback);
   set_in_progress(true);
+  download_retries_ = 0;
 
-  DownloadWidevineBundle(
-      GURL(WIDEVINE_CDM_DOWNLOAD_URL_STRING),
-      base::BindOnce(&BraveWidevineBundleManager::OnBundleDownloaded,
-                     base::Unretained(this)));
+  DownloadWidevineBundle(GURL(WIDEVINE_CDM_DOWNLOAD_URL_STRING));
 }
 
 void BraveWidevineBundleManager::DownloadWidevineBundle(
-    const GURL& bundle_zipfile_url,
-    network::SimpleURLLoader::DownloadToFileCompleteCallback callback) {
+    const GURL& bundle_zipfile_url) {
   if (is_test_) return;
 
+  base::PostTaskAndReplyWithResult(
+      file_task_runner().get(),
+      FROM_HERE,
+      base::BindOnce(&GetPartialBundle),
+      base::BindOnce(
+          [](base::WeakPtr<BraveWidevineBundleManager> manager,
+             const GURL& bundle_zipfile_url, PartialBundle partial_bundle) {
+            if (!manager)
+              return;
+            manager->partial_bundle_path_ = partial_bundle.path;
+            manager->OnGetPartialBundle(bundle_zipfile_url,
+                                        partial_bundle.size,
+                                        partial_bundle.etag);
+          },
+          weak_factory_.GetWeakPtr(), bundle_zipfile_url));
+}
+
+void BraveWidevineBundleManager::OnGetPartialBundle(
+    const GURL& bundle_zipfile_url,
+    int64_t partial_size,
+    const std::string& etag) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (partial_bundle_path_.empty()) {
+    InstallDone("getting partial bundle file failed");
+    return;
+  }
+
   net::NetworkTrafficAnnotationTag traffic_annotation =
       net::DefineNetworkTrafficAnnotation("widevine_bundle_downloader", R"(
         semantics {
@@ -128,13 +239,142 @@ void BraveWidevineBundleManager::DownloadWidevineBundle(
 
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = bundle_zipfile_url;
+  // Resume what an earlier attempt left, as long as the bundle is the same.
+  // Otherwise the server answers with the whole bundle.
+  downloaded_size_ = 0;
+  range_not_satisfiable_ = false;
+  if (partial_size > 0 && !etag.empty()) {
+    request->headers.SetHeader(net::HttpRequestHeaders::kRange,
+        "bytes=" + base::NumberToString(partial_size) + "-");
+    request->headers.SetHeader("If-Range", etag);
+    downloaded_size_ = partial_size;
+  }
+  bundle_size_ = -1;
+
   bundle_loader_ =
       network::SimpleURLLoader::Create(std::move(request), traffic_annotation);
-  bundle_loader_->DownloadToTempFile(
+  bundle_loader_->SetOnResponseStartedCallback(
+      base::BindOnce(&BraveWidevineBundleManager::OnBundleResponseStarted,
+                     base::Unretained(this)));
+  bundle_loader_->DownloadAsStream(
       g_browser_process->system_network_context_manager()
           ->GetURLLoaderFactory(),
-      std::move(callback)
-  );
+      this);
+}
+
+void BraveWidevineBundleManager::OnBundleResponseStarted(
+    const GURL& final_url,
+    const network::ResourceResponseHead& head) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const int response_code = head.headers ? head.headers->response_code() : 0;
+  std::string etag;
+  if (head.headers)
+    head.headers->EnumerateHeader(nullptr, "ETag", &etag);
+
+  // The partial file already holds the whole bundle when there is nothing
+  // left to ask for, which the loader reports as a failure.
+  if (response_code == net::HTTP_REQUESTED_RANGE_NOT_SATISFIABLE &&
+      downloaded_size_ > 0) {
+    range_not_satisfiable_ = true;
+    bundle_size_ = GetUnsatisfiedRangeLength(*head.headers);
+    return;
+  }
+
+  // Anything but a partial response has the bundle from the start, so the
+  // partial file is started over. This is posted ahead of any data.
+  if (response_code != net::HTTP_PARTIAL_CONTENT) {
+    downloaded_size_ = 0;
+    file_task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&ResetPartialBundle, partial_bundle_path_,
+                                  etag));
+  }
+
+  if (head.content_length >= 0)
+    bundle_size_ = downloaded_size_ + head.content_length;
+}
+
+void BraveWidevineBundleManager::OnDataReceived(base::StringPiece string_piece,
+                                                base::OnceClosure resume) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // The next chunk is only asked for once this one is written, which keeps
+  // the writes in order and bounds the memory held for them.
+  base::PostTaskAndReplyWithResult(
+      file_task_runner().get(),
+      FROM_HERE,
+      base::BindOnce(&AppendToPartialBundle, partial_bundle_path_,
+                     string_piece.as_string()),
+      base::BindOnce(&BraveWidevineBundleManager::OnBundleDataWritten,
+                     weak_factory_.GetWeakPtr(), std::move(resume),
+                     string_piece.size()));
+}
+
+void BraveWidevineBundleManager::OnBundleDataWritten(base::OnceClosure resume,
+                                                     size_t size,
+                                                     bool success) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!success) {
+    bundle_loader_.reset();
+    InstallDone("writing bundle file failed");
+    return;
+  }
+
+  downloaded_size_ += size;
+  std::move(resume).Run();
+}
+
+void BraveWidevineBundleManager::OnComplete(bool success) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  bundle_loader_.reset();
+  if (!success && !range_not_satisfiable_) {
+    RetryOrFailDownload();
+    return;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      file_task_runner().get(),
+      FROM_HERE,
+      base::BindOnce(&VerifyPartialBundle, partial_bundle_path_,
+                     bundle_size_),
+      base::BindOnce(&BraveWidevineBundleManager::OnBundleVerified,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void BraveWidevineBundleManager::OnRetry(base::OnceClosure start_retry) {
+  // Retries are done by RetryOrFailDownload() so they can resume.
+  NOTREACHED();
+}
+
+void BraveWidevineBundleManager::OnBundleVerified(bool valid) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!valid) {
+    // Whatever was written can't be trusted, so the retry starts over.
+    file_task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&ResetPartialBundle, partial_bundle_path_,
+                                  std::string()));
+    RetryOrFailDownload();
+    return;
+  }
+
+  OnBundleDownloaded(partial_bundle_path_);
+}
+
+void BraveWidevineBundleManager::RetryOrFailDownload() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (download_retries_ >= kMaxBundleDownloadRetries) {
+    // Nothing is left behind once the install has failed.
+    file_task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&DeletePartialBundle, partial_bundle_path_));
+    OnBundleDownloaded(base::FilePath());
+    return;
+  }
+
+  ++download_retries_;
+  base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&BraveWidevineBundleManager::DownloadWidevineBundle,
+                     weak_factory_.GetWeakPtr(),
+                     GURL(WIDEVINE_CDM_DOWNLOAD_URL_STRING)),
+      kBundleDownloadRetryDelay * download_retries_);
 }
 
 void BraveWidevineBundleManager::OnBundleDownloaded(
@@ -305,11 +545,21 @@ void BraveWidevineBundleManager::DoDelayedBackgroundUpdate() {
 int
 BraveWidevineBundleManager::GetWidevinePermissionRequestTextFragment() const {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  return needs_restart() ?
-      IDS_WIDEVINE_PERMISSION_REQUEST_TEXT_FRAGMENT_RESTART_BROWSER :
+  if (needs_restart())
+    return IDS_WIDEVINE_PERMISSION_REQUEST_TEXT_FRAGMENT_RESTART_BROWSER;
+  return in_progress() ?
+      IDS_WIDEVINE_PERMISSION_REQUEST_TEXT_FRAGMENT_INSTALLING :
       IDS_WIDEVINE_PERMISSION_REQUEST_TEXT_FRAGMENT_INSTALL;
 }
 
+int BraveWidevineBundleManager::install_progress() const {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (bundle_size_ <= 0)
+    return 0;
+  return static_cast<int>(
+      std::min<int64_t>(100, downloaded_size_ * 100 / bundle_size_));
+}
+
 void BraveWidevineBundleManager::WillRestart() const {
   DCHECK(needs_restart());
   SetWidevinePrefs(true);
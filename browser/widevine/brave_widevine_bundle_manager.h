@@ -6,6 +6,8 @@
 #ifndef BRAVE_BROWSER_WIDEVINE_BRAVE_WIDEVINE_BUNDLE_MANAGER_H_
 #define BRAVE_BROWSER_WIDEVINE_BRAVE_WIDEVINE_BUNDLE_MANAGER_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 
@@ -17,6 +19,7 @@
 #include "base/optional.h"
 #include "base/strings/string_piece_forward.h"
 #include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
 
 class GURL;
 
@@ -25,11 +28,23 @@ class FilePath;
 class SequencedTaskRunner;
 }
 
+namespace network {
+struct ResourceResponseHead;
+}
+
 namespace user_prefs {
 class PrefRegistrySyncable;
 }
 
-class BraveWidevineBundleManager {
+// Downloads the widevine bundle and unzips it into the user data dir.
+//
+// The bundle is streamed into a partial file that is kept until the bundle
+// is unzipped, so a failed or interrupted download resumes with a range
+// request instead of starting over. The partial file is only resumed while
+// the server reports the same ETag for the bundle, and is deleted once the
+// download has failed for good.
+class BraveWidevineBundleManager
+    : public network::SimpleURLLoaderStreamConsumer {
  public:
   static char kWidevineInvalidVersion[];
   static void RegisterProfilePrefs(user_prefs::PrefRegistrySyncable* registry);
@@ -38,7 +53,7 @@ class BraveWidevineBundleManager {
   using DoneCallback = base::OnceCallback<void(const std::string& error)>;
 
   BraveWidevineBundleManager();
-  ~BraveWidevineBundleManager();
+  ~BraveWidevineBundleManager() override;
 
   void InstallWidevineBundle(DoneCallback done_callback, bool user_gesture);
 
@@ -57,6 +72,10 @@ class BraveWidevineBundleManager {
 
   int GetWidevinePermissionRequestTextFragment() const;
 
+  // Percentage of the bundle downloaded so far, 0 when the size of the
+  // bundle is not known yet.
+  int install_progress() const;
+
   void WillRestart() const;
 
   bool is_test() const { return is_test_; }
@@ -70,14 +89,33 @@ class BraveWidevineBundleManager {
   FRIEND_TEST_ALL_PREFIXES(BraveWidevineBundleManagerTest, DownloadFailTest);
   FRIEND_TEST_ALL_PREFIXES(BraveWidevineBundleManagerTest, UnzipFailTest);
   FRIEND_TEST_ALL_PREFIXES(BraveWidevineBundleManagerTest, MessageStringTest);
+  FRIEND_TEST_ALL_PREFIXES(BraveWidevineBundleManagerTest, ProgressTest);
   FRIEND_TEST_ALL_PREFIXES(BraveWidevineBundleManagerTest,
                            RetryInstallAfterFail);
+  FRIEND_TEST_ALL_PREFIXES(BraveWidevineBundleManagerTest,
+                           RangeNotSatisfiableTest);
+  FRIEND_TEST_ALL_PREFIXES(BraveWidevineBundleManagerTest,
+                           PartialBundleDeletedAfterFailTest);
   FRIEND_TEST_ALL_PREFIXES(WidevinePermissionRequestBrowserTest,
                            TriggerTwoPermissionTest);
 
-  void DownloadWidevineBundle(
-      const GURL& bundle_zipfile_url,
-      network::SimpleURLLoader::DownloadToFileCompleteCallback callback);
+  // network::SimpleURLLoaderStreamConsumer:
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override;
+  void OnComplete(bool success) override;
+  void OnRetry(base::OnceClosure start_retry) override;
+
+  void DownloadWidevineBundle(const GURL& bundle_zipfile_url);
+  void OnGetPartialBundle(const GURL& bundle_zipfile_url,
+                          int64_t partial_size,
+                          const std::string& etag);
+  void OnBundleResponseStarted(const GURL& final_url,
+                               const network::ResourceResponseHead& head);
+  void OnBundleDataWritten(base::OnceClosure resume,
+                           size_t size,
+                           bool success);
+  void OnBundleVerified(bool valid);
+  void RetryOrFailDownload();
   void OnBundleDownloaded(base::FilePath tmp_bundle_zip_file_path);
   void OnGetTargetWidevineBundleDir(
       const base::FilePath& tmp_bundle_zip_file_path,
@@ -100,6 +138,14 @@ class BraveWidevineBundleManager {
   bool in_progress_ = false;
   bool needs_restart_ = false;
   std::unique_ptr<network::SimpleURLLoader> bundle_loader_;
+  base::FilePath partial_bundle_path_;
+  // Bytes of the bundle in |partial_bundle_path_|, and the size of the whole
+  // bundle or -1 if not known.
+  int64_t downloaded_size_ = 0;
+  int64_t bundle_size_ = -1;
+  // True when the server had no bytes left to send after the partial file.
+  bool range_not_satisfiable_ = false;
+  int download_retries_ = 0;
   scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
 
   base::WeakPtrFactory<BraveWidevineBundleManager> weak_factory_;
@@ -5,6 +5,7 @@
 
 #include "brave/browser/widevine/brave_widevine_bundle_manager.h"
 
+#include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "brave/common/pref_names.h"
 #include "brave/grit/brave_generated_resources.h"
@@ -19,6 +20,9 @@
 #include "content/public/test/test_browser_thread_bundle.h"
 #include "content/test/test_content_client.h"
 #include "media/base/decrypt_config.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
+#include "services/network/public/cpp/resource_response.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/widevine/cdm/widevine_cdm_common.h"
 #include "widevine_cdm_version.h"
@@ -234,3 +238,75 @@ TEST_F(BraveWidevineBundleManagerTest, MessageStringTest) {
   DCHECK_EQ(IDS_WIDEVINE_PERMISSION_REQUEST_TEXT_FRAGMENT_RESTART_BROWSER,
             manager_.GetWidevinePermissionRequestTextFragment());
 }
+
+TEST_F(BraveWidevineBundleManagerTest, ProgressTest) {
+  PrepareTest(true);
+
+  manager_.StartupCheck();
+  manager_.InstallWidevineBundle(base::BindOnce([](const std::string&) {}),
+                                 false);
+  DCHECK_EQ(IDS_WIDEVINE_PERMISSION_REQUEST_TEXT_FRAGMENT_INSTALLING,
+            manager_.GetWidevinePermissionRequestTextFragment());
+
+  // Unknown size reads as no progress.
+  DCHECK_EQ(0, manager_.install_progress());
+
+  manager_.bundle_size_ = 200;
+  manager_.downloaded_size_ = 50;
+  DCHECK_EQ(25, manager_.install_progress());
+
+  manager_.downloaded_size_ = 200;
+  DCHECK_EQ(100, manager_.install_progress());
+
+  manager_.InstallDone("");
+  DCHECK_EQ(IDS_WIDEVINE_PERMISSION_REQUEST_TEXT_FRAGMENT_RESTART_BROWSER,
+            manager_.GetWidevinePermissionRequestTextFragment());
+}
+
+TEST_F(BraveWidevineBundleManagerTest, RangeNotSatisfiableTest) {
+  PrepareTest(true);
+
+  manager_.StartupCheck();
+  manager_.InstallWidevineBundle(base::BindOnce([](const std::string&) {}),
+                                 false);
+
+  // The partial file already has all of the bundle.
+  const std::string raw_headers =
+      "HTTP/1.1 416 Range Not Satisfiable\n"
+      "Content-Range: bytes */200\n\n";
+  network::ResourceResponseHead head;
+  head.headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+      net::HttpUtil::AssembleRawHeaders(raw_headers.c_str(),
+                                        raw_headers.size()));
+  manager_.downloaded_size_ = 200;
+  manager_.OnBundleResponseStarted(GURL(), head);
+  DCHECK(manager_.range_not_satisfiable_);
+  DCHECK_EQ(200, manager_.bundle_size_);
+  DCHECK_EQ(200, manager_.downloaded_size_);
+}
+
+TEST_F(BraveWidevineBundleManagerTest, PartialBundleDeletedAfterFailTest) {
+  PrepareTest(true);
+
+  manager_.StartupCheck();
+  manager_.InstallWidevineBundle(base::BindOnce([](const std::string&) {}),
+                                 false);
+
+  const base::FilePath partial_path =
+      temp_dir_.GetPath().AppendASCII("WidevineBundle.zip.partial");
+  const base::FilePath etag_path =
+      temp_dir_.GetPath().AppendASCII("WidevineBundle.zip.etag");
+  DCHECK_EQ(3, base::WriteFile(partial_path, "zip", 3));
+  DCHECK_EQ(4, base::WriteFile(etag_path, "etag", 4));
+
+  // The last retry failed as well.
+  manager_.partial_bundle_path_ = partial_path;
+  manager_.download_retries_ = 3;
+  manager_.RetryOrFailDownload();
+  threads_.RunUntilIdle();
+
+  DCHECK(!manager_.in_progress());
+  DCHECK(!base::PathExists(partial_path));
+  DCHECK(!base::PathExists(etag_path));
+  CheckPrefsStatesAreInitialState();
+}
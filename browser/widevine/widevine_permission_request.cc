@@ -24,8 +24,14 @@ PermissionRequest::IconId WidevinePermissionRequest::GetIconId() const {
 }
 
 base::string16 WidevinePermissionRequest::GetMessageTextFragment() const {
-  return l10n_util::GetStringUTF16(
-      GetWidevinePermissionRequestTextFrangmentResourceId());
+  const int message_id = GetWidevinePermissionRequestTextFrangmentResourceId();
+#if BUILDFLAG(BUNDLE_WIDEVINE_CDM)
+  if (message_id == IDS_WIDEVINE_PERMISSION_REQUEST_TEXT_FRAGMENT_INSTALLING) {
+    return l10n_util::GetStringFUTF16Int(message_id,
+                                         GetWidevineInstallProgress());
+  }
+#endif
+  return l10n_util::GetStringUTF16(message_id);
 }
 
 GURL WidevinePermissionRequest::GetOrigin() const {
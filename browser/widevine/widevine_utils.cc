@@ -43,7 +43,8 @@ bool IsActiveTabRequestedWidevine() {
   if (content::WebContents* active_web_contents = GetActiveWebContents()) {
     BraveDrmTabHelper* drm_helper =
         BraveDrmTabHelper::FromWebContents(active_web_contents);
-    is_active_tab_requested_widevine = drm_helper->ShouldShowWidevineOptIn();
+    is_active_tab_requested_widevine =
+        drm_helper && drm_helper->ShouldShowWidevineOptIn();
   }
 
   return is_active_tab_requested_widevine;
@@ -119,4 +120,9 @@ void InstallBundleOrRestartBrowser() {
                                    true);
   }
 }
+
+int GetWidevineInstallProgress() {
+  return g_brave_browser_process->brave_widevine_bundle_manager()
+      ->install_progress();
+}
 #endif
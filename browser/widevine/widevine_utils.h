@@ -17,6 +17,8 @@ void RequestWidevinePermission(content::WebContents* web_contents);
 
 #if BUILDFLAG(BUNDLE_WIDEVINE_CDM)
 void InstallBundleOrRestartBrowser();
+// Percentage of the bundle downloaded by the install in progress.
+int GetWidevineInstallProgress();
 #endif
 
 #if BUILDFLAG(ENABLE_WIDEVINE_CDM_COMPONENT)
@@ -6,15 +6,31 @@
 #include "../../../../net/socket/socks5_client_socket.cc"  // NOLINT
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "net/base/io_buffer.h"
 #include "net/socket/socks5_client_socket.h"
 
 namespace net {
 
+namespace {
+
+// Live authenticated SOCKS sockets per proxy username. Tor sends each
+// isolation key as its own username, so each key is its own connection group
+// and this counts the sockets each first-party site holds. Sockets are only
+// created and destroyed on the network thread.
+std::map<std::string, int>& GetSocketsPerUsername() {
+  static base::NoDestructor<std::map<std::string, int>> sockets;
+  return *sockets;
+}
+
+}  // namespace
+
 int SOCKS5ClientSocket::DoAuth(int rv) {
   rv = Authenticate(rv, net_log_, io_callback_);
   next_state_ = (rv == OK ? STATE_HANDSHAKE_WRITE : STATE_AUTH);
@@ -41,9 +57,26 @@ SOCKS5ClientSocketAuth::SOCKS5ClientSocketAuth(
                          traffic_annotation),
       proxy_host_port_(proxy_host_port),
       next_state_(STATE_INIT_WRITE) {
+  if (!do_auth())
+    return;
+
+  auto& sockets = GetSocketsPerUsername();
+  const int count = ++sockets[username()];
+  UMA_HISTOGRAM_COUNTS_100("Brave.Tor.SocketsPerIsolationKey", count);
+  UMA_HISTOGRAM_COUNTS_1000("Brave.Tor.IsolationKeysWithSockets",
+                            sockets.size());
 }
 
-SOCKS5ClientSocketAuth::~SOCKS5ClientSocketAuth() = default;
+SOCKS5ClientSocketAuth::~SOCKS5ClientSocketAuth() {
+  if (!do_auth())
+    return;
+
+  auto& sockets = GetSocketsPerUsername();
+  auto it = sockets.find(username());
+  DCHECK(it != sockets.end());
+  if (it != sockets.end() && --it->second <= 0)
+    sockets.erase(it);
+}
 
 const std::string& SOCKS5ClientSocketAuth::username() {
   return proxy_host_port_.username();
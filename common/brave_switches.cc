@@ -58,4 +58,9 @@ const char kEnableSmartTrackingProtection[] =
 // This prevents appending "Brave" to UA.
 const char kDisableOverrideUA[] = "disable-override-ua";
 
+// Holds subresource requests made before the ad block lists have loaded,
+// for a bounded time, instead of letting them through unfiltered.
+const char kHoldRequestsUntilShieldsReady[] =
+    "hold-requests-until-shields-ready";
+
 }  // namespace switches
@@ -40,6 +40,8 @@ extern const char kEnableSmartTrackingProtection[];
 
 extern const char kDisableOverrideUA[];
 
+extern const char kHoldRequestsUntilShieldsReady[];
+
 }  // namespace switches
 
 #endif  // BRAVE_COMMON_BRAVE_SWITCHES_H_
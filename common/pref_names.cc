@@ -37,6 +37,7 @@ const char kReferralAttemptTimestamp[] =
 const char kReferralAttemptCount[] = "brave.referral.referral_attempt_count";
 const char kReferralCheckedForPromoCodeFile[] =
     "brave.referral.checked_for_promo_code_file";
+const char kReferralComplete[] = "brave.referral.complete";
 const char kHTTPSEVerywhereControlType[] = "brave.https_everywhere_default";
 const char kNoScriptControlType[] = "brave.no_script_default";
 const char kGoogleLoginControlType[] = "brave.google_login_default";
@@ -32,6 +32,7 @@ extern const char kReferralTimestamp[];
 extern const char kReferralAttemptTimestamp[];
 extern const char kReferralAttemptCount[];
 extern const char kReferralCheckedForPromoCodeFile[];
+extern const char kReferralComplete[];
 extern const char kHTTPSEVerywhereControlType[];
 extern const char kNoScriptControlType[];
 extern const char kGoogleLoginControlType[];
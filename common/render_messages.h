@@ -5,6 +5,8 @@
 
 // Multiply-included file, no traditional include guard.
 
+#include <vector>
+
 #include "base/strings/string16.h"
 #include "ipc/ipc_message_macros.h"
 
@@ -14,9 +16,10 @@
 #define IPC_MESSAGE_START BlinkTestMsgStart
 
 // Tells the browser that content in the current page was blocked due to the
-// user's content settings.
+// user's content settings. The renderer batches these, reporting each blocked
+// URL once per document.
 IPC_MESSAGE_ROUTED1(BraveViewHostMsg_JavaScriptBlocked,
-                    base::string16 /* details on blocked content */)
+                    std::vector<base::string16> /* blocked content */)
 
 IPC_MESSAGE_ROUTED1(BraveViewHostMsg_FingerprintingBlocked,
-                    base::string16 /* details on blocked content */)
+                    std::vector<base::string16> /* blocked content */)
@@ -5,57 +5,71 @@
 
 #include "brave/common/shield_exceptions.h"
 
-#include <algorithm>
+#include <functional>
 #include <map>
-#include <vector>
+#include <memory>
+#include <string>
 
+#include "brave/common/url_pattern_host_index.h"
 #include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
 
 namespace brave {
 
+namespace {
+
+struct CookieExceptionTable {
+  // Only applies while Google login is allowed.
+  URLPatternHostIndex google_auth;
+  // Exceptions that only apply when the first party has the given host.
+  std::map<std::string, std::unique_ptr<URLPatternHostIndex>, std::less<>>
+      by_first_party_host;
+};
+
+std::unique_ptr<URLPatternHostIndex> CreateBlockedPatterns() {
+  auto patterns = std::make_unique<URLPatternHostIndex>();
+  patterns->Add(
+      URLPattern(URLPattern::SCHEME_ALL, "https://pdfjs.robwu.nl/*"));
+  return patterns;
+}
+
+std::unique_ptr<CookieExceptionTable> CreateCookieExceptionTable() {
+  auto table = std::make_unique<CookieExceptionTable>();
+  // Note that there's already an exception for TLD+1, so don't add those
+  // here. Check with the security team before adding exceptions.
+  table->google_auth.Add(URLPattern(URLPattern::SCHEME_ALL,
+      "https://accounts.google.com/o/oauth2/*"));
+  return table;
+}
+
+}  // namespace
+
 bool IsBlockedResource(const GURL& gurl) {
-  static std::vector<URLPattern> blocked_patterns({
-      URLPattern(URLPattern::SCHEME_ALL, "https://pdfjs.robwu.nl/*")
-  });
-  return std::any_of(blocked_patterns.begin(), blocked_patterns.end(),
-                     [&gurl](URLPattern pattern){
-                       return pattern.MatchesURL(gurl);
-                     });
+  static const std::unique_ptr<URLPatternHostIndex> blocked_patterns =
+      CreateBlockedPatterns();
+  return blocked_patterns->Match(gurl) != URLPatternHostIndex::kNoMatch;
 }
 
 bool IsWhitelistedCookieException(const GURL& firstPartyOrigin,
     const GURL& subresourceUrl, bool allow_google_auth) {
-  // Note that there's already an exception for TLD+1, so don't add those here.
-  // Check with the security team before adding exceptions.
+  // Built once and never modified afterwards, so concurrent reads from the
+  // cookie hooks need no locking.
+  static const std::unique_ptr<CookieExceptionTable> exceptions =
+      CreateCookieExceptionTable();
 
   // 1st-party-INdependent whitelist
-  std::vector<URLPattern> fpi_whitelist_patterns = {};
-  if (allow_google_auth) {
-    fpi_whitelist_patterns.push_back(URLPattern(URLPattern::SCHEME_ALL,
-        "https://accounts.google.com/o/oauth2/*"));
-  }
-  bool any_match = std::any_of(fpi_whitelist_patterns.begin(),
-      fpi_whitelist_patterns.end(),
-      [&subresourceUrl](const URLPattern& pattern) {
-        return pattern.MatchesURL(subresourceUrl);
-      });
-  if (any_match) {
+  if (allow_google_auth &&
+      exceptions->google_auth.Match(subresourceUrl) !=
+          URLPatternHostIndex::kNoMatch) {
     return true;
   }
 
   // 1st-party-dependent whitelist
-  static std::map<GURL, std::vector<URLPattern> > whitelist_patterns = {};
-  std::map<GURL, std::vector<URLPattern> >::iterator i =
-      whitelist_patterns.find(firstPartyOrigin);
-  if (i == whitelist_patterns.end()) {
+  auto i = exceptions->by_first_party_host.find(firstPartyOrigin.host_piece());
+  if (i == exceptions->by_first_party_host.end()) {
     return false;
   }
-  std::vector<URLPattern> &exceptions = i->second;
-  return std::any_of(exceptions.begin(), exceptions.end(),
-      [&subresourceUrl](const URLPattern& pattern) {
-        return pattern.MatchesURL(subresourceUrl);
-      });
+  return i->second->Match(subresourceUrl) != URLPatternHostIndex::kNoMatch;
 }
 
 }  // namespace brave
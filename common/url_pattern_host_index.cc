@@ -0,0 +1,75 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/url_pattern_host_index.h"
+
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+// static
+constexpr size_t URLPatternHostIndex::kNoMatch;
+
+URLPatternHostIndex::URLPatternHostIndex() {
+}
+
+URLPatternHostIndex::~URLPatternHostIndex() {
+}
+
+size_t URLPatternHostIndex::Add(const URLPattern& pattern) {
+  return AddEntry(pattern, false);
+}
+
+size_t URLPatternHostIndex::AddHostOnly(const URLPattern& pattern) {
+  return AddEntry(pattern, true);
+}
+
+size_t URLPatternHostIndex::AddEntry(const URLPattern& pattern,
+                                     bool host_only) {
+  const size_t position = patterns_.size();
+  patterns_.push_back({pattern, host_only});
+  if (pattern.host().empty())
+    patterns_without_host_.push_back(position);
+  else
+    patterns_by_host_[pattern.host()].push_back(position);
+  return position;
+}
+
+size_t URLPatternHostIndex::Match(const GURL& url) const {
+  size_t best = kNoMatch;
+  MatchAmong(patterns_without_host_, url, &best);
+
+  // Try the host itself, then each parent domain for patterns that match
+  // subdomains; the pattern itself makes the final call either way.
+  base::StringPiece host = url.host_piece();
+  while (!host.empty()) {
+    auto it = patterns_by_host_.find(host);
+    if (it != patterns_by_host_.end())
+      MatchAmong(it->second, url, &best);
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+  return best;
+}
+
+void URLPatternHostIndex::MatchAmong(const std::vector<size_t>& candidates,
+                                     const GURL& url,
+                                     size_t* best) const {
+  for (size_t position : candidates) {
+    if (position >= *best)
+      return;
+    const Entry& entry = patterns_[position];
+    if (entry.host_only ? entry.pattern.MatchesHost(url)
+                        : entry.pattern.MatchesURL(url)) {
+      *best = position;
+      return;
+    }
+  }
+}
+
+}  // namespace brave
@@ -0,0 +1,65 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMMON_URL_PATTERN_HOST_INDEX_H_
+#define BRAVE_COMMON_URL_PATTERN_HOST_INDEX_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave {
+
+// A fixed list of URLPatterns indexed by host, so matching a URL only
+// evaluates the patterns whose host can match it. A URL on a host none of
+// the patterns mention costs one lookup per host label. Patterns without a
+// host are checked for every URL.
+class URLPatternHostIndex {
+ public:
+  static constexpr size_t kNoMatch = static_cast<size_t>(-1);
+
+  URLPatternHostIndex();
+  ~URLPatternHostIndex();
+
+  // Returns the position of |pattern| in the list.
+  size_t Add(const URLPattern& pattern);
+  // Same as Add, but only the scheme and host of |pattern| are matched, as
+  // with URLPattern::MatchesHost.
+  size_t AddHostOnly(const URLPattern& pattern);
+  // Returns the position of the first pattern in the list matching |url|,
+  // or kNoMatch.
+  size_t Match(const GURL& url) const;
+
+ private:
+  struct Entry {
+    URLPattern pattern;
+    bool host_only;
+  };
+
+  size_t AddEntry(const URLPattern& pattern, bool host_only);
+  void MatchAmong(const std::vector<size_t>& candidates,
+                  const GURL& url,
+                  size_t* best) const;
+
+  std::vector<Entry> patterns_;
+  // Positions in |patterns_|, in ascending order.
+  base::flat_map<std::string, std::vector<size_t>, std::less<>>
+      patterns_by_host_;
+  std::vector<size_t> patterns_without_host_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLPatternHostIndex);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMMON_URL_PATTERN_HOST_INDEX_H_
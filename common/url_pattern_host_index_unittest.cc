@@ -0,0 +1,43 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/url_pattern_host_index.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave::URLPatternHostIndex;
+
+TEST(URLPatternHostIndexTest, MatchesByHost) {
+  URLPatternHostIndex index;
+  EXPECT_EQ(index.Add(URLPattern(URLPattern::SCHEME_HTTPS,
+                                 "https://a.example.com/ads/*")), 0u);
+  EXPECT_EQ(index.Add(URLPattern(URLPattern::SCHEME_ALL,
+                                 "*://*.example.org/*")), 1u);
+  EXPECT_EQ(index.AddHostOnly(URLPattern(URLPattern::SCHEME_HTTPS,
+                                         "https://host.example.net/")), 2u);
+
+  EXPECT_EQ(index.Match(GURL("https://a.example.com/ads/1.js")), 0u);
+  EXPECT_EQ(index.Match(GURL("https://a.example.com/other")),
+            URLPatternHostIndex::kNoMatch);
+  EXPECT_EQ(index.Match(GURL("https://b.example.com/ads/1.js")),
+            URLPatternHostIndex::kNoMatch);
+  EXPECT_EQ(index.Match(GURL("http://example.org/")), 1u);
+  EXPECT_EQ(index.Match(GURL("http://deep.sub.example.org/x")), 1u);
+  EXPECT_EQ(index.Match(GURL("http://example.org.evil.com/")),
+            URLPatternHostIndex::kNoMatch);
+  EXPECT_EQ(index.Match(GURL("https://host.example.net/any/path")), 2u);
+  EXPECT_EQ(index.Match(GURL("https://brave.com/")),
+            URLPatternHostIndex::kNoMatch);
+}
+
+TEST(URLPatternHostIndexTest, FirstAddedPatternWins) {
+  URLPatternHostIndex index;
+  index.Add(URLPattern(URLPattern::SCHEME_ALL, "*://*.example.com/*"));
+  index.Add(URLPattern(URLPattern::SCHEME_ALL, "*://www.example.com/*"));
+  index.Add(URLPattern(URLPattern::SCHEME_ALL, "<all_urls>"));
+  EXPECT_EQ(index.Match(GURL("https://www.example.com/")), 0u);
+  EXPECT_EQ(index.Match(GURL("https://brave.com/")), 2u);
+}
@@ -17,6 +17,12 @@ export const getCustomFilters = () => action(types.ADBLOCK_GET_CUSTOM_FILTERS)
 
 export const getRegionalLists = () => action(types.ADBLOCK_GET_REGIONAL_LISTS)
 
+export const onCustomFiltersSpliced = (success: boolean, errors: AdBlock.FilterError[]) =>
+  action(types.ADBLOCK_ON_CUSTOM_FILTERS_SPLICED, {
+    success,
+    errors
+  })
+
 export const onGetCustomFilters = (customFilters: string) =>
   action(types.ADBLOCK_ON_GET_CUSTOM_FILTERS, {
     customFilters
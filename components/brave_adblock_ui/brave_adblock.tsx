@@ -38,6 +38,11 @@ window.cr.define('brave_adblock', function () {
     window.i18nTemplate.process(window.document, window.loadTimeData)
   }
 
+  function onCustomFiltersSpliced (success: boolean, errors: AdBlock.FilterError[]) {
+    const actions = bindActionCreators(adblockActions, store.dispatch.bind(store))
+    actions.onCustomFiltersSpliced(success, errors)
+  }
+
   function onGetCustomFilters (customFilters: string) {
     const actions = bindActionCreators(adblockActions, store.dispatch.bind(store))
     actions.onGetCustomFilters(customFilters)
@@ -55,6 +60,7 @@ window.cr.define('brave_adblock', function () {
 
   return {
     initialize,
+    onCustomFiltersSpliced,
     onGetCustomFilters,
     onGetRegionalLists,
     statsUpdated
@@ -4,6 +4,9 @@
 
 import * as React from 'react'
 
+// Utils
+import { getLocale } from '../../common/locale'
+
 interface Props {
   actions: any
   resource: AdBlock.FilterList
@@ -18,6 +21,26 @@ export class AdBlockItem extends React.Component<Props, {}> {
     this.props.actions.enableFilterList(this.props.resource.uuid, event.target.checked)
   }
 
+  renderStats () {
+    const { stats } = this.props.resource
+    if (!stats) {
+      return null
+    }
+    return (
+      <div style={{ fontSize: '12px', marginLeft: '24px' }}>
+        {
+          getLocale('regionalListStats', {
+            rules: stats.rules_loaded.toString(),
+            memory: Math.round(stats.memory_bytes / 1024).toString(),
+            matched: stats.requests_matched.toString(),
+            checked: stats.requests_checked.toString(),
+            time: stats.match_time_ms.toFixed(1)
+          })
+        }
+      </div>
+    )
+  }
+
   render () {
     return (
       <div>
@@ -30,6 +53,7 @@ export class AdBlockItem extends React.Component<Props, {}> {
           />
           {this.props.resource.title}
         </label>
+        {this.renderStats()}
       </div>
     )
   }
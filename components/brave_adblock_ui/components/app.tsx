@@ -40,6 +40,7 @@ export class AdblockPage extends React.Component<Props, {}> {
         <CustomFilters
           actions={actions}
           rules={adblockData.settings.customFilters || ''}
+          errors={adblockData.settings.customFilterErrors || []}
         />
       </div>
     )
@@ -4,9 +4,13 @@
 
 import * as React from 'react'
 
+// Utils
+import { getLocale } from '../../common/locale'
+
 interface Props {
   actions: any,
   rules: string
+  errors: AdBlock.FilterError[]
 }
 
 export class CustomFilters extends React.Component<Props, {}> {
@@ -38,6 +42,20 @@ export class CustomFilters extends React.Component<Props, {}> {
           value={this.props.rules}
           onChange={this.onChangeCustomFilters}
         />
+        {
+          this.props.errors.length > 0
+          ? <div data-test-id={'customFiltersErrors'}>
+              <div>{getLocale('customFiltersInvalid')}</div>
+              {
+                this.props.errors.map(error =>
+                  <div key={error.rule} title={error.error}>
+                    <code>{error.rule}</code>
+                  </div>
+                )
+              }
+            </div>
+          : null
+        }
       </div>
     )
   }
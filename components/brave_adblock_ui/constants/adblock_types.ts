@@ -6,6 +6,7 @@ export const enum types {
   ADBLOCK_ENABLE_FILTER_LIST = '@@adblock/ADBLOCK_ENABLE_FILTER_LIST',
   ADBLOCK_GET_CUSTOM_FILTERS = '@@adblock/ADBLOCK_GET_CUSTOM_FILTERS',
   ADBLOCK_GET_REGIONAL_LISTS = '@@adblock/ADBLOCK_GET_REGIONAL_LISTS',
+  ADBLOCK_ON_CUSTOM_FILTERS_SPLICED = '@@adblock/ADBLOCK_ON_CUSTOM_FILTERS_SPLICED',
   ADBLOCK_ON_GET_CUSTOM_FILTERS = '@@adblock/ADBLOCK_ON_GET_CUSTOM_FILTERS',
   ADBLOCK_ON_GET_REGIONAL_LISTS = '@@adblock/ADBLOCK_ON_GET_REGIONAL_LISTS',
   ADBLOCK_STATS_UPDATED = '@@adblock/ADBLOCK_STATS_UPDATED',
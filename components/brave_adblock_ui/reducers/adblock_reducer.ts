@@ -11,10 +11,56 @@ import { types } from '../constants/adblock_types'
 import * as storage from '../storage'
 import { debounce } from '../../common/debounce'
 
+// Custom filters as the browser last had them, edits are sent as the lines
+// that changed since
+let syncedCustomFilters: string | undefined
+
+export const getCustomFiltersSplice = (from: string, to: string) => {
+  const fromLines = from.split('\n')
+  const toLines = to.split('\n')
+  let start = 0
+  while (start < fromLines.length && start < toLines.length &&
+         fromLines[start] === toLines[start]) {
+    start++
+  }
+  let fromEnd = fromLines.length
+  let toEnd = toLines.length
+  while (fromEnd > start && toEnd > start &&
+         fromLines[fromEnd - 1] === toLines[toEnd - 1]) {
+    fromEnd--
+    toEnd--
+  }
+  return {
+    start,
+    removed: fromLines.slice(start, fromEnd),
+    inserted: toLines.slice(start, toEnd)
+  }
+}
+
 const updateCustomFilters = debounce((customFilters: string) => {
-  chrome.send('brave_adblock.updateCustomFilters', [customFilters])
+  if (syncedCustomFilters === undefined) {
+    chrome.send('brave_adblock.updateCustomFilters', [customFilters])
+  } else if (syncedCustomFilters !== customFilters) {
+    const { start, removed, inserted } =
+      getCustomFiltersSplice(syncedCustomFilters, customFilters)
+    chrome.send('brave_adblock.spliceCustomFilters', [start, removed, inserted])
+  }
+  syncedCustomFilters = customFilters
 }, 1500)
 
+const mergeCustomFilterErrors = (customFilters: string, errors: AdBlock.FilterError[], newErrors: AdBlock.FilterError[]) => {
+  // Only the edited lines are checked, so earlier errors are kept for as long
+  // as their rule is still in the list
+  const rules = new Set(customFilters.split('\n'))
+  const merged = (errors || []).filter(error => rules.has(error.rule))
+  newErrors.forEach(error => {
+    if (!merged.some(existing => existing.rule === error.rule)) {
+      merged.push(error)
+    }
+  })
+  return merged
+}
+
 const adblockReducer: Reducer<AdBlock.State | undefined> = (state: AdBlock.State | undefined, action) => {
   if (state === undefined) {
     state = storage.load()
@@ -40,7 +86,24 @@ const adblockReducer: Reducer<AdBlock.State | undefined> = (state: AdBlock.State
     case types.ADBLOCK_GET_REGIONAL_LISTS:
       chrome.send('brave_adblock.getRegionalLists')
       break
+    case types.ADBLOCK_ON_CUSTOM_FILTERS_SPLICED:
+      if (!action.payload.success) {
+        // The list was changed somewhere else, start again from the browser's
+        syncedCustomFilters = undefined
+        chrome.send('brave_adblock.getCustomFilters')
+        break
+      }
+      state = {
+        ...state,
+        settings: {
+          ...state.settings,
+          customFilterErrors: mergeCustomFilterErrors(
+            state.settings.customFilters, state.settings.customFilterErrors, action.payload.errors)
+        }
+      }
+      break
     case types.ADBLOCK_ON_GET_CUSTOM_FILTERS:
+      syncedCustomFilters = action.payload.customFilters
       state = { ...state, settings: { ...state.settings, customFilters: action.payload.customFilters } }
       break
     case types.ADBLOCK_ON_GET_REGIONAL_LISTS:
@@ -9,6 +9,7 @@ const keyName = 'adblock-data'
 export const defaultState: AdBlock.State = {
   settings: {
     customFilters: '',
+    customFilterErrors: [],
     regionalLists: []
   },
   stats: {
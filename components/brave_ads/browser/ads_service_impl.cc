@@ -5,8 +5,11 @@
 
 #include "brave/components/brave_ads/browser/ads_service_impl.h"
 
+#include <algorithm>
 #include <limits>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/files/file_util.h"
@@ -43,6 +46,7 @@
 #include "chrome/browser/ui/browser_navigator_params.h"
 #include "chrome/common/buildflags.h"
 #include "chrome/common/chrome_constants.h"
+#include "components/history/core/browser/history_types.h"
 #include "components/prefs/pref_service.h"
 #include "components/wifi/wifi_service.h"
 #include "content/public/browser/browser_thread.h"
@@ -72,6 +76,23 @@ namespace {
 const char kRewardsNotificationAdsLaunch[] =
     "rewards_notification_ads_launch";
 
+// Ads timers due within the same slot of this size share one wakeup.
+constexpr base::TimeDelta kTimerGranularity = base::TimeDelta::FromSeconds(5);
+
+#if !defined(OS_ANDROID)
+// While idle or locked there is no event for the user coming back, so the
+// idle time is polled at this interval instead.
+constexpr base::TimeDelta kIdlePollInterval = base::TimeDelta::FromSeconds(5);
+#endif
+
+// Events held for the ads library while its utility process restarts, the
+// oldest are dropped past this.
+const size_t kMaximumQueuedEvents = 500;
+
+// Saved state up to this size is kept in memory for a restarted utility, so
+// that it doesn't have to be read back from disk.
+const size_t kMaximumStateSnapshotSize = 1024 * 1024;
+
 }
 static const unsigned int kRetriesCountOnNetworkChange = 1;
 
@@ -293,9 +314,10 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile)
           {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
       base_path_(profile_->GetPath().AppendASCII("ads_service")),
-      next_timer_id_(0),
+      timer_wheel_(kTimerGranularity),
       ads_launch_id_(0),
       is_supported_region_(false),
+      is_restarting_(false),
       bundle_state_backend_(
           new BundleStateDatabase(base_path_.AppendASCII("bundle_state"))),
       display_service_(NotificationDisplayService::GetForProfile(profile_)),
@@ -303,6 +325,7 @@ AdsServiceImpl::AdsServiceImpl(Profile* profile)
           brave_rewards::RewardsServiceFactory::GetForProfile(profile_)),
 #if !defined(OS_ANDROID)
       last_idle_state_(ui::IdleState::IDLE_STATE_ACTIVE),
+      idle_threshold_(0),
       is_foreground_(!!chrome::FindBrowserWithActiveWindow()),
 #endif
       bat_ads_client_binding_(new bat_ads::AdsClientMojoBridge(this)) {
@@ -343,6 +366,36 @@ AdsServiceImpl::~AdsServiceImpl() {
 
 void AdsServiceImpl::OnInitialize() {
   ResetTimer();
+
+  if (is_restarting_) {
+    is_restarting_ = false;
+    SendQueuedEvents();
+  }
+}
+
+void AdsServiceImpl::OnConnectionError() {
+  // Activity is still collected while the utility restarts and reaches the
+  // ads library once it has initialized again.
+  is_restarting_ = true;
+  MaybeStart(true);
+}
+
+void AdsServiceImpl::QueueEvent(base::OnceClosure event) {
+  if (queued_events_.size() == kMaximumQueuedEvents)
+    queued_events_.pop_front();
+  queued_events_.push_back(std::move(event));
+}
+
+void AdsServiceImpl::SendQueuedEvents() {
+  base::circular_deque<base::OnceClosure> events;
+  events.swap(queued_events_);
+  for (auto& event : events)
+    std::move(event).Run();
+}
+
+void AdsServiceImpl::DiscardQueuedEvents() {
+  is_restarting_ = false;
+  queued_events_.clear();
 }
 
 void AdsServiceImpl::OnCreate() {
@@ -358,6 +411,7 @@ void AdsServiceImpl::MaybeStart(bool should_restart) {
 
   if (!StartService()) {
     LOG(ERROR) << "Failed to start Ads service";
+    DiscardQueuedEvents();
     return;
   }
 
@@ -374,6 +428,7 @@ void AdsServiceImpl::OnMaybeStartForRegion(
   if (!is_supported_region_) {
     LOG(WARNING) << GetAdsLocale() << " locale does not support Ads";
 
+    DiscardQueuedEvents();
     Shutdown();
     return;
   }
@@ -389,6 +444,7 @@ void AdsServiceImpl::OnMaybeStartForRegion(
       Start();
     }
   } else {
+    DiscardQueuedEvents();
     Stop();
   }
 }
@@ -407,7 +463,7 @@ bool AdsServiceImpl::StartService() {
       bat_ads::mojom::kServiceName, &bat_ads_service_);
 
   bat_ads_service_.set_connection_error_handler(
-      base::Bind(&AdsServiceImpl::MaybeStart, AsWeakPtr(), true));
+      base::Bind(&AdsServiceImpl::OnConnectionError, AsWeakPtr()));
 
   bool is_production = false;
 #if defined(OFFICIAL_BUILD)
@@ -540,14 +596,9 @@ void AdsServiceImpl::StartFirstLaunchNotificationTimer() {
 
   auto timer_offset = base::TimeDelta::FromSeconds(timer_offset_in_seconds);
 
-  uint32_t timer_id = next_timer_id();
-  ads_launch_id_ = timer_id;
-  timers_[timer_id] = std::make_unique<base::OneShotTimer>();
-  timers_[timer_id]->Start(FROM_HERE,
-      timer_offset,
+  ads_launch_id_ = timer_wheel_.Start(timer_offset,
       base::BindOnce(&AdsServiceImpl::OnFirstLaunchNotificationTimedOut,
-          AsWeakPtr(),
-          timer_id));
+          AsWeakPtr()));
 }
 
 uint64_t AdsServiceImpl::GetFirstLaunchNotificationTimeout() {
@@ -593,7 +644,6 @@ bool AdsServiceImpl::HasFirstLaunchNotificationExpired() {
 }
 
 void AdsServiceImpl::OnFirstLaunchNotificationTimedOut(uint32_t timer_id) {
-  timers_.erase(timer_id);
   RemoveFirstLaunchNotification();
 }
 
@@ -606,16 +656,33 @@ void AdsServiceImpl::Stop() {
 }
 
 void AdsServiceImpl::ResetTimer() {
-  idle_poll_timer_.Stop();
-  idle_poll_timer_.Start(FROM_HERE,
-                         base::TimeDelta::FromSeconds(1),
-                         this,
-                         &AdsServiceImpl::CheckIdleState);
+  idle_timer_.Stop();
+#if !defined(OS_ANDROID)
+  idle_threshold_ = GetIdleThreshold();
+  CheckIdleState();
+#endif
 }
 
 void AdsServiceImpl::CheckIdleState() {
 #if !defined(OS_ANDROID)
-  ProcessIdleState(ui::CalculateIdleState(GetIdleThreshold()));
+  // Same as ui::CalculateIdleState, but keeps the idle time to work out when
+  // the user could next become idle
+  const int idle_time = ui::CalculateIdleTime();
+  ui::IdleState idle_state = ui::IdleState::IDLE_STATE_ACTIVE;
+  if (ui::CheckIdleStateIsLocked())
+    idle_state = ui::IdleState::IDLE_STATE_LOCKED;
+  else if (idle_time >= idle_threshold_)
+    idle_state = ui::IdleState::IDLE_STATE_IDLE;
+  ProcessIdleState(idle_state);
+
+  // An active user can't become idle before the threshold is reached, so
+  // sleep until then rather than checking every second
+  base::TimeDelta delay = kIdlePollInterval;
+  if (idle_state == ui::IdleState::IDLE_STATE_ACTIVE) {
+    delay = base::TimeDelta::FromSeconds(
+        std::max(idle_threshold_ - idle_time, 1));
+  }
+  idle_timer_.Start(FROM_HERE, delay, this, &AdsServiceImpl::CheckIdleState);
 #endif
 }
 
@@ -640,7 +707,8 @@ void AdsServiceImpl::Shutdown() {
     delete loader;
   }
   url_loaders_.clear();
-  idle_poll_timer_.Stop();
+  idle_timer_.Stop();
+  timer_wheel_.StopAll();
 
   bat_ads_.reset();
   bat_ads_client_binding_.Close();
@@ -652,6 +720,7 @@ void AdsServiceImpl::Shutdown() {
                             notification_id);
   }
   notification_ids_.clear();
+  notification_timeout_ids_.clear();
 }
 
 void AdsServiceImpl::MigratePrefs() const {
@@ -832,6 +901,12 @@ bool AdsServiceImpl::IsForeground() const {
 void AdsServiceImpl::TabUpdated(SessionID tab_id,
                                 const GURL& url,
                                 const bool is_active) {
+  if (is_restarting_) {
+    QueueEvent(base::BindOnce(&AdsServiceImpl::TabUpdated, AsWeakPtr(),
+                              tab_id, url, is_active));
+    return;
+  }
+
   if (!connected())
     return;
 
@@ -842,6 +917,12 @@ void AdsServiceImpl::TabUpdated(SessionID tab_id,
 }
 
 void AdsServiceImpl::TabClosed(SessionID tab_id) {
+  if (is_restarting_) {
+    QueueEvent(base::BindOnce(&AdsServiceImpl::TabClosed, AsWeakPtr(),
+                              tab_id));
+    return;
+  }
+
   if (!connected())
     return;
 
@@ -857,6 +938,12 @@ void AdsServiceImpl::SetConfirmationsIsReady(const bool is_ready) {
 
 void AdsServiceImpl::ClassifyPage(const std::string& url,
                                   const std::string& page) {
+  if (is_restarting_) {
+    QueueEvent(base::BindOnce(&AdsServiceImpl::ClassifyPage, AsWeakPtr(),
+                              url, page));
+    return;
+  }
+
   if (!connected())
     return;
 
@@ -893,13 +980,76 @@ void AdsServiceImpl::LoadUserModelForLocale(
 
 void AdsServiceImpl::OnURLsDeleted(history::HistoryService* history_service,
                                    const history::DeletionInfo& deletion_info) {
-  if (!connected())
+  if (!connected() && !is_restarting_)
     return;
 
-  bat_ads_->RemoveAllHistory(base::NullCallback());
+  if (deletion_info.IsAllHistory()) {
+    RemoveAllHistory();
+    return;
+  }
+
+  const history::DeletionTimeRange& time_range = deletion_info.time_range();
+  if (time_range.IsValid()) {
+    const uint64_t from_timestamp_in_seconds = time_range.begin().is_null() ?
+        0 : static_cast<uint64_t>(time_range.begin().ToDoubleT());
+    const uint64_t to_timestamp_in_seconds = time_range.end().is_null() ||
+        time_range.end().is_max() ? std::numeric_limits<uint64_t>::max() :
+        static_cast<uint64_t>(time_range.end().ToDoubleT());
+    RemoveHistoryInRange(from_timestamp_in_seconds, to_timestamp_in_seconds);
+  }
+
+  std::vector<std::string> urls;
+  for (const auto& row : deletion_info.deleted_rows())
+    urls.push_back(row.url().spec());
+  if (!urls.empty())
+    RemoveHistoryForUrls(urls);
+}
+
+void AdsServiceImpl::RemoveAllHistory() {
+  if (is_restarting_) {
+    QueueEvent(base::BindOnce(&AdsServiceImpl::RemoveAllHistory, AsWeakPtr()));
+    return;
+  }
+
+  if (connected())
+    bat_ads_->RemoveAllHistory(base::NullCallback());
+}
+
+void AdsServiceImpl::RemoveHistoryInRange(
+    const uint64_t from_timestamp_in_seconds,
+    const uint64_t to_timestamp_in_seconds) {
+  if (is_restarting_) {
+    QueueEvent(base::BindOnce(&AdsServiceImpl::RemoveHistoryInRange,
+                              AsWeakPtr(), from_timestamp_in_seconds,
+                              to_timestamp_in_seconds));
+    return;
+  }
+
+  if (connected()) {
+    bat_ads_->RemoveHistoryInRange(from_timestamp_in_seconds,
+                                   to_timestamp_in_seconds);
+  }
+}
+
+void AdsServiceImpl::RemoveHistoryForUrls(
+    const std::vector<std::string>& urls) {
+  if (is_restarting_) {
+    QueueEvent(base::BindOnce(&AdsServiceImpl::RemoveHistoryForUrls,
+                              AsWeakPtr(), urls));
+    return;
+  }
+
+  if (connected())
+    bat_ads_->RemoveHistoryForUrls(urls);
 }
 
 void AdsServiceImpl::OnMediaStart(SessionID tab_id) {
+  if (is_restarting_) {
+    QueueEvent(base::BindOnce(&AdsServiceImpl::OnMediaStart, AsWeakPtr(),
+                              tab_id));
+    return;
+  }
+
   if (!connected())
     return;
 
@@ -907,6 +1057,12 @@ void AdsServiceImpl::OnMediaStart(SessionID tab_id) {
 }
 
 void AdsServiceImpl::OnMediaStop(SessionID tab_id) {
+  if (is_restarting_) {
+    QueueEvent(base::BindOnce(&AdsServiceImpl::OnMediaStop, AsWeakPtr(),
+                              tab_id));
+    return;
+  }
+
   if (!connected())
     return;
 
@@ -924,14 +1080,23 @@ void AdsServiceImpl::ShowNotification(
   display_service_->Display(NotificationHandler::Type::BRAVE_ADS, *notification,
                             /*metadata=*/nullptr);
 
-  uint32_t timer_id = next_timer_id();
-
-  timers_[timer_id] = std::make_unique<base::OneShotTimer>();
-  timers_[timer_id]->Start(FROM_HERE,
+  notification_timeout_ids_[notification_id] = timer_wheel_.Start(
       base::TimeDelta::FromSeconds(120),
       base::BindOnce(
           &AdsServiceImpl::NotificationTimedOut, AsWeakPtr(),
-              timer_id, notification_id));
+              notification_id));
+}
+
+void AdsServiceImpl::StopNotificationTimeout(
+    const std::string& notification_id) {
+  auto it = notification_timeout_ids_.find(notification_id);
+  if (it == notification_timeout_ids_.end())
+    return;
+
+  // Notifications closed before they time out would otherwise still wake
+  // the wheel up.
+  timer_wheel_.Stop(it->second);
+  notification_timeout_ids_.erase(it);
 }
 
 void AdsServiceImpl::SetCatalogIssuers(std::unique_ptr<ads::IssuersInfo> info) {
@@ -942,9 +1107,8 @@ void AdsServiceImpl::ConfirmAd(std::unique_ptr<ads::NotificationInfo> info) {
   rewards_service_->ConfirmAd(info->ToJson());
 }
 
-void AdsServiceImpl::NotificationTimedOut(uint32_t timer_id,
-                                          const std::string& notification_id) {
-  timers_.erase(timer_id);
+void AdsServiceImpl::NotificationTimedOut(const std::string& notification_id,
+                                          uint32_t timer_id) {
   if (notification_ids_.find(notification_id) != notification_ids_.end()) {
     display_service_->Close(NotificationHandler::Type::BRAVE_ADS,
                             notification_id);
@@ -955,6 +1119,11 @@ void AdsServiceImpl::NotificationTimedOut(uint32_t timer_id,
 void AdsServiceImpl::Save(const std::string& name,
                           const std::string& value,
                           ads::OnSaveCallback callback) {
+  if (value.size() <= kMaximumStateSnapshotSize)
+    state_snapshot_[name] = value;
+  else
+    state_snapshot_.erase(name);
+
   base::ImportantFileWriter writer(
       base_path_.AppendASCII(name), file_task_runner_);
 
@@ -971,10 +1140,19 @@ void AdsServiceImpl::Save(const std::string& name,
 
 void AdsServiceImpl::Load(const std::string& name,
                           ads::OnLoadCallback callback) {
+  auto it = state_snapshot_.find(name);
+  if (it != state_snapshot_.end()) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+        base::BindOnce(&AdsServiceImpl::OnLoaded, AsWeakPtr(), name,
+                       std::move(callback), it->second));
+    return;
+  }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadOnFileTaskRunner, base_path_.AppendASCII(name)),
       base::BindOnce(&AdsServiceImpl::OnLoaded,
                      AsWeakPtr(),
+                     name,
                      std::move(callback)));
 }
 
@@ -1007,11 +1185,15 @@ void AdsServiceImpl::OnSaveBundleState(const ads::OnSaveCallback& callback,
 }
 
 void AdsServiceImpl::OnLoaded(
+    const std::string& name,
     const ads::OnLoadCallback& callback,
     const std::string& value) {
   if (!connected())
     return;
 
+  if (!value.empty() && value.size() <= kMaximumStateSnapshotSize)
+    state_snapshot_[name] = value;
+
   if (value.empty())
     callback(ads::Result::FAILED, value);
   else
@@ -1027,6 +1209,7 @@ void AdsServiceImpl::OnSaved(
 
 void AdsServiceImpl::Reset(const std::string& name,
                            ads::OnResetCallback callback) {
+  state_snapshot_.erase(name);
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&ResetOnFileTaskRunner, base_path_.AppendASCII(name)),
       base::BindOnce(&AdsServiceImpl::OnReset,
@@ -1099,6 +1282,7 @@ void AdsServiceImpl::OnClose(Profile* profile,
     auto notification_info = base::WrapUnique(
         notification_ids_[notification_id].release());
     notification_ids_.erase(notification_id);
+    StopNotificationTimeout(notification_id);
 
     if (connected()) {
       auto result_type = by_user
@@ -1126,6 +1310,7 @@ void AdsServiceImpl::OpenSettings(Profile* profile,
   auto notification_info = base::WrapUnique(
       notification_ids_[notification_id].release());
   notification_ids_.erase(notification_id);
+  StopNotificationTimeout(notification_id);
 
   if (should_close)
     display_service_->Close(NotificationHandler::Type::BRAVE_ADS,
@@ -1282,38 +1467,19 @@ void AdsServiceImpl::EventLog(const std::string& json) {
   VLOG(0) << "AdsService Event Log: " << json;
 }
 
-uint32_t AdsServiceImpl::next_timer_id() {
-  if (next_timer_id_ == std::numeric_limits<uint32_t>::max())
-    next_timer_id_ = 1;
-  else
-    ++next_timer_id_;
-  return next_timer_id_;
-}
-
 uint32_t AdsServiceImpl::SetTimer(const uint64_t time_offset) {
-  uint32_t timer_id = next_timer_id();
-
-  timers_[timer_id] = std::make_unique<base::OneShotTimer>();
-  timers_[timer_id]->Start(FROM_HERE,
-      base::TimeDelta::FromSeconds(time_offset),
-      base::BindOnce(&AdsServiceImpl::OnTimer, AsWeakPtr(), timer_id));
-
-  return timer_id;
+  return timer_wheel_.Start(base::TimeDelta::FromSeconds(time_offset),
+      base::BindOnce(&AdsServiceImpl::OnTimer, AsWeakPtr()));
 }
 
 void AdsServiceImpl::KillTimer(uint32_t timer_id) {
-  if (timers_.find(timer_id) == timers_.end())
-    return;
-
-  timers_[timer_id]->Stop();
-  timers_.erase(timer_id);
+  timer_wheel_.Stop(timer_id);
 }
 
 void AdsServiceImpl::OnTimer(uint32_t timer_id) {
   if (!connected())
     return;
 
-  timers_.erase(timer_id);
   bat_ads_->OnTimer(timer_id);
 }
 
@@ -12,8 +12,10 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/circular_deque.h"
 #include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
+#include "base/gtest_prod_util.h"
 #include "base/memory/weak_ptr.h"
 #include "base/timer/timer.h"
 #include "bat/ads/ads_client.h"
@@ -21,6 +23,7 @@
 #include "brave/components/brave_ads/browser/background_helper.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service_observer.h"
+#include "brave/components/brave_rewards/browser/timer_wheel.h"
 #include "chrome/browser/notifications/notification_handler.h"
 #include "components/history/core/browser/history_service_observer.h"
 #include "components/prefs/pref_change_registrar.h"
@@ -89,6 +92,8 @@ class AdsServiceImpl : public AdsService,
 
  private:
   friend class AdsNotificationHandler;
+  FRIEND_TEST_ALL_PREFIXES(AdsServiceTest, QueuedEventsAreCapped);
+  FRIEND_TEST_ALL_PREFIXES(AdsServiceTest, StateSnapshotIsKeptUntilReset);
 
   typedef std::map<std::string, std::unique_ptr<const ads::NotificationInfo>>
       NotificationInfoMap;
@@ -182,6 +187,7 @@ class AdsServiceImpl : public AdsService,
 
   void OnSaveBundleState(const ads::OnSaveCallback& callback, bool success);
   void OnLoaded(
+      const std::string& name,
       const ads::OnLoadCallback& callback,
       const std::string& value);
   void OnSaved(const ads::OnSaveCallback& callback, bool success);
@@ -197,13 +203,23 @@ class AdsServiceImpl : public AdsService,
   void OnPrefsChanged(const std::string& pref);
   void OnCreate();
   void OnInitialize();
+  void OnConnectionError();
+  // Holds |event| until the restarted ads library has initialized.
+  void QueueEvent(base::OnceClosure event);
+  void SendQueuedEvents();
+  void DiscardQueuedEvents();
+  void RemoveAllHistory();
+  void RemoveHistoryInRange(const uint64_t from_timestamp_in_seconds,
+                            const uint64_t to_timestamp_in_seconds);
+  void RemoveHistoryForUrls(const std::vector<std::string>& urls);
   void MaybeStart(bool should_restart);
   void OnMaybeStartForRegion(
       bool should_restart,
       bool is_supported_region);
   void NotificationTimedOut(
-      uint32_t timer_id,
-      const std::string& notification_id);
+      const std::string& notification_id,
+      uint32_t timer_id);
+  void StopNotificationTimeout(const std::string& notification_id);
   void MaybeShowFirstLaunchNotification();
   bool ShouldShowFirstLaunchNotification();
   void RemoveFirstLaunchNotification();
@@ -215,28 +231,35 @@ class AdsServiceImpl : public AdsService,
   bool HasFirstLaunchNotificationExpired();
   void OnFirstLaunchNotificationTimedOut(uint32_t timer_id);
 
-  uint32_t next_timer_id();
-
   // are we still connected to the ads lib
   bool connected();
 
   Profile* profile_;  // NOT OWNED
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   const base::FilePath base_path_;
-  std::map<uint32_t, std::unique_ptr<base::OneShotTimer>> timers_;
-  uint32_t next_timer_id_;
+  brave_rewards::TimerWheel timer_wheel_;
   uint32_t ads_launch_id_;
   bool is_supported_region_;
+  // Set from a lost connection to the utility until the ads library it is
+  // restarted with has initialized.
+  bool is_restarting_;
+  base::circular_deque<base::OnceClosure> queued_events_;
+  // Last value loaded or saved for each name, handed straight back to a
+  // restarted utility.
+  std::map<std::string, std::string> state_snapshot_;
   std::unique_ptr<BundleStateDatabase> bundle_state_backend_;
   NotificationDisplayService* display_service_;  // NOT OWNED
   brave_rewards::RewardsService* rewards_service_;  // NOT OWNED
 
 #if !defined(OS_ANDROID)
   ui::IdleState last_idle_state_;
+  // Cached from prefs::kBraveAdsIdleThreshold, in seconds.
+  int idle_threshold_;
   bool is_foreground_;
 #endif
 
-  base::RepeatingTimer idle_poll_timer_;
+  // Rescheduled after every idle check for when the state could next change.
+  base::OneShotTimer idle_timer_;
 
   PrefChangeRegistrar profile_pref_change_registrar_;
 
@@ -245,6 +268,8 @@ class AdsServiceImpl : public AdsService,
   bat_ads::mojom::BatAdsServicePtr bat_ads_service_;
 
   NotificationInfoMap notification_ids_;
+  // Timer wheel ids of the timeouts of |notification_ids_|.
+  std::map<std::string, uint32_t> notification_timeout_ids_;
   base::flat_set<network::SimpleURLLoader*> url_loaders_;
 
   DISALLOW_COPY_AND_ASSIGN(AdsServiceImpl);
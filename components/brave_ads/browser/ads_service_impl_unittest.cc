@@ -4,11 +4,14 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <map>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/files/scoped_temp_dir.h"
 #include "extensions/browser/test_event_router.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
+#include "brave/components/brave_ads/browser/ads_service_impl.h"
 #include "brave/components/brave_rewards/browser/rewards_service_factory.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/brave_ads/browser/test_util.h"
@@ -128,6 +131,7 @@ class MockRewardsService : public RewardsService {
       void(const brave_rewards::GetPendingContributionsTotalCallback&));
   MOCK_CONST_METHOD1(GetRewardsMainEnabled,
       void(const brave_rewards::GetRewardsMainEnabledCallback&));
+  MOCK_METHOD0(WakeLedger, void());
   MOCK_METHOD1(SetCatalogIssuers, void(const std::string&));
   MOCK_METHOD1(ConfirmAd, void(const std::string&));
   MOCK_METHOD1(GetRewardsInternalsInfo,
@@ -192,6 +196,9 @@ class AdsServiceTest : public testing::Test {
   Profile* profile() { return profile_.get(); }
   AdsService* ads_service() { return ads_service_; }
   MockRewardsService* rewards_service() { return rewards_service_; }
+  brave_ads::AdsServiceImpl* ads_service_impl() {
+    return static_cast<brave_ads::AdsServiceImpl*>(ads_service_);
+  }
 
  private:
   content::TestBrowserThreadBundle thread_bundle_;
@@ -199,3 +206,39 @@ class AdsServiceTest : public testing::Test {
   base::ScopedTempDir temp_dir_;
   MockRewardsService* rewards_service_;
 };
+
+namespace brave_ads {
+
+TEST_F(AdsServiceTest, QueuedEventsAreCapped) {
+  std::vector<int> sent;
+  for (int i = 0; i < 501; i++) {
+    ads_service_impl()->QueueEvent(base::BindOnce(
+        [](std::vector<int>* sent, int i) { sent->push_back(i); }, &sent, i));
+  }
+
+  ads_service_impl()->SendQueuedEvents();
+
+  // The oldest event is dropped, the rest are sent in order
+  ASSERT_EQ(sent.size(), 500u);
+  EXPECT_EQ(sent.front(), 1);
+  EXPECT_EQ(sent.back(), 500);
+  EXPECT_TRUE(ads_service_impl()->queued_events_.empty());
+}
+
+TEST_F(AdsServiceTest, StateSnapshotIsKeptUntilReset) {
+  ads_service_impl()->Save("client.json", "{\"client\":1}",
+                           [](ads::Result result) {});
+  ads_service_impl()->Save("large.json", std::string(2 * 1024 * 1024, 'a'),
+                           [](ads::Result result) {});
+
+  auto& snapshot = ads_service_impl()->state_snapshot_;
+  ASSERT_EQ(snapshot.count("client.json"), 1u);
+  EXPECT_EQ(snapshot["client.json"], "{\"client\":1}");
+  // Too large to keep in memory, read back from disk instead
+  EXPECT_EQ(snapshot.count("large.json"), 0u);
+
+  ads_service_impl()->Reset("client.json", [](ads::Result result) {});
+  EXPECT_EQ(snapshot.count("client.json"), 0u);
+}
+
+}  // namespace brave_ads
@@ -6,17 +6,19 @@
 #include "brave/components/brave_ads/browser/ads_tab_helper.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
+#include "base/bind.h"
+#include "base/no_destructor.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/values.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
-#include "chrome/browser/dom_distiller/dom_distiller_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/sessions/session_tab_helper.h"
-#include "components/dom_distiller/content/browser/distiller_page_web_contents.h"
-#include "components/dom_distiller/content/browser/web_contents_main_frame_observer.h"
-#include "components/dom_distiller/core/distiller_page.h"
-#include "components/dom_distiller/core/dom_distiller_service.h"
+#include "chrome/common/chrome_isolated_world_ids.h"
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
@@ -25,18 +27,94 @@
 #if !defined(OS_ANDROID)
 #include "chrome/browser/ui/browser.h"
 #include "chrome/browser/ui/browser_list.h"
+#include "chrome/browser/ui/browser_list_observer.h"
 #include "chrome/browser/ui/tabs/tab_strip_model.h"
 #endif
 
 namespace brave_ads {
 
+namespace {
+
+// Only the start of a page is needed to classify it.
+const int kMaximumPageTextLength = 64 * 1024;
+
+// Collects the page's text nodes, skipping scripts and styles, until
+// |kMaximumPageTextLength| characters have been read. Reading text nodes
+// doesn't need layout, unlike innerText.
+const char kExtractPageTextScript[] = R"(
+  (function(maxLength) {
+    if (!document.body) {
+      return '';
+    }
+    const skip = /^(SCRIPT|STYLE|NOSCRIPT|TEMPLATE)$/;
+    const walker = document.createTreeWalker(document.body,
+        NodeFilter.SHOW_TEXT, {
+          acceptNode: (node) => skip.test(node.parentNode.nodeName)
+              ? NodeFilter.FILTER_REJECT : NodeFilter.FILTER_ACCEPT
+        });
+    let text = '';
+    while (text.length < maxLength && walker.nextNode()) {
+      text += walker.currentNode.nodeValue + ' ';
+    }
+    return text.substring(0, maxLength);
+  })(%d)
+)";
+
+// TODO(bridiver) - what is the android equivalent of this?
+#if !defined(OS_ANDROID)
+// Tells the tabs of a window when it gains or loses focus.
+class BrowserActivationObserver : public BrowserListObserver {
+ public:
+  static void EnsureStarted() {
+    static base::NoDestructor<BrowserActivationObserver> observer;
+  }
+
+ private:
+  friend class base::NoDestructor<BrowserActivationObserver>;
+
+  BrowserActivationObserver() {
+    BrowserList::AddObserver(this);
+  }
+
+  ~BrowserActivationObserver() override {
+    BrowserList::RemoveObserver(this);
+  }
+
+  // BrowserListObserver overrides
+  void OnBrowserSetLastActive(Browser* browser) override {
+    SetBrowserActive(browser, true);
+  }
+
+  void OnBrowserNoLongerActive(Browser* browser) override {
+    SetBrowserActive(browser, false);
+  }
+
+  void SetBrowserActive(Browser* browser, bool is_browser_active) {
+    if (!browser)
+      return;
+
+    TabStripModel* tab_strip_model = browser->tab_strip_model();
+    for (int i = 0; i < tab_strip_model->count(); i++) {
+      AdsTabHelper* tab_helper =
+          AdsTabHelper::FromWebContents(tab_strip_model->GetWebContentsAt(i));
+      if (tab_helper)
+        tab_helper->SetBrowserActive(is_browser_active);
+    }
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(BrowserActivationObserver);
+};
+#endif
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(SessionTabHelper::IdForTab(web_contents)),
       ads_service_(nullptr),
       is_active_(false),
       is_browser_active_(true),
-      run_distiller_(false),
+      run_classifier_(false),
       weak_factory_(this) {
   if (!tab_id_.is_valid())
     return;
@@ -46,16 +124,24 @@ AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
   ads_service_ = AdsServiceFactory::GetForProfile(profile);
 
 #if !defined(OS_ANDROID)
-  BrowserList::AddObserver(this);
-  OnBrowserSetLastActive(BrowserList::GetInstance()->GetLastActive());
+  BrowserActivationObserver::EnsureStarted();
 #endif
   OnVisibilityChanged(web_contents->GetVisibility());
 }
 
 AdsTabHelper::~AdsTabHelper() {
-#if !defined(OS_ANDROID)
-  BrowserList::RemoveObserver(this);
-#endif
+}
+
+void AdsTabHelper::SetBrowserActive(bool is_browser_active) {
+  bool old_active = IsEffectivelyActive();
+  is_browser_active_ = is_browser_active;
+
+  if (old_active != IsEffectivelyActive())
+    TabUpdated();
+}
+
+bool AdsTabHelper::IsEffectivelyActive() const {
+  return is_active_ && is_browser_active_;
 }
 
 void AdsTabHelper::DidFinishNavigation(
@@ -64,67 +150,37 @@ void AdsTabHelper::DidFinishNavigation(
       navigation_handle->GetResponseHeaders()) {
     if (navigation_handle->GetResponseHeaders()->HasHeaderValue(
             "cache-control", "no-store")) {
-      run_distiller_ = false;
+      run_classifier_ = false;
     } else {
       bool was_restored =
           navigation_handle->GetRestoreType() != content::RestoreType::NONE;
-      run_distiller_ = !was_restored;
+      run_classifier_ = !was_restored;
     }
   }
 }
 
 void AdsTabHelper::DocumentOnLoadCompletedInMainFrame() {
-  // don't start distilling is the ad service isn't enabled
-  if (!ads_service_ || !ads_service_->IsAdsEnabled() || !run_distiller_)
-    return;
-
-  auto* dom_distiller_service =
-      dom_distiller::DomDistillerServiceFactory::GetForBrowserContext(
-          web_contents()->GetBrowserContext());
-
-  if (!dom_distiller_service)
+  // don't classify the page if the ad service isn't enabled
+  if (!ads_service_ || !ads_service_->IsAdsEnabled() || !run_classifier_)
     return;
 
-  auto source_page_handle =
-      std::make_unique<dom_distiller::SourcePageHandleWebContents>(
-          web_contents(), false);
-
-  auto distiller_page =
-      dom_distiller_service->CreateDefaultDistillerPageWithHandle(
-          std::move(source_page_handle));
-
-  auto options = dom_distiller::proto::DomDistillerOptions();
-  // options.set_extract_text_only(true);
-  // options.set_debug_level(1);
-
-  auto* distiller_page_ptr = distiller_page.get();
-
-  distiller_page_ptr->DistillPage(
-      web_contents()->GetLastCommittedURL(),
-      options,
-      base::Bind(&AdsTabHelper::OnWebContentsDistillationDone,
+  const std::string script =
+      base::StringPrintf(kExtractPageTextScript, kMaximumPageTextLength);
+  web_contents()->GetMainFrame()->ExecuteJavaScriptInIsolatedWorld(
+      base::UTF8ToUTF16(script),
+      base::BindOnce(&AdsTabHelper::OnPageTextExtracted,
           weak_factory_.GetWeakPtr(),
-          web_contents()->GetLastCommittedURL(),
-          base::Passed(std::move(distiller_page))));
+          web_contents()->GetLastCommittedURL()),
+      ISOLATED_WORLD_ID_CHROME_INTERNAL);
 }
 
-void AdsTabHelper::OnWebContentsDistillationDone(
+void AdsTabHelper::OnPageTextExtracted(
     const GURL& url,
-    std::unique_ptr<dom_distiller::DistillerPage> distiller_page,
-    std::unique_ptr<dom_distiller::proto::DomDistillerResult> distiller_result,
-    bool distillation_successful) {
-  if (!ads_service_ )
+    base::Value value) {
+  if (!ads_service_ || !value.is_string())
     return;
 
-  if (distillation_successful &&
-      distiller_result->has_distilled_content() &&
-      distiller_result->has_markup_info() &&
-      distiller_result->distilled_content().has_html()) {
-    ads_service_->ClassifyPage(url.spec(),
-                               distiller_result->distilled_content().html());
-  } else {
-    // TODO(bridiver) - fall back to web_contents()->GenerateMHTML or ignore?
-  }
+  ads_service_->ClassifyPage(url.spec(), value.GetString());
 }
 
 void AdsTabHelper::DidFinishLoad(
@@ -147,13 +203,16 @@ void AdsTabHelper::TabUpdated() {
   ads_service_->TabUpdated(
       tab_id_,
       web_contents()->GetURL(),
-      is_active_ && is_browser_active_);
+      IsEffectivelyActive());
 }
 
 void AdsTabHelper::MediaStartedPlaying(
     const MediaPlayerInfo& video_type,
     const content::MediaPlayerId& id) {
-  if (ads_service_)
+  bool was_playing = !playing_media_.empty();
+  playing_media_.insert(id);
+
+  if (ads_service_ && !was_playing)
     ads_service_->OnMediaStart(tab_id_);
 }
 
@@ -161,12 +220,15 @@ void AdsTabHelper::MediaStoppedPlaying(
     const MediaPlayerInfo& video_type,
     const content::MediaPlayerId& id,
     WebContentsObserver::MediaStoppedReason reason) {
+  if (playing_media_.erase(id) == 0 || !playing_media_.empty())
+    return;
+
   if (ads_service_)
     ads_service_->OnMediaStop(tab_id_);
 }
 
 void AdsTabHelper::OnVisibilityChanged(content::Visibility visibility) {
-  bool old_active = is_active_;
+  bool old_active = IsEffectivelyActive();
   if (visibility == content::Visibility::HIDDEN) {
     is_active_ = false;
   } else if (visibility == content::Visibility::OCCLUDED) {
@@ -175,7 +237,7 @@ void AdsTabHelper::OnVisibilityChanged(content::Visibility visibility) {
     is_active_ = true;
   }
 
-  if (old_active != is_active_)
+  if (old_active != IsEffectivelyActive())
     TabUpdated();
 }
 
@@ -186,34 +248,6 @@ void AdsTabHelper::WebContentsDestroyed() {
   }
 }
 
-// TODO(bridiver) - what is the android equivalent of this?
-#if !defined(OS_ANDROID)
-void AdsTabHelper::OnBrowserSetLastActive(Browser* browser) {
-  if (!browser)
-    return;
-
-  bool old_active = is_browser_active_;
-  if (browser->tab_strip_model()->GetIndexOfWebContents(web_contents()) !=
-      TabStripModel::kNoTab) {
-    is_browser_active_ = true;
-  }
-
-  if (old_active != is_browser_active_)
-    TabUpdated();
-}
-
-void AdsTabHelper::OnBrowserNoLongerActive(Browser* browser) {
-  bool old_active = is_browser_active_;
-  if (browser->tab_strip_model()->GetIndexOfWebContents(web_contents()) !=
-      TabStripModel::kNoTab) {
-    is_browser_active_ = false;
-  }
-
-  if (old_active != is_browser_active_)
-    TabUpdated();
-}
-#endif
-
 WEB_CONTENTS_USER_DATA_KEY_IMPL(AdsTabHelper)
 
 }  // namespace brave_ads
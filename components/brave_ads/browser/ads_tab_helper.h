@@ -7,45 +7,40 @@
 #define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_ADS_TAB_HELPER_H_
 
 #include <memory>
+#include <set>
 #include <string>
 
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "build/build_config.h"
-#include "chrome/browser/ui/browser_list_observer.h"
 #include "components/sessions/core/session_id.h"
 #include "content/public/browser/media_player_id.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
-class Browser;
-
-namespace dom_distiller {
-
-class DistillerPage;
-
-namespace proto {
-class DomDistillerResult;
-}  // namespace proto
-
-}  // namespace dom_distiller
+namespace base {
+class Value;
+}  // namespace base
 
 namespace brave_ads {
 
 class AdsService;
 
 class AdsTabHelper : public content::WebContentsObserver,
-#if !defined(OS_ANDROID)
-                     public BrowserListObserver,
-#endif
                      public content::WebContentsUserData<AdsTabHelper> {
  public:
   AdsTabHelper(content::WebContents*);
   ~AdsTabHelper() override;
 
+  // Called for the tabs of a window when it gains or loses focus. A single
+  // observer of the browser list calls this for the tabs of that window only,
+  // rather than every tab observing every window.
+  void SetBrowserActive(bool is_browser_active);
+
  private:
   friend class content::WebContentsUserData<AdsTabHelper>;
 
+  bool IsEffectivelyActive() const;
   void TabUpdated();
 
   // content::WebContentsObserver overrides.
@@ -64,23 +59,15 @@ class AdsTabHelper : public content::WebContentsObserver,
   void OnVisibilityChanged(content::Visibility visibility) override;
   void WebContentsDestroyed() override;
 
-#if !defined(OS_ANDROID)
-  // BrowserListObserver overrides
-  void OnBrowserSetLastActive(Browser* browser) override;
-  void OnBrowserNoLongerActive(Browser* browser) override;
-#endif
-
-  void OnWebContentsDistillationDone(
-      const GURL& url,
-      std::unique_ptr<dom_distiller::DistillerPage>,
-      std::unique_ptr<dom_distiller::proto::DomDistillerResult> result,
-      bool distillation_successful);
+  void OnPageTextExtracted(const GURL& url, base::Value value);
 
   SessionID tab_id_;
   AdsService* ads_service_;  // NOT OWNED
   bool is_active_;
   bool is_browser_active_;
-  bool run_distiller_;
+  bool run_classifier_;
+  // Only the first player to start and the last to stop are reported.
+  std::set<content::MediaPlayerId> playing_media_;
 
   base::WeakPtrFactory<AdsTabHelper> weak_factory_;
 
@@ -5,14 +5,18 @@
 
 #include "brave/components/brave_ads/browser/bundle_state_database.h"
 
+#include <inttypes.h>
 #include <stdint.h>
 
-#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "sql/meta_table.h"
 #include "sql/statement.h"
@@ -25,11 +29,18 @@ namespace {
 const int kCurrentVersionNumber = 2;
 const int kCompatibleVersionNumber = 2;
 
+const char kCatalogIdKey[] = "catalog_id";
+const char kCatalogVersionKey[] = "catalog_version";
+
+// Comfortably more than a full catalog.
+const int64_t kDefaultMmapSize = 16 * 1024 * 1024;
+
 }  // namespace
 
 BundleStateDatabase::BundleStateDatabase(const base::FilePath& db_path) :
     db_path_(db_path),
-    initialized_(false) {
+    initialized_(false),
+    mmap_size_(kDefaultMmapSize) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -45,6 +56,9 @@ bool BundleStateDatabase::Init() {
   if (!db_.Open(db_path_))
     return false;
 
+  if (!ConfigureDatabase())
+    return false;
+
   // TODO(brave): add error delegate
   sql::Transaction committer(&db_);
   if (!committer.Begin())
@@ -90,21 +104,6 @@ bool BundleStateDatabase::CreateCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCategoryTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM category"));
-  return sql.Run();
-}
-
-
 bool BundleStateDatabase::CreateAdInfoTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -134,20 +133,6 @@ bool BundleStateDatabase::CreateAdInfoTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM ad_info"));
-  return sql.Run();
-}
-
 bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -174,20 +159,6 @@ bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoCategoryTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
-      "DELETE FROM ad_info_category"));
-  return sql.Run();
-}
-
 bool BundleStateDatabase::CreateAdInfoCategoryNameIndex() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -206,97 +177,249 @@ bool BundleStateDatabase::SaveBundleState(
   if (!initialized)
     return false;
 
-  if (!GetDB().BeginTransaction())
-    return false;
+  if (IsCatalogApplied(bundle_state))
+    return true;
 
-  // we are completely replacing here so first truncate all the tables
-  if (!TruncateAdInfoCategoryTable() ||
-      !TruncateAdInfoTable() ||
-      !TruncateCategoryTable()) {
-    GetDB().RollbackTransaction();
+  if (!GetDB().BeginTransaction())
     return false;
-  }
 
-  auto categories = bundle_state.categories;
-  for (std::map<std::string, std::vector<ads::AdInfo>>::iterator it =
-      categories.begin();  it != categories.end(); ++it) {
-    auto category = it->first;
-    if (!InsertOrUpdateCategory(category)) {
+  // Only rows that are new or have changed are written, and rows that are no
+  // longer in the catalog are deleted afterwards, so ads stay servable while
+  // the new catalog is applied
+  std::set<std::string> category_names;
+  RowKeys ad_info_keys;
+  RowKeys ad_info_category_keys;
+  for (const auto& category : bundle_state.categories) {
+    if (!InsertCategory(category.first)) {
       GetDB().RollbackTransaction();
       return false;
     }
+    category_names.insert(category.first);
 
-    auto ads = it->second;
-    for (std::vector<ads::AdInfo>::iterator ad_it = ads.begin();
-        ad_it != ads.end(); ++ad_it) {
-      auto ad_info = *ad_it;
+    for (const auto& ad_info : category.second) {
       if (!InsertOrUpdateAdInfo(ad_info) ||
-          !InsertOrUpdateAdInfoCategory(ad_info, category)) {
+          !InsertAdInfoCategory(ad_info, category.first)) {
         GetDB().RollbackTransaction();
         return false;
       }
+
+      for (const auto& region : ad_info.regions) {
+        ad_info_keys.insert({region, ad_info.uuid});
+      }
+      ad_info_category_keys.insert({ad_info.uuid, category.first});
     }
   }
 
-  if (GetDB().CommitTransaction()) {
-    Vacuum();
-    return true;
+  size_t deleted_count = 0;
+  if (!DeleteStaleAdInfoCategories(ad_info_category_keys, &deleted_count) ||
+      !DeleteStaleAdInfo(ad_info_keys, &deleted_count) ||
+      !DeleteStaleCategories(category_names, &deleted_count) ||
+      !SetCatalogApplied(bundle_state)) {
+    GetDB().RollbackTransaction();
+    return false;
   }
 
-  return false;
+  if (!GetDB().CommitTransaction())
+    return false;
+
+  // Catalogs are applied rarely and all at once, so the log is folded back
+  // right away instead of on a timer
+  Checkpoint();
+
+  if (deleted_count > 0)
+    Vacuum();
+
+  return true;
 }
 
-bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
+bool BundleStateDatabase::IsCatalogApplied(
+    const ads::BundleState& bundle_state) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
+  // An empty catalog id is used to clear the bundle, which is always applied
+  if (bundle_state.catalog_id.empty())
+    return false;
 
-  if (!initialized)
+  std::string catalog_id;
+  int64_t catalog_version;
+  if (!GetMetaTable().GetValue(kCatalogIdKey, &catalog_id) ||
+      !GetMetaTable().GetValue(kCatalogVersionKey, &catalog_version))
     return false;
 
-  sql::Statement ad_info_statement(
+  return catalog_id == bundle_state.catalog_id &&
+      static_cast<uint64_t>(catalog_version) == bundle_state.catalog_version;
+}
+
+bool BundleStateDatabase::SetCatalogApplied(
+    const ads::BundleState& bundle_state) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return GetMetaTable().SetValue(kCatalogIdKey, bundle_state.catalog_id) &&
+      GetMetaTable().SetValue(kCatalogVersionKey,
+          static_cast<int64_t>(bundle_state.catalog_version));
+}
+
+bool BundleStateDatabase::DeleteStaleCategories(
+    const std::set<std::string>& names,
+    size_t* deleted_count) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(deleted_count);
+
+  std::vector<std::string> stale_names;
+  sql::Statement select_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT name FROM category"));
+  while (select_statement.Step()) {
+    std::string name = select_statement.ColumnString(0);
+    if (names.find(name) == names.end())
+      stale_names.push_back(name);
+  }
+
+  for (const auto& name : stale_names) {
+    sql::Statement delete_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+        "DELETE FROM category WHERE name = ?"));
+    delete_statement.BindString(0, name);
+    if (!delete_statement.Run())
+      return false;
+  }
+
+  *deleted_count += stale_names.size();
+  return true;
+}
+
+bool BundleStateDatabase::DeleteStaleAdInfo(
+    const RowKeys& keys,
+    size_t* deleted_count) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(deleted_count);
+
+  std::vector<std::pair<std::string, std::string>> stale_keys;
+  sql::Statement select_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT region, uuid FROM ad_info"));
+  while (select_statement.Step()) {
+    auto key = std::make_pair(select_statement.ColumnString(0),
+        select_statement.ColumnString(1));
+    if (keys.find(key) == keys.end())
+      stale_keys.push_back(key);
+  }
+
+  for (const auto& key : stale_keys) {
+    sql::Statement delete_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+        "DELETE FROM ad_info WHERE region = ? AND uuid = ?"));
+    delete_statement.BindString(0, key.first);
+    delete_statement.BindString(1, key.second);
+    if (!delete_statement.Run())
+      return false;
+  }
+
+  *deleted_count += stale_keys.size();
+  return true;
+}
+
+bool BundleStateDatabase::DeleteStaleAdInfoCategories(
+    const RowKeys& keys,
+    size_t* deleted_count) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(deleted_count);
+
+  std::vector<std::pair<std::string, std::string>> stale_keys;
+  sql::Statement select_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT ad_info_uuid, category_name FROM ad_info_category"));
+  while (select_statement.Step()) {
+    auto key = std::make_pair(select_statement.ColumnString(0),
+        select_statement.ColumnString(1));
+    if (keys.find(key) == keys.end())
+      stale_keys.push_back(key);
+  }
+
+  for (const auto& key : stale_keys) {
+    sql::Statement delete_statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+        "DELETE FROM ad_info_category "
+        "WHERE ad_info_uuid = ? AND category_name = ?"));
+    delete_statement.BindString(0, key.first);
+    delete_statement.BindString(1, key.second);
+    if (!delete_statement.Run())
+      return false;
+  }
+
+  *deleted_count += stale_keys.size();
+  return true;
+}
+
+bool BundleStateDatabase::InsertCategory(const std::string& category) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement category_statement(
       GetDB().GetCachedStatement(SQL_FROM_HERE,
-          "INSERT OR REPLACE INTO category "
+          "INSERT OR IGNORE INTO category "
           "(name) "
           "VALUES (?)"));
 
-  ad_info_statement.BindString(0, category);
+  category_statement.BindString(0, category);
 
-  return ad_info_statement.Run();
+  return category_statement.Run();
 }
 
 bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
   for (auto it = info.regions.begin(); it != info.regions.end(); ++it) {
-    sql::Statement ad_info_statement(
+    sql::Statement insert_statement(
         GetDB().GetCachedStatement(SQL_FROM_HERE,
-            "INSERT OR REPLACE INTO ad_info "
+            "INSERT OR IGNORE INTO ad_info "
             "(creative_set_id, advertiser, notification_text, "
             "notification_url, start_timestamp, end_timestamp, uuid, "
             "campaign_id, daily_cap, per_day, total_max, region) "
             "VALUES (?, ?, ?, ?, datetime(?), datetime(?), ?, ?, ?, ?, ?, ?)"));
 
-    ad_info_statement.BindString(0, info.creative_set_id);
-    ad_info_statement.BindString(1, info.advertiser);
-    ad_info_statement.BindString(2, info.notification_text);
-    ad_info_statement.BindString(3, info.notification_url);
-    ad_info_statement.BindString(4, info.start_timestamp);
-    ad_info_statement.BindString(5, info.end_timestamp);
-    ad_info_statement.BindString(6, info.uuid);
-    ad_info_statement.BindString(7, info.campaign_id);
-    ad_info_statement.BindInt(8, info.daily_cap);
-    ad_info_statement.BindInt(9, info.per_day);
-    ad_info_statement.BindInt(10, info.total_max);
-    ad_info_statement.BindString(11, *it);
-    if (!ad_info_statement.Run()) {
+    insert_statement.BindString(0, info.creative_set_id);
+    insert_statement.BindString(1, info.advertiser);
+    insert_statement.BindString(2, info.notification_text);
+    insert_statement.BindString(3, info.notification_url);
+    insert_statement.BindString(4, info.start_timestamp);
+    insert_statement.BindString(5, info.end_timestamp);
+    insert_statement.BindString(6, info.uuid);
+    insert_statement.BindString(7, info.campaign_id);
+    insert_statement.BindInt(8, info.daily_cap);
+    insert_statement.BindInt(9, info.per_day);
+    insert_statement.BindInt(10, info.total_max);
+    insert_statement.BindString(11, *it);
+    if (!insert_statement.Run()) {
+      return false;
+    }
+
+    if (GetDB().GetLastChangeCount() > 0) {
+      continue;
+    }
+
+    // The row already exists, so only rewrite it if the catalog changed it
+    sql::Statement update_statement(
+        GetDB().GetCachedStatement(SQL_FROM_HERE,
+            "UPDATE ad_info SET "
+            "creative_set_id = ?1, advertiser = ?2, notification_text = ?3, "
+            "notification_url = ?4, start_timestamp = datetime(?5), "
+            "end_timestamp = datetime(?6), campaign_id = ?7, "
+            "daily_cap = ?8, per_day = ?9, total_max = ?10 "
+            "WHERE region = ?11 AND uuid = ?12 AND ("
+            "creative_set_id IS NOT ?1 OR advertiser IS NOT ?2 OR "
+            "notification_text IS NOT ?3 OR notification_url IS NOT ?4 OR "
+            "start_timestamp IS NOT datetime(?5) OR "
+            "end_timestamp IS NOT datetime(?6) OR campaign_id IS NOT ?7 OR "
+            "daily_cap IS NOT ?8 OR per_day IS NOT ?9 OR "
+            "total_max IS NOT ?10)"));
+
+    update_statement.BindString(0, info.creative_set_id);
+    update_statement.BindString(1, info.advertiser);
+    update_statement.BindString(2, info.notification_text);
+    update_statement.BindString(3, info.notification_url);
+    update_statement.BindString(4, info.start_timestamp);
+    update_statement.BindString(5, info.end_timestamp);
+    update_statement.BindString(6, info.campaign_id);
+    update_statement.BindInt(7, info.daily_cap);
+    update_statement.BindInt(8, info.per_day);
+    update_statement.BindInt(9, info.total_max);
+    update_statement.BindString(10, *it);
+    update_statement.BindString(11, info.uuid);
+    if (!update_statement.Run()) {
       return false;
     }
   }
@@ -304,20 +427,14 @@ bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info) {
   return true;
 }
 
-bool BundleStateDatabase::InsertOrUpdateAdInfoCategory(
+bool BundleStateDatabase::InsertAdInfoCategory(
     const ads::AdInfo& ad_info,
     const std::string& category) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
   sql::Statement ad_info_statement(
       GetDB().GetCachedStatement(SQL_FROM_HERE,
-          "INSERT OR REPLACE INTO ad_info_category "
+          "INSERT OR IGNORE INTO ad_info_category "
           "(ad_info_uuid, category_name) "
           "VALUES (?, ?)"));
 
@@ -389,10 +506,50 @@ void BundleStateDatabase::Vacuum() {
   ignore_result(db_.Execute("VACUUM"));
 }
 
+bool BundleStateDatabase::ConfigureDatabase() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Ads are read from the log while a new catalog is being applied, instead
+  // of waiting for the write to finish
+  if (!db_.Execute("PRAGMA journal_mode=WAL") ||
+      !db_.Execute("PRAGMA synchronous=NORMAL")) {
+    LOG(WARNING) << "Could not enable write-ahead logging";
+  }
+
+  const std::string mmap_sql =
+      base::StringPrintf("PRAGMA mmap_size=%" PRId64, mmap_size_);
+  return db_.Execute(mmap_sql.c_str());
+}
+
+void BundleStateDatabase::Checkpoint() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  ignore_result(db_.Execute("PRAGMA wal_checkpoint(PASSIVE)"));
+  UMA_HISTOGRAM_TIMES("Brave.Ads.DatabaseCheckpointTime",
+                      base::TimeTicks::Now() - start_time);
+}
+
 void BundleStateDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  db_.TrimMemory();
+
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      db_.TrimMemory();
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      // Pages only held for the log are dropped along with the cache
+      Checkpoint();
+      db_.TrimMemory();
+      break;
+  }
+
+  UMA_HISTOGRAM_EXACT_LINEAR(
+      "Brave.Ads.DatabaseMemoryPressure", memory_pressure_level,
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL + 1);
 }
 
 std::string BundleStateDatabase::GetDiagnosticInfo(int extended_error,
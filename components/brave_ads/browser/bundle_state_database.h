@@ -7,9 +7,12 @@
 #define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_BUNDLE_STATE_DATABASE_H_
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string>
 #include <vector>
 #include <memory>
+#include <set>
+#include <utility>
 
 #include "bat/ads/ad_info.h"
 #include "bat/ads/bundle_state.h"
@@ -36,6 +39,10 @@ class BundleStateDatabase {
     db_.set_error_callback(error_callback);
   }
 
+  // Size of the memory map SQLite reads the database through, 0 disables
+  // memory mapped I/O. Must be called before the database is first used.
+  void set_mmap_size(int64_t mmap_size) { mmap_size_ = mmap_size; }
+
   bool SaveBundleState(const ads::BundleState& bundle_state);
   bool GetAdsForCategory(
       const std::string& category,
@@ -52,6 +59,8 @@ class BundleStateDatabase {
 
  private:
   bool Init();
+  bool ConfigureDatabase();
+  void Checkpoint();
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
@@ -60,13 +69,24 @@ class BundleStateDatabase {
   bool CreateAdInfoCategoryTable();
   bool CreateAdInfoCategoryNameIndex();
 
-  bool TruncateCategoryTable();
-  bool TruncateAdInfoTable();
-  bool TruncateAdInfoCategoryTable();
+  // (region, uuid) for ad_info and (ad_info_uuid, category_name) for
+  // ad_info_category
+  using RowKeys = std::set<std::pair<std::string, std::string>>;
+
+  bool IsCatalogApplied(const ads::BundleState& bundle_state);
+  bool SetCatalogApplied(const ads::BundleState& bundle_state);
+
+  bool DeleteStaleCategories(
+      const std::set<std::string>& names,
+      size_t* deleted_count);
+  bool DeleteStaleAdInfo(const RowKeys& keys, size_t* deleted_count);
+  bool DeleteStaleAdInfoCategories(
+      const RowKeys& keys,
+      size_t* deleted_count);
 
-  bool InsertOrUpdateCategory(const std::string& category);
+  bool InsertCategory(const std::string& category);
   bool InsertOrUpdateAdInfo(const ads::AdInfo& info);
-  bool InsertOrUpdateAdInfoCategory(
+  bool InsertAdInfoCategory(
       const ads::AdInfo& ad_info,
       const std::string& category);
 
@@ -80,6 +100,7 @@ class BundleStateDatabase {
   sql::MetaTable meta_table_;
   const base::FilePath db_path_;
   bool initialized_;
+  int64_t mmap_size_;
 
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
@@ -0,0 +1,105 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_ads/browser/bundle_state_database.h"
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BundleStateDatabaseTest.*
+
+namespace brave_ads {
+
+class BundleStateDatabaseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    database_ = std::make_unique<BundleStateDatabase>(
+        temp_dir_.GetPath().AppendASCII("bundle_state"));
+  }
+
+  ads::AdInfo CreateAdInfo(const std::string& uuid,
+                           const std::string& notification_text) {
+    ads::AdInfo info;
+    info.creative_set_id = "creative-set-" + uuid;
+    info.campaign_id = "campaign-" + uuid;
+    info.start_timestamp = "2000-01-01 00:00";
+    info.end_timestamp = "2100-01-01 00:00";
+    info.regions = {"US"};
+    info.advertiser = "Brave";
+    info.notification_text = notification_text;
+    info.notification_url = "https://brave.com";
+    info.uuid = uuid;
+    return info;
+  }
+
+  std::vector<ads::AdInfo> GetAdsForCategory(const std::string& category) {
+    std::vector<ads::AdInfo> ads;
+    EXPECT_TRUE(database_->GetAdsForCategory(category, &ads));
+    return ads;
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<BundleStateDatabase> database_;
+};
+
+TEST_F(BundleStateDatabaseTest, AppliesCatalogChanges) {
+  ads::BundleState bundle_state;
+  bundle_state.catalog_id = "catalog";
+  bundle_state.catalog_version = 1;
+  bundle_state.categories["technology"] = {
+      CreateAdInfo("1", "first"), CreateAdInfo("2", "second")};
+  bundle_state.categories["travel"] = {CreateAdInfo("3", "third")};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+
+  EXPECT_EQ(GetAdsForCategory("technology").size(), 2u);
+  EXPECT_EQ(GetAdsForCategory("travel").size(), 1u);
+
+  bundle_state.catalog_version = 2;
+  bundle_state.categories.erase("travel");
+  bundle_state.categories["technology"] = {CreateAdInfo("1", "updated")};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+
+  auto ads = GetAdsForCategory("technology");
+  ASSERT_EQ(ads.size(), 1u);
+  EXPECT_EQ(ads[0].uuid, "1");
+  EXPECT_EQ(ads[0].notification_text, "updated");
+  EXPECT_TRUE(GetAdsForCategory("travel").empty());
+}
+
+TEST_F(BundleStateDatabaseTest, SkipsAppliedCatalogVersion) {
+  ads::BundleState bundle_state;
+  bundle_state.catalog_id = "catalog";
+  bundle_state.catalog_version = 1;
+  bundle_state.categories["technology"] = {CreateAdInfo("1", "first")};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+
+  bundle_state.categories["technology"] = {CreateAdInfo("2", "second")};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+
+  auto ads = GetAdsForCategory("technology");
+  ASSERT_EQ(ads.size(), 1u);
+  EXPECT_EQ(ads[0].uuid, "1");
+}
+
+TEST_F(BundleStateDatabaseTest, EmptyCatalogClearsBundle) {
+  ads::BundleState bundle_state;
+  bundle_state.catalog_id = "catalog";
+  bundle_state.catalog_version = 1;
+  bundle_state.categories["technology"] = {CreateAdInfo("1", "first")};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+
+  ASSERT_TRUE(database_->SaveBundleState(ads::BundleState()));
+
+  EXPECT_TRUE(GetAdsForCategory("technology").empty());
+}
+
+}  // namespace brave_ads
@@ -5,11 +5,13 @@
 
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 
+#include <memory>
 #include <string>
 
 #include "base/logging.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/sha1.h"
 
 namespace brave_component_updater {
 
@@ -34,13 +36,46 @@ void GetDATFileData(const base::FilePath& file_path,
   }
 }
 
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path) {
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(file_path) || 0 == mapped_file->length()) {
+    LOG(ERROR) << "MapDATFile: cannot "
+               << "map dat file " << file_path;
+    return nullptr;
+  }
+  return mapped_file;
+}
+
+void LogDATFileLoad(const base::FilePath& file_path,
+                    size_t size,
+                    base::TimeTicks start_time) {
+  VLOG(1) << "Loaded dat file " << file_path << " (" << size << " bytes) in "
+          << (base::TimeTicks::Now() - start_time).InMilliseconds() << " ms";
+}
+
+std::string GetDATFileHash(const base::MemoryMappedFile& mapped_file) {
+  std::string hash(base::kSHA1Length, '\0');
+  base::SHA1HashBytes(mapped_file.data(), mapped_file.length(),
+                      reinterpret_cast<unsigned char*>(&hash[0]));
+  return hash;
+}
+
+std::unique_ptr<DATFileDataBuffer> CopyDATFileData(
+    const base::MemoryMappedFile& mapped_file) {
+  return std::make_unique<DATFileDataBuffer>(
+      mapped_file.data(), mapped_file.data() + mapped_file.length());
+}
+
 std::string GetDATFileAsString(const base::FilePath& file_path) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
   std::string contents;
   bool success = base::ReadFileToString(file_path, &contents);
   if (!success || contents.empty()) {
     LOG(ERROR) << "GetDATFileAsString: cannot "
                << "read dat file " << file_path;
   }
+  LogDATFileLoad(file_path, contents.size(), start_time);
   return contents;
 }
 
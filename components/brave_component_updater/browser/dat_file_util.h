@@ -12,6 +12,9 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/time/time.h"
 
 namespace brave_component_updater {
 
@@ -20,6 +23,21 @@ using DATFileDataBuffer = std::vector<unsigned char>;
 void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
 std::string GetDATFileAsString(const base::FilePath& file_path);
+// Maps |file_path| read-only. Returns nullptr if the file is missing, empty
+// or can't be mapped.
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path);
+// Logs the size of |file_path| and the time taken to load it since
+// |start_time|, so slow files stand out when the component becomes ready.
+void LogDATFileLoad(const base::FilePath& file_path,
+                    size_t size,
+                    base::TimeTicks start_time);
+// Hash of the contents of |mapped_file|, used to tell whether a component
+// update actually changed a DAT file.
+std::string GetDATFileHash(const base::MemoryMappedFile& mapped_file);
+// Copies |mapped_file| into a buffer which the DAT deserializers may write to.
+std::unique_ptr<DATFileDataBuffer> CopyDATFileData(
+    const base::MemoryMappedFile& mapped_file);
 
 template<typename T>
 using LoadDATFileDataResult =
@@ -28,6 +46,7 @@ using LoadDATFileDataResult =
 template<typename T>
 LoadDATFileDataResult<T> LoadDATFileData(
     const base::FilePath& dat_file_path) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
   DATFileDataBuffer buffer;
   GetDATFileData(dat_file_path, &buffer);
   std::unique_ptr<T> client;
@@ -35,11 +54,82 @@ LoadDATFileDataResult<T> LoadDATFileData(
   if (buffer.empty() ||
       !client->deserialize(reinterpret_cast<char*>(&buffer.front())))
     client.reset();
+  LogDATFileLoad(dat_file_path, buffer.size(), start_time);
 
   return LoadDATFileDataResult<T>(
       std::move(client), std::move(buffer));
 }
 
+template<typename T>
+using LoadMappedDATFileDataResult =
+    std::pair<std::unique_ptr<T>, std::unique_ptr<DATFileDataBuffer>>;
+
+// Like LoadDATFileData but reads the file through a read-only mapping. The
+// deserializers take a mutable buffer, so the mapping is copied rather than
+// handed to them. The returned buffer must outlive the returned client.
+template<typename T>
+LoadMappedDATFileDataResult<T> LoadMappedDATFileData(
+    const base::FilePath& dat_file_path) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  std::unique_ptr<base::MemoryMappedFile> mapped_file =
+      MapDATFile(dat_file_path);
+  std::unique_ptr<DATFileDataBuffer> buffer;
+  std::unique_ptr<T> client;
+  if (mapped_file) {
+    buffer = CopyDATFileData(*mapped_file);
+    client = std::make_unique<T>();
+    if (!client->deserialize(reinterpret_cast<char*>(buffer->data())))
+      client.reset();
+  }
+  LogDATFileLoad(dat_file_path, buffer ? buffer->size() : 0, start_time);
+
+  return LoadMappedDATFileDataResult<T>(std::move(client), std::move(buffer));
+}
+
+template<typename T>
+struct LoadChangedDATFileDataResult {
+  LoadChangedDATFileDataResult() = default;
+  LoadChangedDATFileDataResult(LoadChangedDATFileDataResult&&) = default;
+  LoadChangedDATFileDataResult& operator=(
+      LoadChangedDATFileDataResult&&) = default;
+
+  // Both null when |unchanged| is set.
+  LoadMappedDATFileDataResult<T> data;
+  // Hash of the file, empty if it could not be mapped.
+  std::string hash;
+  bool unchanged = false;
+};
+
+// Like LoadMappedDATFileData but skips deserializing when the file still has
+// |previous_hash|, which saves parsing and swapping in an identical client
+// when a component update did not touch this file.
+template<typename T>
+LoadChangedDATFileDataResult<T> LoadMappedDATFileDataIfChanged(
+    const base::FilePath& dat_file_path,
+    const std::string& previous_hash) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  LoadChangedDATFileDataResult<T> result;
+  std::unique_ptr<base::MemoryMappedFile> mapped_file =
+      MapDATFile(dat_file_path);
+  if (!mapped_file)
+    return result;
+
+  result.hash = GetDATFileHash(*mapped_file);
+  if (!previous_hash.empty() && result.hash == previous_hash) {
+    VLOG(1) << "Dat file " << dat_file_path << " is unchanged";
+    result.unchanged = true;
+    return result;
+  }
+
+  auto buffer = CopyDATFileData(*mapped_file);
+  auto client = std::make_unique<T>();
+  if (!client->deserialize(reinterpret_cast<char*>(buffer->data())))
+    client.reset();
+  LogDATFileLoad(dat_file_path, buffer->size(), start_time);
+  result.data = LoadMappedDATFileDataResult<T>(
+      std::move(client), std::move(buffer));
+  return result;
+}
 
 }  // namespace brave_component_updater
 
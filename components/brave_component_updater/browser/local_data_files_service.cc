@@ -5,6 +5,9 @@
 
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 
+#include "base/logging.h"
+#include "base/task/post_task.h"
+#include "base/time/time.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 
 using brave_component_updater::BraveComponent;
@@ -19,7 +22,10 @@ g_local_data_files_component_base64_public_key_(
 
 LocalDataFilesService::LocalDataFilesService(BraveComponent::Delegate* delegate)
   : BraveComponent(delegate),
-    initialized_(false) {}
+    initialized_(false),
+    load_task_runner_(base::CreateTaskRunnerWithTraits({base::MayBlock(),
+        base::TaskPriority::USER_VISIBLE,
+        base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
 
 LocalDataFilesService::~LocalDataFilesService() {
   for (auto& observer : observers_)
@@ -40,8 +46,11 @@ void LocalDataFilesService::OnComponentReady(
     const std::string& component_id,
     const base::FilePath& install_dir,
     const std::string& manifest) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
   for (auto& observer : observers_)
     observer.OnComponentReady(component_id, install_dir, manifest);
+  VLOG(1) << "Dispatched local data file loads in "
+          << (base::TimeTicks::Now() - start_time).InMilliseconds() << " ms";
 }
 
 void LocalDataFilesService::AddObserver(LocalDataFilesObserver* observer) {
@@ -52,6 +61,10 @@ void LocalDataFilesService::RemoveObserver(LocalDataFilesObserver* observer) {
   observers_.RemoveObserver(observer);
 }
 
+scoped_refptr<base::TaskRunner> LocalDataFilesService::GetLoadTaskRunner() {
+  return load_task_runner_;
+}
+
 // static
 void LocalDataFilesService::SetComponentIdAndBase64PublicKeyForTest(
     const std::string& component_id,
@@ -10,7 +10,9 @@
 #include <string>
 
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/observer_list.h"
+#include "base/task_runner.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
 
 namespace brave_component_updater {
@@ -38,6 +40,10 @@ class LocalDataFilesService : public BraveComponent {
   bool IsInitialized() const { return initialized_; }
   void AddObserver(LocalDataFilesObserver* observer);
   void RemoveObserver(LocalDataFilesObserver* observer);
+  // Observers load their files from this instead of GetTaskRunner(). Loads
+  // are independent of each other, so they run in parallel and the component
+  // is ready once its largest file has loaded.
+  scoped_refptr<base::TaskRunner> GetLoadTaskRunner();
 
   static void SetComponentIdAndBase64PublicKeyForTest(
       const std::string& component_id,
@@ -53,6 +59,7 @@ class LocalDataFilesService : public BraveComponent {
   static std::string g_local_data_files_component_base64_public_key_;
 
   bool initialized_;
+  scoped_refptr<base::TaskRunner> load_task_runner_;
   base::ObserverList<LocalDataFilesObserver>::Unchecked observers_;
 
   DISALLOW_COPY_AND_ASSIGN(LocalDataFilesService);
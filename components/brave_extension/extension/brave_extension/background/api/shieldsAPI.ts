@@ -75,17 +75,41 @@ const getScope = () =>
 export const getTabData = (tabId: number) =>
   chrome.tabs.getAsync(tabId)
 
+/**
+ * Obtains every shields setting and the blocked counts of a tab in one call
+ * @param {number} tabId the tabId of the tab who's content settings are of interest
+ * @return a promise which resolves with the shields state of the tab
+ */
+export const getShieldsState = (tabId: number) =>
+  new Promise<any>((resolve, reject) => {
+    chrome.braveShields.getShieldsState(tabId, (state) => {
+      if (chrome.runtime.lastError) {
+        reject(new Error(chrome.runtime.lastError.message))
+        return
+      }
+      resolve(state)
+    })
+  })
+
 /**
  * Obtains new information about the shields panel settings for the specified tabId
  * @param {number} tabId the tabId of the tab who's content settings are of interest
  * @return a promise which resolves with the updated shields panel data.
  */
 export const requestShieldPanelData = (tabId: number) =>
-  getTabData(tabId)
-    .then(getShieldSettingsForTabData)
-    .then((details: ShieldDetails) => {
-      actions.shieldsPanelDataUpdated(details)
+  getShieldsState(tabId)
+    .then((state) => {
+      // The panel counts from its own lists of blocked resources.
+      const details = { ...state }
+      delete details.blockedCounts
+      actions.shieldsPanelDataUpdated(details as ShieldDetails)
     })
+    .catch(() =>
+      getTabData(tabId)
+        .then(getShieldSettingsForTabData)
+        .then((details: ShieldDetails) => {
+          actions.shieldsPanelDataUpdated(details)
+        }))
 
 const getPrimaryPatternForOrigin = (origin: string) => {
   // When url includes port w/o scheme, chromium parses it as an invalid port
@@ -3,11 +3,17 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 import actions from '../actions/shieldsPanelActions'
-import { BlockDetails } from '../../types/actions/shieldsPanelActions'
 
 if (chrome.braveShields) {
-  chrome.braveShields.onBlocked.addListener((detail: BlockDetails) => {
-    actions.resourceBlocked(detail)
+  // Each event carries everything blocked in a tab since the previous one
+  chrome.braveShields.onBlocked.addListener((details: BlockedResources) => {
+    for (const resource of details.resources) {
+      actions.resourceBlocked({
+        tabId: details.tabId,
+        blockType: resource.blockType,
+        subresource: resource.subresource
+      })
+    }
   })
 } else {
   console.log('chrome.braveShields not enabled')
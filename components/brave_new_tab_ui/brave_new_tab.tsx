@@ -33,6 +33,10 @@ window.cr.define('brave_new_tab', function () {
       </Provider>,
       document.getElementById('root'))
     window.i18nTemplate.process(window.document, window.loadTimeData)
+    // Reports once the first frame with content has been painted
+    window.requestAnimationFrame(() => {
+      setTimeout(() => chrome.send('newTabPageFirstPaint', []))
+    })
   }
 
   function statsUpdated () {
@@ -92,6 +92,13 @@ void BraveReferralsService::Start() {
   if (initialized_)
     return;
 
+  // Once the referral has nothing left to do, skip the file system
+  // entirely on every later startup.
+  if (pref_service_->GetBoolean(kReferralComplete)) {
+    initialized_ = true;
+    return;
+  }
+
   // Retrieve first run sentinel creation time.
   task_runner_->PostTask(FROM_HERE,
                          base::Bind(&BraveReferralsService::GetFirstRunTime,
@@ -204,6 +211,7 @@ void BraveReferralsService::OnReferralFinalizationCheckLoadComplete(
   pref_service_->SetTime(kReferralTimestamp, base::Time::Now());
   pref_service_->ClearPref(kReferralAttemptTimestamp);
   pref_service_->ClearPref(kReferralAttemptCount);
+  MaybeMarkReferralComplete();
 }
 
 void BraveReferralsService::OnReadPromoCodeComplete() {
@@ -270,7 +278,7 @@ void BraveReferralsService::MaybeCheckForReferralFinalization() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   std::string download_id = pref_service_->GetString(kReferralDownloadID);
-  if (download_id.empty()) {
+  if (download_id.empty() || IsReferralFinalized()) {
     return;
   }
 
@@ -295,6 +303,7 @@ void BraveReferralsService::MaybeCheckForReferralFinalization() {
     pref_service_->ClearPref(kReferralAttemptTimestamp);
     pref_service_->ClearPref(kReferralAttemptCount);
     pref_service_->ClearPref(kReferralDownloadID);
+    MaybeMarkReferralComplete();
     return;
   }
 
@@ -320,6 +329,29 @@ void BraveReferralsService::MaybeDeletePromoCodePref() const {
   base::Time now = base::Time::Now();
   if (now - first_run_timestamp_ >= base::TimeDelta::FromSeconds(delete_time))
     pref_service_->ClearPref(kReferralPromoCode);
+
+  MaybeMarkReferralComplete();
+}
+
+bool BraveReferralsService::IsReferralFinalized() const {
+  return !pref_service_->GetTime(kReferralTimestamp).is_null();
+}
+
+void BraveReferralsService::MaybeMarkReferralComplete() const {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  // The referral is complete once the promo code file has been
+  // checked, the promo code has expired and there is no download
+  // left waiting for finalization.
+  if (!pref_service_->GetBoolean(kReferralCheckedForPromoCodeFile))
+    return;
+  if (!pref_service_->GetString(kReferralPromoCode).empty())
+    return;
+  if (!pref_service_->GetString(kReferralDownloadID).empty() &&
+      !IsReferralFinalized())
+    return;
+
+  pref_service_->SetBoolean(kReferralComplete, true);
 }
 
 std::string BraveReferralsService::BuildReferralInitPayload() const {
@@ -459,6 +491,7 @@ void RegisterPrefsForBraveReferralsService(PrefRegistrySimple* registry) {
   registry->RegisterStringPref(kReferralTimestamp, std::string());
   registry->RegisterTimePref(kReferralAttemptTimestamp, base::Time());
   registry->RegisterIntegerPref(kReferralAttemptCount, 0);
+  registry->RegisterBooleanPref(kReferralComplete, false);
 }
 
 }  // namespace brave
@@ -46,6 +46,8 @@ class BraveReferralsService {
   void DeletePromoCodeFile() const;
   void MaybeCheckForReferralFinalization();
   void MaybeDeletePromoCodePref() const;
+  bool IsReferralFinalized() const;
+  void MaybeMarkReferralComplete() const;
   void InitReferral();
   std::string BuildReferralInitPayload() const;
   std::string BuildReferralFinalizationCheckPayload() const;
@@ -0,0 +1,137 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/favicon_cache.h"
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+
+namespace brave_rewards {
+
+namespace {
+
+// How long a fetched icon is used before it is fetched again.
+constexpr base::TimeDelta kMaxAge = base::TimeDelta::FromDays(1);
+
+constexpr size_t kMaxEntries = 1000;
+
+}  // namespace
+
+FaviconCache::FaviconCache() {
+}
+
+FaviconCache::~FaviconCache() {
+}
+
+bool FaviconCache::IsFresh(const Entry& entry, base::Time now) const {
+  return entry.fetched <= now && now - entry.fetched < kMaxAge;
+}
+
+bool FaviconCache::Get(const std::string& url,
+                       base::Time now,
+                       std::string* favicon_key) const {
+  auto it = entries_.find(url);
+  if (it == entries_.end() || !IsFresh(it->second, now)) {
+    return false;
+  }
+
+  *favicon_key = it->second.favicon_key;
+  return true;
+}
+
+bool FaviconCache::Put(const std::string& url,
+                       const std::string& hash,
+                       base::Time now,
+                       std::string* favicon_key) {
+  Entry& entry = entries_[url];
+  entry.fetched = now;
+  if (!entry.favicon_key.empty() && entry.hash == hash) {
+    *favicon_key = entry.favicon_key;
+    return true;
+  }
+
+  entry.favicon_key = *favicon_key;
+  entry.hash = hash;
+
+  if (entries_.size() > kMaxEntries) {
+    EvictOldest();
+  }
+  return false;
+}
+
+void FaviconCache::EvictOldest() {
+  auto oldest = entries_.begin();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->second.fetched < oldest->second.fetched) {
+      oldest = it;
+    }
+  }
+  entries_.erase(oldest);
+}
+
+bool FaviconCache::FromJSON(const std::string& json) {
+  entries_.clear();
+
+  base::Optional<base::Value> root = base::JSONReader::Read(json);
+  if (!root || !root->is_dict()) {
+    return false;
+  }
+
+  for (const auto& item : root->DictItems()) {
+    if (!item.second.is_dict()) {
+      continue;
+    }
+
+    const std::string* favicon_key = item.second.FindStringKey("key");
+    const std::string* hash = item.second.FindStringKey("hash");
+    const std::string* fetched = item.second.FindStringKey("fetched");
+    int64_t fetched_us = 0;
+    if (!favicon_key || !hash || !fetched ||
+        !base::StringToInt64(*fetched, &fetched_us)) {
+      continue;
+    }
+
+    Entry& entry = entries_[item.first];
+    entry.favicon_key = *favicon_key;
+    entry.hash = *hash;
+    entry.fetched = base::Time::FromDeltaSinceWindowsEpoch(
+        base::TimeDelta::FromMicroseconds(fetched_us));
+  }
+
+  while (entries_.size() > kMaxEntries) {
+    EvictOldest();
+  }
+  return true;
+}
+
+std::string FaviconCache::ToJSON() const {
+  base::Value root(base::Value::Type::DICTIONARY);
+  for (const auto& item : entries_) {
+    base::Value entry(base::Value::Type::DICTIONARY);
+    entry.SetKey("key", base::Value(item.second.favicon_key));
+    entry.SetKey("hash", base::Value(item.second.hash));
+    // Stored as a string, like base::Time prefs, since JSON numbers can't
+    // hold every int64_t.
+    entry.SetKey("fetched", base::Value(base::Int64ToString(
+        item.second.fetched.ToDeltaSinceWindowsEpoch().InMicroseconds())));
+    root.SetKey(item.first, std::move(entry));
+  }
+
+  std::string json;
+  if (!base::JSONWriter::Write(root, &json)) {
+    LOG(ERROR) << "Failed to serialize the favicon cache";
+    return std::string();
+  }
+  return json;
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,67 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_FAVICON_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_FAVICON_CACHE_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace brave_rewards {
+
+// Remembers which favicon key each fetched publisher favicon was stored under
+// in the favicon service, along with a hash of the fetched image.
+//
+// The rewards WebUI and panel load publisher icons through
+// chrome://favicon/<favicon key>, so handing out the same key for an icon that
+// hasn't changed keeps those URLs stable and lets the ledger skip rewriting
+// the publisher. The cache is serialized to JSON so it survives restarts.
+class FaviconCache {
+ public:
+  FaviconCache();
+  ~FaviconCache();
+
+  // Sets |favicon_key| to the key |url| was last stored under, if it was
+  // fetched recently enough not to be fetched again.
+  bool Get(const std::string& url,
+           base::Time now,
+           std::string* favicon_key) const;
+
+  // Records that |url| was fetched with an image hashing to |hash|. Returns
+  // true and sets |favicon_key| to the cached key if the image hasn't
+  // changed, otherwise remembers |favicon_key| for it and returns false.
+  bool Put(const std::string& url,
+           const std::string& hash,
+           base::Time now,
+           std::string* favicon_key);
+
+  bool FromJSON(const std::string& json);
+  std::string ToJSON() const;
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    std::string favicon_key;
+    std::string hash;
+    base::Time fetched;
+  };
+
+  bool IsFresh(const Entry& entry, base::Time now) const;
+  void EvictOldest();
+
+  std::map<std::string, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(FaviconCache);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_FAVICON_CACHE_H_
@@ -0,0 +1,67 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/favicon_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=FaviconCacheTest.*
+
+namespace brave_rewards {
+
+TEST(FaviconCacheTest, ReusesKeyForUnchangedIcon) {
+  FaviconCache cache;
+  const base::Time now = base::Time::Now();
+
+  std::string key = "https://first.invalid";
+  EXPECT_FALSE(cache.Put("https://brave.com/favicon.ico", "hash", now, &key));
+  EXPECT_EQ(key, "https://first.invalid");
+
+  key = "https://second.invalid";
+  EXPECT_TRUE(cache.Put("https://brave.com/favicon.ico", "hash", now, &key));
+  EXPECT_EQ(key, "https://first.invalid");
+
+  key = "https://third.invalid";
+  EXPECT_FALSE(cache.Put("https://brave.com/favicon.ico", "other", now, &key));
+  EXPECT_EQ(key, "https://third.invalid");
+}
+
+TEST(FaviconCacheTest, GetExpires) {
+  FaviconCache cache;
+  const base::Time now = base::Time::Now();
+
+  std::string key = "https://first.invalid";
+  cache.Put("https://brave.com/favicon.ico", "hash", now, &key);
+
+  std::string cached;
+  EXPECT_TRUE(cache.Get("https://brave.com/favicon.ico",
+                        now + base::TimeDelta::FromHours(1), &cached));
+  EXPECT_EQ(cached, "https://first.invalid");
+  EXPECT_FALSE(cache.Get("https://brave.com/favicon.ico",
+                         now + base::TimeDelta::FromDays(2), &cached));
+  EXPECT_FALSE(cache.Get("https://basicattentiontoken.org/favicon.ico",
+                         now, &cached));
+}
+
+TEST(FaviconCacheTest, RoundTripsJSON) {
+  FaviconCache cache;
+  const base::Time now = base::Time::Now();
+
+  std::string key = "https://first.invalid";
+  cache.Put("https://brave.com/favicon.ico", "hash", now, &key);
+
+  FaviconCache loaded;
+  ASSERT_TRUE(loaded.FromJSON(cache.ToJSON()));
+  EXPECT_EQ(loaded.size(), 1u);
+
+  std::string cached;
+  EXPECT_TRUE(loaded.Get("https://brave.com/favicon.ico", now, &cached));
+  EXPECT_EQ(cached, "https://first.invalid");
+
+  EXPECT_FALSE(loaded.FromJSON("[]"));
+  EXPECT_EQ(loaded.size(), 0u);
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,338 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/journaled_state_store.h"
+
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "crypto/sha2.h"
+
+namespace brave_rewards {
+
+namespace {
+
+const char kJournalExtension[] = ".journal";
+const char kNull[] = "null";
+
+std::string HashSnapshot(const std::string& snapshot) {
+  return base::HexEncode(crypto::SHA256HashString(snapshot).data(),
+                         crypto::kSHA256Length);
+}
+
+void SkipWhitespace(const std::string& json, size_t* pos) {
+  while (*pos < json.size() &&
+         (json[*pos] == ' ' || json[*pos] == '\t' ||
+          json[*pos] == '\n' || json[*pos] == '\r')) {
+    (*pos)++;
+  }
+}
+
+// Advances |pos| past the JSON string starting at it.
+bool SkipString(const std::string& json, size_t* pos) {
+  DCHECK_EQ(json[*pos], '"');
+  for ((*pos)++; *pos < json.size(); (*pos)++) {
+    if (json[*pos] == '\\') {
+      (*pos)++;
+    } else if (json[*pos] == '"') {
+      (*pos)++;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Advances |pos| past the JSON value starting at it. Only the nesting is
+// checked; the value itself is validated by whoever parses the state.
+bool SkipValue(const std::string& json, size_t* pos) {
+  if (*pos >= json.size()) {
+    return false;
+  }
+
+  if (json[*pos] == '"') {
+    return SkipString(json, pos);
+  }
+
+  if (json[*pos] == '{' || json[*pos] == '[') {
+    int depth = 0;
+    while (*pos < json.size()) {
+      const char c = json[*pos];
+      if (c == '"') {
+        if (!SkipString(json, pos)) {
+          return false;
+        }
+        continue;
+      }
+      if (c == '{' || c == '[') {
+        depth++;
+      } else if (c == '}' || c == ']') {
+        depth--;
+      }
+      (*pos)++;
+      if (depth == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const size_t start = *pos;
+  while (*pos < json.size() && json[*pos] != ',' && json[*pos] != '}' &&
+         json[*pos] != ' ' && json[*pos] != '\n' && json[*pos] != '\t' &&
+         json[*pos] != '\r') {
+    (*pos)++;
+  }
+  return *pos > start;
+}
+
+// Splits a JSON object into the raw text of its top-level members.
+bool SplitObject(const std::string& json,
+                 std::map<std::string, std::string>* members) {
+  members->clear();
+
+  size_t pos = 0;
+  SkipWhitespace(json, &pos);
+  if (pos >= json.size() || json[pos] != '{') {
+    return false;
+  }
+  pos++;
+
+  SkipWhitespace(json, &pos);
+  if (pos < json.size() && json[pos] == '}') {
+    pos++;
+  } else {
+    while (true) {
+      SkipWhitespace(json, &pos);
+      if (pos >= json.size() || json[pos] != '"') {
+        return false;
+      }
+      const size_t key_start = pos;
+      if (!SkipString(json, &pos)) {
+        return false;
+      }
+      const std::string key = json.substr(key_start, pos - key_start);
+
+      SkipWhitespace(json, &pos);
+      if (pos >= json.size() || json[pos] != ':') {
+        return false;
+      }
+      pos++;
+      SkipWhitespace(json, &pos);
+
+      const size_t value_start = pos;
+      if (!SkipValue(json, &pos)) {
+        return false;
+      }
+      (*members)[key] = json.substr(value_start, pos - value_start);
+
+      SkipWhitespace(json, &pos);
+      if (pos >= json.size()) {
+        return false;
+      }
+      if (json[pos] == '}') {
+        pos++;
+        break;
+      }
+      if (json[pos] != ',') {
+        return false;
+      }
+      pos++;
+    }
+  }
+
+  SkipWhitespace(json, &pos);
+  return pos == json.size();
+}
+
+std::string JoinObject(const std::map<std::string, std::string>& members) {
+  std::string json = "{";
+  for (const auto& member : members) {
+    if (json.size() > 1) {
+      json += ",";
+    }
+    json += member.first;
+    json += ":";
+    json += member.second;
+  }
+  json += "}";
+  return json;
+}
+
+std::string JournalHeader(const std::string& snapshot_hash) {
+  return "{\"snapshot\":\"" + snapshot_hash + "\"}\n";
+}
+
+}  // namespace
+
+JournaledStateStore::JournaledStateStore(const base::FilePath& path)
+    : path_(path),
+      journal_path_(path.AddExtensionASCII(kJournalExtension)),
+      loaded_(false),
+      journaling_(false),
+      snapshot_size_(0),
+      journal_size_(0) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+JournaledStateStore::~JournaledStateStore() {
+}
+
+std::string JournaledStateStore::Load() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  loaded_ = true;
+  journaling_ = false;
+  members_.clear();
+  journal_size_ = 0;
+
+  std::string snapshot;
+  if (!base::ReadFileToString(path_, &snapshot) || snapshot.empty()) {
+    LOG(ERROR) << "Failed to read file: " << path_.MaybeAsASCII();
+    snapshot_hash_.clear();
+    snapshot_size_ = 0;
+    return std::string();
+  }
+
+  snapshot_hash_ = HashSnapshot(snapshot);
+  snapshot_size_ = snapshot.size();
+  journaling_ = SplitObject(snapshot, &members_);
+  if (!journaling_) {
+    return snapshot;
+  }
+
+  std::string journal;
+  if (!base::ReadFileToString(journal_path_, &journal)) {
+    return snapshot;
+  }
+
+  std::vector<std::string> lines = base::SplitString(
+      journal, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (lines.empty() || lines[0] + "\n" != JournalHeader(snapshot_hash_)) {
+    // Left over from before the snapshot was last replaced.
+    base::DeleteFile(journal_path_, false);
+    return snapshot;
+  }
+
+  bool torn = !journal.empty() && journal.back() != '\n';
+  size_t applied = 0;
+  for (size_t i = 1; i < lines.size(); i++) {
+    Members record;
+    if ((torn && i == lines.size() - 1) || !SplitObject(lines[i], &record)) {
+      torn = true;
+      break;
+    }
+    for (const auto& member : record) {
+      if (member.second == kNull) {
+        members_.erase(member.first);
+      } else {
+        members_[member.first] = member.second;
+      }
+    }
+    applied++;
+  }
+
+  if (applied == 0 && !torn) {
+    journal_size_ = journal.size();
+    return snapshot;
+  }
+
+  const std::string state = JoinObject(members_);
+  if (torn) {
+    // Later appends would land after the torn record, so start over from
+    // what could be recovered.
+    Compact(state);
+  } else {
+    journal_size_ = journal.size();
+  }
+  return state;
+}
+
+void JournaledStateStore::LoadIfNeeded() {
+  if (!loaded_) {
+    Load();
+  }
+}
+
+bool JournaledStateStore::Save(const std::string& state) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  LoadIfNeeded();
+
+  Members members;
+  if (!journaling_ || !SplitObject(state, &members)) {
+    return Compact(state);
+  }
+
+  Members record;
+  for (const auto& member : members) {
+    auto it = members_.find(member.first);
+    if (it == members_.end() || it->second != member.second) {
+      record[member.first] = member.second;
+    }
+  }
+  for (const auto& member : members_) {
+    if (members.find(member.first) == members.end()) {
+      record[member.first] = kNull;
+    }
+  }
+
+  if (record.empty()) {
+    return true;
+  }
+
+  const std::string line = JoinObject(record);
+  if (line.find('\n') != std::string::npos ||
+      journal_size_ + line.size() > snapshot_size_) {
+    return Compact(state);
+  }
+
+  if (!Append(line + "\n")) {
+    return Compact(state);
+  }
+
+  members_.swap(members);
+  return true;
+}
+
+bool JournaledStateStore::Compact(const std::string& state) {
+  if (!base::ImportantFileWriter::WriteFileAtomically(path_, state)) {
+    return false;
+  }
+
+  base::DeleteFile(journal_path_, false);
+  snapshot_hash_ = HashSnapshot(state);
+  snapshot_size_ = state.size();
+  journal_size_ = 0;
+  journaling_ = SplitObject(state, &members_);
+  return true;
+}
+
+bool JournaledStateStore::Append(const std::string& record) {
+  std::string data = record;
+  if (journal_size_ == 0) {
+    data = JournalHeader(snapshot_hash_) + record;
+  }
+
+  base::File file(journal_path_,
+                  base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+  if (!file.IsValid()) {
+    return false;
+  }
+
+  // The state holds wallet keys, so a record has to be on disk before the
+  // save is reported as done.
+  const int size = static_cast<int>(data.size());
+  if (file.WriteAtCurrentPos(data.data(), size) != size || !file.Flush()) {
+    return false;
+  }
+
+  journal_size_ += data.size();
+  return true;
+}
+
+}  // namespace brave_rewards
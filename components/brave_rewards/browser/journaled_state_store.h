@@ -0,0 +1,71 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_JOURNALED_STATE_STORE_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_JOURNALED_STATE_STORE_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/sequence_checker.h"
+
+namespace brave_rewards {
+
+// Persists a JSON object state, such as the ledger or publisher state, as a
+// snapshot file plus an append-only journal next to it.
+//
+// Each save appends one line to the journal holding only the top-level
+// members that changed since the previous save, with removed members set to
+// null. Member values are kept as their original JSON text so numbers are
+// never reformatted. Once the journal grows larger than the snapshot, the
+// state is compacted into a new snapshot and the journal is restarted.
+//
+// The journal starts with a header naming the snapshot it applies to, so a
+// journal left behind by an interrupted compaction is ignored.
+//
+// Must be used on a sequence that allows blocking.
+class JournaledStateStore {
+ public:
+  explicit JournaledStateStore(const base::FilePath& path);
+  ~JournaledStateStore();
+
+  // Returns the last saved state, or an empty string if there is none.
+  std::string Load();
+
+  bool Save(const std::string& state);
+
+  const base::FilePath& journal_path() const { return journal_path_; }
+
+ private:
+  // Raw JSON text of a top-level member name, quotes included, to the raw
+  // JSON text of its value.
+  using Members = std::map<std::string, std::string>;
+
+  void LoadIfNeeded();
+  bool Compact(const std::string& state);
+  bool Append(const std::string& record);
+
+  const base::FilePath path_;
+  const base::FilePath journal_path_;
+
+  bool loaded_;
+  // False when the snapshot isn't a JSON object that can be journaled.
+  bool journaling_;
+  Members members_;
+  std::string snapshot_hash_;
+  size_t snapshot_size_;
+  size_t journal_size_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  DISALLOW_COPY_AND_ASSIGN(JournaledStateStore);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_JOURNALED_STATE_STORE_H_
@@ -0,0 +1,99 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/journaled_state_store.h"
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=JournaledStateStoreTest.*
+
+namespace brave_rewards {
+
+class JournaledStateStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("ledger_state");
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(JournaledStateStoreTest, SaveAndLoad) {
+  JournaledStateStore store(path_);
+  EXPECT_EQ(store.Load(), std::string());
+
+  ASSERT_TRUE(store.Save(
+      "{\"walletInfo\":{\"paymentId\":\"abc\"},"
+      "\"reconcileStamp\":18446744073709551615,\"days\":30}"));
+  EXPECT_FALSE(base::PathExists(store.journal_path()));
+
+  // Only the changed and removed members are appended.
+  ASSERT_TRUE(store.Save(
+      "{\"walletInfo\":{\"paymentId\":\"abc\"},"
+      "\"reconcileStamp\":18446744073709551614}"));
+  std::string journal;
+  ASSERT_TRUE(base::ReadFileToString(store.journal_path(), &journal));
+  EXPECT_NE(journal.find("{\"days\":null,"
+                         "\"reconcileStamp\":18446744073709551614}\n"),
+            std::string::npos);
+
+  // Saving the same state again writes nothing.
+  ASSERT_TRUE(store.Save(
+      "{\"walletInfo\":{\"paymentId\":\"abc\"},"
+      "\"reconcileStamp\":18446744073709551614}"));
+  std::string unchanged;
+  ASSERT_TRUE(base::ReadFileToString(store.journal_path(), &unchanged));
+  EXPECT_EQ(unchanged, journal);
+
+  JournaledStateStore reloaded(path_);
+  EXPECT_EQ(reloaded.Load(),
+            "{\"reconcileStamp\":18446744073709551614,"
+            "\"walletInfo\":{\"paymentId\":\"abc\"}}");
+}
+
+TEST_F(JournaledStateStoreTest, IgnoresStaleJournal) {
+  {
+    JournaledStateStore store(path_);
+    ASSERT_TRUE(store.Save("{\"a\":1,\"b\":\"long enough to journal\"}"));
+    ASSERT_TRUE(store.Save("{\"a\":2,\"b\":\"long enough to journal\"}"));
+    ASSERT_TRUE(base::PathExists(store.journal_path()));
+  }
+
+  // The snapshot was replaced without the journal being removed.
+  ASSERT_TRUE(base::WriteFile(path_, "{\"a\":3}", 7));
+
+  JournaledStateStore store(path_);
+  EXPECT_EQ(store.Load(), "{\"a\":3}");
+  EXPECT_FALSE(base::PathExists(store.journal_path()));
+}
+
+TEST_F(JournaledStateStoreTest, RecoversTornRecord) {
+  {
+    JournaledStateStore store(path_);
+    ASSERT_TRUE(store.Save("{\"a\":1,\"b\":\"long enough to journal\"}"));
+    ASSERT_TRUE(store.Save("{\"a\":2,\"b\":\"long enough to journal\"}"));
+  }
+
+  JournaledStateStore store(path_);
+  ASSERT_TRUE(base::AppendToFile(store.journal_path(), "{\"a\":", 5));
+  EXPECT_EQ(store.Load(), "{\"a\":2,\"b\":\"long enough to journal\"}");
+  EXPECT_FALSE(base::PathExists(store.journal_path()));
+}
+
+TEST_F(JournaledStateStoreTest, NonObjectState) {
+  JournaledStateStore store(path_);
+  ASSERT_TRUE(store.Save("[1,2,3]"));
+  ASSERT_TRUE(store.Save("[1,2]"));
+  EXPECT_FALSE(base::PathExists(store.journal_path()));
+
+  JournaledStateStore reloaded(path_);
+  EXPECT_EQ(reloaded.Load(), "[1,2]");
+}
+
+}  // namespace brave_rewards
@@ -4,6 +4,8 @@
 
 #include "brave/components/brave_rewards/browser/net/network_delegate_helper.h"
 
+#include <utility>
+
 #include "base/task/post_task.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/brave_rewards/browser/rewards_service_factory.h"
@@ -96,7 +98,7 @@ content::WebContents* GetWebContents(
 }
 
 void DispatchOnUI(
-    const std::string post_data,
+    const std::string& post_data,
     const GURL url,
     const GURL first_party_url,
     const std::string referrer,
@@ -129,7 +131,10 @@ int OnBeforeURLRequest(
   std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
 
-  if (IsMediaLink(ctx->request_url,
+  // Only uploads to the media endpoints known to the ledger are read, and
+  // the cheap upload check keeps every other request from being classified.
+  if (ctx->request->has_upload() &&
+      IsMediaLink(ctx->request_url,
                   ctx->request->site_for_cookies(),
                   GURL(ctx->request->referrer()))) {
     std::string post_data;
@@ -139,7 +144,7 @@ int OnBeforeURLRequest(
           &frame_tree_node_id);
       base::PostTaskWithTraits(FROM_HERE, {content::BrowserThread::UI},
           base::BindOnce(&DispatchOnUI,
-              post_data,
+              std::move(post_data),
               ctx->request_url, ctx->request->site_for_cookies(), ctx->request->referrer(),
               render_process_id, render_frame_id, frame_tree_node_id));
     }
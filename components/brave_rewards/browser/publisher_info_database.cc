@@ -5,14 +5,20 @@
 
 #include "brave/components/brave_rewards/browser/publisher_info_database.h"
 
+#include <inttypes.h>
 #include <stdint.h>
 
+#include <map>
 #include <string>
 #include <utility>
 
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/files/file_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "bat/ledger/ledger.h"
 #include "bat/ledger/media_publisher_info.h"
 #include "bat/ledger/pending_contribution.h"
 #include "build/build_config.h"
@@ -26,19 +32,111 @@ namespace brave_rewards {
 
 namespace {
 
-const int kCurrentVersionNumber = 6;
+const int kCurrentVersionNumber = 8;
 const int kCompatibleVersionNumber = 1;
 
+// How long visit updates are kept in memory before they are written out.
+constexpr base::TimeDelta kPendingWritesFlushDelay =
+    base::TimeDelta::FromSeconds(30);
+
+// Rows copied per transaction when a migration rebuilds a table, so a large
+// table isn't rewritten in one long transaction and an interrupted migration
+// only redoes the chunk it was on.
+const int kMigrationChunkSize = 1000;
+
+// Enough to map a profile with years of activity.
+const int64_t kDefaultMmapSize = 32 * 1024 * 1024;
+
+// How often the write-ahead log is folded back into the database. SQLite
+// also does this itself whenever the log grows past 1000 pages.
+constexpr base::TimeDelta kCheckpointInterval =
+    base::TimeDelta::FromMinutes(5);
+
+// Below this share of free pages a vacuum costs more than it gives back.
+const double kVacuumFreePageRatio = 0.1;
+
+// Pages freed by each VacuumStep().
+const int kIncrementalVacuumPages = 128;
+
+// Written out rather than bound so that queries can use
+// publisher_info_excluded_index, which only covers this condition.
+const char kExcludedCondition[] = "excluded = 1";
+
+// Columns GetActivityList can order, and therefore page, by.
+const char* GetActivityOrderColumn(const std::string& name) {
+  static const char* const kColumns[] = {
+      "ai.duration",
+      "ai.visits",
+      "ai.score",
+      "ai.percent",
+      "ai.weight",
+      "ai.reconcile_stamp",
+  };
+  for (const char* column : kColumns) {
+    if (name == column) {
+      return column;
+    }
+  }
+  return nullptr;
+}
+
+// Balance report column holding the amounts of each report type.
+const char* GetBalanceReportColumn(ledger::ReportType type) {
+  switch (type) {
+    case ledger::ReportType::GRANT:
+      return "grants";
+    case ledger::ReportType::AUTO_CONTRIBUTION:
+      return "auto_contribute";
+    case ledger::ReportType::DEPOSIT:
+      return "deposits";
+    case ledger::ReportType::ADS:
+      return "earning_from_ads";
+    case ledger::ReportType::TIP_RECURRING:
+      return "recurring_donation";
+    case ledger::ReportType::TIP:
+      return "one_time_donation";
+  }
+  return nullptr;
+}
+
+// Whether |probi| is a non-negative decimal amount.
+bool IsProbi(const std::string& probi) {
+  return !probi.empty() && base::ContainsOnlyChars(probi, "0123456789");
+}
+
+void ReadBalanceReport(sql::Statement* statement,
+                       ledger::BalanceReportInfo* info) {
+  info->opening_balance_ = statement->ColumnString(2);
+  info->closing_balance_ = statement->ColumnString(3);
+  info->deposits_ = statement->ColumnString(4);
+  info->grants_ = statement->ColumnString(5);
+  info->earning_from_ads_ = statement->ColumnString(6);
+  info->auto_contribute_ = statement->ColumnString(7);
+  info->recurring_donation_ = statement->ColumnString(8);
+  info->one_time_donation_ = statement->ColumnString(9);
+}
+
 }  // namespace
 
+ActivityListCursor::ActivityListCursor() {
+}
+
+ActivityListCursor::ActivityListCursor(const ActivityListCursor& other) =
+    default;
+
+ActivityListCursor::~ActivityListCursor() {
+}
+
 PublisherInfoDatabase::PublisherInfoDatabase(const base::FilePath& db_path) :
     db_path_(db_path),
     initialized_(false),
-    testing_current_version_(-1) {
+    testing_current_version_(-1),
+    mmap_size_(kDefaultMmapSize) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
 PublisherInfoDatabase::~PublisherInfoDatabase() {
+  FlushPendingWrites();
 }
 
 bool PublisherInfoDatabase::Init() {
@@ -52,6 +150,10 @@ bool PublisherInfoDatabase::Init() {
     return false;
   }
 
+  if (!ConfigureDatabase()) {
+    return false;
+  }
+
   // TODO(brave): Add error delegate
   sql::Transaction committer(&db_);
   if (!committer.Begin()) {
@@ -67,7 +169,8 @@ bool PublisherInfoDatabase::Init() {
       !CreateActivityInfoTable() ||
       !CreateMediaPublisherInfoTable() ||
       !CreateRecurringTipsTable() ||
-      !CreatePendingContributionsTable()) {
+      !CreatePendingContributionsTable() ||
+      !CreateBalanceReportInfoTable()) {
     return false;
   }
 
@@ -76,20 +179,25 @@ bool PublisherInfoDatabase::Init() {
   CreateRecurringTipsIndex();
   CreatePendingContributionsIndex();
 
-  // Version check.
+  if (!committer.Commit()) {
+    return false;
+  }
+
+  // Version check. Migrations commit as they go, so they are run outside of
+  // |committer| and resume where they stopped if they were interrupted.
   sql::InitStatus version_status = EnsureCurrentVersion();
   if (version_status != sql::INIT_OK) {
     return version_status;
   }
 
-  if (!committer.Commit()) {
-    return false;
-  }
-
   memory_pressure_listener_.reset(new base::MemoryPressureListener(
       base::Bind(&PublisherInfoDatabase::OnMemoryPressure,
       base::Unretained(this))));
 
+  checkpoint_timer_.Start(FROM_HERE, kCheckpointInterval,
+                          base::Bind(&PublisherInfoDatabase::Checkpoint,
+                                     base::Unretained(this)));
+
   initialized_ = true;
   return initialized_;
 }
@@ -166,6 +274,7 @@ void PublisherInfoDatabase::GetOneTimeTips(ledger::PublisherInfoList* list,
                                            ledger::ACTIVITY_MONTH month,
                                            int year) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -229,12 +338,124 @@ bool PublisherInfoDatabase::CreatePublisherInfoTable() {
       "url TEXT NOT NULL,"
       "provider TEXT NOT NULL)");
 
+  if (!GetDB().Execute(sql.c_str())) {
+    return false;
+  }
+
+  // Existing tables get this index from MigrateV7toV8.
+  return CreatePublisherInfoExcludedIndex();
+}
+
+bool PublisherInfoDatabase::CreatePublisherInfoExcludedIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Only excluded publishers are indexed, so the index stays small however
+  // many publishers have been visited.
+  std::string sql =
+      "CREATE INDEX IF NOT EXISTS publisher_info_excluded_index "
+      "ON publisher_info (publisher_id) WHERE ";
+  sql.append(kExcludedCondition);
+
   return GetDB().Execute(sql.c_str());
 }
 
 bool PublisherInfoDatabase::InsertOrUpdatePublisherInfo(
     const ledger::PublisherInfo& info) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
+  return WritePublisherInfo(info);
+}
+
+void PublisherInfoDatabase::QueuePublisherInfo(
+    const ledger::PublisherInfo& info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (info.id.empty()) {
+    return;
+  }
+  QueuePendingWrite(&pending_publisher_info_, info.id, info);
+}
+
+void PublisherInfoDatabase::QueueActivityInfo(
+    const ledger::PublisherInfo& info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (info.id.empty()) {
+    return;
+  }
+  // Activity rows also refresh the publisher row, as
+  // InsertOrUpdateActivityInfo does.
+  QueuePendingWrite(&pending_publisher_info_, info.id, info);
+  QueuePendingWrite(&pending_activity_info_,
+                    std::make_pair(info.id, info.reconcile_stamp), info);
+}
+
+template <typename Key>
+void PublisherInfoDatabase::QueuePendingWrite(
+    std::map<Key, ledger::PublisherInfoPtr>* pending,
+    const Key& key,
+    const ledger::PublisherInfo& info) {
+  ledger::PublisherInfoPtr& queued = (*pending)[key];
+  // An empty favicon means "keep the current one", so don't let a later
+  // update drop a favicon change that is still queued.
+  std::string favicon_url =
+      info.favicon_url.empty() && queued ? queued->favicon_url
+                                         : info.favicon_url;
+  queued = info.Clone();
+  queued->favicon_url = favicon_url;
+
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, kPendingWritesFlushDelay,
+                       base::Bind(
+                           base::IgnoreResult(
+                               &PublisherInfoDatabase::FlushPendingWrites),
+                           base::Unretained(this)));
+  }
+}
+
+bool PublisherInfoDatabase::FlushPendingWrites() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (pending_publisher_info_.empty() && pending_activity_info_.empty()) {
+    return true;
+  }
+  flush_timer_.Stop();
+
+  std::map<std::string, ledger::PublisherInfoPtr> publishers;
+  std::map<std::pair<std::string, uint64_t>, ledger::PublisherInfoPtr>
+      activities;
+  publishers.swap(pending_publisher_info_);
+  activities.swap(pending_activity_info_);
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return false;
+  }
+
+  sql::Transaction transaction(&GetDB());
+  if (!transaction.Begin()) {
+    return false;
+  }
+
+  for (const auto& publisher : publishers) {
+    if (!WritePublisherInfo(*publisher.second)) {
+      transaction.Rollback();
+      return false;
+    }
+  }
+
+  for (const auto& activity : activities) {
+    if (!WriteActivityRow(*activity.second)) {
+      transaction.Rollback();
+      return false;
+    }
+  }
+
+  return transaction.Commit();
+}
+
+bool PublisherInfoDatabase::WritePublisherInfo(
+    const ledger::PublisherInfo& info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -292,6 +513,7 @@ bool PublisherInfoDatabase::InsertOrUpdatePublisherInfo(
 ledger::PublisherInfoPtr
 PublisherInfoDatabase::GetPublisherInfo(const std::string& publisher_key) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -327,6 +549,7 @@ ledger::PublisherInfoPtr
 PublisherInfoDatabase::GetPanelPublisher(
     const ledger::ActivityInfoFilter& filter) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -368,6 +591,7 @@ PublisherInfoDatabase::GetPanelPublisher(
 
 bool PublisherInfoDatabase::RestorePublishers() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -376,13 +600,13 @@ bool PublisherInfoDatabase::RestorePublishers() {
     return false;
   }
 
-  sql::Statement restore_q(db_.GetUniqueStatement(
-      "UPDATE publisher_info SET excluded=? WHERE excluded=?"));
+  std::string query = "UPDATE publisher_info SET excluded=? WHERE ";
+  query.append(kExcludedCondition);
+
+  sql::Statement restore_q(db_.GetUniqueStatement(query.c_str()));
 
   restore_q.BindInt(0, static_cast<int>(
       ledger::PUBLISHER_EXCLUDE::DEFAULT));
-  restore_q.BindInt(1, static_cast<int>(
-      ledger::PUBLISHER_EXCLUDE::EXCLUDED));
 
   return restore_q.Run();
 }
@@ -419,7 +643,12 @@ bool PublisherInfoDatabase::CreateActivityInfoTable() {
       "    REFERENCES publisher_info (publisher_id)"
       "    ON DELETE CASCADE)");
 
-  return GetDB().Execute(sql.c_str());
+  if (!GetDB().Execute(sql.c_str())) {
+    return false;
+  }
+
+  // Existing tables get this index from MigrateV6toV7.
+  return CreateActivityInfoStampIndex();
 }
 
 bool PublisherInfoDatabase::CreateActivityInfoIndex() {
@@ -430,9 +659,26 @@ bool PublisherInfoDatabase::CreateActivityInfoIndex() {
       "ON activity_info (publisher_id)");
 }
 
+bool PublisherInfoDatabase::CreateActivityInfoStampIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Covers the reconcile stamp, duration and visits filters of
+  // GetActivityList.
+  return GetDB().Execute(
+      "CREATE INDEX IF NOT EXISTS activity_info_reconcile_stamp_index "
+      "ON activity_info (reconcile_stamp, duration, visits)");
+}
+
 bool PublisherInfoDatabase::InsertOrUpdateActivityInfo(
     const ledger::PublisherInfo& info) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
+  return WriteActivityInfo(info);
+}
+
+bool PublisherInfoDatabase::WriteActivityInfo(
+    const ledger::PublisherInfo& info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -441,10 +687,15 @@ bool PublisherInfoDatabase::InsertOrUpdateActivityInfo(
     return false;
   }
 
-  if (!InsertOrUpdatePublisherInfo(info)) {
+  if (!WritePublisherInfo(info)) {
     return false;
   }
 
+  return WriteActivityRow(info);
+}
+
+bool PublisherInfoDatabase::WriteActivityRow(
+    const ledger::PublisherInfo& info) {
   sql::Statement activity_info_insert(
     GetDB().GetCachedStatement(SQL_FROM_HERE,
         "INSERT OR REPLACE INTO activity_info "
@@ -466,6 +717,34 @@ bool PublisherInfoDatabase::InsertOrUpdateActivityInfo(
 bool PublisherInfoDatabase::InsertOrUpdateActivityInfos(
     const ledger::PublisherInfoList& list) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized || list.size() == 0) {
+    return false;
+  }
+
+  sql::Transaction transaction(&GetDB());
+  if (!transaction.Begin()) {
+    return false;
+  }
+
+  for (const auto& info : list) {
+    if (!WriteActivityInfo(*info)) {
+      transaction.Rollback();
+      return false;
+    }
+  }
+
+  return transaction.Commit();
+}
+
+bool PublisherInfoDatabase::UpdateActivityInfoShares(
+    const ledger::PublisherInfoList& list) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -480,7 +759,22 @@ bool PublisherInfoDatabase::InsertOrUpdateActivityInfos(
   }
 
   for (const auto& info : list) {
-    if (!InsertOrUpdateActivityInfo(*info)) {
+    sql::Statement activity_info_update(
+        GetDB().GetCachedStatement(SQL_FROM_HERE,
+            "UPDATE activity_info SET score = ?, percent = ?, weight = ? "
+            "WHERE publisher_id = ? AND reconcile_stamp = ? "
+            "AND (score != ? OR percent != ? OR weight != ?)"));
+
+    activity_info_update.BindDouble(0, info->score);
+    activity_info_update.BindInt64(1, static_cast<int>(info->percent));
+    activity_info_update.BindDouble(2, info->weight);
+    activity_info_update.BindString(3, info->id);
+    activity_info_update.BindInt64(4, info->reconcile_stamp);
+    activity_info_update.BindDouble(5, info->score);
+    activity_info_update.BindInt64(6, static_cast<int>(info->percent));
+    activity_info_update.BindDouble(7, info->weight);
+
+    if (!activity_info_update.Run()) {
       transaction.Rollback();
       return false;
     }
@@ -495,6 +789,32 @@ bool PublisherInfoDatabase::GetActivityList(
     const ledger::ActivityInfoFilter& filter,
     ledger::PublisherInfoList* list) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return QueryActivityList(filter, limit, start > 1 ? start : 0, nullptr,
+                           list, nullptr);
+}
+
+bool PublisherInfoDatabase::GetActivityList(
+    const ledger::ActivityInfoFilter& filter,
+    int limit,
+    const ActivityListCursor& after,
+    ledger::PublisherInfoList* list,
+    ActivityListCursor* next) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  CHECK(next);
+  *next = after;
+  return QueryActivityList(filter, limit, 0,
+                           after.is_start() ? nullptr : &after, list, next);
+}
+
+bool PublisherInfoDatabase::QueryActivityList(
+    const ledger::ActivityInfoFilter& filter,
+    int limit,
+    int offset,
+    const ActivityListCursor* after,
+    ledger::PublisherInfoList* list,
+    ActivityListCursor* last) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   CHECK(list);
 
@@ -505,14 +825,35 @@ bool PublisherInfoDatabase::GetActivityList(
     return false;
   }
 
+  std::vector<std::pair<const char*, bool>> order_by;
+  for (const auto& it : filter.order_by) {
+    const char* column = GetActivityOrderColumn(it.first);
+    if (!column) {
+      LOG(ERROR) << "DB: Can't order activity list by " << it.first;
+      return false;
+    }
+    order_by.push_back(std::make_pair(column, it.second));
+  }
+
+  if (after && after->order_values.size() != order_by.size()) {
+    return false;
+  }
+
   std::string query = "SELECT ai.publisher_id, ai.duration, ai.score, "
                       "ai.percent, ai.weight, pi.verified, pi.excluded, "
                       "pi.name, pi.url, pi.provider, "
-                      "pi.favIcon, ai.reconcile_stamp, ai.visits "
-                      "FROM activity_info AS ai "
-                      "INNER JOIN publisher_info AS pi "
-                      "ON ai.publisher_id = pi.publisher_id "
-                      "WHERE 1 = 1";
+                      "pi.favIcon, ai.reconcile_stamp, ai.visits, "
+                      "ai.rowid";
+
+  for (const auto& it : order_by) {
+    query += ", ";
+    query += it.first;
+  }
+
+  query += " FROM activity_info AS ai "
+           "INNER JOIN publisher_info AS pi "
+           "ON ai.publisher_id = pi.publisher_id "
+           "WHERE 1 = 1";
 
   if (!filter.id.empty()) {
     query += " AND ai.publisher_id = ?";
@@ -549,20 +890,59 @@ bool PublisherInfoDatabase::GetActivityList(
     query += " AND pi.verified = 1";
   }
 
-  for (const auto& it : filter.order_by) {
-    query += " ORDER BY " + it.first;
-    query += (it.second ? " ASC" : " DESC");
+  // Rows after the cursor: the first column that differs from the cursor
+  // row has to be past it in that column's direction.
+  if (after) {
+    query += " AND (";
+    for (size_t i = 0; i <= order_by.size(); i++) {
+      if (i > 0) {
+        query += " OR ";
+      }
+      query += "(";
+      for (size_t j = 0; j < i; j++) {
+        query += order_by[j].first;
+        query += " = ? AND ";
+      }
+      if (i < order_by.size()) {
+        query += order_by[i].first;
+        query += order_by[i].second ? " > ?" : " < ?";
+      } else {
+        query += "ai.rowid > ?";
+      }
+      query += ")";
+    }
+    query += ")";
+  }
+
+  // Keyset pages need a total order, so rowid breaks ties there.
+  const bool keyset = last != nullptr;
+  if (!order_by.empty() || keyset) {
+    query += " ORDER BY ";
+  }
+  for (size_t i = 0; i < order_by.size(); i++) {
+    if (i > 0) {
+      query += ", ";
+    }
+    query += order_by[i].first;
+    query += (order_by[i].second ? " ASC" : " DESC");
+  }
+  if (keyset) {
+    query += order_by.empty() ? "ai.rowid ASC" : ", ai.rowid ASC";
   }
 
   if (limit > 0) {
-    query += " LIMIT " + std::to_string(limit);
+    query += " LIMIT ?";
 
-    if (start > 1) {
-      query += " OFFSET " + std::to_string(start);
+    if (offset > 0) {
+      query += " OFFSET ?";
     }
   }
 
-  sql::Statement info_sql(db_.GetUniqueStatement(query.c_str()));
+  // The query text only depends on the shape of the filter, so each shape
+  // is prepared once and then reused from the statement cache.
+  const std::string& cached_query = *activity_list_queries_.insert(query).first;
+  sql::Statement info_sql(db_.GetCachedStatement(
+      sql::StatementID(cached_query.c_str()), cached_query.c_str()));
 
   int column = 0;
   if (!filter.id.empty()) {
@@ -596,6 +976,27 @@ bool PublisherInfoDatabase::GetActivityList(
     info_sql.BindInt(column++, filter.min_visits);
   }
 
+  if (after) {
+    for (size_t i = 0; i <= order_by.size(); i++) {
+      for (size_t j = 0; j < i; j++) {
+        info_sql.BindDouble(column++, after->order_values[j]);
+      }
+      if (i < order_by.size()) {
+        info_sql.BindDouble(column++, after->order_values[i]);
+      } else {
+        info_sql.BindInt64(column++, after->rowid);
+      }
+    }
+  }
+
+  if (limit > 0) {
+    info_sql.BindInt(column++, limit);
+
+    if (offset > 0) {
+      info_sql.BindInt(column++, offset);
+    }
+  }
+
   while (info_sql.Step()) {
     auto info = ledger::PublisherInfo::New();
     info->id = info_sql.ColumnString(0);
@@ -613,16 +1014,25 @@ bool PublisherInfoDatabase::GetActivityList(
     info->reconcile_stamp = info_sql.ColumnInt64(11);
     info->visits = info_sql.ColumnInt(12);
 
+    if (last) {
+      last->rowid = info_sql.ColumnInt64(13);
+      last->order_values.clear();
+      for (size_t i = 0; i < order_by.size(); i++) {
+        last->order_values.push_back(info_sql.ColumnDouble(14 + i));
+      }
+    }
+
     list->push_back(std::move(info));
   }
 
-  return true;
+  return info_sql.Succeeded();
 }
 
 bool PublisherInfoDatabase::DeleteActivityInfo(
     const std::string& publisher_key,
     uint64_t reconcile_stamp) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -696,6 +1106,7 @@ bool PublisherInfoDatabase::InsertOrUpdateMediaPublisherInfo(
 ledger::PublisherInfoPtr
 PublisherInfoDatabase::GetMediaPublisherInfo(const std::string& media_key) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -731,8 +1142,11 @@ PublisherInfoDatabase::GetMediaPublisherInfo(const std::string& media_key) {
 }
 
 bool PublisherInfoDatabase::GetExcludedList(
+    uint32_t start,
+    uint32_t limit,
     ledger::PublisherInfoList* list) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   CHECK(list);
 
@@ -743,21 +1157,31 @@ bool PublisherInfoDatabase::GetExcludedList(
     return false;
   }
 
-  // We will use every attribute from publisher_info
-  std::string query = "SELECT * FROM publisher_info WHERE excluded = 1";
+  // Ordered by the indexed publisher_id so that pages are stable.
+  std::string query =
+      "SELECT publisher_id, verified, name, favIcon, url, provider "
+      "FROM publisher_info WHERE ";
+  query.append(kExcludedCondition);
+  query.append(" ORDER BY publisher_id");
+
+  if (limit > 0) {
+    query.append(" LIMIT " + std::to_string(limit));
+
+    if (start > 1) {
+      query.append(" OFFSET " + std::to_string(start));
+    }
+  }
 
   sql::Statement info_sql(db_.GetUniqueStatement(query.c_str()));
 
   while (info_sql.Step()) {
-    std::string id(info_sql.ColumnString(0));
-
     auto info = ledger::PublisherInfo::New();
     info->id = info_sql.ColumnString(0);
     info->verified = info_sql.ColumnBool(1);
-    info->name = info_sql.ColumnString(3);
-    info->favicon_url = info_sql.ColumnString(4);
-    info->url = info_sql.ColumnString(5);
-    info->provider = info_sql.ColumnString(9);
+    info->name = info_sql.ColumnString(2);
+    info->favicon_url = info_sql.ColumnString(3);
+    info->url = info_sql.ColumnString(4);
+    info->provider = info_sql.ColumnString(5);
 
     list->push_back(std::move(info));
   }
@@ -765,6 +1189,50 @@ bool PublisherInfoDatabase::GetExcludedList(
   return true;
 }
 
+int PublisherInfoDatabase::GetExcludedPublishersCount() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return 0;
+  }
+
+  std::string query = "SELECT COUNT(*) FROM publisher_info WHERE ";
+  query.append(kExcludedCondition);
+
+  sql::Statement count_sql(db_.GetUniqueStatement(query.c_str()));
+  if (!count_sql.Step()) {
+    return 0;
+  }
+
+  return count_sql.ColumnInt(0);
+}
+
+bool PublisherInfoDatabase::IsExcludedPublisher(
+    const std::string& publisher_id) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized || publisher_id.empty()) {
+    return false;
+  }
+
+  std::string query =
+      "SELECT 1 FROM publisher_info WHERE publisher_id=? AND ";
+  query.append(kExcludedCondition);
+
+  sql::Statement exists_sql(db_.GetUniqueStatement(query.c_str()));
+  exists_sql.BindString(0, publisher_id);
+
+  return exists_sql.Step();
+}
+
 /**
  *
  * RECURRING TIPS
@@ -830,6 +1298,7 @@ bool PublisherInfoDatabase::InsertOrUpdateRecurringTip(
 void PublisherInfoDatabase::GetRecurringTips(
     ledger::PublisherInfoList* list) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -978,6 +1447,7 @@ double PublisherInfoDatabase::GetReservedAmount() {
 void PublisherInfoDatabase::GetPendingContributions(
     ledger::PendingContributionInfoList* list) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   bool initialized = Init();
   DCHECK(initialized);
@@ -1053,6 +1523,215 @@ bool PublisherInfoDatabase::RemoveAllPendingContributions() {
   return statement.Run();
 }
 
+/**
+ *
+ * BALANCE REPORT INFO
+ *
+ */
+
+bool PublisherInfoDatabase::CreateBalanceReportInfoTable() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const char* name = "balance_report_info";
+  if (GetDB().DoesTableExist(name)) {
+    return true;
+  }
+
+  std::string sql;
+  sql.append("CREATE TABLE ");
+  sql.append(name);
+  sql.append(
+      "("
+      "year INTEGER NOT NULL,"
+      "month INTEGER NOT NULL,"
+      "opening_balance TEXT DEFAULT '0' NOT NULL,"
+      "closing_balance TEXT DEFAULT '0' NOT NULL,"
+      "deposits TEXT DEFAULT '0' NOT NULL,"
+      "grants TEXT DEFAULT '0' NOT NULL,"
+      "earning_from_ads TEXT DEFAULT '0' NOT NULL,"
+      "auto_contribute TEXT DEFAULT '0' NOT NULL,"
+      "recurring_donation TEXT DEFAULT '0' NOT NULL,"
+      "one_time_donation TEXT DEFAULT '0' NOT NULL,"
+      "PRIMARY KEY (year, month))");
+
+  return GetDB().Execute(sql.c_str());
+}
+
+bool PublisherInfoDatabase::InsertOrUpdateBalanceReport(
+    ledger::ACTIVITY_MONTH month,
+    int year,
+    const ledger::BalanceReportInfo& info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return false;
+  }
+
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "INSERT INTO balance_report_info "
+      "(year, month, opening_balance, closing_balance, deposits, grants, "
+      "earning_from_ads, auto_contribute, recurring_donation, "
+      "one_time_donation) "
+      "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?) "
+      "ON CONFLICT (year, month) DO UPDATE SET "
+      "opening_balance = excluded.opening_balance, "
+      "closing_balance = excluded.closing_balance, "
+      "deposits = excluded.deposits, "
+      "grants = excluded.grants, "
+      "earning_from_ads = excluded.earning_from_ads, "
+      "auto_contribute = excluded.auto_contribute, "
+      "recurring_donation = excluded.recurring_donation, "
+      "one_time_donation = excluded.one_time_donation"));
+
+  statement.BindInt(0, year);
+  statement.BindInt(1, month);
+  statement.BindString(2, info.opening_balance_);
+  statement.BindString(3, info.closing_balance_);
+  statement.BindString(4, info.deposits_);
+  statement.BindString(5, info.grants_);
+  statement.BindString(6, info.earning_from_ads_);
+  statement.BindString(7, info.auto_contribute_);
+  statement.BindString(8, info.recurring_donation_);
+  statement.BindString(9, info.one_time_donation_);
+
+  return statement.Run();
+}
+
+bool PublisherInfoDatabase::AddBalanceReportItem(
+    ledger::ACTIVITY_MONTH month,
+    int year,
+    ledger::ReportType type,
+    const std::string& probi) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const char* column = GetBalanceReportColumn(type);
+  if (!column || !IsProbi(probi)) {
+    return false;
+  }
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return false;
+  }
+
+  sql::Transaction transaction(&GetDB());
+  if (!transaction.Begin()) {
+    return false;
+  }
+
+  // Amounts can exceed what SQLite's numeric types hold exactly, so they
+  // are stored as decimal strings and added with the ledger's bignum math.
+  const std::string select_sql = base::StringPrintf(
+      "SELECT %s FROM balance_report_info WHERE year = ? AND month = ?",
+      column);
+  sql::Statement select(GetDB().GetUniqueStatement(select_sql.c_str()));
+  select.BindInt(0, year);
+  select.BindInt(1, month);
+  std::string amount = "0";
+  if (select.Step()) {
+    amount = select.ColumnString(0);
+  }
+  if (!select.Succeeded() || !IsProbi(amount)) {
+    return false;
+  }
+  amount = ledger::Ledger::SumProbi(amount, probi);
+
+  const std::string upsert_sql = base::StringPrintf(
+      "INSERT INTO balance_report_info (year, month, %s) VALUES (?, ?, ?) "
+      "ON CONFLICT (year, month) DO UPDATE SET %s = excluded.%s",
+      column, column, column);
+  sql::Statement upsert(GetDB().GetUniqueStatement(upsert_sql.c_str()));
+  upsert.BindInt(0, year);
+  upsert.BindInt(1, month);
+  upsert.BindString(2, amount);
+  if (!upsert.Run()) {
+    return false;
+  }
+
+  return transaction.Commit();
+}
+
+bool PublisherInfoDatabase::GetBalanceReport(ledger::ACTIVITY_MONTH month,
+                                             int year,
+                                             ledger::BalanceReportInfo* info) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(info);
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return false;
+  }
+
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT year, month, opening_balance, closing_balance, deposits, "
+      "grants, earning_from_ads, auto_contribute, recurring_donation, "
+      "one_time_donation "
+      "FROM balance_report_info WHERE year = ? AND month = ?"));
+
+  statement.BindInt(0, year);
+  statement.BindInt(1, month);
+
+  // A month without any transactions has an all zero report.
+  *info = ledger::BalanceReportInfo();
+  if (statement.Step()) {
+    ReadBalanceReport(&statement, info);
+  }
+
+  return statement.Succeeded();
+}
+
+bool PublisherInfoDatabase::GetAllBalanceReports(
+    std::map<std::string, ledger::BalanceReportInfo>* reports) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(reports);
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return false;
+  }
+
+  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
+      "SELECT year, month, opening_balance, closing_balance, deposits, "
+      "grants, earning_from_ads, auto_contribute, recurring_donation, "
+      "one_time_donation "
+      "FROM balance_report_info"));
+
+  while (statement.Step()) {
+    const std::string name =
+        std::to_string(statement.ColumnInt(0)) + "_" +
+        std::to_string(statement.ColumnInt(1));
+    ReadBalanceReport(&statement, &(*reports)[name]);
+  }
+
+  return statement.Succeeded();
+}
+
+bool PublisherInfoDatabase::DeleteAllBalanceReports() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return false;
+  }
+
+  sql::Statement statement(GetDB().GetCachedStatement(
+      SQL_FROM_HERE,
+      "DELETE FROM balance_report_info"));
+
+  return statement.Run();
+}
+
 int PublisherInfoDatabase::GetCurrentVersion() {
   if (testing_current_version_ != -1) {
     return testing_current_version_;
@@ -1067,6 +1746,7 @@ void PublisherInfoDatabase::SetTestingCurrentVersion(int value) {
 
 void PublisherInfoDatabase::Vacuum() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FlushPendingWrites();
 
   if (!initialized_)
     return;
@@ -1076,10 +1756,116 @@ void PublisherInfoDatabase::Vacuum() {
   ignore_result(db_.Execute("VACUUM"));
 }
 
+double PublisherInfoDatabase::GetFreePageRatio() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement page_count(db_.GetUniqueStatement("PRAGMA page_count"));
+  sql::Statement freelist_count(
+      db_.GetUniqueStatement("PRAGMA freelist_count"));
+  if (!page_count.Step() || !freelist_count.Step() ||
+      page_count.ColumnInt64(0) <= 0) {
+    return 0;
+  }
+
+  return static_cast<double>(freelist_count.ColumnInt64(0)) /
+      page_count.ColumnInt64(0);
+}
+
+bool PublisherInfoDatabase::VacuumStep() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  bool initialized = Init();
+  DCHECK(initialized);
+
+  if (!initialized) {
+    return false;
+  }
+
+  const double free_page_ratio = GetFreePageRatio();
+  UMA_HISTOGRAM_PERCENTAGE("Brave.Rewards.DatabaseFreePagePercent",
+                           static_cast<int>(free_page_ratio * 100));
+  if (free_page_ratio < kVacuumFreePageRatio) {
+    return false;
+  }
+
+  sql::Statement auto_vacuum(db_.GetUniqueStatement("PRAGMA auto_vacuum"));
+  if (!auto_vacuum.Step()) {
+    return false;
+  }
+
+  // 2 is INCREMENTAL. Other modes only change with a full VACUUM, which
+  // rewrites the whole file and is too slow to run as a step.
+  if (auto_vacuum.ColumnInt(0) != 2) {
+    return false;
+  }
+
+  const std::string sql = base::StringPrintf("PRAGMA incremental_vacuum(%d)",
+                                             kIncrementalVacuumPages);
+  sql::Statement statement(db_.GetUniqueStatement(sql.c_str()));
+  // Pages are freed one step at a time.
+  while (statement.Step()) {
+  }
+  if (!statement.Succeeded()) {
+    return false;
+  }
+
+  return GetFreePageRatio() > 0;
+}
+
+bool PublisherInfoDatabase::ConfigureDatabase() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Only applies to a database that has no tables yet, or to an existing one
+  // at its next full VACUUM.
+  ignore_result(db_.Execute("PRAGMA auto_vacuum=INCREMENTAL"));
+
+  // Commits append to the write-ahead log instead of syncing a rollback
+  // journal, and reads no longer wait for writes. With WAL, NORMAL sync can
+  // only lose the last commits on power loss, it can't corrupt the database.
+  if (!db_.Execute("PRAGMA journal_mode=WAL") ||
+      !db_.Execute("PRAGMA synchronous=NORMAL")) {
+    LOG(WARNING) << "DB: Could not enable write-ahead logging";
+  }
+
+  const std::string mmap_sql =
+      base::StringPrintf("PRAGMA mmap_size=%" PRId64, mmap_size_);
+  return db_.Execute(mmap_sql.c_str());
+}
+
+void PublisherInfoDatabase::Checkpoint() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // PASSIVE never waits for readers, whatever it can't copy now is copied by
+  // the next checkpoint.
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  ignore_result(db_.Execute("PRAGMA wal_checkpoint(PASSIVE)"));
+  UMA_HISTOGRAM_TIMES("Brave.Rewards.DatabaseCheckpointTime",
+                      base::TimeTicks::Now() - start_time);
+}
+
 void PublisherInfoDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  db_.TrimMemory();
+
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      // Cached pages are cheap to read back through the memory map.
+      db_.TrimMemory();
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      // Queued visit updates are written out early so they stop holding
+      // memory, and the log is folded back so its pages can be dropped too.
+      FlushPendingWrites();
+      Checkpoint();
+      db_.TrimMemory();
+      break;
+  }
+
+  UMA_HISTOGRAM_EXACT_LINEAR(
+      "Brave.Rewards.DatabaseMemoryPressure", memory_pressure_level,
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL + 1);
 }
 
 std::string PublisherInfoDatabase::GetDiagnosticInfo(int extended_error,
@@ -1231,12 +2017,22 @@ bool PublisherInfoDatabase::MigrateV2toV3() {
       "ON pending_contribution (publisher_id)");
 }
 
-bool PublisherInfoDatabase::MigrateV3toV4() {
+bool PublisherInfoDatabase::CopyActivityInfoV3toV4() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  // Activity info
+  // Activity info. |activity_info_old| is only left over when a previous
+  // run was interrupted, in which case the new table is already there.
   const char* name = "activity_info";
-  if (GetDB().DoesTableExist(name)) {
+  if (!GetDB().DoesTableExist("activity_info_old")) {
+    if (!GetDB().DoesTableExist(name)) {
+      return false;
+    }
+
+    sql::Transaction transaction(&GetDB());
+    if (!transaction.Begin()) {
+      return false;
+    }
+
     std::string sql = "ALTER TABLE activity_info RENAME TO activity_info_old;";
     if (!GetDB().Execute(sql.c_str())) {
       return false;
@@ -1276,34 +2072,60 @@ bool PublisherInfoDatabase::MigrateV3toV4() {
       return false;
     }
 
-    std::string columns = "publisher_id, "
-                          "duration, "
-                          "score, "
-                          "percent, "
-                          "weight, "
-                          "month, "
-                          "year, "
-                          "reconcile_stamp";
+    if (!transaction.Commit()) {
+      return false;
+    }
+  }
 
-    sql = "PRAGMA foreign_keys=off;";
-    sql.append("INSERT INTO activity_info (" + columns + ") "
-               "SELECT " + columns + " "
-               "FROM activity_info_old;");
-    sql.append("UPDATE activity_info SET visits=5;");
-    sql.append("DROP TABLE activity_info_old;");
-    sql.append("PRAGMA foreign_keys=on;");
+  // Rows keep their rowid, so the copy carries on after the last row a
+  // previous run got to.
+  const std::string columns = "publisher_id, "
+                              "duration, "
+                              "score, "
+                              "percent, "
+                              "weight, "
+                              "month, "
+                              "year, "
+                              "reconcile_stamp";
+  const std::string copy_sql =
+      "INSERT INTO activity_info (rowid, visits, " + columns + ") "
+      "SELECT rowid, 5, " + columns + " "
+      "FROM activity_info_old "
+      "WHERE rowid > ? "
+      "ORDER BY rowid "
+      "LIMIT ?";
+
+  int copied = 0;
+  do {
+    sql::Transaction transaction(&GetDB());
+    if (!transaction.Begin()) {
+      return false;
+    }
 
-    return GetDB().Execute(sql.c_str());
-  }
+    sql::Statement last_sql(GetDB().GetUniqueStatement(
+        "SELECT IFNULL(MAX(rowid), 0) FROM activity_info"));
+    if (!last_sql.Step()) {
+      return false;
+    }
+
+    sql::Statement statement(GetDB().GetUniqueStatement(copy_sql.c_str()));
+    statement.BindInt64(0, last_sql.ColumnInt64(0));
+    statement.BindInt(1, kMigrationChunkSize);
+    if (!statement.Run()) {
+      return false;
+    }
+    copied = GetDB().GetLastChangeCount();
+
+    if (!transaction.Commit()) {
+      return false;
+    }
+  } while (copied == kMigrationChunkSize);
 
-  return false;
+  return true;
 }
 
 bool PublisherInfoDatabase::MigrateV4toV5() {
-  sql::Transaction transaction(&GetDB());
-  if (!transaction.Begin()) {
-    return false;
-  }
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   sql::Statement info_sql(db_.GetUniqueStatement(
       "SELECT publisher_id, month, year, reconcile_stamp "
@@ -1323,17 +2145,24 @@ bool PublisherInfoDatabase::MigrateV4toV5() {
     statement.Run();
   }
 
-  return transaction.Commit();
+  return true;
 }
 
-bool PublisherInfoDatabase::MigrateV5toV6() {
-  sql::Transaction transaction(&GetDB());
-  if (!transaction.Begin()) {
-    return false;
-  }
+bool PublisherInfoDatabase::CopyActivityInfoV5toV6() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+  // See MigrateV3toV4 for how an interrupted run is picked up.
   const char* name = "activity_info";
-  if (GetDB().DoesTableExist(name)) {
+  if (!GetDB().DoesTableExist("activity_info_old")) {
+    if (!GetDB().DoesTableExist(name)) {
+      return true;
+    }
+
+    sql::Transaction transaction(&GetDB());
+    if (!transaction.Begin()) {
+      return false;
+    }
+
     std::string sql = "ALTER TABLE activity_info RENAME TO activity_info_old;";
     if (!GetDB().Execute(sql.c_str())) {
       return false;
@@ -1344,6 +2173,13 @@ bool PublisherInfoDatabase::MigrateV5toV6() {
       return false;
     }
 
+    // Lets each chunk below start from where the last one ended.
+    sql = "CREATE INDEX activity_info_old_migration_index "
+          "ON activity_info_old (publisher_id, reconcile_stamp);";
+    if (!GetDB().Execute(sql.c_str())) {
+      return false;
+    }
+
     sql = "CREATE TABLE ";
     sql.append(name);
     sql.append(
@@ -1372,38 +2208,118 @@ bool PublisherInfoDatabase::MigrateV5toV6() {
       return false;
     }
 
-    const std::string columns_insert = "publisher_id, "
-                                       "duration, "
-                                       "visits, "
-                                       "score, "
-                                       "percent, "
-                                       "weight, "
-                                       "reconcile_stamp";
-
-    const std::string columns_select = "publisher_id, "
-                                       "sum(duration) as duration, "
-                                       "sum(visits) as visits, "
-                                       "sum(score) as score, "
-                                       "sum(percent) as percent, "
-                                       "sum(weight) as weight, "
-                                       "reconcile_stamp";
-
-    sql = "PRAGMA foreign_keys=off;";
-    sql.append("INSERT INTO activity_info (" + columns_insert + ") "
-               "SELECT " + columns_select + " "
-               "FROM activity_info_old "
-               "GROUP BY publisher_id, reconcile_stamp;");
-    sql.append("DROP TABLE activity_info_old;");
-    sql.append("PRAGMA foreign_keys=on;");
-
-    bool result = GetDB().Execute(sql.c_str());
-
-    if (!result) {
+    if (!transaction.Commit()) {
+      return false;
+    }
+  }
+
+  const std::string columns_insert = "publisher_id, "
+                                     "duration, "
+                                     "visits, "
+                                     "score, "
+                                     "percent, "
+                                     "weight, "
+                                     "reconcile_stamp";
+
+  const std::string columns_select = "publisher_id, "
+                                     "sum(duration) as duration, "
+                                     "sum(visits) as visits, "
+                                     "sum(score) as score, "
+                                     "sum(percent) as percent, "
+                                     "sum(weight) as weight, "
+                                     "reconcile_stamp";
+
+  // Groups are copied in key order, so the last one in |activity_info| is
+  // where the next chunk starts.
+  const std::string copy_sql =
+      "INSERT INTO activity_info (" + columns_insert + ") "
+      "SELECT " + columns_select + " "
+      "FROM activity_info_old "
+      "%s"
+      "GROUP BY publisher_id, reconcile_stamp "
+      "ORDER BY publisher_id, reconcile_stamp "
+      "LIMIT ?";
+  const std::string copy_first_sql = base::StringPrintf(copy_sql.c_str(), "");
+  const std::string copy_next_sql = base::StringPrintf(copy_sql.c_str(),
+      "WHERE (publisher_id, reconcile_stamp) > (?, ?) ");
+
+  int copied = 0;
+  do {
+    sql::Transaction transaction(&GetDB());
+    if (!transaction.Begin()) {
+      return false;
+    }
+
+    sql::Statement last_sql(GetDB().GetUniqueStatement(
+        "SELECT publisher_id, reconcile_stamp FROM activity_info "
+        "ORDER BY publisher_id DESC, reconcile_stamp DESC "
+        "LIMIT 1"));
+
+    sql::Statement statement;
+    if (last_sql.Step()) {
+      statement.Assign(GetDB().GetUniqueStatement(copy_next_sql.c_str()));
+      statement.BindString(0, last_sql.ColumnString(0));
+      statement.BindInt64(1, last_sql.ColumnInt64(1));
+      statement.BindInt(2, kMigrationChunkSize);
+    } else {
+      statement.Assign(GetDB().GetUniqueStatement(copy_first_sql.c_str()));
+      statement.BindInt(0, kMigrationChunkSize);
+    }
+
+    if (!statement.Run()) {
       LOG(ERROR) << "DB: Error with MigrateV5toV6";
+      return false;
     }
+    copied = GetDB().GetLastChangeCount();
+
+    if (!transaction.Commit()) {
+      return false;
+    }
+  } while (copied == kMigrationChunkSize);
+
+  return true;
+}
+
+bool PublisherInfoDatabase::MigrateV3toV4() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return GetDB().Execute("DROP TABLE activity_info_old;");
+}
+
+bool PublisherInfoDatabase::MigrateV5toV6() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Only left over when there was no activity_info to copy.
+  if (!GetDB().DoesTableExist("activity_info_old")) {
+    return true;
   }
 
-  return transaction.Commit();
+  return GetDB().Execute("DROP TABLE activity_info_old;");
+}
+
+bool PublisherInfoDatabase::MigrateV6toV7() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return CreateActivityInfoStampIndex();
+}
+
+bool PublisherInfoDatabase::MigrateV7toV8() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return CreatePublisherInfoExcludedIndex();
+}
+
+bool PublisherInfoDatabase::CopyForMigration(int version) {
+  switch (version) {
+    case 4: {
+      return CopyActivityInfoV3toV4();
+    }
+    case 6: {
+      return CopyActivityInfoV5toV6();
+    }
+    default:
+      return true;
+  }
 }
 
 bool PublisherInfoDatabase::Migrate(int version) {
@@ -1423,6 +2339,12 @@ bool PublisherInfoDatabase::Migrate(int version) {
     case 6: {
       return MigrateV5toV6();
     }
+    case 7: {
+      return MigrateV6toV7();
+    }
+    case 8: {
+      return MigrateV7toV8();
+    }
     default:
       return false;
   }
@@ -1441,17 +2363,31 @@ sql::InitStatus PublisherInfoDatabase::EnsureCurrentVersion() {
   const int current_version = GetCurrentVersion();
   const int start_version = old_version + 1;
 
-  int migrated_version = old_version;
   for (auto i = start_version; i <= current_version; i++) {
+    // Table copies commit a chunk at a time and pick up where an interrupted
+    // run stopped. The rest of the step commits together with its version
+    // number, so no step is ever applied without being recorded.
+    if (!CopyForMigration(i)) {
+      LOG(ERROR) << "DB: Error with MigrateV" << (i - 1) << "toV" << i;
+      break;
+    }
+
+    sql::Transaction transaction(&GetDB());
+    if (!transaction.Begin()) {
+      break;
+    }
+
     if (!Migrate(i)) {
       LOG(ERROR) << "DB: Error with MigrateV" << (i - 1) << "toV" << i;
       break;
     }
 
-    migrated_version = i;
+    meta_table_.SetVersionNumber(i);
+    if (!transaction.Commit()) {
+      break;
+    }
   }
 
-  meta_table_.SetVersionNumber(migrated_version);
   return sql::INIT_OK;
 }
 
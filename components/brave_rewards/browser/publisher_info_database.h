@@ -6,15 +6,22 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_PUBLISHER_INFO_DATABASE_H_
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_PUBLISHER_INFO_DATABASE_H_
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 #include <stddef.h>  // NOLINT
+#include <stdint.h>  // NOLINT
 
 #include "base/compiler_specific.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/sequence_checker.h"
+#include "base/timer/timer.h"
+#include "bat/ledger/balance_report_info.h"
 #include "bat/ledger/publisher_info.h"
 #include "bat/ledger/pending_contribution.h"
 #include "brave/components/brave_rewards/browser/contribution_info.h"
@@ -27,6 +34,22 @@
 
 namespace brave_rewards {
 
+// Position of the last row of a GetActivityList page. Results are ordered by
+// the filter's |order_by| columns and then by activity_info rowid, so the
+// next page can be read with an index seek instead of an OFFSET scan. A
+// default constructed cursor starts at the first row.
+struct ActivityListCursor {
+  ActivityListCursor();
+  ActivityListCursor(const ActivityListCursor& other);
+  ~ActivityListCursor();
+
+  bool is_start() const { return rowid == 0; }
+
+  // Values of the |order_by| columns of the last row, in filter order.
+  std::vector<double> order_values;
+  int64_t rowid = 0;
+};
+
 class PublisherInfoDatabase {
  public:
   explicit PublisherInfoDatabase(const base::FilePath& db_path);
@@ -58,12 +81,43 @@ class PublisherInfoDatabase {
 
   bool InsertOrUpdateActivityInfos(const ledger::PublisherInfoList& list);
 
+  // Stores the score, percent and weight computed by normalizing the
+  // activity list. Only those columns are written, and only for rows where
+  // they changed, so visit counts recorded meanwhile are kept.
+  bool UpdateActivityInfoShares(const ledger::PublisherInfoList& list);
+
+  // Write-behind variants of InsertOrUpdatePublisherInfo and
+  // InsertOrUpdateActivityInfo for visit updates. Updates to the same
+  // publisher (and reconcile stamp) are coalesced in memory and written in a
+  // single transaction on a timer, before any read of the affected tables
+  // and on destruction.
+  void QueuePublisherInfo(const ledger::PublisherInfo& info);
+  void QueueActivityInfo(const ledger::PublisherInfo& info);
+  bool FlushPendingWrites();
+
   bool GetActivityList(int start,
                        int limit,
                        const ledger::ActivityInfoFilter& filter,
                        ledger::PublisherInfoList* list);
 
-  bool GetExcludedList(ledger::PublisherInfoList* list);
+  // Reads up to |limit| rows after |after| and sets |next| to the position of
+  // the last row read. The filter's |order_by| may only name numeric
+  // activity_info columns.
+  bool GetActivityList(const ledger::ActivityInfoFilter& filter,
+                       int limit,
+                       const ActivityListCursor& after,
+                       ledger::PublisherInfoList* list,
+                       ActivityListCursor* next);
+
+  // Reads |limit| excluded publishers from |start|, or all of them when
+  // |limit| is 0. Only the columns shown in the excluded sites list are read.
+  bool GetExcludedList(uint32_t start,
+                       uint32_t limit,
+                       ledger::PublisherInfoList* list);
+
+  // Both only read publisher_info_excluded_index.
+  int GetExcludedPublishersCount();
+  bool IsExcludedPublisher(const std::string& publisher_id);
 
   bool InsertOrUpdateMediaPublisherInfo(const std::string& media_key,
                                         const std::string& publisher_id);
@@ -91,6 +145,28 @@ class PublisherInfoDatabase {
 
   bool RemoveAllPendingContributions();
 
+  // Balance reports are stored one row per month. Amounts are decimal probi
+  // strings.
+  bool InsertOrUpdateBalanceReport(ledger::ACTIVITY_MONTH month,
+                                   int year,
+                                   const ledger::BalanceReportInfo& info);
+
+  // Adds |probi| to the amount of |type| in the month's report.
+  bool AddBalanceReportItem(ledger::ACTIVITY_MONTH month,
+                            int year,
+                            ledger::ReportType type,
+                            const std::string& probi);
+
+  bool GetBalanceReport(ledger::ACTIVITY_MONTH month,
+                        int year,
+                        ledger::BalanceReportInfo* info);
+
+  // Keyed by "<year>_<month>".
+  bool GetAllBalanceReports(
+      std::map<std::string, ledger::BalanceReportInfo>* reports);
+
+  bool DeleteAllBalanceReports();
+
   // Returns the current version of the publisher info database
   int GetCurrentVersion();
 
@@ -103,12 +179,25 @@ class PublisherInfoDatabase {
   // unused space in the file. It can be VERY SLOW.
   void Vacuum();
 
+  // Frees a bounded number of pages once enough of the file is unused, so no
+  // single call holds the database for long. Does nothing on a database
+  // created before incremental vacuum was turned on. Returns true if more
+  // pages are left to free.
+  bool VacuumStep();
+
+  // Share of the file's pages that are unused, between 0 and 1.
+  double GetFreePageRatio();
+
   std::string GetDiagnosticInfo(int extended_error, sql::Statement* statement);
 
   sql::Database& GetDB();
 
   bool Init();
 
+  // Size of the memory map SQLite reads the database through, 0 disables
+  // memory mapped I/O. Must be called before the database is first used.
+  void set_mmap_size(int64_t mmap_size) { mmap_size_ = mmap_size; }
+
   int GetTableVersionNumber();
 
   std::string GetSchema();
@@ -120,10 +209,21 @@ class PublisherInfoDatabase {
 
   bool CreatePublisherInfoTable();
 
+  bool CreatePublisherInfoExcludedIndex();
+
   bool CreateActivityInfoTable();
 
   bool CreateActivityInfoIndex();
 
+  bool CreateActivityInfoStampIndex();
+
+  bool QueryActivityList(const ledger::ActivityInfoFilter& filter,
+                         int limit,
+                         int offset,
+                         const ActivityListCursor* after,
+                         ledger::PublisherInfoList* list,
+                         ActivityListCursor* last);
+
   bool CreateMediaPublisherInfoTable();
 
   bool CreateRecurringTipsTable();
@@ -134,6 +234,22 @@ class PublisherInfoDatabase {
 
   bool CreatePendingContributionsIndex();
 
+  bool CreateBalanceReportInfoTable();
+
+  bool WritePublisherInfo(const ledger::PublisherInfo& info);
+
+  bool WriteActivityInfo(const ledger::PublisherInfo& info);
+
+  // Writes the activity_info row only.
+  bool WriteActivityRow(const ledger::PublisherInfo& info);
+
+  template <typename Key>
+  void QueuePendingWrite(std::map<Key, ledger::PublisherInfoPtr>* pending,
+                         const Key& key,
+                         const ledger::PublisherInfo& info);
+
+  bool ConfigureDatabase();
+  void Checkpoint();
   void OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
@@ -143,23 +259,47 @@ class PublisherInfoDatabase {
 
   bool MigrateV2toV3();
 
+  bool CopyActivityInfoV3toV4();
+
   bool MigrateV3toV4();
 
   bool MigrateV4toV5();
 
+  bool CopyActivityInfoV5toV6();
+
   bool MigrateV5toV6();
 
+  bool MigrateV6toV7();
+
+  bool MigrateV7toV8();
+
+  // Runs the parts of the migration to |version| that commit as they go.
+  bool CopyForMigration(int version);
+
   bool Migrate(int version);
 
   sql::InitStatus EnsureCurrentVersion();
 
+  // GetActivityList query text per filter shape. The statements are kept in
+  // |db_|'s statement cache keyed by these strings, so this must outlive it.
+  std::set<std::string> activity_list_queries_;
+
   sql::Database db_;
   sql::MetaTable meta_table_;
   const base::FilePath db_path_;
   bool initialized_;
   int testing_current_version_;
+  int64_t mmap_size_;
 
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+  base::RepeatingTimer checkpoint_timer_;
+
+  // Keyed by publisher id.
+  std::map<std::string, ledger::PublisherInfoPtr> pending_publisher_info_;
+  // Keyed by (publisher id, reconcile stamp).
+  std::map<std::pair<std::string, uint64_t>, ledger::PublisherInfoPtr>
+      pending_activity_info_;
+  base::OneShotTimer flush_timer_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(PublisherInfoDatabase);
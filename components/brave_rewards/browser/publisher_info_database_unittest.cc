@@ -7,6 +7,7 @@
 #include <streambuf>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "brave/components/brave_rewards/browser/publisher_info_database.h"
 
@@ -17,6 +18,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/test/scoped_task_environment.h"
 #include "brave/common/brave_paths.h"
 #include "sql/database.h"
 #include "sql/statement.h"
@@ -136,9 +138,72 @@ class PublisherInfoDatabaseTest : public ::testing::Test {
     return data;
   }
 
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
   std::unique_ptr<PublisherInfoDatabase> publisher_info_database_;
 };
 
+TEST_F(PublisherInfoDatabaseTest, UsesWriteAheadLog) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+  publisher_info_database_->set_mmap_size(1024 * 1024);
+  ASSERT_TRUE(publisher_info_database_->Init());
+
+  sql::Statement journal_mode(GetDB().GetUniqueStatement(
+      "PRAGMA journal_mode"));
+  ASSERT_TRUE(journal_mode.Step());
+  EXPECT_EQ(journal_mode.ColumnString(0), "wal");
+
+  sql::Statement mmap_size(GetDB().GetUniqueStatement("PRAGMA mmap_size"));
+  ASSERT_TRUE(mmap_size.Step());
+  EXPECT_EQ(mmap_size.ColumnInt64(0), 1024 * 1024);
+}
+
+TEST_F(PublisherInfoDatabaseTest, VacuumStepFreesPages) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+  ASSERT_TRUE(publisher_info_database_->Init());
+
+  ASSERT_TRUE(GetDB().Execute("CREATE TABLE filler (data BLOB)"));
+  for (int i = 0; i < 200; i++) {
+    ASSERT_TRUE(GetDB().Execute(
+        "INSERT INTO filler VALUES (zeroblob(4096))"));
+  }
+  ASSERT_TRUE(GetDB().Execute("DELETE FROM filler"));
+
+  const double free_page_ratio = publisher_info_database_->GetFreePageRatio();
+  EXPECT_GT(free_page_ratio, 0.1);
+
+  while (publisher_info_database_->VacuumStep()) {
+  }
+
+  EXPECT_LT(publisher_info_database_->GetFreePageRatio(), free_page_ratio);
+}
+
+TEST_F(PublisherInfoDatabaseTest, VacuumStepSkipsNonIncrementalDatabase) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+  ASSERT_TRUE(publisher_info_database_->Init());
+
+  ASSERT_TRUE(GetDB().Execute("PRAGMA auto_vacuum=NONE"));
+  ASSERT_TRUE(GetDB().Execute("VACUUM"));
+
+  ASSERT_TRUE(GetDB().Execute("CREATE TABLE filler (data BLOB)"));
+  for (int i = 0; i < 200; i++) {
+    ASSERT_TRUE(GetDB().Execute(
+        "INSERT INTO filler VALUES (zeroblob(4096))"));
+  }
+  ASSERT_TRUE(GetDB().Execute("DELETE FROM filler"));
+
+  const double free_page_ratio = publisher_info_database_->GetFreePageRatio();
+  EXPECT_GT(free_page_ratio, 0.1);
+
+  EXPECT_FALSE(publisher_info_database_->VacuumStep());
+  EXPECT_EQ(publisher_info_database_->GetFreePageRatio(), free_page_ratio);
+}
+
 TEST_F(PublisherInfoDatabaseTest, InsertContributionInfo) {
   /**
    * Good path
@@ -381,6 +446,75 @@ TEST_F(PublisherInfoDatabaseTest, InsertOrUpdateActivityInfo) {
             info.reconcile_stamp);
 }
 
+TEST_F(PublisherInfoDatabaseTest, QueueActivityInfo) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  ledger::PublisherInfo info;
+  info.id = "brave.com";
+  info.name = "brave.com";
+  info.url = "https://brave.com";
+  info.favicon_url = "favicon.ico";
+  info.duration = 10;
+  info.visits = 1;
+  info.reconcile_stamp = 1;
+  publisher_info_database_->QueueActivityInfo(info);
+
+  // Nothing is written until the queue is flushed.
+  EXPECT_EQ(CountTableRows("activity_info"), 0);
+  EXPECT_EQ(CountTableRows("publisher_info"), 0);
+
+  // Later updates replace the queued row but keep the favicon when none is
+  // given.
+  info.favicon_url = "";
+  info.duration = 20;
+  info.visits = 2;
+  publisher_info_database_->QueueActivityInfo(info);
+
+  // Reads see queued writes.
+  ledger::PublisherInfoPtr publisher =
+      publisher_info_database_->GetPublisherInfo(info.id);
+  ASSERT_TRUE(publisher);
+  EXPECT_EQ(publisher->favicon_url, "favicon.ico");
+  EXPECT_EQ(CountTableRows("activity_info"), 1);
+  EXPECT_EQ(CountTableRows("publisher_info"), 1);
+
+  std::string query = "SELECT duration, visits FROM activity_info "
+      "WHERE publisher_id=?";
+  sql::Statement info_sql(GetDB().GetUniqueStatement(query.c_str()));
+  info_sql.BindString(0, info.id);
+  EXPECT_TRUE(info_sql.Step());
+  EXPECT_EQ(static_cast<uint64_t>(info_sql.ColumnInt64(0)), 20u);
+  EXPECT_EQ(info_sql.ColumnInt64(1), 2);
+
+  // Flushing an empty queue is a no-op.
+  EXPECT_TRUE(publisher_info_database_->FlushPendingWrites());
+}
+
+TEST_F(PublisherInfoDatabaseTest, GetMediaPublisherInfoSeesQueuedWrites) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  ledger::PublisherInfo info;
+  info.id = "youtube#channel:brave";
+  info.name = "Brave";
+  info.url = "https://www.youtube.com/channel/brave";
+  info.provider = "youtube";
+  publisher_info_database_->QueuePublisherInfo(info);
+
+  EXPECT_TRUE(publisher_info_database_->InsertOrUpdateMediaPublisherInfo(
+      "youtube_brave", info.id));
+
+  ledger::PublisherInfoPtr publisher =
+      publisher_info_database_->GetMediaPublisherInfo("youtube_brave");
+  ASSERT_TRUE(publisher);
+  EXPECT_EQ(publisher->id, info.id);
+  EXPECT_EQ(publisher->name, info.name);
+  EXPECT_EQ(publisher->provider, info.provider);
+}
+
 TEST_F(PublisherInfoDatabaseTest, InsertOrUpdateMediaPublisherInfo) {
   /**
    * Good path
@@ -616,6 +750,54 @@ TEST_F(PublisherInfoDatabaseTest, InsertOrUpdateActivityInfos) {
   EXPECT_FALSE(success);
 }
 
+TEST_F(PublisherInfoDatabaseTest, UpdateActivityInfoShares) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  ledger::PublisherInfo info;
+  info.id = "brave.com";
+  info.url = "https://brave.com";
+  info.duration = 10;
+  info.score = 1.1;
+  info.percent = 100;
+  info.weight = 100;
+  info.reconcile_stamp = 10;
+  info.visits = 1;
+  EXPECT_TRUE(publisher_info_database_->InsertOrUpdateActivityInfo(info));
+
+  // A visit recorded after the list was read for normalizing.
+  info.visits = 2;
+  EXPECT_TRUE(publisher_info_database_->InsertOrUpdateActivityInfo(info));
+
+  auto normalized = info.Clone();
+  normalized->visits = 1;
+  normalized->percent = 40;
+  normalized->weight = 40.5;
+
+  auto other_stamp = info.Clone();
+  other_stamp->reconcile_stamp = 9;
+  other_stamp->percent = 60;
+
+  ledger::PublisherInfoList list;
+  list.push_back(std::move(normalized));
+  list.push_back(std::move(other_stamp));
+  EXPECT_TRUE(publisher_info_database_->UpdateActivityInfoShares(list));
+
+  std::string query = "SELECT * FROM activity_info WHERE publisher_id=?";
+  sql::Statement info_sql(GetDB().GetUniqueStatement(query.c_str()));
+  info_sql.BindString(0, info.id);
+
+  EXPECT_TRUE(info_sql.Step());
+  EXPECT_EQ(CountTableRows("activity_info"), 1);
+  EXPECT_EQ(info_sql.ColumnInt64(2), 2);
+  EXPECT_EQ(info_sql.ColumnInt64(4), 40);
+  EXPECT_EQ(info_sql.ColumnDouble(5), 40.5);
+
+  ledger::PublisherInfoList list_empty;
+  EXPECT_FALSE(publisher_info_database_->UpdateActivityInfoShares(list_empty));
+}
+
 TEST_F(PublisherInfoDatabaseTest, InsertPendingContribution) {
   /**
    * Good path
@@ -920,6 +1102,142 @@ TEST_F(PublisherInfoDatabaseTest, Migrationv4tov6) {
   EXPECT_EQ(publisher_info_database_->GetTableVersionNumber(), 6);
 }
 
+TEST_F(PublisherInfoDatabaseTest, Migrationv5tov7) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateMigrationDatabase(&temp_dir, &db_file, 5, 7);
+
+  ledger::PublisherInfoList list;
+  ledger::ActivityInfoFilter filter;
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0, 0, filter, &list));
+  EXPECT_EQ(static_cast<int>(list.size()), 3);
+  EXPECT_EQ(publisher_info_database_->GetTableVersionNumber(), 7);
+
+  const std::string schema = publisher_info_database_->GetSchema();
+  EXPECT_EQ(schema, GetSchemaString(7));
+}
+
+TEST_F(PublisherInfoDatabaseTest, Migrationv5tov8) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateMigrationDatabase(&temp_dir, &db_file, 5, 8);
+
+  ledger::PublisherInfoList list;
+  ledger::ActivityInfoFilter filter;
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(0, 0, filter, &list));
+  EXPECT_EQ(static_cast<int>(list.size()), 3);
+  EXPECT_EQ(publisher_info_database_->GetTableVersionNumber(), 8);
+
+  const std::string schema = publisher_info_database_->GetSchema();
+  EXPECT_EQ(schema, GetSchemaString(8));
+}
+
+TEST_F(PublisherInfoDatabaseTest, GetExcludedPublishers) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  const ledger::PUBLISHER_EXCLUDE excluded[] = {
+    ledger::PUBLISHER_EXCLUDE::EXCLUDED,
+    ledger::PUBLISHER_EXCLUDE::DEFAULT,
+    ledger::PUBLISHER_EXCLUDE::EXCLUDED,
+    ledger::PUBLISHER_EXCLUDE::INCLUDED,
+    ledger::PUBLISHER_EXCLUDE::EXCLUDED,
+  };
+
+  for (size_t i = 0; i < arraysize(excluded); i++) {
+    ledger::PublisherInfo info;
+    info.id = "publisher_" + std::to_string(i + 1);
+    info.name = "publisher_name_" + std::to_string(i + 1);
+    info.url = "https://publisher" + std::to_string(i + 1) + ".com";
+    info.excluded = excluded[i];
+    // Queued, so the queries below have to flush it first.
+    publisher_info_database_->QueuePublisherInfo(info);
+  }
+
+  EXPECT_EQ(publisher_info_database_->GetExcludedPublishersCount(), 3);
+  EXPECT_TRUE(publisher_info_database_->IsExcludedPublisher("publisher_1"));
+  EXPECT_FALSE(publisher_info_database_->IsExcludedPublisher("publisher_2"));
+  EXPECT_FALSE(publisher_info_database_->IsExcludedPublisher("publisher_4"));
+  EXPECT_FALSE(publisher_info_database_->IsExcludedPublisher("unknown"));
+
+  ledger::PublisherInfoList list;
+  EXPECT_TRUE(publisher_info_database_->GetExcludedList(0, 0, &list));
+  ASSERT_EQ(list.size(), 3u);
+  EXPECT_EQ(list.at(0)->id, "publisher_1");
+  EXPECT_EQ(list.at(0)->name, "publisher_name_1");
+  EXPECT_EQ(list.at(1)->id, "publisher_3");
+  EXPECT_EQ(list.at(2)->id, "publisher_5");
+
+  list.clear();
+  EXPECT_TRUE(publisher_info_database_->GetExcludedList(0, 2, &list));
+  ASSERT_EQ(list.size(), 2u);
+  EXPECT_EQ(list.at(1)->id, "publisher_3");
+
+  EXPECT_TRUE(publisher_info_database_->RestorePublishers());
+  EXPECT_EQ(publisher_info_database_->GetExcludedPublishersCount(), 0);
+  EXPECT_FALSE(publisher_info_database_->IsExcludedPublisher("publisher_1"));
+}
+
+TEST_F(PublisherInfoDatabaseTest, GetActivityListKeyset) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  const uint32_t percents[] = {10, 30, 30, 20, 10};
+  for (size_t i = 0; i < arraysize(percents); i++) {
+    ledger::PublisherInfo info;
+    info.id = "publisher_" + std::to_string(i + 1);
+    info.name = info.id;
+    info.url = "https://" + info.id + ".com";
+    info.excluded = ledger::PUBLISHER_EXCLUDE::DEFAULT;
+    info.percent = percents[i];
+    info.reconcile_stamp = 1;
+    EXPECT_TRUE(publisher_info_database_->InsertOrUpdateActivityInfo(info));
+  }
+
+  ledger::ActivityInfoFilter filter;
+  filter.excluded = ledger::EXCLUDE_FILTER::FILTER_ALL;
+  filter.reconcile_stamp = 1;
+  filter.order_by.push_back(std::make_pair("ai.percent", false));
+
+  // Ties on percent are broken by insertion order.
+  const std::vector<std::string> expected = {
+      "publisher_2", "publisher_3", "publisher_4", "publisher_1",
+      "publisher_5"};
+
+  std::vector<std::string> ids;
+  ActivityListCursor cursor;
+  for (int page = 0; page < 3; page++) {
+    ledger::PublisherInfoList list;
+    ActivityListCursor next;
+    EXPECT_TRUE(publisher_info_database_->GetActivityList(
+        filter, 2, cursor, &list, &next));
+    EXPECT_EQ(list.size(), page < 2 ? 2u : 1u);
+    for (const auto& info : list) {
+      ids.push_back(info->id);
+    }
+    cursor = next;
+  }
+  EXPECT_EQ(ids, expected);
+
+  // Past the end the cursor stays put.
+  ledger::PublisherInfoList list;
+  ActivityListCursor next;
+  EXPECT_TRUE(publisher_info_database_->GetActivityList(
+      filter, 2, cursor, &list, &next));
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(next.rowid, cursor.rowid);
+
+  // Only activity columns can be paged by.
+  filter.order_by.clear();
+  filter.order_by.push_back(std::make_pair("pi.name", true));
+  EXPECT_FALSE(publisher_info_database_->GetActivityList(
+      filter, 2, ActivityListCursor(), &list, &next));
+}
+
 TEST_F(PublisherInfoDatabaseTest, DeleteActivityInfo) {
   base::ScopedTempDir temp_dir;
   base::FilePath db_file;
@@ -1117,4 +1435,69 @@ TEST_F(PublisherInfoDatabaseTest, RemoveAllPendingContributions) {
   EXPECT_EQ(CountTableRows("pending_contribution"), 0);
 }
 
+TEST_F(PublisherInfoDatabaseTest, AddBalanceReportItem) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  ledger::BalanceReportInfo info;
+  EXPECT_TRUE(publisher_info_database_->GetBalanceReport(
+      ledger::ACTIVITY_MONTH::MAY, 2019, &info));
+  EXPECT_EQ(info.grants_, "0");
+  EXPECT_EQ(CountTableRows("balance_report_info"), 0);
+
+  EXPECT_TRUE(publisher_info_database_->AddBalanceReportItem(
+      ledger::ACTIVITY_MONTH::MAY, 2019, ledger::ReportType::GRANT,
+      "10000000000000000000"));
+  EXPECT_TRUE(publisher_info_database_->AddBalanceReportItem(
+      ledger::ACTIVITY_MONTH::MAY, 2019, ledger::ReportType::GRANT,
+      "99999999999999999999"));
+  EXPECT_TRUE(publisher_info_database_->AddBalanceReportItem(
+      ledger::ACTIVITY_MONTH::MAY, 2019, ledger::ReportType::TIP,
+      "5000000000000000000"));
+  EXPECT_TRUE(publisher_info_database_->AddBalanceReportItem(
+      ledger::ACTIVITY_MONTH::JUNE, 2019, ledger::ReportType::ADS,
+      "1"));
+  EXPECT_FALSE(publisher_info_database_->AddBalanceReportItem(
+      ledger::ACTIVITY_MONTH::JUNE, 2019, ledger::ReportType::ADS,
+      "-1"));
+
+  EXPECT_TRUE(publisher_info_database_->GetBalanceReport(
+      ledger::ACTIVITY_MONTH::MAY, 2019, &info));
+  EXPECT_EQ(info.grants_, "109999999999999999999");
+  EXPECT_EQ(info.one_time_donation_, "5000000000000000000");
+  EXPECT_EQ(info.earning_from_ads_, "0");
+
+  std::map<std::string, ledger::BalanceReportInfo> reports;
+  EXPECT_TRUE(publisher_info_database_->GetAllBalanceReports(&reports));
+  EXPECT_EQ(reports.size(), 2u);
+  EXPECT_EQ(reports["2019_5"].grants_, "109999999999999999999");
+  EXPECT_EQ(reports["2019_6"].earning_from_ads_, "1");
+
+  EXPECT_TRUE(publisher_info_database_->DeleteAllBalanceReports());
+  EXPECT_EQ(CountTableRows("balance_report_info"), 0);
+}
+
+TEST_F(PublisherInfoDatabaseTest, InsertOrUpdateBalanceReport) {
+  base::ScopedTempDir temp_dir;
+  base::FilePath db_file;
+  CreateTempDatabase(&temp_dir, &db_file);
+
+  ledger::BalanceReportInfo info;
+  info.grants_ = "10";
+  info.auto_contribute_ = "5";
+  EXPECT_TRUE(publisher_info_database_->InsertOrUpdateBalanceReport(
+      ledger::ACTIVITY_MONTH::MAY, 2019, info));
+  info.grants_ = "20";
+  EXPECT_TRUE(publisher_info_database_->InsertOrUpdateBalanceReport(
+      ledger::ACTIVITY_MONTH::MAY, 2019, info));
+  EXPECT_EQ(CountTableRows("balance_report_info"), 1);
+
+  ledger::BalanceReportInfo stored;
+  EXPECT_TRUE(publisher_info_database_->GetBalanceReport(
+      ledger::ACTIVITY_MONTH::MAY, 2019, &stored));
+  EXPECT_EQ(stored.grants_, "20");
+  EXPECT_EQ(stored.auto_contribute_, "5");
+}
+
 }  // namespace brave_rewards
@@ -10,6 +10,7 @@
 #include <string>
 
 #include "brave/components/brave_rewards/browser/reconcile_info.h"
+#include "brave/components/brave_rewards/browser/rewards_perf_stats.h"
 
 namespace brave_rewards {
 
@@ -25,6 +26,7 @@ struct RewardsInternalsInfo {
   uint64_t boot_stamp;
 
   std::map<std::string, ReconcileInfo> current_reconciles;
+  RewardsPerfStats::EntryMap perf_stats;
 };
 
 }  // namespace brave_rewards
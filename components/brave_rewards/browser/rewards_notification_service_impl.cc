@@ -37,7 +37,6 @@ RewardsNotificationServiceImpl::RewardsNotificationServiceImpl(Profile* profile)
               (profile);
   AddObserver(extension_rewards_notification_service_observer_.get());
 #endif
-  ReadRewardsNotificationsJSON();
 }
 
 RewardsNotificationServiceImpl::~RewardsNotificationServiceImpl() {
@@ -53,6 +52,7 @@ void RewardsNotificationServiceImpl::AddNotification(
     RewardsNotificationID id,
     bool only_once) {
   DCHECK(type != REWARDS_NOTIFICATION_INVALID);
+  EnsureLoaded();
   if (id.empty()) {
     id = GenerateRewardsNotificationID();
   } else if (only_once) {
@@ -67,6 +67,7 @@ void RewardsNotificationServiceImpl::AddNotification(
   RewardsNotification rewards_notification(
       id, type, GenerateRewardsNotificationTimestamp(), std::move(args));
   rewards_notifications_[id] = rewards_notification;
+  dirty_ = true;
   OnNotificationAdded(rewards_notification);
 
   if (only_once) {
@@ -77,6 +78,7 @@ void RewardsNotificationServiceImpl::AddNotification(
 void RewardsNotificationServiceImpl::DeleteNotification(
     RewardsNotificationID id) {
   DCHECK(!id.empty());
+  EnsureLoaded();
   RewardsNotification rewards_notification;
   if (rewards_notifications_.find(id) == rewards_notifications_.end()) {
     rewards_notification.id_ = id;
@@ -86,27 +88,34 @@ void RewardsNotificationServiceImpl::DeleteNotification(
     // clean up, so that we don't have long standing notifications
     if (rewards_notifications_.size() == 1) {
       rewards_notifications_.clear();
+      dirty_ = true;
     }
   } else {
     rewards_notification = rewards_notifications_[id];
     rewards_notifications_.erase(id);
+    dirty_ = true;
   }
   OnNotificationDeleted(rewards_notification);
 }
 
 void RewardsNotificationServiceImpl::DeleteAllNotifications() {
+  EnsureLoaded();
+  if (!rewards_notifications_.empty())
+    dirty_ = true;
   rewards_notifications_.clear();
   OnAllNotificationsDeleted();
 }
 
 void RewardsNotificationServiceImpl::GetNotification(RewardsNotificationID id) {
   DCHECK(!id.empty());
+  EnsureLoaded();
   if (rewards_notifications_.find(id) == rewards_notifications_.end())
     return;
   OnGetNotification(rewards_notifications_[id]);
 }
 
 void RewardsNotificationServiceImpl::GetNotifications() {
+  EnsureLoaded();
   RewardsNotificationsList rewards_notifications_list;
   for (auto& item : rewards_notifications_) {
     rewards_notifications_list.push_back(item.second);
@@ -116,6 +125,7 @@ void RewardsNotificationServiceImpl::GetNotifications() {
 
 const RewardsNotificationService::RewardsNotificationsMap&
 RewardsNotificationServiceImpl::GetAllNotifications() const {
+  EnsureLoaded();
   return rewards_notifications_;
 }
 
@@ -130,7 +140,17 @@ RewardsNotificationServiceImpl::GenerateRewardsNotificationTimestamp() const {
   return base::Time::NowFromSystemTime().ToTimeT();
 }
 
+void RewardsNotificationServiceImpl::EnsureLoaded() const {
+  if (!loaded_)
+    LoadRewardsNotifications();
+}
+
 void RewardsNotificationServiceImpl::ReadRewardsNotificationsJSON() {
+  LoadRewardsNotifications();
+}
+
+void RewardsNotificationServiceImpl::LoadRewardsNotifications() const {
+  loaded_ = true;
   std::string json =
       profile_->GetPrefs()->GetString(prefs::kRewardsNotifications);
   if (json.empty())
@@ -146,6 +166,8 @@ void RewardsNotificationServiceImpl::ReadRewardsNotificationsJSON() {
     }
 
     ReadRewardsNotifications(list->GetList());
+    // Rewrite in the current format on shutdown
+    dirty_ = true;
     return;
   }
 
@@ -165,7 +187,7 @@ void RewardsNotificationServiceImpl::ReadRewardsNotificationsJSON() {
 }
 
 void RewardsNotificationServiceImpl::ReadRewardsNotifications(
-    const base::Value::ListStorage& root) {
+    const base::Value::ListStorage& root) const {
   for (auto it = root.cbegin(); it != root.cend(); ++it) {
     if (!it->is_dict())
       continue;
@@ -208,6 +230,9 @@ void RewardsNotificationServiceImpl::ReadRewardsNotifications(
 }
 
 void RewardsNotificationServiceImpl::StoreRewardsNotifications() {
+  if (!dirty_)
+    return;
+
   base::DictionaryValue root;
 
   auto notifications = std::make_unique<base::ListValue>();
@@ -239,6 +264,7 @@ void RewardsNotificationServiceImpl::StoreRewardsNotifications() {
   }
 
   profile_->GetPrefs()->SetString(prefs::kRewardsNotifications, result);
+  dirty_ = false;
 }
 
 void RewardsNotificationServiceImpl::TriggerOnNotificationAdded(
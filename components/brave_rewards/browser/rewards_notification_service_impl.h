@@ -40,7 +40,7 @@ class RewardsNotificationServiceImpl
   const RewardsNotificationsMap& GetAllNotifications() const override;
 
   void ReadRewardsNotificationsJSON() override;
-  void ReadRewardsNotifications(const base::Value::ListStorage& root);
+  void ReadRewardsNotifications(const base::Value::ListStorage& root) const;
   void StoreRewardsNotifications() override;
 
  private:
@@ -77,12 +77,21 @@ class RewardsNotificationServiceImpl
   void OnGetAllNotifications(
       const RewardsNotificationsList& rewards_notifications_list);
 
+  // Notifications are read from prefs the first time they are needed, so
+  // sessions that never show or change one skip parsing them.
+  void EnsureLoaded() const;
+  void LoadRewardsNotifications() const;
+
   RewardsNotificationID GenerateRewardsNotificationID() const;
   RewardsNotificationTimestamp GenerateRewardsNotificationTimestamp() const;
 
   Profile* profile_;
-  RewardsNotificationsMap rewards_notifications_;
-  std::vector<RewardsNotificationID> rewards_notifications_displayed_;
+  // Loaded lazily, including from const accessors.
+  mutable RewardsNotificationsMap rewards_notifications_;
+  mutable std::vector<RewardsNotificationID> rewards_notifications_displayed_;
+  mutable bool loaded_ = false;
+  // Set when the stored notifications no longer match the ones in memory.
+  mutable bool dirty_ = false;
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   std::unique_ptr<ExtensionRewardsNotificationServiceObserver>
       extension_rewards_notification_service_observer_;
@@ -0,0 +1,81 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/rewards_perf_stats.h"
+
+#include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+
+namespace brave_rewards {
+
+namespace {
+
+std::string GetCategoryName(RewardsPerfStats::Category category) {
+  switch (category) {
+    case RewardsPerfStats::DATABASE:
+      return "Database";
+    case RewardsPerfStats::STATE:
+      return "State";
+    case RewardsPerfStats::MOJO:
+      return "Mojo";
+    case RewardsPerfStats::NETWORK:
+      return "Network";
+  }
+  NOTREACHED();
+  return std::string();
+}
+
+// Histograms are per category rather than per operation, since network
+// endpoints are only known at runtime.
+void RecordHistogram(RewardsPerfStats::Category category,
+                     base::TimeDelta elapsed) {
+  switch (category) {
+    case RewardsPerfStats::DATABASE:
+      UMA_HISTOGRAM_TIMES("Brave.Rewards.DatabaseTime", elapsed);
+      break;
+    case RewardsPerfStats::STATE:
+      UMA_HISTOGRAM_TIMES("Brave.Rewards.StateTime", elapsed);
+      break;
+    case RewardsPerfStats::MOJO:
+      UMA_HISTOGRAM_TIMES("Brave.Rewards.LedgerCallTime", elapsed);
+      break;
+    case RewardsPerfStats::NETWORK:
+      UMA_HISTOGRAM_MEDIUM_TIMES("Brave.Rewards.NetworkTime", elapsed);
+      break;
+  }
+}
+
+}  // namespace
+
+RewardsPerfStats::Entry::Entry() : count(0) {
+}
+
+RewardsPerfStats::Entry::~Entry() {
+}
+
+RewardsPerfStats::RewardsPerfStats() : weak_ptr_factory_(this) {
+}
+
+RewardsPerfStats::~RewardsPerfStats() {
+}
+
+void RewardsPerfStats::Record(Category category,
+                              const std::string& name,
+                              base::TimeDelta elapsed) {
+  RecordHistogram(category, elapsed);
+
+  Entry& entry = entries_[GetCategoryName(category) + "." + name];
+  entry.count++;
+  entry.total += elapsed;
+  entry.last = elapsed;
+  if (elapsed > entry.max)
+    entry.max = elapsed;
+}
+
+void RewardsPerfStats::Reset() {
+  entries_.clear();
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,98 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_PERF_STATS_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_PERF_STATS_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+
+namespace brave_rewards {
+
+// Counts and times the operations the rewards service runs for the ledger,
+// so brave://rewards-internals can show where a slow rewards page spends its
+// time. Every sample is also reported to a UMA histogram for its category.
+//
+// Operations are timed from when they are requested to when their reply
+// runs, which includes any time spent queued behind other work.
+class RewardsPerfStats {
+ public:
+  enum Category {
+    DATABASE,
+    STATE,
+    MOJO,
+    NETWORK,
+  };
+
+  struct Entry {
+    Entry();
+    ~Entry();
+
+    int64_t count;
+    base::TimeDelta total;
+    base::TimeDelta max;
+    base::TimeDelta last;
+  };
+
+  // Keyed by "<category>.<name>".
+  using EntryMap = std::map<std::string, Entry>;
+
+  RewardsPerfStats();
+  ~RewardsPerfStats();
+
+  void Record(Category category,
+              const std::string& name,
+              base::TimeDelta elapsed);
+
+  // Returns a callback that records the time until it is run, then runs
+  // |callback| with the same arguments. |callback| still runs if this object
+  // has been destroyed.
+  template <typename... Args>
+  base::OnceCallback<void(Args...)> Time(
+      Category category,
+      const std::string& name,
+      base::OnceCallback<void(Args...)> callback) {
+    return base::BindOnce(&RewardsPerfStats::RunTimed<Args...>,
+                          weak_ptr_factory_.GetWeakPtr(),
+                          category,
+                          name,
+                          base::TimeTicks::Now(),
+                          std::move(callback));
+  }
+
+  const EntryMap& entries() const { return entries_; }
+  void Reset();
+
+ private:
+  template <typename... Args>
+  static void RunTimed(base::WeakPtr<RewardsPerfStats> stats,
+                       Category category,
+                       const std::string& name,
+                       base::TimeTicks start_time,
+                       base::OnceCallback<void(Args...)> callback,
+                       Args... args) {
+    if (stats)
+      stats->Record(category, name, base::TimeTicks::Now() - start_time);
+    std::move(callback).Run(std::forward<Args>(args)...);
+  }
+
+  EntryMap entries_;
+  base::WeakPtrFactory<RewardsPerfStats> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(RewardsPerfStats);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_REWARDS_PERF_STATS_H_
@@ -0,0 +1,92 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/rewards_perf_stats.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=RewardsPerfStatsTest.*
+
+namespace brave_rewards {
+
+class RewardsPerfStatsTest : public testing::Test {
+ public:
+  RewardsPerfStatsTest()
+      : scoped_task_environment_(
+            base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME,
+            base::test::ScopedTaskEnvironment::NowSource::
+                MAIN_THREAD_MOCK_TIME) {
+  }
+
+ protected:
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+};
+
+TEST_F(RewardsPerfStatsTest, RecordsCountTotalAndMax) {
+  base::HistogramTester histograms;
+  RewardsPerfStats stats;
+
+  stats.Record(RewardsPerfStats::DATABASE, "GetActivityList",
+               base::TimeDelta::FromMilliseconds(30));
+  stats.Record(RewardsPerfStats::DATABASE, "GetActivityList",
+               base::TimeDelta::FromMilliseconds(10));
+  stats.Record(RewardsPerfStats::STATE, "SaveLedgerState",
+               base::TimeDelta::FromMilliseconds(5));
+
+  ASSERT_EQ(stats.entries().size(), 2u);
+  const auto& entry = stats.entries().at("Database.GetActivityList");
+  EXPECT_EQ(entry.count, 2);
+  EXPECT_EQ(entry.total, base::TimeDelta::FromMilliseconds(40));
+  EXPECT_EQ(entry.max, base::TimeDelta::FromMilliseconds(30));
+  EXPECT_EQ(entry.last, base::TimeDelta::FromMilliseconds(10));
+
+  histograms.ExpectTotalCount("Brave.Rewards.DatabaseTime", 2);
+  histograms.ExpectTotalCount("Brave.Rewards.StateTime", 1);
+
+  stats.Reset();
+  EXPECT_TRUE(stats.entries().empty());
+}
+
+TEST_F(RewardsPerfStatsTest, TimesCallback) {
+  RewardsPerfStats stats;
+
+  std::string result;
+  auto callback = stats.Time(RewardsPerfStats::MOJO,
+      "GetBalance",
+      base::BindOnce([](std::string* result, const std::string& value) {
+        *result = value;
+      }, &result));
+
+  scoped_task_environment_.FastForwardBy(
+      base::TimeDelta::FromMilliseconds(250));
+  std::move(callback).Run("done");
+
+  EXPECT_EQ(result, "done");
+  const auto& entry = stats.entries().at("Mojo.GetBalance");
+  EXPECT_EQ(entry.count, 1);
+  EXPECT_EQ(entry.last, base::TimeDelta::FromMilliseconds(250));
+}
+
+TEST_F(RewardsPerfStatsTest, RunsCallbackAfterDestruction) {
+  auto stats = std::make_unique<RewardsPerfStats>();
+
+  bool ran = false;
+  auto callback = stats->Time(RewardsPerfStats::NETWORK,
+      "ledger.mercury.basicattentiontoken.org/v2/wallet",
+      base::BindOnce([](bool* ran) { *ran = true; }, &ran));
+
+  stats.reset();
+  std::move(callback).Run();
+  EXPECT_TRUE(ran);
+}
+
+}  // namespace brave_rewards
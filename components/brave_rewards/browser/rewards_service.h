@@ -185,6 +185,9 @@ class RewardsService : public KeyedService {
     const GetPendingContributionsTotalCallback& callback) = 0;
   virtual void GetRewardsMainEnabled(
     const GetRewardsMainEnabledCallback& callback) const = 0;
+  // Starts the ledger for a profile that was left dormant at startup because
+  // rewards is disabled. Rewards UI calls this before asking for ledger data.
+  virtual void WakeLedger() = 0;
   // TODO(Terry Mancey): remove this hack when ads is moved to the same process
   // as ledger
   virtual void SetCatalogIssuers(const std::string& json) = 0;
@@ -9,11 +9,11 @@
 
 #include <algorithm>
 #include <functional>
-#include <limits>
 #include <utility>
 #include <vector>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
 #include "base/files/file_util.h"
@@ -22,13 +22,15 @@
 #include "base/i18n/time_formatting.h"
 #include "base/time/time.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
-#include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "base/task_runner_util.h"
 #include "base/threading/sequenced_task_runner_handle.h"
+#include "base/timer/timer.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/auto_contribute_props.h"
 #include "bat/ledger/media_publisher_info.h"
@@ -43,6 +45,8 @@
 #include "brave/components/brave_rewards/browser/auto_contribution_props.h"
 #include "brave/components/brave_rewards/browser/balance_report.h"
 #include "brave/components/brave_rewards/browser/content_site.h"
+#include "brave/components/brave_rewards/browser/favicon_cache.h"
+#include "brave/components/brave_rewards/browser/journaled_state_store.h"
 #include "brave/components/brave_rewards/browser/publisher_banner.h"
 #include "brave/components/brave_rewards/browser/publisher_info_database.h"
 #include "brave/components/brave_rewards/browser/rewards_fetcher_service_observer.h"
@@ -53,6 +57,7 @@
 #include "brave/components/brave_rewards/browser/switches.h"
 #include "brave/components/brave_rewards/browser/wallet_properties.h"
 #include "brave/components/services/bat_ledger/public/cpp/ledger_client_mojo_proxy.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_type_converters.h"
 #include "chrome/browser/bitmap_fetcher/bitmap_fetcher_service_factory.h"
 #include "chrome/browser/browser_process_impl.h"
 #include "chrome/browser/favicon/favicon_service_factory.h"
@@ -65,19 +70,23 @@
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/url_data_source.h"
 #include "content/public/common/service_manager_connection.h"
+#include "crypto/sha2.h"
 #include "extensions/buildflags/buildflags.h"
 #include "mojo/public/cpp/bindings/map.h"
 #include "net/base/escape.h"
+#include "net/base/net_errors.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/base/url_util.h"
+#include "net/http/http_request_headers.h"
 #include "net/http/http_status_code.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "services/service_manager/public/cpp/connector.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/base/idle/idle.h"
 #include "ui/base/resource/resource_bundle.h"
 #include "ui/gfx/image/image.h"
 #include "url/gurl.h"
-#include "url/url_canon_stdstring.h"
 
 #if !defined(OS_ANDROID)
 #include "brave/components/brave_rewards/resources/grit/brave_rewards_resources.h"
@@ -98,6 +107,10 @@ namespace brave_rewards {
 
 static const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// Ledger responses are small JSON documents, except for the publisher list.
+static const size_t kMaxURLResponseBodySize = 4 * 1024 * 1024;
+static const size_t kMaxPublisherListResponseBodySize = 64 * 1024 * 1024;
+
 class LogStreamImpl : public ledger::LogStream {
  public:
   LogStreamImpl(const char* file,
@@ -184,6 +197,30 @@ std::string URLMethodToRequestType(ledger::URL_METHOD method) {
   }
 }
 
+// Groups requests by host and path for the rewards internals page, with the
+// wallet, publisher and surveyor ids in the path replaced by "*".
+std::string GetEndpointName(const GURL& url) {
+  std::string endpoint = url.host();
+  for (const auto& segment : base::SplitStringPiece(url.path_piece(), "/",
+           base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    bool is_version = segment.size() > 1 && segment[0] == 'v' &&
+        base::ContainsOnlyChars(segment.substr(1), "0123456789");
+    bool is_word = base::ContainsOnlyChars(segment,
+        "abcdefghijklmnopqrstuvwxyz_-");
+    endpoint += "/";
+    endpoint += is_version || is_word ? segment.as_string() : "*";
+  }
+  return endpoint;
+}
+
+size_t GetMaxResponseBodySize(const GURL& url) {
+  if (base::StartsWith(url.path_piece(), "/api/v1/public/channels",
+                       base::CompareCase::SENSITIVE)) {
+    return kMaxPublisherListResponseBodySize;
+  }
+  return kMaxURLResponseBodySize;
+}
+
 std::string LoadStateOnFileTaskRunner(
     const base::FilePath& path) {
   std::string data;
@@ -197,6 +234,15 @@ std::string LoadStateOnFileTaskRunner(
   return data;
 }
 
+std::string LoadJournaledStateOnFileTaskRunner(JournaledStateStore* store) {
+  return store->Load();
+}
+
+bool SaveJournaledStateOnFileTaskRunner(const std::string& state,
+                                        JournaledStateStore* store) {
+  return store->Save(state);
+}
+
 bool SaveMediaPublisherInfoOnFileTaskRunner(
     const std::string& media_key,
     const std::string& publisher_id,
@@ -232,21 +278,21 @@ LoadMediaPublisherInfoOnFileTaskRunner(
 bool SavePublisherInfoOnFileTaskRunner(
     ledger::PublisherInfoPtr publisher_info,
     PublisherInfoDatabase* backend) {
-  if (backend &&
-      backend->InsertOrUpdatePublisherInfo(*publisher_info))
-    return true;
+  if (!backend)
+    return false;
 
-  return false;
+  backend->QueuePublisherInfo(*publisher_info);
+  return true;
 }
 
 bool SaveActivityInfoOnFileTaskRunner(
     ledger::PublisherInfoPtr publisher_info,
     PublisherInfoDatabase* backend) {
-  if (backend &&
-      backend->InsertOrUpdateActivityInfo(*publisher_info))
-    return true;
+  if (!backend)
+    return false;
 
-  return false;
+  backend->QueueActivityInfo(*publisher_info);
+  return true;
 }
 
 ledger::PublisherInfoList GetActivityListOnFileTaskRunner(
@@ -260,7 +306,7 @@ ledger::PublisherInfoList GetActivityListOnFileTaskRunner(
 
   if (filter.excluded ==
     ledger::EXCLUDE_FILTER::FILTER_EXCLUDED) {
-    ignore_result(backend->GetExcludedList(&list));
+    ignore_result(backend->GetExcludedList(start, limit, &list));
   } else {
     ignore_result(backend->GetActivityList(start, limit, filter, &list));
   }
@@ -315,6 +361,20 @@ void EnsureRewardsBaseDirectoryExists(const base::FilePath& path) {
     base::CreateDirectory(path);
 }
 
+bool SaveFaviconCacheOnFileTaskRunner(const base::FilePath& path,
+                                      const std::string& data) {
+  return base::ImportantFileWriter::WriteFileAtomically(path, data);
+}
+
+std::string HashFavicon(const SkBitmap& image) {
+  std::string data = base::IntToString(image.width()) + "x" +
+      base::IntToString(image.height());
+  data.append(static_cast<const char*>(image.getPixels()),
+              image.computeByteSize());
+  return base::HexEncode(crypto::SHA256HashString(data).data(),
+                         crypto::kSHA256Length);
+}
+
 net::NetworkTrafficAnnotationTag
 GetNetworkTrafficAnnotationTagForFaviconFetch() {
   return net::DefineNetworkTrafficAnnotation(
@@ -363,6 +423,33 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTagForURLLoad() {
       })");
 }
 
+// Media requests from a tab are sent to the ledger together once this much
+// time has passed since the first of them, or sooner when the tab changes.
+constexpr base::TimeDelta kMediaEventsBatchDelay =
+    base::TimeDelta::FromSeconds(1);
+
+// Ledger timers due within the same slot of this size share one wakeup.
+constexpr base::TimeDelta kLedgerTimerGranularity =
+    base::TimeDelta::FromSeconds(5);
+
+// How often the publisher database is checked for space to give back.
+constexpr base::TimeDelta kVacuumCheckInterval =
+    base::TimeDelta::FromMinutes(10);
+
+// Vacuum steps only run once the user has been idle this long.
+const int kVacuumIdleThresholdInSeconds = 60;
+
+// Publishers whose banners are kept for the tip dialog and panel.
+const size_t kMaximumEntriesInPublisherBannerCache = 32;
+
+// Events held for the ledger while its utility process restarts, the oldest
+// are dropped past this.
+const size_t kMaximumQueuedLedgerEvents = 1000;
+
+bool VacuumStepOnFileTaskRunner(PublisherInfoDatabase* backend) {
+  return backend && backend->VacuumStep();
+}
+
 }  // namespace
 
 bool IsMediaLink(const GURL& url,
@@ -381,12 +468,14 @@ const base::FilePath::StringType kPublisher_state(L"publisher_state");
 const base::FilePath::StringType kPublisher_info_db(L"publisher_info_db");
 const base::FilePath::StringType kPublishers_list(L"publishers_list");
 const base::FilePath::StringType kRewardsStatePath(L"rewards_service");
+const base::FilePath::StringType kFavicon_cache(L"favicon_cache");
 #else
 const base::FilePath::StringType kLedger_state("ledger_state");
 const base::FilePath::StringType kPublisher_state("publisher_state");
 const base::FilePath::StringType kPublisher_info_db("publisher_info_db");
 const base::FilePath::StringType kPublishers_list("publishers_list");
 const base::FilePath::StringType kRewardsStatePath("rewards_service");
+const base::FilePath::StringType kFavicon_cache("favicon_cache");
 #endif
 
 RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
@@ -404,14 +493,25 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
       publisher_info_db_path_(profile->GetPath().Append(kPublisher_info_db)),
       publisher_list_path_(profile->GetPath().Append(kPublishers_list)),
       rewards_base_path_(profile_->GetPath().Append(kRewardsStatePath)),
+      favicon_cache_path_(rewards_base_path_.Append(kFavicon_cache)),
       publisher_info_backend_(
           new PublisherInfoDatabase(publisher_info_db_path_)),
+      ledger_state_store_(new JournaledStateStore(ledger_state_path_)),
+      publisher_state_store_(new JournaledStateStore(publisher_state_path_)),
       notification_service_(new RewardsNotificationServiceImpl(profile)),
 #if BUILDFLAG(ENABLE_EXTENSIONS)
       private_observer_(
           std::make_unique<ExtensionRewardsServiceObserver>(profile_)),
 #endif
-      next_timer_id_(0) {
+      dormant_(false),
+      timer_wheel_(kLedgerTimerGranularity),
+      media_events_timer_(std::make_unique<base::OneShotTimer>()),
+      vacuum_timer_(std::make_unique<base::RepeatingTimer>()),
+      visit_tracker_(base::BindRepeating(&RewardsServiceImpl::OnVisitEnded,
+                                         base::Unretained(this))),
+      publisher_banner_cache_(kMaximumEntriesInPublisherBannerCache),
+      publisher_list_version_(0),
+      ledger_restarting_(false) {
   file_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&EnsureRewardsBaseDirectoryExists,
                                 rewards_base_path_));
@@ -422,10 +522,15 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
 
 RewardsServiceImpl::~RewardsServiceImpl() {
   file_task_runner_->DeleteSoon(FROM_HERE, publisher_info_backend_.release());
+  file_task_runner_->DeleteSoon(FROM_HERE, ledger_state_store_.release());
+  file_task_runner_->DeleteSoon(FROM_HERE, publisher_state_store_.release());
   StopNotificationTimers();
 }
 
 void RewardsServiceImpl::ConnectionClosed() {
+  // Activity is still tracked while the utility restarts and reaches the
+  // ledger once it has initialized again.
+  ledger_restarting_ = true;
   base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::StartLedger, AsWeakPtr()),
       base::TimeDelta::FromSeconds(1));
@@ -438,9 +543,61 @@ void RewardsServiceImpl::Init() {
   private_observers_.AddObserver(private_observer_.get());
 #endif
 
+  // A profile that has turned rewards off, or never turned it on, has no use
+  // for the ledger until rewards UI is opened, so the utility process, its
+  // databases and timers are only brought up then. The pref can only be
+  // trusted once it has been migrated out of the ledger state.
+  PrefService* pref_service = profile_->GetPrefs();
+  dormant_ = pref_service->GetBoolean(prefs::kBraveRewardsEnabledMigrated) &&
+      !pref_service->GetBoolean(prefs::kBraveRewardsEnabled);
+  UMA_HISTOGRAM_BOOLEAN("Brave.Rewards.StartedDormant", dormant_);
+  if (dormant_) {
+    dormant_start_time_ = base::TimeTicks::Now();
+    VLOG(1) << "Rewards is disabled, not starting the ledger";
+    return;
+  }
+
+  StartLedgerAndLoadCaches();
+}
+
+void RewardsServiceImpl::WakeLedger() {
+  if (!dormant_)
+    return;
+
+  dormant_ = false;
+  UMA_HISTOGRAM_LONG_TIMES("Brave.Rewards.DormantDuration",
+                           base::TimeTicks::Now() - dormant_start_time_);
+  StartLedgerAndLoadCaches();
+}
+
+void RewardsServiceImpl::StartLedgerAndLoadCaches() {
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::Bind(&LoadOnFileTaskRunner, favicon_cache_path_),
+      base::Bind(&RewardsServiceImpl::OnFaviconCacheLoaded, AsWeakPtr()));
+
+  vacuum_timer_->Start(FROM_HERE, kVacuumCheckInterval,
+      base::Bind(&RewardsServiceImpl::OnVacuumTimerFired, AsWeakPtr()));
+
   StartLedger();
 }
 
+void RewardsServiceImpl::OnVacuumTimerFired() {
+  // A step holds the database while it runs, so it waits until the user
+  // isn't around to notice.
+  if (ui::CalculateIdleTime() < kVacuumIdleThresholdInSeconds)
+    return;
+
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&VacuumStepOnFileTaskRunner,
+                     publisher_info_backend_.get()),
+      base::BindOnce(&RewardsServiceImpl::OnVacuumStep, AsWeakPtr()));
+}
+
+void RewardsServiceImpl::OnVacuumStep(bool more_pages) {
+  if (more_pages)
+    OnVacuumTimerFired();
+}
+
 void RewardsServiceImpl::StartLedger() {
   bat_ledger::mojom::BatLedgerClientAssociatedPtrInfo client_ptr_info;
   bat_ledger_client_binding_.Bind(mojo::MakeRequest(&client_ptr_info));
@@ -524,6 +681,7 @@ void RewardsServiceImpl::MaybeShowAddFundsNotification(
 }
 
 void RewardsServiceImpl::CreateWallet() {
+  WakeLedger();
   if (ready().is_signaled()) {
     if (Connected())
       bat_ledger_->CreateWallet();
@@ -557,10 +715,11 @@ void RewardsServiceImpl::GetContentSiteList(
   bat_ledger_->GetActivityInfoList(
       start,
       limit,
-      filter.ToJson(),
-      base::BindOnce(&RewardsServiceImpl::OnGetContentSiteList,
-                     AsWeakPtr(),
-                     callback));
+      ledger::mojom::ActivityInfoFilter::From(filter),
+      perf_stats_.Time(RewardsPerfStats::MOJO, "GetActivityInfoList",
+          base::BindOnce(&RewardsServiceImpl::OnGetContentSiteList,
+                         AsWeakPtr(),
+                         callback)));
 }
 
 void RewardsServiceImpl::OnGetContentSiteList(
@@ -580,6 +739,8 @@ void RewardsServiceImpl::OnLoad(SessionID tab_id, const GURL& url) {
   if (!Connected())
     return;
 
+  FlushMediaEvents(tab_id);
+
   auto origin = url.GetOrigin();
   const std::string baseDomain =
       GetDomainAndRegistry(origin.host(), INCLUDE_PRIVATE_REGISTRIES);
@@ -597,56 +758,81 @@ void RewardsServiceImpl::OnLoad(SessionID tab_id, const GURL& url) {
                          publisher_url,
                          "",
                          "");
-  bat_ledger_->OnLoad(data.ToJson(), GetCurrentTimestamp());
+  visit_tracker_.OnLoad(data, GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnUnload(SessionID tab_id) {
   if (!Connected())
     return;
 
-  bat_ledger_->OnUnload(tab_id.id(), GetCurrentTimestamp());
+  FlushMediaEvents(tab_id);
+  visit_tracker_.OnUnload(tab_id.id(), GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnShow(SessionID tab_id) {
   if (!Connected())
     return;
 
-  bat_ledger_->OnShow(tab_id.id(), GetCurrentTimestamp());
+  FlushMediaEvents(tab_id);
+  visit_tracker_.OnShow(tab_id.id(), GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnHide(SessionID tab_id) {
   if (!Connected())
     return;
 
-  bat_ledger_->OnHide(tab_id.id(), GetCurrentTimestamp());
+  FlushMediaEvents(tab_id);
+  visit_tracker_.OnHide(tab_id.id(), GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnForeground(SessionID tab_id) {
   if (!Connected())
     return;
 
-  bat_ledger_->OnForeground(tab_id.id(), GetCurrentTimestamp());
+  FlushMediaEvents(tab_id);
+  visit_tracker_.OnForeground(tab_id.id(), GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnBackground(SessionID tab_id) {
   if (!Connected())
     return;
 
-  bat_ledger_->OnBackground(tab_id.id(), GetCurrentTimestamp());
+  FlushMediaEvents(tab_id);
+  visit_tracker_.OnBackground(tab_id.id(), GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnMediaStart(SessionID tab_id) {
   if (!Connected())
     return;
 
-  bat_ledger_->OnMediaStart(tab_id.id(), GetCurrentTimestamp());
+  FlushMediaEvents(tab_id);
+  SendMediaStartOrStop(tab_id, true, GetCurrentTimestamp());
 }
 
 void RewardsServiceImpl::OnMediaStop(SessionID tab_id) {
   if (!Connected())
     return;
 
-  bat_ledger_->OnMediaStop(tab_id.id(), GetCurrentTimestamp());
+  FlushMediaEvents(tab_id);
+  SendMediaStartOrStop(tab_id, false, GetCurrentTimestamp());
+}
+
+void RewardsServiceImpl::SendMediaStartOrStop(SessionID tab_id,
+                                              bool start,
+                                              uint64_t timestamp) {
+  if (ledger_restarting_) {
+    QueueLedgerEvent(base::BindOnce(&RewardsServiceImpl::SendMediaStartOrStop,
+                                    AsWeakPtr(), tab_id, start, timestamp));
+    return;
+  }
+
+  if (!Connected())
+    return;
+
+  if (start)
+    bat_ledger_->OnMediaStart(tab_id.id(), timestamp);
+  else
+    bat_ledger_->OnMediaStop(tab_id.id(), timestamp);
 }
 
 void RewardsServiceImpl::OnPostData(SessionID tab_id,
@@ -657,15 +843,9 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
   if (!Connected())
     return;
 
-  std::string output;
-  url::RawCanonOutputW<1024> canonOutput;
-  url::DecodeURLEscapeSequences(post_data.c_str(),
-                                post_data.length(),
-                                url::DecodeURLMode::kUTF8OrIsomorphic,
-                                &canonOutput);
-  output = base::UTF16ToUTF8(base::StringPiece16(canonOutput.data(),
-                                                 canonOutput.length()));
-
+  // The ledger works on the body's bytes, so they are unescaped as they are
+  // rather than through UTF-16.
+  std::string output = net::UnescapeBinaryURLComponent(post_data);
   if (output.empty())
     return;
 
@@ -678,11 +858,14 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
                                std::string(),
                                std::string());
 
-  bat_ledger_->OnPostData(url.spec(),
-                          first_party_url.spec(),
-                          referrer.spec(),
-                          output,
-                          visit_data.ToJson());
+  auto event = bat_ledger::mojom::MediaEvent::New();
+  event->type = bat_ledger::mojom::MediaEventType::POST_DATA;
+  event->url = url.spec();
+  event->first_party_url = first_party_url.spec();
+  event->referrer = referrer.spec();
+  event->post_data = std::move(output);
+  event->visit_data = ledger::mojom::VisitData::From(visit_data);
+  QueueMediaEvent(tab_id, std::move(event));
 }
 
 void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
@@ -692,11 +875,14 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
   if (!Connected())
     return;
 
-  std::map<std::string, std::string> parts;
-
+  auto event = bat_ledger::mojom::MediaEvent::New();
+  event->type = bat_ledger::mojom::MediaEventType::XHR_LOAD;
+  event->url = url.spec();
   for (net::QueryIterator it(url); !it.IsAtEnd(); it.Advance()) {
-    parts[it.GetKey()] = it.GetUnescapedValue();
+    event->parts[it.GetKey()] = it.GetUnescapedValue();
   }
+  event->first_party_url = first_party_url.spec();
+  event->referrer = referrer.spec();
 
   ledger::VisitData data(std::string(),
                          std::string(),
@@ -706,24 +892,89 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
                          std::string(),
                          std::string(),
                          std::string());
+  event->visit_data = ledger::mojom::VisitData::From(data);
+  QueueMediaEvent(tab_id, std::move(event));
+}
 
-  bat_ledger_->OnXHRLoad(tab_id.id(),
-                         url.spec(),
-                         mojo::MapToFlatMap(parts),
-                         first_party_url.spec(),
-                         referrer.spec(),
-                         data.ToJson());
+void RewardsServiceImpl::QueueMediaEvent(
+    SessionID tab_id,
+    bat_ledger::mojom::MediaEventPtr event) {
+  pending_media_events_[tab_id.id()].push_back(std::move(event));
+
+  if (!media_events_timer_->IsRunning()) {
+    media_events_timer_->Start(FROM_HERE,
+        kMediaEventsBatchDelay,
+        this,
+        &RewardsServiceImpl::FlushAllMediaEvents);
+  }
+}
+
+void RewardsServiceImpl::FlushMediaEvents(SessionID tab_id) {
+  auto it = pending_media_events_.find(tab_id.id());
+  if (it == pending_media_events_.end())
+    return;
+
+  std::vector<bat_ledger::mojom::MediaEventPtr> events = std::move(it->second);
+  pending_media_events_.erase(it);
+  SendMediaEvents(tab_id.id(), std::move(events));
+}
+
+void RewardsServiceImpl::FlushAllMediaEvents() {
+  for (auto& tab : pending_media_events_)
+    SendMediaEvents(tab.first, std::move(tab.second));
+  pending_media_events_.clear();
+}
+
+void RewardsServiceImpl::SendMediaEvents(
+    SessionID::id_type tab_id,
+    std::vector<bat_ledger::mojom::MediaEventPtr> events) {
+  if (ledger_restarting_) {
+    QueueLedgerEvent(base::BindOnce(&RewardsServiceImpl::SendMediaEvents,
+                                    AsWeakPtr(), tab_id, std::move(events)));
+    return;
+  }
+
+  if (Connected())
+    bat_ledger_->OnMediaEvents(tab_id, std::move(events));
+}
+
+void RewardsServiceImpl::QueueLedgerEvent(base::OnceClosure event) {
+  if (queued_ledger_events_.size() == kMaximumQueuedLedgerEvents)
+    queued_ledger_events_.pop_front();
+  queued_ledger_events_.push_back(std::move(event));
+}
+
+void RewardsServiceImpl::SendQueuedLedgerEvents() {
+  base::circular_deque<base::OnceClosure> events;
+  events.swap(queued_ledger_events_);
+  UMA_HISTOGRAM_COUNTS_1000("Brave.Rewards.QueuedLedgerEvents", events.size());
+  for (auto& event : events)
+    std::move(event).Run();
+}
+
+void RewardsServiceImpl::OnVisitEnded(const ledger::VisitData& visit_data,
+                                      uint64_t duration) {
+  if (ledger_restarting_) {
+    QueueLedgerEvent(base::BindOnce(&RewardsServiceImpl::OnVisitEnded,
+                                    AsWeakPtr(), visit_data, duration));
+    return;
+  }
+
+  if (!Connected())
+    return;
+
+  bat_ledger_->OnVisit(ledger::mojom::VisitData::From(visit_data), duration);
 }
 
 void RewardsServiceImpl::LoadPublisherInfo(
     const std::string& publisher_key,
     ledger::PublisherInfoCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&LoadPublisherInfoOnFileTaskRunner,
+      base::BindOnce(&LoadPublisherInfoOnFileTaskRunner,
           publisher_key, publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnPublisherInfoLoaded,
-                     AsWeakPtr(),
-                     callback));
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "LoadPublisherInfo",
+          base::BindOnce(&RewardsServiceImpl::OnPublisherInfoLoaded,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnPublisherInfoLoaded(
@@ -741,11 +992,11 @@ void RewardsServiceImpl::LoadMediaPublisherInfo(
     const std::string& media_key,
     ledger::PublisherInfoCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&LoadMediaPublisherInfoOnFileTaskRunner,
+      base::BindOnce(&LoadMediaPublisherInfoOnFileTaskRunner,
           media_key, publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnMediaPublisherInfoLoaded,
-                     AsWeakPtr(),
-                     callback));
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "LoadMediaPublisherInfo",
+          base::BindOnce(&RewardsServiceImpl::OnMediaPublisherInfoLoaded,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnMediaPublisherInfoLoaded(
@@ -766,12 +1017,13 @@ void RewardsServiceImpl::SaveMediaPublisherInfo(
     const std::string& media_key,
     const std::string& publisher_id) {
 base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&SaveMediaPublisherInfoOnFileTaskRunner,
-                    media_key,
-                    publisher_id,
-                    publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnMediaPublisherInfoSaved,
-                     AsWeakPtr()));
+      base::BindOnce(&SaveMediaPublisherInfoOnFileTaskRunner,
+                     media_key,
+                     publisher_id,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "SaveMediaPublisherInfo",
+          base::BindOnce(&RewardsServiceImpl::OnMediaPublisherInfoSaved,
+              AsWeakPtr())));
 }
 
 void RewardsServiceImpl::RestorePublishers() {
@@ -813,7 +1065,9 @@ void RewardsServiceImpl::Shutdown() {
     delete loader;
   }
   url_loaders_.clear();
+  pending_url_loads_.clear();
 
+  FlushAllMediaEvents();
   bat_ledger_.reset();
   RewardsService::Shutdown();
 }
@@ -822,6 +1076,11 @@ void RewardsServiceImpl::OnWalletInitialized(ledger::Result result) {
   if (!ready_.is_signaled())
     ready_.Signal();
 
+  if (ledger_restarting_) {
+    ledger_restarting_ = false;
+    SendQueuedLedgerEvents();
+  }
+
   if (result == ledger::Result::WALLET_CREATED) {
     SetRewardsMainEnabled(true);
     SetAutoContribute(true);
@@ -901,6 +1160,7 @@ void RewardsServiceImpl::OnGetRewardsInternalsInfo(
   rewards_internals_info->persona_id = info.persona_id;
   rewards_internals_info->user_id = info.user_id;
   rewards_internals_info->boot_stamp = info.boot_stamp;
+  rewards_internals_info->perf_stats = perf_stats_.entries();
 
   for (const auto& item : info.current_reconciles) {
     ReconcileInfo reconcile_info;
@@ -920,8 +1180,10 @@ void RewardsServiceImpl::GetAutoContributeProps(
   if (!Connected())
     return;
 
-  bat_ledger_->GetAutoContributeProps(base::BindOnce(
-        &RewardsServiceImpl::OnGetAutoContributeProps, AsWeakPtr(), callback));
+  bat_ledger_->GetAutoContributeProps(
+      perf_stats_.Time(RewardsPerfStats::MOJO, "GetAutoContributeProps",
+          base::BindOnce(&RewardsServiceImpl::OnGetAutoContributeProps,
+                         AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnGrant(ledger::Result result,
@@ -934,30 +1196,42 @@ void RewardsServiceImpl::OnGrantCaptcha(const std::string& image,
   TriggerOnGrantCaptcha(image, hint);
 }
 
+bool DeleteAllBalanceReportsOnFileTaskRunner(PublisherInfoDatabase* backend) {
+  return backend && backend->DeleteAllBalanceReports();
+}
+
 void RewardsServiceImpl::OnRecoverWallet(ledger::Result result,
                                     double balance,
                                     const std::vector<ledger::Grant>& grants) {
+  // Reports of the replaced wallet don't apply to the recovered one.
+  if (result == ledger::Result::LEDGER_OK) {
+    file_task_runner_->PostTask(FROM_HERE,
+        base::BindOnce(
+            base::IgnoreResult(&DeleteAllBalanceReportsOnFileTaskRunner),
+            publisher_info_backend_.get()));
+  }
+
   TriggerOnRecoverWallet(result, balance, grants);
 }
 
 void RewardsServiceImpl::OnGrantFinish(ledger::Result result,
                                        const ledger::Grant& grant) {
-  ledger::BalanceReportInfo report_info;
   auto now = base::Time::Now();
   if (result == ledger::Result::LEDGER_OK) {
     if (!Connected())
       return;
 
-    int report_type = grant.type == "ads"
+    ledger::ReportType report_type = grant.type == "ads"
       ? ledger::ReportType::ADS
       : ledger::ReportType::GRANT;
-    bat_ledger_->SetBalanceReportItem(GetPublisherMonth(now),
-                                      GetPublisherYear(now),
-                                      report_type,
-                                      grant.probi);
+    AddBalanceReportItem(GetPublisherMonth(now),
+                         GetPublisherYear(now),
+                         report_type,
+                         grant.probi);
+  } else {
+    GetCurrentBalanceReport();
   }
 
-  GetCurrentBalanceReport();
   TriggerOnGrantFinish(result, grant);
 }
 
@@ -995,11 +1269,20 @@ void RewardsServiceImpl::OnReconcileComplete(ledger::Result result,
 
 void RewardsServiceImpl::LoadLedgerState(
     ledger::LedgerCallbackHandler* handler) {
+  // A restarted utility gets back what it last saved without a disk read.
+  if (ledger_state_snapshot_) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+        base::BindOnce(&RewardsServiceImpl::OnLedgerStateLoaded, AsWeakPtr(),
+                       base::Unretained(handler), *ledger_state_snapshot_));
+    return;
+  }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&LoadStateOnFileTaskRunner, ledger_state_path_),
-      base::Bind(&RewardsServiceImpl::OnLedgerStateLoaded,
-                     AsWeakPtr(),
-                     base::Unretained(handler)));
+      base::BindOnce(&LoadJournaledStateOnFileTaskRunner,
+                     ledger_state_store_.get()),
+      perf_stats_.Time(RewardsPerfStats::STATE, "LoadLedgerState",
+          base::BindOnce(&RewardsServiceImpl::OnLedgerStateLoaded,
+              AsWeakPtr(), base::Unretained(handler))));
 }
 
 void RewardsServiceImpl::OnLedgerStateLoaded(
@@ -1008,6 +1291,8 @@ void RewardsServiceImpl::OnLedgerStateLoaded(
   if (!Connected())
     return;
 
+  if (!data.empty())
+    ledger_state_snapshot_ = data;
   handler->OnLedgerStateLoaded(data.empty() ? ledger::Result::NO_LEDGER_STATE
                                             : ledger::Result::LEDGER_OK,
                                data);
@@ -1024,11 +1309,20 @@ void RewardsServiceImpl::LoadPublisherState(
         base::BindOnce(&RewardsServiceImpl::SetRewardsMainEnabledPref,
           AsWeakPtr()));
   }
+  if (publisher_state_snapshot_) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+        base::BindOnce(&RewardsServiceImpl::OnPublisherStateLoaded,
+                       AsWeakPtr(), base::Unretained(handler),
+                       *publisher_state_snapshot_));
+    return;
+  }
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&LoadStateOnFileTaskRunner, publisher_state_path_),
-      base::Bind(&RewardsServiceImpl::OnPublisherStateLoaded,
-                     AsWeakPtr(),
-                     base::Unretained(handler)));
+      base::BindOnce(&LoadJournaledStateOnFileTaskRunner,
+                     publisher_state_store_.get()),
+      perf_stats_.Time(RewardsPerfStats::STATE, "LoadPublisherState",
+          base::BindOnce(&RewardsServiceImpl::OnPublisherStateLoaded,
+              AsWeakPtr(), base::Unretained(handler))));
 }
 
 void RewardsServiceImpl::OnPublisherStateLoaded(
@@ -1037,6 +1331,8 @@ void RewardsServiceImpl::OnPublisherStateLoaded(
   if (!Connected())
     return;
 
+  if (!data.empty())
+    publisher_state_snapshot_ = data;
   handler->OnPublisherStateLoaded(
       data.empty() ? ledger::Result::NO_PUBLISHER_STATE
                    : ledger::Result::LEDGER_OK,
@@ -1045,18 +1341,14 @@ void RewardsServiceImpl::OnPublisherStateLoaded(
 
 void RewardsServiceImpl::SaveLedgerState(const std::string& ledger_state,
                                       ledger::LedgerCallbackHandler* handler) {
-  base::ImportantFileWriter writer(
-      ledger_state_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(&RewardsServiceImpl::OnLedgerStateSaved, AsWeakPtr(),
-            base::Unretained(handler)),
-        base::SequencedTaskRunnerHandle::Get()));
-
-  writer.WriteNow(std::make_unique<std::string>(ledger_state));
+  ledger_state_snapshot_ = ledger_state;
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&SaveJournaledStateOnFileTaskRunner,
+                     ledger_state,
+                     ledger_state_store_.get()),
+      perf_stats_.Time(RewardsPerfStats::STATE, "SaveLedgerState",
+          base::BindOnce(&RewardsServiceImpl::OnLedgerStateSaved,
+              AsWeakPtr(), base::Unretained(handler))));
 }
 
 void RewardsServiceImpl::OnLedgerStateSaved(
@@ -1071,17 +1363,14 @@ void RewardsServiceImpl::OnLedgerStateSaved(
 
 void RewardsServiceImpl::SavePublisherState(const std::string& publisher_state,
                                       ledger::LedgerCallbackHandler* handler) {
-  base::ImportantFileWriter writer(publisher_state_path_, file_task_runner_);
-
-  writer.RegisterOnNextWriteCallbacks(
-      base::Closure(),
-      base::Bind(
-        &PostWriteCallback,
-        base::Bind(&RewardsServiceImpl::OnPublisherStateSaved, AsWeakPtr(),
-            base::Unretained(handler)),
-        base::SequencedTaskRunnerHandle::Get()));
-
-  writer.WriteNow(std::make_unique<std::string>(publisher_state));
+  publisher_state_snapshot_ = publisher_state;
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&SaveJournaledStateOnFileTaskRunner,
+                     publisher_state,
+                     publisher_state_store_.get()),
+      perf_stats_.Time(RewardsPerfStats::STATE, "SavePublisherState",
+          base::BindOnce(&RewardsServiceImpl::OnPublisherStateSaved,
+              AsWeakPtr(), base::Unretained(handler))));
 }
 
 void RewardsServiceImpl::OnPublisherStateSaved(
@@ -1112,15 +1401,19 @@ void RewardsServiceImpl::LoadNicewareList(
 void RewardsServiceImpl::SavePublisherInfo(
     ledger::PublisherInfoPtr publisher_info,
     ledger::PublisherInfoCallback callback) {
+  // Banners show the publisher's name, icon and verified state.
+  auto cached = publisher_banner_cache_.Peek(publisher_info->id);
+  if (cached != publisher_banner_cache_.end())
+    publisher_banner_cache_.Erase(cached);
+
   ledger::PublisherInfoPtr copy = publisher_info->Clone();
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&SavePublisherInfoOnFileTaskRunner,
                     std::move(copy),
                     publisher_info_backend_.get()),
-      base::BindOnce(&RewardsServiceImpl::OnPublisherInfoSaved,
-                     AsWeakPtr(),
-                     callback,
-                     std::move(publisher_info)));
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "SavePublisherInfo",
+          base::BindOnce(&RewardsServiceImpl::OnPublisherInfoSaved,
+              AsWeakPtr(), callback, std::move(publisher_info))));
 }
 
 void RewardsServiceImpl::OnPublisherInfoSaved(
@@ -1141,10 +1434,9 @@ void RewardsServiceImpl::SaveActivityInfo(
       base::BindOnce(&SaveActivityInfoOnFileTaskRunner,
                     std::move(copy),
                     publisher_info_backend_.get()),
-      base::BindOnce(&RewardsServiceImpl::OnActivityInfoSaved,
-                     AsWeakPtr(),
-                     callback,
-                     std::move(publisher_info)));
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "SaveActivityInfo",
+          base::BindOnce(&RewardsServiceImpl::OnActivityInfoSaved,
+              AsWeakPtr(), callback, std::move(publisher_info))));
 }
 
 void RewardsServiceImpl::OnActivityInfoSaved(
@@ -1161,14 +1453,13 @@ void RewardsServiceImpl::LoadActivityInfo(
     ledger::ActivityInfoFilter filter,
     ledger::PublisherInfoCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&GetActivityListOnFileTaskRunner,
+      base::BindOnce(&GetActivityListOnFileTaskRunner,
           // set limit to 2 to make sure there is
           // only 1 valid result for the filter
           0, 2, filter, publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnActivityInfoLoaded,
-                     AsWeakPtr(),
-                     callback,
-                     filter.id));
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "LoadActivityInfo",
+          base::BindOnce(&RewardsServiceImpl::OnActivityInfoLoaded,
+              AsWeakPtr(), callback, filter.id)));
 }
 
 void RewardsServiceImpl::OnPublisherActivityInfoLoaded(
@@ -1209,12 +1500,12 @@ void RewardsServiceImpl::LoadPanelPublisherInfo(
     ledger::ActivityInfoFilter filter,
     ledger::PublisherInfoCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&GetPanelPublisherInfoOnFileTaskRunner,
-                 filter,
-                 publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnPanelPublisherInfoLoaded,
-                     AsWeakPtr(),
-                     callback));
+      base::BindOnce(&GetPanelPublisherInfoOnFileTaskRunner,
+                     filter,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "LoadPanelPublisherInfo",
+          base::BindOnce(&RewardsServiceImpl::OnPanelPublisherInfoLoaded,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnPanelPublisherInfoLoaded(
@@ -1234,14 +1525,12 @@ void RewardsServiceImpl::GetActivityInfoList(
     ledger::ActivityInfoFilter filter,
     ledger::PublisherInfoListCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&GetActivityListOnFileTaskRunner,
-                    start, limit, filter,
-                    publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnPublisherInfoListLoaded,
-                    AsWeakPtr(),
-                    start,
-                    limit,
-                    callback));
+      base::BindOnce(&GetActivityListOnFileTaskRunner,
+                     start, limit, filter,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "GetActivityInfoList",
+          base::BindOnce(&RewardsServiceImpl::OnPublisherInfoListLoaded,
+              AsWeakPtr(), start, limit, callback)));
 }
 
 void RewardsServiceImpl::OnPublisherInfoListLoaded(
@@ -1291,6 +1580,18 @@ void RewardsServiceImpl::LoadURL(
     return;
   }
 
+  // Identical GETs share one fetch; the rest wait for its response.
+  std::string cache_key;
+  if (method == ledger::URL_METHOD::GET && content.empty()) {
+    cache_key = URLResponseCache::KeyFor(url, headers);
+    auto pending = pending_url_loads_.find(cache_key);
+    if (pending != pending_url_loads_.end()) {
+      pending->second.push_back(callback);
+      return;
+    }
+    pending_url_loads_[cache_key].push_back(callback);
+  }
+
   const std::string request_method = URLMethodToRequestType(method);
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = GURL(url);
@@ -1298,6 +1599,9 @@ void RewardsServiceImpl::LoadURL(
   request->allow_credentials = false;
   for (size_t i = 0; i < headers.size(); i++)
     request->headers.AddHeaderFromString(headers[i]);
+  std::string etag;
+  if (!cache_key.empty() && url_response_cache_.GetETag(cache_key, &etag))
+    request->headers.SetHeader(net::HttpRequestHeaders::kIfNoneMatch, etag);
   network::SimpleURLLoader* loader = network::SimpleURLLoader::Create(
       std::move(request),
       GetNetworkTrafficAnnotationTagForURLLoad()).release();
@@ -1325,17 +1629,24 @@ void RewardsServiceImpl::LoadURL(
       << "[ END REQUEST ]";
   }
 
-  loader->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+  loader->DownloadToString(
       content::BrowserContext::GetDefaultStoragePartition(profile_)
           ->GetURLLoaderFactoryForBrowserProcess().get(),
       base::BindOnce(&RewardsServiceImpl::OnURLLoaderComplete,
                      base::Unretained(this),
                      loader,
-                     callback));
+                     cache_key,
+                     GetEndpointName(parsed_url),
+                     base::TimeTicks::Now(),
+                     callback),
+      GetMaxResponseBodySize(parsed_url));
 }
 
 void RewardsServiceImpl::OnURLLoaderComplete(
     network::SimpleURLLoader* loader,
+    const std::string& cache_key,
+    const std::string& endpoint,
+    base::TimeTicks start_time,
     ledger::LoadURLCallback callback,
     std::unique_ptr<std::string> response_body) {
   DCHECK(url_loaders_.find(loader) != url_loaders_.end());
@@ -1362,10 +1673,44 @@ void RewardsServiceImpl::OnURLLoaderComplete(
     }
   }
 
+  const base::TimeDelta latency = base::TimeTicks::Now() - start_time;
+  perf_stats_.Record(RewardsPerfStats::NETWORK, endpoint, latency);
+  VLOG(ledger::LogLevel::LOG_RESPONSE) << "[ LATENCY ] " << endpoint << ": "
+      << latency.InMilliseconds() << "ms (" << response_code << ")";
+
+  if (loader->NetError() == net::ERR_INSUFFICIENT_RESOURCES) {
+    LOG(ERROR) << "Response for " << endpoint << " exceeds the size limit";
+    response_code = -1;
+  }
+
+  // The body can be several megabytes, so it is moved rather than copied and
+  // handed to every callback by reference.
+  std::string body;
+  if (response_body)
+    body = std::move(*response_body);
+  std::vector<ledger::LoadURLCallback> callbacks = { callback };
+  if (!cache_key.empty()) {
+    if (response_code == net::HTTP_NOT_MODIFIED &&
+        url_response_cache_.GetBody(cache_key, &body)) {
+      response_code = net::HTTP_OK;
+    } else if (response_code == net::HTTP_OK) {
+      auto etag = headers.find("etag");
+      url_response_cache_.Put(cache_key,
+                              etag != headers.end() ? etag->second : "",
+                              body);
+    }
+
+    auto pending = pending_url_loads_.find(cache_key);
+    if (pending != pending_url_loads_.end()) {
+      callbacks = std::move(pending->second);
+      pending_url_loads_.erase(pending);
+    }
+  }
+
   if (Connected()) {
-    callback(response_code,
-             response_body ? *response_body : std::string(),
-             headers);
+    for (const auto& pending_callback : callbacks) {
+      pending_callback(response_code, body, headers);
+    }
   }
 }
 
@@ -1395,8 +1740,9 @@ void RewardsServiceImpl::FetchWalletProperties() {
     }
 
     bat_ledger_->FetchWalletProperties(
-        base::BindOnce(&RewardsServiceImpl::OnFetchWalletProperties,
-                       AsWeakPtr()));
+        perf_stats_.Time(RewardsPerfStats::MOJO, "FetchWalletProperties",
+            base::BindOnce(&RewardsServiceImpl::OnFetchWalletProperties,
+                           AsWeakPtr())));
   } else {
     ready().Post(FROM_HERE,
         base::Bind(&brave_rewards::RewardsService::FetchWalletProperties,
@@ -1533,6 +1879,9 @@ void RewardsServiceImpl::GetAddresses(const GetAddressesCallback& callback) {
 }
 
 void RewardsServiceImpl::SetRewardsMainEnabled(bool enabled) {
+  if (enabled)
+    WakeLedger();
+
   if (!Connected()) {
     return;
   }
@@ -1544,7 +1893,15 @@ void RewardsServiceImpl::SetRewardsMainEnabled(bool enabled) {
 
 void RewardsServiceImpl::GetRewardsMainEnabled(
     const GetRewardsMainEnabledCallback& callback) const {
+  // Content scripts ask this on every page they run on, and the answer is
+  // already known without waking the ledger
+  if (dormant_) {
+    callback.Run(false);
+    return;
+  }
+
   if (!Connected()) {
+    callback.Run(false);
     return;
   }
 
@@ -1595,8 +1952,11 @@ void RewardsServiceImpl::GetTransactionHistoryForThisCycle(
   }
 
   bat_ledger_->GetTransactionHistoryForThisCycle(
-      base::BindOnce(&RewardsServiceImpl::OnGetTransactionHistoryForThisCycle,
-          AsWeakPtr(), std::move(callback)));
+      perf_stats_.Time(RewardsPerfStats::MOJO,
+          "GetTransactionHistoryForThisCycle",
+          base::BindOnce(
+              &RewardsServiceImpl::OnGetTransactionHistoryForThisCycle,
+              AsWeakPtr(), std::move(callback))));
 }
 
 void RewardsServiceImpl::OnGetTransactionHistoryForThisCycle(
@@ -1649,19 +2009,25 @@ void RewardsServiceImpl::LoadState(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&LoadOnFileTaskRunner,
                      rewards_base_path_.AppendASCII(name)),
-      base::BindOnce(&RewardsServiceImpl::OnLoadedState,
-                     AsWeakPtr(), std::move(callback)));
+      perf_stats_.Time(RewardsPerfStats::STATE, "LoadState",
+          base::BindOnce(&RewardsServiceImpl::OnLoadedState,
+              AsWeakPtr(), std::move(callback))));
 }
 
 void RewardsServiceImpl::ResetState(
     const std::string& name,
     ledger::OnResetCallback callback) {
+  // The ledger is starting over, so it must not be handed its old state
+  // back from memory.
+  ledger_state_snapshot_.reset();
+  publisher_state_snapshot_.reset();
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&ResetOnFileTaskRunner,
                      rewards_base_path_.AppendASCII(name)),
-      base::BindOnce(&RewardsServiceImpl::OnResetState,
-                     AsWeakPtr(), std::move(callback)));
+      perf_stats_.Time(RewardsPerfStats::STATE, "ResetState",
+          base::BindOnce(&RewardsServiceImpl::OnResetState,
+              AsWeakPtr(), std::move(callback))));
 }
 
 void RewardsServiceImpl::OnSavedState(
@@ -1683,11 +2049,7 @@ void RewardsServiceImpl::OnLoadedState(
 }
 
 void RewardsServiceImpl::KillTimer(uint32_t timer_id) {
-  if (timers_.find(timer_id) == timers_.end())
-    return;
-
-  timers_[timer_id]->Stop();
-  timers_.erase(timer_id);
+  timer_wheel_.Stop(timer_id);
 }
 
 void RewardsServiceImpl::OnResetState(
@@ -1789,6 +2151,7 @@ void RewardsServiceImpl::SetUserChangedContribution() const {
 void RewardsServiceImpl::GetAutoContribute(
     GetAutoContributeCallback callback) {
   if (!Connected()) {
+    std::move(callback).Run(false);
     return;
   }
 
@@ -1811,6 +2174,10 @@ void RewardsServiceImpl::TriggerOnRewardsMainEnabled(
 
 void RewardsServiceImpl::SavePublishersList(const std::string& publishers_list,
                                       ledger::LedgerCallbackHandler* handler) {
+  // Banner text, images and verified states come from this list.
+  publisher_list_version_++;
+  publisher_banner_cache_.Clear();
+
   base::ImportantFileWriter writer(
       publisher_list_path_, file_task_runner_);
 
@@ -1838,18 +2205,8 @@ void RewardsServiceImpl::OnPublishersListSaved(
 
 void RewardsServiceImpl::SetTimer(uint64_t time_offset,
                                   uint32_t* timer_id) {
-  if (next_timer_id_ == std::numeric_limits<uint32_t>::max())
-    next_timer_id_ = 1;
-  else
-    ++next_timer_id_;
-
-  *timer_id = next_timer_id_;
-
-  timers_[next_timer_id_] = std::make_unique<base::OneShotTimer>();
-  timers_[next_timer_id_]->Start(FROM_HERE,
-      base::TimeDelta::FromSeconds(time_offset),
-      base::BindOnce(
-          &RewardsServiceImpl::OnTimer, AsWeakPtr(), next_timer_id_));
+  *timer_id = timer_wheel_.Start(base::TimeDelta::FromSeconds(time_offset),
+      base::BindOnce(&RewardsServiceImpl::OnTimer, AsWeakPtr()));
 }
 
 void RewardsServiceImpl::OnTimer(uint32_t timer_id) {
@@ -1857,16 +2214,16 @@ void RewardsServiceImpl::OnTimer(uint32_t timer_id) {
     return;
   }
 
-  timers_.erase(timer_id);
   bat_ledger_->OnTimer(timer_id);
 }
 
 void RewardsServiceImpl::LoadPublisherList(
     ledger::LedgerCallbackHandler* handler) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&LoadStateOnFileTaskRunner, publisher_list_path_),
-      base::Bind(&RewardsServiceImpl::OnPublisherListLoaded,
-          AsWeakPtr(), base::Unretained(handler)));
+      base::BindOnce(&LoadStateOnFileTaskRunner, publisher_list_path_),
+      perf_stats_.Time(RewardsPerfStats::STATE, "LoadPublisherList",
+          base::BindOnce(&RewardsServiceImpl::OnPublisherListLoaded,
+              AsWeakPtr(), base::Unretained(handler))));
 }
 
 void RewardsServiceImpl::OnPublisherListLoaded(
@@ -1882,16 +2239,18 @@ void RewardsServiceImpl::OnPublisherListLoaded(
       data);
 }
 
-void RewardsServiceImpl::OnGetAllBalanceReports(
-    const GetAllBalanceReportsCallback& callback,
-    const base::flat_map<std::string, std::string>& json_reports) {
+std::map<std::string, ledger::BalanceReportInfo>
+GetAllBalanceReportsOnFileTaskRunner(PublisherInfoDatabase* backend) {
   std::map<std::string, ledger::BalanceReportInfo> reports;
-  for (auto const& report : json_reports) {
-    ledger::BalanceReportInfo info;
-    info.loadFromJson(report.second);
-    reports[report.first] = info;
+  if (backend) {
+    backend->GetAllBalanceReports(&reports);
   }
+  return reports;
+}
 
+void RewardsServiceImpl::OnGetAllBalanceReports(
+    const GetAllBalanceReportsCallback& callback,
+    const std::map<std::string, ledger::BalanceReportInfo>& reports) {
   std::map<std::string, brave_rewards::BalanceReport> newReports;
   for (auto const& report : reports) {
     brave_rewards::BalanceReport newReport;
@@ -1912,34 +2271,116 @@ void RewardsServiceImpl::OnGetAllBalanceReports(
 
 void RewardsServiceImpl::GetAllBalanceReports(
     const GetAllBalanceReportsCallback& callback) {
-  if (!Connected()) {
-    return;
-  }
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&GetAllBalanceReportsOnFileTaskRunner,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "GetAllBalanceReports",
+          base::BindOnce(&RewardsServiceImpl::OnGetAllBalanceReports,
+              AsWeakPtr(), callback)));
+}
 
-  bat_ledger_->GetAllBalanceReports(
-      base::BindOnce(&RewardsServiceImpl::OnGetAllBalanceReports,
-        AsWeakPtr(), callback));
+std::unique_ptr<ledger::BalanceReportInfo> GetBalanceReportOnFileTaskRunner(
+    ledger::ACTIVITY_MONTH month,
+    int year,
+    PublisherInfoDatabase* backend) {
+  auto report = std::make_unique<ledger::BalanceReportInfo>();
+  if (!backend || !backend->GetBalanceReport(month, year, report.get())) {
+    return nullptr;
+  }
+  return report;
 }
 
 void RewardsServiceImpl::OnGetCurrentBalanceReport(
-    bool success, const std::string& json_report) {
-  ledger::BalanceReportInfo report;
-  report.loadFromJson(json_report);
-
-  if (success) {
-    TriggerOnGetCurrentBalanceReport(report);
+    std::unique_ptr<ledger::BalanceReportInfo> report) {
+  if (report) {
+    TriggerOnGetCurrentBalanceReport(*report);
   }
 }
 
 void RewardsServiceImpl::GetCurrentBalanceReport() {
   auto now = base::Time::Now();
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&GetBalanceReportOnFileTaskRunner,
+                     GetPublisherMonth(now),
+                     GetPublisherYear(now),
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "GetCurrentBalanceReport",
+          base::BindOnce(&RewardsServiceImpl::OnGetCurrentBalanceReport,
+              AsWeakPtr())));
+}
+
+bool AddBalanceReportItemOnFileTaskRunner(ledger::ACTIVITY_MONTH month,
+                                          int year,
+                                          ledger::ReportType type,
+                                          const std::string& probi,
+                                          PublisherInfoDatabase* backend) {
+  return backend && backend->AddBalanceReportItem(month, year, type, probi);
+}
+
+void RewardsServiceImpl::AddBalanceReportItem(ledger::ACTIVITY_MONTH month,
+                                              int year,
+                                              ledger::ReportType type,
+                                              const std::string& probi) {
+  file_task_runner_->PostTask(FROM_HERE,
+      base::BindOnce(base::IgnoreResult(&AddBalanceReportItemOnFileTaskRunner),
+                     month,
+                     year,
+                     type,
+                     probi,
+                     publisher_info_backend_.get()));
+
+  // Read back after the write, which is ahead of it on the file task runner.
+  GetCurrentBalanceReport();
+}
+
+bool SaveBalanceReportsOnFileTaskRunner(
+    const std::map<std::string, ledger::BalanceReportInfo>& reports,
+    PublisherInfoDatabase* backend) {
+  if (!backend) {
+    return false;
+  }
+
+  bool success = true;
+  for (const auto& report : reports) {
+    // Reports are named "<year>_<month>".
+    std::vector<std::string> parts = base::SplitString(report.first, "_",
+        base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    int year = 0;
+    int month = 0;
+    if (parts.size() != 2 ||
+        !base::StringToInt(parts[0], &year) ||
+        !base::StringToInt(parts[1], &month) ||
+        month < ledger::ACTIVITY_MONTH::JANUARY ||
+        month > ledger::ACTIVITY_MONTH::DECEMBER) {
+      continue;
+    }
+
+    success &= backend->InsertOrUpdateBalanceReport(
+        static_cast<ledger::ACTIVITY_MONTH>(month), year, report.second);
+  }
+  return success;
+}
+
+void RewardsServiceImpl::SaveBalanceReports(
+    const std::map<std::string, ledger::BalanceReportInfo>& reports,
+    ledger::OnSaveCallback callback) {
+  base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&SaveBalanceReportsOnFileTaskRunner,
+                     reports,
+                     publisher_info_backend_.get()),
+      base::BindOnce(&RewardsServiceImpl::OnBalanceReportsSaved,
+                     AsWeakPtr(),
+                     callback));
+}
+
+void RewardsServiceImpl::OnBalanceReportsSaved(
+    ledger::OnSaveCallback callback,
+    bool success) {
   if (!Connected()) {
     return;
   }
 
-  bat_ledger_->GetBalanceReport(GetPublisherMonth(now), GetPublisherYear(now),
-      base::BindOnce(&RewardsServiceImpl::OnGetCurrentBalanceReport,
-        AsWeakPtr()));
+  callback(success ? ledger::Result::LEDGER_OK : ledger::Result::LEDGER_ERROR);
 }
 
 void RewardsServiceImpl::IsWalletCreated(
@@ -1984,7 +2425,7 @@ void RewardsServiceImpl::GetPublisherActivityFromUrl(
   visitData.favicon_url = favicon_url;
 
   bat_ledger_->GetPublisherActivityFromUrl(
-    windowId, visitData.ToJson(), publisher_blob);
+    windowId, ledger::mojom::VisitData::From(visitData), publisher_blob);
 }
 
 void RewardsServiceImpl::OnExcludedSitesChanged(
@@ -2035,18 +2476,26 @@ void RewardsServiceImpl::FetchFavIcon(const std::string& url,
     return;
   }
 
-  std::vector<std::string>::iterator it;
-  it = find(current_media_fetchers_.begin(),
-      current_media_fetchers_.end(), url);
-  if (it != current_media_fetchers_.end()) {
-    LOG(WARNING) << "Already fetching favicon: " << url;
+  std::string cached_key;
+  if (favicon_cache_.Get(parsedUrl.spec(), base::Time::Now(), &cached_key)) {
+    std::vector<ledger::FetchIconCallback> callbacks = { callback };
+    base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+        base::BindOnce(&RewardsServiceImpl::OnSetOnDemandFaviconComplete,
+            AsWeakPtr(), cached_key, std::move(callbacks), true));
+    return;
+  }
+
+  // Several tabs showing the same publisher share one fetch.
+  auto pending = pending_favicon_fetches_.find(parsedUrl.spec());
+  if (pending != pending_favicon_fetches_.end()) {
+    pending->second.push_back(callback);
     return;
   }
 
   BitmapFetcherService* image_service =
       BitmapFetcherServiceFactory::GetForBrowserContext(profile_);
   if (image_service) {
-    current_media_fetchers_.emplace_back(url);
+    pending_favicon_fetches_[parsedUrl.spec()].push_back(callback);
     request_ids_.push_back(image_service->RequestImage(
           parsedUrl,
           // Image Service takes ownership of the observer
@@ -2054,66 +2503,121 @@ void RewardsServiceImpl::FetchFavIcon(const std::string& url,
               favicon_key,
               parsedUrl,
               base::Bind(&RewardsServiceImpl::OnFetchFavIconCompleted,
-                  base::Unretained(this), callback)),
+                  base::Unretained(this))),
           GetNetworkTrafficAnnotationTagForFaviconFetch()));
   }
 }
 
 void RewardsServiceImpl::OnFetchFavIconCompleted(
-    ledger::FetchIconCallback callback,
     const std::string& favicon_key,
     const GURL& url,
     const BitmapFetcherService::RequestId& request_id,
     const SkBitmap& image) {
-  GURL favicon_url(favicon_key);
+  std::vector<BitmapFetcherService::RequestId>::iterator it_ids;
+  it_ids = find(request_ids_.begin(), request_ids_.end(), request_id);
+  if (it_ids != request_ids_.end()) {
+    request_ids_.erase(it_ids);
+  }
+
+  std::vector<ledger::FetchIconCallback> callbacks;
+  auto pending = pending_favicon_fetches_.find(url.spec());
+  if (pending != pending_favicon_fetches_.end()) {
+    callbacks.swap(pending->second);
+    pending_favicon_fetches_.erase(pending);
+  }
+
+  if (image.drawsNothing()) {
+    OnSetOnDemandFaviconComplete(std::string(), std::move(callbacks), false);
+    return;
+  }
+
+  std::string key = favicon_key;
+  const bool unchanged =
+      favicon_cache_.Put(url.spec(), HashFavicon(image), base::Time::Now(),
+                         &key);
+  SaveFaviconCache();
+
+  GURL favicon_url(key);
   gfx::Image gfx_image = gfx::Image::CreateFrom1xBitmap(image);
   favicon::FaviconService* favicon_service =
           FaviconServiceFactory::GetForProfile(profile_,
               ServiceAccessType::EXPLICIT_ACCESS);
+
+  if (unchanged) {
+    // The icon is normally still stored under |key|, in which case this is a
+    // no-op. It only puts the icon back if the favicon service expired it.
+    favicon_service->SetOnDemandFavicons(
+        favicon_url,
+        url,
+        favicon_base::IconType::kFavicon,
+        gfx_image,
+        base::DoNothing());
+    OnSetOnDemandFaviconComplete(key, std::move(callbacks), true);
+    return;
+  }
+
   favicon_service->SetOnDemandFavicons(
       favicon_url,
       url,
       favicon_base::IconType::kFavicon,
       gfx_image,
       base::BindOnce(&RewardsServiceImpl::OnSetOnDemandFaviconComplete,
-          AsWeakPtr(), favicon_url.spec(), callback));
-
-  std::vector<std::string>::iterator it_url;
-  it_url = find(current_media_fetchers_.begin(),
-      current_media_fetchers_.end(), url.spec());
-  if (it_url != current_media_fetchers_.end()) {
-    current_media_fetchers_.erase(it_url);
-  }
-
-  std::vector<BitmapFetcherService::RequestId>::iterator it_ids;
-  it_ids = find(request_ids_.begin(), request_ids_.end(), request_id);
-  if (it_ids != request_ids_.end()) {
-    request_ids_.erase(it_ids);
-  }
+          AsWeakPtr(), favicon_url.spec(), std::move(callbacks)));
 }
 
 void RewardsServiceImpl::OnSetOnDemandFaviconComplete(
     const std::string& favicon_url,
-    ledger::FetchIconCallback callback, bool success) {
+    std::vector<ledger::FetchIconCallback> callbacks,
+    bool success) {
   if (!Connected())
     return;
 
-  callback(success, favicon_url);
+  for (const auto& callback : callbacks) {
+    callback(success, favicon_url);
+  }
+}
+
+void RewardsServiceImpl::OnFaviconCacheLoaded(const std::string& data) {
+  // Icons fetched before the load finished are newer than the file.
+  if (data.empty() || favicon_cache_.size() > 0)
+    return;
+
+  if (!favicon_cache_.FromJSON(data)) {
+    LOG(ERROR) << "Failed to parse the favicon cache";
+  }
+}
+
+void RewardsServiceImpl::SaveFaviconCache() {
+  file_task_runner_->PostTask(FROM_HERE,
+      base::BindOnce(base::IgnoreResult(&SaveFaviconCacheOnFileTaskRunner),
+                     favicon_cache_path_,
+                     favicon_cache_.ToJSON()));
 }
 
 void RewardsServiceImpl::GetPublisherBanner(
     const std::string& publisher_id,
     GetPublisherBannerCallback callback) {
+  auto cached = publisher_banner_cache_.Get(publisher_id);
+  if (cached != publisher_banner_cache_.end()) {
+    std::move(callback).Run(
+        std::make_unique<brave_rewards::PublisherBanner>(cached->second));
+    return;
+  }
+
   if (!Connected())
     return;
 
   bat_ledger_->GetPublisherBanner(publisher_id,
       base::BindOnce(&RewardsServiceImpl::OnPublisherBanner,
                      AsWeakPtr(),
+                     publisher_id,
+                     publisher_list_version_,
                      std::move(callback)));
 }
 
 void RewardsServiceImpl::OnPublisherBanner(
+    const std::string& publisher_id,
+    uint32_t publisher_list_version,
     GetPublisherBannerCallback callback,
     const std::string& banner) {
   std::unique_ptr<brave_rewards::PublisherBanner> new_banner;
@@ -2141,6 +2645,9 @@ void RewardsServiceImpl::OnPublisherBanner(
   new_banner->provider = publisher_banner->provider;
   new_banner->verified = publisher_banner->verified;
 
+  if (!banner.empty() && publisher_list_version == publisher_list_version_)
+    publisher_banner_cache_.Put(publisher_id, *new_banner);
+
   std::move(callback).Run(std::move(new_banner));
 }
 
@@ -2203,12 +2710,12 @@ void RewardsServiceImpl::SaveContributionInfo(const std::string& probi,
   info.category = category;
 
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&SaveContributionInfoOnFileTaskRunner,
-                    info,
-                    publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnContributionInfoSaved,
-                     AsWeakPtr(),
-                     category));
+      base::BindOnce(&SaveContributionInfoOnFileTaskRunner,
+                     info,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "SaveContributionInfo",
+          base::BindOnce(&RewardsServiceImpl::OnContributionInfoSaved,
+              AsWeakPtr(), category)));
 }
 
 bool SaveRecurringTipOnFileTaskRunner(
@@ -2234,11 +2741,12 @@ void RewardsServiceImpl::SaveRecurringTip(
   info.added_date = GetCurrentTimestamp();
 
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&SaveRecurringTipOnFileTaskRunner,
-                    info,
-                    publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnRecurringTipSaved,
-                     AsWeakPtr()));
+      base::BindOnce(&SaveRecurringTipOnFileTaskRunner,
+                     info,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "SaveRecurringTip",
+          base::BindOnce(&RewardsServiceImpl::OnRecurringTipSaved,
+              AsWeakPtr())));
 }
 
 void RewardsServiceImpl::OnTwitterPublisherInfoSaved(
@@ -2302,10 +2810,16 @@ void RewardsServiceImpl::OnGetRecurringTipsUI(
 
 void RewardsServiceImpl::GetRecurringTipsUI(
     GetRecurringTipsCallback callback) {
+  if (!Connected()) {
+    std::move(callback).Run(std::make_unique<brave_rewards::ContentSiteList>());
+    return;
+  }
+
   bat_ledger_->GetRecurringTips(
-      base::BindOnce(&RewardsServiceImpl::OnGetRecurringTipsUI,
-                     AsWeakPtr(),
-                     std::move(callback)));
+      perf_stats_.Time(RewardsPerfStats::MOJO, "GetRecurringTips",
+          base::BindOnce(&RewardsServiceImpl::OnGetRecurringTipsUI,
+                         AsWeakPtr(),
+                         std::move(callback))));
 }
 
 void RewardsServiceImpl::OnGetRecurringTips(
@@ -2321,11 +2835,11 @@ void RewardsServiceImpl::OnGetRecurringTips(
 void RewardsServiceImpl::GetRecurringTips(
     ledger::PublisherInfoListCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&GetRecurringTipsOnFileTaskRunner,
-                 publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnGetRecurringTips,
-                 AsWeakPtr(),
-                 callback));
+      base::BindOnce(&GetRecurringTipsOnFileTaskRunner,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "GetRecurringTips",
+          base::BindOnce(&RewardsServiceImpl::OnGetRecurringTips,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnGetOneTimeTipsUI(
@@ -2345,9 +2859,10 @@ void RewardsServiceImpl::OnGetOneTimeTipsUI(
 
 void RewardsServiceImpl::GetOneTimeTipsUI(GetOneTimeTipsCallback callback) {
   bat_ledger_->GetOneTimeTips(
-      base::BindOnce(&RewardsServiceImpl::OnGetOneTimeTipsUI,
-                     AsWeakPtr(),
-                     std::move(callback)));
+      perf_stats_.Time(RewardsPerfStats::MOJO, "GetOneTimeTips",
+          base::BindOnce(&RewardsServiceImpl::OnGetOneTimeTipsUI,
+                         AsWeakPtr(),
+                         std::move(callback))));
 }
 
 ledger::PublisherInfoList GetOneTimeTipsOnFileTaskRunner(
@@ -2366,11 +2881,11 @@ ledger::PublisherInfoList GetOneTimeTipsOnFileTaskRunner(
 void RewardsServiceImpl::GetOneTimeTips(
     ledger::PublisherInfoListCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&GetOneTimeTipsOnFileTaskRunner,
-                 publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnGetOneTimeTips,
-                 AsWeakPtr(),
-                 callback));
+      base::BindOnce(&GetOneTimeTipsOnFileTaskRunner,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "GetOneTimeTips",
+          base::BindOnce(&RewardsServiceImpl::OnGetOneTimeTips,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnGetOneTimeTips(
@@ -2414,11 +2929,12 @@ void RewardsServiceImpl::OnRemovedRecurringTip(
 void RewardsServiceImpl::OnRemoveRecurring(const std::string& publisher_key,
     ledger::RecurringRemoveCallback callback) {
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
-      base::Bind(&RemoveRecurringTipOnFileTaskRunner,
-                    publisher_key,
-                    publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnRemovedRecurringTip,
-                     AsWeakPtr(), callback));
+      base::BindOnce(&RemoveRecurringTipOnFileTaskRunner,
+                     publisher_key,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "RemoveRecurringTip",
+          base::BindOnce(&RewardsServiceImpl::OnRemovedRecurringTip,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::TriggerOnGetCurrentBalanceReport(
@@ -2657,8 +3173,9 @@ void RewardsServiceImpl::SetBackupCompleted() {
 void RewardsServiceImpl::GetRewardsInternalsInfo(
     GetRewardsInternalsInfoCallback callback) {
   bat_ledger_->GetRewardsInternalsInfo(
-      base::BindOnce(&RewardsServiceImpl::OnGetRewardsInternalsInfo,
-                     AsWeakPtr(), std::move(callback)));
+      perf_stats_.Time(RewardsPerfStats::MOJO, "GetRewardsInternalsInfo",
+          base::BindOnce(&RewardsServiceImpl::OnGetRewardsInternalsInfo,
+                         AsWeakPtr(), std::move(callback))));
 }
 
 void RewardsServiceImpl::OnTip(
@@ -2776,15 +3293,21 @@ void RewardsServiceImpl::SavePendingContribution(
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
-      base::Bind(&SavePendingContributionOnFileTaskRunner,
-                 publisher_info_backend_.get(),
-                 std::move(list)),
-      base::Bind(&RewardsServiceImpl::OnSavePendingContribution,
-                 AsWeakPtr()));
+      base::BindOnce(&SavePendingContributionOnFileTaskRunner,
+                     publisher_info_backend_.get(),
+                     std::move(list)),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "SavePendingContribution",
+          base::BindOnce(&RewardsServiceImpl::OnSavePendingContribution,
+              AsWeakPtr())));
 }
 
 void RewardsServiceImpl::GetPendingContributionsTotalUI(
     const GetPendingContributionsTotalCallback& callback) {
+  if (!Connected()) {
+    callback.Run(0.0);
+    return;
+  }
+
   bat_ledger_->GetPendingContributionsTotal(std::move(callback));
 }
 
@@ -2813,11 +3336,12 @@ void RewardsServiceImpl::GetPendingContributionsTotal(
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
-      base::Bind(&PendingContributionsTotalOnFileTaskRunner,
-                 publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnGetPendingContributionsTotal,
-                 AsWeakPtr(),
-                 callback));
+      base::BindOnce(&PendingContributionsTotalOnFileTaskRunner,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE,
+          "GetPendingContributionsTotal",
+          base::BindOnce(&RewardsServiceImpl::OnGetPendingContributionsTotal,
+              AsWeakPtr(), callback)));
 }
 
 bool RestorePublisherOnFileTaskRunner(PublisherInfoDatabase* backend) {
@@ -2833,11 +3357,11 @@ void RewardsServiceImpl::OnRestorePublishers(
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
-      base::Bind(&RestorePublisherOnFileTaskRunner,
-                 publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnRestorePublishersInternal,
-                 AsWeakPtr(),
-                 callback));
+      base::BindOnce(&RestorePublisherOnFileTaskRunner,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "RestorePublishers",
+          base::BindOnce(&RewardsServiceImpl::OnRestorePublishersInternal,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnRestorePublishersInternal(
@@ -2853,7 +3377,7 @@ bool SaveNormalizedPublisherListOnFileTaskRunner(
     return false;
   }
 
-  return backend->InsertOrUpdateActivityInfos(list);
+  return backend->UpdateActivityInfoShares(list);
 }
 
 void RewardsServiceImpl::SaveNormalizedPublisherList(
@@ -2873,9 +3397,10 @@ void RewardsServiceImpl::SaveNormalizedPublisherList(
       base::BindOnce(&SaveNormalizedPublisherListOnFileTaskRunner,
                      publisher_info_backend_.get(),
                      std::move(list)),
-      base::BindOnce(&RewardsServiceImpl::OnPublisherListNormalizedSaved,
-                     AsWeakPtr(),
-                     std::move(site_list)));
+      perf_stats_.Time(RewardsPerfStats::DATABASE,
+          "SaveNormalizedPublisherList",
+          base::BindOnce(&RewardsServiceImpl::OnPublisherListNormalizedSaved,
+              AsWeakPtr(), std::move(site_list))));
 }
 
 void RewardsServiceImpl::OnPublisherListNormalizedSaved(
@@ -2928,13 +3453,13 @@ void RewardsServiceImpl::OnDeleteActivityInfoStamp(
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
-      base::Bind(&DeleteActivityInfoOnFileTaskRunner,
-                 publisher_info_backend_.get(),
-                 publisher_key,
-                 reconcile_stamp),
-      base::Bind(&RewardsServiceImpl::OnDeleteActivityInfo,
-                 AsWeakPtr(),
-                 publisher_key));
+      base::BindOnce(&DeleteActivityInfoOnFileTaskRunner,
+                     publisher_info_backend_.get(),
+                     publisher_key,
+                     reconcile_stamp),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "DeleteActivityInfo",
+          base::BindOnce(&RewardsServiceImpl::OnDeleteActivityInfo,
+              AsWeakPtr(), publisher_key)));
 }
 
 void RewardsServiceImpl::OnDeleteActivityInfo(
@@ -3076,11 +3601,11 @@ void RewardsServiceImpl::GetPendingContributions(
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
-      base::Bind(&PendingContributionsOnFileTaskRunner,
-                 publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnGetPendingContributions,
-                 AsWeakPtr(),
-                 callback));
+      base::BindOnce(&PendingContributionsOnFileTaskRunner,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "GetPendingContributions",
+          base::BindOnce(&RewardsServiceImpl::OnGetPendingContributions,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnPendingContributionRemovedUI(int32_t result) {
@@ -3123,14 +3648,14 @@ void RewardsServiceImpl::RemovePendingContribution(
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
-      base::Bind(&RemovePendingContributionOnFileTaskRunner,
-                 publisher_info_backend_.get(),
-                 publisher_key,
-                 viewing_id,
-                 added_date),
-      base::Bind(&RewardsServiceImpl::OnPendingContributionRemoved,
-                 AsWeakPtr(),
-                 callback));
+      base::BindOnce(&RemovePendingContributionOnFileTaskRunner,
+                     publisher_info_backend_.get(),
+                     publisher_key,
+                     viewing_id,
+                     added_date),
+      perf_stats_.Time(RewardsPerfStats::DATABASE, "RemovePendingContribution",
+          base::BindOnce(&RewardsServiceImpl::OnPendingContributionRemoved,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::OnPendingContributionRemoved(
@@ -3179,11 +3704,12 @@ void RewardsServiceImpl::RemoveAllPendingContributions(
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
       FROM_HERE,
-      base::Bind(&RemoveAllPendingContributionOnFileTaskRunner,
-                 publisher_info_backend_.get()),
-      base::Bind(&RewardsServiceImpl::OnRemoveAllPendingContribution,
-                 AsWeakPtr(),
-                 callback));
+      base::BindOnce(&RemoveAllPendingContributionOnFileTaskRunner,
+                     publisher_info_backend_.get()),
+      perf_stats_.Time(RewardsPerfStats::DATABASE,
+          "RemoveAllPendingContributions",
+          base::BindOnce(&RewardsServiceImpl::OnRemoveAllPendingContribution,
+              AsWeakPtr(), callback)));
 }
 
 void RewardsServiceImpl::GetCountryCodes(
@@ -13,12 +13,16 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/circular_deque.h"
 #include "base/containers/flat_set.h"
+#include "base/containers/mru_cache.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/wallet_info.h"
 #include "base/files/file_path.h"
 #include "base/observer_list.h"
 #include "base/one_shot_event.h"
+#include "base/optional.h"
+#include "base/time/time.h"
 #include "base/memory/weak_ptr.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
@@ -30,9 +34,14 @@
 #include "brave/components/brave_rewards/browser/balance_report.h"
 #include "brave/components/brave_rewards/browser/content_site.h"
 #include "brave/components/brave_rewards/browser/contribution_info.h"
+#include "brave/components/brave_rewards/browser/favicon_cache.h"
 #include "ui/gfx/image/image.h"
 #include "brave/components/brave_rewards/browser/publisher_banner.h"
+#include "brave/components/brave_rewards/browser/rewards_perf_stats.h"
 #include "brave/components/brave_rewards/browser/rewards_service_private_observer.h"
+#include "brave/components/brave_rewards/browser/timer_wheel.h"
+#include "brave/components/brave_rewards/browser/url_response_cache.h"
+#include "brave/components/brave_rewards/browser/visit_tracker.h"
 
 #if BUILDFLAG(ENABLE_EXTENSIONS)
 #include "brave/components/brave_rewards/browser/extension_rewards_service_observer.h"
@@ -64,6 +73,7 @@ class BraveRewardsBrowserTest;
 
 namespace brave_rewards {
 
+class JournaledStateStore;
 class PublisherInfoDatabase;
 class RewardsNotificationServiceImpl;
 class BraveRewardsBrowserTest;
@@ -90,6 +100,7 @@ class RewardsServiceImpl : public RewardsService,
 
   void Init();
   void StartLedger();
+  void WakeLedger() override;
   void CreateWallet() override;
   void FetchWalletProperties() override;
   void FetchGrants(const std::string& lang,
@@ -167,7 +178,9 @@ class RewardsServiceImpl : public RewardsService,
       const GetContributionAmountCallback& callback) override;
   void GetPublisherBanner(const std::string& publisher_id,
                           GetPublisherBannerCallback callback) override;
-  void OnPublisherBanner(GetPublisherBannerCallback callback,
+  void OnPublisherBanner(const std::string& publisher_id,
+                         uint32_t publisher_list_version,
+                         GetPublisherBannerCallback callback,
                          const std::string& banner);
   void RemoveRecurringTip(const std::string& publisher_key) override;
   void OnGetRecurringTipsUI(
@@ -252,6 +265,14 @@ class RewardsServiceImpl : public RewardsService,
  private:
   friend class ::BraveRewardsBrowserTest;
   FRIEND_TEST_ALL_PREFIXES(RewardsServiceTest, OnWalletProperties);
+  FRIEND_TEST_ALL_PREFIXES(RewardsServiceTest, StartsDormantWhenDisabled);
+  FRIEND_TEST_ALL_PREFIXES(RewardsServiceTest,
+                           PanelStateGettersReplyWhileDisconnected);
+  FRIEND_TEST_ALL_PREFIXES(RewardsServiceTest, QueuedLedgerEventsAreCapped);
+  FRIEND_TEST_ALL_PREFIXES(RewardsServiceTest,
+                           VisitsAreQueuedWhileLedgerRestarts);
+  FRIEND_TEST_ALL_PREFIXES(RewardsServiceTest,
+                           StateSnapshotIsKeptUntilReset);
 
   const base::OneShotEvent& ready() const { return ready_; }
   void OnLedgerStateSaved(ledger::LedgerCallbackHandler* handler,
@@ -317,6 +338,7 @@ class RewardsServiceImpl : public RewardsService,
                         ledger::PublisherInfoList list);
   void OnRemovedRecurringTip(ledger::RecurringRemoveCallback callback,
                           bool success);
+  void OnBalanceReportsSaved(ledger::OnSaveCallback callback, bool success);
   void OnRemoveRecurring(const std::string& publisher_key,
                          ledger::RecurringRemoveCallback callback) override;
   void TriggerOnGetCurrentBalanceReport(
@@ -369,12 +391,31 @@ class RewardsServiceImpl : public RewardsService,
     ledger::PendingContributionInfoList list);
 
   void OnURLLoaderComplete(network::SimpleURLLoader* loader,
+                           const std::string& cache_key,
+                           const std::string& endpoint,
+                           base::TimeTicks start_time,
                            ledger::LoadURLCallback callback,
                            std::unique_ptr<std::string> response_body);
 
   void StartNotificationTimers(bool main_enabled);
   void StopNotificationTimers();
   void OnNotificationTimerFired();
+  void OnVacuumTimerFired();
+  void OnVacuumStep(bool more_pages);
+
+  void QueueMediaEvent(SessionID tab_id,
+                       bat_ledger::mojom::MediaEventPtr event);
+  // Sends the media events queued for |tab_id| so they reach the ledger
+  // before the tab's next load, show or hide event.
+  void FlushMediaEvents(SessionID tab_id);
+  void FlushAllMediaEvents();
+  void SendMediaEvents(SessionID::id_type tab_id,
+                       std::vector<bat_ledger::mojom::MediaEventPtr> events);
+  void SendMediaStartOrStop(SessionID tab_id, bool start, uint64_t timestamp);
+  void OnVisitEnded(const ledger::VisitData& visit_data, uint64_t duration);
+  // Holds |event| until the restarted ledger has initialized.
+  void QueueLedgerEvent(base::OnceClosure event);
+  void SendQueuedLedgerEvents();
 
   void MaybeShowNotificationAddFunds();
   bool ShouldShowNotificationAddFunds() const;
@@ -458,14 +499,17 @@ class RewardsServiceImpl : public RewardsService,
   void FetchFavIcon(const std::string& url,
                     const std::string& favicon_key,
                     ledger::FetchIconCallback callback) override;
-  void OnFetchFavIconCompleted(ledger::FetchIconCallback callback,
-                          const std::string& favicon_key,
-                          const GURL& url,
-                          const BitmapFetcherService::RequestId& request_id,
-                          const SkBitmap& image);
-  void OnSetOnDemandFaviconComplete(const std::string& favicon_url,
-                                    ledger::FetchIconCallback callback,
-                                    bool success);
+  void OnFetchFavIconCompleted(
+      const std::string& favicon_key,
+      const GURL& url,
+      const BitmapFetcherService::RequestId& request_id,
+      const SkBitmap& image);
+  void OnSetOnDemandFaviconComplete(
+      const std::string& favicon_url,
+      std::vector<ledger::FetchIconCallback> callbacks,
+      bool success);
+  void OnFaviconCacheLoaded(const std::string& data);
+  void SaveFaviconCache();
   void SaveContributionInfo(const std::string& probi,
                             const int month,
                             const int year,
@@ -474,6 +518,13 @@ class RewardsServiceImpl : public RewardsService,
                             const ledger::REWARDS_CATEGORY category) override;
   void GetRecurringTips(
       ledger::PublisherInfoListCallback callback) override;
+  void AddBalanceReportItem(ledger::ACTIVITY_MONTH month,
+                            int year,
+                            ledger::ReportType type,
+                            const std::string& probi) override;
+  void SaveBalanceReports(
+      const std::map<std::string, ledger::BalanceReportInfo>& reports,
+      ledger::OnSaveCallback callback) override;
   std::unique_ptr<ledger::LogStream> Log(
                      const char* file,
                      int line,
@@ -531,9 +582,9 @@ class RewardsServiceImpl : public RewardsService,
       const std::string& transactions);
   void OnGetAllBalanceReports(
       const GetAllBalanceReportsCallback& callback,
-      const base::flat_map<std::string, std::string>& json_reports);
+      const std::map<std::string, ledger::BalanceReportInfo>& reports);
   void OnGetCurrentBalanceReport(
-      bool success, const std::string& json_report);
+      std::unique_ptr<ledger::BalanceReportInfo> report);
   void OnGetAddresses(
       const GetAddressesCallback& callback,
       const base::flat_map<std::string, std::string>& addresses);
@@ -557,6 +608,7 @@ class RewardsServiceImpl : public RewardsService,
 
   bool Connected() const;
   void ConnectionClosed();
+  void StartLedgerAndLoadCaches();
 
   Profile* profile_;  // NOT OWNED
   mojo::AssociatedBinding<bat_ledger::mojom::BatLedgerClient>
@@ -574,7 +626,11 @@ class RewardsServiceImpl : public RewardsService,
   const base::FilePath publisher_info_db_path_;
   const base::FilePath publisher_list_path_;
   const base::FilePath rewards_base_path_;
+  const base::FilePath favicon_cache_path_;
   std::unique_ptr<PublisherInfoDatabase> publisher_info_backend_;
+  // Used on |file_task_runner_|.
+  std::unique_ptr<JournaledStateStore> ledger_state_store_;
+  std::unique_ptr<JournaledStateStore> publisher_state_store_;
   std::unique_ptr<RewardsNotificationServiceImpl> notification_service_;
   base::ObserverList<RewardsServicePrivateObserver> private_observers_;
 #if BUILDFLAG(ENABLE_EXTENSIONS)
@@ -582,14 +638,44 @@ class RewardsServiceImpl : public RewardsService,
 #endif
 
   base::OneShotEvent ready_;
+  // Set while rewards is disabled and the ledger has not been started
+  bool dormant_;
+  base::TimeTicks dormant_start_time_;
   base::flat_set<network::SimpleURLLoader*> url_loaders_;
-  std::map<uint32_t, std::unique_ptr<base::OneShotTimer>> timers_;
-  std::vector<std::string> current_media_fetchers_;
+  // Callbacks waiting on an in-flight GET, keyed by
+  // URLResponseCache::KeyFor().
+  std::map<std::string, std::vector<ledger::LoadURLCallback>>
+      pending_url_loads_;
+  URLResponseCache url_response_cache_;
+  RewardsPerfStats perf_stats_;
+  // Callbacks waiting on the favicon fetch for each url.
+  std::map<std::string, std::vector<ledger::FetchIconCallback>>
+      pending_favicon_fetches_;
+  FaviconCache favicon_cache_;
+  // Banners already built by the ledger, so that the tip dialog and panel
+  // don't look the same publisher up each time they open. Entries are
+  // dropped when the server publisher list or the publisher is saved.
+  base::MRUCache<std::string, PublisherBanner> publisher_banner_cache_;
+  // Bumped whenever the server publisher list is saved, so that banners
+  // requested before that aren't cached.
+  uint32_t publisher_list_version_;
   std::vector<BitmapFetcherService::RequestId> request_ids_;
   std::unique_ptr<base::OneShotTimer> notification_startup_timer_;
   std::unique_ptr<base::RepeatingTimer> notification_periodic_timer_;
-
-  uint32_t next_timer_id_;
+  TimerWheel timer_wheel_;
+  std::unique_ptr<base::OneShotTimer> media_events_timer_;
+  std::unique_ptr<base::RepeatingTimer> vacuum_timer_;
+  std::map<SessionID::id_type, std::vector<bat_ledger::mojom::MediaEventPtr>>
+      pending_media_events_;
+  VisitTracker visit_tracker_;
+  // Set from a lost connection to the utility until the ledger it is
+  // restarted with has initialized.
+  bool ledger_restarting_;
+  base::circular_deque<base::OnceClosure> queued_ledger_events_;
+  // Last state loaded or saved by the ledger, handed straight back to it when
+  // its utility is restarted.
+  base::Optional<std::string> ledger_state_snapshot_;
+  base::Optional<std::string> publisher_state_snapshot_;
 
   GetTestResponseCallback test_response_callback_;
   std::string current_country_for_test_;
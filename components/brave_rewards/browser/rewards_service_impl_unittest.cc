@@ -4,14 +4,19 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <map>
+#include <memory>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/files/scoped_temp_dir.h"
 #include "brave/components/brave_rewards/browser/wallet_properties.h"
 #include "brave/components/brave_rewards/browser/rewards_service_factory.h"
 #include "brave/components/brave_rewards/browser/rewards_service_impl.h"
 #include "brave/components/brave_rewards/browser/rewards_service_observer.h"
 #include "brave/components/brave_rewards/browser/test_util.h"
+#include "brave/components/brave_rewards/common/pref_names.h"
 #include "chrome/browser/profiles/profile.h"
+#include "components/prefs/pref_service.h"
 #include "content/public/test/test_browser_thread_bundle.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -101,6 +106,103 @@ TEST_F(RewardsServiceTest, OnWalletProperties) {
   rewards_service()->OnWalletProperties(ledger::Result::LEDGER_ERROR, nullptr);
 }
 
+TEST_F(RewardsServiceTest, StartsDormantWhenDisabled) {
+  PrefService* pref_service = profile()->GetPrefs();
+  pref_service->SetBoolean(prefs::kBraveRewardsEnabledMigrated, true);
+  pref_service->SetBoolean(prefs::kBraveRewardsEnabled, false);
+
+  RewardsServiceImpl rewards_service(profile());
+  rewards_service.Init();
+  EXPECT_TRUE(rewards_service.dormant_);
+  EXPECT_FALSE(rewards_service.Connected());
+
+  // Answered without waking the ledger
+  bool enabled = true;
+  rewards_service.GetRewardsMainEnabled(base::Bind(
+      [](bool* enabled, bool value) { *enabled = value; }, &enabled));
+  EXPECT_FALSE(enabled);
+  EXPECT_TRUE(rewards_service.dormant_);
+
+  rewards_service.WakeLedger();
+  EXPECT_FALSE(rewards_service.dormant_);
+  rewards_service.Shutdown();
+}
+
+TEST_F(RewardsServiceTest, PanelStateGettersReplyWhileDisconnected) {
+  ASSERT_FALSE(rewards_service()->Connected());
+
+  // braveRewards.getPanelState only replies once all of these have
+  int replies = 0;
+  rewards_service()->GetRewardsMainEnabled(base::Bind(
+      [](int* replies, bool enabled) {
+        EXPECT_FALSE(enabled);
+        (*replies)++;
+      }, &replies));
+  rewards_service()->GetAutoContribute(base::BindOnce(
+      [](int* replies, bool enabled) {
+        EXPECT_FALSE(enabled);
+        (*replies)++;
+      }, &replies));
+  rewards_service()->GetPendingContributionsTotalUI(base::Bind(
+      [](int* replies, double amount) {
+        EXPECT_EQ(amount, 0.0);
+        (*replies)++;
+      }, &replies));
+  rewards_service()->GetRecurringTipsUI(base::BindOnce(
+      [](int* replies, std::unique_ptr<ContentSiteList> list) {
+        ASSERT_TRUE(list);
+        EXPECT_TRUE(list->empty());
+        (*replies)++;
+      }, &replies));
+  EXPECT_EQ(replies, 4);
+}
+
+TEST_F(RewardsServiceTest, QueuedLedgerEventsAreCapped) {
+  std::vector<int> sent;
+  for (int i = 0; i < 1001; i++) {
+    rewards_service()->QueueLedgerEvent(base::BindOnce(
+        [](std::vector<int>* sent, int i) { sent->push_back(i); }, &sent, i));
+  }
+
+  rewards_service()->SendQueuedLedgerEvents();
+
+  // The oldest event is dropped, the rest are sent in order
+  ASSERT_EQ(sent.size(), 1000u);
+  EXPECT_EQ(sent.front(), 1);
+  EXPECT_EQ(sent.back(), 1000);
+  EXPECT_TRUE(rewards_service()->queued_ledger_events_.empty());
+}
+
+TEST_F(RewardsServiceTest, VisitsAreQueuedWhileLedgerRestarts) {
+  rewards_service()->ledger_restarting_ = true;
+
+  ledger::VisitData visit_data;
+  visit_data.tld = "brave.com";
+  rewards_service()->OnVisitEnded(visit_data, 10);
+  rewards_service()->OnVisitEnded(visit_data, 20);
+  EXPECT_EQ(rewards_service()->queued_ledger_events_.size(), 2u);
+
+  // Sent events go to the ledger instead of being queued again
+  rewards_service()->ledger_restarting_ = false;
+  rewards_service()->SendQueuedLedgerEvents();
+  EXPECT_TRUE(rewards_service()->queued_ledger_events_.empty());
+}
+
+TEST_F(RewardsServiceTest, StateSnapshotIsKeptUntilReset) {
+  rewards_service()->SaveLedgerState("{\"ledger\":1}", nullptr);
+  rewards_service()->SavePublisherState("{\"publisher\":1}", nullptr);
+  ASSERT_TRUE(rewards_service()->ledger_state_snapshot_);
+  EXPECT_EQ(*rewards_service()->ledger_state_snapshot_, "{\"ledger\":1}");
+  ASSERT_TRUE(rewards_service()->publisher_state_snapshot_);
+  EXPECT_EQ(*rewards_service()->publisher_state_snapshot_,
+            "{\"publisher\":1}");
+
+  rewards_service()->ResetState("ledger_state",
+                                [](ledger::Result result) {});
+  EXPECT_FALSE(rewards_service()->ledger_state_snapshot_);
+  EXPECT_FALSE(rewards_service()->publisher_state_snapshot_);
+}
+
 // add test for strange entries
 
 }  // namespace brave_rewards
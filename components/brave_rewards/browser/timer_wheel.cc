@@ -0,0 +1,113 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/timer_wheel.h"
+
+#include <limits>
+
+#include "base/bind.h"
+#include "base/logging.h"
+
+namespace brave_rewards {
+
+TimerWheel::Timer::Timer() {
+}
+
+TimerWheel::Timer::Timer(Timer&& other) = default;
+
+TimerWheel::Timer::~Timer() {
+}
+
+TimerWheel::TimerWheel(base::TimeDelta granularity)
+    : granularity_(granularity),
+      next_timer_id_(0) {
+  DCHECK(granularity_ > base::TimeDelta());
+}
+
+TimerWheel::~TimerWheel() {
+}
+
+uint32_t TimerWheel::Start(base::TimeDelta delay, Callback callback) {
+  do {
+    if (next_timer_id_ == std::numeric_limits<uint32_t>::max())
+      next_timer_id_ = 1;
+    else
+      ++next_timer_id_;
+  } while (timers_.find(next_timer_id_) != timers_.end());
+
+  Timer timer;
+  timer.slot = SlotFor(base::TimeTicks::Now() + delay);
+  timer.callback = std::move(callback);
+  slots_.emplace(timer.slot, next_timer_id_);
+  timers_.emplace(next_timer_id_, std::move(timer));
+
+  Schedule();
+  return next_timer_id_;
+}
+
+void TimerWheel::Stop(uint32_t timer_id) {
+  auto it = timers_.find(timer_id);
+  if (it == timers_.end())
+    return;
+
+  slots_.erase(std::make_pair(it->second.slot, timer_id));
+  timers_.erase(it);
+  Schedule();
+}
+
+void TimerWheel::StopAll() {
+  timers_.clear();
+  slots_.clear();
+  wakeup_.Stop();
+}
+
+bool TimerWheel::IsRunning(uint32_t timer_id) const {
+  return timers_.find(timer_id) != timers_.end();
+}
+
+base::TimeTicks TimerWheel::SlotFor(base::TimeTicks deadline) const {
+  const int64_t slot_us = granularity_.InMicroseconds();
+  const int64_t deadline_us = (deadline - base::TimeTicks()).InMicroseconds();
+  const int64_t slot = (deadline_us + slot_us - 1) / slot_us;
+  return base::TimeTicks() + base::TimeDelta::FromMicroseconds(slot * slot_us);
+}
+
+void TimerWheel::Schedule() {
+  if (slots_.empty()) {
+    wakeup_.Stop();
+    return;
+  }
+
+  const base::TimeTicks next_slot = slots_.begin()->first;
+  if (wakeup_.IsRunning() && scheduled_slot_ == next_slot)
+    return;
+
+  scheduled_slot_ = next_slot;
+  const base::TimeDelta delay = next_slot - base::TimeTicks::Now();
+  wakeup_.Start(FROM_HERE,
+      delay > base::TimeDelta() ? delay : base::TimeDelta(),
+      base::BindOnce(&TimerWheel::OnWakeup, base::Unretained(this)));
+}
+
+void TimerWheel::OnWakeup() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+
+  // Callbacks may start or stop other timers, so take one at a time.
+  while (!slots_.empty() && slots_.begin()->first <= now) {
+    const uint32_t timer_id = slots_.begin()->second;
+    slots_.erase(slots_.begin());
+
+    auto it = timers_.find(timer_id);
+    DCHECK(it != timers_.end());
+    Callback callback = std::move(it->second.callback);
+    timers_.erase(it);
+
+    std::move(callback).Run(timer_id);
+  }
+
+  Schedule();
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,73 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_TIMER_WHEEL_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <set>
+#include <utility>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace brave_rewards {
+
+// Runs any number of one-shot timers off a single OS timer.
+//
+// Deadlines are rounded up to slots of |granularity|, and every timer in a
+// slot fires from the same wakeup, so timers set close together cost one
+// wakeup instead of one each. Timers never fire early; they may fire up to
+// |granularity| late.
+class TimerWheel {
+ public:
+  // Called with the id returned by Start().
+  using Callback = base::OnceCallback<void(uint32_t)>;
+
+  explicit TimerWheel(base::TimeDelta granularity);
+  ~TimerWheel();
+
+  // Returns a non-zero id that can be passed to Stop().
+  uint32_t Start(base::TimeDelta delay, Callback callback);
+
+  // Does nothing if |timer_id| already fired or was stopped.
+  void Stop(uint32_t timer_id);
+  void StopAll();
+
+  bool IsRunning(uint32_t timer_id) const;
+  size_t size() const { return timers_.size(); }
+
+ private:
+  struct Timer {
+    Timer();
+    Timer(Timer&& other);
+    ~Timer();
+
+    base::TimeTicks slot;
+    Callback callback;
+  };
+
+  base::TimeTicks SlotFor(base::TimeTicks deadline) const;
+  void Schedule();
+  void OnWakeup();
+
+  const base::TimeDelta granularity_;
+  std::map<uint32_t, Timer> timers_;
+  std::set<std::pair<base::TimeTicks, uint32_t>> slots_;
+  base::OneShotTimer wakeup_;
+  base::TimeTicks scheduled_slot_;
+  uint32_t next_timer_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_TIMER_WHEEL_H_
@@ -0,0 +1,84 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/timer_wheel.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=TimerWheelTest.*
+
+namespace brave_rewards {
+
+class TimerWheelTest : public testing::Test {
+ public:
+  TimerWheelTest()
+      : scoped_task_environment_(
+            base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME,
+            base::test::ScopedTaskEnvironment::NowSource::
+                MAIN_THREAD_MOCK_TIME),
+        wheel_(base::TimeDelta::FromSeconds(1)) {
+  }
+
+  void OnTimer(uint32_t timer_id) {
+    fired_.push_back(timer_id);
+  }
+
+  uint32_t Start(int64_t delay_ms) {
+    return wheel_.Start(base::TimeDelta::FromMilliseconds(delay_ms),
+        base::BindOnce(&TimerWheelTest::OnTimer, base::Unretained(this)));
+  }
+
+ protected:
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  TimerWheel wheel_;
+  std::vector<uint32_t> fired_;
+};
+
+TEST_F(TimerWheelTest, NeverFiresEarly) {
+  const uint32_t timer_id = Start(2500);
+
+  scoped_task_environment_.FastForwardBy(
+      base::TimeDelta::FromMilliseconds(2400));
+  EXPECT_TRUE(fired_.empty());
+  EXPECT_TRUE(wheel_.IsRunning(timer_id));
+
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  ASSERT_EQ(fired_.size(), 1u);
+  EXPECT_EQ(fired_[0], timer_id);
+  EXPECT_FALSE(wheel_.IsRunning(timer_id));
+  EXPECT_EQ(wheel_.size(), 0u);
+}
+
+TEST_F(TimerWheelTest, CoalescesDeadlinesInOneSlot) {
+  const uint32_t first = Start(100);
+  const uint32_t second = Start(900);
+  const uint32_t later = Start(5000);
+
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  ASSERT_EQ(fired_.size(), 2u);
+  EXPECT_EQ(fired_[0], first);
+  EXPECT_EQ(fired_[1], second);
+
+  // Only the wakeup for |later| is left.
+  EXPECT_EQ(scoped_task_environment_.GetPendingMainThreadTaskCount(), 1u);
+  EXPECT_TRUE(wheel_.IsRunning(later));
+}
+
+TEST_F(TimerWheelTest, StopCancels) {
+  const uint32_t stopped = Start(1000);
+  const uint32_t kept = Start(3000);
+  wheel_.Stop(stopped);
+  wheel_.Stop(stopped);
+
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(5));
+  ASSERT_EQ(fired_.size(), 1u);
+  EXPECT_EQ(fired_[0], kept);
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,102 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/url_response_cache.h"
+
+#include <algorithm>
+
+namespace brave_rewards {
+
+namespace {
+
+constexpr size_t kMaxEntries = 64;
+
+// Bodies larger than this aren't worth keeping in memory.
+constexpr size_t kMaxBodySize = 256 * 1024;
+
+}  // namespace
+
+URLResponseCache::URLResponseCache() {
+}
+
+URLResponseCache::~URLResponseCache() {
+}
+
+// static
+std::string URLResponseCache::KeyFor(const std::string& url,
+                                     const std::vector<std::string>& headers) {
+  std::vector<std::string> sorted_headers(headers);
+  std::sort(sorted_headers.begin(), sorted_headers.end());
+
+  std::string key = url;
+  for (const auto& header : sorted_headers) {
+    key += '\n';
+    key += header;
+  }
+  return key;
+}
+
+bool URLResponseCache::GetETag(const std::string& key,
+                               std::string* etag) const {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+
+  *etag = it->second.etag;
+  return true;
+}
+
+bool URLResponseCache::GetBody(const std::string& key, std::string* body) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+
+  Touch(&it->second);
+  *body = it->second.body;
+  return true;
+}
+
+void URLResponseCache::Put(const std::string& key,
+                           const std::string& etag,
+                           const std::string& body) {
+  if (etag.empty() || body.size() > kMaxBodySize) {
+    Remove(key);
+    return;
+  }
+
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    lru_.push_front(key);
+    it = entries_.emplace(key, Entry()).first;
+    it->second.lru = lru_.begin();
+  } else {
+    Touch(&it->second);
+  }
+  it->second.etag = etag;
+  it->second.body = body;
+
+  while (entries_.size() > kMaxEntries) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+}
+
+void URLResponseCache::Remove(const std::string& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return;
+  }
+
+  lru_.erase(it->second.lru);
+  entries_.erase(it);
+}
+
+void URLResponseCache::Touch(Entry* entry) {
+  lru_.splice(lru_.begin(), lru_, entry->lru);
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,65 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_URL_RESPONSE_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_URL_RESPONSE_CACHE_H_
+
+#include <stddef.h>
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace brave_rewards {
+
+// Remembers the last body returned for ledger GET requests that carried an
+// ETag, so the request can be revalidated with If-None-Match and a 304 can be
+// answered from memory.
+class URLResponseCache {
+ public:
+  URLResponseCache();
+  ~URLResponseCache();
+
+  // Identifies a GET by its url and request headers. Requests with the same
+  // key can share one network fetch.
+  static std::string KeyFor(const std::string& url,
+                            const std::vector<std::string>& headers);
+
+  // Sets |etag| to the validator for |key|, if a response was cached for it.
+  bool GetETag(const std::string& key, std::string* etag) const;
+
+  // Sets |body| to the cached response body for |key|.
+  bool GetBody(const std::string& key, std::string* body);
+
+  void Put(const std::string& key,
+           const std::string& etag,
+           const std::string& body);
+
+  void Remove(const std::string& key);
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    std::string etag;
+    std::string body;
+    std::list<std::string>::iterator lru;
+  };
+
+  void Touch(Entry* entry);
+
+  std::map<std::string, Entry> entries_;
+  // Most recently used keys first.
+  std::list<std::string> lru_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLResponseCache);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_URL_RESPONSE_CACHE_H_
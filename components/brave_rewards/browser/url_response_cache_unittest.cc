@@ -0,0 +1,59 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/url_response_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=URLResponseCacheTest.*
+
+namespace brave_rewards {
+
+TEST(URLResponseCacheTest, KeyIgnoresHeaderOrder) {
+  EXPECT_EQ(URLResponseCache::KeyFor("https://brave.com", {"a: 1", "b: 2"}),
+            URLResponseCache::KeyFor("https://brave.com", {"b: 2", "a: 1"}));
+  EXPECT_NE(URLResponseCache::KeyFor("https://brave.com", {"a: 1"}),
+            URLResponseCache::KeyFor("https://brave.com", {"a: 2"}));
+  EXPECT_NE(URLResponseCache::KeyFor("https://brave.com", {}),
+            URLResponseCache::KeyFor("https://brave.com/", {}));
+}
+
+TEST(URLResponseCacheTest, StoresBodyByETag) {
+  URLResponseCache cache;
+
+  std::string etag;
+  std::string body;
+  EXPECT_FALSE(cache.GetETag("key", &etag));
+
+  cache.Put("key", "\"v1\"", "body");
+  EXPECT_TRUE(cache.GetETag("key", &etag));
+  EXPECT_EQ(etag, "\"v1\"");
+  EXPECT_TRUE(cache.GetBody("key", &body));
+  EXPECT_EQ(body, "body");
+
+  // A response without a validator replaces the cached one.
+  cache.Put("key", "", "other");
+  EXPECT_FALSE(cache.GetETag("key", &etag));
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(URLResponseCacheTest, EvictsLeastRecentlyUsed) {
+  URLResponseCache cache;
+  for (int i = 0; i < 64; i++) {
+    cache.Put(std::to_string(i), "etag", "body");
+  }
+
+  std::string body;
+  EXPECT_TRUE(cache.GetBody("0", &body));
+  cache.Put("64", "etag", "body");
+
+  std::string etag;
+  EXPECT_EQ(cache.size(), 64u);
+  EXPECT_TRUE(cache.GetETag("0", &etag));
+  EXPECT_FALSE(cache.GetETag("1", &etag));
+  EXPECT_TRUE(cache.GetETag("64", &etag));
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,71 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/visit_tracker.h"
+
+#include <utility>
+
+namespace brave_rewards {
+
+VisitTracker::VisitTracker(VisitCallback callback)
+    : callback_(std::move(callback)),
+      last_tab_active_time_(0),
+      last_shown_tab_id_(-1) {
+}
+
+VisitTracker::~VisitTracker() {
+}
+
+void VisitTracker::OnLoad(const ledger::VisitData& visit_data,
+                          uint64_t current_time) {
+  if (visit_data.domain.empty())
+    return;
+
+  auto iter = current_pages_.find(visit_data.tab_id);
+  if (iter != current_pages_.end() &&
+      iter->second.domain == visit_data.domain) {
+    return;
+  }
+
+  if (last_shown_tab_id_ == visit_data.tab_id)
+    last_tab_active_time_ = current_time;
+  current_pages_[visit_data.tab_id] = visit_data;
+}
+
+void VisitTracker::OnUnload(uint32_t tab_id, uint64_t current_time) {
+  OnHide(tab_id, current_time);
+  current_pages_.erase(tab_id);
+}
+
+void VisitTracker::OnShow(uint32_t tab_id, uint64_t current_time) {
+  last_tab_active_time_ = current_time;
+  last_shown_tab_id_ = tab_id;
+}
+
+void VisitTracker::OnHide(uint32_t tab_id, uint64_t current_time) {
+  if (tab_id != last_shown_tab_id_)
+    return;
+
+  auto iter = current_pages_.find(tab_id);
+  if (iter == current_pages_.end() || last_tab_active_time_ == 0)
+    return;
+
+  const uint64_t duration = current_time - last_tab_active_time_;
+  last_tab_active_time_ = 0;
+  callback_.Run(iter->second, duration);
+}
+
+void VisitTracker::OnForeground(uint32_t tab_id, uint64_t current_time) {
+  if (last_shown_tab_id_ != tab_id)
+    return;
+
+  OnShow(tab_id, current_time);
+}
+
+void VisitTracker::OnBackground(uint32_t tab_id, uint64_t current_time) {
+  OnHide(tab_id, current_time);
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,53 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_VISIT_TRACKER_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_VISIT_TRACKER_H_
+
+#include <stdint.h>
+
+#include <map>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "bat/ledger/ledger.h"
+
+namespace brave_rewards {
+
+// Times how long each tab's page is shown, the same way the ledger does from
+// the tab events the rewards service used to forward to it one by one. Only
+// finished visits are reported, so tab switching doesn't wake the ledger
+// process up for every event.
+//
+// Times are in seconds.
+class VisitTracker {
+ public:
+  // Called with a visit that has ended and how long its page was shown.
+  using VisitCallback =
+      base::RepeatingCallback<void(const ledger::VisitData&, uint64_t)>;
+
+  explicit VisitTracker(VisitCallback callback);
+  ~VisitTracker();
+
+  void OnLoad(const ledger::VisitData& visit_data, uint64_t current_time);
+  void OnUnload(uint32_t tab_id, uint64_t current_time);
+  void OnShow(uint32_t tab_id, uint64_t current_time);
+  void OnHide(uint32_t tab_id, uint64_t current_time);
+  void OnForeground(uint32_t tab_id, uint64_t current_time);
+  void OnBackground(uint32_t tab_id, uint64_t current_time);
+
+ private:
+  VisitCallback callback_;
+  // Keyed by tab id.
+  std::map<uint32_t, ledger::VisitData> current_pages_;
+  uint64_t last_tab_active_time_;
+  uint32_t last_shown_tab_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(VisitTracker);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_VISIT_TRACKER_H_
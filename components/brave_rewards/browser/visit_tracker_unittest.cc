@@ -0,0 +1,116 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/visit_tracker.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=VisitTrackerTest.*
+
+namespace brave_rewards {
+
+class VisitTrackerTest : public testing::Test {
+ public:
+  VisitTrackerTest()
+      : tracker_(base::BindRepeating(&VisitTrackerTest::OnVisit,
+                                     base::Unretained(this))) {
+  }
+
+  void OnVisit(const ledger::VisitData& visit_data, uint64_t duration) {
+    visits_.push_back(std::make_pair(visit_data.domain, duration));
+  }
+
+ protected:
+  ledger::VisitData CreateVisitData(const std::string& domain,
+                                    uint32_t tab_id) {
+    return ledger::VisitData(domain, domain, "/", tab_id, domain,
+                             "https://" + domain + "/", "", "");
+  }
+
+  VisitTracker tracker_;
+  std::vector<std::pair<std::string, uint64_t>> visits_;
+};
+
+TEST_F(VisitTrackerTest, ReportsVisitWhenTabIsHidden) {
+  tracker_.OnShow(1, 100);
+  tracker_.OnLoad(CreateVisitData("brave.com", 1), 105);
+  tracker_.OnHide(1, 125);
+
+  ASSERT_EQ(1u, visits_.size());
+  EXPECT_EQ("brave.com", visits_[0].first);
+  EXPECT_EQ(20u, visits_[0].second);
+}
+
+TEST_F(VisitTrackerTest, IgnoresEventsForOtherTabs) {
+  tracker_.OnShow(1, 100);
+  tracker_.OnLoad(CreateVisitData("brave.com", 1), 100);
+  tracker_.OnLoad(CreateVisitData("example.com", 2), 110);
+  tracker_.OnHide(2, 120);
+  tracker_.OnBackground(2, 130);
+  EXPECT_TRUE(visits_.empty());
+
+  tracker_.OnUnload(1, 140);
+  ASSERT_EQ(1u, visits_.size());
+  EXPECT_EQ("brave.com", visits_[0].first);
+  EXPECT_EQ(40u, visits_[0].second);
+}
+
+TEST_F(VisitTrackerTest, ReportsVisitOnce) {
+  tracker_.OnShow(1, 100);
+  tracker_.OnLoad(CreateVisitData("brave.com", 1), 100);
+  tracker_.OnHide(1, 110);
+  tracker_.OnHide(1, 120);
+  tracker_.OnUnload(1, 130);
+
+  EXPECT_EQ(1u, visits_.size());
+}
+
+TEST_F(VisitTrackerTest, KeepsTimingSameDomainNavigation) {
+  tracker_.OnShow(1, 100);
+  tracker_.OnLoad(CreateVisitData("brave.com", 1), 100);
+  tracker_.OnLoad(CreateVisitData("brave.com", 1), 110);
+  tracker_.OnHide(1, 130);
+
+  ASSERT_EQ(1u, visits_.size());
+  EXPECT_EQ(30u, visits_[0].second);
+}
+
+TEST_F(VisitTrackerTest, RestartsTimingOnNewDomain) {
+  tracker_.OnShow(1, 100);
+  tracker_.OnLoad(CreateVisitData("brave.com", 1), 100);
+  tracker_.OnLoad(CreateVisitData("example.com", 1), 110);
+  tracker_.OnHide(1, 130);
+
+  ASSERT_EQ(1u, visits_.size());
+  EXPECT_EQ("example.com", visits_[0].first);
+  EXPECT_EQ(20u, visits_[0].second);
+}
+
+TEST_F(VisitTrackerTest, ResumesWhenBroughtToForeground) {
+  tracker_.OnShow(1, 100);
+  tracker_.OnLoad(CreateVisitData("brave.com", 1), 100);
+  tracker_.OnBackground(1, 110);
+  tracker_.OnForeground(1, 200);
+  tracker_.OnBackground(1, 205);
+
+  ASSERT_EQ(2u, visits_.size());
+  EXPECT_EQ(10u, visits_[0].second);
+  EXPECT_EQ(5u, visits_[1].second);
+}
+
+TEST_F(VisitTrackerTest, IgnoresEmptyDomain) {
+  tracker_.OnShow(1, 100);
+  tracker_.OnLoad(CreateVisitData("", 1), 100);
+  tracker_.OnHide(1, 110);
+
+  EXPECT_TRUE(visits_.empty());
+}
+
+}  // namespace brave_rewards
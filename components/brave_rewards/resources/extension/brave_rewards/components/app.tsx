@@ -36,21 +36,19 @@ export class RewardsPanel extends React.Component<Props, State> {
   }
 
   componentDidMount () {
-    chrome.windows.getCurrent({}, this.onWindowCallback)
-    chrome.braveRewards.getRewardsMainEnabled(((enabled: boolean) => {
-      this.props.actions.onEnabledMain(enabled)
-    }))
-
-    chrome.braveRewards.getACEnabled(((enabled: boolean) => {
-      this.props.actions.onEnabledAC(enabled)
-    }))
-
-    chrome.braveRewards.getRecurringTips((tips: RewardsExtension.RecurringTips) => {
-      this.props.actions.onRecurringTips(tips)
+    chrome.windows.getCurrent({}, (window: chrome.windows.Window) => {
+      this.onWindowCallback(window)
+      this.getPanelState(window.id)
     })
+  }
 
-    chrome.braveRewards.getAllNotifications((list: RewardsExtension.Notification[]) => {
-      this.props.actions.onAllNotifications(list)
+  getPanelState (windowId: number) {
+    chrome.braveRewards.getPanelState(windowId, (state: RewardsExtension.PanelState) => {
+      this.props.actions.onEnabledMain(state.enabledMain)
+      this.props.actions.onEnabledAC(state.enabledAC)
+      this.props.actions.onRecurringTips(state.recurringTips)
+      this.props.actions.onAllNotifications(state.notifications)
+      this.props.actions.OnPendingContributionsTotal(state.pendingContributionsTotal)
     })
   }
 
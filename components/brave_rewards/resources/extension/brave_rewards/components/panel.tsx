@@ -64,10 +64,6 @@ export class Panel extends React.Component<Props, State> {
 
     this.actions.getWalletProperties()
     this.actions.getCurrentReport()
-
-    chrome.braveRewards.getPendingContributionsTotal(((amount: number) => {
-      this.actions.OnPendingContributionsTotal(amount)
-    }))
   }
 
   componentDidUpdate (prevProps: Props, prevState: State) {
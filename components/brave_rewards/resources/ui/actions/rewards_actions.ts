@@ -91,6 +91,11 @@ export const onContributeList = (list: Rewards.Publisher[]) => action(types.ON_C
   list
 })
 
+export const onContributeListChanged = (updated: Rewards.Publisher[], removed: string[]) => action(types.ON_CONTRIBUTE_LIST_CHANGED, {
+  updated,
+  removed
+})
+
 export const onExcludedList = (list: Rewards.ExcludedPublisher[]) => action(types.ON_EXCLUDED_LIST, {
   list
 })
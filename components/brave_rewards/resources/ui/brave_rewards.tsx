@@ -93,6 +93,10 @@ window.cr.define('brave_rewards', function () {
     getActions().onContributeList(list)
   }
 
+  function contributeListChanged (updated: Rewards.Publisher[], removed: string[]) {
+    getActions().onContributeListChanged(updated, removed)
+  }
+
   function excludedList (list: Rewards.ExcludedPublisher[]) {
     getActions().onExcludedList(list)
   }
@@ -191,6 +195,7 @@ window.cr.define('brave_rewards', function () {
     reconcileStamp,
     addresses,
     contributeList,
+    contributeListChanged,
     excludedList,
     balanceReports,
     walletExists,
@@ -9,6 +9,7 @@ import { connect } from 'react-redux'
 // Components
 import { CurrentReconcile } from './currentReconcile'
 import { KeyInfoSeed } from './keyInfoSeed'
+import { PerfStats } from './perfStats'
 import { WalletPaymentId } from './walletPaymentId'
 
 // Utils
@@ -54,6 +55,11 @@ export class RewardsInternalsPage extends React.Component<Props, {}> {
           <div>
             <span i18n-content='bootStamp'/>: {new Date(info.bootStamp * 1000).toLocaleDateString()}
           </div>
+          <hr/>
+          <div>
+            <span i18n-content='perfStats'/>
+            <PerfStats perfStats={info.perfStats || []} />
+          </div>
           <button type='button' style={{ marginTop: '10px' }} onClick={this.onRefresh}>{getLocale('refreshButton')}</button>
         </div>)
     } else {
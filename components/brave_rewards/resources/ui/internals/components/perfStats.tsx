@@ -0,0 +1,36 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+import * as React from 'react'
+
+interface Props {
+  perfStats: RewardsInternals.PerfStat[]
+}
+
+const formatMs = (ms: number) => `${ms.toFixed(1)} ms`
+
+export const PerfStats = (props: Props) => (
+  <table>
+    <thead>
+      <tr>
+        <th i18n-content='perfStatName'/>
+        <th i18n-content='perfStatCount'/>
+        <th i18n-content='perfStatAverage'/>
+        <th i18n-content='perfStatMax'/>
+        <th i18n-content='perfStatLast'/>
+      </tr>
+    </thead>
+    <tbody>
+      {props.perfStats.map((item) => (
+        <tr key={item.name}>
+          <td>{item.name}</td>
+          <td>{item.count}</td>
+          <td>{formatMs(item.count > 0 ? item.totalMs / item.count : 0)}</td>
+          <td>{formatMs(item.maxMs)}</td>
+          <td>{formatMs(item.lastMs)}</td>
+        </tr>
+      ))}
+    </tbody>
+  </table>
+)
@@ -14,7 +14,8 @@ const defaultState: RewardsInternals.State = {
     currentReconciles: [],
     personaId: '',
     userId: '',
-    bootStamp: 0
+    bootStamp: 0,
+    perfStats: []
   }
 }
 
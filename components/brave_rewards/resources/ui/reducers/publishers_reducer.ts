@@ -19,6 +19,21 @@ const publishersReducer: Reducer<Rewards.State | undefined> = (state: Rewards.St
 
       state.autoContributeList = action.payload.list
       break
+    case types.ON_CONTRIBUTE_LIST_CHANGED: {
+      const updated: Rewards.Publisher[] = action.payload.updated || []
+      const removed: string[] = action.payload.removed || []
+      const changedKeys = new Set<string>(removed)
+      updated.forEach((publisher: Rewards.Publisher) => {
+        changedKeys.add(publisher.publisherKey)
+      })
+
+      state = { ...state }
+      state.autoContributeList = state.autoContributeList
+        .filter((publisher: Rewards.Publisher) => !changedKeys.has(publisher.publisherKey))
+        .concat(updated)
+        .sort((a: Rewards.Publisher, b: Rewards.Publisher) => b.percentage - a.percentage)
+      break
+    }
     case types.ON_EXCLUDED_LIST: {
       if (!action.payload.list) {
         break
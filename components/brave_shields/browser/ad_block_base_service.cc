@@ -19,17 +19,17 @@
 #include "brave/browser/net/url_context.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/vendor/ad-block/ad_block_client.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "url/origin.h"
+
+#define AD_BLOCK_DECISION_CACHE_MAX_ENTRIES 1000
 
 using brave_component_updater::BraveComponent;
 using content::BrowserThread;
-using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
@@ -110,6 +110,8 @@ namespace brave_shields {
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
       ad_block_client_(new AdBlockClient()),
+      decision_cache_(AD_BLOCK_DECISION_CACHE_MAX_ENTRIES),
+      ready_(false),
       weak_factory_(this),
       weak_factory_io_thread_(this) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
@@ -122,45 +124,64 @@ AdBlockBaseService::~AdBlockBaseService() {
 void AdBlockBaseService::Cleanup() {
   BrowserThread::DeleteSoon(
       BrowserThread::IO, FROM_HERE, ad_block_client_.release());
+  // Released after the client, which may still reference the buffer.
+  BrowserThread::DeleteSoon(
+      BrowserThread::IO, FROM_HERE, dat_file_.release());
+  BrowserThread::DeleteSoon(
+      BrowserThread::IO, FROM_HERE, memory_pressure_listener_.release());
 }
 
 bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
     content::ResourceType resource_type, const std::string& tab_host,
     bool* did_match_exception, bool* cancel_request_explicitly) {
+  return ShouldStartRequest(
+      ShieldsMatchRequest(url, resource_type, tab_host),
+      did_match_exception, cancel_request_explicitly);
+}
+
+bool AdBlockBaseService::ShouldStartRequest(
+    const ShieldsMatchRequest& request,
+    bool* did_match_exception,
+    bool* cancel_request_explicitly) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  FilterOption current_option = ResourceTypeToFilterOption(resource_type);
+  FilterOption current_option =
+      ResourceTypeToFilterOption(request.resource_type);
 
   // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  if (SameDomainOrHost(url, url::Origin::CreateFromNormalizedTuple(
-        "https", tab_host.c_str(), 80), INCLUDE_PRIVATE_REGISTRIES)) {
-    current_option = static_cast<FilterOption>(
-        current_option | FONotThirdParty);
-  } else {
-    current_option = static_cast<FilterOption>(current_option | FOThirdParty);
+  current_option = static_cast<FilterOption>(current_option |
+      (request.is_third_party ? FOThirdParty : FONotThirdParty));
+
+  AdBlockDecision decision;
+  if (!decision_cache_.Get(request.spec, request.tab_host, current_option,
+                           &decision)) {
+    Filter* matching_filter = nullptr;
+    Filter* matching_exception_filter = nullptr;
+    if (ad_block_client_->matches(request.spec.c_str(),
+          current_option, request.tab_host.c_str(), &matching_filter,
+          &matching_exception_filter)) {
+      decision.should_start_request = false;
+      decision.cancel_request_explicitly = matching_filter &&
+          (matching_filter->filterOption & FOExplicitCancel);
+    } else {
+      decision.did_match_exception = !!matching_exception_filter;
+    }
+    decision_cache_.Put(request.spec, request.tab_host, current_option,
+                        decision);
   }
 
-  Filter* matching_filter = nullptr;
-  Filter* matching_exception_filter = nullptr;
-  if (ad_block_client_->matches(url.spec().c_str(),
-        current_option, tab_host.c_str(), &matching_filter,
-        &matching_exception_filter)) {
-    if (matching_filter && cancel_request_explicitly &&
-        (matching_filter->filterOption & FOExplicitCancel)) {
+  if (!decision.should_start_request) {
+    if (decision.cancel_request_explicitly && cancel_request_explicitly) {
       *cancel_request_explicitly = true;
     }
     // We'd only possibly match an exception filter if we're returning true.
-    *did_match_exception = false;
-    // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-    //  << tab_host
-    //  << ", resource type: " << resource_type
-    //  << ", url.spec(): " << url.spec();
+    if (did_match_exception) {
+      *did_match_exception = false;
+    }
     return false;
   }
 
   if (did_match_exception) {
-    *did_match_exception = !!matching_exception_filter;
+    *did_match_exception = decision.did_match_exception;
   }
 
   return true;
@@ -183,6 +204,26 @@ void AdBlockBaseService::EnableTagOnIOThread(
   } else {
     ad_block_client_->removeTag(tag);
   }
+  decision_cache_.Clear();
+}
+
+const AdBlockDecisionCache& AdBlockBaseService::decision_cache() const {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  return decision_cache_;
+}
+
+bool AdBlockBaseService::IsReadyOnIOThread() const {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  return ready_;
+}
+
+void AdBlockBaseService::RunWhenReadyOnIOThread(base::OnceClosure callback) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (ready_) {
+    std::move(callback).Run();
+    return;
+  }
+  ready_callbacks_.push_back(std::move(callback));
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
@@ -190,43 +231,82 @@ void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
       GetTaskRunner().get(),
       FROM_HERE,
       base::BindOnce(
-          &brave_component_updater::LoadDATFileData<AdBlockClient>,
-          dat_file_path),
+          &brave_component_updater::LoadMappedDATFileDataIfChanged<
+              AdBlockClient>,
+          dat_file_path, dat_file_hash_),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 }
 
-void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
+void AdBlockBaseService::OnGetDATFileData(
+    brave_component_updater::LoadChangedDATFileDataResult<AdBlockClient>
+        result) {
+  if (result.unchanged)
+    return;
+  if (!result.data.second) {
     LOG(ERROR) << "Could not obtain ad block data";
     return;
   }
-  if (!result.first.get()) {
+  if (!result.data.first.get()) {
     LOG(ERROR) << "Failed to deserialize ad block data";
     return;
   }
 
+  dat_file_hash_ = result.hash;
+  SetAdBlockClient(std::move(result.data.first),
+                   std::move(result.data.second));
+}
+
+void AdBlockBaseService::SetAdBlockClient(
+    std::unique_ptr<AdBlockClient> ad_block_client,
+    std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file) {
   base::PostTaskWithTraits(
       FROM_HERE, {BrowserThread::IO},
       base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
                      weak_factory_io_thread_.GetWeakPtr(),
-                     std::move(result.first),
-                     std::move(result.second)));
+                     std::move(ad_block_client),
+                     std::move(dat_file)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
     std::unique_ptr<AdBlockClient> ad_block_client,
-    brave_component_updater::DATFileDataBuffer buffer) {
+    std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   ad_block_client_ = std::move(ad_block_client);
-  buffer_ = std::move(buffer);
+  dat_file_ = std::move(dat_file);
+  decision_cache_.Clear();
+  if (!memory_pressure_listener_) {
+    memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+        base::Bind(&AdBlockBaseService::OnMemoryPressure,
+                   weak_factory_io_thread_.GetWeakPtr()));
+  }
+
+  ready_ = true;
+  std::vector<base::OnceClosure> ready_callbacks;
+  ready_callbacks.swap(ready_callbacks_);
+  for (auto& callback : ready_callbacks)
+    std::move(callback).Run();
 }
 
+void AdBlockBaseService::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  // Decisions are cheap to recompute from the loaded list.
+  if (memory_pressure_level !=
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    decision_cache_.Clear();
+  }
+}
 
 bool AdBlockBaseService::Init() {
   return true;
 }
 
+size_t AdBlockBaseService::GetDATFileSizeOnIOThread() const {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  return dat_file_ ? dat_file_->size() : 0;
+}
+
 AdBlockClient* AdBlockBaseService::GetAdBlockClientForTest() {
   return ad_block_client_.get();
 }
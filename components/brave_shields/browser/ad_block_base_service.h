@@ -13,26 +13,32 @@
 #include <utility>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "content/public/common/resource_type.h"
 
 class AdBlockClient;
 class AdBlockServiceTest;
+class ShieldsPerfTest;
 
 using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+struct ShieldsMatchRequest;
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
  public:
   using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<AdBlockClient>;
+      brave_component_updater::LoadMappedDATFileDataResult<AdBlockClient>;
 
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
@@ -40,16 +46,42 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   bool ShouldStartRequest(const GURL &url, content::ResourceType resource_type,
     const std::string& tab_host, bool* did_match_exception,
     bool* cancel_request_explicitly) override;
+  // Same as above but reuses the URL spec and third-party status already
+  // computed for |request|. The overload above ends up here too.
+  virtual bool ShouldStartRequest(const ShieldsMatchRequest& request,
+                                  bool* did_match_exception,
+                                  bool* cancel_request_explicitly);
   void EnableTag(const std::string& tag, bool enabled);
 
+  // Hit and miss counters are exposed through this. Must be called on the IO
+  // thread.
+  const AdBlockDecisionCache& decision_cache() const;
+
+  // Whether list data has been swapped in, so requests are matched against
+  // real filters. Must be called on the IO thread.
+  bool IsReadyOnIOThread() const;
+  // Runs |callback| on the IO thread once list data has been swapped in, or
+  // right away if it already has been. Must be called on the IO thread.
+  void RunWhenReadyOnIOThread(base::OnceClosure callback);
+
  protected:
   friend class ::AdBlockServiceTest;
+  friend class ::ShieldsPerfTest;
   bool Init() override;
   void Cleanup() override;
 
   void GetDATFileData(const base::FilePath& dat_file_path);
+  // Swaps in |ad_block_client| on the IO thread. |dat_file| is the buffer
+  // it was deserialized from, or null if the client owns its data. Can be
+  // called from any thread.
+  void SetAdBlockClient(
+      std::unique_ptr<AdBlockClient> ad_block_client,
+      std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file);
 
   AdBlockClient* GetAdBlockClientForTest();
+  // Size of the DAT buffer |ad_block_client_| was deserialized from, or 0
+  // if it owns its data. Must be called on the IO thread.
+  size_t GetDATFileSizeOnIOThread() const;
 
   SEQUENCE_CHECKER(sequence_checker_);
   std::unique_ptr<AdBlockClient> ad_block_client_;
@@ -57,12 +89,27 @@ class AdBlockBaseService : public BaseBraveShieldsService {
  private:
   void UpdateAdBlockClient(
       std::unique_ptr<AdBlockClient> ad_block_client,
-      brave_component_updater::DATFileDataBuffer buffer);
-  void OnGetDATFileData(GetDATFileDataResult result);
+      std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file);
+  void OnGetDATFileData(
+      brave_component_updater::LoadChangedDATFileDataResult<AdBlockClient>
+          result);
   void EnableTagOnIOThread(const std::string& tag, bool enabled);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
   void OnPreferenceChanges(const std::string& pref_name);
 
-  brave_component_updater::DATFileDataBuffer buffer_;
+  // |ad_block_client_| points into this buffer.
+  std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file_;
+  // Hash of the DAT file last loaded by GetDATFileData(), so an update that
+  // leaves it as is does not rebuild the client. Only used on the UI thread.
+  std::string dat_file_hash_;
+  AdBlockDecisionCache decision_cache_;
+  // Only used on the IO thread.
+  bool ready_;
+  std::vector<base::OnceClosure> ready_callbacks_;
+  // Created on the IO thread with the first client, so |decision_cache_| is
+  // trimmed on the thread that owns it.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_io_thread_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
@@ -5,20 +5,42 @@
 
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
+#include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/threading/scoped_blocking_call.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/vendor/ad-block/ad_block_client.h"
+#include "chrome/common/chrome_paths.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_thread.h"
+#include "crypto/sha2.h"
+
+namespace {
+
+const char kCustomFiltersDATDir[] = "AdBlockCustomFilters";
+const base::FilePath::CharType kCustomFiltersDATPattern[] =
+    FILE_PATH_LITERAL("*.dat");
+
+}  // namespace
 
 using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
 AdBlockCustomFiltersService::AdBlockCustomFiltersService(
-    BraveComponent::Delegate* delegate) : AdBlockBaseService(delegate) {
+    BraveComponent::Delegate* delegate)
+    : AdBlockBaseService(delegate),
+      custom_filters_update_(0) {
 }
 
 AdBlockCustomFiltersService::~AdBlockCustomFiltersService() {
@@ -43,6 +65,7 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
   if (!local_state)
     return false;
   local_state->SetString(kAdBlockCustomFilters, custom_filters);
+  custom_filters_update_++;
 
   GetTaskRunner()->PostTask(
       FROM_HERE,
@@ -53,12 +76,131 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
   return true;
 }
 
-void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
+bool AdBlockCustomFiltersService::SpliceCustomFilters(
+    size_t start,
+    const std::vector<std::string>& removed,
+    const std::vector<std::string>& inserted) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  PrefService* local_state = g_browser_process->local_state();
+  if (!local_state)
+    return false;
+
+  std::vector<std::string> lines = base::SplitString(
+      local_state->GetString(kAdBlockCustomFilters), "\n",
+      base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  if (start > lines.size() || removed.size() > lines.size() - start ||
+      !std::equal(removed.begin(), removed.end(), lines.begin() + start)) {
+    return false;
+  }
+
+  auto removed_begin = lines.begin() + start;
+  auto inserted_begin = lines.erase(removed_begin,
+                                    removed_begin + removed.size());
+  lines.insert(inserted_begin, inserted.begin(), inserted.end());
+  const std::string custom_filters = base::JoinString(lines, "\n");
+  local_state->SetString(kAdBlockCustomFilters, custom_filters);
+
+  const uint64_t update = ++custom_filters_update_;
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          &AdBlockCustomFiltersService::ApplyCustomFiltersOnFileTaskRunner,
+          base::Unretained(this), update, custom_filters));
+
+  return true;
+}
+
+void AdBlockCustomFiltersService::ApplyCustomFiltersOnFileTaskRunner(
+    uint64_t update,
     const std::string& custom_filters) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  ad_block_client_->clear();
+  // A later edit is queued behind this one and will build its own engine.
+  if (update != custom_filters_update_)
+    return;
+
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  auto ad_block_client = std::make_unique<AdBlockClient>();
   if (!custom_filters.empty())
-    ad_block_client_->parse(custom_filters.c_str());
+    ad_block_client->parse(custom_filters.c_str());
+  SetAdBlockClient(std::move(ad_block_client), nullptr);
+}
+
+void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
+    const std::string& custom_filters) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::WILL_BLOCK);
+  // The client the IO thread is matching with is never touched here, a new
+  // one is built and swapped in.
+  if (custom_filters.empty()) {
+    SetAdBlockClient(std::make_unique<AdBlockClient>(), nullptr);
+    return;
+  }
+
+  base::FilePath dat_file_path = GetCustomFiltersDATFile(custom_filters);
+  if (!dat_file_path.empty()) {
+    GetDATFileDataResult result =
+        brave_component_updater::LoadMappedDATFileData<AdBlockClient>(
+            dat_file_path);
+    if (result.first) {
+      SetAdBlockClient(std::move(result.first), std::move(result.second));
+      return;
+    }
+    LOG(ERROR) << "Failed to load custom filters DAT " << dat_file_path;
+    base::DeleteFile(dat_file_path, false);
+  }
+
+  auto ad_block_client = std::make_unique<AdBlockClient>();
+  ad_block_client->parse(custom_filters.c_str());
+  SetAdBlockClient(std::move(ad_block_client), nullptr);
+}
+
+base::FilePath AdBlockCustomFiltersService::GetCustomFiltersDATFile(
+    const std::string& custom_filters) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::FilePath dat_dir;
+  if (!base::PathService::Get(chrome::DIR_USER_DATA, &dat_dir))
+    return base::FilePath();
+  dat_dir = dat_dir.AppendASCII(kCustomFiltersDATDir);
+
+  // The DAT is named after a hash of the filters so a cached one is only
+  // reused for the exact same list.
+  const std::string hash = crypto::SHA256HashString(custom_filters);
+  base::FilePath dat_file_path = dat_dir.AppendASCII(
+      base::HexEncode(hash.data(), hash.size()) + ".dat");
+  if (base::PathExists(dat_file_path))
+    return dat_file_path;
+
+  if (!base::CreateDirectory(dat_dir))
+    return base::FilePath();
+
+  // Only the DAT for the current filters is kept.
+  base::FileEnumerator old_dat_files(dat_dir, false,
+      base::FileEnumerator::FILES, kCustomFiltersDATPattern);
+  for (base::FilePath path = old_dat_files.Next(); !path.empty();
+       path = old_dat_files.Next()) {
+    base::DeleteFile(path, false);
+  }
+
+  AdBlockClient ad_block_client;
+  ad_block_client.parse(custom_filters.c_str());
+  int size = 0;
+  std::unique_ptr<char[]> data(ad_block_client.serialize(&size));
+  if (!data || size <= 0)
+    return base::FilePath();
+
+  // Write to a temporary file first so a partially written DAT is never
+  // picked up on the next start.
+  base::FilePath temp_file_path;
+  if (!base::CreateTemporaryFileInDir(dat_dir, &temp_file_path))
+    return base::FilePath();
+  if (base::WriteFile(temp_file_path, data.get(), size) != size ||
+      !base::ReplaceFile(temp_file_path, dat_file_path, nullptr)) {
+    base::DeleteFile(temp_file_path, false);
+    return base::FilePath();
+  }
+  return dat_file_path;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -6,8 +6,10 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_CUSTOM_FILTERS_SERVICE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_CUSTOM_FILTERS_SERVICE_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
@@ -26,6 +28,17 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
 
   std::string GetCustomFilters();
   bool UpdateCustomFilters(const std::string& custom_filters);
+  // Replaces the lines |removed| starting at line |start| of the custom
+  // filters with |inserted|, as brave://adblock edits them. Fails without
+  // changing anything if those lines are not |removed|, e.g. because the
+  // list was changed from another page.
+  //
+  // Unlike UpdateCustomFilters() no DAT is written, since it would be out of
+  // date again by the next edit. The engine is rebuilt from text and the DAT
+  // is written on the next start.
+  bool SpliceCustomFilters(size_t start,
+                           const std::vector<std::string>& removed,
+                           const std::vector<std::string>& inserted);
 
  protected:
   bool Init() override;
@@ -33,6 +46,15 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
  private:
   friend class ::AdBlockServiceTest;
   void UpdateCustomFiltersOnFileTaskRunner(const std::string& custom_filters);
+  void ApplyCustomFiltersOnFileTaskRunner(uint64_t update,
+                                          const std::string& custom_filters);
+  // Returns the cached DAT for |custom_filters|, compiling and writing it
+  // first if needed. Returns an empty path if the DAT can't be written.
+  base::FilePath GetCustomFiltersDATFile(const std::string& custom_filters);
+
+  // Bumped on the UI thread for every edit, so the file task runner only
+  // builds an engine for the latest of the edits queued up on it.
+  std::atomic<uint64_t> custom_filters_update_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockCustomFiltersService);
 };
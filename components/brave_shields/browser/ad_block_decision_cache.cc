@@ -0,0 +1,44 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+namespace brave_shields {
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t max_entries)
+    : entries_(max_entries),
+      hit_count_(0),
+      miss_count_(0) {
+}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() {
+}
+
+bool AdBlockDecisionCache::Get(const std::string& spec,
+                               const std::string& tab_host,
+                               int filter_option,
+                               AdBlockDecision* decision) {
+  auto it = entries_.Get(Key(spec, tab_host, filter_option));
+  if (it == entries_.end()) {
+    miss_count_++;
+    return false;
+  }
+  hit_count_++;
+  *decision = it->second;
+  return true;
+}
+
+void AdBlockDecisionCache::Put(const std::string& spec,
+                               const std::string& tab_host,
+                               int filter_option,
+                               const AdBlockDecision& decision) {
+  entries_.Put(Key(spec, tab_host, filter_option), decision);
+}
+
+void AdBlockDecisionCache::Clear() {
+  entries_.Clear();
+}
+
+}  // namespace brave_shields
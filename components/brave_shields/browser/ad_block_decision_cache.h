@@ -0,0 +1,62 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <tuple>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+
+namespace brave_shields {
+
+// Outcome of matching one request against an ad-block list.
+struct AdBlockDecision {
+  bool should_start_request = true;
+  bool did_match_exception = false;
+  bool cancel_request_explicitly = false;
+};
+
+// Remembers recent ad-block decisions so pages that request the same URLs
+// from many frames or on reload skip the list lookup. Entries are keyed on
+// the exact URL, tab host and filter option, since domain-restricted filters
+// depend on the full tab host. Must be cleared whenever the list or its tags
+// change. Not thread safe, owned and used on the IO thread.
+class AdBlockDecisionCache {
+ public:
+  explicit AdBlockDecisionCache(size_t max_entries);
+  ~AdBlockDecisionCache();
+
+  bool Get(const std::string& spec,
+           const std::string& tab_host,
+           int filter_option,
+           AdBlockDecision* decision);
+  void Put(const std::string& spec,
+           const std::string& tab_host,
+           int filter_option,
+           const AdBlockDecision& decision);
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+  uint64_t hit_count() const { return hit_count_; }
+  uint64_t miss_count() const { return miss_count_; }
+
+ private:
+  using Key = std::tuple<std::string, std::string, int>;
+
+  base::MRUCache<Key, AdBlockDecision> entries_;
+  uint64_t hit_count_;
+  uint64_t miss_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockDecisionCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
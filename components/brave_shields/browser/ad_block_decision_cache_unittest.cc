@@ -0,0 +1,47 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::AdBlockDecision;
+using brave_shields::AdBlockDecisionCache;
+
+TEST(AdBlockDecisionCacheTest, GetPutClear) {
+  AdBlockDecisionCache cache(2);
+  AdBlockDecision decision;
+  EXPECT_FALSE(cache.Get("https://a.com/ad.js", "b.com", 1, &decision));
+  EXPECT_EQ(cache.miss_count(), 1u);
+
+  AdBlockDecision blocked;
+  blocked.should_start_request = false;
+  blocked.cancel_request_explicitly = true;
+  cache.Put("https://a.com/ad.js", "b.com", 1, blocked);
+  ASSERT_TRUE(cache.Get("https://a.com/ad.js", "b.com", 1, &decision));
+  EXPECT_FALSE(decision.should_start_request);
+  EXPECT_TRUE(decision.cancel_request_explicitly);
+  EXPECT_EQ(cache.hit_count(), 1u);
+
+  // The tab host and filter option are part of the key.
+  EXPECT_FALSE(cache.Get("https://a.com/ad.js", "www.b.com", 1, &decision));
+  EXPECT_FALSE(cache.Get("https://a.com/ad.js", "b.com", 2, &decision));
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_FALSE(cache.Get("https://a.com/ad.js", "b.com", 1, &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, EvictsLeastRecentlyUsed) {
+  AdBlockDecisionCache cache(2);
+  AdBlockDecision decision;
+  cache.Put("https://a.com/", "t.com", 0, decision);
+  cache.Put("https://b.com/", "t.com", 0, decision);
+  EXPECT_TRUE(cache.Get("https://a.com/", "t.com", 0, &decision));
+  cache.Put("https://c.com/", "t.com", 0, decision);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_TRUE(cache.Get("https://a.com/", "t.com", 0, &decision));
+  EXPECT_FALSE(cache.Get("https://b.com/", "t.com", 0, &decision));
+}
@@ -0,0 +1,169 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_filter_validator.h"
+
+#include <string.h>
+
+#include "base/logging.h"
+#include "base/stl_util.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Options the engine accepts without a value.
+const char* const kFlagOptions[] = {
+  "1p",
+  "3p",
+  "all",
+  "badfilter",
+  "collapse",
+  "document",
+  "donottrack",
+  "elemhide",
+  "empty",
+  "explicitcancel",
+  "first-party",
+  "font",
+  "generichide",
+  "genericblock",
+  "image",
+  "important",
+  "inline-script",
+  "match-case",
+  "media",
+  "object",
+  "object-subrequest",
+  "other",
+  "ping",
+  "popup",
+  "script",
+  "stylesheet",
+  "subdocument",
+  "third-party",
+  "webrtc",
+  "websocket",
+  "xhr",
+  "xmlhttprequest",
+};
+
+// Options that need a value after '='.
+const char* const kValueOptions[] = {
+  "csp",
+  "domain",
+  "redirect",
+  "sitekey",
+};
+
+const char* const kCosmeticMarkers[] = {
+  "#@#",
+  "#?#",
+  "##",
+};
+
+bool IsOneOf(base::StringPiece value, const char* const* list, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    if (value == list[i])
+      return true;
+  }
+  return false;
+}
+
+FilterSyntaxError ValidateOption(base::StringPiece option) {
+  option = base::TrimWhitespaceASCII(option, base::TRIM_ALL);
+  if (option.starts_with("~"))
+    option.remove_prefix(1);
+
+  const size_t equals = option.find('=');
+  if (equals == base::StringPiece::npos) {
+    return IsOneOf(option, kFlagOptions, base::size(kFlagOptions)) ?
+        FILTER_SYNTAX_OK : FILTER_SYNTAX_UNKNOWN_OPTION;
+  }
+
+  if (!IsOneOf(option.substr(0, equals), kValueOptions,
+               base::size(kValueOptions))) {
+    return FILTER_SYNTAX_UNKNOWN_OPTION;
+  }
+
+  // Every domain of "domain=a.com|~b.com" has to be there.
+  for (const base::StringPiece value : base::SplitStringPiece(
+           option.substr(equals + 1), "|", base::TRIM_WHITESPACE,
+           base::SPLIT_WANT_ALL)) {
+    if (value.empty() || value == "~")
+      return FILTER_SYNTAX_EMPTY_OPTION_VALUE;
+  }
+  return FILTER_SYNTAX_OK;
+}
+
+}  // namespace
+
+FilterSyntaxError ValidateFilterSyntax(base::StringPiece filter) {
+  filter = base::TrimWhitespaceASCII(filter, base::TRIM_ALL);
+  if (filter.empty() || filter.starts_with("!") || filter.starts_with("["))
+    return FILTER_SYNTAX_OK;
+
+  for (const char* marker : kCosmeticMarkers) {
+    const size_t pos = filter.find(marker);
+    if (pos != base::StringPiece::npos) {
+      return filter.size() > pos + strlen(marker) ?
+          FILTER_SYNTAX_OK : FILTER_SYNTAX_EMPTY_SELECTOR;
+    }
+  }
+
+  base::StringPiece pattern = filter;
+  if (pattern.starts_with("@@"))
+    pattern.remove_prefix(2);
+
+  // A '$' inside a /regex/ pattern is not the start of the options.
+  size_t options_start = pattern.rfind('$');
+  if (pattern.starts_with("/") && options_start != base::StringPiece::npos) {
+    const size_t regex_end = pattern.rfind('/');
+    if (regex_end > 0 && regex_end > options_start)
+      options_start = base::StringPiece::npos;
+  }
+
+  bool has_options = false;
+  if (options_start != base::StringPiece::npos) {
+    for (const base::StringPiece option : base::SplitStringPiece(
+             pattern.substr(options_start + 1), ",", base::TRIM_WHITESPACE,
+             base::SPLIT_WANT_ALL)) {
+      const FilterSyntaxError error = ValidateOption(option);
+      if (error != FILTER_SYNTAX_OK)
+        return error;
+      has_options = true;
+    }
+    pattern = pattern.substr(0, options_start);
+  }
+
+  // Anchors alone leave nothing to match on, which only makes sense when
+  // options narrow the filter down, e.g. "$third-party,domain=a.com".
+  pattern = base::TrimString(pattern, "|", base::TRIM_ALL);
+  if ((pattern.empty() || pattern == "*") && !has_options)
+    return FILTER_SYNTAX_EMPTY_PATTERN;
+
+  return FILTER_SYNTAX_OK;
+}
+
+const char* FilterSyntaxErrorToString(FilterSyntaxError error) {
+  switch (error) {
+    case FILTER_SYNTAX_OK:
+      return "";
+    case FILTER_SYNTAX_EMPTY_PATTERN:
+      return "emptyPattern";
+    case FILTER_SYNTAX_EMPTY_SELECTOR:
+      return "emptySelector";
+    case FILTER_SYNTAX_UNKNOWN_OPTION:
+      return "unknownOption";
+    case FILTER_SYNTAX_EMPTY_OPTION_VALUE:
+      return "emptyOptionValue";
+  }
+  NOTREACHED();
+  return "";
+}
+
+}  // namespace brave_shields
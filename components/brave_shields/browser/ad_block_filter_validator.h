@@ -0,0 +1,36 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FILTER_VALIDATOR_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FILTER_VALIDATOR_H_
+
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+enum FilterSyntaxError {
+  FILTER_SYNTAX_OK,
+  // A network filter that would match every request, e.g. "||" or "@@".
+  FILTER_SYNTAX_EMPTY_PATTERN,
+  // A cosmetic filter without a selector, e.g. "example.com##".
+  FILTER_SYNTAX_EMPTY_SELECTOR,
+  // An option after '$' that the ad-block engine does not know.
+  FILTER_SYNTAX_UNKNOWN_OPTION,
+  // An option such as "domain=" that needs a value but has none.
+  FILTER_SYNTAX_EMPTY_OPTION_VALUE,
+};
+
+// Checks one line of custom filters for mistakes the ad-block engine would
+// otherwise silently ignore or misread. This is a quick syntax check, not a
+// full parse: a filter that passes can still match nothing. Empty lines and
+// comments are always valid.
+FilterSyntaxError ValidateFilterSyntax(base::StringPiece filter);
+
+// Name of |error| as shown to brave://adblock, e.g. "unknownOption".
+const char* FilterSyntaxErrorToString(FilterSyntaxError error);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FILTER_VALIDATOR_H_
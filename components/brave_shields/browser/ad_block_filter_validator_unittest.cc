@@ -0,0 +1,54 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_filter_validator.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=AdBlockFilterValidatorTest.*
+
+using brave_shields::FILTER_SYNTAX_EMPTY_OPTION_VALUE;
+using brave_shields::FILTER_SYNTAX_EMPTY_PATTERN;
+using brave_shields::FILTER_SYNTAX_EMPTY_SELECTOR;
+using brave_shields::FILTER_SYNTAX_OK;
+using brave_shields::FILTER_SYNTAX_UNKNOWN_OPTION;
+using brave_shields::ValidateFilterSyntax;
+
+TEST(AdBlockFilterValidatorTest, AcceptsCommonFilters) {
+  EXPECT_EQ(ValidateFilterSyntax(""), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("   "), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("! comment"), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("[Adblock Plus 2.0]"), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("*ad_banner.png"), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("||ads.example.com^"), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("@@||example.com/ads.js$script"),
+            FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax(
+      "||tracker.com^$third-party,~image,domain=a.com|~b.com"),
+      FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("$third-party,domain=a.com"),
+            FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("/banner[0-9]+$/"), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("/banner/$image"), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("example.com##.ad"), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("##div[id^=\"ad$\"]"), FILTER_SYNTAX_OK);
+  EXPECT_EQ(ValidateFilterSyntax("example.com#@#.ad"), FILTER_SYNTAX_OK);
+}
+
+TEST(AdBlockFilterValidatorTest, RejectsMistakes) {
+  EXPECT_EQ(ValidateFilterSyntax("||"), FILTER_SYNTAX_EMPTY_PATTERN);
+  EXPECT_EQ(ValidateFilterSyntax("@@"), FILTER_SYNTAX_EMPTY_PATTERN);
+  EXPECT_EQ(ValidateFilterSyntax("*"), FILTER_SYNTAX_EMPTY_PATTERN);
+  EXPECT_EQ(ValidateFilterSyntax("example.com##"),
+            FILTER_SYNTAX_EMPTY_SELECTOR);
+  EXPECT_EQ(ValidateFilterSyntax("||ads.com^$scirpt"),
+            FILTER_SYNTAX_UNKNOWN_OPTION);
+  EXPECT_EQ(ValidateFilterSyntax("||ads.com^$foo=bar"),
+            FILTER_SYNTAX_UNKNOWN_OPTION);
+  EXPECT_EQ(ValidateFilterSyntax("||ads.com^$domain="),
+            FILTER_SYNTAX_EMPTY_OPTION_VALUE);
+  EXPECT_EQ(ValidateFilterSyntax("||ads.com^$domain=a.com||b.com"),
+            FILTER_SYNTAX_EMPTY_OPTION_VALUE);
+}
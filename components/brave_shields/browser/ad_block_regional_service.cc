@@ -21,10 +21,12 @@
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
 #include "brave/vendor/ad-block/ad_block_client.h"
 #include "brave/vendor/ad-block/data_file_version.h"
 #include "brave/vendor/ad-block/lists/regions.h"
 #include "components/prefs/pref_service.h"
+#include "content/public/browser/browser_thread.h"
 
 namespace brave_shields {
 
@@ -34,11 +36,27 @@ std::string
 std::string AdBlockRegionalService::g_ad_block_regional_dat_file_version_(
     base::NumberToString(DATA_FILE_VERSION));
 
+AdBlockRegionalStats::AdBlockRegionalStats()
+    : rules_loaded(0),
+      memory_bytes(0),
+      requests_checked(0),
+      requests_matched(0) {
+}
+
+AdBlockRegionalStats::AdBlockRegionalStats(
+    const AdBlockRegionalStats& other) = default;
+
+AdBlockRegionalStats::~AdBlockRegionalStats() {
+}
+
 AdBlockRegionalService::AdBlockRegionalService(
     const std::string& uuid,
     brave_component_updater::BraveComponent::Delegate* delegate)
     : AdBlockBaseService(delegate),
-      uuid_(uuid) {
+      uuid_(uuid),
+      active_(false),
+      requests_checked_(0),
+      requests_matched_(0) {
 }
 
 AdBlockRegionalService::~AdBlockRegionalService() {
@@ -63,15 +81,66 @@ bool AdBlockRegionalService::Init() {
   return true;
 }
 
+bool AdBlockRegionalService::ShouldStartRequest(
+    const ShieldsMatchRequest& request,
+    bool* did_match_exception,
+    bool* cancel_request_explicitly) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  // The manager stops at the first list that matches an exception, so the
+  // flag has to be read back to tell whether this list did.
+  bool matched_exception = false;
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  const bool should_start_request = AdBlockBaseService::ShouldStartRequest(
+      request, &matched_exception, cancel_request_explicitly);
+  match_time_ += base::TimeTicks::Now() - start_time;
+
+  requests_checked_++;
+  if (!should_start_request || matched_exception)
+    requests_matched_++;
+  if (did_match_exception)
+    *did_match_exception = matched_exception;
+
+  return should_start_request;
+}
+
+AdBlockRegionalStats AdBlockRegionalService::GetStatsOnIOThread() const {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  AdBlockRegionalStats stats;
+  stats.rules_loaded = ad_block_client_->numFilters +
+                       ad_block_client_->numCosmeticFilters +
+                       ad_block_client_->numHtmlFilters +
+                       ad_block_client_->numExceptionFilters +
+                       ad_block_client_->numNoFingerprintFilters +
+                       ad_block_client_->numNoFingerprintExceptionFilters +
+                       ad_block_client_->numHostAnchoredFilters +
+                       ad_block_client_->numHostAnchoredExceptionFilters;
+  stats.memory_bytes = GetDATFileSizeOnIOThread();
+  stats.requests_checked = requests_checked_;
+  stats.requests_matched = requests_matched_;
+  stats.match_time = match_time_;
+  return stats;
+}
+
 void AdBlockRegionalService::OnComponentReady(
     const std::string& component_id,
     const base::FilePath& install_dir,
     const std::string& manifest) {
-  base::FilePath dat_file_path =
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  dat_file_path_ =
       install_dir.AppendASCII(g_ad_block_regional_dat_file_version_)
           .AppendASCII(uuid_)
           .AddExtension(FILE_PATH_LITERAL(".dat"));
-  GetDATFileData(dat_file_path);
+  if (active_)
+    GetDATFileData(dat_file_path_);
+}
+
+void AdBlockRegionalService::Activate() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (active_)
+    return;
+  active_ = true;
+  if (!dat_file_path_.empty())
+    GetDATFileData(dat_file_path_);
 }
 
 // static
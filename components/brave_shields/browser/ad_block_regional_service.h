@@ -13,13 +13,31 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/time/time.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "content/public/common/resource_type.h"
 
 class AdBlockServiceTest;
+class ShieldsPerfTest;
 
 namespace brave_shields {
 
+// How much a regional list costs and how much it matches, shown on
+// brave://adblock so lists that never match can be turned off.
+struct AdBlockRegionalStats {
+  AdBlockRegionalStats();
+  AdBlockRegionalStats(const AdBlockRegionalStats& other);
+  ~AdBlockRegionalStats();
+
+  size_t rules_loaded;
+  // Size of the DAT the list was loaded from.
+  size_t memory_bytes;
+  uint64_t requests_checked;
+  // Requests the list blocked or matched an exception for.
+  uint64_t requests_matched;
+  base::TimeDelta match_time;
+};
+
 // The brave shields service in charge of ad-block checking and init
 // for a specific region.
 class AdBlockRegionalService : public AdBlockBaseService {
@@ -32,6 +50,21 @@ class AdBlockRegionalService : public AdBlockBaseService {
   std::string GetUUID() const { return uuid_; }
   std::string GetTitle() const { return title_; }
 
+  // Loads the list, right away if its component is ready or else as soon as
+  // it is. Until then the component is kept up to date but nothing is
+  // loaded. Must be called on the UI thread.
+  void Activate();
+  bool IsActive() const { return active_; }
+
+  using AdBlockBaseService::ShouldStartRequest;
+  // Counts the request and the time taken to match it in the stats for this
+  // list.
+  bool ShouldStartRequest(const ShieldsMatchRequest& request,
+                          bool* did_match_exception,
+                          bool* cancel_request_explicitly) override;
+  // Must be called on the IO thread.
+  AdBlockRegionalStats GetStatsOnIOThread() const;
+
  protected:
   bool Init() override;
   void OnComponentReady(const std::string& component_id,
@@ -40,6 +73,7 @@ class AdBlockRegionalService : public AdBlockBaseService {
 
  private:
   friend class ::AdBlockServiceTest;
+  friend class ::ShieldsPerfTest;
   static std::string g_ad_block_regional_component_id_;
   static std::string g_ad_block_regional_component_base64_public_key_;
   static std::string g_ad_block_regional_dat_file_version_;
@@ -50,6 +84,13 @@ class AdBlockRegionalService : public AdBlockBaseService {
 
   std::string uuid_;
   std::string title_;
+  // Only used on the UI thread.
+  bool active_;
+  base::FilePath dat_file_path_;
+  // Only used on the IO thread.
+  uint64_t requests_checked_;
+  uint64_t requests_matched_;
+  base::TimeDelta match_time_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalService);
 };
@@ -11,12 +11,14 @@
 
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
 #include "brave/vendor/ad-block/lists/regions.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -25,6 +27,22 @@
 
 namespace brave_shields {
 
+namespace {
+
+// Lists activated within this many days are loaded again at startup, so
+// that they keep applying to pages from any top-level domain.
+const int kActivatedListRetentionDays = 30;
+
+bool WasActivatedRecently(const base::DictionaryValue& regional_filter_dict) {
+  double last_activated = 0;
+  if (!regional_filter_dict.GetDouble("last_activated", &last_activated))
+    return false;
+  return base::Time::Now() - base::Time::FromDoubleT(last_activated) <
+         base::TimeDelta::FromDays(kActivatedListRetentionDays);
+}
+
+}  // namespace
+
 AdBlockRegionalServiceManager::AdBlockRegionalServiceManager(
     brave_component_updater::BraveComponent::Delegate* delegate)
     : delegate_(delegate),
@@ -65,7 +83,10 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
     EnableFilterList(it->uuid, true);
   }
 
-  // Start all regional services associated with enabled filter lists
+  // Start all regional services associated with enabled filter lists. Only
+  // the list for the browser locale is loaded now, see the class comment.
+  auto locale_list = brave_shields::FindAdBlockFilterListByLocale(
+      region_lists, g_brave_browser_process->GetApplicationLocale());
   base::AutoLock lock(regional_services_lock_);
   const base::DictionaryValue* regional_filters_dict =
       local_state->GetDictionary(kAdBlockRegionalFilters);
@@ -80,10 +101,85 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
     if (enabled) {
       auto regional_service = AdBlockRegionalServiceFactory(uuid, delegate_);
       regional_service->Start();
+      if ((locale_list != region_lists.end() &&
+           base::ToUpperASCII(uuid) == locale_list->uuid) ||
+          WasActivatedRecently(*regional_filter_dict)) {
+        regional_service->Activate();
+      }
       regional_services_.insert(
           std::make_pair(uuid, std::move(regional_service)));
     }
   }
+  PublishSnapshot();
+}
+
+void AdBlockRegionalServiceManager::PublishSnapshot(
+    std::unique_ptr<AdBlockRegionalService> retired_service) {
+  regional_services_lock_.AssertAcquired();
+  RegionalServicesSnapshot snapshot;
+  InactiveServicesByTLD inactive_services;
+  snapshot.reserve(regional_services_.size());
+  for (const auto& regional_service : regional_services_) {
+    if (regional_service.second->IsActive()) {
+      snapshot.push_back(std::make_pair(regional_service.first,
+                                        regional_service.second.get()));
+      continue;
+    }
+    auto it = brave_shields::FindAdBlockFilterListByUUID(
+        region_lists, regional_service.first);
+    if (it == region_lists.end())
+      continue;
+    for (const std::string& tld : GetAdBlockFilterListTLDs(*it))
+      inactive_services.insert(std::make_pair(tld, regional_service.first));
+  }
+  base::PostTaskWithTraitsAndReply(
+      FROM_HERE, {content::BrowserThread::IO},
+      base::BindOnce(&AdBlockRegionalServiceManager::SetSnapshotOnIOThread,
+                     base::Unretained(this), std::move(snapshot),
+                     std::move(inactive_services)),
+      base::BindOnce([](std::unique_ptr<AdBlockRegionalService>) {},
+                     std::move(retired_service)));
+}
+
+void AdBlockRegionalServiceManager::SetSnapshotOnIOThread(
+    RegionalServicesSnapshot snapshot,
+    InactiveServicesByTLD inactive_services) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  io_regional_services_ = std::move(snapshot);
+  io_inactive_services_ = std::move(inactive_services);
+}
+
+void AdBlockRegionalServiceManager::MaybeActivateForTabHostOnIOThread(
+    const std::string& tab_host) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  const std::string tld = GetAdBlockTLDForHost(tab_host);
+  if (tld.empty())
+    return;
+  auto range = io_inactive_services_.equal_range(tld);
+  for (auto it = range.first; it != range.second; ++it) {
+    base::PostTaskWithTraits(
+        FROM_HERE, {content::BrowserThread::UI},
+        base::BindOnce(&AdBlockRegionalServiceManager::ActivateFilterList,
+                       base::Unretained(this), it->second));
+  }
+  // Not asked again until the next snapshot, which will have them active.
+  io_inactive_services_.erase(range.first, range.second);
+}
+
+void AdBlockRegionalServiceManager::ActivateFilterList(
+    const std::string& uuid) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  base::AutoLock lock(regional_services_lock_);
+  auto it = regional_services_.find(uuid);
+  // The list may have been disabled since.
+  if (it == regional_services_.end() || it->second->IsActive())
+    return;
+  it->second->Activate();
+  PublishSnapshot();
+  base::PostTaskWithTraits(
+      FROM_HERE, {content::BrowserThread::UI},
+      base::BindOnce(&AdBlockRegionalServiceManager::UpdateFilterListPrefs,
+                     base::Unretained(this), uuid, true));
 }
 
 void AdBlockRegionalServiceManager::UpdateFilterListPrefs(
@@ -97,6 +193,10 @@ void AdBlockRegionalServiceManager::UpdateFilterListPrefs(
   base::DictionaryValue* regional_filters_dict = update.Get();
   auto regional_filter_dict = std::make_unique<base::DictionaryValue>();
   regional_filter_dict->SetBoolean("enabled", enabled);
+  // Enabled lists are active until the next startup, see the class comment.
+  if (enabled)
+    regional_filter_dict->SetDouble("last_activated",
+                                    base::Time::Now().ToDoubleT());
   regional_filters_dict->Set(uuid, std::move(regional_filter_dict));
 }
 
@@ -126,14 +226,30 @@ bool AdBlockRegionalServiceManager::ShouldStartRequest(
     const std::string& tab_host,
     bool* matching_exception_filter,
     bool* cancel_request_explicitly) {
-  base::AutoLock lock(regional_services_lock_);
-  for (const auto& regional_service : regional_services_) {
+  return ShouldStartRequest(
+      ShieldsMatchRequest(url, resource_type, tab_host),
+      matching_exception_filter, cancel_request_explicitly, nullptr);
+}
+
+bool AdBlockRegionalServiceManager::ShouldStartRequest(
+    const ShieldsMatchRequest& request,
+    bool* matching_exception_filter,
+    bool* cancel_request_explicitly,
+    std::string* matching_uuid) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  if (!io_inactive_services_.empty())
+    MaybeActivateForTabHostOnIOThread(request.tab_host);
+
+  for (const auto& regional_service : io_regional_services_) {
     if (!regional_service.second->ShouldStartRequest(
-            url, resource_type, tab_host, matching_exception_filter,
-            cancel_request_explicitly)) {
+            request, matching_exception_filter, cancel_request_explicitly)) {
+      if (matching_uuid)
+        *matching_uuid = regional_service.first;
       return false;
     }
     if (matching_exception_filter && *matching_exception_filter) {
+      if (matching_uuid)
+        *matching_uuid = regional_service.first;
       return true;
     }
   }
@@ -149,6 +265,28 @@ void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
   }
 }
 
+void AdBlockRegionalServiceManager::GetRegionalStats(
+    GetRegionalStatsCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {content::BrowserThread::IO},
+      base::BindOnce(
+          &AdBlockRegionalServiceManager::GetRegionalStatsOnIOThread,
+          base::Unretained(this)),
+      std::move(callback));
+}
+
+AdBlockRegionalServiceManager::RegionalStats
+AdBlockRegionalServiceManager::GetRegionalStatsOnIOThread() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  RegionalStats stats;
+  for (const auto& regional_service : io_regional_services_) {
+    stats.insert(std::make_pair(regional_service.first,
+                                regional_service.second->GetStatsOnIOThread()));
+  }
+  return stats;
+}
+
 void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
                                                      bool enabled) {
   DCHECK(!uuid.empty());
@@ -161,13 +299,20 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
       DCHECK(it == regional_services_.end());
       auto regional_service = AdBlockRegionalServiceFactory(uuid, delegate_);
       regional_service->Start();
+      regional_service->Activate();
       regional_services_.insert(
           std::make_pair(uuid, std::move(regional_service)));
+      PublishSnapshot();
     } else {
       DCHECK(it != regional_services_.end());
       it->second->Stop();
       it->second->Unregister();
+      // The IO thread may still be matching against this service, so it is
+      // kept alive until the snapshot without it has been published.
+      std::unique_ptr<AdBlockRegionalService> retired_service =
+          std::move(it->second);
       regional_services_.erase(it);
+      PublishSnapshot(std::move(retired_service));
     }
   }
 
@@ -9,7 +9,10 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/callback_forward.h"
 #include "base/macros.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
@@ -22,17 +25,32 @@ class ListValue;
 }  // namespace base
 
 class AdBlockServiceTest;
+class ShieldsPerfTest;
 
 using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
 class AdBlockRegionalService;
+struct AdBlockRegionalStats;
+struct ShieldsMatchRequest;
 
 // The AdBlock regional service manager, in charge of initializing and
 // managing regional AdBlock clients.
+//
+// Enabled lists are only loaded once they are needed: the list for the
+// browser locale and lists the user enables right away, any other enabled
+// list once a page is loaded from a top-level domain of one of its
+// languages. Until then their components are kept up to date but hold no
+// memory and are not matched against. An activated list applies to pages
+// from every top-level domain, and is loaded at startup as long as it was
+// activated in the last 30 days.
 class AdBlockRegionalServiceManager {
  public:
+  // Stats of every active list, by uuid.
+  using RegionalStats = std::map<std::string, AdBlockRegionalStats>;
+  using GetRegionalStatsCallback = base::OnceCallback<void(RegionalStats)>;
+
   explicit AdBlockRegionalServiceManager(BraveComponent::Delegate* delegate);
   ~AdBlockRegionalServiceManager();
 
@@ -47,20 +65,52 @@ class AdBlockRegionalServiceManager {
                           const std::string& tab_host,
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly);
+  // Checks |request| against every enabled regional list. When a list
+  // blocks the request or matches an exception, its uuid is written to
+  // |matching_uuid| if non-null.
+  bool ShouldStartRequest(const ShieldsMatchRequest& request,
+                          bool* matching_exception_filter,
+                          bool* cancel_request_explicitly,
+                          std::string* matching_uuid);
   void EnableTag(const std::string& tag, bool enabled);
   void EnableFilterList(const std::string& uuid, bool enabled);
+  // Collects the stats on the IO thread and runs |callback| with them on the
+  // UI thread. Stats start over when a list is enabled again.
+  void GetRegionalStats(GetRegionalStatsCallback callback);
 
  private:
   friend class ::AdBlockServiceTest;
+  friend class ::ShieldsPerfTest;
+  // Active services in uuid order, read on the IO thread.
+  using RegionalServicesSnapshot =
+      std::vector<std::pair<std::string, AdBlockRegionalService*>>;
+  // Uuids of the enabled services that are not active yet, by the top-level
+  // domains that activate them.
+  using InactiveServicesByTLD = std::multimap<std::string, std::string>;
+
   bool Init();
   void StartRegionalServices();
   void UpdateFilterListPrefs(const std::string& uuid, bool enabled);
+  void MaybeActivateForTabHostOnIOThread(const std::string& tab_host);
+  void ActivateFilterList(const std::string& uuid);
+  // Must be called with |regional_services_lock_| held. |retired_service|,
+  // if any, is destroyed on the calling thread once the IO thread has
+  // switched to the new snapshot.
+  void PublishSnapshot(
+      std::unique_ptr<AdBlockRegionalService> retired_service = nullptr);
+  void SetSnapshotOnIOThread(RegionalServicesSnapshot snapshot,
+                             InactiveServicesByTLD inactive_services);
+  RegionalStats GetRegionalStatsOnIOThread();
 
   brave_component_updater::BraveComponent::Delegate* delegate_;  // NOT OWNED
   bool initialized_;
+  // Guards |regional_services_| for writers, which are rare. The request
+  // path only reads |io_regional_services_|.
   base::Lock regional_services_lock_;
   std::map<std::string, std::unique_ptr<AdBlockRegionalService>>
       regional_services_;
+  RegionalServicesSnapshot io_regional_services_;
+  InactiveServicesByTLD io_inactive_services_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalServiceManager);
 };
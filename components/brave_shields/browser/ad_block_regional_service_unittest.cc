@@ -3,9 +3,17 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/vendor/ad-block/lists/regions.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+// npm run test -- brave_unit_tests --filter=AdBlockRegionalServiceTest.*
+
 TEST(AdBlockRegionalServiceTest, SupportedLocales) {
   std::vector<std::string> locales({ "fr", "fR", "fr-FR", "fr-ca" });
   std::for_each(locales.begin(), locales.end(), [](const std::string& locale) {
@@ -13,3 +21,45 @@ TEST(AdBlockRegionalServiceTest, SupportedLocales) {
         locale));
   });
 }
+
+TEST(AdBlockRegionalServiceTest, FilterListTLDs) {
+  auto it = brave_shields::FindAdBlockFilterListByLocale(region_lists, "ja");
+  ASSERT_NE(it, region_lists.end());
+  const std::vector<std::string> tlds =
+      brave_shields::GetAdBlockFilterListTLDs(*it);
+  EXPECT_NE(std::find(tlds.begin(), tlds.end(), "jp"), tlds.end());
+  EXPECT_EQ(std::find(tlds.begin(), tlds.end(), "ja"), tlds.end());
+
+  it = brave_shields::FindAdBlockFilterListByLocale(region_lists, "fr");
+  ASSERT_NE(it, region_lists.end());
+  EXPECT_EQ(brave_shields::GetAdBlockFilterListTLDs(*it),
+            std::vector<std::string>({ "fr" }));
+}
+
+TEST(AdBlockRegionalServiceTest, TLDForHost) {
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost("www.example.jp"), "jp");
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost("www.example.co.jp"), "jp");
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost("example.jp."), "jp");
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost("EXAMPLE.JP"), "jp");
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost("localhost"), "");
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost("localhost."), "");
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost("192.168.0.1"), "");
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost("[::1]"), "");
+  EXPECT_EQ(brave_shields::GetAdBlockTLDForHost(""), "");
+}
+
+TEST(AdBlockRegionalServiceTest, HostActivatesFilterList) {
+  auto it = brave_shields::FindAdBlockFilterListByLocale(region_lists, "ja");
+  ASSERT_NE(it, region_lists.end());
+  const std::vector<std::string> tlds =
+      brave_shields::GetAdBlockFilterListTLDs(*it);
+  auto activates = [&tlds](const std::string& host) {
+    return std::find(tlds.begin(), tlds.end(),
+                     brave_shields::GetAdBlockTLDForHost(host)) != tlds.end();
+  };
+  EXPECT_TRUE(activates("www.example.co.jp"));
+  EXPECT_TRUE(activates("example.jp."));
+  EXPECT_FALSE(activates("example.ja"));
+  EXPECT_FALSE(activates("example.fr"));
+  EXPECT_FALSE(activates("jp"));
+}
@@ -16,6 +16,7 @@
 #include "components/prefs/pref_registry_simple.h"
 
 class AdBlockServiceTest;
+class ShieldsPerfTest;
 
 using brave_component_updater::BraveComponent;
 
@@ -46,6 +47,7 @@ class AdBlockService : public AdBlockBaseService {
 
  private:
   friend class ::AdBlockServiceTest;
+  friend class ::ShieldsPerfTest;
   static std::string g_ad_block_component_id_;
   static std::string g_ad_block_component_base64_public_key_;
   static std::string g_ad_block_dat_file_version_;
@@ -3,9 +3,14 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <memory>
+#include <utility>
+
 #include "base/path_service.h"
+#include "base/run_loop.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
+#include "base/values.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
@@ -21,9 +26,11 @@
 #include "chrome/browser/ui/browser.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_test_utils.h"
+#include "content/public/test/test_utils.h"
 #include "net/dns/mock_host_resolver.h"
 
 using content::BrowserThread;
@@ -192,6 +199,44 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
     return true;
   }
 
+  // Enables the regional list |uuid| the way a previous session would have,
+  // so that it is started but only loaded once it is activated.
+  bool InstallInactiveRegionalAdBlockExtension(const std::string& uuid) {
+    {
+      DictionaryPrefUpdate update(g_browser_process->local_state(),
+                                  kAdBlockRegionalFilters);
+      auto regional_filter_dict = std::make_unique<base::DictionaryValue>();
+      regional_filter_dict->SetBoolean("enabled", true);
+      update->Set(uuid, std::move(regional_filter_dict));
+    }
+    auto* manager =
+        g_brave_browser_process->ad_block_regional_service_manager();
+    manager->StartRegionalServices();
+    auto regional_service = manager->regional_services_.find(uuid);
+    if (regional_service == manager->regional_services_.end())
+      return false;
+
+    base::FilePath test_data_dir;
+    GetTestDataDir(&test_data_dir);
+    regional_service->second->OnComponentReady(
+        kRegionalAdBlockComponentTestId,
+        test_data_dir.AppendASCII("adblock-data")
+            .AppendASCII("adblock-regional")
+            .AppendASCII(uuid),
+        "");
+    WaitForAdBlockServiceThreads();
+
+    return !regional_service->second->IsActive();
+  }
+
+  bool IsRegionalAdBlockListActive(const std::string& uuid) {
+    auto* manager =
+        g_brave_browser_process->ad_block_regional_service_manager();
+    auto regional_service = manager->regional_services_.find(uuid);
+    return regional_service != manager->regional_services_.end() &&
+           regional_service->second->IsActive();
+  }
+
   bool InstallTrackingProtectionExtension() {
     base::FilePath test_data_dir;
     GetTestDataDir(&test_data_dir);
@@ -218,6 +263,8 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
   }
 
   void WaitForAdBlockServiceThreads() {
+    // Local data files load in the thread pool, replying to this thread.
+    content::RunAllTasksUntilIdle();
     scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
     ASSERT_TRUE(tr_helper->Run());
@@ -346,6 +393,72 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByRegionalBlocker) {
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
 }
 
+// Load a page from a top-level domain of an enabled but inactive regional
+// list, and make sure the list gets loaded and blocks ads.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       RegionalBlockerIsActivatedByTabHostTLD) {
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  ASSERT_TRUE(
+      InstallInactiveRegionalAdBlockExtension(kAdBlockEasyListFranceUUID));
+
+  GURL url = embedded_test_server()->GetURL("example.fr", kAdBlockTestPage);
+  ui_test_utils::NavigateToURL(browser(), url);
+  WaitForAdBlockServiceThreads();
+  EXPECT_TRUE(IsRegionalAdBlockListActive(kAdBlockEasyListFranceUUID));
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  bool as_expected = false;
+  ASSERT_TRUE(ExecuteScriptAndExtractBool(contents,
+                                          "setExpectations(0, 1, 0, 0, 0, 0);"
+                                          "addImage('ad_fr.png')",
+                                          &as_expected));
+  EXPECT_TRUE(as_expected);
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+}
+
+// Activate a regional list from its top-level domain, and make sure it is
+// still active after a restart, so that it applies to other domains too.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       PRE_ActivatedRegionalBlockerIsLoadedAtStartup) {
+  ASSERT_TRUE(
+      InstallInactiveRegionalAdBlockExtension(kAdBlockEasyListFranceUUID));
+
+  GURL url = embedded_test_server()->GetURL("example.fr", kAdBlockTestPage);
+  ui_test_utils::NavigateToURL(browser(), url);
+  WaitForAdBlockServiceThreads();
+  EXPECT_TRUE(IsRegionalAdBlockListActive(kAdBlockEasyListFranceUUID));
+}
+
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       ActivatedRegionalBlockerIsLoadedAtStartup) {
+  EXPECT_TRUE(IsRegionalAdBlockListActive(kAdBlockEasyListFranceUUID));
+}
+
+// Load a page from an unrelated top-level domain, and make sure an inactive
+// regional list is neither loaded nor matched against.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       RegionalBlockerStaysInactiveForOtherTLDs) {
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+  ASSERT_TRUE(
+      InstallInactiveRegionalAdBlockExtension(kAdBlockEasyListFranceUUID));
+
+  GURL url = embedded_test_server()->GetURL("example.de", kAdBlockTestPage);
+  ui_test_utils::NavigateToURL(browser(), url);
+  WaitForAdBlockServiceThreads();
+  EXPECT_FALSE(IsRegionalAdBlockListActive(kAdBlockEasyListFranceUUID));
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  bool as_expected = false;
+  ASSERT_TRUE(ExecuteScriptAndExtractBool(contents,
+                                          "setExpectations(1, 0, 0, 0, 0, 0);"
+                                          "addImage('ad_fr.png')",
+                                          &as_expected));
+  EXPECT_TRUE(as_expected);
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+}
+
 // Load a page with an image which is not an ad, and make sure it is
 // NOT blocked by the regional blocker.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
@@ -375,6 +488,52 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
+// Load a page with an ad image, and make sure the regional list that blocked
+// it counts the match in its stats.
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, RegionalListStatsCountMatches) {
+  g_browser_process->SetApplicationLocale("fr");
+  ASSERT_STREQ(g_browser_process->GetApplicationLocale().c_str(), "fr");
+
+  SetRegionalComponentIdAndBase64PublicKeyForTest(
+      kRegionalAdBlockComponentTestId,
+      kRegionalAdBlockComponentTestBase64PublicKey);
+  ASSERT_TRUE(InstallRegionalAdBlockExtension(kAdBlockEasyListFranceUUID));
+  ASSERT_TRUE(StartAdBlockRegionalServices());
+
+  GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
+  ui_test_utils::NavigateToURL(browser(), url);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  bool as_expected = false;
+  ASSERT_TRUE(ExecuteScriptAndExtractBool(contents,
+                                          "setExpectations(0, 1, 0, 0, 0, 0);"
+                                          "addImage('ad_fr.png')",
+                                          &as_expected));
+  EXPECT_TRUE(as_expected);
+
+  brave_shields::AdBlockRegionalServiceManager::RegionalStats stats;
+  base::RunLoop run_loop;
+  g_brave_browser_process->ad_block_regional_service_manager()
+      ->GetRegionalStats(base::BindOnce(
+          [](brave_shields::AdBlockRegionalServiceManager::RegionalStats* out,
+             base::OnceClosure quit,
+             brave_shields::AdBlockRegionalServiceManager::RegionalStats
+                 stats) {
+            *out = std::move(stats);
+            std::move(quit).Run();
+          },
+          &stats, run_loop.QuitClosure()));
+  run_loop.Run();
+
+  auto it = stats.find(kAdBlockEasyListFranceUUID);
+  ASSERT_NE(it, stats.end());
+  EXPECT_GT(it->second.rules_loaded, 0U);
+  EXPECT_GT(it->second.memory_bytes, 0U);
+  EXPECT_GE(it->second.requests_checked, it->second.requests_matched);
+  EXPECT_GE(it->second.requests_matched, 1U);
+}
+
 // Upgrade from v3 to v4 format data file and make sure v4-specific ad
 // is blocked.
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
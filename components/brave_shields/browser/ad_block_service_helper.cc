@@ -6,11 +6,34 @@
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 
 #include <algorithm>
+#include <map>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
+#include "url/url_util.h"
 
 namespace brave_shields {
 
+namespace {
+
+// Languages whose country code differs from the language code, or that are
+// spoken in several countries. Every other language maps to the TLD with the
+// same code.
+const std::multimap<std::string, std::string>& GetLangTLDs() {
+  static const base::NoDestructor<std::multimap<std::string, std::string>>
+      lang_tlds({
+          {"ar", "ae"}, {"ar", "dz"}, {"ar", "eg"}, {"ar", "ma"},
+          {"ar", "sa"}, {"be", "by"}, {"cs", "cz"}, {"da", "dk"},
+          {"el", "gr"}, {"et", "ee"}, {"fa", "ir"}, {"he", "il"},
+          {"hi", "in"}, {"ja", "jp"}, {"ko", "kr"}, {"nb", "no"},
+          {"sl", "si"}, {"sr", "rs"}, {"sv", "se"}, {"uk", "ua"},
+          {"vi", "vn"}, {"zh", "cn"}, {"zh", "hk"}, {"zh", "tw"},
+      });
+  return *lang_tlds;
+}
+
+}  // namespace
+
 std::vector<FilterList>::const_iterator FindAdBlockFilterListByUUID(
     const std::vector<FilterList>& region_lists,
     const std::string& uuid) {
@@ -42,4 +65,32 @@ std::vector<FilterList>::const_iterator FindAdBlockFilterListByLocale(
       });
 }
 
+std::vector<std::string> GetAdBlockFilterListTLDs(
+    const FilterList& filter_list) {
+  const auto& lang_tlds = GetLangTLDs();
+  std::vector<std::string> tlds;
+  for (const std::string& lang : filter_list.langs) {
+    auto range = lang_tlds.equal_range(lang);
+    if (range.first == range.second) {
+      tlds.push_back(lang);
+      continue;
+    }
+    for (auto it = range.first; it != range.second; ++it)
+      tlds.push_back(it->second);
+  }
+  return tlds;
+}
+
+std::string GetAdBlockTLDForHost(const std::string& host) {
+  if (url::HostIsIPAddress(host))
+    return std::string();
+  // Fully qualified hosts end with a dot, e.g. "example.jp.".
+  base::StringPiece labels =
+      base::TrimString(host, ".", base::TRIM_TRAILING);
+  const size_t dot = labels.rfind('.');
+  if (dot == base::StringPiece::npos)
+    return std::string();
+  return base::ToLowerASCII(labels.substr(dot + 1));
+}
+
 }  // namespace brave_shields
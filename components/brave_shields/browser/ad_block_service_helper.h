@@ -19,6 +19,13 @@ std::vector<FilterList>::const_iterator FindAdBlockFilterListByUUID(
 std::vector<FilterList>::const_iterator FindAdBlockFilterListByLocale(
     const std::vector<FilterList>& region_lists,
     const std::string& locale);
+// Top-level domains of the countries where the languages of |filter_list|
+// are spoken, e.g. "jp" for "ja".
+std::vector<std::string> GetAdBlockFilterListTLDs(
+    const FilterList& filter_list);
+// Top-level domain of |host| as listed by GetAdBlockFilterListTLDs(), or an
+// empty string for single-label hosts and IP addresses.
+std::string GetAdBlockTLDForHost(const std::string& host);
 
 }  // namespace brave_shields
 
@@ -11,6 +11,7 @@
 #include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/span.h"
 #include "base/location.h"
 #include "base/memory/weak_ptr.h"
 #include "base/no_destructor.h"
@@ -57,27 +58,54 @@ const unsigned char kJpeg1x1[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xda, 0x00, 0x08,
     0x01, 0x01, 0x00, 0x00, 0x3f, 0x00, 0x37, 0xff, 0xd9};
 
+const char kDefaultMimeType[] = "text/html";
+
+scoped_refptr<net::HttpResponseHeaders> CreateResponseHeaders(
+    const std::string& mime_type) {
+  // TODO(iefremov): Allowing any origins still breaks some CORS requests.
+  // Maybe we can provide something smarter here.
+  std::string raw_headers =
+      "HTTP/1.1 200 OK\r\n"
+      "Access-Control-Allow-Origin: *\r\n"
+      "Content-Type: " + mime_type + "\r\n";
+  return base::MakeRefCounted<net::HttpResponseHeaders>(
+      net::HttpUtil::AssembleRawHeaders(raw_headers.c_str(),
+                                        raw_headers.size()));
+}
+
+// Headers are never changed once parsed, so jobs serving the same mime type
+// share one copy, and bodies point straight at the stubs above.
+struct StubResponse {
+  StubResponse() = default;
+  StubResponse(const std::string& mime_type,
+               base::span<const unsigned char> body)
+      : body(body), headers(CreateResponseHeaders(mime_type)) {}
+
+  base::span<const unsigned char> body;
+  scoped_refptr<net::HttpResponseHeaders> headers;
+};
+
 // Basically, for now all Chromium image resource requests use hardcoded
 // 'Accept' header that starts with "image/webp". However, it is possible to
 // craft a custom 'Accept', for example, using XHR, so we provide stubs for
-// other popular mime types.
-std::vector<unsigned char> GetContentForMimeType(const std::string& mime_type) {
-  static const base::NoDestructor<
-      base::flat_map<std::string, std::vector<unsigned char>>>
-      content({
-          {"image/webp", {kWebp1x1, std::end(kWebp1x1)}},
-          {"image/*", {kPng1x1, std::end(kPng1x1)}},
-          {"image/apng", {kPng1x1, std::end(kPng1x1)}},
-          {"image/png", {kPng1x1, std::end(kPng1x1)}},
-          {"image/x-png", {kPng1x1, std::end(kPng1x1)}},
-          {"image/gif", {kGif1x1, std::end(kGif1x1)}},
-          {"image/jpeg", {kJpeg1x1, std::end(kJpeg1x1)}},
+// other popular mime types. Returns null for other mime types.
+const StubResponse* GetStubResponse(const std::string& mime_type) {
+  static const base::NoDestructor<base::flat_map<std::string, StubResponse>>
+      responses({
+          {kDefaultMimeType, {kDefaultMimeType, {}}},
+          {"image/webp", {"image/webp", kWebp1x1}},
+          {"image/*", {"image/*", kPng1x1}},
+          {"image/apng", {"image/apng", kPng1x1}},
+          {"image/png", {"image/png", kPng1x1}},
+          {"image/x-png", {"image/x-png", kPng1x1}},
+          {"image/gif", {"image/gif", kGif1x1}},
+          {"image/jpeg", {"image/jpeg", kJpeg1x1}},
       });
-  auto it = content->find(mime_type);
-  if (it == content->end()) {
-    return {};
+  auto it = responses->find(mime_type);
+  if (it == responses->end()) {
+    return nullptr;
   }
-  return it->second;
+  return &it->second;
 }
 
 class Http200OkJob : public net::URLRequestJob {
@@ -98,8 +126,11 @@ class Http200OkJob : public net::URLRequestJob {
   void InitMimeAndResponse(net::URLRequest* request);
 
   // Intercepted from 'Accept:' (or default if the header is empty).
-  std::string mime_type_ = "text/html";
-  std::vector<unsigned char> response_body_;
+  std::string mime_type_ = kDefaultMimeType;
+  // Points at static data, so it outlives the job.
+  base::span<const unsigned char> response_body_;
+  size_t bytes_read_ = 0;
+  scoped_refptr<net::HttpResponseHeaders> headers_;
 
   base::WeakPtrFactory<Http200OkJob> weak_factory_;
 };
@@ -130,33 +161,17 @@ bool Http200OkJob::GetMimeType(std::string* mime_type) const {
 
 void Http200OkJob::GetResponseInfo(net::HttpResponseInfo* info) {
   net::HttpResponseInfo new_info;
-  // TODO(iefremov): Allowing any origins still breaks some CORS requests.
-  // Maybe we can provide something smarter here.
-  // TODO(iefremov): Some URLRequests users extract Content-Type from headers,
-  // not from |GetMimeType()|. Probably we could add a Content-Type here.
-  std::string raw_headers =
-      "HTTP/1.1 200 OK\r\n"
-      "Access-Control-Allow-Origin: *\r\n"
-      "Content-Type: " + mime_type_ + "\r\n";
-  new_info.headers =
-      new net::HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(
-          raw_headers.c_str(), raw_headers.size()));
+  new_info.headers = headers_;
   *info = new_info;
 }
 
 int Http200OkJob::ReadRawData(net::IOBuffer* buf, int buf_size) {
-  if (response_body_.empty()) {
-    return 0;
-  }
-
-  size_t bytes_to_copy =
-      std::min(static_cast<size_t>(buf_size), response_body_.size());
+  size_t bytes_to_copy = std::min(static_cast<size_t>(buf_size),
+                                  response_body_.size() - bytes_read_);
   if (bytes_to_copy > 0) {
-    std::memcpy(buf->data(), response_body_.data(), bytes_to_copy);
-    // We do not optimize here because returned data is typically much shorter
-    // than the buf_size, so there is only one call.
-    response_body_.erase(response_body_.begin(),
-                         response_body_.begin() + bytes_to_copy);
+    std::memcpy(buf->data(), response_body_.data() + bytes_read_,
+                bytes_to_copy);
+    bytes_read_ += bytes_to_copy;
   }
   return bytes_to_copy;
 }
@@ -173,16 +188,23 @@ void Http200OkJob::InitMimeAndResponse(net::URLRequest* request) {
   auto headers = request->extra_request_headers();
   std::string accept_header;
   headers.GetHeader("Accept", &accept_header);
-  auto mime_types = base::SplitString(
+  auto mime_types = base::SplitStringPiece(
       accept_header, ",;", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
   if (!mime_types.empty()) {
     DCHECK(!mime_types.front().empty());
     // If the entry looks like "*/*", use the default value. Otherwise, use
     // the value from 'Accept', even if it looks like "audio/*".
     if (mime_types.front()[0] != '*') {
-      mime_type_ = mime_types.front();
+      mime_type_ = mime_types.front().as_string();
     }
-    response_body_ = GetContentForMimeType(mime_type_);
+  }
+
+  const StubResponse* stub = GetStubResponse(mime_type_);
+  if (stub) {
+    response_body_ = stub->body;
+    headers_ = stub->headers;
+  } else {
+    headers_ = CreateResponseHeaders(mime_type_);
   }
 }
 
@@ -50,10 +50,11 @@ void AutoplayWhitelistService::OnComponentReady(
       .AppendASCII(AUTOPLAY_DAT_FILE);
 
   base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
+      local_data_files_service()->GetLoadTaskRunner().get(),
       FROM_HERE,
       base::BindOnce(
-          &brave_component_updater::LoadDATFileData<AutoplayWhitelistParser>,
+          &brave_component_updater::LoadMappedDATFileData<
+              AutoplayWhitelistParser>,
           dat_file_path),
       base::BindOnce(&AutoplayWhitelistService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
@@ -61,7 +62,7 @@ void AutoplayWhitelistService::OnComponentReady(
 
 void AutoplayWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (result.second.empty()) {
+  if (!result.second) {
     LOG(ERROR) << "Could not obtain autoplay whitelist data";
     return;
   }
@@ -71,7 +72,7 @@ void AutoplayWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
   }
 
   autoplay_whitelist_client_ = std::move(result.first);
-  buffer_ = std::move(result.second);
+  dat_file_ = std::move(result.second);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
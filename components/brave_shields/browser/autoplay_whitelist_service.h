@@ -29,7 +29,8 @@ namespace brave_shields {
 class AutoplayWhitelistService : public LocalDataFilesObserver {
  public:
   using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<AutoplayWhitelistParser>;
+      brave_component_updater::LoadMappedDATFileDataResult<
+          AutoplayWhitelistParser>;
 
   explicit AutoplayWhitelistService(
       LocalDataFilesService* local_data_files_service);
@@ -48,7 +49,8 @@ class AutoplayWhitelistService : public LocalDataFilesObserver {
   void OnGetDATFileData(GetDATFileDataResult result);
 
   std::unique_ptr<AutoplayWhitelistParser> autoplay_whitelist_client_;
-  brave_component_updater::DATFileDataBuffer buffer_;
+  // |autoplay_whitelist_client_| points into this buffer.
+  std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file_;
   SEQUENCE_CHECKER(sequence_checker_);
 
   base::WeakPtrFactory<AutoplayWhitelistService> weak_factory_;
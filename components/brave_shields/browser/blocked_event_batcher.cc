@@ -0,0 +1,99 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace brave_shields {
+
+namespace {
+
+// How long blocked events are collected before they are sent to the UI
+// thread. Short enough for the shields panel counts to look live.
+constexpr base::TimeDelta kBlockedEventFlushDelay =
+    base::TimeDelta::FromMilliseconds(200);
+
+}  // namespace
+
+BlockedEvent::BlockedEvent(const std::string& block_type,
+                           const std::string& subresource,
+                           int render_process_id,
+                           int render_frame_id,
+                           int frame_tree_node_id)
+    : block_type(block_type),
+      subresource(subresource),
+      render_process_id(render_process_id),
+      render_frame_id(render_frame_id),
+      frame_tree_node_id(frame_tree_node_id) {
+}
+
+BlockedEvent::BlockedEvent(const BlockedEvent& other) = default;
+
+BlockedEvent::~BlockedEvent() {
+}
+
+// static
+BlockedEventBatcher* BlockedEventBatcher::GetInstance() {
+  static base::NoDestructor<BlockedEventBatcher> instance;
+  return instance.get();
+}
+
+BlockedEventBatcher::BlockedEventBatcher() : flush_in_flight_(false) {
+}
+
+BlockedEventBatcher::~BlockedEventBatcher() {
+}
+
+void BlockedEventBatcher::Add(const BlockedEvent& event) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (!pending_keys_.insert(std::make_tuple(event.render_process_id,
+                                            event.render_frame_id,
+                                            event.frame_tree_node_id,
+                                            event.block_type,
+                                            event.subresource)).second) {
+    return;
+  }
+  pending_.push_back(event);
+  if (!flush_in_flight_ && !flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, kBlockedEventFlushDelay,
+                       base::Bind(&BlockedEventBatcher::Flush,
+                                  base::Unretained(this)));
+  }
+}
+
+void BlockedEventBatcher::Flush() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  std::vector<BlockedEvent> events;
+  events.swap(pending_);
+  pending_keys_.clear();
+  flush_in_flight_ = true;
+  base::PostTaskWithTraitsAndReply(
+      FROM_HERE, {BrowserThread::UI},
+      base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvents,
+                     std::move(events)),
+      base::BindOnce(&BlockedEventBatcher::OnFlushed,
+                     base::Unretained(this)));
+}
+
+void BlockedEventBatcher::OnFlushed() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  flush_in_flight_ = false;
+  if (!pending_.empty() && !flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, kBlockedEventFlushDelay,
+                       base::Bind(&BlockedEventBatcher::Flush,
+                                  base::Unretained(this)));
+  }
+}
+
+}  // namespace brave_shields
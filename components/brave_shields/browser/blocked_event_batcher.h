@@ -0,0 +1,73 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
+
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/timer/timer.h"
+
+namespace brave_shields {
+
+// A request blocked or upgraded by shields, recorded on the IO thread.
+struct BlockedEvent {
+  BlockedEvent(const std::string& block_type,
+               const std::string& subresource,
+               int render_process_id,
+               int render_frame_id,
+               int frame_tree_node_id);
+  BlockedEvent(const BlockedEvent& other);
+  ~BlockedEvent();
+
+  std::string block_type;
+  std::string subresource;
+  int render_process_id;
+  int render_frame_id;
+  int frame_tree_node_id;
+};
+
+// Collects shields blocked events on the IO thread and hands them to
+// BraveShieldsWebContentsObserver::DispatchBlockedEvents in one UI task per
+// tick, so counters and prefs are updated once per batch rather than once
+// per blocked request.
+//
+// At most one batch is in flight at a time: while the UI thread has not run
+// the last one, new events keep accumulating here instead of queueing more
+// tasks behind a busy UI thread. Repeats of a subresource within a batch are
+// dropped, since the UI side counts each subresource once per page anyway.
+class BlockedEventBatcher {
+ public:
+  static BlockedEventBatcher* GetInstance();
+
+  void Add(const BlockedEvent& event);
+
+ private:
+  friend class base::NoDestructor<BlockedEventBatcher>;
+
+  BlockedEventBatcher();
+  ~BlockedEventBatcher();
+
+  void Flush();
+  void OnFlushed();
+
+  using EventKey = std::tuple<int, int, int, std::string, std::string>;
+
+  std::vector<BlockedEvent> pending_;
+  std::set<EventKey> pending_keys_;
+  base::OneShotTimer flush_timer_;
+  bool flush_in_flight_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockedEventBatcher);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
@@ -7,18 +7,20 @@
 
 #include <memory>
 
-#include "base/task/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/shield_exceptions.h"
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/referrer_whitelist_service.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/profiles/profile_io_data.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 #include "components/content_settings/core/common/content_settings_utils.h"
-#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/resource_request_info.h"
 #include "content/public/browser/websocket_handshake_request_info.h"
 #include "content/public/common/referrer.h"
@@ -57,17 +59,38 @@ bool GetDefaultFromResourceIdentifier(const std::string& resource_identifier,
 
 }  // namespace
 
+void SetShieldsSettings(HostContentSettingsMap* map,
+                        const std::vector<ShieldsSettingRule>& rules) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  content_settings::BravePrefProvider::ScopedBatchUpdate batch_update;
+  for (const auto& rule : rules) {
+    map->SetContentSettingCustomScope(
+        rule.primary_pattern, rule.secondary_pattern,
+        CONTENT_SETTINGS_TYPE_PLUGINS, rule.resource_identifier,
+        rule.setting);
+  }
+}
+
 bool IsAllowContentSetting(HostContentSettingsMap* content_settings,
                            const GURL& primary_url,
                            const GURL& secondary_url,
                            ContentSettingsType setting_type,
                            const std::string& resource_identifier) {
   DCHECK(content_settings);
-  content_settings::SettingInfo setting_info;
-  std::unique_ptr<base::Value> value = content_settings->GetWebsiteSetting(
-      primary_url, secondary_url, setting_type, resource_identifier,
-      &setting_info);
-  ContentSetting setting = content_settings::ValueToContentSetting(value.get());
+  ContentSetting setting = CONTENT_SETTING_DEFAULT;
+  // Shields settings are plugin settings with a resource identifier, which
+  // can be looked up through the rules index instead of every exception
+  if (setting_type != CONTENT_SETTINGS_TYPE_PLUGINS ||
+      resource_identifier.empty() ||
+      !ShieldsSettingsCache::GetInstance()->GetContentSetting(
+          content_settings, primary_url, secondary_url, resource_identifier,
+          &setting)) {
+    content_settings::SettingInfo setting_info;
+    std::unique_ptr<base::Value> value = content_settings->GetWebsiteSetting(
+        primary_url, secondary_url, setting_type, resource_identifier,
+        &setting_info);
+    setting = content_settings::ValueToContentSetting(value.get());
+  }
 
   // TODO(bbondy): Add a static RegisterUserPrefs method for shields and use
   // prefs instead of simply returning true / false below.
@@ -123,6 +146,44 @@ bool IsAllowContentSettingWithIOData(ProfileIOData* io_data,
                                resource_identifier);
 }
 
+ShieldsSettingsSnapshot GetShieldsSettingsFromIO(const net::URLRequest* request,
+                                                 const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  ProfileIOData* io_data = nullptr;
+  content::ResourceRequestInfo* resource_info =
+      content::ResourceRequestInfo::ForRequest(request);
+  if (resource_info)
+    io_data = ProfileIOData::FromResourceContext(resource_info->GetContext());
+  HostContentSettingsMap* map =
+      io_data ? io_data->GetHostContentSettingsMap() : nullptr;
+
+  ShieldsSettingsSnapshot snapshot;
+  ShieldsSettingsCache* cache = ShieldsSettingsCache::GetInstance();
+  if (map && cache->Get(map, tab_origin, &snapshot))
+    return snapshot;
+
+  snapshot.allow_brave_shields = IsAllowContentSettingWithIOData(
+      io_data, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
+      kBraveShields);
+  snapshot.allow_ads = IsAllowContentSettingWithIOData(
+      io_data, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS, kAds);
+  snapshot.allow_http_upgradable_resource = IsAllowContentSettingWithIOData(
+      io_data, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
+      kHTTPUpgradableResources);
+  snapshot.allow_1p_cookies = IsAllowContentSettingWithIOData(
+      io_data, tab_origin, GURL("https://firstParty/"),
+      CONTENT_SETTINGS_TYPE_PLUGINS, kCookies);
+  snapshot.allow_3p_cookies = IsAllowContentSettingWithIOData(
+      io_data, tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS, kCookies);
+  snapshot.allow_referrers = IsAllowContentSettingWithIOData(
+      io_data, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
+      kReferrers);
+
+  if (map)
+    cache->Put(map, tab_origin, snapshot);
+  return snapshot;
+}
+
 void GetRenderFrameInfo(const URLRequest* request,
                         int* render_frame_id,
                         int* render_process_id,
@@ -154,11 +215,9 @@ void DispatchBlockedEventFromIO(const GURL& request_url,
                                 int frame_tree_node_id,
                                 const std::string& block_type) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  base::PostTaskWithTraits(
-      FROM_HERE, {BrowserThread::UI},
-      base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvent,
-                     block_type, request_url.spec(), render_process_id,
-                     render_frame_id, frame_tree_node_id));
+  BlockedEventBatcher::GetInstance()->Add(
+      BlockedEvent(block_type, request_url.spec(), render_process_id,
+                   render_frame_id, frame_tree_node_id));
 }
 
 bool ShouldSetReferrer(bool allow_referrers,
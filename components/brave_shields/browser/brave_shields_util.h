@@ -8,7 +8,10 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 #include "services/network/public/mojom/referrer_policy.mojom.h"
 
@@ -27,6 +30,22 @@ class ProfileIOData;
 
 namespace brave_shields {
 
+struct ShieldsSettingsSnapshot;
+
+// One shields rule. CONTENT_SETTING_DEFAULT removes the rule.
+struct ShieldsSettingRule {
+  ContentSettingsPattern primary_pattern;
+  ContentSettingsPattern secondary_pattern;
+  std::string resource_identifier;
+  ContentSetting setting = CONTENT_SETTING_DEFAULT;
+};
+
+// Applies |rules| to |map| in one batch, so content settings observers and
+// renderers are updated once rather than once per rule. Must be called on
+// the UI thread.
+void SetShieldsSettings(HostContentSettingsMap* map,
+                        const std::vector<ShieldsSettingRule>& rules);
+
 bool IsAllowContentSetting(HostContentSettingsMap* content_settings,
                            const GURL& primary_url,
                            const GURL& secondary_url,
@@ -51,6 +70,11 @@ bool IsAllowContentSettingFromIO(const net::URLRequest* request,
                                  ContentSettingsType setting_type,
                                  const std::string& resource_identifier);
 
+// Resolves all shields settings for |tab_origin| at once, served from
+// ShieldsSettingsCache when possible.
+ShieldsSettingsSnapshot GetShieldsSettingsFromIO(const net::URLRequest* request,
+                                                 const GURL& tab_origin);
+
 void DispatchBlockedEventFromIO(const GURL& request_url,
                                 int render_frame_id,
                                 int render_process_id,
@@ -7,11 +7,15 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -26,6 +30,7 @@
 #include "components/prefs/pref_service.h"
 #include "content/browser/frame_host/frame_tree_node.h"
 #include "content/browser/frame_host/navigator.h"
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/navigation_handle.h"
@@ -38,6 +43,7 @@
 
 #if BUILDFLAG(ENABLE_EXTENSIONS)
 #include "brave/common/extensions/api/brave_shields.h"
+#include "brave/common/extensions/extension_constants.h"
 #include "chrome/browser/extensions/extension_tab_util.h"
 #include "extensions/browser/event_router.h"
 #include "extensions/browser/extension_api_frame_id_map.h"
@@ -46,39 +52,13 @@ using extensions::Event;
 using extensions::EventRouter;
 #endif
 
+using content::BrowserThread;
 using content::Referrer;
 using content::RenderFrameHost;
 using content::WebContents;
 
 namespace {
 
-// Content Settings are only sent to the main frame currently.
-// Chrome may fix this at some point, but for now we do this as a work-around.
-// You can verify if this is fixed by running the following test:
-// npm run test -- brave_browser_tests --filter=BraveContentSettingsObserverBrowserTest.*  // NOLINT
-// Chrome seems to also have a bug with RenderFrameHostChanged not updating
-// the content settings so this is fixed here too. That case is covered in
-// tests by:
-// npm run test -- brave_browser_tests --filter=BraveContentSettingsObserverBrowserTest.*  // NOLINT
-void UpdateContentSettingsToRendererFrames(content::WebContents* web_contents) {
-  for (content::RenderFrameHost* frame : web_contents->GetAllFrames()) {
-    Profile* profile =
-        Profile::FromBrowserContext(web_contents->GetBrowserContext());
-    const HostContentSettingsMap* map =
-        HostContentSettingsMapFactory::GetForProfile(profile);
-    RendererContentSettingRules rules;
-    GetRendererContentSettingRules(map, &rules);
-    IPC::ChannelProxy* channel =
-        frame->GetProcess()->GetChannel();
-    // channel might be NULL in tests.
-    if (channel) {
-      chrome::mojom::RendererConfigurationAssociatedPtr rc_interface;
-      channel->GetRemoteAssociatedInterface(&rc_interface);
-      rc_interface->SetContentSettingRules(rules);
-    }
-  }
-}
-
 WebContents* GetWebContents(
     int render_process_id,
     int render_frame_id,
@@ -97,15 +77,41 @@ WebContents* GetWebContents(
   return web_contents;
 }
 
+using BlockedCounts =
+    brave_shields::BraveShieldsWebContentsObserver::BlockedCounts;
+
+void IncrementUint64Pref(PrefService* prefs,
+                         const char* pref_name,
+                         uint64_t delta) {
+  if (delta) {
+    prefs->SetUint64(pref_name, prefs->GetUint64(pref_name) + delta);
+  }
+}
+
+// One write per counter for the whole batch.
+void IncrementBlockedCountPrefs(PrefService* prefs,
+                                const BlockedCounts& counts) {
+  IncrementUint64Pref(prefs, kAdsBlocked, counts.ads);
+  IncrementUint64Pref(prefs, kTrackersBlocked, counts.trackers);
+  IncrementUint64Pref(prefs, kHttpsUpgrades, counts.https_upgrades);
+  IncrementUint64Pref(prefs, kJavascriptBlocked, counts.javascript);
+  IncrementUint64Pref(prefs, kFingerprintingBlocked, counts.fingerprinting);
+}
+
+// How long blocked scripts and fingerprinting attempts reported over IPC are
+// collected before the shields extension is told about them. Matches the
+// delay of BlockedEventBatcher so the panel counts update at the same rate.
+constexpr base::TimeDelta kBlockedResourcesDispatchDelay =
+    base::TimeDelta::FromMilliseconds(200);
+
 }  // namespace
 
 namespace brave_shields {
 
-base::Lock BraveShieldsWebContentsObserver::frame_data_map_lock_;
-std::map<BraveShieldsWebContentsObserver::RenderFrameIdKey, GURL>
-    BraveShieldsWebContentsObserver::frame_key_to_tab_url_;
-std::map<int, GURL>
-    BraveShieldsWebContentsObserver::frame_tree_node_id_to_tab_url_;
+struct BraveShieldsWebContentsObserver::TabURLMaps {
+  std::map<RenderFrameIdKey, GURL> by_frame_key;
+  std::map<int, GURL> by_frame_tree_node_id;
+};
 
 BraveShieldsWebContentsObserver::RenderFrameIdKey::RenderFrameIdKey()
     : render_process_id(content::ChildProcessHost::kInvalidUniqueID),
@@ -134,7 +140,62 @@ BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
-    : WebContentsObserver(web_contents) {
+    : WebContentsObserver(web_contents),
+      content_settings_map_(HostContentSettingsMapFactory::GetForProfile(
+          Profile::FromBrowserContext(web_contents->GetBrowserContext()))),
+      rules_version_(0),
+      content_settings_observer_(this) {
+  content_settings_observer_.Add(content_settings_map_);
+}
+
+// Content Settings are only sent to the main frame currently.
+// Chrome may fix this at some point, but for now we do this as a work-around.
+// You can verify if this is fixed by running the following test:
+// npm run test -- brave_browser_tests --filter=BraveContentSettingsObserverBrowserTest.*  // NOLINT
+// Chrome seems to also have a bug with RenderFrameHostChanged not updating
+// the content settings so this is fixed here too. That case is covered in
+// tests by:
+// npm run test -- brave_browser_tests --filter=BraveContentSettingsObserverBrowserTest.*  // NOLINT
+void BraveShieldsWebContentsObserver::UpdateContentSettingsToRendererFrames() {
+  // Rules are the same for every frame, so they are built at most once and
+  // sent only to the renderer processes of this tab that have not been sent
+  // the current rules version yet
+  std::unique_ptr<RendererContentSettingRules> rules;
+  for (content::RenderFrameHost* frame : web_contents()->GetAllFrames()) {
+    content::RenderProcessHost* process = frame->GetProcess();
+    auto it = rules_version_by_process_id_.find(process->GetID());
+    if (it != rules_version_by_process_id_.end() &&
+        it->second == rules_version_)
+      continue;
+
+    IPC::ChannelProxy* channel = process->GetChannel();
+    // channel might be NULL in tests.
+    if (!channel)
+      continue;
+
+    if (!rules) {
+      rules = std::make_unique<RendererContentSettingRules>();
+      GetRendererContentSettingRules(content_settings_map_, rules.get());
+    }
+    chrome::mojom::RendererConfigurationAssociatedPtr rc_interface;
+    channel->GetRemoteAssociatedInterface(&rc_interface);
+    rc_interface->SetContentSettingRules(*rules);
+    // The renderer drops the decisions it cached from the old rules. Once per
+    // process is enough, as the rules are shared by all of its frames.
+    frame->Send(new BraveFrameMsg_ContentSettingRulesChanged(
+        frame->GetRoutingID()));
+    rules_version_by_process_id_[process->GetID()] = rules_version_;
+  }
+}
+
+void BraveShieldsWebContentsObserver::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  // Changes only bump the version. Bulk changes such as imports or sync are
+  // then sent once, the next time a frame of this tab needs the rules.
+  ++rules_version_;
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameCreated(
@@ -146,22 +207,28 @@ void BraveShieldsWebContentsObserver::RenderFrameCreated(
 
   WebContents* web_contents = WebContents::FromRenderFrameHost(rfh);
   if (web_contents) {
-    UpdateContentSettingsToRendererFrames(web_contents);
+    UpdateContentSettingsToRendererFrames();
 
-    base::AutoLock lock(frame_data_map_lock_);
     const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
-    frame_key_to_tab_url_[key] = web_contents->GetURL();
-    frame_tree_node_id_to_tab_url_[rfh->GetFrameTreeNodeId()] =
-        web_contents->GetURL();
+    base::PostTaskWithTraits(
+        FROM_HERE, {BrowserThread::IO},
+        base::BindOnce(&BraveShieldsWebContentsObserver::SetTabURLOnIOThread,
+                       key, rfh->GetFrameTreeNodeId(),
+                       web_contents->GetURL()));
   }
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameDeleted(
     RenderFrameHost* rfh) {
-  base::AutoLock lock(frame_data_map_lock_);
+  // Also called for every frame of a crashed renderer. The process host may
+  // be reused by a new renderer, which has to be sent the rules again.
+  rules_version_by_process_id_.erase(rfh->GetProcess()->GetID());
+
   const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
-  frame_key_to_tab_url_.erase(key);
-  frame_tree_node_id_to_tab_url_.erase(rfh->GetFrameTreeNodeId());
+  base::PostTaskWithTraits(
+      FROM_HERE, {BrowserThread::IO},
+      base::BindOnce(&BraveShieldsWebContentsObserver::RemoveTabURLOnIOThread,
+                     key, rfh->GetFrameTreeNodeId()));
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
@@ -184,31 +251,85 @@ void BraveShieldsWebContentsObserver::DidFinishNavigation(
   int routing_id = main_frame->GetRoutingID();
   int tree_node_id = main_frame->GetFrameTreeNodeId();
 
-  base::AutoLock lock(frame_data_map_lock_);
-  frame_key_to_tab_url_[{process_id, routing_id}] = web_contents()->GetURL();
-  frame_tree_node_id_to_tab_url_[tree_node_id] = web_contents()->GetURL();
+  base::PostTaskWithTraits(
+      FROM_HERE, {BrowserThread::IO},
+      base::BindOnce(&BraveShieldsWebContentsObserver::SetTabURLOnIOThread,
+                     RenderFrameIdKey(process_id, routing_id), tree_node_id,
+                     web_contents()->GetURL()));
+}
+
+// static
+BraveShieldsWebContentsObserver::TabURLMaps*
+BraveShieldsWebContentsObserver::GetTabURLMapsOnIOThread() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  static base::NoDestructor<TabURLMaps> tab_url_maps;
+  return tab_url_maps.get();
+}
+
+// static
+void BraveShieldsWebContentsObserver::SetTabURLOnIOThread(
+    const RenderFrameIdKey& key,
+    int frame_tree_node_id,
+    const GURL& tab_url) {
+  TabURLMaps* tab_url_maps = GetTabURLMapsOnIOThread();
+  tab_url_maps->by_frame_key[key] = tab_url;
+  tab_url_maps->by_frame_tree_node_id[frame_tree_node_id] = tab_url;
+}
+
+// static
+void BraveShieldsWebContentsObserver::RemoveTabURLOnIOThread(
+    const RenderFrameIdKey& key,
+    int frame_tree_node_id) {
+  TabURLMaps* tab_url_maps = GetTabURLMapsOnIOThread();
+  tab_url_maps->by_frame_key.erase(key);
+  tab_url_maps->by_frame_tree_node_id.erase(frame_tree_node_id);
 }
 
 // static
 GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
     int render_process_id, int render_frame_id, int render_frame_tree_node_id) {
-  base::AutoLock lock(frame_data_map_lock_);
+  const TabURLMaps* tab_url_maps = GetTabURLMapsOnIOThread();
   if (-1 != render_process_id && -1 != render_frame_id) {
-    auto iter = frame_key_to_tab_url_.find({render_process_id,
-                                            render_frame_id});
-    if (iter != frame_key_to_tab_url_.end()) {
+    auto iter = tab_url_maps->by_frame_key.find({render_process_id,
+                                                 render_frame_id});
+    if (iter != tab_url_maps->by_frame_key.end()) {
       return iter->second;
     }
   }
   if (-1 != render_frame_tree_node_id) {
-    auto iter2 = frame_tree_node_id_to_tab_url_.find(render_frame_tree_node_id);
-    if (iter2 != frame_tree_node_id_to_tab_url_.end()) {
+    auto iter2 = tab_url_maps->by_frame_tree_node_id.find(
+        render_frame_tree_node_id);
+    if (iter2 != tab_url_maps->by_frame_tree_node_id.end()) {
       return iter2->second;
     }
   }
   return GURL();
 }
 
+void BraveShieldsWebContentsObserver::BlockedCounts::Add(
+    const std::string& block_type) {
+  if (block_type == brave_shields::kAds) {
+    ads++;
+  } else if (block_type == brave_shields::kTrackers) {
+    trackers++;
+  } else if (block_type == brave_shields::kHTTPUpgradableResources) {
+    https_upgrades++;
+  } else if (block_type == brave_shields::kJavaScript) {
+    javascript++;
+  } else if (block_type == brave_shields::kFingerprinting) {
+    fingerprinting++;
+  }
+}
+
+void BraveShieldsWebContentsObserver::BlockedCounts::Add(
+    const BlockedCounts& other) {
+  ads += other.ads;
+  trackers += other.trackers;
+  https_upgrades += other.https_upgrades;
+  javascript += other.javascript;
+  fingerprinting += other.fingerprinting;
+}
+
 bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
     const std::string& subresource) {
   return blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
@@ -219,76 +340,120 @@ void BraveShieldsWebContentsObserver::AddBlockedSubresource(
   blocked_url_paths_.insert(subresource);
 }
 
-// static
-void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
-    std::string block_type,
-    std::string subresource,
-    int render_process_id,
-    int render_frame_id,
-    int frame_tree_node_id) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-
-  WebContents* web_contents = GetWebContents(render_process_id,
-    render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+bool BraveShieldsWebContentsObserver::AddPendingBlockedResource(
+    const std::string& block_type,
+    const std::string& subresource) {
+  pending_blocked_resources_.push_back({block_type, subresource});
+  if (IsBlockedSubresource(subresource)) {
+    return false;
+  }
+  AddBlockedSubresource(subresource);
+  blocked_counts_.Add(block_type);
+  pending_blocked_counts_.Add(block_type);
+  return true;
+}
 
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kTrackers) {
-        prefs->SetUint64(kTrackersBlocked,
-            prefs->GetUint64(kTrackersBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprinting) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
-    }
+void BraveShieldsWebContentsObserver::ScheduleBlockedResourcesDispatch() {
+  if (!dispatch_blocked_resources_timer_.IsRunning()) {
+    dispatch_blocked_resources_timer_.Start(FROM_HERE,
+        kBlockedResourcesDispatchDelay,
+        base::Bind(
+            &BraveShieldsWebContentsObserver::DispatchPendingBlockedResources,
+            base::Unretained(this)));
   }
 }
 
-// static
-void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
-    const std::string& block_type, const std::string& subresource,
-    WebContents* web_contents) {
-#if BUILDFLAG(ENABLE_EXTENSIONS)
-  if (!web_contents) {
+void BraveShieldsWebContentsObserver::DispatchPendingBlockedResources() {
+  dispatch_blocked_resources_timer_.Stop();
+  if (pending_blocked_resources_.empty()) {
     return;
   }
+  std::vector<PendingBlockedResource> resources;
+  resources.swap(pending_blocked_resources_);
+  const BlockedCounts counts = pending_blocked_counts_;
+  pending_blocked_counts_ = BlockedCounts();
+
+#if BUILDFLAG(ENABLE_EXTENSIONS)
   Profile* profile =
-      Profile::FromBrowserContext(web_contents->GetBrowserContext());
+      Profile::FromBrowserContext(web_contents()->GetBrowserContext());
   EventRouter* event_router = EventRouter::Get(profile);
-  if (profile && event_router) {
-    extensions::api::brave_shields::OnBlocked::Details details;
-    details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
-    details.block_type = block_type;
-    details.subresource = subresource;
-    std::unique_ptr<base::ListValue> args(
-        extensions::api::brave_shields::OnBlocked::Create(details)
-          .release());
-    std::unique_ptr<Event> event(
-        new Event(extensions::events::BRAVE_AD_BLOCKED,
-          extensions::api::brave_shields::OnBlocked::kEventName,
-          std::move(args)));
-    event_router->BroadcastEvent(std::move(event));
+  // Only the shields extension shows these, so nothing is serialized for
+  // other extensions and nothing at all when it is not listening.
+  if (!event_router || !event_router->ExtensionHasEventListener(
+          brave_extension_id,
+          extensions::api::brave_shields::OnBlocked::kEventName)) {
+    return;
+  }
+
+  extensions::api::brave_shields::OnBlocked::Details details;
+  details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents());
+  details.resources.reserve(resources.size());
+  for (PendingBlockedResource& resource : resources) {
+    extensions::api::brave_shields::BlockedResource blocked_resource;
+    blocked_resource.block_type = std::move(resource.block_type);
+    blocked_resource.subresource = std::move(resource.subresource);
+    details.resources.push_back(std::move(blocked_resource));
   }
+  details.counts.tab_id = details.tab_id;
+  details.counts.ads = counts.ads;
+  details.counts.trackers = counts.trackers;
+  details.counts.https_upgrades = counts.https_upgrades;
+  details.counts.javascript = counts.javascript;
+  details.counts.fingerprinting = counts.fingerprinting;
+
+  std::unique_ptr<base::ListValue> args(
+      extensions::api::brave_shields::OnBlocked::Create(details).release());
+  std::unique_ptr<Event> event(
+      new Event(extensions::events::BRAVE_AD_BLOCKED,
+        extensions::api::brave_shields::OnBlocked::kEventName,
+        std::move(args)));
+  event_router->DispatchEventToExtension(brave_extension_id, std::move(event));
 #endif
 }
 
+// static
+void BraveShieldsWebContentsObserver::DispatchBlockedEvents(
+    std::vector<BlockedEvent> events) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  std::map<WebContents*, BlockedCounts> tab_counts;
+  std::set<BraveShieldsWebContentsObserver*> observers;
+  for (const BlockedEvent& event : events) {
+    WebContents* web_contents = GetWebContents(event.render_process_id,
+        event.render_frame_id, event.frame_tree_node_id);
+    if (!web_contents) {
+      continue;
+    }
+    BraveShieldsWebContentsObserver* observer =
+        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+    if (!observer) {
+      continue;
+    }
+    observers.insert(observer);
+    if (observer->AddPendingBlockedResource(event.block_type,
+                                            event.subresource)) {
+      tab_counts[web_contents].Add(event.block_type);
+    }
+  }
+
+  std::map<PrefService*, BlockedCounts> pref_counts;
+  for (const auto& tab : tab_counts) {
+    PrefService* prefs = Profile::FromBrowserContext(
+        tab.first->GetBrowserContext())->
+        GetOriginalProfile()->
+        GetPrefs();
+    pref_counts[prefs].Add(tab.second);
+  }
+  for (const auto& counts : pref_counts) {
+    IncrementBlockedCountPrefs(counts.first, counts.second);
+  }
+
+  // The batch has already waited out its window on the IO thread.
+  for (BraveShieldsWebContentsObserver* observer : observers) {
+    observer->DispatchPendingBlockedResources();
+  }
+}
+
 bool BraveShieldsWebContentsObserver::OnMessageReceived(
     const IPC::Message& message, RenderFrameHost* render_frame_host) {
   bool handled = true;
@@ -305,26 +470,32 @@ bool BraveShieldsWebContentsObserver::OnMessageReceived(
 
 void BraveShieldsWebContentsObserver::OnJavaScriptBlockedWithDetail(
     RenderFrameHost* render_frame_host,
-    const base::string16& details) {
+    const std::vector<base::string16>& details) {
   WebContents* web_contents =
       WebContents::FromRenderFrameHost(render_frame_host);
   if (!web_contents) {
     return;
   }
-  DispatchBlockedEventForWebContents(brave_shields::kJavaScript,
-      base::UTF16ToUTF8(details), web_contents);
+  for (const base::string16& subresource : details) {
+    AddPendingBlockedResource(brave_shields::kJavaScript,
+                              base::UTF16ToUTF8(subresource));
+  }
+  ScheduleBlockedResourcesDispatch();
 }
 
 void BraveShieldsWebContentsObserver::OnFingerprintingBlockedWithDetail(
     RenderFrameHost* render_frame_host,
-    const base::string16& details) {
+    const std::vector<base::string16>& details) {
   WebContents* web_contents =
       WebContents::FromRenderFrameHost(render_frame_host);
   if (!web_contents) {
     return;
   }
-  DispatchBlockedEventForWebContents(brave_shields::kFingerprinting,
-      base::UTF16ToUTF8(details), web_contents);
+  for (const base::string16& subresource : details) {
+    AddPendingBlockedResource(brave_shields::kFingerprinting,
+                              base::UTF16ToUTF8(subresource));
+  }
+  ScheduleBlockedResourcesDispatch();
 }
 
 // static
@@ -343,8 +514,11 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument() &&
       navigation_handle->GetReloadType() == content::ReloadType::NONE) {
+    // Whatever the old page blocked is sent before its counts are reset.
+    DispatchPendingBlockedResources();
     allowed_script_origins_.clear();
     blocked_url_paths_.clear();
+    blocked_counts_ = BlockedCounts();
   }
 
   navigation_handle->GetWebContents()->SendToAllFrames(
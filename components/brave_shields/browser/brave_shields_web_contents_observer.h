@@ -6,14 +6,19 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "base/macros.h"
-#include "base/synchronization/lock.h"
+#include "base/scoped_observer.h"
 #include "base/strings/string16.h"
+#include "base/timer/timer.h"
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -21,26 +26,36 @@ namespace content {
 class WebContents;
 }
 
+class HostContentSettingsMap;
 class PrefRegistrySimple;
 
 namespace brave_shields {
 
 class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
-    public content::WebContentsUserData<BraveShieldsWebContentsObserver> {
+    public content::WebContentsUserData<BraveShieldsWebContentsObserver>,
+    public content_settings::Observer {
  public:
+  // Number of blocked or upgraded requests, by block type.
+  struct BlockedCounts {
+    void Add(const std::string& block_type);
+    void Add(const BlockedCounts& other);
+
+    uint64_t ads = 0;
+    uint64_t trackers = 0;
+    uint64_t https_upgrades = 0;
+    uint64_t javascript = 0;
+    uint64_t fingerprinting = 0;
+  };
+
   explicit BraveShieldsWebContentsObserver(content::WebContents*);
   ~BraveShieldsWebContentsObserver() override;
 
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
-  static void DispatchBlockedEventForWebContents(
-      const std::string& block_type,
-      const std::string& subresource,
-      content::WebContents* web_contents);
-  static void DispatchBlockedEvent(
-      std::string block_type,
-      std::string subresource,
-      int render_process_id,
-      int render_frame_id, int frame_tree_node_id);
+  // Reports a batch collected by BlockedEventBatcher: updates the blocked
+  // counter prefs once per profile and notifies the shields extension once
+  // per affected tab.
+  static void DispatchBlockedEvents(std::vector<BlockedEvent> events);
+  // Must be called on the IO thread.
   static GURL GetTabURLFromRenderFrameInfo(int render_process_id,
                                            int render_frame_id,
                                            int render_frame_tree_node_id);
@@ -48,6 +63,8 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
+  // Counts for the current page, each blocked subresource counted once.
+  const BlockedCounts& blocked_counts() const { return blocked_counts_; }
 
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
@@ -80,24 +97,65 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::RenderFrameHost* render_frame_host) override;
   void OnJavaScriptBlockedWithDetail(
       content::RenderFrameHost* render_frame_host,
-      const base::string16& details);
+      const std::vector<base::string16>& details);
   void OnFingerprintingBlockedWithDetail(
       content::RenderFrameHost* render_frame_host,
-      const base::string16& details);
-
-  // TODO(iefremov): Refactor this away or at least put into base::NoDestructor.
-  // Protects global maps below from being concurrently written on the UI thread
-  // and read on the IO thread.
-  static base::Lock frame_data_map_lock_;
-  static std::map<RenderFrameIdKey, GURL> frame_key_to_tab_url_;
-  static std::map<int, GURL> frame_tree_node_id_to_tab_url_;
+      const std::vector<base::string16>& details);
+
+  // Frame changes are observed on the UI thread and posted to the IO thread,
+  // which alone owns the frame to tab URL maps. The per-request lookup
+  // therefore takes no lock, and no map is shared between threads.
+  struct TabURLMaps;
+  static TabURLMaps* GetTabURLMapsOnIOThread();
+  static void SetTabURLOnIOThread(const RenderFrameIdKey& key,
+                                  int frame_tree_node_id,
+                                  const GURL& tab_url);
+  static void RemoveTabURLOnIOThread(const RenderFrameIdKey& key,
+                                     int frame_tree_node_id);
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+
+  struct PendingBlockedResource {
+    std::string block_type;
+    std::string subresource;
+  };
+
+  void UpdateContentSettingsToRendererFrames();
+
+  // Records a blocked subresource for the next onBlocked event. Returns true
+  // if it had not been blocked on the current page yet.
+  bool AddPendingBlockedResource(const std::string& block_type,
+                                 const std::string& subresource);
+  // Sends everything blocked since the last onBlocked event to the shields
+  // extension. Blocked scripts and fingerprinting attempts arrive one IPC at
+  // a time, so they are held for a short window before being sent.
+  void ScheduleBlockedResourcesDispatch();
+  void DispatchPendingBlockedResources();
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(
+      const ContentSettingsPattern& primary_pattern,
+      const ContentSettingsPattern& secondary_pattern,
+      ContentSettingsType content_type,
+      const std::string& resource_identifier) override;
+
+  HostContentSettingsMap* content_settings_map_;  // Not owned
+  // Bumped on every content settings change. Renderer processes are only
+  // sent the rules when they were last sent an older version.
+  uint64_t rules_version_;
+  std::map<int, uint64_t> rules_version_by_process_id_;
+  ScopedObserver<HostContentSettingsMap, content_settings::Observer>
+      content_settings_observer_;
+
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
   std::set<std::string> blocked_url_paths_;
+  BlockedCounts blocked_counts_;
+  std::vector<PendingBlockedResource> pending_blocked_resources_;
+  BlockedCounts pending_blocked_counts_;
+  base::OneShotTimer dispatch_blocked_resources_timer_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
@@ -48,10 +48,11 @@ void ExtensionWhitelistService::OnComponentReady(
       .AppendASCII(EXTENSION_DAT_FILE);
 
   base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
+      local_data_files_service()->GetLoadTaskRunner().get(),
       FROM_HERE,
       base::BindOnce(
-          &brave_component_updater::LoadDATFileData<ExtensionWhitelistParser>,
+          &brave_component_updater::LoadMappedDATFileData<
+              ExtensionWhitelistParser>,
           dat_file_path),
       base::BindOnce(&ExtensionWhitelistService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
@@ -59,7 +60,7 @@ void ExtensionWhitelistService::OnComponentReady(
 
 void ExtensionWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (result.second.empty()) {
+  if (!result.second) {
     LOG(ERROR) << "Could not obtain extension whitelist data";
     return;
   }
@@ -69,7 +70,7 @@ void ExtensionWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
   }
 
   extension_whitelist_client_ = std::move(result.first);
-  buffer_ = std::move(result.second);
+  dat_file_ = std::move(result.second);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -32,7 +32,8 @@ namespace brave_shields {
 class ExtensionWhitelistService : public LocalDataFilesObserver {
  public:
   using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<ExtensionWhitelistParser>;
+      brave_component_updater::LoadMappedDATFileDataResult<
+          ExtensionWhitelistParser>;
 
   explicit ExtensionWhitelistService(
       LocalDataFilesService* local_data_files_service);
@@ -53,7 +54,8 @@ class ExtensionWhitelistService : public LocalDataFilesObserver {
   void OnGetDATFileData(GetDATFileDataResult result);
 
   std::unique_ptr<ExtensionWhitelistParser> extension_whitelist_client_;
-  brave_component_updater::DATFileDataBuffer buffer_;
+  // |extension_whitelist_client_| points into this buffer.
+  std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file_;
   SEQUENCE_CHECKER(sequence_checker_);
   base::WeakPtrFactory<ExtensionWhitelistService> weak_factory_;
 
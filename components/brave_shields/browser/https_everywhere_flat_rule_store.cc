@@ -0,0 +1,174 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_flat_rule_store.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kMagic[] = "HTTPSE01";
+const size_t kMagicLength = sizeof(kMagic) - 1;
+
+void AppendUInt32(std::string* out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+uint32_t ReadUInt32(const uint8_t* data) {
+  return static_cast<uint32_t>(data[0]) |
+      (static_cast<uint32_t>(data[1]) << 8) |
+      (static_cast<uint32_t>(data[2]) << 16) |
+      (static_cast<uint32_t>(data[3]) << 24);
+}
+
+}  // namespace
+
+struct HTTPSEFlatRuleStore::Entry {
+  uint8_t key_offset[4];
+  uint8_t key_length[4];
+  uint8_t value_offset[4];
+  uint8_t value_length[4];
+};
+
+HTTPSEFlatRuleStore::HTTPSEFlatRuleStore()
+    : entries_(nullptr),
+      entry_count_(0),
+      blob_(nullptr),
+      blob_length_(0) {
+}
+
+HTTPSEFlatRuleStore::~HTTPSEFlatRuleStore() {
+}
+
+// static
+std::unique_ptr<HTTPSEFlatRuleStore> HTTPSEFlatRuleStore::Open(
+    const base::FilePath& path) {
+  if (!base::PathExists(path)) {
+    return nullptr;
+  }
+  std::unique_ptr<HTTPSEFlatRuleStore> store(new HTTPSEFlatRuleStore());
+  if (!store->file_.Initialize(path)) {
+    LOG(ERROR) << "Failed to map HTTPSE rule store " << path.value();
+    return nullptr;
+  }
+  if (!store->Initialize(store->file_.data(), store->file_.length())) {
+    LOG(ERROR) << "Corrupted HTTPSE rule store " << path.value();
+    return nullptr;
+  }
+  return store;
+}
+
+// static
+std::string HTTPSEFlatRuleStore::Build(
+    const std::map<std::string, std::string>& rules) {
+  std::string table;
+  std::string blob;
+  // std::map iterates in byte-wise key order, which is what Find expects.
+  for (const auto& rule : rules) {
+    AppendUInt32(&table, static_cast<uint32_t>(blob.size()));
+    AppendUInt32(&table, static_cast<uint32_t>(rule.first.size()));
+    blob.append(rule.first);
+    AppendUInt32(&table, static_cast<uint32_t>(blob.size()));
+    AppendUInt32(&table, static_cast<uint32_t>(rule.second.size()));
+    blob.append(rule.second);
+  }
+
+  std::string out(kMagic, kMagicLength);
+  AppendUInt32(&out, static_cast<uint32_t>(rules.size()));
+  out.append(table);
+  out.append(blob);
+  return out;
+}
+
+// static
+bool HTTPSEFlatRuleStore::WriteFromLevelDB(leveldb::DB* db,
+                                           const base::FilePath& path) {
+  DCHECK(db);
+  std::map<std::string, std::string> rules;
+  std::unique_ptr<leveldb::Iterator> it(
+      db->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    rules.emplace(it->key().ToString(), it->value().ToString());
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Failed to read HTTPSE database: "
+               << it->status().ToString();
+    return false;
+  }
+
+  if (!base::ImportantFileWriter::WriteFileAtomically(path, Build(rules))) {
+    LOG(ERROR) << "Failed to write HTTPSE rule store " << path.value();
+    return false;
+  }
+  return true;
+}
+
+bool HTTPSEFlatRuleStore::Initialize(const uint8_t* data, size_t length) {
+  const size_t header_length = kMagicLength + sizeof(uint32_t);
+  if (length < header_length || memcmp(data, kMagic, kMagicLength) != 0) {
+    return false;
+  }
+  const size_t entry_count = ReadUInt32(data + kMagicLength);
+  if (entry_count > (length - header_length) / sizeof(Entry)) {
+    return false;
+  }
+  const size_t table_length = entry_count * sizeof(Entry);
+
+  entries_ = reinterpret_cast<const Entry*>(data + header_length);
+  entry_count_ = entry_count;
+  blob_ = reinterpret_cast<const char*>(data + header_length + table_length);
+  blob_length_ = length - header_length - table_length;
+
+  // Validate every range once so that lookups don't have to.
+  for (size_t i = 0; i < entry_count_; ++i) {
+    const Entry& entry = entries_[i];
+    const uint64_t key_end = static_cast<uint64_t>(
+        ReadUInt32(entry.key_offset)) + ReadUInt32(entry.key_length);
+    const uint64_t value_end = static_cast<uint64_t>(
+        ReadUInt32(entry.value_offset)) + ReadUInt32(entry.value_length);
+    if (key_end > blob_length_ || value_end > blob_length_) {
+      return false;
+    }
+    if (i > 0 && !(GetKey(entries_[i - 1]) < GetKey(entry))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+base::StringPiece HTTPSEFlatRuleStore::GetKey(const Entry& entry) const {
+  return base::StringPiece(blob_ + ReadUInt32(entry.key_offset),
+                           ReadUInt32(entry.key_length));
+}
+
+bool HTTPSEFlatRuleStore::Find(base::StringPiece key,
+                               base::StringPiece* value) const {
+  const Entry* end = entries_ + entry_count_;
+  const Entry* it = std::lower_bound(entries_, end, key,
+      [this](const Entry& entry, base::StringPiece key) {
+        return GetKey(entry) < key;
+      });
+  if (it == end || GetKey(*it) != key) {
+    return false;
+  }
+  *value = base::StringPiece(blob_ + ReadUInt32(it->value_offset),
+                             ReadUInt32(it->value_length));
+  return true;
+}
+
+}  // namespace brave_shields
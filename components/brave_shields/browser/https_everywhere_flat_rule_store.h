@@ -0,0 +1,80 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_FLAT_RULE_STORE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_FLAT_RULE_STORE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/files/memory_mapped_file.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class FilePath;
+}
+
+namespace leveldb {
+class DB;
+}
+
+namespace brave_shields {
+
+// Read-only, memory-mapped store of HTTPS Everywhere rules keyed by the
+// reversed lookup domains produced for leveldb ("com.example",
+// "com.example.*"). The file layout is
+//
+//   char     magic[8]            "HTTPSE01"
+//   uint32_t entry_count
+//   Entry    entries[entry_count] sorted by key, byte-wise
+//   char     blob[]              keys and JSON rule values
+//
+// where every Entry is four uint32_t: key offset, key length, value offset
+// and value length, with offsets relative to the start of |blob|. All
+// integers are little-endian. Opening the store does no decompression or
+// parsing and a lookup is a binary search over the entry table.
+class HTTPSEFlatRuleStore {
+ public:
+  ~HTTPSEFlatRuleStore();
+
+  // Returns nullptr if |path| is missing or isn't a well-formed store.
+  static std::unique_ptr<HTTPSEFlatRuleStore> Open(const base::FilePath& path);
+
+  // Builds the serialized form of |rules|, used for packaging the component
+  // and in tests.
+  static std::string Build(const std::map<std::string, std::string>& rules);
+
+  // Converts every rule in |db| and writes the store to |path|, replacing it
+  // atomically. Used for components which only ship the leveldb database.
+  static bool WriteFromLevelDB(leveldb::DB* db, const base::FilePath& path);
+
+  // The returned piece points into the mapping and lives as long as |this|.
+  bool Find(base::StringPiece key, base::StringPiece* value) const;
+
+  size_t size() const { return entry_count_; }
+
+ private:
+  struct Entry;
+
+  HTTPSEFlatRuleStore();
+  bool Initialize(const uint8_t* data, size_t length);
+  base::StringPiece GetKey(const Entry& entry) const;
+
+  base::MemoryMappedFile file_;
+  const Entry* entries_;
+  size_t entry_count_;
+  const char* blob_;
+  size_t blob_length_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSEFlatRuleStore);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_FLAT_RULE_STORE_H_
@@ -0,0 +1,103 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "brave/components/brave_shields/browser/https_everywhere_flat_rule_store.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+
+// npm run test -- brave_unit_tests --filter=HTTPSEFlatRuleStoreTest.*
+
+using brave_shields::HTTPSEFlatRuleStore;
+
+namespace {
+
+base::FilePath WriteStore(const base::ScopedTempDir& dir,
+                          const std::string& contents) {
+  base::FilePath path = dir.GetPath().AppendASCII("httpse.flat");
+  EXPECT_EQ(static_cast<int>(contents.size()),
+            base::WriteFile(path, contents.data(), contents.size()));
+  return path;
+}
+
+}  // namespace
+
+TEST(HTTPSEFlatRuleStoreTest, RoundTrip) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+
+  std::map<std::string, std::string> rules = {
+      {"com.example", "[{\"r\":[{\"d\":1}]}]"},
+      {"com.example.*", "[]"},
+      {"org.brave", "[{\"r\":[{\"d\":1}]}]"},
+  };
+  std::unique_ptr<HTTPSEFlatRuleStore> store = HTTPSEFlatRuleStore::Open(
+      WriteStore(dir, HTTPSEFlatRuleStore::Build(rules)));
+  ASSERT_TRUE(store);
+  EXPECT_EQ(store->size(), 3u);
+
+  for (const auto& rule : rules) {
+    base::StringPiece value;
+    ASSERT_TRUE(store->Find(rule.first, &value));
+    EXPECT_EQ(value, rule.second);
+  }
+
+  base::StringPiece value;
+  EXPECT_FALSE(store->Find("com.example.www", &value));
+  EXPECT_FALSE(store->Find("", &value));
+  EXPECT_FALSE(store->Find("zzz", &value));
+}
+
+TEST(HTTPSEFlatRuleStoreTest, RejectsMalformedFiles) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+
+  EXPECT_FALSE(HTTPSEFlatRuleStore::Open(
+      dir.GetPath().AppendASCII("missing.flat")));
+  EXPECT_FALSE(HTTPSEFlatRuleStore::Open(WriteStore(dir, "not a store")));
+
+  std::string truncated = HTTPSEFlatRuleStore::Build({{"com.example", "[]"}});
+  truncated.resize(truncated.size() - 1);
+  EXPECT_FALSE(HTTPSEFlatRuleStore::Open(WriteStore(dir, truncated)));
+}
+
+TEST(HTTPSEFlatRuleStoreTest, WriteFromLevelDB) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+
+  std::map<std::string, std::string> rules = {
+      {"com.example", "[{\"r\":[{\"d\":1}]}]"},
+      {"com.example.*", "[]"},
+      {"org.brave", "[{\"r\":[{\"d\":1}]}]"},
+  };
+
+  leveldb::Options options;
+  options.create_if_missing = true;
+  leveldb::DB* db = nullptr;
+  ASSERT_TRUE(leveldb::DB::Open(options,
+      dir.GetPath().AppendASCII("httpse.leveldb").AsUTF8Unsafe(), &db).ok());
+  std::unique_ptr<leveldb::DB> db_owner(db);
+  for (const auto& rule : rules) {
+    ASSERT_TRUE(db->Put(leveldb::WriteOptions(), rule.first,
+                        rule.second).ok());
+  }
+
+  base::FilePath path = dir.GetPath().AppendASCII("httpse-converted.flat");
+  ASSERT_TRUE(HTTPSEFlatRuleStore::WriteFromLevelDB(db, path));
+
+  std::unique_ptr<HTTPSEFlatRuleStore> store = HTTPSEFlatRuleStore::Open(path);
+  ASSERT_TRUE(store);
+  EXPECT_EQ(store->size(), rules.size());
+  for (const auto& rule : rules) {
+    base::StringPiece value;
+    ASSERT_TRUE(store->Find(rule.first, &value));
+    EXPECT_EQ(value, rule.second);
+  }
+}
@@ -28,3 +28,21 @@ TEST(HTTPSEverywhereRecentlyUsedCacheTest, Operations) {
   cache.remove("kD");
   ASSERT_FALSE(cache.get("kD", &v));
 }
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, Shards) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(16, 4);
+
+  // Empty values are kept, so negative entries can be cached.
+  cache.add("example.com", "");
+  cache.add("www.eff.org", "eff.org");
+  std::string v = "unset";
+  ASSERT_TRUE(cache.get("example.com", &v));
+  ASSERT_TRUE(v.empty());
+  ASSERT_TRUE(cache.get("www.eff.org", &v));
+  ASSERT_STREQ(v.c_str(), "eff.org");
+
+  cache.clear();
+  ASSERT_FALSE(cache.get("example.com", &v));
+  ASSERT_FALSE(cache.get("www.eff.org", &v));
+}
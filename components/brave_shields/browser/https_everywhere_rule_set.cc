@@ -0,0 +1,222 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+#include "third_party/re2/src/re2/set.h"
+
+namespace brave_shields {
+
+namespace {
+
+// RE2 doesn't expose the byte size of a compiled program, only the number
+// of instructions. This is a rough per-instruction cost used for budgeting.
+const size_t kEstimatedBytesPerRE2Instruction = 16;
+
+size_t EstimateRE2MemoryUsage(const re2::RE2& re) {
+  return sizeof(re) + re.pattern().size() +
+      re.ProgramSize() * kEstimatedBytesPerRE2Instruction;
+}
+
+}  // namespace
+
+struct HTTPSERuleSet::Rule {
+  // "d": upgrade the scheme without rewriting the rest of the URL.
+  bool is_default = false;
+  std::unique_ptr<re2::RE2> from;
+  std::string to;
+};
+
+struct HTTPSERuleSet::Target {
+  std::unique_ptr<re2::RE2::Set> exclusions;
+  // A target without an "r" list stops the evaluation of later targets.
+  bool has_rules = false;
+  std::vector<Rule> rules;
+};
+
+HTTPSERuleSet::HTTPSERuleSet() : memory_usage_(sizeof(HTTPSERuleSet)) {
+}
+
+HTTPSERuleSet::~HTTPSERuleSet() {
+}
+
+// static
+std::string HTTPSERuleSet::CorrecttoRuleToRE2Engine(const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+// static
+std::unique_ptr<HTTPSERuleSet> HTTPSERuleSet::Parse(const std::string& json) {
+  base::Optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (base::nullopt == json_object || !json_object->is_list()) {
+    return nullptr;
+  }
+
+  std::unique_ptr<HTTPSERuleSet> rule_set(new HTTPSERuleSet());
+  for (const base::Value& top_value : json_object->GetList()) {
+    if (!top_value.is_dict()) {
+      continue;
+    }
+
+    auto target = std::make_unique<Target>();
+    rule_set->memory_usage_ += sizeof(Target);
+
+    const base::Value* exclusions = top_value.FindKey("e");
+    if (exclusions && exclusions->is_list()) {
+      auto set = std::make_unique<re2::RE2::Set>(re2::RE2::DefaultOptions,
+                                                 re2::RE2::ANCHOR_BOTH);
+      size_t count = 0;
+      for (const base::Value& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict()) {
+          continue;
+        }
+        const base::Value* pattern = exclusion.FindKey("p");
+        if (!pattern || !pattern->is_string()) {
+          continue;
+        }
+        // Invalid patterns never matched with RE2::FullMatch either.
+        const std::string corrected =
+            CorrecttoRuleToRE2Engine(pattern->GetString());
+        if (set->Add(corrected, nullptr) >= 0) {
+          rule_set->memory_usage_ += corrected.size() +
+              corrected.size() * kEstimatedBytesPerRE2Instruction;
+          count++;
+        }
+      }
+      if (count > 0 && set->Compile()) {
+        target->exclusions = std::move(set);
+      }
+    }
+
+    const base::Value* rules = top_value.FindKey("r");
+    if (rules && rules->is_list()) {
+      target->has_rules = true;
+      for (const base::Value& rule_value : rules->GetList()) {
+        if (!rule_value.is_dict()) {
+          continue;
+        }
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.is_default = true;
+          target->rules.push_back(std::move(rule));
+          continue;
+        }
+        const base::Value* from = rule_value.FindKey("f");
+        const base::Value* to = rule_value.FindKey("t");
+        if (!from || !to || !from->is_string() || !to->is_string()) {
+          continue;
+        }
+        rule.from = std::make_unique<re2::RE2>(from->GetString());
+        if (!rule.from->ok()) {
+          continue;
+        }
+        rule.to = CorrecttoRuleToRE2Engine(to->GetString());
+        rule_set->memory_usage_ += sizeof(Rule) + rule.to.size() +
+            EstimateRE2MemoryUsage(*rule.from);
+        target->rules.push_back(std::move(rule));
+      }
+    }
+
+    rule_set->targets_.push_back(std::move(target));
+  }
+
+  return rule_set;
+}
+
+std::string HTTPSERuleSet::Apply(const std::string& original_url) const {
+  for (const auto& target : targets_) {
+    if (target->exclusions) {
+      std::vector<int> matches;
+      if (target->exclusions->Match(original_url, &matches)) {
+        return "";
+      }
+    }
+
+    if (!target->has_rules) {
+      return "";
+    }
+
+    for (const Rule& rule : target->rules) {
+      if (rule.is_default) {
+        std::string new_url(original_url);
+        return new_url.insert(4, "s");
+      }
+
+      std::string new_url(original_url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) &&
+          new_url != original_url) {
+        return new_url;
+      }
+    }
+  }
+  return "";
+}
+
+HTTPSERuleSetCache::HTTPSERuleSetCache(size_t max_entries, size_t max_bytes)
+    : entries_(max_entries),
+      max_bytes_(max_bytes),
+      memory_usage_(0) {
+}
+
+HTTPSERuleSetCache::~HTTPSERuleSetCache() {
+}
+
+const HTTPSERuleSet* HTTPSERuleSetCache::Get(const std::string& key) {
+  auto it = entries_.Get(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  return it->second.get();
+}
+
+void HTTPSERuleSetCache::Put(
+    const std::string& key,
+    std::unique_ptr<HTTPSERuleSet> rule_set) {
+  DCHECK(rule_set);
+  auto existing = entries_.Peek(key);
+  if (existing != entries_.end()) {
+    memory_usage_ -= existing->second->EstimateMemoryUsage();
+    entries_.Erase(existing);
+  }
+
+  // Make room ourselves so that |memory_usage_| stays accurate; the
+  // MRUCache would otherwise silently drop the oldest entry.
+  while (!entries_.empty() && entries_.size() >= entries_.max_size()) {
+    auto oldest = entries_.rbegin();
+    memory_usage_ -= oldest->second->EstimateMemoryUsage();
+    entries_.Erase(oldest);
+  }
+
+  memory_usage_ += rule_set->EstimateMemoryUsage();
+  entries_.Put(key, std::move(rule_set));
+  EvictIfNeeded();
+}
+
+void HTTPSERuleSetCache::Clear() {
+  entries_.Clear();
+  memory_usage_ = 0;
+}
+
+void HTTPSERuleSetCache::EvictIfNeeded() {
+  while (!entries_.empty() && memory_usage_ > max_bytes_) {
+    auto oldest = entries_.rbegin();
+    memory_usage_ -= oldest->second->EstimateMemoryUsage();
+    entries_.Erase(oldest);
+  }
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,84 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// The HTTPS Everywhere rules stored for one lookup domain, parsed from their
+// JSON form and with every regular expression compiled once.
+class HTTPSERuleSet {
+ public:
+  ~HTTPSERuleSet();
+
+  // Returns nullptr if |json| isn't a list of rule objects.
+  static std::unique_ptr<HTTPSERuleSet> Parse(const std::string& json);
+
+  // The HTTPSE rulesets use JavaScript style $1 back references, RE2 wants
+  // \1 instead.
+  static std::string CorrecttoRuleToRE2Engine(const std::string& to);
+
+  // Returns the rewritten URL, or an empty string if no rule applies.
+  std::string Apply(const std::string& original_url) const;
+
+  // Approximate heap size of the compiled rules, in bytes.
+  size_t EstimateMemoryUsage() const { return memory_usage_; }
+
+ private:
+  struct Rule;
+  struct Target;
+
+  HTTPSERuleSet();
+
+  std::vector<std::unique_ptr<Target>> targets_;
+  size_t memory_usage_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleSet);
+};
+
+// Most-recently-used cache of compiled rule sets, bounded both by number of
+// entries and by their estimated memory usage. Not thread safe.
+class HTTPSERuleSetCache {
+ public:
+  HTTPSERuleSetCache(size_t max_entries, size_t max_bytes);
+  ~HTTPSERuleSetCache();
+
+  // Returns nullptr on a miss. The pointer is valid until the next Put or
+  // Clear.
+  const HTTPSERuleSet* Get(const std::string& key);
+  void Put(const std::string& key, std::unique_ptr<HTTPSERuleSet> rule_set);
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+  size_t memory_usage() const { return memory_usage_; }
+
+ private:
+  using Entries =
+      base::MRUCache<std::string, std::unique_ptr<HTTPSERuleSet>>;
+
+  void EvictIfNeeded();
+
+  Entries entries_;
+  const size_t max_bytes_;
+  size_t memory_usage_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleSetCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
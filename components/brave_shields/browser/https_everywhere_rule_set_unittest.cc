@@ -0,0 +1,78 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERuleSet;
+using brave_shields::HTTPSERuleSetCache;
+
+TEST(HTTPSERuleSetTest, InvalidJSON) {
+  EXPECT_FALSE(HTTPSERuleSet::Parse(""));
+  EXPECT_FALSE(HTTPSERuleSet::Parse("{}"));
+  EXPECT_TRUE(HTTPSERuleSet::Parse("[]"));
+}
+
+TEST(HTTPSERuleSetTest, DefaultRule) {
+  auto rule_set = HTTPSERuleSet::Parse(R"([{"r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/a"), "https://example.com/a");
+}
+
+TEST(HTTPSERuleSetTest, FromToRule) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      R"([{"r": [{"f": "^http://(www\\.)?example\\.com/",)"
+      R"( "t": "https://$1example.com/"}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://www.example.com/x"),
+            "https://www.example.com/x");
+  EXPECT_EQ(rule_set->Apply("http://other.test/"), "");
+}
+
+TEST(HTTPSERuleSetTest, Exclusions) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      R"([{"e": [{"p": "^http://example\\.com/plain/.*"}],)"
+      R"( "r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/plain/page"), "");
+  EXPECT_EQ(rule_set->Apply("http://example.com/secure"),
+            "https://example.com/secure");
+}
+
+TEST(HTTPSERuleSetTest, TargetWithoutRulesStops) {
+  auto rule_set = HTTPSERuleSet::Parse(R"([{"e": []}, {"r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/"), "");
+}
+
+TEST(HTTPSERuleSetTest, CacheEviction) {
+  HTTPSERuleSetCache cache(2, 1024 * 1024);
+  cache.Put("a", HTTPSERuleSet::Parse(R"([{"r": [{"d": 1}]}])"));
+  cache.Put("b", HTTPSERuleSet::Parse(R"([{"r": [{"d": 1}]}])"));
+  EXPECT_TRUE(cache.Get("a"));
+  cache.Put("c", HTTPSERuleSet::Parse(R"([{"r": [{"d": 1}]}])"));
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_FALSE(cache.Get("b"));
+  EXPECT_TRUE(cache.Get("a"));
+  EXPECT_TRUE(cache.Get("c"));
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.memory_usage(), 0u);
+}
+
+TEST(HTTPSERuleSetTest, CacheMemoryBudget) {
+  auto rule_set = HTTPSERuleSet::Parse(R"([{"r": [{"d": 1}]}])");
+  ASSERT_TRUE(rule_set);
+  HTTPSERuleSetCache cache(10, rule_set->EstimateMemoryUsage());
+  cache.Put("a", std::move(rule_set));
+  EXPECT_TRUE(cache.Get("a"));
+  cache.Put("b", HTTPSERuleSet::Parse(R"([{"r": [{"d": 1}]}])"));
+  EXPECT_FALSE(cache.Get("a"));
+  EXPECT_TRUE(cache.Get("b"));
+}
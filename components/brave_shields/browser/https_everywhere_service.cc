@@ -8,63 +8,35 @@
 #include <algorithm>
 #include <string>
 #include <utility>
-#include <vector>
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/json/json_reader.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
+#include "brave/components/brave_shields/browser/reversed_host_trie.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
+#define FLAT_DAT_FILE "httpse.flat"
 #define DAT_FILE_VERSION "6.0"
-#define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
-#define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+// Written next to DAT_FILE by this service. Both names carry the version of
+// the layout they were produced with, so a change to either is never read
+// back from an older run.
+#define UNZIPPED_DB_DIR "httpse-" DAT_FILE_VERSION ".leveldb"
+#define CONVERTED_FLAT_DAT_FILE "httpse-converted-1.flat"
+#define HTTPSE_RULE_SET_CACHE_MAX_ENTRIES   500
+#define HTTPSE_RULE_SET_CACHE_MAX_BYTES     (4 * 1024 * 1024)
+#define HTTPSE_URL_CACHE_SIZE               1000
+#define HTTPSE_HOST_CACHE_SIZE              2000
+#define HTTPSE_CACHE_SHARD_COUNT            8
 
 namespace {
 
-std::vector<std::string> Split(const std::string& s, char delim) {
-  std::stringstream ss(s);
-  std::string item;
-  std::vector<std::string> result;
-  while (getline(ss, item, delim)) {
-    result.push_back(item);
-  }
-  return result;
-}
-
-// returns parts in reverse order, makes list of lookup domains like com.foo.*
-std::vector<std::string> ExpandDomainForLookup(const std::string& domain) {
-  std::vector<std::string> resultDomains;
-  std::vector<std::string> domainParts = Split(domain, '.');
-  if (domainParts.empty()) {
-    return resultDomains;
-  }
-
-  for (size_t i = 0; i < domainParts.size() - 1; i++) {
-    // i < size()-1 is correct: don't want 'com.*' added to resultDomains
-    std::string slice = "";
-    std::string dot = "";
-    for (int j = domainParts.size() - 1; j >= static_cast<int>(i); j--) {
-      slice += dot + domainParts[j];
-      dot = ".";
-    }
-    if (0 != i) {
-      // We don't want * on the top URL
-      resultDomains.push_back(slice + ".*");
-    } else {
-      resultDomains.push_back(slice);
-    }
-  }
-  return resultDomains;
-}
 std::string leveldbGet(leveldb::DB* db, const std::string &key) {
   if (!db) {
     return "";
@@ -100,6 +72,10 @@ HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
 HTTPSEverywhereService::HTTPSEverywhereService(
     BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
+      recently_used_cache_(HTTPSE_URL_CACHE_SIZE, HTTPSE_CACHE_SHARD_COUNT),
+      host_cache_(HTTPSE_HOST_CACHE_SIZE, HTTPSE_CACHE_SHARD_COUNT),
+      rule_set_cache_(HTTPSE_RULE_SET_CACHE_MAX_ENTRIES,
+                      HTTPSE_RULE_SET_CACHE_MAX_BYTES),
       level_db_(nullptr) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
@@ -119,36 +95,135 @@ bool HTTPSEverywhereService::Init() {
   Register(kHTTPSEverywhereComponentName,
            g_https_everywhere_component_id_,
            g_https_everywhere_component_base64_public_key_);
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::Bind(&HTTPSEverywhereService::StartObservingMemoryPressure,
+                 AsWeakPtr()));
   return true;
 }
 
+void HTTPSEverywhereService::StartObservingMemoryPressure() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!memory_pressure_listener_) {
+    memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+        base::Bind(&HTTPSEverywhereService::OnMemoryPressure, AsWeakPtr()));
+  }
+}
+
+void HTTPSEverywhereService::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      // Compiled rule sets are the bulk of the footprint and are parsed
+      // again from the store on the next lookup.
+      rule_set_cache_.Clear();
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      // The URL and host caches are rebuilt as pages load again.
+      rule_set_cache_.Clear();
+      recently_used_cache_.clear();
+      host_cache_.clear();
+      break;
+  }
+}
+
 void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  base::FilePath zip_db_file_path =
-      install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
-  base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
-  base::FilePath destination = zip_db_file_path.DirName();
-  if (!zip::Unzip(zip_db_file_path, destination)) {
-    LOG(ERROR) << "Failed to unzip database file "
-               << zip_db_file_path.value().c_str();
+  CloseDatabase();
+
+  base::FilePath dat_file_dir = install_dir.AppendASCII(DAT_FILE_VERSION);
+
+  // Prefer the prebuilt flat store, which is mapped as is.
+  flat_store_ = HTTPSEFlatRuleStore::Open(
+      dat_file_dir.AppendASCII(FLAT_DAT_FILE));
+  if (flat_store_) {
+    return;
+  }
+
+  // Then one converted from the leveldb database by a previous run.
+  base::FilePath converted_store_path =
+      dat_file_dir.AppendASCII(CONVERTED_FLAT_DAT_FILE);
+  flat_store_ = HTTPSEFlatRuleStore::Open(converted_store_path);
+  if (flat_store_) {
+    return;
+  }
+
+  // Component install directories are versioned and never modified in
+  // place, so a database unzipped by a previous run can be reused. It is only
+  // moved to |unzipped_level_db_path| once fully unzipped.
+  base::FilePath unzipped_level_db_path =
+      dat_file_dir.AppendASCII(UNZIPPED_DB_DIR);
+  if (!base::DirectoryExists(unzipped_level_db_path) ||
+      !OpenDatabase(unzipped_level_db_path)) {
+    if (!UnzipDatabase(dat_file_dir.AppendASCII(DAT_FILE),
+                       unzipped_level_db_path) ||
+        !OpenDatabase(unzipped_level_db_path)) {
+      return;
+    }
+  }
+
+  // Convert the database so that later runs map the rules instead of opening
+  // leveldb. The database is kept open for this run if that fails.
+  if (!HTTPSEFlatRuleStore::WriteFromLevelDB(level_db_,
+                                             converted_store_path)) {
     return;
   }
+  std::unique_ptr<HTTPSEFlatRuleStore> converted_store =
+      HTTPSEFlatRuleStore::Open(converted_store_path);
+  if (!converted_store) {
+    return;
+  }
+  CloseDatabase();
+  flat_store_ = std::move(converted_store);
+  base::DeleteFile(unzipped_level_db_path, true);
+}
+
+bool HTTPSEverywhereService::UnzipDatabase(const base::FilePath& zip_path,
+                                           const base::FilePath& db_path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::FilePath temp_dir;
+  if (!base::CreateTemporaryDirInDir(db_path.DirName(),
+                                     FILE_PATH_LITERAL("httpse"),
+                                     &temp_dir)) {
+    LOG(ERROR) << "Failed to create a directory to unzip "
+               << zip_path.value().c_str();
+    return false;
+  }
+
+  // The archive holds a single directory named after it.
+  base::FilePath unzipped_path =
+      temp_dir.Append(zip_path.BaseName().RemoveExtension());
+  bool success = zip::Unzip(zip_path, temp_dir);
+  if (!success) {
+    LOG(ERROR) << "Failed to unzip database file "
+               << zip_path.value().c_str();
+  } else {
+    base::DeleteFile(db_path, true);
+    success = base::Move(unzipped_path, db_path);
+  }
+  base::DeleteFile(temp_dir, true);
+  return success;
+}
 
+bool HTTPSEverywhereService::OpenDatabase(const base::FilePath& path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   CloseDatabase();
 
   leveldb::Options options;
   leveldb::Status status =
-      leveldb::DB::Open(options,
-                        unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
+      leveldb::DB::Open(options, path.AsUTF8Unsafe(), &level_db_);
   if (!status.ok() || !level_db_) {
     level_db_ = nullptr;
     LOG(ERROR) << "Level db open error "
-               << unzipped_level_db_path.value().c_str()
+               << path.value().c_str()
                << ", error: " << status.ToString();
     CloseDatabase();
-    return;
+    return false;
   }
+  return true;
 }
 
 void HTTPSEverywhereService::OnComponentReady(
@@ -164,23 +239,20 @@ void HTTPSEverywhereService::OnComponentReady(
 
 bool HTTPSEverywhereService::GetHTTPSURL(
     const GURL* url,
-    const uint64_t& request_identifier,
     std::string* new_url) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   if (!url->is_valid())
     return false;
 
-  if (!IsInitialized() || !level_db_ || url->scheme() == url::kHttpsScheme) {
-    return false;
-  }
-  if (!ShouldHTTPSERedirect(request_identifier)) {
+  if (!IsInitialized() || (!level_db_ && !flat_store_) ||
+      url->scheme() == url::kHttpsScheme) {
     return false;
   }
 
+  // An empty cached URL means the URL is known not to be upgraded.
   if (recently_used_cache_.get(url->spec(), new_url)) {
-    AddHTTPSEUrlToRedirectList(request_identifier);
-    return true;
+    return !new_url->empty();
   }
 
   GURL candidate_url(*url);
@@ -190,26 +262,51 @@ bool HTTPSEverywhereService::GetHTTPSURL(
     candidate_url = candidate_url.ReplaceComponents(replacements);
   }
 
-  const std::vector<std::string> domains =
-      ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
-      if (0 != new_url->length()) {
-        recently_used_cache_.add(candidate_url.spec(), *new_url);
-        AddHTTPSEUrlToRedirectList(request_identifier);
-        return true;
-      }
+  const std::string spec = candidate_url.spec();
+  const std::string host = candidate_url.host();
+
+  // Hosts are cached with the domain key their rules live under, or with an
+  // empty key when no domain key has any rules for them, so repeated hosts
+  // skip walking the rule store.
+  std::string rule_domain;
+  if (host_cache_.get(host, &rule_domain)) {
+    if (rule_domain.empty()) {
+      recently_used_cache_.add(spec, std::string());
+      new_url->clear();
+      return false;
+    }
+    bool has_rules = false;
+    *new_url = ApplyHTTPSRulesForDomain(spec, rule_domain, &has_rules);
+    if (0 != new_url->length()) {
+      recently_used_cache_.add(spec, *new_url);
+      return true;
+    }
+  }
+
+  bool host_has_rules = false;
+  ReversedHostLookupKeys domains(candidate_url.host_piece());
+  base::StringPiece domain;
+  while (domains.Next(&domain)) {
+    bool has_rules = false;
+    *new_url = ApplyHTTPSRulesForDomain(spec, domain.as_string(), &has_rules);
+    if (has_rules && !host_has_rules) {
+      host_has_rules = true;
+      host_cache_.add(host, domain.as_string());
+    }
+    if (0 != new_url->length()) {
+      host_cache_.add(host, domain.as_string());
+      recently_used_cache_.add(spec, *new_url);
+      return true;
     }
   }
-  recently_used_cache_.remove(candidate_url.spec());
+  if (!host_has_rules)
+    host_cache_.add(host, std::string());
+  recently_used_cache_.add(spec, std::string());
   return false;
 }
 
 bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
     const GURL* url,
-    const uint64_t& request_identifier,
     std::string* cached_url) {
   if (!url->is_valid())
     return false;
@@ -217,173 +314,77 @@ bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
   if (!IsInitialized() || url->scheme() == url::kHttpsScheme) {
     return false;
   }
-  if (!ShouldHTTPSERedirect(request_identifier)) {
-    return false;
-  }
 
+  // A hit with an empty |cached_url| means there is nothing to upgrade.
   if (recently_used_cache_.get(url->spec(), cached_url)) {
-    AddHTTPSEUrlToRedirectList(request_identifier);
     return true;
   }
-  return false;
-}
-
-bool HTTPSEverywhereService::ShouldHTTPSERedirect(
-    const uint64_t& request_identifier) {
-  base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_ &&
-        httpse_urls_redirects_count_[i].redirects_ >=
-        HTTPSE_URL_MAX_REDIRECTS_COUNT - 1) {
-      return false;
-    }
-  }
-
-  return true;
-}
 
-void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
-    const uint64_t& request_identifier) {
-  // Adding redirects count for the current request
-  base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  bool hostFound = false;
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_) {
-      // Found the host, just increment the redirects_count
-      httpse_urls_redirects_count_[i].redirects_++;
-      hostFound = true;
-      break;
-    }
-  }
-  if (!hostFound) {
-      // The host is new, adding it to the redirects list
-      if (httpse_urls_redirects_count_.size() >=
-          HTTPSE_URLS_REDIRECTS_COUNT_QUEUE) {
-          // The queue is full, erase the first element
-          httpse_urls_redirects_count_.erase(
-              httpse_urls_redirects_count_.begin());
-      }
-      httpse_urls_redirects_count_.push_back(
-          HTTPSE_REDIRECTS_COUNT_ST(request_identifier, 1));
+  // Third party hosts without any rules are answered here, without going
+  // through the task runner.
+  std::string rule_domain;
+  if (host_cache_.get(url->host(), &rule_domain) && rule_domain.empty()) {
+    cached_url->clear();
+    return true;
   }
+  return false;
 }
 
 std::string HTTPSEverywhereService::ApplyHTTPSRule(
     const std::string& originalUrl,
     const std::string& rule) {
-  base::Optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (base::nullopt == json_object || !json_object->is_list()) {
+  std::unique_ptr<HTTPSERuleSet> rule_set = HTTPSERuleSet::Parse(rule);
+  if (!rule_set) {
     return "";
   }
+  return rule_set->Apply(originalUrl);
+}
 
-  const base::Value::ListStorage& topValues = json_object->GetList();
-  for (auto it = topValues.cbegin(); it != topValues.cend(); ++it) {
-    if (!it->is_dict()) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    it->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
+std::string HTTPSEverywhereService::ApplyHTTPSRulesForDomain(
+    const std::string& originalUrl,
+    const std::string& domain,
+    bool* has_rules) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  *has_rules = false;
+  const HTTPSERuleSet* cached_rule_set = rule_set_cache_.Get(domain);
+  if (cached_rule_set) {
+    *has_rules = true;
+    return cached_rule_set->Apply(originalUrl);
+  }
 
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
+  std::string value;
+  if (flat_store_) {
+    base::StringPiece flat_value;
+    if (flat_store_->Find(domain, &flat_value)) {
+      flat_value.CopyToString(&value);
     }
+  } else {
+    value = leveldbGet(level_db_, domain);
   }
-  return "";
+  if (value.empty()) {
+    return "";
+  }
+  std::unique_ptr<HTTPSERuleSet> rule_set = HTTPSERuleSet::Parse(value);
+  if (!rule_set) {
+    return "";
+  }
+  *has_rules = true;
+  std::string new_url = rule_set->Apply(originalUrl);
+  rule_set_cache_.Put(domain, std::move(rule_set));
+  return new_url;
 }
 
 std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
     const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
+  return HTTPSERuleSet::CorrecttoRuleToRE2Engine(to);
 }
 
 void HTTPSEverywhereService::CloseDatabase() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  rule_set_cache_.Clear();
+  recently_used_cache_.clear();
+  host_cache_.clear();
+  flat_store_.reset();
   if (level_db_) {
     delete level_db_;
     level_db_ = nullptr;
@@ -8,20 +8,22 @@
 
 #include <memory>
 #include <string>
-#include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
-#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
+#include "brave/components/brave_shields/browser/https_everywhere_flat_rule_store.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
 
 namespace leveldb {
 class DB;
 }
 
 class HTTPSEverywhereServiceTest;
+class ShieldsPerfTest;
 
 using brave_component_updater::BraveComponent;
 
@@ -31,29 +33,14 @@ extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
 
-struct HTTPSE_REDIRECTS_COUNT_ST {
- public:
-  HTTPSE_REDIRECTS_COUNT_ST(uint64_t request_identifier,
-                            unsigned int redirects):
-    request_identifier_(request_identifier),
-    redirects_(redirects) {
-  }
-
-  uint64_t request_identifier_;
-  unsigned int redirects_;
-};
-
 class HTTPSEverywhereService : public BaseBraveShieldsService,
                          public base::SupportsWeakPtr<HTTPSEverywhereService> {
  public:
   explicit HTTPSEverywhereService(BraveComponent::Delegate* delegate);
   ~HTTPSEverywhereService() override;
-  bool GetHTTPSURL(const GURL* url,
-                   const uint64_t& request_id,
-                   std::string* new_url);
-  bool GetHTTPSURLFromCacheOnly(const GURL* url,
-                                const uint64_t& request_id,
-                                std::string* cached_url);
+  // Callers track how often a request was upgraded to break redirect loops.
+  bool GetHTTPSURL(const GURL* url, std::string* new_url);
+  bool GetHTTPSURLFromCacheOnly(const GURL* url, std::string* cached_url);
 
  protected:
   bool Init() override;
@@ -62,14 +49,19 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
       const base::FilePath& install_dir,
       const std::string& manifest) override;
 
-  void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
-  bool ShouldHTTPSERedirect(const uint64_t& request_id);
   std::string ApplyHTTPSRule(const std::string& originalUrl,
       const std::string& rule);
+  // Applies the rules stored under |domain|, compiling them only on the
+  // first lookup. |has_rules| is set when |domain| has any rules, whether or
+  // not they upgrade |originalUrl|.
+  std::string ApplyHTTPSRulesForDomain(const std::string& originalUrl,
+      const std::string& domain,
+      bool* has_rules);
   std::string CorrecttoRuleToRE2Engine(const std::string& to);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
+  friend class ::ShieldsPerfTest;
   static bool g_ignore_port_for_test_;
   static std::string g_https_everywhere_component_id_;
   static std::string g_https_everywhere_component_base64_public_key_;
@@ -81,10 +73,24 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   void CloseDatabase();
 
   void InitDB(const base::FilePath& install_dir);
+  bool UnzipDatabase(const base::FilePath& zip_path,
+                     const base::FilePath& db_path);
+  bool OpenDatabase(const base::FilePath& path);
+
+  void StartObservingMemoryPressure();
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
-  base::Lock httpse_get_urls_redirects_count_mutex_;
-  std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
+  // Both are read from the IO thread. Empty values are negative entries.
+  // Keyed by URL, holding the upgraded URL.
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  // Keyed by host, holding the domain key its rules are stored under.
+  HTTPSERecentlyUsedCache<std::string> host_cache_;
+  HTTPSERuleSetCache rule_set_cache_;
+  // Created on the task runner, where the caches are rebuilt.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+  // When the component ships a flat store it is used instead of leveldb.
+  std::unique_ptr<HTTPSEFlatRuleStore> flat_store_;
   leveldb::DB* level_db_;
 
   SEQUENCE_CHECKER(sequence_checker_);
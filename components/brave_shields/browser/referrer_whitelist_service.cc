@@ -16,10 +16,13 @@
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
 using brave_component_updater::LocalDataFilesObserver;
 using brave_component_updater::LocalDataFilesService;
 using content::BrowserThread;
+using net::registry_controlled_domains::GetDomainAndRegistry;
+using net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES;
 
 namespace brave_shields {
 
@@ -33,71 +36,122 @@ ReferrerWhitelistService::ReferrerWhitelistService(
 ReferrerWhitelistService::~ReferrerWhitelistService() {
 }
 
-ReferrerWhitelistService::ReferrerWhitelist::ReferrerWhitelist() = default;
-ReferrerWhitelistService::ReferrerWhitelist::ReferrerWhitelist(
-  const ReferrerWhitelist& other) = default;
-ReferrerWhitelistService::ReferrerWhitelist::~ReferrerWhitelist() = default;
+ReferrerWhitelistService::ReferrerWhitelistTable::ReferrerWhitelist::
+    ReferrerWhitelist() = default;
+ReferrerWhitelistService::ReferrerWhitelistTable::ReferrerWhitelist::
+    ~ReferrerWhitelist() = default;
 
-bool ReferrerWhitelistService::IsWhitelisted(
+ReferrerWhitelistService::ReferrerWhitelistTable::ReferrerWhitelistTable()
+    : size_(0) {
+}
+
+ReferrerWhitelistService::ReferrerWhitelistTable::~ReferrerWhitelistTable() {
+}
+
+void ReferrerWhitelistService::ReferrerWhitelistTable::Add(
+    const URLPattern& first_party_pattern,
+    const std::vector<URLPattern>& subresource_patterns) {
+  auto rw = std::make_unique<ReferrerWhitelist>();
+  rw->first_party_pattern = first_party_pattern;
+  for (const URLPattern& subresource_pattern : subresource_patterns) {
+    rw->subresource_patterns.Add(subresource_pattern);
+  }
+  size_++;
+
+  const std::string& host = first_party_pattern.host();
+  std::string domain = GetDomainAndRegistry(host, INCLUDE_PRIVATE_REGISTRIES);
+  if (first_party_pattern.match_all_urls() || host.empty() ||
+      (domain.empty() && first_party_pattern.match_subdomains())) {
+    any_first_party_.push_back(std::move(rw));
+    return;
+  }
+  // Hosts without a registrable domain (IPs, localhost) are their own key.
+  by_first_party_domain_[domain.empty() ? host : domain].push_back(
+      std::move(rw));
+}
+
+bool ReferrerWhitelistService::ReferrerWhitelistTable::IsWhitelisted(
     const GURL& first_party_origin, const GURL& subresource_url) const {
-  if (BrowserThread::CurrentlyOn(BrowserThread::IO)) {
-    return IsWhitelisted(
-        referrer_whitelist_io_thread_, first_party_origin, subresource_url);
-  } else {
-    return IsWhitelisted(
-        referrer_whitelist_, first_party_origin, subresource_url);
+  std::string domain =
+      GetDomainAndRegistry(first_party_origin, INCLUDE_PRIVATE_REGISTRIES);
+  auto bucket = by_first_party_domain_.find(
+      domain.empty() ? first_party_origin.host_piece() : domain);
+  if (bucket != by_first_party_domain_.end() &&
+      IsWhitelisted(bucket->second, first_party_origin, subresource_url)) {
+    return true;
   }
+  return IsWhitelisted(any_first_party_, first_party_origin, subresource_url);
 }
 
-bool ReferrerWhitelistService::IsWhitelisted(
-    const std::vector<ReferrerWhitelist>& whitelist,
+// static
+bool ReferrerWhitelistService::ReferrerWhitelistTable::IsWhitelisted(
+    const Bucket& bucket,
     const GURL& first_party_origin,
-    const GURL& subresource_url) const {
-  for (auto rw : whitelist) {
-    if (rw.first_party_pattern.MatchesURL(first_party_origin)) {
-      for (auto subresource_pattern : rw.subresource_pattern_list) {
-        if (subresource_pattern.MatchesURL(subresource_url)) {
-          return true;
-        }
-      }
+    const GURL& subresource_url) {
+  for (const auto& rw : bucket) {
+    if (rw->first_party_pattern.MatchesURL(first_party_origin) &&
+        rw->subresource_patterns.Match(subresource_url) !=
+            brave::URLPatternHostIndex::kNoMatch) {
+      return true;
     }
   }
   return false;
 }
 
-void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  referrer_whitelist_.clear();
+bool ReferrerWhitelistService::IsWhitelisted(
+    const GURL& first_party_origin, const GURL& subresource_url) const {
+  const scoped_refptr<const ReferrerWhitelistTable>& whitelist =
+      BrowserThread::CurrentlyOn(BrowserThread::IO) ?
+          referrer_whitelist_io_thread_ : referrer_whitelist_;
+  return whitelist &&
+         whitelist->IsWhitelisted(first_party_origin, subresource_url);
+}
+
+// static
+scoped_refptr<const ReferrerWhitelistService::ReferrerWhitelistTable>
+ReferrerWhitelistService::LoadReferrerWhitelist(
+    const base::FilePath& dat_file_path) {
+  std::string contents =
+      brave_component_updater::GetDATFileAsString(dat_file_path);
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain referrer whitelist data";
-    return;
+    return nullptr;
   }
   base::Optional<base::Value> root = base::JSONReader::Read(contents);
   contents.clear();
   if (!root) {
     LOG(ERROR) << "Failed to parse referrer whitelist data";
-    return;
+    return nullptr;
   }
   base::DictionaryValue* root_dict = nullptr;
   root->GetAsDictionary(&root_dict);
   base::ListValue* whitelist = nullptr;
   root_dict->GetList("whitelist", &whitelist);
+  scoped_refptr<ReferrerWhitelistTable> table = new ReferrerWhitelistTable();
   for (base::Value& origins : whitelist->GetList()) {
     base::DictionaryValue* origins_dict = nullptr;
     origins.GetAsDictionary(&origins_dict);
     for (const auto& it : origins_dict->DictItems()) {
-      ReferrerWhitelist rw;
-      rw.first_party_pattern = URLPattern(
-        URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS, it.first);
-      URLPatternList subresource_pattern_list;
+      std::vector<URLPattern> subresource_patterns;
       for (base::Value& subresource_value : it.second.GetList()) {
-        rw.subresource_pattern_list.push_back(URLPattern(
+        subresource_patterns.push_back(URLPattern(
           URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS,
           subresource_value.GetString()));
       }
-      referrer_whitelist_.push_back(rw);
+      table->Add(URLPattern(
+          URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS, it.first),
+          subresource_patterns);
     }
   }
+  return table;
+}
+
+void ReferrerWhitelistService::OnDATFileDataReady(
+    scoped_refptr<const ReferrerWhitelistTable> whitelist) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  referrer_whitelist_ = std::move(whitelist);
+  if (!referrer_whitelist_)
+    return;
 
   base::PostTaskWithTraits(
       FROM_HERE, {BrowserThread::IO},
@@ -107,7 +161,7 @@ void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
 }
 
 void ReferrerWhitelistService::OnDATFileDataReadyOnIOThread(
-    std::vector<ReferrerWhitelist> whitelist) {
+    scoped_refptr<const ReferrerWhitelistTable> whitelist) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   referrer_whitelist_io_thread_ = std::move(whitelist);
 }
@@ -121,9 +175,9 @@ void ReferrerWhitelistService::OnComponentReady(
       .AppendASCII(REFERRER_DAT_FILE);
 
   base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
+      local_data_files_service()->GetLoadTaskRunner().get(),
       FROM_HERE,
-      base::BindOnce(&brave_component_updater::GetDATFileAsString,
+      base::BindOnce(&ReferrerWhitelistService::LoadReferrerWhitelist,
                      dat_file_path),
       base::BindOnce(&ReferrerWhitelistService::OnDATFileDataReady,
                      weak_factory_.GetWeakPtr()));
@@ -6,13 +6,17 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REFERRER_WHITELIST_SERVICE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REFERRER_WHITELIST_SERVICE_H_
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "brave/common/url_pattern_host_index.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
@@ -45,24 +49,60 @@ class ReferrerWhitelistService : public LocalDataFilesObserver {
  private:
   friend class ::ReferrerWhitelistServiceTest;
 
-  struct ReferrerWhitelist {
-    URLPattern first_party_pattern;
-    URLPatternList subresource_pattern_list;
-    ReferrerWhitelist();
-    ReferrerWhitelist(const ReferrerWhitelist& other);
-    ~ReferrerWhitelist();
+  // The whitelist entries bucketed by the eTLD+1 of their first party
+  // pattern, so a lookup only evaluates the entries that can match the
+  // first party. Immutable once built, which lets the UI and the IO thread
+  // share one instance.
+  class ReferrerWhitelistTable
+      : public base::RefCountedThreadSafe<ReferrerWhitelistTable> {
+   public:
+    ReferrerWhitelistTable();
+
+    void Add(const URLPattern& first_party_pattern,
+             const std::vector<URLPattern>& subresource_patterns);
+    bool IsWhitelisted(const GURL& first_party_origin,
+                       const GURL& subresource_url) const;
+    size_t size() const { return size_; }
+
+   private:
+    friend class base::RefCountedThreadSafe<ReferrerWhitelistTable>;
+
+    struct ReferrerWhitelist {
+      ReferrerWhitelist();
+      ~ReferrerWhitelist();
+
+      URLPattern first_party_pattern;
+      brave::URLPatternHostIndex subresource_patterns;
+    };
+    using Bucket = std::vector<std::unique_ptr<ReferrerWhitelist>>;
+
+    ~ReferrerWhitelistTable();
+
+    static bool IsWhitelisted(const Bucket& bucket,
+                              const GURL& first_party_origin,
+                              const GURL& subresource_url);
+
+    std::map<std::string, Bucket, std::less<>> by_first_party_domain_;
+    // Entries whose first party pattern spans domains, e.g. <all_urls>.
+    Bucket any_first_party_;
+    size_t size_;
+
+    DISALLOW_COPY_AND_ASSIGN(ReferrerWhitelistTable);
   };
 
-  bool IsWhitelisted(const std::vector<ReferrerWhitelist>& whitelist,
-                     const GURL& first_party_origin,
-                     const GURL& subresource_url) const;
-  void OnDATFileDataReady(std::string contents);
-  void OnDATFileDataReadyOnIOThread(std::vector<ReferrerWhitelist> whitelist);
+  // Reads and parses the whitelist at |dat_file_path|. Runs on the load task
+  // runner, so no JSON parsing or URLPattern construction happens on the UI
+  // thread. Returns null if the file can't be read or parsed.
+  static scoped_refptr<const ReferrerWhitelistTable> LoadReferrerWhitelist(
+      const base::FilePath& dat_file_path);
 
-  typedef std::vector<URLPattern> URLPatternList;
+  void OnDATFileDataReady(
+      scoped_refptr<const ReferrerWhitelistTable> whitelist);
+  void OnDATFileDataReadyOnIOThread(
+      scoped_refptr<const ReferrerWhitelistTable> whitelist);
 
-  std::vector<ReferrerWhitelist> referrer_whitelist_;
-  std::vector<ReferrerWhitelist> referrer_whitelist_io_thread_;
+  scoped_refptr<const ReferrerWhitelistTable> referrer_whitelist_;
+  scoped_refptr<const ReferrerWhitelistTable> referrer_whitelist_io_thread_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   base::WeakPtrFactory<ReferrerWhitelistService> weak_factory_;
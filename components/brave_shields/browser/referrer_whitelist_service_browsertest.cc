@@ -14,6 +14,7 @@
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/test/test_utils.h"
 
 using content::BrowserThread;
 using extensions::ExtensionBrowserTest;
@@ -76,6 +77,8 @@ class ReferrerWhitelistServiceTest : public ExtensionBrowserTest {
   }
 
   void WaitForReferrerWhitelistServiceThread() {
+    // Local data files load in the thread pool, replying to this thread.
+    content::RunAllTasksUntilIdle();
     scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
     ASSERT_TRUE(tr_helper->Run());
@@ -93,13 +96,15 @@ class ReferrerWhitelistServiceTest : public ExtensionBrowserTest {
   }
 
   int GetWhitelistSize() {
-    return g_brave_browser_process->referrer_whitelist_service()->
-      referrer_whitelist_.size();
+    const auto& whitelist =
+        g_brave_browser_process->referrer_whitelist_service()->
+          referrer_whitelist_;
+    return whitelist ? whitelist->size() : 0;
   }
 
   void ClearWhitelist() {
     g_brave_browser_process->referrer_whitelist_service()->
-      referrer_whitelist_.clear();
+      referrer_whitelist_ = nullptr;
   }
 };
 
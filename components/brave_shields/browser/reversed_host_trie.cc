@@ -0,0 +1,139 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/reversed_host_trie.h"
+
+#include <utility>
+
+namespace brave_shields {
+
+namespace {
+
+// Calls |callback| with each label of |host| from the last to the first,
+// stopping early if it returns false. Empty labels are preserved.
+template <typename Callback>
+void ForEachLabelReversed(base::StringPiece host, Callback callback) {
+  size_t end = host.size();
+  while (true) {
+    size_t dot = end == 0 ? base::StringPiece::npos : host.rfind('.', end - 1);
+    size_t start = dot == base::StringPiece::npos ? 0 : dot + 1;
+    if (!callback(host.substr(start, end - start)))
+      return;
+    if (dot == base::StringPiece::npos)
+      return;
+    end = dot;
+  }
+}
+
+base::StringPiece TrimRootLabel(base::StringPiece host) {
+  // A single trailing dot denotes the root and isn't a label of its own.
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  return host;
+}
+
+}  // namespace
+
+ReversedHostLookupKeys::ReversedHostLookupKeys(base::StringPiece host)
+    : label_count_(0),
+      next_label_count_(0),
+      next_boundary_(0) {
+  host = TrimRootLabel(host);
+
+  // Room for the trailing "*" written after the last separator.
+  buffer_.reserve(host.size() + 2);
+  ForEachLabelReversed(host, [this](base::StringPiece label) {
+    if (label_count_ > 0)
+      buffer_.push_back('.');
+    label.AppendToString(&buffer_);
+    label_count_++;
+    return true;
+  });
+}
+
+ReversedHostLookupKeys::~ReversedHostLookupKeys() {
+}
+
+bool ReversedHostLookupKeys::Next(base::StringPiece* key) {
+  // Single label hosts have no lookup keys at all.
+  if (label_count_ < 2)
+    return false;
+
+  if (next_label_count_ == 0) {
+    next_label_count_ = label_count_ - 1;
+    next_boundary_ = buffer_.rfind('.');
+    *key = buffer_;
+    return true;
+  }
+
+  if (next_label_count_ < 2)
+    return false;
+
+  // Turn "com.foo.www" into "com.foo.*" in place. Everything after the
+  // boundary has already been returned as part of a longer key.
+  const size_t length = next_boundary_ + 2;
+  if (buffer_.size() < length)
+    buffer_.resize(length);
+  buffer_[next_boundary_ + 1] = '*';
+  *key = base::StringPiece(buffer_.data(), length);
+
+  next_label_count_--;
+  if (next_boundary_ > 0)
+    next_boundary_ = buffer_.rfind('.', next_boundary_ - 1);
+  return true;
+}
+
+ReversedHostTrie::Node::Node() {
+}
+
+ReversedHostTrie::Node::~Node() {
+}
+
+ReversedHostTrie::ReversedHostTrie() {
+}
+
+ReversedHostTrie::~ReversedHostTrie() {
+}
+
+void ReversedHostTrie::Insert(base::StringPiece host) {
+  Node* node = &root_;
+  ForEachLabelReversed(TrimRootLabel(host), [&node](base::StringPiece label) {
+    auto it = node->children.find(label);
+    if (it == node->children.end()) {
+      it = node->children.emplace(label.as_string(),
+                                  std::make_unique<Node>()).first;
+    }
+    node = it->second.get();
+    return true;
+  });
+  node->terminal = true;
+}
+
+bool ReversedHostTrie::ContainsHostOrParent(base::StringPiece host) const {
+  const Node* node = &root_;
+  bool found = false;
+  auto visit_label = [&node, &found](base::StringPiece label) {
+    auto it = node->children.find(label);
+    if (it == node->children.end()) {
+      node = nullptr;
+      return false;
+    }
+    node = it->second.get();
+    if (node->terminal) {
+      found = true;
+      return false;
+    }
+    return true;
+  };
+  ForEachLabelReversed(TrimRootLabel(host), visit_label);
+  return found;
+}
+
+void ReversedHostTrie::Clear() {
+  root_.children.clear();
+  root_.terminal = false;
+}
+
+}  // namespace brave_shields
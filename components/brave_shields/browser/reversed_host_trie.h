@@ -0,0 +1,74 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REVERSED_HOST_TRIE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REVERSED_HOST_TRIE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// Produces the reversed-label lookup keys used by the HTTPS Everywhere
+// rulesets, most specific first. For "www.foo.com" these are "com.foo.www"
+// and "com.foo.*"; the bare TLD wildcard "com.*" is never produced.
+//
+// All keys are written into one buffer sized for the host, so iterating
+// does a single allocation regardless of the number of labels. Each key
+// is only valid until the next call to Next().
+class ReversedHostLookupKeys {
+ public:
+  explicit ReversedHostLookupKeys(base::StringPiece host);
+  ~ReversedHostLookupKeys();
+
+  bool Next(base::StringPiece* key);
+
+ private:
+  std::string buffer_;
+  size_t label_count_;
+  // Number of labels in the next wildcard key, 0 before the exact key has
+  // been returned.
+  size_t next_label_count_;
+  // Offset of the '.' that ends the next wildcard key's last label.
+  size_t next_boundary_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReversedHostLookupKeys);
+};
+
+// A set of hosts stored label by label from the TLD down, answering
+// whether a host is one of them or a subdomain of one of them without
+// building any intermediate strings.
+class ReversedHostTrie {
+ public:
+  ReversedHostTrie();
+  ~ReversedHostTrie();
+
+  void Insert(base::StringPiece host);
+  // True if |host| or one of its parent domains was inserted.
+  bool ContainsHostOrParent(base::StringPiece host) const;
+  bool empty() const { return root_.children.empty() && !root_.terminal; }
+  void Clear();
+
+ private:
+  struct Node {
+    Node();
+    ~Node();
+    bool terminal = false;
+    base::flat_map<std::string, std::unique_ptr<Node>, std::less<>> children;
+  };
+
+  Node root_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReversedHostTrie);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_REVERSED_HOST_TRIE_H_
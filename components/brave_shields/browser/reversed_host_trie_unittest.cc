@@ -0,0 +1,59 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_shields/browser/reversed_host_trie.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::ReversedHostLookupKeys;
+using brave_shields::ReversedHostTrie;
+
+namespace {
+
+std::vector<std::string> GetLookupKeys(const std::string& host) {
+  std::vector<std::string> keys;
+  ReversedHostLookupKeys lookup_keys(host);
+  base::StringPiece key;
+  while (lookup_keys.Next(&key))
+    keys.push_back(key.as_string());
+  return keys;
+}
+
+}  // namespace
+
+TEST(ReversedHostTrieTest, LookupKeys) {
+  EXPECT_EQ(GetLookupKeys("www.foo.com"),
+            std::vector<std::string>({"com.foo.www", "com.foo.*"}));
+  EXPECT_EQ(GetLookupKeys("a.b.foo.co.uk"),
+            std::vector<std::string>({"uk.co.foo.b.a", "uk.co.foo.b.*",
+                                      "uk.co.foo.*", "uk.co.*"}));
+  EXPECT_EQ(GetLookupKeys("foo.com"), std::vector<std::string>({"com.foo"}));
+  EXPECT_EQ(GetLookupKeys("foo.com."), std::vector<std::string>({"com.foo"}));
+  EXPECT_TRUE(GetLookupKeys("localhost").empty());
+  EXPECT_TRUE(GetLookupKeys("").empty());
+}
+
+TEST(ReversedHostTrieTest, ContainsHostOrParent) {
+  ReversedHostTrie trie;
+  EXPECT_TRUE(trie.empty());
+  trie.Insert("example.com");
+  trie.Insert("cdn.test.org");
+  EXPECT_FALSE(trie.empty());
+
+  EXPECT_TRUE(trie.ContainsHostOrParent("example.com"));
+  EXPECT_TRUE(trie.ContainsHostOrParent("www.example.com"));
+  EXPECT_TRUE(trie.ContainsHostOrParent("a.b.example.com."));
+  EXPECT_TRUE(trie.ContainsHostOrParent("x.cdn.test.org"));
+  EXPECT_FALSE(trie.ContainsHostOrParent("test.org"));
+  EXPECT_FALSE(trie.ContainsHostOrParent("notexample.com"));
+  EXPECT_FALSE(trie.ContainsHostOrParent("example.com.evil.net"));
+  EXPECT_FALSE(trie.ContainsHostOrParent("com"));
+
+  trie.Clear();
+  EXPECT_TRUE(trie.empty());
+  EXPECT_FALSE(trie.ContainsHostOrParent("example.com"));
+}
@@ -0,0 +1,595 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "base/process/process_metrics.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
+#include "base/test/thread_test_helper.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+#include "brave/browser/brave_browser_process_impl.h"
+#include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
+#include "brave/browser/net/url_context.h"
+#include "brave/common/brave_paths.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_component_updater/browser/local_data_files_service.h"
+#include "brave/components/brave_shields/browser/ad_block_regional_service.h"
+#include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
+#include "brave/components/brave_shields/browser/tracking_protection_service.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "build/build_config.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/extensions/extension_browsertest.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "components/network_session_configurator/common/network_switches.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/test/browser_test_utils.h"
+#include "content/public/test/test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "net/test/embedded_test_server/request_handler_util.h"
+#include "testing/perf/perf_test.h"
+
+#if defined(OS_POSIX)
+#include <sys/resource.h>
+#endif
+
+using content::BrowserThread;
+using extensions::ExtensionBrowserTest;
+
+namespace {
+
+// Each stage replays the corpus once cold, then this many times warm.
+const int kWarmIterations = 20;
+
+// Each page is loaded once to warm up, then this many times per shields state.
+const int kPageLoadIterations = 5;
+
+const char kRequestCorpusFile[] = "request_corpus.tsv";
+
+// Pages under test/data/shields-perf/pages, loaded from these hosts.
+struct RecordedPage {
+  const char* name;
+  const char* host;
+};
+
+const RecordedPage kRecordedPages[] = {
+  { "news", "www.nytimes.com" },
+  { "regional", "www.lemonde.fr" },
+};
+
+// Pages set this title once their load event and beacons have settled.
+const char kPageDoneTitle[] = "done";
+
+// Decisions the shields report back to the profile, per page load.
+const char* const kShieldsDecisionPrefs[] = {
+  kAdsBlocked,
+  kTrackersBlocked,
+  kJavascriptBlocked,
+  kHttpsUpgrades,
+};
+
+const char kEasyListFranceUUID[] = "9852EFC4-99E4-4F2D-A915-9C3196C7A1DE";
+
+const char kDefaultAdBlockComponentTestId[] =
+    "naccapggpomhlhoifnlebfoocegenbol";
+const char kRegionalAdBlockComponentTestId[] =
+    "dlpmaigjliompnelofkljgcmlenklieh";
+const char kTrackingProtectionComponentTestId[] =
+    "eclbkhjphkhalklhipiicaldjbnhdfkc";
+const char kHTTPSEverywhereComponentTestId[] =
+    "bhlmpjhncoojbkemjkeppfahkglffilp";
+
+const char kDefaultAdBlockComponentTestBase64PublicKey[] =
+    "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAtV7Vr69kkvSvu2lhcMDh"
+    "j4Jm3FKU1zpUkALaum5719/cccVvGpMKKFyy4WYXsmAfcIONmGO4ThK/q6jkgC5v"
+    "8HrkjPOf7HHebKEnsJJucz/Z1t6dq0CE+UA2IWfbGfFM4nJ8AKIv2gqiw2d4ydAs"
+    "QcL26uR9IHHrBk/zzkv2jO43Aw2kY3loqRf60THz4pfz5vOtI+BKOw1KHM0+y1Di"
+    "Qdk+dZ9r8NRQnpjChQzwhMAkxyrdjT1N7NcfTufiYQTOyiFvxPAC9D7vAzkpGgxU"
+    "Ikylk7cYRxqkRGS/AayvfipJ/HOkoBd0yKu1MRk4YcKGd/EahDAhUtd9t4+v33Qv"
+    "uwIDAQAB";
+const char kRegionalAdBlockComponentTestBase64PublicKey[] =
+    "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAoKYkdDM8vWZXBbDJXTP6"
+    "1m9yLuH9iL/TvqAqu1zOd91VJu4bpcCMZjfGPC1g+O+pZrCaFVv5NJeZxGqT6DUB"
+    "RZUdXPkGGUC1ebS4LLJbggNQb152LFk8maR0/ItvMOW8eTcV8VFKHk4UrVhPTggf"
+    "dU/teuAesUUJnhFchijBtAqO+nJ0wEcksY8ktrIyoNPzMj43a1OVJVXrPFDc+WT/"
+    "G8XBq/Y8FbBt+u+7skWQy3lVyRwFjeFu6cXVF4tcc06PNx5yLsbHQtSv8R+h1bWw"
+    "ieMF3JB9CZPr+qDKIap+RZUfsraV47QebRi/JA17nbDMlXOmK7mILfFU7Jhjx04F"
+    "LwIDAQAB";
+const char kTrackingProtectionComponentTestBase64PublicKey[] =
+    "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAsleoSxQ3DN+6xym2P1uX"
+    "mN6ArIWd9Oru5CSjS0SRE5upM2EnAl/C20TP8JdIlPi/3tk/SN6Y92K3xIhAby5F"
+    "0rbPDSTXEWGy72tv2qb/WySGwDdvYQu9/J5sEDneVcMrSHcC0VWgcZR0eof4BfOy"
+    "fKMEnHX98tyA3z+vW5ndHspR/Xvo78B3+6HX6tyVm/pNlCNOm8W8feyfDfPpK2Lx"
+    "qRLB7PumyhR625txxolkGC6aC8rrxtT3oymdMfDYhB4BZBrzqdriyvu1NdygoEiF"
+    "WhIYw/5zv1NyIsfUiG8wIs5+OwS419z7dlMKsg1FuB2aQcDyjoXx1habFfHQfQwL"
+    "qwIDAQAB";
+const char kHTTPSEverywhereComponentTestBase64PublicKey[] =
+    "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEA3tAm7HooTNVGQ9cm7Yuc"
+    "M9sLM/V38JOXzdj7z9dyDIfO64N69Gr5dn3XRzLuD+Pyzpl8MzfY/tIbWNSw3I2a"
+    "8YcEPmyHl2L4HByKTm+eJ02ArhtkgtZKjiTDc84KQcsTBHqINkMUQYeUN3VW1lz2"
+    "yuZJrGlqlKCmQq7iRjCSUFu/C9mbJghTF8aKqmLbuf/pUXLpXFCRhCfaeabPqZP4"
+    "e9efRk7lsOraJMhF1Gcx0iubObKxl6Ov19e4nreYpw7Vp0fHodLzh0YxssLgNhTb"
+    "txtjWrJaXB5wghi1G0coTy6TgTXxoU9OU70eyf6PgdW4ZcaBIyM3tY6tme4zukvv"
+    "3wIDAQAB";
+
+content::ResourceType ResourceTypeFromString(const std::string& type) {
+  if (type == "main_frame")
+    return content::RESOURCE_TYPE_MAIN_FRAME;
+  if (type == "sub_frame")
+    return content::RESOURCE_TYPE_SUB_FRAME;
+  if (type == "stylesheet")
+    return content::RESOURCE_TYPE_STYLESHEET;
+  if (type == "script")
+    return content::RESOURCE_TYPE_SCRIPT;
+  if (type == "image")
+    return content::RESOURCE_TYPE_IMAGE;
+  if (type == "xhr")
+    return content::RESOURCE_TYPE_XHR;
+  return content::RESOURCE_TYPE_SUB_RESOURCE;
+}
+
+void PrintNsPerRequest(const std::string& stage,
+                       const std::string& pass,
+                       base::TimeDelta elapsed,
+                       size_t requests) {
+  perf_test::PrintResult(
+      stage, "", pass,
+      requests ? elapsed.InNanoseconds() / static_cast<double>(requests) : 0,
+      "ns/request", true);
+}
+
+// Stands in for the recorded third party responses, which are replayed with
+// empty bodies so the load measures the shields, not running page content.
+std::unique_ptr<net::test_server::HttpResponse> HandleReplayedRequest(
+    const net::test_server::HttpRequest& request) {
+  auto response = std::make_unique<net::test_server::BasicHttpResponse>();
+  const std::string path = request.GetURL().path();
+  if (base::EndsWith(path, ".js", base::CompareCase::INSENSITIVE_ASCII)) {
+    response->set_content_type("application/javascript");
+  } else if (base::EndsWith(path, ".css",
+                            base::CompareCase::INSENSITIVE_ASCII)) {
+    response->set_content_type("text/css");
+  } else {
+    response->set_content_type("text/html");
+  }
+  return std::move(response);
+}
+
+}  // namespace
+
+// Replays the recorded requests in test/data/shields-perf through every
+// shields stage the network delegate runs, on the thread each stage runs on
+// in the browser.
+class ShieldsPerfTest : public ExtensionBrowserTest {
+ public:
+  struct CorpusEntry {
+    GURL url;
+    content::ResourceType resource_type;
+    std::string tab_host;
+  };
+
+  // Totals for the loads of one page with the shields in one state.
+  struct PageLoadResult {
+    base::TimeDelta load_time;
+    base::TimeDelta navigation_timing;
+    base::TimeDelta io_thread_time;
+    std::vector<uint64_t> decisions;
+    size_t malloc_growth = 0;
+  };
+
+  ShieldsPerfTest()
+      : https_server_(net::EmbeddedTestServer::TYPE_HTTPS) {}
+
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    ExtensionBrowserTest::SetUpCommandLine(command_line);
+    // The HTTPS server only has a certificate for localhost.
+    command_line->AppendSwitch(switches::kIgnoreCertificateErrors);
+  }
+
+  void SetUpOnMainThread() override {
+    ExtensionBrowserTest::SetUpOnMainThread();
+    host_resolver()->AddRule("*", "127.0.0.1");
+  }
+
+  void SetUp() override {
+    brave::RegisterPathProvider();
+    brave_shields::AdBlockService::SetComponentIdAndBase64PublicKeyForTest(
+        kDefaultAdBlockComponentTestId,
+        kDefaultAdBlockComponentTestBase64PublicKey);
+    brave_shields::AdBlockRegionalService::
+        SetComponentIdAndBase64PublicKeyForTest(
+            kRegionalAdBlockComponentTestId,
+            kRegionalAdBlockComponentTestBase64PublicKey);
+    brave_component_updater::LocalDataFilesService::
+        SetComponentIdAndBase64PublicKeyForTest(
+            kTrackingProtectionComponentTestId,
+            kTrackingProtectionComponentTestBase64PublicKey);
+    brave_shields::HTTPSEverywhereService::
+        SetComponentIdAndBase64PublicKeyForTest(
+            kHTTPSEverywhereComponentTestId,
+            kHTTPSEverywhereComponentTestBase64PublicKey);
+
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    https_server_.ServeFilesFromDirectory(test_data_dir);
+    https_server_.RegisterRequestHandler(
+        base::BindRepeating(&HandleReplayedRequest));
+    ASSERT_TRUE(https_server_.Start());
+
+    ExtensionBrowserTest::SetUp();
+  }
+
+  void GetTestDataDir(base::FilePath* test_data_dir) {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    base::PathService::Get(brave::DIR_TEST_DATA, test_data_dir);
+  }
+
+  bool LoadCorpus() {
+    base::FilePath test_data_dir;
+    GetTestDataDir(&test_data_dir);
+    std::string contents;
+    {
+      base::ScopedAllowBlockingForTesting allow_blocking;
+      if (!base::ReadFileToString(test_data_dir.AppendASCII("shields-perf")
+                                      .AppendASCII(kRequestCorpusFile),
+                                  &contents)) {
+        return false;
+      }
+    }
+    for (const std::string& line : base::SplitString(
+             contents, "\n", base::TRIM_WHITESPACE,
+             base::SPLIT_WANT_NONEMPTY)) {
+      if (line[0] == '#')
+        continue;
+      std::vector<std::string> fields = base::SplitString(
+          line, "\t", base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+      if (fields.size() != 3)
+        return false;
+      corpus_.push_back(
+          {GURL(fields[0]), ResourceTypeFromString(fields[1]), fields[2]});
+    }
+    for (const CorpusEntry& entry : corpus_) {
+      match_requests_.push_back(
+          std::make_unique<brave_shields::ShieldsMatchRequest>(
+              entry.url, entry.resource_type, entry.tab_host));
+    }
+    return !corpus_.empty();
+  }
+
+  bool InstallShieldsComponents() {
+    base::FilePath test_data_dir;
+    GetTestDataDir(&test_data_dir);
+    base::FilePath adblock_data_dir = test_data_dir.AppendASCII("adblock-data");
+
+    const extensions::Extension* extension =
+        InstallExtension(adblock_data_dir.AppendASCII("adblock-default"), 1);
+    if (!extension)
+      return false;
+    g_brave_browser_process->ad_block_service()->OnComponentReady(
+        extension->id(), extension->path(), "");
+
+    extension = InstallExtension(adblock_data_dir.AppendASCII(
+        "adblock-regional").AppendASCII(kEasyListFranceUUID), 1);
+    if (!extension)
+      return false;
+    brave_shields::AdBlockRegionalServiceManager* regional_manager =
+        g_brave_browser_process->ad_block_regional_service_manager();
+    regional_manager->EnableFilterList(kEasyListFranceUUID, true);
+    auto regional_service =
+        regional_manager->regional_services_.find(kEasyListFranceUUID);
+    if (regional_service == regional_manager->regional_services_.end())
+      return false;
+    regional_service->second->OnComponentReady(extension->id(),
+                                               extension->path(), "");
+
+    extension = InstallExtension(
+        test_data_dir.AppendASCII("tracking-protection-data"), 1);
+    if (!extension)
+      return false;
+    g_brave_browser_process->tracking_protection_service()->OnComponentReady(
+        extension->id(), extension->path(), "");
+
+    extension = InstallExtension(
+        test_data_dir.AppendASCII("https-everywhere-data"), 1);
+    if (!extension)
+      return false;
+    g_brave_browser_process->https_everywhere_service()->OnComponentReady(
+        extension->id(), extension->path(), "");
+
+    // Local data files load in the thread pool, replying to this thread.
+    content::RunAllTasksUntilIdle();
+    WaitForTaskRunner(
+        g_brave_browser_process->local_data_files_service()->GetTaskRunner());
+    WaitForTaskRunner(
+        g_brave_browser_process->https_everywhere_service()->GetTaskRunner());
+    WaitForTaskRunner(
+        base::CreateSingleThreadTaskRunnerWithTraits({BrowserThread::IO}));
+    return true;
+  }
+
+  void WaitForTaskRunner(scoped_refptr<base::SequencedTaskRunner> runner) {
+    scoped_refptr<base::ThreadTestHelper> helper(
+        new base::ThreadTestHelper(runner));
+    ASSERT_TRUE(helper->Run());
+  }
+
+  // Runs |closure| on |runner| and waits for it.
+  void RunOn(scoped_refptr<base::SequencedTaskRunner> runner,
+             base::OnceClosure closure) {
+    base::RunLoop run_loop;
+    runner->PostTaskAndReply(FROM_HERE, std::move(closure),
+                             run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
+  template <typename StageFunction>
+  void MeasureStage(const std::string& stage, StageFunction run_request) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    for (size_t i = 0; i < corpus_.size(); i++) {
+      run_request(i);
+    }
+    PrintNsPerRequest(stage, "cold", base::TimeTicks::Now() - start,
+                      corpus_.size());
+
+    start = base::TimeTicks::Now();
+    for (int iteration = 0; iteration < kWarmIterations; iteration++) {
+      for (size_t i = 0; i < corpus_.size(); i++) {
+        run_request(i);
+      }
+    }
+    PrintNsPerRequest(stage, "warm", base::TimeTicks::Now() - start,
+                      corpus_.size() * kWarmIterations);
+  }
+
+  void RunIOThreadStages() {
+    DCHECK_CURRENTLY_ON(BrowserThread::IO);
+    bool did_match_exception = false;
+    bool cancel_request_explicitly = false;
+
+    brave_shields::AdBlockService* ad_block_service =
+        g_brave_browser_process->ad_block_service();
+    MeasureStage("ad_block_default", [&](size_t i) {
+      ad_block_service->ShouldStartRequest(*match_requests_[i],
+          &did_match_exception, &cancel_request_explicitly);
+    });
+
+    brave_shields::AdBlockRegionalServiceManager* regional_manager =
+        g_brave_browser_process->ad_block_regional_service_manager();
+    std::string matching_uuid;
+    MeasureStage("ad_block_regional", [&](size_t i) {
+      regional_manager->ShouldStartRequest(*match_requests_[i],
+          &did_match_exception, &cancel_request_explicitly, &matching_uuid);
+    });
+
+    brave_shields::TrackingProtectionService* tracking_protection_service =
+        g_brave_browser_process->tracking_protection_service();
+    MeasureStage("tracking_protection", [&](size_t i) {
+      tracking_protection_service->ShouldStartRequest(*match_requests_[i],
+          &did_match_exception, &cancel_request_explicitly);
+    });
+
+    std::vector<std::shared_ptr<brave::BraveRequestInfo>> contexts;
+    for (const CorpusEntry& entry : corpus_) {
+      auto ctx = std::make_shared<brave::BraveRequestInfo>();
+      ctx->request_url = entry.url;
+      contexts.push_back(ctx);
+    }
+    brave::ResponseCallback next_callback;
+    MeasureStage("static_redirect", [&](size_t i) {
+      contexts[i]->new_url_spec.clear();
+      brave::OnBeforeURLRequest_StaticRedirectWork(next_callback,
+                                                   contexts[i]);
+    });
+  }
+
+  void RunHTTPSEverywhereStage() {
+    brave_shields::HTTPSEverywhereService* https_everywhere_service =
+        g_brave_browser_process->https_everywhere_service();
+    std::string new_url;
+    MeasureStage("https_everywhere", [&](size_t i) {
+      new_url.clear();
+      https_everywhere_service->GetHTTPSURL(&corpus_[i].url, &new_url);
+    });
+  }
+
+  void SetShieldsEnabled(bool enabled) {
+    HostContentSettingsMapFactory::GetForProfile(browser()->profile())
+        ->SetContentSettingCustomScope(
+            ContentSettingsPattern::Wildcard(),
+            ContentSettingsPattern::Wildcard(),
+            CONTENT_SETTINGS_TYPE_PLUGINS, brave_shields::kBraveShields,
+            enabled ? CONTENT_SETTING_ALLOW : CONTENT_SETTING_BLOCK);
+    // Lets the IO thread see the new setting before the next load.
+    content::RunAllTasksUntilIdle();
+  }
+
+  GURL GetRecordedPageURL(const RecordedPage& page) {
+    const std::string path = net::test_server::GetFilePathWithReplacements(
+        std::string("/shields-perf/pages/") + page.name + ".html",
+        {{"REPLACE_WITH_PORT", base::NumberToString(https_server_.port())}});
+    return https_server_.GetURL(page.host, path);
+  }
+
+  std::vector<uint64_t> GetShieldsDecisions() {
+    PrefService* prefs = browser()->profile()->GetPrefs();
+    std::vector<uint64_t> decisions;
+    for (const char* pref : kShieldsDecisionPrefs)
+      decisions.push_back(prefs->GetUint64(pref));
+    return decisions;
+  }
+
+  // CPU time the IO thread has used so far, where the network delegate runs
+  // the shields for every request.
+  base::TimeDelta GetIOThreadTime() {
+    if (!base::ThreadTicks::IsSupported())
+      return base::TimeDelta();
+    base::ThreadTicks io_thread_ticks;
+    RunOn(base::CreateSingleThreadTaskRunnerWithTraits({BrowserThread::IO}),
+          base::BindOnce([](base::ThreadTicks* ticks) {
+            *ticks = base::ThreadTicks::Now();
+          }, &io_thread_ticks));
+    return io_thread_ticks - base::ThreadTicks();
+  }
+
+  // Loads |url| in the active tab and waits for the page to settle, adding
+  // the cost of the load to |result|.
+  void LoadPage(const GURL& url, PageLoadResult* result) {
+    content::WebContents* contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    ui_test_utils::NavigateToURL(browser(), GURL("about:blank"));
+    content::RunAllTasksUntilIdle();
+
+    const std::vector<uint64_t> decisions_before = GetShieldsDecisions();
+    const base::TimeDelta io_thread_time_before = GetIOThreadTime();
+    const size_t malloc_usage_before = GetMallocUsage();
+    const base::TimeTicks start = base::TimeTicks::Now();
+
+    content::TitleWatcher title_watcher(contents,
+                                        base::ASCIIToUTF16(kPageDoneTitle));
+    ui_test_utils::NavigateToURL(browser(), url);
+    ASSERT_EQ(base::ASCIIToUTF16(kPageDoneTitle),
+              title_watcher.WaitAndGetTitle());
+    result->load_time += base::TimeTicks::Now() - start;
+
+    // Blocked counts reach the profile through the UI thread.
+    content::RunAllTasksUntilIdle();
+    result->io_thread_time += GetIOThreadTime() - io_thread_time_before;
+    const size_t malloc_usage = GetMallocUsage();
+    if (malloc_usage > malloc_usage_before)
+      result->malloc_growth += malloc_usage - malloc_usage_before;
+
+    const std::vector<uint64_t> decisions = GetShieldsDecisions();
+    result->decisions.resize(decisions.size());
+    for (size_t i = 0; i < decisions.size(); i++)
+      result->decisions[i] += decisions[i] - decisions_before[i];
+
+    result->navigation_timing += base::TimeDelta::FromMilliseconds(
+        content::EvalJs(contents,
+                        "performance.timing.loadEventEnd - "
+                        "performance.timing.navigationStart").ExtractInt());
+  }
+
+  void PrintPageLoadResult(const std::string& trace,
+                           const PageLoadResult& result) {
+    perf_test::PrintResult("page_load_time", "", trace,
+        result.load_time.InMillisecondsF() / kPageLoadIterations, "ms",
+        true);
+    perf_test::PrintResult("page_load_navigation_timing", "", trace,
+        result.navigation_timing.InMillisecondsF() / kPageLoadIterations,
+        "ms", true);
+    if (base::ThreadTicks::IsSupported()) {
+      perf_test::PrintResult("page_load_io_thread_time", "", trace,
+          result.io_thread_time.InMillisecondsF() / kPageLoadIterations,
+          "ms", true);
+    }
+    for (size_t i = 0; i < result.decisions.size(); i++) {
+      perf_test::PrintResult(
+          std::string("page_load_") + kShieldsDecisionPrefs[i], "", trace,
+          static_cast<double>(result.decisions[i]) / kPageLoadIterations,
+          "count", true);
+    }
+    // Net heap growth of the browser process stands in for memory, since the
+    // allocator is not hooked in this test binary.
+    perf_test::PrintResult("page_load_heap", "", trace,
+        static_cast<double>(result.malloc_growth) / kPageLoadIterations,
+        "bytes", true);
+  }
+
+  size_t GetMallocUsage() {
+    return base::ProcessMetrics::CreateCurrentProcessMetrics()
+        ->GetMallocUsage();
+  }
+
+  void PrintPeakMemory() {
+#if defined(OS_POSIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+      return;
+#if defined(OS_MACOSX)
+    // Reported in bytes on Mac and in kilobytes everywhere else.
+    double peak_kb = usage.ru_maxrss / 1024.0;
+#else
+    double peak_kb = usage.ru_maxrss;
+#endif
+    perf_test::PrintResult("shields_peak_memory", "", "max_rss", peak_kb,
+                           "KB", true);
+#endif
+  }
+
+ protected:
+  net::EmbeddedTestServer https_server_;
+  std::vector<CorpusEntry> corpus_;
+  std::vector<std::unique_ptr<brave_shields::ShieldsMatchRequest>>
+      match_requests_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ShieldsPerfTest);
+};
+
+IN_PROC_BROWSER_TEST_F(ShieldsPerfTest, ReplayRequestCorpus) {
+  ASSERT_TRUE(LoadCorpus());
+  ASSERT_TRUE(InstallShieldsComponents());
+
+  RunOn(base::CreateSingleThreadTaskRunnerWithTraits({BrowserThread::IO}),
+        base::BindOnce(&ShieldsPerfTest::RunIOThreadStages,
+                       base::Unretained(this)));
+  RunOn(g_brave_browser_process->https_everywhere_service()->GetTaskRunner(),
+        base::BindOnce(&ShieldsPerfTest::RunHTTPSEverywhereStage,
+                       base::Unretained(this)));
+  PrintPeakMemory();
+}
+
+// Loads recorded tracker heavy pages with every shields list installed, with
+// the shields on and then off, and reports the cost of each load.
+IN_PROC_BROWSER_TEST_F(ShieldsPerfTest, LoadRecordedPages) {
+  ASSERT_TRUE(InstallShieldsComponents());
+
+  for (const RecordedPage& page : kRecordedPages) {
+    const GURL url = GetRecordedPageURL(page);
+    for (const bool shields_enabled : { true, false }) {
+      SetShieldsEnabled(shields_enabled);
+
+      PageLoadResult warm_up;
+      LoadPage(url, &warm_up);
+
+      PageLoadResult result;
+      for (int i = 0; i < kPageLoadIterations; i++)
+        LoadPage(url, &result);
+      PrintPageLoadResult(std::string(page.name) +
+                              (shields_enabled ? "_shields_on"
+                                               : "_shields_off"),
+                          result);
+
+      if (!shields_enabled) {
+        for (const uint64_t decisions : result.decisions)
+          EXPECT_EQ(0ULL, decisions);
+      }
+    }
+  }
+}
@@ -0,0 +1,120 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
+
+#include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/tracking_protection_service.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/origin.h"
+
+using namespace net::registry_controlled_domains;  // NOLINT
+
+namespace brave_shields {
+
+namespace {
+
+bool IsThirdParty(const GURL& url, const std::string& tab_host) {
+  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
+  // a URL or origin and not a string to a host name.
+  return !SameDomainOrHost(url, url::Origin::CreateFromNormalizedTuple(
+      "https", tab_host.c_str(), 80), INCLUDE_PRIVATE_REGISTRIES);
+}
+
+}  // namespace
+
+ShieldsMatchRequest::ShieldsMatchRequest(const GURL& url,
+                                         content::ResourceType resource_type,
+                                         const std::string& tab_host)
+    : url(url),
+      spec(url.spec()),
+      host(url.host()),
+      tab_host(tab_host),
+      resource_type(resource_type),
+      is_third_party(IsThirdParty(url, tab_host)) {
+}
+
+ShieldsMatchRequest::~ShieldsMatchRequest() {
+}
+
+ShieldsMatchResult::ShieldsMatchResult() {
+}
+
+ShieldsMatchResult::ShieldsMatchResult(const ShieldsMatchResult& other) =
+    default;
+
+ShieldsMatchResult::~ShieldsMatchResult() {
+}
+
+bool ShieldsMatchResult::IsBlocked() const {
+  return source != ShieldsMatchSource::kNone && !did_match_exception;
+}
+
+bool ShieldsMatchResult::IsBlockedByAdBlock() const {
+  return IsBlocked() && source != ShieldsMatchSource::kTrackingProtection;
+}
+
+bool ShieldsMatchResult::IsBlockedByTrackingProtection() const {
+  return IsBlocked() && source == ShieldsMatchSource::kTrackingProtection;
+}
+
+ShieldsRequestMatcher::ShieldsRequestMatcher(
+    AdBlockService* ad_block_service,
+    AdBlockRegionalServiceManager* regional_manager,
+    AdBlockCustomFiltersService* custom_filters_service,
+    TrackingProtectionService* tracking_protection_service)
+    : ad_block_service_(ad_block_service),
+      regional_manager_(regional_manager),
+      custom_filters_service_(custom_filters_service),
+      tracking_protection_service_(tracking_protection_service) {
+}
+
+ShieldsRequestMatcher::~ShieldsRequestMatcher() {
+}
+
+ShieldsMatchResult ShieldsRequestMatcher::Match(
+    const ShieldsMatchRequest& request) const {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
+  ShieldsMatchResult result;
+
+  if (ad_block_service_ &&
+      (!ad_block_service_->ShouldStartRequest(request,
+          &result.did_match_exception, &result.cancel_request_explicitly) ||
+       result.did_match_exception)) {
+    result.source = ShieldsMatchSource::kAdBlockDefault;
+    return result;
+  }
+
+  if (regional_manager_ &&
+      (!regional_manager_->ShouldStartRequest(request,
+          &result.did_match_exception, &result.cancel_request_explicitly,
+          &result.regional_list_uuid) ||
+       result.did_match_exception)) {
+    result.source = ShieldsMatchSource::kAdBlockRegional;
+    return result;
+  }
+
+  if (custom_filters_service_ &&
+      (!custom_filters_service_->ShouldStartRequest(request,
+          &result.did_match_exception, &result.cancel_request_explicitly) ||
+       result.did_match_exception)) {
+    result.source = ShieldsMatchSource::kAdBlockCustom;
+    return result;
+  }
+
+  if (tracking_protection_service_ &&
+      !tracking_protection_service_->ShouldStartRequest(request,
+          &result.did_match_exception, &result.cancel_request_explicitly)) {
+    result.source = ShieldsMatchSource::kTrackingProtection;
+    return result;
+  }
+
+  return result;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,95 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_REQUEST_MATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_REQUEST_MATCHER_H_
+
+#include <string>
+
+#include "base/macros.h"
+#include "content/public/common/resource_type.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+class AdBlockCustomFiltersService;
+class AdBlockRegionalServiceManager;
+class AdBlockService;
+class TrackingProtectionService;
+
+// A request normalized once so that it can be checked against every loaded
+// filter list without re-serializing the URL or re-computing third-party
+// status for each of them.
+struct ShieldsMatchRequest {
+  ShieldsMatchRequest(const GURL& url,
+                      content::ResourceType resource_type,
+                      const std::string& tab_host);
+  ~ShieldsMatchRequest();
+
+  // Not owned, must outlive this object.
+  const GURL& url;
+  const std::string spec;
+  const std::string host;
+  const std::string tab_host;
+  const content::ResourceType resource_type;
+  const bool is_third_party;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsMatchRequest);
+};
+
+// The list that decided the outcome of a match.
+enum class ShieldsMatchSource {
+  kNone,
+  kAdBlockDefault,
+  kAdBlockRegional,
+  kAdBlockCustom,
+  kTrackingProtection,
+};
+
+struct ShieldsMatchResult {
+  ShieldsMatchResult();
+  ShieldsMatchResult(const ShieldsMatchResult& other);
+  ~ShieldsMatchResult();
+
+  bool IsBlocked() const;
+  bool IsBlockedByAdBlock() const;
+  bool IsBlockedByTrackingProtection() const;
+
+  // The list that blocked the request or, if |did_match_exception| is set,
+  // the list whose exception rule allowed it.
+  ShieldsMatchSource source = ShieldsMatchSource::kNone;
+  // uuid of the regional list when |source| is kAdBlockRegional.
+  std::string regional_list_uuid;
+  bool did_match_exception = false;
+  bool cancel_request_explicitly = false;
+};
+
+// Resolves block/exception/explicit-cancel across the default, regional and
+// custom ad-block lists and the tracking protection list in a single pass
+// over one ShieldsMatchRequest. Lists are consulted in priority order and
+// the first block or exception wins, matching the order the network
+// delegate has always used. Must be used on the IO thread.
+class ShieldsRequestMatcher {
+ public:
+  ShieldsRequestMatcher(AdBlockService* ad_block_service,
+                        AdBlockRegionalServiceManager* regional_manager,
+                        AdBlockCustomFiltersService* custom_filters_service,
+                        TrackingProtectionService* tracking_protection_service);
+  ~ShieldsRequestMatcher();
+
+  ShieldsMatchResult Match(const ShieldsMatchRequest& request) const;
+
+ private:
+  AdBlockService* ad_block_service_;  // NOT OWNED
+  AdBlockRegionalServiceManager* regional_manager_;  // NOT OWNED
+  AdBlockCustomFiltersService* custom_filters_service_;  // NOT OWNED
+  TrackingProtectionService* tracking_protection_service_;  // NOT OWNED
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsRequestMatcher);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_REQUEST_MATCHER_H_
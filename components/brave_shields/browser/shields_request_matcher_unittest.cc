@@ -0,0 +1,51 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::ShieldsMatchRequest;
+using brave_shields::ShieldsMatchResult;
+using brave_shields::ShieldsMatchSource;
+
+TEST(ShieldsRequestMatcherTest, NormalizesRequestOnce) {
+  GURL url("https://cdn.example.com/ad.js?x=1");
+  ShieldsMatchRequest request(url, content::ResourceType::kScript,
+                              "www.example.com");
+  EXPECT_EQ(request.spec, url.spec());
+  EXPECT_EQ(request.host, "cdn.example.com");
+  EXPECT_EQ(request.tab_host, "www.example.com");
+  EXPECT_EQ(request.resource_type, content::ResourceType::kScript);
+  EXPECT_FALSE(request.is_third_party);
+}
+
+TEST(ShieldsRequestMatcherTest, DetectsThirdParty) {
+  GURL url("https://tracker.test/pixel.gif");
+  ShieldsMatchRequest request(url, content::ResourceType::kImage,
+                              "www.example.com");
+  EXPECT_TRUE(request.is_third_party);
+}
+
+TEST(ShieldsRequestMatcherTest, ResultAttribution) {
+  ShieldsMatchResult result;
+  EXPECT_FALSE(result.IsBlocked());
+
+  result.source = ShieldsMatchSource::kAdBlockRegional;
+  result.regional_list_uuid = "9852EFC4-99E4-4F2D-A915-9C3196C7A1DE";
+  EXPECT_TRUE(result.IsBlocked());
+  EXPECT_TRUE(result.IsBlockedByAdBlock());
+  EXPECT_FALSE(result.IsBlockedByTrackingProtection());
+
+  result.did_match_exception = true;
+  EXPECT_FALSE(result.IsBlocked());
+  EXPECT_FALSE(result.IsBlockedByAdBlock());
+
+  result.did_match_exception = false;
+  result.source = ShieldsMatchSource::kTrackingProtection;
+  EXPECT_TRUE(result.IsBlockedByTrackingProtection());
+  EXPECT_FALSE(result.IsBlockedByAdBlock());
+}
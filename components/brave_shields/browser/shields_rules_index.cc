@@ -0,0 +1,103 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_rules_index.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "base/sha1.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+
+namespace brave_shields {
+
+namespace {
+
+void AppendRules(const std::vector<size_t>& rules,
+                 std::vector<size_t>* candidates) {
+  candidates->insert(candidates->end(), rules.begin(), rules.end());
+}
+
+}  // namespace
+
+ShieldsRulesIndex::ShieldsRulesIndex(ContentSettingsForOneType rules)
+    : rules_(std::move(rules)) {
+  std::map<std::string, std::vector<size_t>> host_rules;
+  std::map<std::string, std::vector<size_t>> domain_rules;
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    const ContentSettingsPattern& pattern = rules_[i].primary_pattern;
+    const std::string host = pattern.GetHost();
+    if (host.empty() || host.find_first_of("[:") != std::string::npos) {
+      any_host_rules_.push_back(i);
+    } else if (pattern.HasDomainWildcard()) {
+      domain_rules[host].push_back(i);
+    } else {
+      host_rules[host].push_back(i);
+    }
+  }
+
+  host_rules_ = HostRules(std::make_move_iterator(host_rules.begin()),
+                          std::make_move_iterator(host_rules.end()));
+  domain_rules_ = HostRules(std::make_move_iterator(domain_rules.begin()),
+                            std::make_move_iterator(domain_rules.end()));
+}
+
+ShieldsRulesIndex::~ShieldsRulesIndex() {
+}
+
+// static
+std::string ShieldsRulesIndex::GetFingerprint(
+    const ContentSettingsForOneType& rules) {
+  // Only what GetContentSetting() reads, in order, since order decides which
+  // rule wins.
+  std::string serialized;
+  for (const ContentSettingPatternSource& rule : rules) {
+    serialized += rule.primary_pattern.ToString();
+    serialized += '\t';
+    serialized += rule.secondary_pattern.ToString();
+    serialized += '\t';
+    serialized += base::NumberToString(rule.GetContentSetting());
+    serialized += '\n';
+  }
+  return base::SHA1HashString(serialized);
+}
+
+ContentSetting ShieldsRulesIndex::GetContentSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url) const {
+  std::vector<size_t> candidates = any_host_rules_;
+
+  const base::StringPiece host = primary_url.host_piece();
+  if (!host.empty()) {
+    auto it = host_rules_.find(host);
+    if (it != host_rules_.end())
+      AppendRules(it->second, &candidates);
+
+    // "[*.]foo.com" applies to "foo.com" and every host under it
+    for (size_t start = 0; start != base::StringPiece::npos;) {
+      it = domain_rules_.find(host.substr(start));
+      if (it != domain_rules_.end())
+        AppendRules(it->second, &candidates);
+      start = host.find('.', start);
+      if (start != base::StringPiece::npos)
+        ++start;
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  for (size_t i : candidates) {
+    const ContentSettingPatternSource& rule = rules_[i];
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      return rule.GetContentSetting();
+    }
+  }
+  return CONTENT_SETTING_DEFAULT;
+}
+
+}  // namespace brave_shields
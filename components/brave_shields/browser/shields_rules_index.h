@@ -0,0 +1,60 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_RULES_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_RULES_INDEX_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+// Indexes the rules of one shields resource by the host of their primary
+// pattern, so a lookup only matches the rules that can apply to the primary
+// host instead of every site exception. Rules are kept in the order
+// HostContentSettingsMap returns them, which is the order it matches them
+// in, and the first matching candidate wins just as it would in the map.
+class ShieldsRulesIndex : public base::RefCountedThreadSafe<ShieldsRulesIndex> {
+ public:
+  explicit ShieldsRulesIndex(ContentSettingsForOneType rules);
+
+  // Same for any two rule lists an index would give the same results for,
+  // so maps with the same exceptions can share one index.
+  static std::string GetFingerprint(const ContentSettingsForOneType& rules);
+
+  // Returns CONTENT_SETTING_DEFAULT when no rule matches.
+  ContentSetting GetContentSetting(const GURL& primary_url,
+                                   const GURL& secondary_url) const;
+
+  size_t size() const { return rules_.size(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<ShieldsRulesIndex>;
+  using HostRules =
+      base::flat_map<std::string, std::vector<size_t>, std::less<>>;
+
+  ~ShieldsRulesIndex();
+
+  const ContentSettingsForOneType rules_;
+  // Rules whose primary pattern matches any host, or a host this index
+  // doesn't bucket, such as an IPv6 literal.
+  std::vector<size_t> any_host_rules_;
+  // Rules for exactly one host, and rules for a domain and its subdomains.
+  HostRules host_rules_;
+  HostRules domain_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsRulesIndex);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_RULES_INDEX_H_
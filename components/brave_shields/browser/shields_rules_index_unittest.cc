@@ -0,0 +1,99 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <utility>
+
+#include "brave/components/brave_shields/browser/shields_rules_index.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=ShieldsRulesIndexTest.*
+
+using brave_shields::ShieldsRulesIndex;
+
+namespace {
+
+ContentSettingPatternSource CreateRule(const std::string& primary_pattern,
+                                       const std::string& secondary_pattern,
+                                       ContentSetting setting) {
+  return ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary_pattern),
+      ContentSettingsPattern::FromString(secondary_pattern),
+      base::Value::FromUniquePtrValue(
+          content_settings::ContentSettingToValue(setting)),
+      std::string(), false);
+}
+
+}  // namespace
+
+TEST(ShieldsRulesIndexTest, MatchesHostsAndDomains) {
+  ContentSettingsForOneType rules;
+  rules.push_back(CreateRule("www.brave.com", "*", CONTENT_SETTING_ALLOW));
+  rules.push_back(CreateRule("[*.]brave.com", "*", CONTENT_SETTING_BLOCK));
+  rules.push_back(CreateRule("[*.]example.com", "*", CONTENT_SETTING_ALLOW));
+  auto index = base::MakeRefCounted<ShieldsRulesIndex>(std::move(rules));
+
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+      index->GetContentSetting(GURL("https://www.brave.com/"), GURL()));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+      index->GetContentSetting(GURL("https://brave.com/"), GURL()));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+      index->GetContentSetting(GURL("https://a.b.brave.com/"), GURL()));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+      index->GetContentSetting(GURL("https://example.com/"), GURL()));
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+      index->GetContentSetting(GURL("https://notbrave.com/"), GURL()));
+}
+
+TEST(ShieldsRulesIndexTest, KeepsMapOrder) {
+  ContentSettingsForOneType rules;
+  rules.push_back(CreateRule("[*.]brave.com", "https://firstParty/*",
+                             CONTENT_SETTING_BLOCK));
+  rules.push_back(CreateRule("www.brave.com", "*", CONTENT_SETTING_ALLOW));
+  rules.push_back(CreateRule("*", "*", CONTENT_SETTING_BLOCK));
+  auto index = base::MakeRefCounted<ShieldsRulesIndex>(std::move(rules));
+
+  // The earlier domain rule wins over the later exact host rule
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+      index->GetContentSetting(GURL("https://www.brave.com/"),
+                               GURL("https://firstParty/")));
+  // The secondary pattern still has to match
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+      index->GetContentSetting(GURL("https://www.brave.com/"), GURL()));
+  // Rules for any host apply when no host rule matches
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+      index->GetContentSetting(GURL("https://example.com/"), GURL()));
+}
+
+TEST(ShieldsRulesIndexTest, FingerprintFollowsRules) {
+  ContentSettingsForOneType rules;
+  rules.push_back(CreateRule("www.brave.com", "*", CONTENT_SETTING_ALLOW));
+  rules.push_back(CreateRule("[*.]brave.com", "*", CONTENT_SETTING_BLOCK));
+
+  ContentSettingsForOneType same_rules;
+  same_rules.push_back(CreateRule("www.brave.com", "*", CONTENT_SETTING_ALLOW));
+  same_rules.push_back(CreateRule("[*.]brave.com", "*", CONTENT_SETTING_BLOCK));
+  EXPECT_EQ(ShieldsRulesIndex::GetFingerprint(rules),
+            ShieldsRulesIndex::GetFingerprint(same_rules));
+
+  // The first matching rule wins, so order matters.
+  ContentSettingsForOneType reordered_rules;
+  reordered_rules.push_back(
+      CreateRule("[*.]brave.com", "*", CONTENT_SETTING_BLOCK));
+  reordered_rules.push_back(
+      CreateRule("www.brave.com", "*", CONTENT_SETTING_ALLOW));
+  EXPECT_NE(ShieldsRulesIndex::GetFingerprint(rules),
+            ShieldsRulesIndex::GetFingerprint(reordered_rules));
+
+  ContentSettingsForOneType other_setting_rules;
+  other_setting_rules.push_back(
+      CreateRule("www.brave.com", "*", CONTENT_SETTING_BLOCK));
+  other_setting_rules.push_back(
+      CreateRule("[*.]brave.com", "*", CONTENT_SETTING_BLOCK));
+  EXPECT_NE(ShieldsRulesIndex::GetFingerprint(rules),
+            ShieldsRulesIndex::GetFingerprint(other_setting_rules));
+}
@@ -0,0 +1,151 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include <utility>
+
+#include "brave/components/brave_shields/browser/shields_rules_index.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave_shields {
+
+namespace {
+
+const size_t kShieldsSettingsCacheSize = 500;
+
+}  // namespace
+
+// static
+ShieldsSettingsCache* ShieldsSettingsCache::GetInstance() {
+  return base::Singleton<ShieldsSettingsCache>::get();
+}
+
+ShieldsSettingsCache::ShieldsSettingsCache()
+    : entries_(kShieldsSettingsCacheSize) {
+}
+
+ShieldsSettingsCache::~ShieldsSettingsCache() {
+}
+
+void ShieldsSettingsCache::StartObserving(HostContentSettingsMap* map) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK(map);
+  {
+    base::AutoLock lock(lock_);
+    if (!observed_maps_.insert(map).second)
+      return;
+  }
+  map->AddObserver(this);
+}
+
+void ShieldsSettingsCache::StopObserving(HostContentSettingsMap* map) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK(map);
+  {
+    base::AutoLock lock(lock_);
+    if (!observed_maps_.erase(map))
+      return;
+    // Entries are keyed by address, which a later map may reuse.
+    entries_.Clear();
+    rules_indexes_.clear();
+    shared_indexes_.clear();
+    ++version_;
+  }
+  map->RemoveObserver(this);
+}
+
+bool ShieldsSettingsCache::Get(HostContentSettingsMap* map,
+                               const GURL& tab_origin,
+                               ShieldsSettingsSnapshot* snapshot) {
+  base::AutoLock lock(lock_);
+  auto it = entries_.Get(Key(map, tab_origin.spec()));
+  if (it == entries_.end())
+    return false;
+  *snapshot = it->second;
+  return true;
+}
+
+void ShieldsSettingsCache::Put(HostContentSettingsMap* map,
+                               const GURL& tab_origin,
+                               const ShieldsSettingsSnapshot& snapshot) {
+  base::AutoLock lock(lock_);
+  if (observed_maps_.find(map) == observed_maps_.end())
+    return;
+  entries_.Put(Key(map, tab_origin.spec()), snapshot);
+}
+
+void ShieldsSettingsCache::Clear() {
+  base::AutoLock lock(lock_);
+  entries_.Clear();
+  rules_indexes_.clear();
+  shared_indexes_.clear();
+  ++version_;
+}
+
+bool ShieldsSettingsCache::GetContentSetting(
+    HostContentSettingsMap* map,
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    const std::string& resource_identifier,
+    ContentSetting* setting) {
+  const Key key(map, resource_identifier);
+  scoped_refptr<ShieldsRulesIndex> index;
+  uint64_t version;
+  {
+    base::AutoLock lock(lock_);
+    if (observed_maps_.find(map) == observed_maps_.end())
+      return false;
+    auto it = rules_indexes_.find(key);
+    if (it != rules_indexes_.end())
+      index = it->second;
+    version = version_;
+  }
+
+  if (!index) {
+    ContentSettingsForOneType rules;
+    map->GetSettingsForOneType(CONTENT_SETTINGS_TYPE_PLUGINS,
+                               resource_identifier, &rules);
+    const std::string fingerprint = ShieldsRulesIndex::GetFingerprint(rules);
+    {
+      base::AutoLock lock(lock_);
+      auto it = shared_indexes_.find(fingerprint);
+      if (version == version_ && it != shared_indexes_.end()) {
+        index = it->second;
+        rules_indexes_[key] = index;
+      }
+    }
+
+    if (!index) {
+      index = base::MakeRefCounted<ShieldsRulesIndex>(std::move(rules));
+
+      base::AutoLock lock(lock_);
+      if (version == version_) {
+        rules_indexes_[key] = index;
+        shared_indexes_.insert(std::make_pair(fingerprint, index));
+      }
+    }
+  }
+
+  *setting = index->GetContentSetting(primary_url, secondary_url);
+  return true;
+}
+
+void ShieldsSettingsCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  // Shields settings are stored as plugin settings with a resource
+  // identifier. CONTENT_SETTINGS_TYPE_DEFAULT means all types changed.
+  if (content_type != CONTENT_SETTINGS_TYPE_PLUGINS &&
+      content_type != CONTENT_SETTINGS_TYPE_DEFAULT) {
+    return;
+  }
+  Clear();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,112 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/containers/flat_set.h"
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/singleton.h"
+#include "base/synchronization/lock.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+
+namespace brave_shields {
+
+class ShieldsRulesIndex;
+
+// The shields settings that apply to every request made from one tab origin.
+struct ShieldsSettingsSnapshot {
+  bool allow_brave_shields = true;
+  bool allow_ads = false;
+  bool allow_http_upgradable_resource = false;
+  bool allow_1p_cookies = true;
+  bool allow_3p_cookies = false;
+  bool allow_referrers = false;
+};
+
+// Caches resolved shields settings per (content settings map, tab origin) so
+// that the network delegate doesn't walk the content settings rules for each
+// shields type on every request and every event. Entries are only kept for
+// maps registered with StartObserving(), and all of them are dropped
+// whenever any of those maps reports a change or stops being observed.
+//
+// It also keeps a ShieldsRulesIndex per (map, shields resource), so looking
+// up one shields setting doesn't match every site exception in turn.
+//
+// The ad block, tracking protection and HTTPS Everywhere engines are shared
+// by every profile already, so the content settings are the only per-profile
+// shields state. Indexes are shared between maps whose rules are the same,
+// so an extra profile without exceptions of its own, such as a new or Tor
+// profile, doesn't build or hold another copy.
+class ShieldsSettingsCache : public content_settings::Observer {
+ public:
+  static ShieldsSettingsCache* GetInstance();
+
+  // Must be called on the UI thread once the profile that owns |map| is
+  // initialized, and StopObserving() before that profile is destroyed.
+  void StartObserving(HostContentSettingsMap* map);
+  void StopObserving(HostContentSettingsMap* map);
+
+  // Safe to call from any thread.
+  bool Get(HostContentSettingsMap* map,
+           const GURL& tab_origin,
+           ShieldsSettingsSnapshot* snapshot);
+  void Put(HostContentSettingsMap* map,
+           const GURL& tab_origin,
+           const ShieldsSettingsSnapshot& snapshot);
+  void Clear();
+
+  // Safe to call from any thread. Looks up the shields setting for
+  // |resource_identifier| through the rules index of |map|, building it on
+  // first use. Returns false when |map| isn't observed, in which case the
+  // caller should ask |map| itself.
+  bool GetContentSetting(HostContentSettingsMap* map,
+                         const GURL& primary_url,
+                         const GURL& secondary_url,
+                         const std::string& resource_identifier,
+                         ContentSetting* setting);
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(
+      const ContentSettingsPattern& primary_pattern,
+      const ContentSettingsPattern& secondary_pattern,
+      ContentSettingsType content_type,
+      const std::string& resource_identifier) override;
+
+ private:
+  friend struct base::DefaultSingletonTraits<ShieldsSettingsCache>;
+  using Key = std::pair<HostContentSettingsMap*, std::string>;
+
+  ShieldsSettingsCache();
+  ~ShieldsSettingsCache() override;
+
+  base::Lock lock_;
+  base::flat_set<HostContentSettingsMap*> observed_maps_;
+  base::MRUCache<Key, ShieldsSettingsSnapshot> entries_;
+  // Keyed by (map, resource identifier). Indexes are built outside |lock_|
+  // and only stored if no change was reported meanwhile.
+  std::map<Key, scoped_refptr<ShieldsRulesIndex>> rules_indexes_;
+  // The indexes above by ShieldsRulesIndex::GetFingerprint() of their rules.
+  std::map<std::string, scoped_refptr<ShieldsRulesIndex>> shared_indexes_;
+  uint64_t version_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
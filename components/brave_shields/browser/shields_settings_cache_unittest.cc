@@ -0,0 +1,85 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include <memory>
+
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=ShieldsSettingsCacheTest.*
+
+using brave_shields::ShieldsSettingsCache;
+using brave_shields::ShieldsSettingsSnapshot;
+
+class ShieldsSettingsCacheTest : public testing::Test {
+ public:
+  void SetUp() override {
+    profile_ = std::make_unique<TestingProfile>();
+    map_ = HostContentSettingsMapFactory::GetForProfile(profile_.get());
+  }
+
+  void TearDown() override {
+    ShieldsSettingsCache::GetInstance()->StopObserving(map_);
+  }
+
+ protected:
+  content::TestBrowserThreadBundle test_browser_thread_bundle_;
+  std::unique_ptr<TestingProfile> profile_;
+  HostContentSettingsMap* map_;
+};
+
+TEST_F(ShieldsSettingsCacheTest, OnlyCachesObservedMaps) {
+  ShieldsSettingsCache* cache = ShieldsSettingsCache::GetInstance();
+  const GURL tab_origin("https://brave.com/");
+  ShieldsSettingsSnapshot snapshot;
+  snapshot.allow_ads = true;
+
+  cache->Put(map_, tab_origin, snapshot);
+  ShieldsSettingsSnapshot cached;
+  EXPECT_FALSE(cache->Get(map_, tab_origin, &cached));
+
+  cache->StartObserving(map_);
+  cache->Put(map_, tab_origin, snapshot);
+  ASSERT_TRUE(cache->Get(map_, tab_origin, &cached));
+  EXPECT_TRUE(cached.allow_ads);
+}
+
+TEST_F(ShieldsSettingsCacheTest, StopObservingDropsEntries) {
+  ShieldsSettingsCache* cache = ShieldsSettingsCache::GetInstance();
+  const GURL tab_origin("https://brave.com/");
+  cache->StartObserving(map_);
+  cache->Put(map_, tab_origin, ShieldsSettingsSnapshot());
+
+  // A map created later at the same address must not see these entries.
+  cache->StopObserving(map_);
+  ShieldsSettingsSnapshot cached;
+  EXPECT_FALSE(cache->Get(map_, tab_origin, &cached));
+  cache->Put(map_, tab_origin, ShieldsSettingsSnapshot());
+  EXPECT_FALSE(cache->Get(map_, tab_origin, &cached));
+
+  // Observing again starts from an empty cache.
+  cache->StartObserving(map_);
+  EXPECT_FALSE(cache->Get(map_, tab_origin, &cached));
+}
+
+TEST_F(ShieldsSettingsCacheTest, SettingChangeDropsEntries) {
+  ShieldsSettingsCache* cache = ShieldsSettingsCache::GetInstance();
+  const GURL tab_origin("https://brave.com/");
+  cache->StartObserving(map_);
+  cache->Put(map_, tab_origin, ShieldsSettingsSnapshot());
+
+  map_->SetContentSettingDefaultScope(tab_origin, GURL(),
+                                      CONTENT_SETTINGS_TYPE_PLUGINS,
+                                      brave_shields::kAds, CONTENT_SETTING_ALLOW);
+  ShieldsSettingsSnapshot cached;
+  EXPECT_FALSE(cache->Get(map_, tab_origin, &cached));
+}
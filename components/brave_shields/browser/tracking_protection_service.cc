@@ -8,16 +8,17 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/strings/string_split.h"
 #include "base/task/post_task.h"
 #include "base/task_runner_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
+#include "brave/components/brave_shields/browser/shields_request_matcher.h"
 #include "brave/components/content_settings/core/browser/brave_cookie_settings.h"
 #include "brave/vendor/tracking-protection/TPParser.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
-#include "base/strings/string_split.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/tracking_protection_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -42,6 +43,7 @@ TrackingProtectionService::TrackingProtectionService(
     LocalDataFilesService* local_data_files_service)
     : LocalDataFilesObserver(local_data_files_service),
       tracking_protection_client_(new CTPParser()),
+      third_party_hosts_cache_(kThirdPartyHostsCacheSize),
       weak_factory_(this),
       weak_factory_io_thread_(this) {
 }
@@ -49,6 +51,11 @@ TrackingProtectionService::TrackingProtectionService(
 TrackingProtectionService::~TrackingProtectionService() {
   BrowserThread::DeleteSoon(
       BrowserThread::IO, FROM_HERE, tracking_protection_client_.release());
+  // Released after the client, which may still reference the buffer.
+  BrowserThread::DeleteSoon(
+      BrowserThread::IO, FROM_HERE, dat_file_.release());
+  BrowserThread::DeleteSoon(
+      BrowserThread::IO, FROM_HERE, memory_pressure_listener_.release());
 }
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
@@ -224,6 +231,15 @@ bool TrackingProtectionService::ShouldStartRequest(
     const std::string& tab_host,
     bool* matching_exception_filter,
     bool* cancel_request_explicitly) {
+  return ShouldStartRequest(
+      ShieldsMatchRequest(url, resource_type, tab_host),
+      matching_exception_filter, cancel_request_explicitly);
+}
+
+bool TrackingProtectionService::ShouldStartRequest(
+    const ShieldsMatchRequest& request,
+    bool* matching_exception_filter,
+    bool* cancel_request_explicitly) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   // There are no exceptions in the TP service, but exceptions are
   // combined with brave/ad-block.
@@ -231,54 +247,57 @@ bool TrackingProtectionService::ShouldStartRequest(
     *matching_exception_filter = false;
   }
   // Intentionally don't set cancel_request_explicitly
-  std::string host = url.host();
-  if (!tracking_protection_client_->matchesTracker(tab_host.c_str(),
+  const std::string& host = request.host;
+  if (!tracking_protection_client_->matchesTracker(request.tab_host.c_str(),
                                                    host.c_str())) {
     return true;
   }
 
-  std::vector<std::string> hosts(GetThirdPartyHosts(tab_host));
-  for (size_t i = 0; i < hosts.size(); i++) {
-    if (host == hosts[i] ||
-        host.find((std::string) "." + hosts[i]) != std::string::npos) {
-      return true;
-    }
-    size_t iPos = host.find((std::string) "." + hosts[i]);
-    if (iPos == std::string::npos) {
-      continue;
-    }
-    if (hosts[i].length() + ((std::string) ".").length() + iPos ==
-        host.length()) {
-      return true;
-    }
-  }
-  return false;
+  return GetThirdPartyHosts(request.tab_host).ContainsHostOrParent(host);
 }
 
 void TrackingProtectionService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
+  if (result.unchanged)
+    return;
+  if (!result.data.second) {
     LOG(ERROR) << "Could not obtain tracking protection data";
     return;
   }
-  if (!result.first.get()) {
+  if (!result.data.first.get()) {
     LOG(ERROR) << "Failed to deserialize tracking protection data";
     return;
   }
 
+  dat_file_hash_ = result.hash;
   base::PostTaskWithTraits(
       FROM_HERE, {BrowserThread::IO},
       base::BindOnce(&TrackingProtectionService::UpdateTrackingProtectionClient,
                      weak_factory_io_thread_.GetWeakPtr(),
-                     std::move(result.first),
-                     std::move(result.second)));
+                     std::move(result.data.first),
+                     std::move(result.data.second)));
 }
 
 void TrackingProtectionService::UpdateTrackingProtectionClient(
     std::unique_ptr<CTPParser> tracking_protection_client,
-    brave_component_updater::DATFileDataBuffer buffer) {
+    std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   tracking_protection_client_ = std::move(tracking_protection_client);
-  buffer_ = std::move(buffer);
+  dat_file_ = std::move(dat_file);
+  third_party_hosts_cache_.Clear();
+  if (!memory_pressure_listener_) {
+    memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+        base::Bind(&TrackingProtectionService::OnMemoryPressure,
+                   weak_factory_io_thread_.GetWeakPtr()));
+  }
+}
+
+void TrackingProtectionService::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (memory_pressure_level !=
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    third_party_hosts_cache_.Clear();
+  }
 }
 
 void TrackingProtectionService::OnComponentReady(
@@ -290,10 +309,11 @@ void TrackingProtectionService::OnComponentReady(
       .AppendASCII(kNavigationTrackersFile);
 
   base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
+      local_data_files_service()->GetLoadTaskRunner().get(),
       FROM_HERE,
-      base::BindOnce(&brave_component_updater::LoadDATFileData<CTPParser>,
-                     navigation_tracking_protection_path),
+      base::BindOnce(
+          &brave_component_updater::LoadMappedDATFileDataIfChanged<CTPParser>,
+          navigation_tracking_protection_path, dat_file_hash_),
       base::BindOnce(&TrackingProtectionService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 
@@ -306,7 +326,7 @@ void TrackingProtectionService::OnComponentReady(
       .AppendASCII(kStorageTrackersFile);
 
   base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(),
+      local_data_files_service()->GetLoadTaskRunner().get(),
       FROM_HERE,
       base::BindOnce(&brave_component_updater::GetDATFileAsString,
                      storage_tracking_protection_path),
@@ -316,60 +336,27 @@ void TrackingProtectionService::OnComponentReady(
 }
 
 // Ported from Android: net/blockers/blockers_worker.cc
-std::vector<std::string> TrackingProtectionService::GetThirdPartyHosts(
+const ReversedHostTrie& TrackingProtectionService::GetThirdPartyHosts(
     const std::string& base_host) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  {
-    base::AutoLock guard(third_party_hosts_lock_);
-    std::map<std::string, std::vector<std::string>>::const_iterator iter =
-        third_party_hosts_cache_.find(base_host);
-    if (third_party_hosts_cache_.end() != iter) {
-      if (third_party_base_hosts_.size() != 0 &&
-          third_party_base_hosts_[third_party_hosts_cache_.size() - 1] !=
-              base_host) {
-        for (size_t i = 0; i < third_party_base_hosts_.size(); i++) {
-          if (third_party_base_hosts_[i] == base_host) {
-            third_party_base_hosts_.erase(third_party_base_hosts_.begin() + i);
-            third_party_base_hosts_.push_back(base_host);
-            break;
-          }
-        }
-      }
-      return iter->second;
-    }
-  }
+  auto iter = third_party_hosts_cache_.Get(base_host);
+  if (iter != third_party_hosts_cache_.end())
+    return *iter->second;
 
+  auto hosts = std::make_unique<ReversedHostTrie>();
   char* thirdPartyHosts =
       tracking_protection_client_->findFirstPartyHosts(base_host.c_str());
-  std::vector<std::string> hosts;
   if (nullptr != thirdPartyHosts) {
-    std::string strThirdPartyHosts = thirdPartyHosts;
-    size_t iPos = strThirdPartyHosts.find(",");
-    while (iPos != std::string::npos) {
-      std::string thirdParty = strThirdPartyHosts.substr(0, iPos);
-      strThirdPartyHosts = strThirdPartyHosts.substr(iPos + 1);
-      iPos = strThirdPartyHosts.find(",");
-      hosts.push_back(thirdParty);
-    }
-    if (0 != strThirdPartyHosts.length()) {
-      hosts.push_back(strThirdPartyHosts);
+    for (const base::StringPiece& host : base::SplitStringPiece(
+             thirdPartyHosts, ",", base::KEEP_WHITESPACE,
+             base::SPLIT_WANT_NONEMPTY)) {
+      hosts->Insert(host);
     }
     delete []thirdPartyHosts;
   }
 
-  {
-    base::AutoLock guard(third_party_hosts_lock_);
-    if (third_party_hosts_cache_.size() == kThirdPartyHostsCacheSize &&
-        third_party_base_hosts_.size() == kThirdPartyHostsCacheSize) {
-      third_party_hosts_cache_.erase(third_party_base_hosts_[0]);
-      third_party_base_hosts_.erase(third_party_base_hosts_.begin());
-    }
-    third_party_base_hosts_.push_back(base_host);
-    third_party_hosts_cache_.insert(
-        std::pair<std::string, std::vector<std::string>>(base_host, hosts));
-  }
-
-  return hosts;
+  iter = third_party_hosts_cache_.Put(base_host, std::move(hosts));
+  return *iter->second;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -13,13 +13,15 @@
 #include <vector>
 
 #include "base/containers/flat_set.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequenced_task_runner.h"
-#include "base/synchronization/lock.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "brave/components/brave_shields/browser/buildflags/buildflags.h"  // For STP
+#include "brave/components/brave_shields/browser/reversed_host_trie.h"
 #include "content/public/common/resource_type.h"
 #include "url/gurl.h"
 
@@ -36,11 +38,13 @@ using brave_component_updater::LocalDataFilesService;
 
 namespace brave_shields {
 
+struct ShieldsMatchRequest;
+
 // The brave shields service in charge of tracking protection and init.
 class TrackingProtectionService : public LocalDataFilesObserver {
  public:
   using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<CTPParser>;
+      brave_component_updater::LoadChangedDATFileDataResult<CTPParser>;
 
   explicit TrackingProtectionService(
       LocalDataFilesService* local_data_files_service);
@@ -51,6 +55,9 @@ class TrackingProtectionService : public LocalDataFilesObserver {
                           const std::string& tab_host,
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly);
+  bool ShouldStartRequest(const ShieldsMatchRequest& request,
+                          bool* matching_exception_filter,
+                          bool* cancel_request_explicitly);
 
   bool ShouldStoreState(content_settings::BraveCookieSettings* settings,
                         HostContentSettingsMap* map,
@@ -114,8 +121,12 @@ class TrackingProtectionService : public LocalDataFilesObserver {
   void OnGetDATFileData(GetDATFileDataResult result);
   void UpdateTrackingProtectionClient(
       std::unique_ptr<CTPParser> tracking_protection_client,
-      brave_component_updater::DATFileDataBuffer);
-  std::vector<std::string> GetThirdPartyHosts(const std::string& base_host);
+      std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+  // Returns the hosts |base_host| is allowed to load trackers from. The
+  // reference is valid until the next call.
+  const ReversedHostTrie& GetThirdPartyHosts(const std::string& base_host);
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
   base::flat_set<std::string> first_party_storage_trackers_;
@@ -123,10 +134,16 @@ class TrackingProtectionService : public LocalDataFilesObserver {
 #endif
 
   std::unique_ptr<CTPParser> tracking_protection_client_;
-  std::vector<std::string> third_party_base_hosts_;
-  std::map<std::string, std::vector<std::string>> third_party_hosts_cache_;
-  base::Lock third_party_hosts_lock_;
-  brave_component_updater::DATFileDataBuffer buffer_;
+  // Only used on the IO thread.
+  base::HashingMRUCache<std::string, std::unique_ptr<ReversedHostTrie>>
+      third_party_hosts_cache_;
+  // Created on the IO thread with the first client.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+  // |tracking_protection_client_| points into this buffer.
+  std::unique_ptr<brave_component_updater::DATFileDataBuffer> dat_file_;
+  // Hash of the last loaded navigation trackers DAT. Only used on the UI
+  // thread.
+  std::string dat_file_hash_;
 
   base::WeakPtrFactory<TrackingProtectionService> weak_factory_;
   base::WeakPtrFactory<TrackingProtectionService> weak_factory_io_thread_;
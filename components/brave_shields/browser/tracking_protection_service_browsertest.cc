@@ -21,6 +21,7 @@
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_test_utils.h"
+#include "content/public/test/test_utils.h"
 #include "net/dns/mock_host_resolver.h"
 
 #if BUILDFLAG(BRAVE_STP_ENABLED)
@@ -130,6 +131,8 @@ class TrackingProtectionServiceTest : public ExtensionBrowserTest {
   }
 
   void WaitForTrackingProtectionServiceThread() {
+    // Local data files load in the thread pool, replying to this thread.
+    content::RunAllTasksUntilIdle();
     scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
         g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
     ASSERT_TRUE(tr_helper->Run());
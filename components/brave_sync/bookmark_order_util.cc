@@ -5,10 +5,39 @@
 #include "brave/components/brave_sync/bookmark_order_util.h"
 
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
 
 namespace brave_sync {
 
+namespace {
+
+// Reads the segment of |order| after |*pos| the same way as OrderToIntVect
+// splits it, skipping empty segments. Returns false if there are none left.
+bool GetNextOrderSegment(base::StringPiece order, size_t* pos, int* segment) {
+  while (*pos <= order.size()) {
+    size_t end = order.find('.', *pos);
+    if (end == base::StringPiece::npos)
+      end = order.size();
+
+    base::StringPiece piece = base::TrimWhitespaceASCII(
+        order.substr(*pos, end - *pos), base::TRIM_ALL);
+    *pos = end + 1;
+    if (piece.empty())
+      continue;
+
+    bool b = base::StringToInt(piece, segment);
+    CHECK(b);
+    CHECK(*segment >= 0);
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace
+
 std::vector<int> OrderToIntVect(const std::string& s) {
   std::vector<std::string> vec_s = SplitString(
       s,
@@ -29,12 +58,21 @@ std::vector<int> OrderToIntVect(const std::string& s) {
 
 bool CompareOrder(const std::string& left, const std::string& right) {
   // Return: true if left <  right
-  // Split each and use C++ stdlib
-  std::vector<int> vec_left = OrderToIntVect(left);
-  std::vector<int> vec_right = OrderToIntVect(right);
-
-  return std::lexicographical_compare(vec_left.begin(), vec_left.end(),
-    vec_right.begin(), vec_right.end());
+  // Compares segment by segment like std::lexicographical_compare
+  size_t left_pos = 0;
+  size_t right_pos = 0;
+  int left_segment = 0;
+  int right_segment = 0;
+  while (true) {
+    bool has_left = GetNextOrderSegment(left, &left_pos, &left_segment);
+    bool has_right = GetNextOrderSegment(right, &right_pos, &right_segment);
+    if (!has_right)
+      return false;
+    if (!has_left)
+      return true;
+    if (left_segment != right_segment)
+      return left_segment < right_segment;
+  }
 }
 
 } // namespace brave_sync
@@ -11,6 +11,8 @@
 namespace brave_sync {
 
   std::vector<int> OrderToIntVect(const std::string& s);
+  // Compares the segments of the orders in place, without splitting them
+  // into vectors
   bool CompareOrder(const std::string& left, const std::string& right);
 
 } // namespace brave_sync
@@ -5,12 +5,17 @@
 
 #include "brave/components/brave_sync/brave_sync_service_impl.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
+#include "base/timer/timer.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/ui/webui/sync/sync_ui.h"
 #include "brave/components/brave_sync/bookmark_order_util.h"
 #include "brave/components/brave_sync/brave_sync_prefs.h"
@@ -28,6 +33,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "components/bookmarks/browser/bookmark_model.h"
 #include "net/base/network_interfaces.h"
+#include "ui/base/idle/idle.h"
 
 namespace brave_sync {
 
@@ -89,7 +95,7 @@ BraveSyncServiceImpl::BraveSyncServiceImpl(Profile* profile) :
         profile,
         sync_client_.get(),
         sync_prefs_.get())),
-    timer_(std::make_unique<base::RepeatingTimer>()),
+    timer_(std::make_unique<base::OneShotTimer>()),
     unsynced_send_interval_(base::TimeDelta::FromMinutes(10)) {
   // Moniter syncs prefs required in GetSettingsAndDevices
   profile_pref_change_registrar_.Init(profile->GetPrefs());
@@ -118,6 +124,17 @@ BraveSyncServiceImpl::BraveSyncServiceImpl(Profile* profile) :
       base::Bind(&BraveSyncServiceImpl::OnSyncPrefsChanged,
                  base::Unretained(this)));
 
+  // The processor is owned, so it does not outlive the service
+  bookmark_change_processor_->set_apply_changes_progress_callback(
+      base::BindRepeating(&BraveSyncServiceImpl::NotifySyncRecordsApplyProgress,
+                          base::Unretained(this)));
+  bookmark_change_processor_->set_apply_changes_done_callback(
+      base::BindRepeating(&BraveSyncServiceImpl::OnBookmarkChangesApplied,
+                          base::Unretained(this)));
+  bookmark_change_processor_->set_local_change_callback(
+      base::BindRepeating(&BraveSyncServiceImpl::OnLocalBookmarksChanged,
+                          base::Unretained(this)));
+
   if (!sync_prefs_->GetSeed().empty() &&
       !sync_prefs_->GetThisDeviceName().empty()) {
     sync_configured_ = true;
@@ -142,6 +159,8 @@ bool BraveSyncServiceImpl::IsSyncInitialized() {
 void BraveSyncServiceImpl::Shutdown() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   bookmark_change_processor_->Stop();
+  pending_bookmark_record_times_.clear();
+  applying_bookmark_record_time_ = base::Time();
 
   StopLoop();
 }
@@ -401,17 +420,30 @@ void BraveSyncServiceImpl::OnGetExistingObjects(
     const base::Time &last_record_time_stamp,
     const bool is_truncated) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT1("sync", "BraveSyncServiceImpl::OnGetExistingObjects",
+               "records", records->size());
   // TODO(bridiver) - what do we do with is_truncated ?
   // It appears to be ignored in b-l
-  if (!tools::IsTimeEmpty(last_record_time_stamp)) {
+  if (!records->empty())
+    records_fetched_since_poll_ = true;
+
+  if (category_name == jslib_const::kBookmarks) {
+    // Saved by OnBookmarkChangesApplied once these records are applied
+    pending_bookmark_record_times_.push_back(last_record_time_stamp);
+  } else if (!tools::IsTimeEmpty(last_record_time_stamp) &&
+             pending_bookmark_record_times_.empty() &&
+             tools::IsTimeEmpty(applying_bookmark_record_time_)) {
     sync_prefs_->SetLatestRecordTime(last_record_time_stamp);
   }
 
   if (category_name == jslib_const::kBookmarks) {
+    const base::TimeTicks start_time = base::TimeTicks::Now();
     auto records_and_existing_objects =
         std::make_unique<SyncRecordAndExistingList>();
     bookmark_change_processor_->GetAllSyncData(
         *records.get(), records_and_existing_objects.get());
+    UMA_HISTOGRAM_TIMES("Brave.Sync.GetExistingBookmarksTime",
+                        base::TimeTicks::Now() - start_time);
     sync_client_->SendResolveSyncRecords(
         category_name, std::move(records_and_existing_objects));
   } else if (category_name == brave_sync::jslib_const::kPreferences) {
@@ -425,12 +457,32 @@ void BraveSyncServiceImpl::OnResolvedSyncRecords(
     const std::string& category_name,
     std::unique_ptr<RecordsList> records) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT1("sync", "BraveSyncServiceImpl::OnResolvedSyncRecords",
+               "records", records->size());
 
   if (category_name == brave_sync::jslib_const::kPreferences) {
+    const base::TimeTicks start_time = base::TimeTicks::Now();
     OnResolvedPreferences(*records.get());
+    UMA_HISTOGRAM_TIMES("Brave.Sync.ApplyPreferencesTime",
+                        base::TimeTicks::Now() - start_time);
   } else if (category_name == brave_sync::jslib_const::kBookmarks) {
+    // Only the first slice of a large batch is applied here, so this times
+    // that slice. Later slices are applied from posted tasks and aren't part
+    // of this histogram.
+    if (!pending_bookmark_record_times_.empty()) {
+      if (!tools::IsTimeEmpty(pending_bookmark_record_times_.front()))
+        applying_bookmark_record_time_ = pending_bookmark_record_times_.front();
+      pending_bookmark_record_times_.pop_front();
+    }
+    base::TimeTicks start_time = base::TimeTicks::Now();
     bookmark_change_processor_->ApplyChangesFromSyncModel(*records.get());
+    UMA_HISTOGRAM_TIMES("Brave.Sync.ApplyBookmarksTime",
+                        base::TimeTicks::Now() - start_time);
+
+    start_time = base::TimeTicks::Now();
     bookmark_change_processor_->SendUnsynced(unsynced_send_interval_);
+    UMA_HISTOGRAM_TIMES("Brave.Sync.SendUnsyncedTime",
+                        base::TimeTicks::Now() - start_time);
   } else if (category_name == brave_sync::jslib_const::kHistorySites) {
     NOTIMPLEMENTED();
   }
@@ -461,17 +513,26 @@ void BraveSyncServiceImpl::OnResolvedPreferences(const RecordsList& records) {
   bool contains_only_one_device = false;
 
   auto sync_devices = sync_prefs_->GetSyncDevices();
+  std::vector<SyncDevice> changed_devices;
+  std::vector<std::string> deleted_device_ids;
   for (const auto &record : records) {
     DCHECK(record->has_device() || record->has_sitesetting());
     if (record->has_device()) {
       bool actually_merged = false;
-      sync_devices->Merge(
-          SyncDevice(record->GetDevice().name,
+      SyncDevice device(record->GetDevice().name,
           record->objectId,
           record->deviceId,
-          record->syncTimestamp.ToJsTime()),
+          record->syncTimestamp.ToJsTime());
+      sync_devices->Merge(
+          device,
           record->action,
           &actually_merged);
+      if (actually_merged) {
+        if (record->action == jslib::SyncRecord::Action::A_DELETE)
+          deleted_device_ids.push_back(record->deviceId);
+        else
+          changed_devices.push_back(device);
+      }
       this_device_deleted = this_device_deleted ||
         (record->deviceId == this_device_id &&
           record->action == jslib::SyncRecord::Action::A_DELETE &&
@@ -482,7 +543,13 @@ void BraveSyncServiceImpl::OnResolvedPreferences(const RecordsList& records) {
     }
   }  // for each device
 
-  sync_prefs_->SetSyncDevices(*sync_devices);
+  // The device list is only written back when a record changed it
+  if (!changed_devices.empty() || !deleted_device_ids.empty()) {
+    saving_resolved_devices_ = true;
+    sync_prefs_->SetSyncDevices(*sync_devices);
+    saving_resolved_devices_ = false;
+    NotifySyncDevicesChanged(changed_devices, deleted_device_ids);
+  }
 
   if (this_device_deleted) {
     ResetSyncInternal();
@@ -499,6 +566,9 @@ void BraveSyncServiceImpl::OnSyncPrefsChanged(const std::string& pref) {
     sync_client_->OnSyncEnabledChanged();
     if (!sync_prefs_->GetSyncEnabled())
       sync_initialized_ = false;
+  } else if (pref == prefs::kSyncDeviceList && saving_resolved_devices_) {
+    // OnResolvedPreferences notifies the changed devices
+    return;
   }
   NotifySyncStateChanged();
 }
@@ -532,6 +602,7 @@ void BraveSyncServiceImpl::OnSyncWordsPrepared(const std::string& words) {
 // Here we query sync lib for the records after initialization (or again later)
 void BraveSyncServiceImpl::RequestSyncData() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT0("sync", "BraveSyncServiceImpl::RequestSyncData");
 
   const bool bookmarks = sync_prefs_->GetSyncBookmarksEnabled();
   const bool history = sync_prefs_->GetSyncHistoryEnabled();
@@ -625,19 +696,63 @@ void BraveSyncServiceImpl::SendDeviceSyncRecord(
       jslib_const::SyncRecordType_PREFERENCES, *records);
 }
 
+// Polls for records start at the shortest interval, which doubles after each
+// poll that brought no records up to the longest one
 static const int64_t kCheckUpdatesIntervalSec = 60;
+static const int64_t kMaxCheckUpdatesIntervalSec = 16 * 60;
+// Local bookmark changes are sent once the following fetch resolves, so the
+// next poll comes no later than this after one
+static const int64_t kLocalChangeCheckUpdatesDelaySec = 10;
+// Nobody sees changes from other devices while the user is away, so polls
+// are skipped after this long without input
+static const int kIdleThresholdSec = 5 * 60;
 
 void BraveSyncServiceImpl::StartLoop() {
-  timer_->Start(FROM_HERE,
-                  base::TimeDelta::FromSeconds(kCheckUpdatesIntervalSec),
-                  this,
-                  &BraveSyncServiceImpl::LoopProc);
+  poll_interval_ = base::TimeDelta::FromSeconds(kCheckUpdatesIntervalSec);
+  records_fetched_since_poll_ = true;
+  ScheduleNextPoll(poll_interval_);
 }
 
 void BraveSyncServiceImpl::StopLoop() {
   timer_->Stop();
 }
 
+void BraveSyncServiceImpl::ScheduleNextPoll(base::TimeDelta delay) {
+  timer_->Start(FROM_HERE,
+                delay,
+                this,
+                &BraveSyncServiceImpl::LoopProc);
+}
+
+void BraveSyncServiceImpl::UpdatePollInterval() {
+  if (records_fetched_since_poll_) {
+    poll_interval_ = base::TimeDelta::FromSeconds(kCheckUpdatesIntervalSec);
+  } else {
+    poll_interval_ = std::min(poll_interval_ * 2,
+        base::TimeDelta::FromSeconds(kMaxCheckUpdatesIntervalSec));
+  }
+  records_fetched_since_poll_ = false;
+}
+
+void BraveSyncServiceImpl::OnLocalBookmarksChanged() {
+  if (!timer_->IsRunning())
+    return;
+
+  poll_interval_ = base::TimeDelta::FromSeconds(kCheckUpdatesIntervalSec);
+  const base::TimeDelta delay =
+      base::TimeDelta::FromSeconds(kLocalChangeCheckUpdatesDelaySec);
+  if (timer_->desired_run_time() - base::TimeTicks::Now() > delay)
+    ScheduleNextPoll(delay);
+}
+
+void BraveSyncServiceImpl::OnSyncRecordsAvailable() {
+  if (!timer_->IsRunning())
+    return;
+
+  poll_interval_ = base::TimeDelta::FromSeconds(kCheckUpdatesIntervalSec);
+  ScheduleNextPoll(base::TimeDelta());
+}
+
 void BraveSyncServiceImpl::LoopProc() {
   base::CreateSingleThreadTaskRunnerWithTraits(
     {content::BrowserThread::UI})->PostTask(
@@ -649,11 +764,14 @@ void BraveSyncServiceImpl::LoopProc() {
 
 void BraveSyncServiceImpl::LoopProcThreadAligned() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  if (!sync_initialized_) {
+  if (!sync_initialized_ || ui::CalculateIdleTime() >= kIdleThresholdSec) {
+    ScheduleNextPoll(poll_interval_);
     return;
   }
 
+  UpdatePollInterval();
   RequestSyncData();
+  ScheduleNextPoll(poll_interval_);
 }
 
 void BraveSyncServiceImpl::NotifyLogMessage(const std::string& message) {
@@ -672,6 +790,29 @@ void BraveSyncServiceImpl::NotifySyncStateChanged() {
     observer.OnSyncStateChanged(this);
 }
 
+void BraveSyncServiceImpl::NotifySyncDevicesChanged(
+    const std::vector<SyncDevice>& changed_devices,
+    const std::vector<std::string>& deleted_device_ids) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  for (auto& observer : observers_)
+    observer.OnSyncDevicesChanged(this, changed_devices, deleted_device_ids);
+}
+
+void BraveSyncServiceImpl::NotifySyncRecordsApplyProgress(size_t applied,
+                                                          size_t total) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  for (auto& observer : observers_)
+    observer.OnSyncRecordsApplyProgress(this, applied, total);
+}
+
+void BraveSyncServiceImpl::OnBookmarkChangesApplied() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (tools::IsTimeEmpty(applying_bookmark_record_time_))
+    return;
+  sync_prefs_->SetLatestRecordTime(applying_bookmark_record_time_);
+  applying_bookmark_record_time_ = base::Time();
+}
+
 void BraveSyncServiceImpl::NotifyHaveSyncWords(
     const std::string& sync_words) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -681,6 +822,8 @@ void BraveSyncServiceImpl::NotifyHaveSyncWords(
 
 void BraveSyncServiceImpl::ResetSyncInternal() {
   bookmark_change_processor_->Reset(false);
+  pending_bookmark_record_times_.clear();
+  applying_bookmark_record_time_ = base::Time();
 
   sync_prefs_->SetPrevSeed(sync_prefs_->GetSeed());
 
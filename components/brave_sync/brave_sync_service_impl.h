@@ -9,7 +9,9 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/containers/circular_deque.h"
 #include "base/macros.h"
 #include "base/scoped_observer.h"
 #include "base/time/time.h"
@@ -39,11 +41,12 @@ FORWARD_DECLARE_TEST(BraveSyncServiceTest, BackgroundSyncStopped);
 class BraveSyncServiceTest;
 
 namespace base {
-class RepeatingTimer;
+class OneShotTimer;
 }
 
 namespace brave_sync {
 
+class SyncDevice;
 class SyncDevices;
 class Settings;
 class BookmarkChangeProcessor;
@@ -88,6 +91,10 @@ class BraveSyncServiceImpl
 
   BraveSyncClient* GetSyncClient() override;
 
+  // Fetches records now instead of at the next poll, for when the sync
+  // server can tell that new records are waiting.
+  void OnSyncRecordsAvailable();
+
  private:
   FRIEND_TEST_ALL_PREFIXES(::BraveSyncServiceTest, BookmarkAdded);
   FRIEND_TEST_ALL_PREFIXES(::BraveSyncServiceTest, BookmarkDeleted);
@@ -108,6 +115,9 @@ class BraveSyncServiceImpl
   FRIEND_TEST_ALL_PREFIXES(::BraveSyncServiceTest, OnGetExistingObjects);
   FRIEND_TEST_ALL_PREFIXES(::BraveSyncServiceTest, BackgroundSyncStarted);
   FRIEND_TEST_ALL_PREFIXES(::BraveSyncServiceTest, BackgroundSyncStopped);
+  FRIEND_TEST_ALL_PREFIXES(::BraveSyncServiceTest, PollIntervalBacksOff);
+  FRIEND_TEST_ALL_PREFIXES(::BraveSyncServiceTest,
+                           LocalBookmarkChangeBringsPollForward);
   friend class ::BraveSyncServiceTest;
 
   // SyncMessageHandler overrides
@@ -161,6 +171,11 @@ class BraveSyncServiceImpl
   void StopLoop();
   void LoopProc();
   void LoopProcThreadAligned();
+  // Polls are scheduled one at a time, backing off while fetches bring no
+  // records and coming forward after local bookmark changes
+  void ScheduleNextPoll(base::TimeDelta delay);
+  void UpdatePollInterval();
+  void OnLocalBookmarksChanged();
 
   void GetExistingHistoryObjects(
     const RecordsList &records,
@@ -170,6 +185,11 @@ class BraveSyncServiceImpl
   void NotifyLogMessage(const std::string& message);
   void NotifySyncSetupError(const std::string& error);
   void NotifySyncStateChanged();
+  void NotifySyncDevicesChanged(
+      const std::vector<SyncDevice>& changed_devices,
+      const std::vector<std::string>& deleted_device_ids);
+  void NotifySyncRecordsApplyProgress(size_t applied, size_t total);
+  void OnBookmarkChangesApplied();
   void NotifyHaveSyncWords(const std::string& sync_words);
 
   void ResetSyncInternal();
@@ -189,6 +209,10 @@ class BraveSyncServiceImpl
 
   bool reseting_ = false;
 
+  // True while OnResolvedPreferences saves the device list, which notifies
+  // observers of the changed devices rather than of a sync state change
+  bool saving_resolved_devices_ = false;
+
   std::string sync_words_;
 
   std::unique_ptr<brave_sync::Settings> settings_;
@@ -201,7 +225,16 @@ class BraveSyncServiceImpl
   // will be saved on GET_EXISTING_OBJECTS to be sure request was processed
   base::Time last_time_fetch_sent_;
 
-  std::unique_ptr<base::RepeatingTimer> timer_;
+  // Record times of fetched bookmarks not yet passed to the change processor,
+  // and of the last ones that were. The latest record time is only saved once
+  // those are applied, as stopping the processor drops the pending records.
+  base::circular_deque<base::Time> pending_bookmark_record_times_;
+  base::Time applying_bookmark_record_time_;
+
+  std::unique_ptr<base::OneShotTimer> timer_;
+  base::TimeDelta poll_interval_;
+  // Whether any records arrived since the last poll
+  bool records_fetched_since_poll_ = false;
 
   // send unsynced records in batches
   base::TimeDelta unsynced_send_interval_;
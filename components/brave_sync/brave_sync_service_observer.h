@@ -5,9 +5,15 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SYNC_BRAVE_SYNC_SERVICE_OBSERVER_H_
 #define BRAVE_COMPONENTS_BRAVE_SYNC_BRAVE_SYNC_SERVICE_OBSERVER_H_
 
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
 namespace brave_sync {
 
 class BraveSyncService;
+class SyncDevice;
 
 class BraveSyncServiceObserver : public base::CheckedObserver {
  public:
@@ -18,6 +24,17 @@ class BraveSyncServiceObserver : public base::CheckedObserver {
   virtual void OnSyncStateChanged(BraveSyncService* sync_service) {}
   virtual void OnHaveSyncWords(BraveSyncService* sync_service,
                                const std::string& sync_words) {}
+  // Called instead of OnSyncStateChanged when device records from sync only
+  // changed the device list. |changed_devices| were created or updated.
+  virtual void OnSyncDevicesChanged(
+      BraveSyncService* sync_service,
+      const std::vector<SyncDevice>& changed_devices,
+      const std::vector<std::string>& deleted_device_ids) {}
+  // Called while bookmarks from sync are applied in several slices, with the
+  // number of records applied out of those received so far
+  virtual void OnSyncRecordsApplyProgress(BraveSyncService* sync_service,
+                                          size_t applied,
+                                          size_t total) {}
 };
 
 } // namespace brave_sync
@@ -5,6 +5,7 @@
 
 #include "base/files/scoped_temp_dir.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "brave/components/brave_sync/client/bookmark_change_processor.h"
 #include "brave/components/brave_sync/client/brave_sync_client_impl.h"
 #include "brave/components/brave_sync/client/client_ext_impl_data.h"
@@ -107,6 +108,10 @@ class MockBraveSyncServiceObserver : public BraveSyncServiceObserver {
   MOCK_METHOD2(OnSyncSetupError, void(BraveSyncService*, const std::string&));
   MOCK_METHOD1(OnSyncStateChanged, void(BraveSyncService*));
   MOCK_METHOD2(OnHaveSyncWords, void(BraveSyncService*, const std::string&));
+  MOCK_METHOD3(OnSyncDevicesChanged,
+               void(BraveSyncService*,
+                    const std::vector<brave_sync::SyncDevice>&,
+                    const std::vector<std::string>&));
 };
 
 class BraveSyncServiceTest : public testing::Test {
@@ -400,7 +405,8 @@ TEST_F(BraveSyncServiceTest, OnDeleteDevice) {
   records.push_back(SimpleDeviceRecord(
       SyncRecord::Action::A_CREATE,
       "3", "device3"));
-  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(1);
+  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(0);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _)).Times(1);
   sync_service()->OnResolvedPreferences(records);
 
   sync_service()->sync_prefs_->SetThisDeviceId("1");
@@ -425,7 +431,8 @@ TEST_F(BraveSyncServiceTest, OnDeleteDevice) {
   resolved_record2->action = SyncRecord::Action::A_DELETE;
   resolved_records.push_back(std::move(resolved_record2));
 
-  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(1);
+  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(0);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _)).Times(1);
   sync_service()->OnResolvedPreferences(resolved_records);
 
   auto devices_final = sync_service()->sync_prefs_->GetSyncDevices();
@@ -434,6 +441,55 @@ TEST_F(BraveSyncServiceTest, OnDeleteDevice) {
   EXPECT_FALSE(DevicesContains(devices_final.get(), "3", "device3"));
 }
 
+TEST_F(BraveSyncServiceTest, OnResolvedPreferencesNotifiesChangedDevices) {
+  RecordsList records;
+  records.push_back(SimpleDeviceRecord(
+      SyncRecord::Action::A_CREATE,
+      "1", "device1"));
+  records.push_back(SimpleDeviceRecord(
+      SyncRecord::Action::A_CREATE,
+      "2", "device2"));
+  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(0);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _))
+      .WillOnce(testing::Invoke([](
+          BraveSyncService* sync_service,
+          const std::vector<brave_sync::SyncDevice>& changed_devices,
+          const std::vector<std::string>& deleted_device_ids) {
+        ASSERT_EQ(changed_devices.size(), 2u);
+        EXPECT_EQ(changed_devices[0].device_id_, "1");
+        EXPECT_EQ(changed_devices[1].device_id_, "2");
+        EXPECT_TRUE(deleted_device_ids.empty());
+      }));
+  sync_service()->OnResolvedPreferences(records);
+
+  // Records which do not change the list are not notified or saved
+  const std::string device_list = profile()->GetPrefs()->GetString(
+      brave_sync::prefs::kSyncDeviceList);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _))
+      .Times(0);
+  sync_service()->OnResolvedPreferences(records);
+  EXPECT_EQ(profile()->GetPrefs()->GetString(
+      brave_sync::prefs::kSyncDeviceList), device_list);
+
+  RecordsList resolved_records;
+  auto resolved_record = SyncRecord::Clone(*records.at(1));
+  resolved_record->action = SyncRecord::Action::A_DELETE;
+  resolved_records.push_back(std::move(resolved_record));
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _))
+      .WillOnce(testing::Invoke([](
+          BraveSyncService* sync_service,
+          const std::vector<brave_sync::SyncDevice>& changed_devices,
+          const std::vector<std::string>& deleted_device_ids) {
+        EXPECT_TRUE(changed_devices.empty());
+        EXPECT_EQ(deleted_device_ids, std::vector<std::string>({ "2" }));
+      }));
+  sync_service()->OnResolvedPreferences(resolved_records);
+
+  auto devices = sync_service()->sync_prefs_->GetSyncDevices();
+  EXPECT_TRUE(devices->GetByDeviceId("1"));
+  EXPECT_FALSE(devices->GetByDeviceId("2"));
+}
+
 TEST_F(BraveSyncServiceTest, OnDeleteDeviceWhenOneDevice) {
   sync_service()->sync_prefs_->SetThisDeviceId("1");
   RecordsList records;
@@ -443,7 +499,8 @@ TEST_F(BraveSyncServiceTest, OnDeleteDeviceWhenOneDevice) {
   records.push_back(SimpleDeviceRecord(
       SyncRecord::Action::A_CREATE,
       "2", "device2"));
-  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(1);
+  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(0);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _)).Times(1);
   sync_service()->OnResolvedPreferences(records);
 
   auto devices = sync_service()->sync_prefs_->GetSyncDevices();
@@ -458,8 +515,9 @@ TEST_F(BraveSyncServiceTest, OnDeleteDeviceWhenOneDevice) {
   auto resolved_record = SyncRecord::Clone(*records.at(1));
   resolved_record->action = SyncRecord::Action::A_DELETE;
   resolved_records.push_back(std::move(resolved_record));
-  // Expecting to be called one time to set the new devices list
-  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(1);
+  // Expecting the new devices list to be notified once
+  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(0);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _)).Times(1);
 
   EXPECT_CALL(*sync_client(), SendSyncRecords).Times(1);
 
@@ -474,7 +532,8 @@ TEST_F(BraveSyncServiceTest, OnDeleteDeviceWhenOneDevice) {
   auto resolved_record2 = SyncRecord::Clone(*records.at(0));
   resolved_record2->action = SyncRecord::Action::A_DELETE;
   resolved_records2.push_back(std::move(resolved_record2));
-  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(3);
+  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(2);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _)).Times(1);
 
   sync_service()->OnResolvedPreferences(resolved_records2);
 
@@ -493,7 +552,8 @@ TEST_F(BraveSyncServiceTest, OnDeleteDeviceWhenSelfDeleted) {
   records.push_back(SimpleDeviceRecord(
       SyncRecord::Action::A_CREATE,
       "2", "device2"));
-  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(1);
+  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(0);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _)).Times(1);
   sync_service()->OnResolvedPreferences(records);
 
   auto devices = sync_service()->sync_prefs_->GetSyncDevices();
@@ -509,8 +569,9 @@ TEST_F(BraveSyncServiceTest, OnDeleteDeviceWhenSelfDeleted) {
   auto resolved_record = SyncRecord::Clone(*records.at(0));
   resolved_record->action = SyncRecord::Action::A_DELETE;
   resolved_records.push_back(std::move(resolved_record));
-  // If you have to modify .Times(3) to another value, double re-check
-  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(3);
+  // If you have to modify .Times(2) to another value, double re-check
+  EXPECT_CALL(*observer(), OnSyncStateChanged(sync_service())).Times(2);
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _)).Times(1);
   sync_service()->OnResolvedPreferences(resolved_records);
 
   auto devices_final = sync_service()->sync_prefs_->GetSyncDevices();
@@ -524,6 +585,8 @@ TEST_F(BraveSyncServiceTest, OnResetSync) {
   EXPECT_CALL(*sync_client(), OnSyncEnabledChanged).Times(AtLeast(1));
   EXPECT_CALL(*observer(),
       OnSyncStateChanged(sync_service())).Times(AtLeast(3));
+  EXPECT_CALL(*observer(), OnSyncDevicesChanged(sync_service(), _, _))
+      .Times(2);
   sync_service()->OnSetupSyncNewToSync("this_device");
   EXPECT_TRUE(profile()->GetPrefs()->GetBoolean(
        brave_sync::prefs::kSyncEnabled));
@@ -696,6 +759,42 @@ TEST_F(BraveSyncServiceTest, OnGetExistingObjects) {
       false);
 }
 
+TEST_F(BraveSyncServiceTest, LatestRecordTimeSavedOnceBookmarksApplied) {
+  const base::Time record_time = base::Time::Now();
+  sync_service()->OnGetExistingObjects(brave_sync::jslib_const::kBookmarks,
+      std::make_unique<RecordsList>(),
+      record_time,
+      false);
+  // Not saved before the records are applied, so they are fetched again if
+  // the change processor is stopped before then
+  EXPECT_TRUE(profile()->GetPrefs()->GetTime(
+      brave_sync::prefs::kSyncLatestRecordTime).is_null());
+
+  sync_service()->OnResolvedSyncRecords(brave_sync::jslib_const::kBookmarks,
+      std::make_unique<RecordsList>());
+  EXPECT_EQ(profile()->GetPrefs()->GetTime(
+      brave_sync::prefs::kSyncLatestRecordTime), record_time);
+}
+
+TEST_F(BraveSyncServiceTest, RecordsSyncPhaseTimes) {
+  base::HistogramTester histograms;
+
+  sync_service()->OnGetExistingObjects(brave_sync::jslib_const::kBookmarks,
+      std::make_unique<RecordsList>(),
+      base::Time(),
+      false);
+  histograms.ExpectTotalCount("Brave.Sync.GetExistingBookmarksTime", 1);
+
+  sync_service()->OnResolvedSyncRecords(brave_sync::jslib_const::kBookmarks,
+      std::make_unique<RecordsList>());
+  histograms.ExpectTotalCount("Brave.Sync.ApplyBookmarksTime", 1);
+  histograms.ExpectTotalCount("Brave.Sync.SendUnsyncedTime", 1);
+
+  sync_service()->OnResolvedSyncRecords(brave_sync::jslib_const::kPreferences,
+      std::make_unique<RecordsList>());
+  histograms.ExpectTotalCount("Brave.Sync.ApplyPreferencesTime", 1);
+}
+
 TEST_F(BraveSyncServiceTest, BackgroundSyncStarted) {
   sync_service()->BackgroundSyncStarted(false);
   EXPECT_TRUE(sync_service()->timer_->IsRunning());
@@ -705,3 +804,44 @@ TEST_F(BraveSyncServiceTest, BackgroundSyncStopped) {
   sync_service()->BackgroundSyncStopped(false);
   EXPECT_FALSE(sync_service()->timer_->IsRunning());
 }
+
+TEST_F(BraveSyncServiceTest, PollIntervalBacksOff) {
+  sync_service()->BackgroundSyncStarted(false);
+  const base::TimeDelta min_interval = sync_service()->poll_interval_;
+  EXPECT_EQ(sync_service()->timer_->GetCurrentDelay(), min_interval);
+
+  // The startup poll keeps the shortest interval
+  sync_service()->UpdatePollInterval();
+  EXPECT_EQ(sync_service()->poll_interval_, min_interval);
+
+  // Polls without records back off up to the longest interval
+  sync_service()->UpdatePollInterval();
+  EXPECT_EQ(sync_service()->poll_interval_, min_interval * 2);
+  for (int i = 0; i < 10; ++i)
+    sync_service()->UpdatePollInterval();
+  EXPECT_EQ(sync_service()->poll_interval_, min_interval * 16);
+
+  // Records bring polling back to the shortest interval
+  auto records = std::make_unique<RecordsList>();
+  records->push_back(SimpleDeviceRecord(
+      SyncRecord::Action::A_CREATE,
+      "1", "device1"));
+  EXPECT_CALL(*sync_client(), SendResolveSyncRecords).Times(1);
+  sync_service()->OnGetExistingObjects(brave_sync::jslib_const::kPreferences,
+      std::move(records), base::Time(), false);
+  sync_service()->UpdatePollInterval();
+  EXPECT_EQ(sync_service()->poll_interval_, min_interval);
+}
+
+TEST_F(BraveSyncServiceTest, LocalBookmarkChangeBringsPollForward) {
+  sync_service()->BackgroundSyncStarted(false);
+  const base::TimeDelta min_interval = sync_service()->poll_interval_;
+
+  sync_service()->OnLocalBookmarksChanged();
+  EXPECT_TRUE(sync_service()->timer_->IsRunning());
+  EXPECT_LT(sync_service()->timer_->GetCurrentDelay(), min_interval);
+
+  sync_service()->StopLoop();
+  sync_service()->OnLocalBookmarksChanged();
+  EXPECT_FALSE(sync_service()->timer_->IsRunning());
+}
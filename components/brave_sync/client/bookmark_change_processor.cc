@@ -5,13 +5,19 @@
 
 #include "brave/components/brave_sync/client/bookmark_change_processor.h"
 
+#include <algorithm>
 #include <string>
 #include <tuple>
 #include <memory>
+#include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/brave_sync/bookmark_order_util.h"
 #include "brave/components/brave_sync/client/bookmark_node.h"
 #include "brave/components/brave_sync/jslib_const.h"
@@ -31,20 +37,24 @@ using bookmarks::BookmarkModel;
 
 namespace {
 
-class ScopedPauseObserver {
- public:
-  explicit ScopedPauseObserver(brave_sync::BookmarkChangeProcessor* processor) :
-      processor_(processor) {
-    DCHECK_NE(processor_, nullptr);
-    processor_->Stop();
-  }
-  ~ScopedPauseObserver() {
-    processor_->Start();
-  }
+// Orders are migrated synchronously for up to this many nodes, and in chunks
+// of this many nodes otherwise
+const size_t kMigrateOrdersChunkSize = 1000;
 
- private:
-  brave_sync::BookmarkChangeProcessor* processor_;  // Not owned
-};
+// Default time records from sync are applied for before yielding
+constexpr base::TimeDelta kApplyChangesTimeBudget =
+    base::TimeDelta::FromMilliseconds(50);
+
+// Default size of the messages records are sent to the sync library in
+const size_t kSendRecordsTargetBytes = 256 * 1024;
+
+// The sync library takes at most this many records per message
+const size_t kMaxRecordsPerMessage = 1000;
+
+// At most this many messages are sent per call to SendUnsynced. The sync
+// library does not acknowledge sends, so the remaining records wait for the
+// next call, which follows the library resolving the records it fetched
+const size_t kMaxMessagesPerSend = 10;
 
 const char kDeletedBookmarksTitle[] = "Deleted Bookmarks";
 const char kPendingBookmarksTitle[] = "Pending Bookmarks";
@@ -61,6 +71,31 @@ std::unique_ptr<brave_sync::BraveBookmarkPermanentNode>
   return node;
 }
 
+// Approximates the size of |record| once converted to a base::Value and
+// serialized for the sync library, without converting it
+size_t EstimateSyncRecordSize(const brave_sync::jslib::SyncRecord& record) {
+  // Keys, numbers and booleans of a bookmark record
+  const size_t kFixedSize = 512;
+  // Bytes are sent as a list of numbers, e.g. "121, "
+  const size_t kBytesPerIdByte = 5;
+
+  size_t size = kFixedSize +
+      (record.deviceId.size() + record.objectId.size()) * kBytesPerIdByte +
+      record.objectData.size();
+  if (record.has_bookmark()) {
+    const auto& bookmark = record.GetBookmark();
+    size += bookmark.site.location.size() + bookmark.site.title.size() +
+        bookmark.site.customTitle.size() + bookmark.site.favicon.size() +
+        (bookmark.parentFolderObjectId.size() +
+            bookmark.prevObjectId.size()) * kBytesPerIdByte +
+        bookmark.order.size() + bookmark.prevOrder.size() +
+        bookmark.nextOrder.size() + bookmark.parentOrder.size();
+    for (const auto& field : bookmark.fields)
+      size += field.size();
+  }
+  return size;
+}
+
 }  // namespace
 
 namespace brave_sync {
@@ -132,8 +167,24 @@ void GetPrevObjectId(const bookmarks::BookmarkNode* parent,
     prev_node->GetMetaInfo("object_id", prev_object_id);
 }
 
-const bookmarks::BookmarkNode* FindByObjectId(bookmarks::BookmarkModel* model,
-                                        const std::string& object_id) {
+bool IsUnsynced(const bookmarks::BookmarkNode* node) {
+  std::string sync_timestamp;
+  node->GetMetaInfo("sync_timestamp", &sync_timestamp);
+
+  if (sync_timestamp.empty())
+    return true;
+
+  std::string last_updated_time;
+  node->GetMetaInfo("last_updated_time", &last_updated_time);
+
+  return !last_updated_time.empty() &&
+      base::Time::FromJsTime(std::stod(last_updated_time)) >
+      base::Time::FromJsTime(std::stod(sync_timestamp));
+}
+
+const bookmarks::BookmarkNode* FindByObjectIdInTree(
+    bookmarks::BookmarkModel* model,
+    const std::string& object_id) {
   ui::TreeNodeIterator<const bookmarks::BookmarkNode>
       iterator(model->root_node());
   while (iterator.has_next()) {
@@ -147,28 +198,6 @@ const bookmarks::BookmarkNode* FindByObjectId(bookmarks::BookmarkModel* model,
   return nullptr;
 }
 
-uint64_t GetIndexByOrder(const bookmarks::BookmarkNode* root_node,
-                  const std::string& record_order) {
-  int index = 0;
-  while (index < root_node->child_count()) {
-    const bookmarks::BookmarkNode* node = root_node->GetChild(index);
-    std::string node_order;
-    node->GetMetaInfo("order", &node_order);
-
-    if (!node_order.empty() &&
-        brave_sync::CompareOrder(record_order, node_order))
-      return index;
-
-    ++index;
-  }
-  return index;
-}
-
-uint64_t GetIndex(const bookmarks::BookmarkNode* root_node,
-                  const jslib::Bookmark& record) {
-  return GetIndexByOrder(root_node, record.order);
-}
-
 // this should only be called for resolved records we get from the server
 void UpdateNode(bookmarks::BookmarkModel* model,
                 const bookmarks::BookmarkNode* node,
@@ -204,35 +233,27 @@ void UpdateNode(bookmarks::BookmarkModel* model,
   }
 }
 
-const bookmarks::BookmarkNode* FindParent(bookmarks::BookmarkModel* model,
-                                          const jslib::Bookmark& bookmark,
-                                          bookmarks::BookmarkNode*
-                                                            pending_node_root) {
-  auto* parent_node = FindByObjectId(model, bookmark.parentFolderObjectId);
+}  // namespace
 
-  if (!parent_node) {
-    if (!bookmark.parentFolderObjectId.empty()) {
-      return pending_node_root;
-    }
-    if (
-        // this flag is a bit odd, but if the node doesn't have a parent and
-        // hideInToolbar is false, then this bookmark should go in the
-        // toolbar root. We don't care about this flag for records with
-        // a parent id because they will be inserted into the correct
-        // parent folder
-        !bookmark.hideInToolbar ||
-        // mobile generated bookmarks go also in bookmark bar
-        (!bookmark.order.empty() && bookmark.order.at(0) == '2')) {
-      parent_node = model->bookmark_bar_node();
-    } else {
-      parent_node = model->other_node();
-    }
+class BookmarkChangeProcessor::ScopedPauseObserver {
+ public:
+  explicit ScopedPauseObserver(BookmarkChangeProcessor* processor) :
+      processor_(processor) {
+    DCHECK_NE(processor_, nullptr);
+    // Changes made while paused keep the node index current themselves, so
+    // only stop observing rather than calling |Stop|
+    if (processor_->bookmark_model_)
+      processor_->bookmark_model_->RemoveObserver(processor_);
+  }
+  ~ScopedPauseObserver() {
+    processor_->Start();
   }
 
-  return parent_node;
-}
+ private:
+  BookmarkChangeProcessor* processor_;  // Not owned
 
-}  // namespace
+  DISALLOW_COPY_AND_ASSIGN(ScopedPauseObserver);
+};
 
 // static
 BookmarkChangeProcessor* BookmarkChangeProcessor::Create(
@@ -252,7 +273,17 @@ BookmarkChangeProcessor::BookmarkChangeProcessor(
       bookmark_model_(BookmarkModelFactory::GetForBrowserContext(
           Profile::FromBrowserContext(profile))),
       deleted_node_root_(nullptr),
-      pending_node_root_(nullptr) {
+      pending_node_root_(nullptr),
+      node_index_built_(false),
+      is_sending_unsynced_(false),
+      send_records_target_bytes_(kSendRecordsTargetBytes),
+      is_migrating_orders_(false),
+      pending_records_applied_(0),
+      pending_records_total_(0),
+      is_applying_changes_(false),
+      apply_changes_time_budget_(kApplyChangesTimeBudget),
+      send_unsynced_after_apply_(false),
+      weak_ptr_factory_(this) {
   DCHECK(sync_client_);
   DCHECK(sync_prefs);
   DCHECK(bookmark_model_);
@@ -264,28 +295,48 @@ BookmarkChangeProcessor::~BookmarkChangeProcessor() {
 
 void BookmarkChangeProcessor::Start() {
   bookmark_model_->AddObserver(this);
+  if (!node_index_built_ && bookmark_model_->loaded())
+    BuildNodeIndex();
 }
 
 void BookmarkChangeProcessor::Stop() {
   if (bookmark_model_)
     bookmark_model_->RemoveObserver(this);
+  // Changes are not observed while stopped, so the index would go stale
+  ClearNodeIndex();
+  order_keys_.clear();
+  // Removed nodes would not be dropped from a migration in progress either,
+  // so start it again on the next send
+  orders_to_migrate_.clear();
+  is_migrating_orders_ = false;
+  // Records not applied yet are dropped, as sync is stopping
+  pending_records_.clear();
+  pending_records_applied_ = 0;
+  pending_records_total_ = 0;
+  is_applying_changes_ = false;
+  send_unsynced_after_apply_ = false;
+  weak_ptr_factory_.InvalidateWeakPtrs();
 }
 
 void BookmarkChangeProcessor::BookmarkModelLoaded(BookmarkModel* model,
                                                   bool ids_reassigned) {
   // This may be invoked after bookmarks import
   VLOG(1) << __func__;
+  BuildNodeIndex();
 }
 
 void BookmarkChangeProcessor::BookmarkModelBeingDeleted(
     bookmarks::BookmarkModel* model) {
   NOTREACHED();
+  ClearNodeIndex();
   bookmark_model_ = nullptr;
 }
 
 void BookmarkChangeProcessor::BookmarkNodeAdded(BookmarkModel* model,
                                                 const BookmarkNode* parent,
                                                 int index) {
+  AddToNodeIndex(parent->GetChild(index));
+  NotifyLocalChange();
 }
 
 void BookmarkChangeProcessor::OnWillRemoveBookmarks(BookmarkModel* model,
@@ -321,6 +372,8 @@ void BookmarkChangeProcessor::CloneBookmarkNodeForDeleteImpl(
 
   auto* cloned_node_ptr = cloned_node.get();
   parent->Add(std::move(cloned_node), index);
+  // Added without an event, so index the clone here
+  IndexNode(cloned_node_ptr);
   // we call `Changed` here because we don't want to update the order
   BookmarkNodeChanged(bookmark_model_, cloned_node_ptr);
 }
@@ -344,6 +397,9 @@ void BookmarkChangeProcessor::BookmarkNodeRemoved(
   // TODO(bridiver) - should this be in OnWillRemoveBookmarks?
   // copy into the deleted node tree without firing any events
 
+  RemoveFromNodeIndex(node);
+  NotifyLocalChange();
+
   // The node which has not yet been sent, should not be cloned into removed.
   std::string node_object_id;
   node->GetMetaInfo("object_id", &node_object_id);
@@ -363,6 +419,7 @@ void BookmarkChangeProcessor::BookmarkAllUserNodesRemoved(
     const std::set<GURL>& removed_urls) {
   // this only happens on profile deletion and we don't want
   // to wipe out the remote store when that happens
+  BuildNodeIndex();
 }
 
 void BookmarkChangeProcessor::BookmarkNodeChanged(BookmarkModel* model,
@@ -375,6 +432,12 @@ void BookmarkChangeProcessor::BookmarkNodeChanged(BookmarkModel* model,
   model->SetNodeMetaInfo(node,
       "last_updated_time",
       std::to_string(base::Time::Now().ToJsTime()));
+  NotifyLocalChange();
+}
+
+void BookmarkChangeProcessor::NotifyLocalChange() {
+  if (local_change_callback_)
+    local_change_callback_.Run();
 }
 
 void BookmarkChangeProcessor::BookmarkMetaInfoChanged(
@@ -386,7 +449,9 @@ void BookmarkChangeProcessor::BookmarkMetaInfoChanged(
   // Chromium managed: kBookmarkLastVisitDateOnMobileKey,
   //      kBookmarkLastVisitDateOnDesktopKey, kBookmarkDismissedFromNTP,
   //      submitted by private JS API
-  // Not interested in any of these.
+  // Not interested in any of these, other than keeping the node index
+  // current.
+  IndexNode(node);
 }
 
 void BookmarkChangeProcessor::BookmarkNodeMoved(BookmarkModel* model,
@@ -441,9 +506,11 @@ void BookmarkChangeProcessor::Reset(bool clear_meta_info) {
 
   auto* deleted_node = GetDeletedNodeRoot();
   CHECK(deleted_node);
+  RemoveChildrenFromNodeIndex(deleted_node);
   deleted_node->DeleteAll();
   auto* pending_node = GetPendingNodeRoot();
   CHECK(pending_node);
+  RemoveChildrenFromNodeIndex(pending_node);
   pending_node->DeleteAll();
   bookmark_model_->EndExtensiveChanges();
 }
@@ -507,101 +574,382 @@ void ValidateFolderOrders(const bookmarks::BookmarkNode* folder_node) {
 
 void BookmarkChangeProcessor::ApplyChangesFromSyncModel(
     const RecordsList &records) {
-  ScopedPauseObserver pause(this);
-  bookmark_model_->BeginExtensiveChanges();
-  for (const auto& sync_record : records) {
-    DCHECK(sync_record->has_bookmark());
-    DCHECK(!sync_record->objectId.empty());
+  if (records.empty()) {
+    if (!is_applying_changes_ && apply_changes_done_callback_)
+      apply_changes_done_callback_.Run();
+    return;
+  }
 
-    auto* node = FindByObjectId(bookmark_model_, sync_record->objectId);
-    auto bookmark_record = sync_record->GetBookmark();
+  for (const auto& sync_record : records)
+    pending_records_.push_back(jslib::SyncRecord::Clone(*sync_record));
+  pending_records_total_ += records.size();
 
-    if (node && sync_record->action == jslib::SyncRecord::Action::A_UPDATE) {
-      int64_t old_parent_local_id = node->parent()->id();
-      const bookmarks::BookmarkNode* old_parent_node =
-          bookmarks::GetBookmarkNodeByID(bookmark_model_, old_parent_local_id);
+  // Records received while applying are queued behind the ones in progress
+  if (is_applying_changes_)
+    return;
 
-      std::string old_parent_object_id;
-      if (old_parent_node) {
-        old_parent_node->GetMetaInfo("object_id", &old_parent_object_id);
-      }
+  ApplyPendingChanges();
+}
 
-      const bookmarks::BookmarkNode* new_parent_node = nullptr;
-      if (bookmark_record.parentFolderObjectId != old_parent_object_id) {
-        new_parent_node = FindParent(bookmark_model_, bookmark_record,
-            GetPendingNodeRoot());
-      }
+void BookmarkChangeProcessor::ApplyPendingChanges() {
+  TRACE_EVENT1("sync", "BookmarkChangeProcessor::ApplyPendingChanges",
+               "pending", pending_records_.size());
+  const base::TimeTicks deadline =
+      base::TimeTicks::Now() + apply_changes_time_budget_;
+  {
+    ScopedPauseObserver pause(this);
+    bookmark_model_->BeginExtensiveChanges();
+    do {
+      auto sync_record = std::move(pending_records_.front());
+      pending_records_.pop_front();
+      ApplyChange(*sync_record);
+      pending_records_applied_++;
+    } while (!pending_records_.empty() && base::TimeTicks::Now() < deadline);
+    bookmark_model_->EndExtensiveChanges();
+  }
+  order_keys_.clear();
+
+  if (!pending_records_.empty()) {
+    // Yield to the message loop before applying the next slice. Children
+    // that arrive before their folder wait in the pending node root, and are
+    // moved out by CompletePendingNodesMove in whichever slice creates it.
+    is_applying_changes_ = true;
+    if (apply_changes_progress_callback_) {
+      apply_changes_progress_callback_.Run(pending_records_applied_,
+                                           pending_records_total_);
+    }
+    base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+        base::BindOnce(&BookmarkChangeProcessor::ApplyPendingChanges,
+            weak_ptr_factory_.GetWeakPtr()));
+    return;
+  }
+
+  // Progress is only reported for records applied in more than one slice
+  if (is_applying_changes_ && apply_changes_progress_callback_) {
+    apply_changes_progress_callback_.Run(pending_records_applied_,
+                                         pending_records_total_);
+  }
+  is_applying_changes_ = false;
+  pending_records_applied_ = 0;
+  pending_records_total_ = 0;
+
+  if (apply_changes_done_callback_)
+    apply_changes_done_callback_.Run();
+
+  if (send_unsynced_after_apply_) {
+    send_unsynced_after_apply_ = false;
+    SendUnsynced(unsynced_send_interval_after_apply_);
+  }
+}
+
+void BookmarkChangeProcessor::ApplyChange(
+    const jslib::SyncRecord& sync_record) {
+  DCHECK(sync_record.has_bookmark());
+  DCHECK(!sync_record.objectId.empty());
+
+  auto* node = FindByObjectId(sync_record.objectId);
+  auto bookmark_record = sync_record.GetBookmark();
+
+  if (node && sync_record.action == jslib::SyncRecord::Action::A_UPDATE) {
+    int64_t old_parent_local_id = node->parent()->id();
+    const bookmarks::BookmarkNode* old_parent_node =
+        bookmarks::GetBookmarkNodeByID(bookmark_model_, old_parent_local_id);
+
+    std::string old_parent_object_id;
+    if (old_parent_node) {
+      old_parent_node->GetMetaInfo("object_id", &old_parent_object_id);
+    }
+
+    const bookmarks::BookmarkNode* new_parent_node = nullptr;
+    if (bookmark_record.parentFolderObjectId != old_parent_object_id) {
+      new_parent_node = FindParent(bookmark_record, GetPendingNodeRoot());
+    }
 
-      if (new_parent_node) {
-        DCHECK(!bookmark_record.order.empty());
-        int64_t index = GetIndex(new_parent_node, bookmark_record);
-        bookmark_model_->Move(node, new_parent_node, index);
-      } else if (!bookmark_record.order.empty()) {
-        std::string order;
-        node->GetMetaInfo("order", &order);
-        DCHECK(!order.empty());
-        if (bookmark_record.order != order) {
-          int64_t index = GetIndex(node->parent(), bookmark_record);
-          bookmark_model_->Move(node, node->parent(), index);
-        }
+    if (new_parent_node) {
+      DCHECK(!bookmark_record.order.empty());
+      int64_t index = GetIndexByOrder(new_parent_node, bookmark_record.order);
+      bookmark_model_->Move(node, new_parent_node, index);
+    } else if (!bookmark_record.order.empty()) {
+      std::string order;
+      node->GetMetaInfo("order", &order);
+      DCHECK(!order.empty());
+      if (bookmark_record.order != order) {
+        int64_t index = GetIndexByOrder(node->parent(),
+            bookmark_record.order);
+        bookmark_model_->Move(node, node->parent(), index);
       }
-      UpdateNode(bookmark_model_, node, sync_record.get());
-    } else if (node &&
-               sync_record->action == jslib::SyncRecord::Action::A_DELETE) {
-      if (node->parent() == GetDeletedNodeRoot()) {
-        // this is a deleted node so remove without firing events
-        int index = GetDeletedNodeRoot()->GetIndexOf(node);
-        GetDeletedNodeRoot()->Remove(index);
+    }
+    UpdateNode(bookmark_model_, node, &sync_record);
+    IndexNode(node);
+  } else if (node &&
+             sync_record.action == jslib::SyncRecord::Action::A_DELETE) {
+    // Removed without firing events, so drop the node from the index here
+    RemoveFromNodeIndex(node);
+    if (node->parent() == GetDeletedNodeRoot()) {
+      // this is a deleted node so remove without firing events
+      int index = GetDeletedNodeRoot()->GetIndexOf(node);
+      GetDeletedNodeRoot()->Remove(index);
+    } else {
+      // normal remove
+      if (node->is_folder()) {
+        DeleteSelfAndChildren(node);
       } else {
-        // normal remove
-        if (node->is_folder()) {
-          DeleteSelfAndChildren(node);
-        } else {
-          bookmark_model_->Remove(node);
-        }
+        bookmark_model_->Remove(node);
       }
-    } else if (sync_record->action == jslib::SyncRecord::Action::A_CREATE) {
-      bool folder_was_created = false;
-      const bookmarks::BookmarkNode* parent_node = nullptr;
-      if (!node) {
-        // TODO(bridiver) make sure there isn't an existing record for objectId
-        parent_node =
-            FindParent(bookmark_model_, bookmark_record, GetPendingNodeRoot());
-
-        const BookmarkNode* bookmark_bar = bookmark_model_->bookmark_bar_node();
-        bool bookmark_bar_was_empty = bookmark_bar->empty();
-
-        if (bookmark_record.isFolder) {
-          node = bookmark_model_->AddFolder(
-                          parent_node,
-                          GetIndex(parent_node, bookmark_record),
-                          base::UTF8ToUTF16(bookmark_record.site.title));
-          folder_was_created = true;
-        } else {
-          node = bookmark_model_->AddURL(parent_node,
-                          GetIndex(parent_node, bookmark_record),
-                          base::UTF8ToUTF16(bookmark_record.site.title),
-                          GURL(bookmark_record.site.location));
-        }
-        if (bookmark_bar_was_empty)
-          profile_->GetPrefs()->SetBoolean(bookmarks::prefs::kShowBookmarkBar,
-                                          true);
+    }
+  } else if (sync_record.action == jslib::SyncRecord::Action::A_CREATE) {
+    bool folder_was_created = false;
+    const bookmarks::BookmarkNode* parent_node = nullptr;
+    if (!node) {
+      // TODO(bridiver) make sure there isn't an existing record for objectId
+      parent_node = FindParent(bookmark_record, GetPendingNodeRoot());
+
+      const BookmarkNode* bookmark_bar = bookmark_model_->bookmark_bar_node();
+      bool bookmark_bar_was_empty = bookmark_bar->empty();
+
+      if (bookmark_record.isFolder) {
+        node = bookmark_model_->AddFolder(
+                        parent_node,
+                        GetIndexByOrder(parent_node, bookmark_record.order),
+                        base::UTF8ToUTF16(bookmark_record.site.title));
+        folder_was_created = true;
+      } else {
+        node = bookmark_model_->AddURL(parent_node,
+                        GetIndexByOrder(parent_node, bookmark_record.order),
+                        base::UTF8ToUTF16(bookmark_record.site.title),
+                        GURL(bookmark_record.site.location));
       }
-      UpdateNode(bookmark_model_, node, sync_record.get(),
-          GetPendingNodeRoot());
+      if (bookmark_bar_was_empty)
+        profile_->GetPrefs()->SetBoolean(bookmarks::prefs::kShowBookmarkBar,
+                                        true);
+    }
+    UpdateNode(bookmark_model_, node, &sync_record,
+        GetPendingNodeRoot());
+    IndexNode(node);
 
 #ifndef NDEBUG
-      if (parent_node) {
-        ValidateFolderOrders(parent_node);
-      }
+    if (parent_node) {
+      ValidateFolderOrders(parent_node);
+    }
 #endif
 
-      if (folder_was_created) {
-        CompletePendingNodesMove(node, sync_record->objectId);
-      }
+    if (folder_was_created) {
+      CompletePendingNodesMove(node, sync_record.objectId);
     }
   }
-  bookmark_model_->EndExtensiveChanges();
+}
+
+const bookmarks::BookmarkNode* BookmarkChangeProcessor::FindParent(
+    const jslib::Bookmark& bookmark,
+    bookmarks::BookmarkNode* pending_node_root) {
+  auto* parent_node = FindByObjectId(bookmark.parentFolderObjectId);
+
+  if (!parent_node) {
+    if (!bookmark.parentFolderObjectId.empty()) {
+      return pending_node_root;
+    }
+    if (
+        // this flag is a bit odd, but if the node doesn't have a parent and
+        // hideInToolbar is false, then this bookmark should go in the
+        // toolbar root. We don't care about this flag for records with
+        // a parent id because they will be inserted into the correct
+        // parent folder
+        !bookmark.hideInToolbar ||
+        // mobile generated bookmarks go also in bookmark bar
+        (!bookmark.order.empty() && bookmark.order.at(0) == '2')) {
+      parent_node = bookmark_model_->bookmark_bar_node();
+    } else {
+      parent_node = bookmark_model_->other_node();
+    }
+  }
+
+  return parent_node;
+}
+
+const std::vector<int>* BookmarkChangeProcessor::GetOrderKey(
+    const bookmarks::BookmarkNode* node) {
+  const auto* meta_info_map = node->GetMetaInfoMap();
+  if (!meta_info_map)
+    return nullptr;
+
+  auto it = meta_info_map->find("order");
+  if (it == meta_info_map->end() || it->second.empty())
+    return nullptr;
+
+  // The cached key is checked against the order, so it is never stale even
+  // if the order changed or the node was replaced
+  auto& order_key = order_keys_[node];
+  if (order_key.order != it->second) {
+    order_key.order = it->second;
+    order_key.key = OrderToIntVect(order_key.order);
+  }
+
+  return &order_key.key;
+}
+
+uint64_t BookmarkChangeProcessor::GetIndexByOrder(
+    const bookmarks::BookmarkNode* root_node,
+    const std::string& record_order) {
+  // Returns the index of the first child ordered after the record. Children
+  // are kept sorted by order, so binary search over them, skipping children
+  // which have no order yet.
+  const std::vector<int> record_key = OrderToIntVect(record_order);
+
+  int index = root_node->child_count();
+  int begin = 0;
+  int end = root_node->child_count();
+  while (begin < end) {
+    int middle = begin + (end - begin) / 2;
+
+    const std::vector<int>* key = nullptr;
+    int ordered = middle;
+    for (; ordered < end; ++ordered) {
+      key = GetOrderKey(root_node->GetChild(ordered));
+      if (key)
+        break;
+    }
+
+    if (ordered == end) {
+      end = middle;
+      continue;
+    }
+
+    if (std::lexicographical_compare(record_key.begin(), record_key.end(),
+        key->begin(), key->end())) {
+      index = ordered;
+      end = middle;
+    } else {
+      begin = ordered + 1;
+    }
+  }
+
+  return index;
+}
+
+const bookmarks::BookmarkNode* BookmarkChangeProcessor::FindByObjectId(
+    const std::string& object_id) {
+  if (!node_index_built_ || duplicate_object_ids_.count(object_id))
+    return FindByObjectIdInTree(bookmark_model_, object_id);
+
+  auto it = nodes_by_object_id_.find(object_id);
+  if (it == nodes_by_object_id_.end())
+    return nullptr;
+
+  return it->second;
+}
+
+void BookmarkChangeProcessor::BuildNodeIndex() {
+  nodes_by_object_id_.clear();
+  object_ids_by_node_.clear();
+  duplicate_object_ids_.clear();
+  unsynced_nodes_.clear();
+
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode>
+      iterator(bookmark_model_->root_node());
+  while (iterator.has_next()) {
+    const bookmarks::BookmarkNode* node = iterator.Next();
+    if (!node->is_permanent_node() && IsUnsynced(node))
+      unsynced_nodes_.insert(node);
+
+    std::string object_id;
+    node->GetMetaInfo("object_id", &object_id);
+    if (object_id.empty())
+      continue;
+
+    if (nodes_by_object_id_.insert({object_id, node}).second) {
+      object_ids_by_node_[node] = object_id;
+    } else {
+      duplicate_object_ids_.insert(object_id);
+    }
+  }
+
+  node_index_built_ = true;
+}
+
+void BookmarkChangeProcessor::ClearNodeIndex() {
+  nodes_by_object_id_.clear();
+  object_ids_by_node_.clear();
+  duplicate_object_ids_.clear();
+  unsynced_nodes_.clear();
+  node_index_built_ = false;
+}
+
+void BookmarkChangeProcessor::IndexNode(
+    const bookmarks::BookmarkNode* node) {
+  if (!node_index_built_)
+    return;
+
+  // Every change to a node which matters to sync also changes its meta info,
+  // so this is where nodes become unsynced and, once acknowledged, synced
+  if (!node->is_permanent_node() && IsUnsynced(node)) {
+    unsynced_nodes_.insert(node);
+  } else {
+    unsynced_nodes_.erase(node);
+  }
+
+  std::string object_id;
+  node->GetMetaInfo("object_id", &object_id);
+
+  auto it = object_ids_by_node_.find(node);
+  if (it != object_ids_by_node_.end()) {
+    if (it->second == object_id)
+      return;
+
+    nodes_by_object_id_.erase(it->second);
+    object_ids_by_node_.erase(it);
+  }
+
+  if (object_id.empty())
+    return;
+
+  if (!nodes_by_object_id_.insert({object_id, node}).second) {
+    duplicate_object_ids_.insert(object_id);
+    return;
+  }
+  object_ids_by_node_[node] = object_id;
+}
+
+void BookmarkChangeProcessor::AddToNodeIndex(
+    const bookmarks::BookmarkNode* node) {
+  if (!node_index_built_)
+    return;
+
+  IndexNode(node);
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(node);
+  while (iterator.has_next())
+    IndexNode(iterator.Next());
+}
+
+void BookmarkChangeProcessor::RemoveFromNodeIndex(
+    const bookmarks::BookmarkNode* node) {
+  if (!node_index_built_ && orders_to_migrate_.empty())
+    return;
+
+  UnindexNode(node);
+  RemoveChildrenFromNodeIndex(node);
+}
+
+void BookmarkChangeProcessor::RemoveChildrenFromNodeIndex(
+    const bookmarks::BookmarkNode* node) {
+  if (!node_index_built_ && orders_to_migrate_.empty())
+    return;
+
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(node);
+  while (iterator.has_next())
+    UnindexNode(iterator.Next());
+}
+
+void BookmarkChangeProcessor::UnindexNode(
+    const bookmarks::BookmarkNode* node) {
+  unsynced_nodes_.erase(node);
+  orders_to_migrate_.erase(node);
+
+  auto it = object_ids_by_node_.find(node);
+  if (it == object_ids_by_node_.end())
+    return;
+
+  nodes_by_object_id_.erase(it->second);
+  object_ids_by_node_.erase(it);
 }
 
 void BookmarkChangeProcessor::CompletePendingNodesMove(
@@ -745,7 +1093,14 @@ BookmarkChangeProcessor::BookmarkNodeToSyncBookmark(
   if (record->objectId.empty()) {
     record->objectId = tools::GenerateObjectId();
     record->action = jslib::SyncRecord::Action::A_CREATE;
-    bookmark_model_->SetNodeMetaInfo(node, "object_id", record->objectId);
+    if (is_sending_unsynced_) {
+      // Saved along with the send bookkeeping, see |SendUnsynced|
+      const_cast<bookmarks::BookmarkNode*>(node)->SetMetaInfo("object_id",
+          record->objectId);
+      IndexNode(node);
+    } else {
+      bookmark_model_->SetNodeMetaInfo(node, "object_id", record->objectId);
+    }
   } else if (node->HasAncestor(deleted_node)) {
     record->action = jslib::SyncRecord::Action::A_DELETE;
   } else {
@@ -758,28 +1113,15 @@ BookmarkChangeProcessor::BookmarkNodeToSyncBookmark(
   return record;
 }
 
-bool IsUnsynced(const bookmarks::BookmarkNode* node) {
-  std::string sync_timestamp;
-  node->GetMetaInfo("sync_timestamp", &sync_timestamp);
-
-  if (sync_timestamp.empty())
-    return true;
-
-  std::string last_updated_time;
-  node->GetMetaInfo("last_updated_time", &last_updated_time);
-
-  return !last_updated_time.empty() &&
-      base::Time::FromJsTime(std::stod(last_updated_time)) >
-      base::Time::FromJsTime(std::stod(sync_timestamp));
-}
-
 void BookmarkChangeProcessor::GetAllSyncData(
     const std::vector<std::unique_ptr<jslib::SyncRecord>>& records,
     SyncRecordAndExistingList* records_and_existing_objects) {
+  TRACE_EVENT1("sync", "BookmarkChangeProcessor::GetAllSyncData",
+               "records", records.size());
   for (const auto& record : records) {
     auto resolved_record = std::make_unique<SyncRecordAndExisting>();
     resolved_record->first = jslib::SyncRecord::Clone(*record);
-    auto* node = FindByObjectId(bookmark_model_, record->objectId);
+    auto* node = FindByObjectId(record->objectId);
     if (node) {
       resolved_record->second = BookmarkNodeToSyncBookmark(node);
     }
@@ -861,8 +1203,8 @@ int BookmarkChangeProcessor::FindMigrateSubOrderLength(
   return pos3;
 }
 
-void BookmarkChangeProcessor::MigrateOrdersForPermanentNode(
-    bookmarks::BookmarkNode* permanent_node) {
+void BookmarkChangeProcessor::CollectOrdersToMigrate(
+    const bookmarks::BookmarkNode* permanent_node) {
 
   //                         Before              After
   // bookmarks_bar child     "order":"1.0.0.1"   "order":"1.0.1.1"
@@ -876,43 +1218,149 @@ void BookmarkChangeProcessor::MigrateOrdersForPermanentNode(
   std::string perm_new_order = sync_prefs_->GetBookmarksBaseOrder() +
       std::to_string(permanent_node_index);
 
-  ui::TreeNodeIterator<bookmarks::BookmarkNode>
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode>
       iterator(permanent_node);
   while (iterator.has_next()) {
-    bookmarks::BookmarkNode* node = iterator.Next();
+    const bookmarks::BookmarkNode* node = iterator.Next();
 
     std::string old_node_order;
     if (node->GetMetaInfo("order", &old_node_order)
                                                    && !old_node_order.empty()) {
-      int old_suborder_length = FindMigrateSubOrderLength(old_node_order);
-      if (old_suborder_length == -1) {
+      if (FindMigrateSubOrderLength(old_node_order) == -1) {
         continue;
       }
 
-      std::string new_node_order = perm_new_order +
-          old_node_order.substr(old_suborder_length);
-
-      node->SetMetaInfo("order", new_node_order);
-      BookmarkNodeChanged(bookmark_model_, node);
+      orders_to_migrate_[node] = perm_new_order;
     }
   }
 }
 
-void BookmarkChangeProcessor::MigrateOrders() {
-  if (sync_prefs_->GetMigratedBookmarksVersion() >= 1) {
+void BookmarkChangeProcessor::MigrateOrder(
+    const bookmarks::BookmarkNode* node,
+    const std::string& perm_new_order) {
+  // The order is read again, as sync may have changed it since it was
+  // collected
+  std::string old_node_order;
+  if (!node->GetMetaInfo("order", &old_node_order) || old_node_order.empty())
+    return;
+
+  int old_suborder_length = FindMigrateSubOrderLength(old_node_order);
+  if (old_suborder_length == -1) {
     return;
   }
+
+  std::string new_node_order = perm_new_order +
+      old_node_order.substr(old_suborder_length);
+
+  const_cast<bookmarks::BookmarkNode*>(node)->SetMetaInfo("order",
+      new_node_order);
+  BookmarkNodeChanged(bookmark_model_, node);
+}
+
+bool BookmarkChangeProcessor::MigrateOrders() {
+  if (sync_prefs_->GetMigratedBookmarksVersion() >= 1) {
+    return true;
+  }
+
+  if (is_migrating_orders_) {
+    return false;
+  }
+
+  orders_to_migrate_.clear();
   for (const auto* node : { bookmark_model_->bookmark_bar_node(),
                             bookmark_model_->other_node() }) {
-    MigrateOrdersForPermanentNode(const_cast<bookmarks::BookmarkNode*>(node));
+    CollectOrdersToMigrate(node);
+  }
+
+  if (orders_to_migrate_.size() <= kMigrateOrdersChunkSize) {
+    MigrateOrdersChunk();
+    return true;
+  }
+
+  // Migrate large trees a chunk at a time so that the UI thread is not blocked
+  is_migrating_orders_ = true;
+  base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+      base::BindOnce(&BookmarkChangeProcessor::MigrateOrdersChunk,
+          weak_ptr_factory_.GetWeakPtr()));
+  return false;
+}
+
+void BookmarkChangeProcessor::MigrateOrdersChunk() {
+  TRACE_EVENT1("sync", "BookmarkChangeProcessor::MigrateOrdersChunk",
+               "remaining", orders_to_migrate_.size());
+  size_t count = 0;
+  while (!orders_to_migrate_.empty() && count < kMigrateOrdersChunkSize) {
+    auto it = orders_to_migrate_.begin();
+    MigrateOrder(it->first, it->second);
+    orders_to_migrate_.erase(it);
+    count++;
+  }
+
+  if (!orders_to_migrate_.empty()) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+        base::BindOnce(&BookmarkChangeProcessor::MigrateOrdersChunk,
+            weak_ptr_factory_.GetWeakPtr()));
+    return;
   }
 
+  is_migrating_orders_ = false;
   sync_prefs_->SetMigratedBookmarksVersion(1);
 }
 
+std::vector<const bookmarks::BookmarkNode*>
+BookmarkChangeProcessor::GetUnsyncedNodesInTreeOrder(
+    const std::vector<const bookmarks::BookmarkNode*>& root_nodes) const {
+  // Nodes are sent in the same order as walking |root_nodes|, so that a folder
+  // is given an object id before its children are sent. Mark the ancestors of
+  // the unsynced nodes, then walk the tree once in that order, only going into
+  // the folders which lead to an unsynced node.
+  std::set<const bookmarks::BookmarkNode*> marked_nodes;
+  for (const auto* node : unsynced_nodes_) {
+    const bookmarks::BookmarkNode* ancestor = node;
+    while (ancestor && marked_nodes.insert(ancestor).second)
+      ancestor = ancestor->parent();
+  }
+
+  std::vector<const bookmarks::BookmarkNode*> sorted_nodes;
+  std::vector<const bookmarks::BookmarkNode*> stack;
+  for (const auto* root_node : root_nodes) {
+    if (!marked_nodes.count(root_node))
+      continue;
+
+    stack.push_back(root_node);
+    while (!stack.empty()) {
+      const bookmarks::BookmarkNode* node = stack.back();
+      stack.pop_back();
+      if (node != root_node && unsynced_nodes_.count(node))
+        sorted_nodes.push_back(node);
+
+      // Push the last child first so that children are visited in order
+      for (int i = node->child_count() - 1; i >= 0; --i) {
+        const bookmarks::BookmarkNode* child = node->GetChild(i);
+        if (marked_nodes.count(child))
+          stack.push_back(child);
+      }
+    }
+  }
+
+  return sorted_nodes;
+}
+
 void BookmarkChangeProcessor::SendUnsynced(
     base::TimeDelta unsynced_send_interval) {
-  MigrateOrders();
+  TRACE_EVENT0("sync", "BookmarkChangeProcessor::SendUnsynced");
+  if (is_applying_changes_) {
+    // Sent once the records from sync have been applied, so that local
+    // changes are not sent against a partially applied model
+    send_unsynced_after_apply_ = true;
+    unsynced_send_interval_after_apply_ = unsynced_send_interval;
+    return;
+  }
+
+  if (!MigrateOrders()) {
+    // Records are sent once the orders have been migrated
+    return;
+  }
 
   std::vector<std::unique_ptr<jslib::SyncRecord>> records;
 
@@ -924,44 +1372,85 @@ void BookmarkChangeProcessor::SendUnsynced(
     deleted_node
   };
 
-  for (const auto* root_node : root_nodes) {
-    ui::TreeNodeIterator<const bookmarks::BookmarkNode>
-        iterator(root_node);
-    while (iterator.has_next()) {
-      const bookmarks::BookmarkNode* node = iterator.Next();
+  // Send bookkeeping is written to the nodes directly, so that observers are
+  // not notified and a save is not scheduled for every node sent. Only the
+  // last node sent is updated through the model, which notifies once and
+  // schedules a single save of the whole tree, including the other nodes.
+  const std::string send_time = std::to_string(base::Time::Now().ToJsTime());
+  const bookmarks::BookmarkNode* last_sent_node = nullptr;
+  is_sending_unsynced_ = true;
+
+  size_t records_size = 0;
+  size_t messages_sent = 0;
+  auto send_records = [&]() {
+    sync_client_->SendSyncRecords(
+        jslib_const::SyncRecordType_BOOKMARKS, records);
+    records.clear();
+    records_size = 0;
+    messages_sent++;
+  };
 
-      // only send unsynced records
-      if (!IsUnsynced(node))
-        continue;
+  auto send_node = [&](const bookmarks::BookmarkNode* node) {
+    // the remaining nodes are sent by the next call
+    if (messages_sent == kMaxMessagesPerSend)
+      return;
 
-      std::string last_send_time;
-      node->GetMetaInfo("last_send_time", &last_send_time);
-      if (!last_send_time.empty() &&
-          // don't send more often than unsynced_send_interval_
-          (base::Time::Now() -
-              base::Time::FromJsTime(std::stod(last_send_time))) <
-          unsynced_send_interval)
-        continue;
+    // only send unsynced records
+    if (!IsUnsynced(node))
+      return;
 
-      bookmark_model_->SetNodeMetaInfo(node,
-          "last_send_time", std::to_string(base::Time::Now().ToJsTime()));
+    std::string last_send_time;
+    node->GetMetaInfo("last_send_time", &last_send_time);
+    if (!last_send_time.empty() &&
+        // don't send more often than unsynced_send_interval_
+        (base::Time::Now() -
+            base::Time::FromJsTime(std::stod(last_send_time))) <
+        unsynced_send_interval)
+      return;
 
-      auto record = BookmarkNodeToSyncBookmark(node);
-      if (record)
-        records.push_back(std::move(record));
+    auto record = BookmarkNodeToSyncBookmark(node);
+    size_t record_size = record ? EstimateSyncRecordSize(*record) : 0;
+    if (record && !records.empty() &&
+        (records_size + record_size > send_records_target_bytes_ ||
+            records.size() == kMaxRecordsPerMessage)) {
+      send_records();
+      if (messages_sent == kMaxMessagesPerSend)
+        return;
+    }
 
-      if (records.size() == 1000) {
-        sync_client_->SendSyncRecords(
-            jslib_const::SyncRecordType_BOOKMARKS, records);
-        records.clear();
-      }
+    if (last_sent_node) {
+      const_cast<bookmarks::BookmarkNode*>(last_sent_node)->SetMetaInfo(
+          "last_send_time", send_time);
+    }
+    last_sent_node = node;
+
+    if (record) {
+      records.push_back(std::move(record));
+      records_size += record_size;
+    }
+  };
+
+  if (node_index_built_) {
+    // Only the nodes known to be unsynced need to be looked at
+    for (const auto* node : GetUnsyncedNodesInTreeOrder(root_nodes))
+      send_node(node);
+  } else {
+    for (const auto* root_node : root_nodes) {
+      ui::TreeNodeIterator<const bookmarks::BookmarkNode>
+          iterator(root_node);
+      while (iterator.has_next())
+        send_node(iterator.Next());
     }
   }
-  if (!records.empty()) {
-    sync_client_->SendSyncRecords(
-      jslib_const::SyncRecordType_BOOKMARKS, records);
-    records.clear();
+
+  is_sending_unsynced_ = false;
+  if (last_sent_node) {
+    bookmark_model_->SetNodeMetaInfo(last_sent_node,
+        "last_send_time", send_time);
   }
+
+  if (!records.empty())
+    send_records();
   sync_client_->ClearOrderMap();
 }
 
@@ -970,7 +1459,7 @@ void BookmarkChangeProcessor::InitialSync() {}
 void BookmarkChangeProcessor::ApplyOrder(const std::string& object_id,
                                          const std::string& order) {
   ScopedPauseObserver pause(this);
-  auto* node = FindByObjectId(bookmark_model_, object_id);
+  auto* node = FindByObjectId(object_id);
   if (node) {
     bookmark_model_->SetNodeMetaInfo(node, "order", order);
   }
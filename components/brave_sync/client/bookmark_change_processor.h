@@ -6,13 +6,19 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SYNC_CLIENT_BOOKMARK_CHANGE_PROCESSOR_H_
 #define BRAVE_COMPONENTS_BRAVE_SYNC_CLIENT_BOOKMARK_CHANGE_PROCESSOR_H_
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/compiler_specific.h"
+#include "base/containers/circular_deque.h"
 #include "base/macros.h"
+#include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "brave/components/brave_sync/brave_sync_prefs.h"
 #include "brave/components/brave_sync/client/brave_sync_client.h"
@@ -26,9 +32,14 @@ FORWARD_DECLARE_TEST(BraveBookmarkChangeProcessorTest,
     MigrateOrdersForPermanentNodes);
 
 class BraveBookmarkChangeProcessorTest;
+class BraveSyncPerfTest;
 
 namespace brave_sync {
 
+namespace jslib {
+class Bookmark;
+}  // namespace jslib
+
 class BookmarkChangeProcessor : public ChangeProcessor,
                                        bookmarks::BookmarkModelObserver  {
  public:
@@ -51,13 +62,48 @@ class BookmarkChangeProcessor : public ChangeProcessor,
 
   void ApplyOrder(const std::string& object_id, const std::string& order);
 
+  // Records are sent to the sync library in messages of roughly this many
+  // serialized bytes
+  void set_send_records_target_bytes(size_t target_bytes) {
+    send_records_target_bytes_ = target_bytes;
+  }
+
+  // Records from sync are applied in slices of about this long, yielding to
+  // the message loop in between
+  void set_apply_changes_time_budget(base::TimeDelta time_budget) {
+    apply_changes_time_budget_ = time_budget;
+  }
+
+  // Run with the number of records applied and received so far while records
+  // from sync are applied over several slices, and once they all are
+  using ApplyChangesProgressCallback =
+      base::RepeatingCallback<void(size_t applied, size_t total)>;
+  void set_apply_changes_progress_callback(
+      const ApplyChangesProgressCallback& callback) {
+    apply_changes_progress_callback_ = callback;
+  }
+
+  // Run once every record from sync received so far has been applied
+  void set_apply_changes_done_callback(const base::RepeatingClosure& callback) {
+    apply_changes_done_callback_ = callback;
+  }
+
+  // Run when the user adds, changes, moves or removes a bookmark, so the
+  // change can be sent without waiting for the next regular fetch
+  void set_local_change_callback(const base::RepeatingClosure& callback) {
+    local_change_callback_ = callback;
+  }
+
  private:
   friend class ::BraveBookmarkChangeProcessorTest;
+  friend class ::BraveSyncPerfTest;
   FRIEND_TEST_ALL_PREFIXES(::BraveBookmarkChangeProcessorTest,
                                                        IgnoreRapidCreateDelete);
   FRIEND_TEST_ALL_PREFIXES(::BraveBookmarkChangeProcessorTest,
                                                 MigrateOrdersForPermanentNodes);
 
+  class ScopedPauseObserver;
+
   BookmarkChangeProcessor(Profile* profile,
                           BraveSyncClient* sync_client,
                           prefs::Prefs* sync_prefs);
@@ -95,6 +141,8 @@ class BookmarkChangeProcessor : public ChangeProcessor,
       bookmarks::BookmarkModel* model,
       const bookmarks::BookmarkNode* node) override;
 
+  void NotifyLocalChange();
+
   std::unique_ptr<jslib::SyncRecord> BookmarkNodeToSyncBookmark(
       const bookmarks::BookmarkNode* node);
   bookmarks::BookmarkNode* GetDeletedNodeRoot();
@@ -111,12 +159,46 @@ class BookmarkChangeProcessor : public ChangeProcessor,
   // "Other Bookmarks" so we need to explicitly delete children
   void DeleteSelfAndChildren(const bookmarks::BookmarkNode* node);
 
+  void ApplyPendingChanges();
+  void ApplyChange(const jslib::SyncRecord& sync_record);
+
   void CompletePendingNodesMove(
       const bookmarks::BookmarkNode* created_folder_node,
       const std::string& created_folder_object_id);
 
-  void MigrateOrders();
-  void MigrateOrdersForPermanentNode(bookmarks::BookmarkNode* perm_node);
+  const bookmarks::BookmarkNode* FindParent(
+      const jslib::Bookmark& bookmark,
+      bookmarks::BookmarkNode* pending_node_root);
+
+  // Nodes are indexed by their "object_id" meta info so that sync records can
+  // be matched to nodes without walking the tree, and unsynced nodes are
+  // tracked so that |SendUnsynced| only looks at those. The index is kept
+  // current through the observer while started, and by the changes applied
+  // from sync which are made while observing is paused. It is only built
+  // while started, otherwise the tree is walked.
+  const bookmarks::BookmarkNode* FindByObjectId(const std::string& object_id);
+  void BuildNodeIndex();
+  void ClearNodeIndex();
+  void IndexNode(const bookmarks::BookmarkNode* node);
+  void UnindexNode(const bookmarks::BookmarkNode* node);
+  void AddToNodeIndex(const bookmarks::BookmarkNode* node);
+  void RemoveFromNodeIndex(const bookmarks::BookmarkNode* node);
+  void RemoveChildrenFromNodeIndex(const bookmarks::BookmarkNode* node);
+  std::vector<const bookmarks::BookmarkNode*> GetUnsyncedNodesInTreeOrder(
+      const std::vector<const bookmarks::BookmarkNode*>& root_nodes) const;
+
+  // Parses the "order" meta info of a node once, returning null if it has no
+  // order. Cached keys are dropped after each batch of changes from sync.
+  const std::vector<int>* GetOrderKey(const bookmarks::BookmarkNode* node);
+  uint64_t GetIndexByOrder(const bookmarks::BookmarkNode* root_node,
+                           const std::string& record_order);
+
+  // Returns false while orders are still being migrated
+  bool MigrateOrders();
+  void CollectOrdersToMigrate(const bookmarks::BookmarkNode* perm_node);
+  void MigrateOrder(const bookmarks::BookmarkNode* node,
+                    const std::string& perm_new_order);
+  void MigrateOrdersChunk();
   int GetPermanentNodeIndex(const bookmarks::BookmarkNode* node) const;
   static int FindMigrateSubOrderLength(const std::string& order);
 
@@ -128,6 +210,44 @@ class BookmarkChangeProcessor : public ChangeProcessor,
   bookmarks::BookmarkNode* deleted_node_root_;
   bookmarks::BookmarkNode* pending_node_root_;
 
+  std::unordered_map<std::string, const bookmarks::BookmarkNode*>
+      nodes_by_object_id_;
+  std::unordered_map<const bookmarks::BookmarkNode*, std::string>
+      object_ids_by_node_;
+  // Object ids held by more than one node. These are looked up by walking the
+  // tree, so the first node in tree order wins like it did before the index
+  std::unordered_set<std::string> duplicate_object_ids_;
+  std::set<const bookmarks::BookmarkNode*> unsynced_nodes_;
+  bool node_index_built_;
+
+  // True while |SendUnsynced| is batching meta info changes
+  bool is_sending_unsynced_;
+  size_t send_records_target_bytes_;
+
+  struct OrderKey {
+    std::string order;
+    std::vector<int> key;
+  };
+  std::unordered_map<const bookmarks::BookmarkNode*, OrderKey> order_keys_;
+
+  // Nodes whose order still needs migrating, with the new order prefix
+  std::map<const bookmarks::BookmarkNode*, std::string> orders_to_migrate_;
+  bool is_migrating_orders_;
+
+  // Records from sync which are still to be applied
+  base::circular_deque<std::unique_ptr<jslib::SyncRecord>> pending_records_;
+  size_t pending_records_applied_;
+  size_t pending_records_total_;
+  bool is_applying_changes_;
+  base::TimeDelta apply_changes_time_budget_;
+  bool send_unsynced_after_apply_;
+  base::TimeDelta unsynced_send_interval_after_apply_;
+  ApplyChangesProgressCallback apply_changes_progress_callback_;
+  base::RepeatingClosure apply_changes_done_callback_;
+  base::RepeatingClosure local_change_callback_;
+
+  base::WeakPtrFactory<BookmarkChangeProcessor> weak_ptr_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(BookmarkChangeProcessor);
 };
 
@@ -0,0 +1,336 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/process/process_metrics.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "brave/components/brave_sync/brave_sync_prefs.h"
+#include "brave/components/brave_sync/client/bookmark_change_processor.h"
+#include "brave/components/brave_sync/jslib_messages.h"
+#include "brave/components/brave_sync/test_util.h"
+#include "chrome/browser/bookmarks/bookmark_model_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+// npm run test -- brave_sync_perftests
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+using bookmarks::BookmarkModel;
+using bookmarks::BookmarkNode;
+
+using brave_sync::jslib::SyncRecord;
+using brave_sync::MockBraveSyncClient;
+using brave_sync::RecordsList;
+using brave_sync::SimpleBookmarkSyncRecord;
+using brave_sync::SimpleFolderSyncRecord;
+using brave_sync::SyncRecordAndExistingList;
+
+namespace {
+
+// Node counts span a typical profile up to one that has imported bookmarks
+// from several other browsers
+const size_t kNodeCounts[] = { 1000, 10000, 100000 };
+
+// Wide trees keep many bookmarks in few folders, deep trees nest folders
+// holding a handful of bookmarks each
+struct TreeShape {
+  const char* name;
+  size_t bookmarks_per_folder;
+  size_t folder_depth;
+};
+
+const TreeShape kTreeShapes[] = {
+  { "wide", 1000, 1 },
+  { "deep", 4, 32 },
+};
+
+const char kBaseOrder[] = "1.0.";
+
+// Long enough that a node is not sent twice while every node is sent
+constexpr base::TimeDelta kUnsyncedSendInterval =
+    base::TimeDelta::FromMinutes(10);
+
+// Net heap growth stands in for allocations, since the allocator is not
+// hooked in this test binary
+size_t GetMallocUsage() {
+  return base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage();
+}
+
+std::string GetTrace(const TreeShape& shape, size_t count) {
+  return std::string(shape.name) + "_" + base::NumberToString(count);
+}
+
+void PrintTimePerNode(const std::string& measurement,
+                      const std::string& trace,
+                      size_t count,
+                      base::TimeDelta elapsed) {
+  perf_test::PrintResult(measurement, "", trace,
+      elapsed.InMicrosecondsF() / count, "us/node", true);
+}
+
+void PrintMemoryPerNode(const std::string& measurement,
+                        const std::string& trace,
+                        size_t count,
+                        size_t malloc_usage_before) {
+  const size_t malloc_usage = GetMallocUsage();
+  const size_t growth = malloc_usage > malloc_usage_before ?
+      malloc_usage - malloc_usage_before : 0;
+  perf_test::PrintResult(measurement, "", trace,
+      static_cast<double>(growth) / count, "bytes/node", true);
+}
+
+}  // namespace
+
+class BraveSyncPerfTest : public testing::Test {
+ public:
+  BraveSyncPerfTest() {}
+  ~BraveSyncPerfTest() override {}
+
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+
+    profile_ = brave_sync::CreateBraveSyncProfile(temp_dir_.GetPath());
+    ASSERT_TRUE(profile_);
+
+    sync_client_.reset(new NiceMock<MockBraveSyncClient>());
+    ON_CALL(*sync_client_, SendSyncRecords(_, _))
+        .WillByDefault(Invoke([this](const std::string& category_name,
+                                     const RecordsList& records) {
+          records_sent_ += records.size();
+        }));
+
+    BookmarkModelFactory::GetInstance()->SetTestingFactory(
+       profile_.get(),
+       base::BindRepeating(&brave_sync::BuildFakeBookmarkModelForTests));
+
+    model_ = BookmarkModelFactory::GetForBrowserContext(profile_.get());
+
+    sync_prefs_.reset(new brave_sync::prefs::Prefs(profile_->GetPrefs()));
+    sync_prefs_->SetBookmarksBaseOrder(kBaseOrder);
+
+    change_processor_.reset(brave_sync::BookmarkChangeProcessor::Create(
+        profile_.get(),
+        sync_client_.get(),
+        sync_prefs_.get()));
+  }
+
+  void TearDown() override {
+    change_processor_->Stop();
+    change_processor_.reset();
+    profile_.reset();
+  }
+
+  // Adds about |count| nodes to the bookmark bar in |shape|. Orders are in
+  // the format used before migration when |old_orders| is set.
+  void AddLocalNodes(const TreeShape& shape, size_t count, bool old_orders) {
+    const std::string bar_order = std::string(kBaseOrder) +
+        (old_orders ? "0" : "1");
+    size_t added = 0;
+    for (int chain = 0; added < count; ++chain) {
+      const BookmarkNode* parent = model_->bookmark_bar_node();
+      std::string parent_order = bar_order;
+      int index = chain;
+      for (size_t depth = 0; depth < shape.folder_depth && added < count;
+           ++depth) {
+        const auto* folder = model_->AddFolder(parent, index,
+            base::ASCIIToUTF16("Folder"));
+        const std::string folder_order =
+            parent_order + "." + base::NumberToString(index + 1);
+        model_->SetNodeMetaInfo(folder, "order", folder_order);
+        ++added;
+
+        for (size_t i = 0; i < shape.bookmarks_per_folder && added < count;
+             ++i) {
+          const auto* node = model_->AddURL(folder, i,
+              base::ASCIIToUTF16("Bookmark - title"),
+              GURL("https://bookmark" + base::NumberToString(added) + ".com/"));
+          model_->SetNodeMetaInfo(node, "order",
+              folder_order + "." + base::NumberToString(i + 1));
+          ++added;
+        }
+
+        parent = folder;
+        parent_order = folder_order;
+        index = shape.bookmarks_per_folder;
+      }
+    }
+  }
+
+  // Creates records from another device for about |count| nodes in |shape|,
+  // with every folder ahead of its children
+  RecordsList CreateRemoteRecords(const TreeShape& shape, size_t count) {
+    const std::string bar_order = std::string(kBaseOrder) + "1";
+    RecordsList records;
+    for (int chain = 0; records.size() < count; ++chain) {
+      std::string parent_object_id;
+      std::string parent_order = bar_order;
+      int index = chain;
+      for (size_t depth = 0;
+           depth < shape.folder_depth && records.size() < count; ++depth) {
+        const std::string folder_order =
+            parent_order + "." + base::NumberToString(index + 1);
+        auto folder = SimpleFolderSyncRecord(
+            SyncRecord::Action::A_CREATE,
+            "Folder",
+            folder_order,
+            parent_object_id,
+            false, "");
+        const std::string folder_object_id = folder->objectId;
+        records.push_back(std::move(folder));
+
+        for (size_t i = 0;
+             i < shape.bookmarks_per_folder && records.size() < count; ++i) {
+          records.push_back(SimpleBookmarkSyncRecord(
+              SyncRecord::Action::A_CREATE,
+              "",
+              "https://bookmark" + base::NumberToString(records.size()) +
+                  ".com/",
+              "Bookmark - title",
+              folder_order + "." + base::NumberToString(i + 1),
+              folder_object_id));
+        }
+
+        parent_object_id = folder_object_id;
+        parent_order = folder_order;
+        index = shape.bookmarks_per_folder;
+      }
+    }
+    return records;
+  }
+
+  // Sends every unsynced node, which takes several calls for large trees
+  void SendAllUnsynced() {
+    size_t records_sent_before;
+    do {
+      records_sent_before = records_sent_;
+      change_processor_->SendUnsynced(kUnsyncedSendInterval);
+      base::RunLoop().RunUntilIdle();
+    } while (records_sent_ != records_sent_before);
+  }
+
+  // Need this as a very first member to run tests in UI thread
+  content::TestBrowserThreadBundle thread_bundle_;
+
+  std::unique_ptr<NiceMock<MockBraveSyncClient>> sync_client_;
+  BookmarkModel* model_;  // Not owns
+  std::unique_ptr<brave_sync::BookmarkChangeProcessor> change_processor_;
+  std::unique_ptr<Profile> profile_;
+  std::unique_ptr<brave_sync::prefs::Prefs> sync_prefs_;
+  base::ScopedTempDir temp_dir_;
+  size_t records_sent_ = 0;
+};
+
+TEST_F(BraveSyncPerfTest, ApplyChangesFromSyncModel) {
+  for (const auto& shape : kTreeShapes) {
+    for (const size_t count : kNodeCounts) {
+      // Arrange
+      sync_prefs_->SetMigratedBookmarksVersion(1);
+      change_processor_->Start();
+      auto records = CreateRemoteRecords(shape, count);
+      const std::string trace = GetTrace(shape, records.size());
+
+      // Act
+      size_t malloc_usage = GetMallocUsage();
+      auto start_time = base::TimeTicks::Now();
+      change_processor_->ApplyChangesFromSyncModel(records);
+      base::RunLoop().RunUntilIdle();
+      PrintTimePerNode("apply_changes_from_sync_model", trace, records.size(),
+          base::TimeTicks::Now() - start_time);
+      PrintMemoryPerNode("apply_changes_from_sync_model_heap", trace,
+          records.size(), malloc_usage);
+
+      // Resolving the same records again finds every node as existing
+      SyncRecordAndExistingList records_and_existing_objects;
+      malloc_usage = GetMallocUsage();
+      start_time = base::TimeTicks::Now();
+      change_processor_->GetAllSyncData(records,
+                                        &records_and_existing_objects);
+      PrintTimePerNode("get_all_sync_data", trace, records.size(),
+          base::TimeTicks::Now() - start_time);
+      PrintMemoryPerNode("get_all_sync_data_heap", trace, records.size(),
+          malloc_usage);
+
+      // Assert
+      ASSERT_EQ(records_and_existing_objects.size(), records.size());
+      for (const auto& resolved_record : records_and_existing_objects)
+        EXPECT_NE(resolved_record->second, nullptr);
+
+      change_processor_->Stop();
+      model_->RemoveAllUserBookmarks();
+    }
+  }
+}
+
+TEST_F(BraveSyncPerfTest, SendUnsynced) {
+  for (const auto& shape : kTreeShapes) {
+    for (const size_t count : kNodeCounts) {
+      // Arrange
+      sync_prefs_->SetMigratedBookmarksVersion(1);
+      change_processor_->Start();
+      AddLocalNodes(shape, count, false);
+      const std::string trace = GetTrace(shape, count);
+      records_sent_ = 0;
+
+      // Act
+      const size_t malloc_usage = GetMallocUsage();
+      const auto start_time = base::TimeTicks::Now();
+      SendAllUnsynced();
+      PrintTimePerNode("send_unsynced", trace, count,
+          base::TimeTicks::Now() - start_time);
+      PrintMemoryPerNode("send_unsynced_heap", trace, count, malloc_usage);
+
+      // Assert
+      EXPECT_EQ(records_sent_, count);
+
+      change_processor_->Stop();
+      model_->RemoveAllUserBookmarks();
+    }
+  }
+}
+
+TEST_F(BraveSyncPerfTest, MigrateOrders) {
+  for (const auto& shape : kTreeShapes) {
+    for (const size_t count : kNodeCounts) {
+      // Arrange
+      sync_prefs_->SetMigratedBookmarksVersion(0);
+      change_processor_->Start();
+      AddLocalNodes(shape, count, true);
+      const std::string trace = GetTrace(shape, count);
+
+      // Act
+      // Large trees are migrated over several tasks
+      const size_t malloc_usage = GetMallocUsage();
+      const auto start_time = base::TimeTicks::Now();
+      change_processor_->MigrateOrders();
+      base::RunLoop().RunUntilIdle();
+      PrintTimePerNode("migrate_orders", trace, count,
+          base::TimeTicks::Now() - start_time);
+      PrintMemoryPerNode("migrate_orders_heap", trace, count, malloc_usage);
+
+      // Assert
+      EXPECT_EQ(sync_prefs_->GetMigratedBookmarksVersion(), 1);
+
+      change_processor_->Stop();
+      model_->RemoveAllUserBookmarks();
+    }
+  }
+}
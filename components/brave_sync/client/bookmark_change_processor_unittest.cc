@@ -8,7 +8,9 @@
 #include <string>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/components/brave_sync/client/bookmark_change_processor.h"
 #include "brave/components/brave_sync/client/brave_sync_client_impl.h"
@@ -21,6 +23,7 @@
 #include "brave/components/brave_sync/test_util.h"
 #include "chrome/browser/bookmarks/bookmark_model_factory.h"
 #include "chrome/browser/profiles/profile.h"
+#include "components/bookmarks/browser/base_bookmark_model_observer.h"
 #include "components/bookmarks/browser/bookmark_model.h"
 #include "components/bookmarks/browser/bookmark_utils.h"
 #include "components/bookmarks/common/bookmark_pref_names.h"
@@ -1388,6 +1391,98 @@ TEST_F(BraveBookmarkChangeProcessorTest, MigrateOrdersForPermanentNodes) {
   EXPECT_EQ(sync_prefs()->GetMigratedBookmarksVersion(), 1);
 }
 
+TEST_F(BraveBookmarkChangeProcessorTest, ApplyChangesInSlices) {
+  change_processor()->Start();
+
+  std::vector<std::pair<size_t, size_t>> progress;
+  change_processor()->set_apply_changes_progress_callback(
+      base::BindRepeating([](std::vector<std::pair<size_t, size_t>>* progress,
+                             size_t applied, size_t total) {
+        progress->push_back(std::make_pair(applied, total));
+      }, &progress));
+  // Every slice applies a single record
+  change_processor()->set_apply_changes_time_budget(base::TimeDelta());
+
+  auto folder_record = SimpleFolderSyncRecord(
+      SyncRecord::Action::A_CREATE,
+      "Folder1",
+      "1.0.1.1",
+      "", false, "");
+
+  // The child arrives before its folder
+  RecordsList records;
+  records.push_back(SimpleBookmarkSyncRecord(
+      SyncRecord::Action::A_CREATE,
+      "",
+      "https://a.com/",
+      "A.com - title",
+      "1.0.1.1.1",
+      folder_record->objectId));
+  records.push_back(std::move(folder_record));
+
+  change_processor()->ApplyChangesFromSyncModel(records);
+  EXPECT_EQ(GetPendingNodeRoot()->child_count(), 1);
+  EXPECT_TRUE(model()->bookmark_bar_node()->empty());
+  ASSERT_EQ(progress.size(), 1u);
+  EXPECT_EQ(progress[0].first, 1u);
+  EXPECT_EQ(progress[0].second, 2u);
+
+  // Local changes are not sent until every record is applied
+  EXPECT_CALL(*sync_client(), SendSyncRecords(_, _)).Times(0);
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(0);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+  testing::Mock::VerifyAndClearExpectations(sync_client());
+
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(1);
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_TRUE(GetPendingNodeRoot()->empty());
+  ASSERT_EQ(model()->bookmark_bar_node()->child_count(), 1);
+  const auto* folder = model()->bookmark_bar_node()->GetChild(0);
+  EXPECT_EQ(folder->GetTitle(), base::ASCIIToUTF16("Folder1"));
+  ASSERT_EQ(folder->child_count(), 1);
+  EXPECT_EQ(folder->GetChild(0)->url(), GURL("https://a.com/"));
+  ASSERT_EQ(progress.size(), 2u);
+  EXPECT_EQ(progress[1].first, 2u);
+  EXPECT_EQ(progress[1].second, 2u);
+}
+
+TEST_F(BraveBookmarkChangeProcessorTest, MigrateOrdersInChunks) {
+  sync_prefs()->SetBookmarksBaseOrder("1.0.");
+
+  change_processor()->Start();
+
+  // More nodes than are migrated at once
+  const size_t kNodeCount = 1500;
+  std::vector<const bookmarks::BookmarkNode*> nodes;
+  for (size_t i = 0; i < kNodeCount; ++i) {
+    const auto* node = model()->AddURL(model()->other_node(), i,
+        base::ASCIIToUTF16("OB item - title"),
+        GURL("https://ob_item.com/"));
+    const_cast<bookmarks::BookmarkNode*>(node)->SetMetaInfo(
+        "order", "1.0.0." + std::to_string(i + 1));
+    nodes.push_back(node);
+  }
+
+  // Nothing is sent until the migration finishes
+  EXPECT_CALL(*sync_client(), SendSyncRecords("BOOKMARKS", _)).Times(0);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+  EXPECT_EQ(sync_prefs()->GetMigratedBookmarksVersion(), 0);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(sync_prefs()->GetMigratedBookmarksVersion(), 1);
+
+  for (size_t i = 0; i < kNodeCount; ++i) {
+    std::string order;
+    nodes[i]->GetMetaInfo("order", &order);
+    EXPECT_EQ(order, "1.0.2." + std::to_string(i + 1));
+  }
+
+  // Records are sent in batches of 1000
+  EXPECT_CALL(*sync_client(), SendSyncRecords("BOOKMARKS", _)).Times(2);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+}
+
 TEST_F(BraveBookmarkChangeProcessorTest, ApplyOrder) {
   BookmarkCreatedFromSyncImpl();
   const char* record_a_object_id =
@@ -1403,3 +1498,223 @@ TEST_F(BraveBookmarkChangeProcessorTest, ApplyOrder) {
   node_a->GetMetaInfo("order", &order);
   EXPECT_EQ(order, new_order);
 }
+
+TEST_F(BraveBookmarkChangeProcessorTest, ObjectIdIndexFollowsModelChanges) {
+  BookmarkCreatedFromSyncImpl();
+  const char* record_a_object_id =
+      "121, 194, 37, 61, 199, 11, 166, 234, "
+      "214, 197, 45, 215, 241, 206, 219, 130";
+
+  const auto* node_c = model()->AddURL(model()->other_node(), 0,
+      base::ASCIIToUTF16("C.com - title"),
+      GURL("https://c.com/"));
+  model()->SetNodeMetaInfo(node_c, "object_id", "c");
+
+  std::vector<std::unique_ptr<SyncRecord>> records_to_resolve;
+  records_to_resolve.push_back(SimpleBookmarkSyncRecord(
+      SyncRecord::Action::A_UPDATE, "c", "https://c.com/", "C.com - title",
+      "1.1.1.3", ""));
+  records_to_resolve.push_back(SimpleBookmarkSyncRecord(
+      SyncRecord::Action::A_UPDATE, "d", "https://d.com/", "D.com - title",
+      "1.1.1.4", ""));
+
+  brave_sync::SyncRecordAndExistingList records_and_existing_objects;
+  change_processor()->GetAllSyncData(records_to_resolve,
+                                     &records_and_existing_objects);
+  ASSERT_EQ(records_and_existing_objects.size(), 2u);
+  ASSERT_NE(records_and_existing_objects.at(0)->second.get(), nullptr);
+  EXPECT_EQ(records_and_existing_objects.at(0)->second->GetBookmark()
+      .site.location, "https://c.com/");
+  EXPECT_EQ(records_and_existing_objects.at(1)->second.get(), nullptr);
+
+  // The object id moves from c to d
+  model()->SetNodeMetaInfo(node_c, "object_id", "d");
+  records_and_existing_objects.clear();
+  change_processor()->GetAllSyncData(records_to_resolve,
+                                     &records_and_existing_objects);
+  ASSERT_EQ(records_and_existing_objects.size(), 2u);
+  EXPECT_EQ(records_and_existing_objects.at(0)->second.get(), nullptr);
+  EXPECT_NE(records_and_existing_objects.at(1)->second.get(), nullptr);
+
+  // A removed node is found in the deleted nodes by its object id
+  std::vector<const BookmarkNode*> nodes_a;
+  model()->GetNodesByURL(GURL("https://a.com/"), &nodes_a);
+  ASSERT_EQ(nodes_a.size(), 1u);
+  model()->Remove(nodes_a.at(0));
+
+  RecordsList records;
+  records.push_back(SimpleBookmarkSyncRecord(
+      SyncRecord::Action::A_DELETE,
+      record_a_object_id,
+      "https://a.com/",
+      "A.com - title",
+      "1.1.1.1", ""));
+  EXPECT_EQ(GetDeletedNodeRoot()->child_count(), 1);
+  change_processor()->ApplyChangesFromSyncModel(records);
+  EXPECT_EQ(GetDeletedNodeRoot()->child_count(), 0);
+}
+
+TEST_F(BraveBookmarkChangeProcessorTest,
+       ObjectIdIndexFindsFirstNodeInTreeOrderForDuplicates) {
+  change_processor()->Start();
+
+  // The bookmark bar comes before the other bookmarks in tree order, but is
+  // given the object id first
+  const auto* node_bar = model()->AddURL(model()->bookmark_bar_node(), 0,
+      base::ASCIIToUTF16("Bar.com - title"),
+      GURL("https://bar.com/"));
+  model()->SetNodeMetaInfo(node_bar, "object_id", "dup");
+  const auto* node_other = model()->AddURL(model()->other_node(), 0,
+      base::ASCIIToUTF16("Other.com - title"),
+      GURL("https://other.com/"));
+  model()->SetNodeMetaInfo(node_other, "object_id", "dup");
+
+  std::vector<std::unique_ptr<SyncRecord>> records_to_resolve;
+  records_to_resolve.push_back(SimpleBookmarkSyncRecord(
+      SyncRecord::Action::A_UPDATE, "dup", "https://bar.com/",
+      "Bar.com - title", "1.0.1", ""));
+
+  brave_sync::SyncRecordAndExistingList records_and_existing_objects;
+  change_processor()->GetAllSyncData(records_to_resolve,
+                                     &records_and_existing_objects);
+  ASSERT_EQ(records_and_existing_objects.size(), 1u);
+  ASSERT_NE(records_and_existing_objects.at(0)->second.get(), nullptr);
+  EXPECT_EQ(records_and_existing_objects.at(0)->second->GetBookmark()
+      .site.location, "https://bar.com/");
+
+  // Once the first node has another object id the remaining duplicate is
+  // found
+  model()->SetNodeMetaInfo(node_bar, "object_id", "bar");
+  records_and_existing_objects.clear();
+  change_processor()->GetAllSyncData(records_to_resolve,
+                                     &records_and_existing_objects);
+  ASSERT_EQ(records_and_existing_objects.size(), 1u);
+  ASSERT_NE(records_and_existing_objects.at(0)->second.get(), nullptr);
+  EXPECT_EQ(records_and_existing_objects.at(0)->second->GetBookmark()
+      .site.location, "https://other.com/");
+}
+
+TEST_F(BraveBookmarkChangeProcessorTest, SendUnsyncedOnlySendsChangedNodes) {
+  change_processor()->Start();
+
+  const auto* node_a = model()->AddURL(model()->other_node(), 0,
+      base::ASCIIToUTF16("A.com - title"),
+      GURL("https://a.com/"));
+  const auto* node_b = model()->AddURL(model()->other_node(), 1,
+      base::ASCIIToUTF16("B.com - title"),
+      GURL("https://b.com/"));
+
+  EXPECT_CALL(*sync_client(), SendSyncRecords("BOOKMARKS",
+      RecordsNumber(2))).Times(1);
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(1);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+
+  // Acknowledge both nodes as synced
+  const std::string sync_timestamp = std::to_string(
+      (base::Time::Now() + base::TimeDelta::FromMinutes(1)).ToJsTime());
+  model()->SetNodeMetaInfo(node_a, "sync_timestamp", sync_timestamp);
+  model()->SetNodeMetaInfo(node_b, "sync_timestamp", sync_timestamp);
+
+  EXPECT_CALL(*sync_client(), SendSyncRecords(_, _)).Times(0);
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(1);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(0));
+
+  model()->SetTitle(node_b, base::ASCIIToUTF16("B.com - title - updated"));
+
+  EXPECT_CALL(*sync_client(), SendSyncRecords("BOOKMARKS",
+      RecordsNumber(1))).Times(1);
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(1);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+}
+
+TEST_F(BraveBookmarkChangeProcessorTest, SendUnsyncedChunksBySize) {
+  change_processor()->Start();
+
+  for (int i = 0; i < 3; ++i) {
+    model()->AddURL(model()->other_node(), i,
+        base::ASCIIToUTF16("A.com - title"),
+        GURL("https://a.com/"));
+  }
+
+  // Every record is larger than the target, so each is sent on its own
+  change_processor()->set_send_records_target_bytes(1);
+  EXPECT_CALL(*sync_client(), SendSyncRecords("BOOKMARKS",
+      RecordsNumber(1))).Times(3);
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(1);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+}
+
+TEST_F(BraveBookmarkChangeProcessorTest, SendUnsyncedLimitsMessagesPerCall) {
+  change_processor()->Start();
+
+  // More nodes than messages sent per call
+  for (int i = 0; i < 12; ++i) {
+    model()->AddURL(model()->other_node(), i,
+        base::ASCIIToUTF16("A.com - title"),
+        GURL("https://a.com/"));
+  }
+
+  change_processor()->set_send_records_target_bytes(1);
+  EXPECT_CALL(*sync_client(), SendSyncRecords("BOOKMARKS",
+      RecordsNumber(1))).Times(10);
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(1);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+  testing::Mock::VerifyAndClearExpectations(sync_client());
+
+  // The nodes which did not fit are sent by the next call
+  EXPECT_CALL(*sync_client(), SendSyncRecords("BOOKMARKS",
+      RecordsNumber(1))).Times(2);
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(1);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+}
+
+namespace {
+
+class MetaInfoChangedCounter : public bookmarks::BaseBookmarkModelObserver {
+ public:
+  MetaInfoChangedCounter() : count_(0) {}
+
+  void BookmarkModelChanged() override {}
+  void BookmarkMetaInfoChanged(BookmarkModel* model,
+                               const BookmarkNode* node) override {
+    count_++;
+  }
+
+  int count() const { return count_; }
+
+ private:
+  int count_;
+};
+
+}  // namespace
+
+TEST_F(BraveBookmarkChangeProcessorTest, SendUnsyncedNotifiesOnce) {
+  change_processor()->Start();
+
+  const BookmarkNode* folder1;
+  const BookmarkNode* node_a;
+  const BookmarkNode* node_b;
+  const BookmarkNode* node_c;
+  AddSimpleHierarchy(&folder1, &node_a, &node_b, &node_c);
+
+  MetaInfoChangedCounter counter;
+  model()->AddObserver(&counter);
+
+  EXPECT_CALL(*sync_client(), SendSyncRecords("BOOKMARKS",
+      RecordsNumber(4))).Times(1);
+  EXPECT_CALL(*sync_client(), ClearOrderMap()).Times(1);
+  change_processor()->SendUnsynced(base::TimeDelta::FromMinutes(10));
+
+  model()->RemoveObserver(&counter);
+  EXPECT_EQ(counter.count(), 1);
+
+  // The bookkeeping is still written to every node sent
+  for (const auto* node : { folder1, node_a, node_b, node_c }) {
+    std::string object_id;
+    node->GetMetaInfo("object_id", &object_id);
+    EXPECT_FALSE(object_id.empty());
+    std::string last_send_time;
+    node->GetMetaInfo("last_send_time", &last_send_time);
+    EXPECT_FALSE(last_send_time.empty());
+  }
+}
@@ -9,12 +9,14 @@
 #include <string>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/one_shot_event.h"
 #include "brave/browser/extensions/api/brave_sync_event_router.h"
 #include "brave/components/brave_sync/client/client_ext_impl_data.h"
 #include "brave/components/brave_sync/grit/brave_sync_resources.h"
 #include "brave/components/brave_sync/brave_sync_prefs.h"
+#include "brave/components/brave_sync/sync_records_codec.h"
 #include "brave/common/extensions/api/brave_sync.h"
 #include "brave/common/extensions/extension_constants.h"
 #include "chrome/browser/profiles/profile.h"
@@ -26,6 +28,14 @@
 
 namespace brave_sync {
 
+namespace {
+
+// Bounds how many resolved records are serialized into one event for the
+// sync extension
+const size_t kMaxResolveSyncRecordsPerEvent = 500;
+
+}  // namespace
+
 BraveSyncClient* brave_sync_client_for_testing_;
 
 // static
@@ -92,23 +102,22 @@ void BraveSyncClientImpl::SendResolveSyncRecords(
     const std::string &category_name,
     std::unique_ptr<SyncRecordAndExistingList> records_and_existing_objects) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  std::vector<extensions::api::brave_sync::RecordAndExistingObject>
-      records_and_existing_objects_ext;
+  if (!brave_sync_event_router_->HasListener(
+          extensions::api::brave_sync::OnResolveSyncRecords::kEventName))
+    return;
 
-  ConvertResolvedPairs(*records_and_existing_objects,
-                       records_and_existing_objects_ext);
-
-  brave_sync_event_router_->ResolveSyncRecords(category_name,
-    records_and_existing_objects_ext);
+  ConvertResolvedPairsInBatches(
+      records_and_existing_objects.get(), kMaxResolveSyncRecordsPerEvent,
+      base::BindRepeating(&extensions::BraveSyncEventRouter::ResolveSyncRecords,
+                          base::Unretained(brave_sync_event_router_.get()),
+                          category_name));
 }
 
 void BraveSyncClientImpl::SendSyncRecords(const std::string &category_name,
                                           const RecordsList &records) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  std::vector<extensions::api::brave_sync::SyncRecord> records_ext;
-  ConvertSyncRecordsFromLibToExt(records, records_ext);
-
-  brave_sync_event_router_->SendSyncRecords(category_name, records_ext);
+  brave_sync_event_router_->SendSyncRecords(category_name,
+                                            EncodeSyncRecords(records));
 }
 
 void BraveSyncClientImpl::SendDeleteSyncUser()  {
@@ -8,6 +8,7 @@
 #include <memory>
 #include <vector>
 
+#include "base/callback_forward.h"
 #include "brave/components/brave_sync/jslib_messages_fwd.h"
 
 namespace extensions {
@@ -31,14 +32,24 @@ namespace brave_sync {
 void ConvertConfig(const brave_sync::client_data::Config &config,
   extensions::api::brave_sync::Config &config_extension);
 
-void ConvertSyncRecords(const std::vector<extensions::api::brave_sync::SyncRecord> &records_extension,
+// Both conversions move the record bodies out of their source, which is left
+// empty
+void ConvertSyncRecords(std::vector<extensions::api::brave_sync::SyncRecord>* records_extension,
   std::vector<brave_sync::SyncRecordPtr> &records);
 
-void ConvertResolvedPairs(const SyncRecordAndExistingList &records_and_existing_objects,
+void ConvertResolvedPairs(SyncRecordAndExistingList* records_and_existing_objects,
   std::vector<extensions::api::brave_sync::RecordAndExistingObject> &records_and_existing_objects_ext);
 
-void ConvertSyncRecordsFromLibToExt(const std::vector<brave_sync::SyncRecordPtr> &records,
-  std::vector<extensions::api::brave_sync::SyncRecord> &records_extension);
+using ResolvedPairsBatchCallback = base::RepeatingCallback<void(
+    const std::vector<extensions::api::brave_sync::RecordAndExistingObject>&)>;
+
+// Converts |records_and_existing_objects| |max_batch_size| records at a time
+// and runs |send_batch| with each batch, so only one batch is held as
+// extension values at once. An empty list is sent as one empty batch
+void ConvertResolvedPairsInBatches(
+    SyncRecordAndExistingList* records_and_existing_objects,
+    size_t max_batch_size,
+    const ResolvedPairsBatchCallback& send_batch);
 
 } // namespace brave_sync
 
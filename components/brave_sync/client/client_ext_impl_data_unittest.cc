@@ -0,0 +1,100 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/client/client_ext_impl_data.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "brave/common/extensions/api/brave_sync.h"
+#include "brave/components/brave_sync/jslib_messages.h"
+#include "brave/components/brave_sync/test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=ClientExtImplDataTest.*
+
+using extensions::api::brave_sync::RecordAndExistingObject;
+
+namespace brave_sync {
+
+namespace {
+
+std::unique_ptr<SyncRecordAndExistingList> CreateResolvedPairs(size_t count) {
+  auto records = std::make_unique<SyncRecordAndExistingList>();
+  for (size_t i = 0; i < count; ++i) {
+    auto record = SimpleBookmarkSyncRecord(
+        jslib::SyncRecord::Action::A_CREATE, base::NumberToString(i),
+        "https://brave.com/", "Brave", "1.1." + base::NumberToString(i), "");
+    records->push_back(std::make_unique<SyncRecordAndExisting>(
+        std::move(record), nullptr));
+  }
+  return records;
+}
+
+void RecordBatch(std::vector<std::vector<std::string>>* batches,
+                 const std::vector<RecordAndExistingObject>& batch) {
+  std::vector<std::string> object_ids;
+  for (const auto& record_and_existing : batch) {
+    object_ids.push_back(*record_and_existing.server_record.object_id_str);
+  }
+  batches->push_back(object_ids);
+}
+
+}  // namespace
+
+TEST(ClientExtImplDataTest, ConvertResolvedPairsInBatches_SplitsInOrder) {
+  auto records = CreateResolvedPairs(5);
+  std::vector<std::vector<std::string>> batches;
+
+  ConvertResolvedPairsInBatches(records.get(), 2,
+                                base::BindRepeating(&RecordBatch, &batches));
+
+  ASSERT_EQ(3u, batches.size());
+  EXPECT_EQ(std::vector<std::string>({"0", "1"}), batches[0]);
+  EXPECT_EQ(std::vector<std::string>({"2", "3"}), batches[1]);
+  EXPECT_EQ(std::vector<std::string>({"4"}), batches[2]);
+  EXPECT_TRUE(records->empty());
+}
+
+TEST(ClientExtImplDataTest, ConvertResolvedPairsInBatches_ExactMultiple) {
+  auto records = CreateResolvedPairs(4);
+  std::vector<std::vector<std::string>> batches;
+
+  ConvertResolvedPairsInBatches(records.get(), 2,
+                                base::BindRepeating(&RecordBatch, &batches));
+
+  ASSERT_EQ(2u, batches.size());
+  EXPECT_EQ(2u, batches[0].size());
+  EXPECT_EQ(2u, batches[1].size());
+}
+
+TEST(ClientExtImplDataTest, ConvertResolvedPairsInBatches_SingleBatch) {
+  auto records = CreateResolvedPairs(3);
+  std::vector<std::vector<std::string>> batches;
+
+  ConvertResolvedPairsInBatches(records.get(), 500,
+                                base::BindRepeating(&RecordBatch, &batches));
+
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_EQ(std::vector<std::string>({"0", "1", "2"}), batches[0]);
+}
+
+TEST(ClientExtImplDataTest, ConvertResolvedPairsInBatches_EmptyList) {
+  auto records = CreateResolvedPairs(0);
+  std::vector<std::vector<std::string>> batches;
+
+  ConvertResolvedPairsInBatches(records.get(), 2,
+                                base::BindRepeating(&RecordBatch, &batches));
+
+  // The extension still gets an answer for the category
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_TRUE(batches[0].empty());
+}
+
+}  // namespace brave_sync
@@ -48,7 +48,8 @@ chrome.braveSync.onResolveSyncRecords.addListener(function(category_name, record
   callbackList["resolve-sync-records"](null, category_name, recordsAndExistingObjectsArrArr);
 });
 
-chrome.braveSync.onSendSyncRecords.addListener(function(category_name, records) {
+chrome.braveSync.onSendSyncRecords.addListener(function(category_name, encoded_records) {
+  var records = decodeSyncRecords(encoded_records);
   // Fixup ids
   for (var i = 0; i < records.length; ++i) {
     // getOrder requires objectIdStr to send back order
@@ -114,6 +115,145 @@ function getOrder(record) {
   }
 }
 
+// Decodes records encoded by brave_sync::EncodeSyncRecords, see
+// components/brave_sync/sync_records_codec.h for the layout. Records are
+// decoded to the same shape as the browser's SyncRecord type, so that
+// fixupSyncRecordBrowserToExt can be applied to them.
+function decodeSyncRecords(buffer) {
+  var view = new DataView(buffer);
+  var bytes = new Uint8Array(buffer);
+  var utf8 = new TextDecoder('utf-8');
+  var offset = 0;
+
+  function readU8() {
+    return view.getUint8(offset++);
+  }
+  function readU32() {
+    var value = view.getUint32(offset);
+    offset += 4;
+    return value;
+  }
+  function readDouble() {
+    var value = view.getFloat64(offset);
+    offset += 8;
+    return value;
+  }
+  function readBool() {
+    return readU8() != 0;
+  }
+  function readString() {
+    var length = readU32();
+    var value = utf8.decode(bytes.subarray(offset, offset + length));
+    offset += length;
+    return value;
+  }
+  // Ids are passed as the "1, 2, 3" strings the *IdStr fields hold
+  function readIdStr() {
+    var length = readU32();
+    var value = Array.prototype.join.call(
+        bytes.subarray(offset, offset + length), ', ');
+    offset += length;
+    return value;
+  }
+  function readFields() {
+    var count = readU32();
+    var fields = [];
+    for (var i = 0; i < count; ++i) {
+      fields.push(readString());
+    }
+    return fields;
+  }
+  function readSite() {
+    return {
+      location: readString(),
+      title: readString(),
+      customTitle: readString(),
+      favicon: readString(),
+      lastAccessedTime: 0,
+      creationTime: 0
+    };
+  }
+  function readBookmark() {
+    var bookmark = {};
+    bookmark.site = readSite();
+    bookmark.isFolder = readBool();
+    var parentFolderObjectIdStr = readIdStr();
+    if (parentFolderObjectIdStr) {
+      bookmark.parentFolderObjectIdStr = parentFolderObjectIdStr;
+      bookmark.parentFolderObjectId =
+          new Uint8Array(IntArrayFromString(parentFolderObjectIdStr));
+    }
+    var prevObjectIdStr = readIdStr();
+    if (prevObjectIdStr) {
+      bookmark.prevObjectIdStr = prevObjectIdStr;
+      bookmark.prevObjectId =
+          new Uint8Array(IntArrayFromString(prevObjectIdStr));
+    }
+    var fields = readFields();
+    if (fields.length) {
+      bookmark.fields = fields;
+    }
+    bookmark.hideInToolbar = readBool();
+    bookmark.order = readString();
+    bookmark.prevOrder = readString();
+    bookmark.nextOrder = readString();
+    bookmark.parentOrder = readString();
+    return bookmark;
+  }
+  function readSiteSetting() {
+    var siteSetting = {};
+    siteSetting.hostPattern = readString();
+    siteSetting.zoomLevel = readDouble();
+    siteSetting.shieldsUp = readBool();
+    siteSetting.safeBrowsing = readBool();
+    siteSetting.noScript = readBool();
+    siteSetting.httpsEverywhere = readBool();
+    siteSetting.fingerprintingProtection = readBool();
+    siteSetting.ledgerPayments = readBool();
+    siteSetting.ledgerPaymentsShown = readBool();
+    var fields = readFields();
+    if (fields.length) {
+      siteSetting.fields = fields;
+    }
+    return siteSetting;
+  }
+
+  var version = readU8();
+  if (version != 1) {
+    console.log(`"decodeSyncRecords" unknown version=${version}`);
+    return [];
+  }
+
+  var records = [];
+  var count = readU32();
+  for (var i = 0; i < count; ++i) {
+    var record = {};
+    record.action = view.getInt8(offset++);
+    record.deviceIdStr = readIdStr();
+    record.objectIdStr = readIdStr();
+    record.deviceId = new Uint8Array();
+    record.objectId = new Uint8Array();
+    record.objectData = readString();
+    record.syncTimestamp = readDouble();
+    switch (readU8()) {
+      case 1:
+        record.bookmark = readBookmark();
+        break;
+      case 2:
+        record.historySite = readSite();
+        break;
+      case 3:
+        record.siteSetting = readSiteSetting();
+        break;
+      case 4:
+        record.device = { name: readString() };
+        break;
+    }
+    records.push(record);
+  }
+  return records;
+}
+
 function removeLocalMeta(record) {
   if ('bookmark' in record) {
     if ('prevObjectId' in record.bookmark) {
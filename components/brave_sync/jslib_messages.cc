@@ -141,6 +141,26 @@ const Device& SyncRecord::GetDevice() const {
   return *device_.get();
 }
 
+Bookmark* SyncRecord::mutable_bookmark() {
+  DCHECK(has_bookmark());
+  return bookmark_.get();
+}
+
+Site* SyncRecord::mutable_historysite() {
+  DCHECK(has_historysite());
+  return history_site_.get();
+}
+
+SiteSetting* SyncRecord::mutable_sitesetting() {
+  DCHECK(has_sitesetting());
+  return site_setting_.get();
+}
+
+Device* SyncRecord::mutable_device() {
+  DCHECK(has_device());
+  return device_.get();
+}
+
 void SyncRecord::SetBookmark(std::unique_ptr<Bookmark> bookmark) {
   DCHECK(!has_bookmark() && !has_historysite() && !has_sitesetting() && !has_device());
   bookmark_ = std::move(bookmark);
@@ -131,6 +131,10 @@ public:
   const Site& GetHistorySite() const;
   const SiteSetting& GetSiteSetting() const;
   const Device& GetDevice() const;
+  Bookmark* mutable_bookmark();
+  Site* mutable_historysite();
+  SiteSetting* mutable_sitesetting();
+  Device* mutable_device();
 
   void SetBookmark(std::unique_ptr<Bookmark> bookmark);
   void SetHistorySite(std::unique_ptr<Site> history_site);
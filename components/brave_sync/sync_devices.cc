@@ -89,6 +89,7 @@ std::unique_ptr<base::Value> SyncDevices::ToValueArrOnly() const {
 void SyncDevices::FromJson(const std::string& str_json) {
   if (str_json.empty()) {
     devices_.clear();
+    BuildIndex();
     return;
   }
 
@@ -124,21 +125,20 @@ void SyncDevices::FromJson(const std::string& str_json) {
       device_id,
       last_active) );
   }
+  BuildIndex();
 }
 
 void SyncDevices::Merge(const SyncDevice& device,
                         int action,
                         bool* actually_merged) {
   *actually_merged = false;
-  auto existing_it = std::find_if(std::begin(devices_),
-                                  std::end(devices_),
-      [device](const SyncDevice &cur_dev) {
-        return cur_dev.object_id_ == device.object_id_;
-      });
+  auto existing = indexes_by_object_id_.find(device.object_id_);
 
   switch (action) {
     case jslib_const::kActionCreate: {
-      if (existing_it == std::end(devices_)) {
+      if (existing == indexes_by_object_id_.end()) {
+        indexes_by_object_id_[device.object_id_] = devices_.size();
+        indexes_by_device_id_[device.device_id_] = devices_.size();
         devices_.push_back(device);
         *actually_merged = true;
       } else {
@@ -147,16 +147,24 @@ void SyncDevices::Merge(const SyncDevice& device,
       break;
     }
     case jslib_const::kActionUpdate: {
-      DCHECK(existing_it != std::end(devices_));
-      *existing_it = device;
+      DCHECK(existing != indexes_by_object_id_.end());
+      if (existing == indexes_by_object_id_.end())
+        break;
+      SyncDevice& existing_device = devices_[existing->second];
+      if (existing_device.device_id_ != device.device_id_) {
+        indexes_by_device_id_.erase(existing_device.device_id_);
+        indexes_by_device_id_[device.device_id_] = existing->second;
+      }
+      existing_device = device;
       *actually_merged = true;
       break;
     }
     case jslib_const::kActionDelete: {
       // Sync js lib does not merge several DELETE records into one,
-      // at this point existing_it can be equal to std::end(devices_)
-      if (existing_it != std::end(devices_)) {
-        devices_.erase(existing_it);
+      // at this point existing can be equal to indexes_by_object_id_.end()
+      if (existing != indexes_by_object_id_.end()) {
+        devices_.erase(devices_.begin() + existing->second);
+        BuildIndex();
         *actually_merged = true;
       } else {
         // ignoring delete, already deleted
@@ -167,39 +175,39 @@ void SyncDevices::Merge(const SyncDevice& device,
 }
 
 SyncDevice* SyncDevices::GetByObjectId(const std::string &object_id) {
-  for (auto& device : devices_) {
-    if (device.object_id_ == object_id) {
-      return &device;
-    }
-  }
+  auto it = indexes_by_object_id_.find(object_id);
+  if (it == indexes_by_object_id_.end())
+    return nullptr;
 
-  return nullptr;
+  return &devices_[it->second];
 }
 
 const SyncDevice* SyncDevices::GetByDeviceId(const std::string &device_id) {
-  for (const auto& device : devices_) {
-    if (device.device_id_ == device_id) {
-      return &device;
-    }
-  }
+  auto it = indexes_by_device_id_.find(device_id);
+  if (it == indexes_by_device_id_.end())
+    return nullptr;
 
-  return nullptr;
+  return &devices_[it->second];
 }
 
 void SyncDevices::DeleteByObjectId(const std::string &object_id) {
-  auto existing_it =
-      std::find_if(std::begin(devices_),
-                    std::end(devices_),
-                    [object_id](const SyncDevice &dev) {
-                      return dev.object_id_ == object_id;
-                    });
-
-  if (existing_it != std::end(devices_)) {
-    devices_.erase(existing_it);
+  auto it = indexes_by_object_id_.find(object_id);
+  if (it != indexes_by_object_id_.end()) {
+    devices_.erase(devices_.begin() + it->second);
+    BuildIndex();
   } else {
     // TODO(bridiver) - is this correct?
     NOTREACHED();
   }
 }
 
+void SyncDevices::BuildIndex() {
+  indexes_by_object_id_.clear();
+  indexes_by_device_id_.clear();
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    indexes_by_object_id_[devices_[i].object_id_] = i;
+    indexes_by_device_id_[devices_[i].device_id_] = i;
+  }
+}
+
 }  // namespace brave_sync
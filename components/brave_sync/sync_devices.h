@@ -6,6 +6,7 @@
 #define BRAVE_COMPONENTS_BRAVE_SYNC_BRAVE_SYNC_DEVICES_H_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -49,6 +50,13 @@ public:
    const SyncDevice* GetByDeviceId(const std::string& device_id);
    SyncDevice* GetByObjectId(const std::string& object_id);
    void DeleteByObjectId(const std::string& object_id);
+
+private:
+   void BuildIndex();
+
+   // Positions in |devices_|
+   std::unordered_map<std::string, size_t> indexes_by_object_id_;
+   std::unordered_map<std::string, size_t> indexes_by_device_id_;
 };
 
 } // namespace brave_sync
@@ -0,0 +1,146 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/sync_records_codec.h"
+
+#include <string.h>
+
+#include <string>
+
+#include "brave/components/brave_sync/jslib_messages.h"
+#include "brave/components/brave_sync/values_conv.h"
+
+namespace brave_sync {
+
+namespace {
+
+const uint8_t kVersion = 1;
+
+enum Kind : uint8_t {
+  KIND_NONE = 0,
+  KIND_BOOKMARK = 1,
+  KIND_HISTORY_SITE = 2,
+  KIND_SITE_SETTING = 3,
+  KIND_DEVICE = 4,
+};
+
+class Writer {
+ public:
+  explicit Writer(std::vector<uint8_t>* data) : data_(data) {}
+
+  void WriteU8(uint8_t value) {
+    data_->push_back(value);
+  }
+
+  void WriteU32(uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8)
+      data_->push_back(static_cast<uint8_t>(value >> shift));
+  }
+
+  void WriteDouble(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteU32(static_cast<uint32_t>(bits >> 32));
+    WriteU32(static_cast<uint32_t>(bits));
+  }
+
+  void WriteBool(bool value) {
+    WriteU8(value ? 1 : 0);
+  }
+
+  void WriteString(const std::string& value) {
+    WriteU32(static_cast<uint32_t>(value.size()));
+    data_->insert(data_->end(), value.begin(), value.end());
+  }
+
+  // Ids are held as a comma separated list of byte values, see
+  // UCharVecFromString
+  void WriteId(const std::string& value) {
+    const std::vector<unsigned char> bytes = UCharVecFromString(value);
+    WriteU32(static_cast<uint32_t>(bytes.size()));
+    data_->insert(data_->end(), bytes.begin(), bytes.end());
+  }
+
+  void WriteFields(const std::vector<std::string>& fields) {
+    WriteU32(static_cast<uint32_t>(fields.size()));
+    for (const auto& field : fields)
+      WriteString(field);
+  }
+
+ private:
+  std::vector<uint8_t>* data_;  // not owned
+};
+
+void WriteSite(const jslib::Site& site, Writer* writer) {
+  writer->WriteString(site.location);
+  writer->WriteString(site.title);
+  writer->WriteString(site.customTitle);
+  writer->WriteString(site.favicon);
+}
+
+void WriteBookmark(const jslib::Bookmark& bookmark, Writer* writer) {
+  WriteSite(bookmark.site, writer);
+  writer->WriteBool(bookmark.isFolder);
+  writer->WriteId(bookmark.parentFolderObjectId);
+  writer->WriteId(bookmark.prevObjectId);
+  writer->WriteFields(bookmark.fields);
+  writer->WriteBool(bookmark.hideInToolbar);
+  writer->WriteString(bookmark.order);
+  writer->WriteString(bookmark.prevOrder);
+  writer->WriteString(bookmark.nextOrder);
+  writer->WriteString(bookmark.parentOrder);
+}
+
+void WriteSiteSetting(const jslib::SiteSetting& site_setting,
+                      Writer* writer) {
+  writer->WriteString(site_setting.hostPattern);
+  writer->WriteDouble(site_setting.zoomLevel);
+  writer->WriteBool(site_setting.shieldsUp);
+  writer->WriteBool(site_setting.safeBrowsing);
+  writer->WriteBool(site_setting.noScript);
+  writer->WriteBool(site_setting.httpsEverywhere);
+  writer->WriteBool(site_setting.fingerprintingProtection);
+  writer->WriteBool(site_setting.ledgerPayments);
+  writer->WriteBool(site_setting.ledgerPaymentsShown);
+  writer->WriteFields(site_setting.fields);
+}
+
+void WriteSyncRecord(const jslib::SyncRecord& record, Writer* writer) {
+  writer->WriteU8(static_cast<uint8_t>(record.action));
+  writer->WriteId(record.deviceId);
+  writer->WriteId(record.objectId);
+  writer->WriteString(record.objectData);
+  writer->WriteDouble(record.syncTimestamp.ToJsTime());
+
+  if (record.has_bookmark()) {
+    writer->WriteU8(KIND_BOOKMARK);
+    WriteBookmark(record.GetBookmark(), writer);
+  } else if (record.has_historysite()) {
+    writer->WriteU8(KIND_HISTORY_SITE);
+    WriteSite(record.GetHistorySite(), writer);
+  } else if (record.has_sitesetting()) {
+    writer->WriteU8(KIND_SITE_SETTING);
+    WriteSiteSetting(record.GetSiteSetting(), writer);
+  } else if (record.has_device()) {
+    writer->WriteU8(KIND_DEVICE);
+    writer->WriteString(record.GetDevice().name);
+  } else {
+    writer->WriteU8(KIND_NONE);
+  }
+}
+
+}  // namespace
+
+std::vector<uint8_t> EncodeSyncRecords(const RecordsList& records) {
+  std::vector<uint8_t> data;
+  Writer writer(&data);
+  writer.WriteU8(kVersion);
+  writer.WriteU32(static_cast<uint32_t>(records.size()));
+  for (const auto& record : records)
+    WriteSyncRecord(*record, &writer);
+  return data;
+}
+
+}  // namespace brave_sync
@@ -0,0 +1,36 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SYNC_SYNC_RECORDS_CODEC_H_
+#define BRAVE_COMPONENTS_BRAVE_SYNC_SYNC_RECORDS_CODEC_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "brave/components/brave_sync/jslib_messages_fwd.h"
+
+namespace brave_sync {
+
+// Compact binary encoding of sync records, passed to the sync extension as a
+// single ArrayBuffer instead of a list of nested values. The extension
+// decodes it in background.js, see decodeSyncRecords there.
+//
+// All integers are big endian. A string is a uint32 byte length followed by
+// UTF-8, and an id is a uint32 length followed by the raw id bytes. The
+// records are preceded by a uint8 format version and a uint32 count, and
+// each one is laid out as:
+//
+//   int8 action, id deviceId, id objectId, string objectData,
+//   float64 syncTimestamp, uint8 kind, then the bookmark, history site,
+//   site setting or device for the kind, or nothing for kind 0
+//
+// Field order within each kind follows jslib_messages.h. Site times are not
+// encoded, as the extension does not sync them.
+std::vector<uint8_t> EncodeSyncRecords(const RecordsList& records);
+
+}  // namespace brave_sync
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SYNC_SYNC_RECORDS_CODEC_H_
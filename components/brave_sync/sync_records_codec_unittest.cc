@@ -0,0 +1,86 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/sync_records_codec.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "brave/components/brave_sync/jslib_messages.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=SyncRecordsCodecTest.*
+
+namespace brave_sync {
+
+namespace {
+
+SyncRecordPtr CreateBookmarkRecord() {
+  auto record = std::make_unique<jslib::SyncRecord>();
+  record->action = jslib::SyncRecord::Action::A_UPDATE;
+  record->deviceId = "3";
+  record->objectId = "121, 194, 37, 61, 199, 11, 166, 234";
+  record->objectData = "bookmark";
+  record->syncTimestamp = base::Time::FromJsTime(1565972360819);
+
+  auto bookmark = std::make_unique<jslib::Bookmark>();
+  bookmark->site.location = "https://a.com/";
+  bookmark->site.title = "A.com - title \xC3\xA9";
+  bookmark->isFolder = false;
+  bookmark->parentFolderObjectId = "0, 255, 1";
+  bookmark->fields = { "one", "" };
+  bookmark->hideInToolbar = true;
+  bookmark->order = "1.0.1.2";
+  bookmark->prevOrder = "1.0.1.1";
+  record->SetBookmark(std::move(bookmark));
+
+  return record;
+}
+
+}  // namespace
+
+TEST(SyncRecordsCodecTest, EncodesDeviceRecord) {
+  RecordsList records;
+  auto record = std::make_unique<jslib::SyncRecord>();
+  record->action = jslib::SyncRecord::Action::A_CREATE;
+  record->objectId = "1";
+  record->objectData = "device";
+  auto device = std::make_unique<jslib::Device>();
+  device->name = "device1";
+  record->SetDevice(std::move(device));
+  records.push_back(std::move(record));
+
+  const std::vector<uint8_t> expected = {
+    // version, count
+    1, 0, 0, 0, 1,
+    // action, empty device id, object id
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+    // object data
+    0, 0, 0, 6, 'd', 'e', 'v', 'i', 'c', 'e',
+    // null sync timestamp
+    0, 0, 0, 0, 0, 0, 0, 0,
+    // device kind and name
+    4, 0, 0, 0, 7, 'd', 'e', 'v', 'i', 'c', 'e', '1',
+  };
+  EXPECT_EQ(EncodeSyncRecords(records), expected);
+}
+
+TEST(SyncRecordsCodecTest, EncodesIdsAsRawBytes) {
+  RecordsList records;
+  records.push_back(CreateBookmarkRecord());
+  const std::vector<uint8_t> data = EncodeSyncRecords(records);
+
+  // version, count, action, then the length prefixed device id
+  const std::vector<uint8_t> expected_prefix = {
+    1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 3
+  };
+  ASSERT_GT(data.size(), expected_prefix.size());
+  EXPECT_EQ(std::vector<uint8_t>(data.begin(),
+                                 data.begin() + expected_prefix.size()),
+            expected_prefix);
+}
+
+}  // namespace brave_sync
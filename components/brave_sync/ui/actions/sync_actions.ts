@@ -24,6 +24,25 @@ export const onShowSettings = (settings: Sync.SettingsFromBackEnd, devices: Sync
   return action(types.SYNC_ON_SHOW_SETTINGS, { settings, devices })
 }
 
+/**
+ * Action dispatched by the back-end when sync records changed only
+ * the device list
+ * @param {Sync.DevicesFromBackEnd[]} changedDevices - the created or updated devices
+ * @param {string[]} deletedDeviceIds - the ids of the deleted devices
+ */
+export const onDevicesChanged = (changedDevices: Sync.DevicesFromBackEnd[], deletedDeviceIds: string[]) => {
+  return action(types.SYNC_ON_DEVICES_CHANGED, { changedDevices, deletedDeviceIds })
+}
+
+/**
+ * Action dispatched by the back-end while records from sync are applied
+ * @param {number} applied - the number of records applied
+ * @param {number} total - the number of records received
+ */
+export const onSyncRecordsApplyProgress = (applied: number, total: number) => {
+  return action(types.SYNC_ON_RECORDS_APPLY_PROGRESS, { applied, total })
+}
+
 /**
  * Action dispatched by the back-end when sync words are available
  * for use in the front-end
@@ -46,6 +46,14 @@ window.cr.define('sync_ui_exports', function () {
     getActions().onShowSettings(settings, devices)
   }
 
+  function devicesChanged (changedDevices: any, deletedDeviceIds: string[]) {
+    getActions().onDevicesChanged(changedDevices, deletedDeviceIds)
+  }
+
+  function syncRecordsApplyProgress (applied: number, total: number) {
+    getActions().onSyncRecordsApplyProgress(applied, total)
+  }
+
   function haveSyncWords (syncWords: string) {
     getActions().onHaveSyncWords(syncWords)
   }
@@ -67,6 +75,8 @@ window.cr.define('sync_ui_exports', function () {
   return {
     initialize,
     showSettings,
+    devicesChanged,
+    syncRecordsApplyProgress,
     haveSyncWords,
     haveSeedForQrCode,
     logMessage,
@@ -5,6 +5,8 @@
 export const enum types {
   SYNC_ON_PAGE_LOADED = '@@sync/SYNC_ON_PAGE_LOADED',
   SYNC_ON_SHOW_SETTINGS = '@@sync/SYNC_ON_SHOW_SETTINGS',
+  SYNC_ON_DEVICES_CHANGED = '@@sync/SYNC_ON_DEVICES_CHANGED',
+  SYNC_ON_RECORDS_APPLY_PROGRESS = '@@sync/SYNC_ON_RECORDS_APPLY_PROGRESS',
   SYNC_ON_HAVE_SYNC_WORDS = '@@sync/SYNC_ON_HAVE_SYNC_WORDS',
   SYNC_ON_HAVE_SEED_FOR_QR_CODE = '@@sync/SYNC_ON_HAVE_SEED_FOR_QR_CODE',
   SYNC_ON_SETUP_NEW_TO_SYNC = '@@sync/SYNC_ON_SETUP_NEW_TO_SYNC',
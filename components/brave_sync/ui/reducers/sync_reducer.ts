@@ -11,6 +11,14 @@ import { types } from '../constants/sync_types'
 import * as storage from '../storage'
 import { generateQRCodeImageSource } from '../helpers'
 
+const getDeviceFromBackEnd = (device: Sync.DevicesFromBackEnd) => {
+  return {
+    name: device.name,
+    id: device.device_id,
+    lastActive: (new Date(device.last_active)).toDateString()
+  }
+}
+
 const syncReducer: Reducer<Sync.State | undefined> = (state: Sync.State | undefined, action: any) => {
   if (state === undefined) {
     state = storage.load()
@@ -30,13 +38,7 @@ const syncReducer: Reducer<Sync.State | undefined> = (state: Sync.State | undefi
       break
 
     case types.SYNC_ON_SHOW_SETTINGS:
-      const devices = payload.devices.map((device: Sync.DevicesFromBackEnd) => {
-        return {
-          name: device.name,
-          id: device.device_id,
-          lastActive: (new Date(device.last_active)).toDateString()
-        }
-      })
+      const devices = payload.devices.map(getDeviceFromBackEnd)
 
       state = {
         ...state,
@@ -64,6 +66,30 @@ const syncReducer: Reducer<Sync.State | undefined> = (state: Sync.State | undefi
       }
       break
 
+    case types.SYNC_ON_DEVICES_CHANGED:
+      const changedDevices = payload.changedDevices.map(getDeviceFromBackEnd)
+      const changedIds = changedDevices.map((device: Sync.Devices) => String(device.id))
+      const removedIds = [ ...payload.deletedDeviceIds, ...changedIds ]
+      state = {
+        ...state,
+        devices: [
+          ...state.devices.filter((device: Sync.Devices) =>
+            removedIds.indexOf(String(device.id)) === -1),
+          ...changedDevices
+        ]
+      }
+      break
+
+    case types.SYNC_ON_RECORDS_APPLY_PROGRESS:
+      // Cleared once every record has been applied
+      state = {
+        ...state,
+        recordsApplyProgress: payload.applied < payload.total
+          ? { applied: payload.applied, total: payload.total }
+          : undefined
+      }
+      break
+
     case types.SYNC_ON_HAVE_SEED_FOR_QR_CODE:
       if (!payload.seed) {
         break
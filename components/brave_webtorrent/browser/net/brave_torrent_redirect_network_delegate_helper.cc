@@ -15,6 +15,7 @@
 #include "brave/common/extensions/extension_constants.h"
 #include "chrome/browser/profiles/profile_io_data.h"
 #include "content/public/browser/resource_request_info.h"
+#include "content/public/common/resource_type.h"
 #include "extensions/browser/info_map.h"
 #include "extensions/common/constants.h"
 #include "net/http/http_content_disposition.h"
@@ -64,6 +65,15 @@ bool IsTorrentFile(net::URLRequest* request,
   return false;
 }
 
+// Only navigations can be redirected to the webtorrent viewer, so responses
+// to subresource requests skip the header checks. Requests whose type is
+// unknown are still checked.
+bool IsNavigationCandidate(const brave::BraveRequestInfo& ctx) {
+  return ctx.resource_type == brave::BraveRequestInfo::kInvalidResourceType ||
+      ctx.resource_type == content::ResourceType::kMainFrame ||
+      ctx.resource_type == content::ResourceType::kSubFrame;
+}
+
 bool IsWebtorrentInitiated(net::URLRequest* request) {
   return request->initiator().has_value() &&
     request->initiator()->GetURL().spec() ==
@@ -123,6 +133,7 @@ int OnHeadersReceived_TorrentRedirectWork(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
 
   if (!request || !original_response_headers ||
+      !IsNavigationCandidate(*ctx) ||
       IsTorProfile(request) ||
       IsWebTorrentDisabled(request) ||
       IsWebtorrentInitiated(request) ||  // download .torrent, do not redirect
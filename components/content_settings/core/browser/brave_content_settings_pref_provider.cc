@@ -4,12 +4,46 @@
 
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 
+#include <set>
+
 #include "base/bind.h"
+#include "base/no_destructor.h"
 #include "components/content_settings/core/browser/content_settings_pref.h"
 #include "components/content_settings/core/browser/website_settings_registry.h"
 
 namespace content_settings {
 
+namespace {
+
+int g_batch_update_depth = 0;
+
+// Providers whose shields changes are held back by a ScopedBatchUpdate.
+std::set<BravePrefProvider*>& GetProvidersPendingNotification() {
+  static base::NoDestructor<std::set<BravePrefProvider*>> providers;
+  return *providers;
+}
+
+}  // namespace
+
+BravePrefProvider::ScopedBatchUpdate::ScopedBatchUpdate() {
+  ++g_batch_update_depth;
+}
+
+BravePrefProvider::ScopedBatchUpdate::~ScopedBatchUpdate() {
+  DCHECK_GT(g_batch_update_depth, 0);
+  if (--g_batch_update_depth > 0)
+    return;
+
+  std::set<BravePrefProvider*> providers;
+  providers.swap(GetProvidersPendingNotification());
+  for (BravePrefProvider* provider : providers) {
+    provider->Notify(ContentSettingsPattern::Wildcard(),
+                     ContentSettingsPattern::Wildcard(),
+                     CONTENT_SETTINGS_TYPE_PLUGINS,
+                     std::string());
+  }
+}
+
 BravePrefProvider::BravePrefProvider(PrefService* prefs,
                                      bool incognito,
                                      bool store_last_modified)
@@ -27,13 +61,15 @@ BravePrefProvider::BravePrefProvider(PrefService* prefs,
               info->type(), prefs_, &brave_pref_change_registrar_,
               info->pref_name(),
               is_incognito_,
-              base::Bind(&PrefProvider::Notify, base::Unretained(this)))));
+              base::Bind(&BravePrefProvider::OnShieldsSettingChanged,
+                         base::Unretained(this)))));
       return;
     }
   }
 }
 
 void BravePrefProvider::ShutdownOnUIThread() {
+  GetProvidersPendingNotification().erase(this);
   brave_pref_change_registrar_.RemoveAll();
   PrefProvider::ShutdownOnUIThread();
 }
@@ -58,4 +94,17 @@ bool BravePrefProvider::SetWebsiteSetting(
       content_type, resource_identifier, in_value);
 }
 
+void BravePrefProvider::OnShieldsSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  if (g_batch_update_depth > 0) {
+    GetProvidersPendingNotification().insert(this);
+    return;
+  }
+  Notify(primary_pattern, secondary_pattern, content_type,
+         resource_identifier);
+}
+
 }  // namespace content_settings
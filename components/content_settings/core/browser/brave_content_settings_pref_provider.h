@@ -5,6 +5,8 @@
 #ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_CONTENT_SETTINGS_PREF_PROVIDER_H_
 #define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_CONTENT_SETTINGS_PREF_PROVIDER_H_
 
+#include <string>
+
 #include "components/content_settings/core/browser/content_settings_pref_provider.h"
 #include "components/prefs/pref_change_registrar.h"
 
@@ -17,8 +19,22 @@ namespace content_settings {
 // Because of this reasion, shields configuration was also ephemeral.
 // However, we want shilelds configuration persisted. To do this, we make
 // EphemeralProvider ignore shields type and this class handles.
+//
+// Shields settings written while a ScopedBatchUpdate is alive are notified
+// once, when the outermost one goes away, as a change of every plugin
+// setting. Observers then refresh once instead of once per rule.
 class BravePrefProvider : public PrefProvider {
  public:
+  // Must only be used on the UI thread.
+  class ScopedBatchUpdate {
+   public:
+    ScopedBatchUpdate();
+    ~ScopedBatchUpdate();
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(ScopedBatchUpdate);
+  };
+
   BravePrefProvider(
       PrefService* prefs, bool incognito, bool store_last_modified);
   ~BravePrefProvider() override {}
@@ -33,6 +49,11 @@ class BravePrefProvider : public PrefProvider {
       const ResourceIdentifier& resource_identifier,
       base::Value* value) override;
 
+  void OnShieldsSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type,
+                               const std::string& resource_identifier);
+
   // PrefProvider::pref_change_registrar_ alreay has plugin type.
   PrefChangeRegistrar brave_pref_change_registrar_;
 
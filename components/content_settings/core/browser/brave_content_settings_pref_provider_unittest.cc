@@ -0,0 +1,143 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=BravePrefProviderTest.*
+
+namespace {
+
+class CountingObserver : public content_settings::Observer {
+ public:
+  CountingObserver() {}
+  ~CountingObserver() override {}
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(
+      const ContentSettingsPattern& primary_pattern,
+      const ContentSettingsPattern& secondary_pattern,
+      ContentSettingsType content_type,
+      const std::string& resource_identifier) override {
+    if (content_type == CONTENT_SETTINGS_TYPE_PLUGINS)
+      ++count_;
+  }
+
+  int count() const { return count_; }
+
+ private:
+  int count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingObserver);
+};
+
+}  // namespace
+
+class BravePrefProviderTest : public testing::Test {
+ public:
+  void SetUp() override {
+    profile_ = std::make_unique<TestingProfile>();
+    map_ = HostContentSettingsMapFactory::GetForProfile(profile_.get());
+    map_->AddObserver(&observer_);
+  }
+
+  void TearDown() override {
+    map_->RemoveObserver(&observer_);
+  }
+
+ protected:
+  brave_shields::ShieldsSettingRule CreateRule(const std::string& host,
+                                               const std::string& resource,
+                                               ContentSetting setting) {
+    brave_shields::ShieldsSettingRule rule;
+    rule.primary_pattern = ContentSettingsPattern::FromString(host);
+    rule.secondary_pattern = ContentSettingsPattern::Wildcard();
+    rule.resource_identifier = resource;
+    rule.setting = setting;
+    return rule;
+  }
+
+  ContentSetting GetSetting(const std::string& url,
+                            const std::string& resource) {
+    return map_->GetContentSetting(GURL(url), GURL(),
+                                   CONTENT_SETTINGS_TYPE_PLUGINS, resource);
+  }
+
+  content::TestBrowserThreadBundle test_browser_thread_bundle_;
+  std::unique_ptr<TestingProfile> profile_;
+  HostContentSettingsMap* map_;
+  CountingObserver observer_;
+};
+
+TEST_F(BravePrefProviderTest, SetShieldsSettingsNotifiesOnce) {
+  std::vector<brave_shields::ShieldsSettingRule> rules = {
+    CreateRule("[*.]brave.com", brave_shields::kAds, CONTENT_SETTING_ALLOW),
+    CreateRule("[*.]brave.com", brave_shields::kTrackers,
+               CONTENT_SETTING_ALLOW),
+    CreateRule("[*.]example.com", brave_shields::kBraveShields,
+               CONTENT_SETTING_BLOCK),
+  };
+  brave_shields::SetShieldsSettings(map_, rules);
+
+  EXPECT_EQ(1, observer_.count());
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting("https://brave.com", brave_shields::kAds));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting("https://www.brave.com", brave_shields::kTrackers));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            GetSetting("https://example.com", brave_shields::kBraveShields));
+
+  // Setting default removes the rules.
+  rules = {
+    CreateRule("[*.]brave.com", brave_shields::kAds, CONTENT_SETTING_DEFAULT),
+    CreateRule("[*.]brave.com", brave_shields::kTrackers,
+               CONTENT_SETTING_DEFAULT),
+  };
+  brave_shields::SetShieldsSettings(map_, rules);
+
+  EXPECT_EQ(2, observer_.count());
+  EXPECT_NE(CONTENT_SETTING_ALLOW,
+            GetSetting("https://brave.com", brave_shields::kAds));
+  EXPECT_NE(CONTENT_SETTING_ALLOW,
+            GetSetting("https://brave.com", brave_shields::kTrackers));
+}
+
+TEST_F(BravePrefProviderTest, NestedBatchUpdatesNotifyOnce) {
+  {
+    content_settings::BravePrefProvider::ScopedBatchUpdate outer;
+    brave_shields::SetShieldsSettings(map_, {
+      CreateRule("[*.]brave.com", brave_shields::kAds, CONTENT_SETTING_ALLOW),
+    });
+    map_->SetContentSettingCustomScope(
+        ContentSettingsPattern::FromString("[*.]brave.com"),
+        ContentSettingsPattern::Wildcard(), CONTENT_SETTINGS_TYPE_PLUGINS,
+        brave_shields::kTrackers, CONTENT_SETTING_ALLOW);
+    EXPECT_EQ(0, observer_.count());
+  }
+
+  EXPECT_EQ(1, observer_.count());
+}
+
+TEST_F(BravePrefProviderTest, SingleSettingNotifiesImmediately) {
+  map_->SetContentSettingCustomScope(
+      ContentSettingsPattern::FromString("[*.]brave.com"),
+      ContentSettingsPattern::Wildcard(), CONTENT_SETTINGS_TYPE_PLUGINS,
+      brave_shields::kAds, CONTENT_SETTING_ALLOW);
+
+  EXPECT_EQ(1, observer_.count());
+}
@@ -6,9 +6,12 @@
 #include "brave/components/content_settings/core/browser/brave_cookie_settings.h"
 
 #include "base/bind.h"
+#include "base/no_destructor.h"
 #include "brave/common/brave_cookie_blocking.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/cookie_settings_base.h"
 #include "components/prefs/pref_service.h"
 #include "extensions/buildflags/buildflags.h"
@@ -19,6 +22,16 @@ namespace content_settings {
 
 using namespace net::registry_controlled_domains;  // NOLINT
 
+namespace {
+
+const GURL& GetFirstPartyURL() {
+  static const base::NoDestructor<GURL> first_party_url(
+      "https://firstParty/");
+  return *first_party_url;
+}
+
+}  // namespace
+
 BraveCookieSettings::BraveCookieSettings(
     HostContentSettingsMap* host_content_settings_map,
     PrefService* prefs,
@@ -34,6 +47,54 @@ BraveCookieSettings::BraveCookieSettings(
 
 BraveCookieSettings::~BraveCookieSettings() {}
 
+ContentSetting BraveCookieSettings::GetShieldsContentSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    const std::string& resource_identifier) const {
+  ContentSetting setting = CONTENT_SETTING_DEFAULT;
+  if (!brave_shields::ShieldsSettingsCache::GetInstance()->GetContentSetting(
+          host_content_settings_map_.get(), primary_url, secondary_url,
+          resource_identifier, &setting)) {
+    setting = host_content_settings_map_->GetContentSetting(
+        primary_url, secondary_url, CONTENT_SETTINGS_TYPE_PLUGINS,
+        resource_identifier);
+  }
+  return setting;
+}
+
+BraveCookieSettings::ShieldsCookieSettings
+BraveCookieSettings::GetShieldsCookieSettings(const GURL& primary_url) const {
+  ShieldsCookieSettings settings;
+
+  // Patterns for other schemes, such as file:, can match on the path
+  brave_shields::ShieldsSettingsSnapshot snapshot;
+  if (primary_url.SchemeIsHTTPOrHTTPS() &&
+      brave_shields::ShieldsSettingsCache::GetInstance()->Get(
+          host_content_settings_map_.get(), primary_url.GetOrigin(),
+          &snapshot)) {
+    settings.allow_brave_shields = snapshot.allow_brave_shields;
+    settings.allow_1p_cookies = snapshot.allow_1p_cookies;
+    settings.allow_3p_cookies = snapshot.allow_3p_cookies;
+    return settings;
+  }
+
+  // Not stored, as the snapshot holds more settings than cookies need
+  ContentSetting brave_shields_setting = GetShieldsContentSetting(
+      primary_url, GURL(), brave_shields::kBraveShields);
+  ContentSetting brave_1p_setting = GetShieldsContentSetting(
+      primary_url, GetFirstPartyURL(), brave_shields::kCookies);
+  ContentSetting brave_3p_setting = GetShieldsContentSetting(
+      primary_url, GURL(), brave_shields::kCookies);
+
+  settings.allow_brave_shields =
+      brave_shields_setting == CONTENT_SETTING_ALLOW ||
+      brave_shields_setting == CONTENT_SETTING_DEFAULT;
+  settings.allow_1p_cookies = brave_1p_setting == CONTENT_SETTING_ALLOW ||
+                              brave_1p_setting == CONTENT_SETTING_DEFAULT;
+  settings.allow_3p_cookies = brave_3p_setting == CONTENT_SETTING_ALLOW;
+  return settings;
+}
+
 void BraveCookieSettings::GetCookieSetting(
     const GURL& url,
     const GURL& first_party_url,
@@ -78,25 +139,10 @@ void BraveCookieSettings::GetCookieSetting(
       (tab_url == GURL("about:blank") || tab_url.is_empty() ? first_party_url
                                                             : tab_url);
 
-  ContentSetting brave_shields_setting =
-      host_content_settings_map_->GetContentSetting(
-          primary_url, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
-          brave_shields::kBraveShields);
-  ContentSetting brave_1p_setting =
-      host_content_settings_map_->GetContentSetting(
-          primary_url, GURL("https://firstParty/"),
-          CONTENT_SETTINGS_TYPE_PLUGINS, brave_shields::kCookies);
-  ContentSetting brave_3p_setting =
-      host_content_settings_map_->GetContentSetting(
-          primary_url, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
-          brave_shields::kCookies);
-
-  bool allow_brave_shields = brave_shields_setting == CONTENT_SETTING_ALLOW ||
-                             brave_shields_setting == CONTENT_SETTING_DEFAULT;
-  bool allow_1p_cookies = brave_1p_setting == CONTENT_SETTING_ALLOW ||
-                          brave_1p_setting == CONTENT_SETTING_DEFAULT;
-  bool allow_3p_cookies = brave_3p_setting == CONTENT_SETTING_ALLOW;
-  if (ShouldBlockCookie(allow_brave_shields, allow_1p_cookies, allow_3p_cookies,
+  const ShieldsCookieSettings settings = GetShieldsCookieSettings(primary_url);
+  if (ShouldBlockCookie(settings.allow_brave_shields,
+                        settings.allow_1p_cookies,
+                        settings.allow_3p_cookies,
                         first_party_url, url, allow_google_auth_)) {
     *cookie_setting = CONTENT_SETTING_BLOCK;
   }
@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_COOKIE_SETTINGS_H_
 #define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_COOKIE_SETTINGS_H_
 
+#include <string>
+
 #include "components/content_settings/core/browser/cookie_settings.h"
 
 class HostContentSettingsMap;
@@ -47,9 +49,25 @@ class BraveCookieSettings : public CookieSettings {
   bool GetAllowGoogleAuth() const { return allow_google_auth_; }
 
  protected:
+  // The shields settings a cookie decision needs for one tab origin.
+  struct ShieldsCookieSettings {
+    bool allow_brave_shields;
+    bool allow_1p_cookies;
+    bool allow_3p_cookies;
+  };
+
   ~BraveCookieSettings() override;
   void OnAllowGoogleAuthChanged();
 
+  // Cookie decisions are made for every cookie read and write, so they come
+  // from the ShieldsSettingsCache the network delegate fills for each tab
+  // origin, or else through its rules indexes.
+  ShieldsCookieSettings GetShieldsCookieSettings(const GURL& primary_url) const;
+  ContentSetting GetShieldsContentSetting(
+      const GURL& primary_url,
+      const GURL& secondary_url,
+      const std::string& resource_identifier) const;
+
   bool allow_google_auth_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveCookieSettings);
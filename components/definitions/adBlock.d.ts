@@ -6,6 +6,7 @@ declare namespace AdBlock {
   export interface State {
     settings: {
       customFilters: string
+      customFilterErrors: FilterError[]
       regionalLists: FilterList[]
     },
     stats: {
@@ -14,6 +15,11 @@ declare namespace AdBlock {
     }
   }
 
+  export interface FilterError {
+    rule: string
+    error: string
+  }
+
   export interface FilterList {
     uuid: string
     url: string
@@ -22,5 +28,15 @@ declare namespace AdBlock {
     componentId: string
     base64PublicKey: string
     enabled: boolean
+    // Only set for enabled lists
+    stats?: FilterListStats
+  }
+
+  export interface FilterListStats {
+    rules_loaded: number
+    memory_bytes: number
+    requests_checked: number
+    requests_matched: number
+    match_time_ms: number
   }
 }
@@ -75,6 +75,7 @@ declare namespace chrome.braveRewards {
   const refreshPublisher: (publisherKey: string, callback: (enabled: boolean, publisherKey: string) => void) => {}
   const getAllNotifications: (callback: (list: RewardsExtension.Notification[]) => void) => {}
   const getInlineTipSetting: (key: string, callback: (enabled: boolean) => void) => {}
+  const getPanelState: (windowId: number, callback: (state: RewardsExtension.PanelState) => void) => {}
 }
 
 declare namespace chrome.rewardsNotifications {
@@ -110,6 +111,26 @@ interface BlockDetails {
   tabId: number
   subresource: string
 }
+
+interface BlockedResource {
+  blockType: BlockTypes
+  subresource: string
+}
+
+interface BlockedCounts {
+  tabId: number
+  ads: number
+  trackers: number
+  httpsUpgrades: number
+  javascript: number
+  fingerprinting: number
+}
+
+interface BlockedResources {
+  tabId: number
+  resources: BlockedResource[]
+  counts: BlockedCounts
+}
 declare namespace chrome.tabs {
   const setAsync: any
   const getAsync: any
@@ -121,11 +142,13 @@ declare namespace chrome.windows {
 
 declare namespace chrome.braveShields {
   const onBlocked: {
-    addListener: (callback: (detail: BlockDetails) => void) => void
-    emit: (detail: BlockDetails) => void
+    addListener: (callback: (details: BlockedResources) => void) => void
+    emit: (details: BlockedResources) => void
   }
 
   const allowScriptsOnce: any
+  const getShieldsState: (tabId: number, callback: (state: any) => void) => void
+  const setContentSettings: (rules: any[], callback?: () => void) => void
   const javascript: any
   const plugins: any
 }
@@ -136,6 +136,14 @@ declare namespace RewardsExtension {
     recurringTips: Record<string, number>[]
   }
 
+  interface PanelState {
+    enabledMain: boolean
+    enabledAC: boolean
+    pendingContributionsTotal: number
+    recurringTips: RecurringTips
+    notifications: Notification[]
+  }
+
   interface PublisherBanner {
     publisherKey: string
     name: string
@@ -12,6 +12,7 @@ declare namespace RewardsInternals {
       personaId: string
       userId: string
       bootStamp: number
+      perfStats: PerfStat[]
     }
   }
 
@@ -21,4 +22,12 @@ declare namespace RewardsInternals {
     retryStep: number
     retryLevel: number
   }
+
+  export interface PerfStat {
+    name: string
+    count: number
+    totalMs: number
+    maxMs: number
+    lastMs: number
+  }
 }
@@ -23,6 +23,11 @@ declare namespace Sync {
     lastActive: number
   }
 
+  export interface RecordsApplyProgress {
+    applied: number
+    total: number
+  }
+
 export type SetupErrorType =
   'ERR_SYNC_MISSING_WORDS' |
   'ERR_SYNC_WRONG_WORDS' |
@@ -41,5 +46,6 @@ export type SetupErrorType =
     syncSavedSiteSettings: boolean
     syncBrowsingHistory: boolean
     error: SetupErrorType
+    recordsApplyProgress?: RecordsApplyProgress
   }
 }
@@ -7,16 +7,97 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <string>
+#include <vector>
 
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/trace_event/trace_event.h"
 #include "components/omnibox/browser/autocomplete_input.h"
 #include "components/omnibox/browser/history_provider.h"
 
+namespace {
+
+// Every suffix of every top site, sorted, so that the sites containing the
+// input are found with a binary search instead of searching each site.
+class TopSitesIndex {
+ public:
+  explicit TopSitesIndex(const std::vector<std::string>& sites)
+      : sites_(sites) {
+    for (size_t site = 0; site < sites_.size(); ++site) {
+      for (size_t offset = 0; offset < sites_[site].length(); ++offset)
+        suffixes_.push_back({site, offset});
+    }
+    std::sort(suffixes_.begin(), suffixes_.end(),
+        [this](const Suffix& a, const Suffix& b) {
+          return GetSuffix(a) < GetSuffix(b);
+        });
+  }
+
+  // Returns up to |max_sites| indexes of the sites containing |text|, in the
+  // order the sites are listed.
+  std::vector<size_t> FindSites(const std::string& text,
+                                size_t max_sites) const {
+    std::vector<size_t> found;
+    if (text.empty()) {
+      for (size_t site = 0; site < sites_.size() && site < max_sites; ++site)
+        found.push_back(site);
+      return found;
+    }
+
+    // Suffixes starting with |text| are adjacent in sorted order
+    const base::StringPiece prefix(text);
+    auto it = std::lower_bound(suffixes_.begin(), suffixes_.end(), prefix,
+        [this](const Suffix& suffix, base::StringPiece prefix) {
+          return GetSuffix(suffix) < prefix;
+        });
+    for (; it != suffixes_.end() &&
+           base::StartsWith(GetSuffix(*it), prefix,
+                            base::CompareCase::SENSITIVE);
+         ++it) {
+      // Keep the first |max_sites| in list order, as the list is ordered by
+      // popularity
+      auto pos = std::lower_bound(found.begin(), found.end(), it->site);
+      if (pos != found.end() && *pos == it->site)
+        continue;
+      if (found.size() == max_sites) {
+        if (pos == found.end())
+          continue;
+        found.pop_back();
+      }
+      found.insert(pos, it->site);
+    }
+    return found;
+  }
+
+ private:
+  struct Suffix {
+    size_t site;
+    size_t offset;
+  };
+
+  base::StringPiece GetSuffix(const Suffix& suffix) const {
+    return base::StringPiece(sites_[suffix.site]).substr(suffix.offset);
+  }
+
+  const std::vector<std::string>& sites_;
+  std::vector<Suffix> suffixes_;
+
+  DISALLOW_COPY_AND_ASSIGN(TopSitesIndex);
+};
+
+}  // namespace
+
 // As from autocomplete_provider.h:
 // Search Secondary Provider (suggestion)                              |  100++
 const int TopSitesProvider::kRelevance = 100;
 
+const char TopSitesProvider::kProviderTimeHistogram[] =
+    "Brave.Omnibox.ProviderTime.TopSites";
+
 
 TopSitesProvider::TopSitesProvider(AutocompleteProviderClient* client)
     : AutocompleteProvider(AutocompleteProvider::TYPE_SEARCH) {
@@ -24,6 +105,10 @@ TopSitesProvider::TopSitesProvider(AutocompleteProviderClient* client)
 
 void TopSitesProvider::Start(const AutocompleteInput& input,
                             bool minimal_changes) {
+  // Brave's providers are traced in the omnibox category, next to the
+  // autocomplete controller they run in.
+  TRACE_EVENT0("omnibox", "Brave.TopSitesProvider::Start");
+  SCOPED_UMA_HISTOGRAM_TIMER(kProviderTimeHistogram);
   matches_.clear();
   if (input.from_omnibox_focus() ||
       (input.type() == metrics::OmniboxInputType::INVALID) ||
@@ -33,15 +118,12 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
 
-  for (std::vector<std::string>::const_iterator i = top_sites_.begin();
-    (i != top_sites_.end()) && (matches_.size() < kMaxMatches); ++i) {
-
-    const std::string &current_site = *i;
+  static const base::NoDestructor<TopSitesIndex> index(top_sites_);
+  for (size_t site : index->FindSites(input_text, kMaxMatches)) {
+    const std::string &current_site = top_sites_[site];
     size_t foundPos = current_site.find(input_text);
-    if (std::string::npos != foundPos) {
-      ACMatchClassifications styles = StylesForSingleMatch(input_text, current_site, foundPos);
-      AddMatch(base::ASCIIToUTF16(current_site), styles);
-    }
+    ACMatchClassifications styles = StylesForSingleMatch(input_text, current_site, foundPos);
+    AddMatch(base::ASCIIToUTF16(current_site), styles);
   }
 
   for (size_t i = 0; i < matches_.size(); ++i)
@@ -20,6 +20,11 @@ class TopSitesProvider : public AutocompleteProvider {
  public:
   explicit TopSitesProvider(AutocompleteProviderClient* client);
 
+  // Records the time each Start() takes. Chromium's own per provider
+  // histograms are keyed by provider type, which this provider shares with
+  // the search provider, so it records its own.
+  static const char kProviderTimeHistogram[];
+
   // AutocompleteProvider:
   void Start(const AutocompleteInput& input, bool minimal_changes) override;
 
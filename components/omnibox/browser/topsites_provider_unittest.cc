@@ -42,3 +42,20 @@ TEST_F(TopSitesProviderTest, SmokeTest) {
   provider_->Start(CreateAutocompleteInput("테스트"), false);
   EXPECT_TRUE(provider_->matches().empty());
 }
+
+// Matches are the first sites in the list containing the input, wherever in
+// the site it is found.
+TEST_F(TopSitesProviderTest, MatchesInListOrder) {
+  provider_->Start(CreateAutocompleteInput("google"), false);
+  ASSERT_GE(provider_->matches().size(), 3u);
+  EXPECT_EQ(provider_->matches()[0].contents, base::ASCIIToUTF16("google.com"));
+  EXPECT_EQ(provider_->matches()[1].contents,
+            base::ASCIIToUTF16("mail.google.com"));
+  EXPECT_EQ(provider_->matches()[2].contents,
+            base::ASCIIToUTF16("maps.google.com"));
+
+  provider_->Start(CreateAutocompleteInput("ail.goo"), false);
+  ASSERT_FALSE(provider_->matches().empty());
+  EXPECT_EQ(provider_->matches()[0].contents,
+            base::ASCIIToUTF16("mail.google.com"));
+}
@@ -18,6 +18,9 @@ namespace bat_ads {
 
 namespace {
 
+const size_t kMaximumPendingEventLogs = 50;
+const int kFlushEventLogsAfterSeconds = 10;
+
 int32_t ToMojomURLRequestMethod(
     ads::URLRequestMethod method) {
   return (int32_t)method;
@@ -73,7 +76,9 @@ BatAdsClientMojoBridge::BatAdsClientMojoBridge(
   bat_ads_client_.Bind(std::move(client_info));
 }
 
-BatAdsClientMojoBridge::~BatAdsClientMojoBridge() {}
+BatAdsClientMojoBridge::~BatAdsClientMojoBridge() {
+  FlushEventLogs();
+}
 
 bool BatAdsClientMojoBridge::IsAdsEnabled() const {
   if (!connected())
@@ -341,7 +346,32 @@ void BatAdsClientMojoBridge::EventLog(const std::string& json) {
   if (!connected())
     return;
 
-  bat_ads_client_->EventLog(json);
+  pending_event_logs_.push_back(json);
+  if (pending_event_logs_.size() >= kMaximumPendingEventLogs) {
+    FlushEventLogs();
+    return;
+  }
+
+  if (!event_log_timer_.IsRunning()) {
+    event_log_timer_.Start(FROM_HERE,
+        base::TimeDelta::FromSeconds(kFlushEventLogsAfterSeconds), this,
+        &BatAdsClientMojoBridge::FlushEventLogs);
+  }
+}
+
+void BatAdsClientMojoBridge::FlushEventLogs() {
+  event_log_timer_.Stop();
+
+  if (pending_event_logs_.empty())
+    return;
+
+  std::vector<std::string> json_events;
+  json_events.swap(pending_event_logs_);
+
+  if (!connected())
+    return;
+
+  bat_ads_client_->EventLog(json_events);
 }
 
 std::unique_ptr<ads::LogStream> BatAdsClientMojoBridge::Log(
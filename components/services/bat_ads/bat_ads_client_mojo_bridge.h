@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "bat/ads/ads_client.h"
+#include "base/timer/timer.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 
 namespace bat_ads {
@@ -71,8 +72,15 @@ class BatAdsClientMojoBridge : public ads::AdsClient {
  private:
   bool connected() const;
 
+  // Sends the buffered events in one message, so frequent tab events do not
+  // each cost a round of IPC
+  void FlushEventLogs();
+
   mojom::BatAdsClientAssociatedPtr bat_ads_client_;
 
+  std::vector<std::string> pending_event_logs_;
+  base::OneShotTimer event_log_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(BatAdsClientMojoBridge);
 };
 
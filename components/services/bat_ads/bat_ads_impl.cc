@@ -8,6 +8,10 @@
 #include <utility>
 
 #include "bat/ads/ads.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "brave/components/services/bat_ads/bat_ads_client_mojo_bridge.h"
 
 namespace bat_ads {
@@ -24,9 +28,30 @@ ads::NotificationResultInfoResultType ToNotificationResultInfoResultType(
 BatAdsImpl::BatAdsImpl(mojom::BatAdsClientAssociatedPtrInfo client_info)
     : bat_ads_client_mojo_proxy_(
           new BatAdsClientMojoBridge(std::move(client_info))),
-      ads_(ads::Ads::CreateInstance(bat_ads_client_mojo_proxy_.get())) {}
+      ads_(ads::Ads::CreateInstance(bat_ads_client_mojo_proxy_.get())) {
+  base::trace_event::MemoryDumpManager::GetInstance()
+      ->RegisterDumpProviderWithSequencedTaskRunner(
+          this, "BatAds", base::SequencedTaskRunnerHandle::Get(),
+          base::trace_event::MemoryDumpProvider::Options());
+}
+
+BatAdsImpl::~BatAdsImpl() {
+  base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+      this);
+}
+
+bool BatAdsImpl::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  for (const auto& usage : ads_->GetMemoryUsage()) {
+    auto* dump = pmd->CreateAllocatorDump("bat_ads/" + usage.first);
+    dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                    base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                    usage.second);
+  }
 
-BatAdsImpl::~BatAdsImpl() {}
+  return true;
+}
 
 void BatAdsImpl::Initialize(InitializeCallback callback) {
   // TODO(Terry Mancey): Initialize needs a real callback
@@ -84,6 +109,16 @@ void BatAdsImpl::RemoveAllHistory(RemoveAllHistoryCallback callback) {
   std::move(callback).Run();
 }
 
+void BatAdsImpl::RemoveHistoryInRange(uint64_t from_timestamp_in_seconds,
+                                      uint64_t to_timestamp_in_seconds) {
+  ads_->RemoveHistoryInRange(from_timestamp_in_seconds,
+                             to_timestamp_in_seconds);
+}
+
+void BatAdsImpl::RemoveHistoryForUrls(const std::vector<std::string>& urls) {
+  ads_->RemoveHistoryForUrls(urls);
+}
+
 void BatAdsImpl::SetConfirmationsIsReady(const bool is_ready) {
   ads_->SetConfirmationsIsReady(is_ready);
 }
@@ -8,7 +8,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/trace_event/memory_dump_provider.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 
@@ -20,7 +22,8 @@ namespace bat_ads {
 
 class BatAdsClientMojoBridge;
 
-class BatAdsImpl : public mojom::BatAds {
+class BatAdsImpl : public mojom::BatAds,
+                   public base::trace_event::MemoryDumpProvider {
  public:
   explicit BatAdsImpl(mojom::BatAdsClientAssociatedPtrInfo client_info);
   ~BatAdsImpl() override;
@@ -42,6 +45,9 @@ class BatAdsImpl : public mojom::BatAds {
                   bool is_active,
                   bool is_incognito) override;
   void RemoveAllHistory(RemoveAllHistoryCallback callback) override;
+  void RemoveHistoryInRange(uint64_t from_timestamp_in_seconds,
+                            uint64_t to_timestamp_in_seconds) override;
+  void RemoveHistoryForUrls(const std::vector<std::string>& urls) override;
   void SetConfirmationsIsReady(const bool is_ready) override;
   void ServeSampleAd() override;
   void GenerateAdReportingNotificationShownEvent(
@@ -50,6 +56,10 @@ class BatAdsImpl : public mojom::BatAds {
       const std::string& notification_info,
       int32_t event_type) override;
 
+  // Overridden from base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
  private:
   std::unique_ptr<BatAdsClientMojoBridge> bat_ads_client_mojo_proxy_;
   std::unique_ptr<ads::Ads> ads_;
@@ -177,8 +177,11 @@ void AdsClientMojoBridge::GetClientInfo(const std::string& client_info,
   std::move(callback).Run(info.ToJson());
 }
 
-void AdsClientMojoBridge::EventLog(const std::string& json) {
-  ads_client_->EventLog(json);
+void AdsClientMojoBridge::EventLog(
+    const std::vector<std::string>& json_events) {
+  for (const auto& json : json_events) {
+    ads_client_->EventLog(json);
+  }
 }
 
 // static
@@ -55,7 +55,7 @@ class AdsClientMojoBridge : public mojom::BatAdsClient,
   void GetClientInfo(const std::string& client_info,
                      GetClientInfoCallback callback) override;
 
-  void EventLog(const std::string& json) override;
+  void EventLog(const std::vector<std::string>& json_events) override;
   void SetIdleThreshold(int32_t threshold) override;
   void KillTimer(uint32_t timer_id) override;
   void Load(const std::string& name, LoadCallback callback) override;
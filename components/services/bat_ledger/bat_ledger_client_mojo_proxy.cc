@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_type_converters.h"
 #include "mojo/public/cpp/bindings/map.h"
 
 namespace bat_ledger {
@@ -375,7 +376,8 @@ void BatLedgerClientMojoProxy::LoadPanelPublisherInfo(
     return;
   }
 
-  bat_ledger_client_->LoadPanelPublisherInfo(filter.ToJson(),
+  bat_ledger_client_->LoadPanelPublisherInfo(
+      ledger::mojom::ActivityInfoFilter::From(filter),
       base::BindOnce(&OnLoadPanelPublisherInfo, std::move(callback)));
 }
 
@@ -534,6 +536,38 @@ void BatLedgerClientMojoProxy::SaveContributionInfo(const std::string& probi,
       publisher_key, ToMojomPublisherCategory(category));
 }
 
+void BatLedgerClientMojoProxy::AddBalanceReportItem(
+    ledger::ACTIVITY_MONTH month,
+    int year,
+    ledger::ReportType type,
+    const std::string& probi) {
+  if (!Connected())
+    return;
+
+  bat_ledger_client_->AddBalanceReportItem(month, year, type, probi);
+}
+
+void OnBalanceReportsSaved(const ledger::OnSaveCallback& callback,
+    int32_t result) {
+  callback(ToLedgerResult(result));
+}
+
+void BatLedgerClientMojoProxy::SaveBalanceReports(
+    const std::map<std::string, ledger::BalanceReportInfo>& reports,
+    ledger::OnSaveCallback callback) {
+  if (!Connected()) {
+    callback(ledger::Result::LEDGER_ERROR);
+    return;
+  }
+
+  base::flat_map<std::string, std::string> json_reports;
+  for (const auto& report : reports) {
+    json_reports[report.first] = report.second.ToJson();
+  }
+  bat_ledger_client_->SaveBalanceReports(json_reports,
+      base::BindOnce(&OnBalanceReportsSaved, std::move(callback)));
+}
+
 void BatLedgerClientMojoProxy::SaveMediaPublisherInfo(
     const std::string& media_key, const std::string& publisher_id) {
   if (!Connected())
@@ -591,7 +625,8 @@ void BatLedgerClientMojoProxy::LoadActivityInfo(
     return;
   }
 
-  bat_ledger_client_->LoadActivityInfo(filter.ToJson(),
+  bat_ledger_client_->LoadActivityInfo(
+      ledger::mojom::ActivityInfoFilter::From(filter),
       base::BindOnce(&OnLoadActivityInfo, std::move(callback)));
 }
 
@@ -648,7 +683,7 @@ void BatLedgerClientMojoProxy::GetActivityInfoList(uint32_t start,
 
   bat_ledger_client_->GetActivityInfoList(start,
       limit,
-      filter.ToJson(),
+      ledger::mojom::ActivityInfoFilter::From(filter),
       base::BindOnce(&OnGetActivityInfoList, std::move(callback)));
 }
 
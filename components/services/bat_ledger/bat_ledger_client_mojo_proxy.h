@@ -84,6 +84,13 @@ class BatLedgerClientMojoProxy : public ledger::LedgerClient,
                             const uint32_t date,
                             const std::string& publisher_key,
                             const ledger::REWARDS_CATEGORY category) override;
+  void AddBalanceReportItem(ledger::ACTIVITY_MONTH month,
+                            int year,
+                            ledger::ReportType type,
+                            const std::string& probi) override;
+  void SaveBalanceReports(
+      const std::map<std::string, ledger::BalanceReportInfo>& reports,
+      ledger::OnSaveCallback callback) override;
   void GetRecurringTips(ledger::PublisherInfoListCallback callback) override;
   void GetOneTimeTips(ledger::PublisherInfoListCallback callback) override;
   std::unique_ptr<ledger::LogStream> Log(const char* file,
@@ -14,6 +14,7 @@
 
 #include "base/containers/flat_map.h"
 #include "brave/components/services/bat_ledger/bat_ledger_client_mojo_proxy.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_type_converters.h"
 #include "mojo/public/cpp/bindings/map.h"
 
 using std::placeholders::_1;
@@ -31,10 +32,6 @@ ledger::ACTIVITY_MONTH ToLedgerPublisherMonth(int32_t month) {
   return (ledger::ACTIVITY_MONTH)month;
 }
 
-ledger::ReportType ToLedgerReportType(int32_t type) {
-  return (ledger::ReportType)type;
-}
-
 ledger::REWARDS_CATEGORY ToLedgerPublisherCategory(int32_t category) {
   return (ledger::REWARDS_CATEGORY)category;
 }
@@ -116,11 +113,9 @@ void BatLedgerImpl::GetReconcileStamp(GetReconcileStampCallback callback) {
   std::move(callback).Run(ledger_->GetReconcileStamp());
 }
 
-void BatLedgerImpl::OnLoad(const std::string& visit_data,
+void BatLedgerImpl::OnLoad(ledger::mojom::VisitDataPtr visit_data,
     uint64_t current_time) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnLoad(visitData, current_time);
+  ledger_->OnLoad(visit_data.To<ledger::VisitData>(), current_time);
 }
 
 void BatLedgerImpl::OnUnload(uint32_t tab_id, uint64_t current_time) {
@@ -143,6 +138,11 @@ void BatLedgerImpl::OnBackground(uint32_t tab_id, uint64_t current_time) {
   ledger_->OnBackground(tab_id, current_time);
 }
 
+void BatLedgerImpl::OnVisit(ledger::mojom::VisitDataPtr visit_data,
+    uint64_t duration) {
+  ledger_->OnVisit(visit_data.To<ledger::VisitData>(), duration);
+}
+
 void BatLedgerImpl::OnMediaStart(uint32_t tab_id, uint64_t current_time) {
   ledger_->OnMediaStart(tab_id, current_time);
 }
@@ -151,22 +151,25 @@ void BatLedgerImpl::OnMediaStop(uint32_t tab_id, uint64_t current_time) {
   ledger_->OnMediaStop(tab_id, current_time);
 }
 
-void BatLedgerImpl::OnPostData(const std::string& url,
-    const std::string& first_party_url, const std::string& referrer,
-    const std::string& post_data, const std::string& visit_data) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnPostData(url, first_party_url, referrer, post_data, visitData);
-}
-
-void BatLedgerImpl::OnXHRLoad(uint32_t tab_id, const std::string& url,
-    const base::flat_map<std::string, std::string>& parts,
-    const std::string& first_party_url, const std::string& referrer,
-    const std::string& visit_data) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->OnXHRLoad(tab_id, url, mojo::FlatMapToMap(parts),
-        first_party_url, referrer, visitData);
+void BatLedgerImpl::OnMediaEvents(uint32_t tab_id,
+    std::vector<mojom::MediaEventPtr> events) {
+  // The activity updates these cause are queued by the browser's
+  // PublisherInfoDatabase, so a batch is written in a single transaction.
+  for (const auto& event : events) {
+    const ledger::VisitData visit_data =
+        event->visit_data.To<ledger::VisitData>();
+    switch (event->type) {
+      case mojom::MediaEventType::XHR_LOAD:
+        ledger_->OnXHRLoad(tab_id, event->url,
+            mojo::FlatMapToMap(event->parts), event->first_party_url,
+            event->referrer, visit_data);
+        break;
+      case mojom::MediaEventType::POST_DATA:
+        ledger_->OnPostData(event->url, event->first_party_url,
+            event->referrer, event->post_data, visit_data);
+        break;
+    }
+  }
 }
 
 void BatLedgerImpl::SetPublisherExclude(const std::string& publisher_key,
@@ -179,12 +182,6 @@ void BatLedgerImpl::RestorePublishers() {
   ledger_->RestorePublishers();
 }
 
-void BatLedgerImpl::SetBalanceReportItem(int32_t month,
-    int32_t year, int32_t type, const std::string& probi) {
-  ledger_->SetBalanceReportItem(
-      ToLedgerPublisherMonth(month), year, ToLedgerReportType(type), probi);
-}
-
 void BatLedgerImpl::OnReconcileCompleteSuccess(const std::string& viewing_id,
     int32_t category, const std::string& probi, int32_t month,
     int32_t year, uint32_t data) {
@@ -287,35 +284,16 @@ void BatLedgerImpl::OnTimer(uint32_t timer_id) {
   ledger_->OnTimer(timer_id);
 }
 
-void BatLedgerImpl::GetAllBalanceReports(
-    GetAllBalanceReportsCallback callback) {
-  auto reports = ledger_->GetAllBalanceReports();
-  base::flat_map<std::string, std::string> out_reports;
-  for (auto const& report : reports) {
-    out_reports[report.first] = report.second.ToJson();
-  }
-  std::move(callback).Run(out_reports);
-}
-
-void BatLedgerImpl::GetBalanceReport(int32_t month, int32_t year,
-    GetBalanceReportCallback callback) {
-  ledger::BalanceReportInfo info;
-  bool result =
-    ledger_->GetBalanceReport(ToLedgerPublisherMonth(month), year, &info);
-  std::move(callback).Run(result, info.ToJson());
-}
-
 void BatLedgerImpl::IsWalletCreated(IsWalletCreatedCallback callback) {
   std::move(callback).Run(ledger_->IsWalletCreated());
 }
 
 void BatLedgerImpl::GetPublisherActivityFromUrl(
     uint64_t window_id,
-    const std::string& visit_data,
+    ledger::mojom::VisitDataPtr visit_data,
     const std::string& publisher_blob) {
-  ledger::VisitData visitData;
-  if (visitData.loadFromJson(visit_data))
-    ledger_->GetPublisherActivityFromUrl(window_id, visitData, publisher_blob);
+  ledger_->GetPublisherActivityFromUrl(window_id,
+      visit_data.To<ledger::VisitData>(), publisher_blob);
 }
 
 // static
@@ -484,19 +462,16 @@ void BatLedgerImpl::OnGetActivityInfoList(
 void BatLedgerImpl::GetActivityInfoList(
     uint32_t start,
     uint32_t limit,
-    const std::string& json_filter,
+    ledger::mojom::ActivityInfoFilterPtr filter,
     GetActivityInfoListCallback callback) {
   auto* holder = new CallbackHolder<GetActivityInfoListCallback>(
       AsWeakPtr(), std::move(callback));
 
-  ledger::ActivityInfoFilter filter;
-  if (filter.loadFromJson(json_filter)) {
-    ledger_->GetActivityInfoList(
-        start,
-        limit,
-        filter,
-        std::bind(BatLedgerImpl::OnGetActivityInfoList, holder, _1, _2));
-  }
+  ledger_->GetActivityInfoList(
+      start,
+      limit,
+      filter.To<ledger::ActivityInfoFilter>(),
+      std::bind(BatLedgerImpl::OnGetActivityInfoList, holder, _1, _2));
 }
 
 // static
@@ -12,6 +12,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "bat/ledger/ledger.h"
@@ -45,30 +46,25 @@ class BatLedgerImpl : public mojom::BatLedger,
   void GetAutoContribute(GetAutoContributeCallback callback) override;
   void GetReconcileStamp(GetReconcileStampCallback callback) override;
 
-  void OnLoad(const std::string& visit_data, uint64_t current_time) override;
+  void OnLoad(ledger::mojom::VisitDataPtr visit_data,
+      uint64_t current_time) override;
   void OnUnload(uint32_t tab_id, uint64_t current_time) override;
   void OnShow(uint32_t tab_id, uint64_t current_time) override;
   void OnHide(uint32_t tab_id, uint64_t current_time) override;
   void OnForeground(uint32_t tab_id, uint64_t current_time) override;
   void OnBackground(uint32_t tab_id, uint64_t current_time) override;
+  void OnVisit(ledger::mojom::VisitDataPtr visit_data,
+      uint64_t duration) override;
   void OnMediaStart(uint32_t tab_id, uint64_t current_time) override;
   void OnMediaStop(uint32_t tab_id, uint64_t current_time) override;
 
-  void OnPostData(const std::string& url,
-      const std::string& first_party_url, const std::string& referrer,
-      const std::string& post_data, const std::string& visit_data) override;
-  void OnXHRLoad(uint32_t tab_id, const std::string& url,
-      const base::flat_map<std::string, std::string>& parts,
-      const std::string& first_party_url, const std::string& referrer,
-      const std::string& visit_data) override;
+  void OnMediaEvents(uint32_t tab_id,
+      std::vector<mojom::MediaEventPtr> events) override;
 
   void SetPublisherExclude(const std::string& publisher_key,
       int32_t exclude) override;
   void RestorePublishers() override;
 
-  void SetBalanceReportItem(
-      int32_t month, int32_t year, int32_t type,
-      const std::string& probi) override;
   void OnReconcileCompleteSuccess(const std::string& viewing_id,
       int32_t category, const std::string& probi, int32_t month,
       int32_t year, uint32_t data) override;
@@ -103,15 +99,11 @@ class BatLedgerImpl : public mojom::BatLedger,
 
   void OnTimer(uint32_t timer_id) override;
 
-  void GetAllBalanceReports(GetAllBalanceReportsCallback callback) override;
-  void GetBalanceReport(int32_t month, int32_t year,
-      GetBalanceReportCallback callback) override;
-
   void IsWalletCreated(IsWalletCreatedCallback callback) override;
 
   void GetPublisherActivityFromUrl(
       uint64_t window_id,
-      const std::string& visit_data,
+      ledger::mojom::VisitDataPtr visit_data,
       const std::string& publisher_blob) override;
 
   void GetContributionAmount(
@@ -148,7 +140,7 @@ class BatLedgerImpl : public mojom::BatLedger,
   void GetActivityInfoList(
     uint32_t start,
     uint32_t limit,
-    const std::string& json_filter,
+    ledger::mojom::ActivityInfoFilterPtr filter,
     GetActivityInfoListCallback callback) override;
 
   void LoadPublisherInfo(
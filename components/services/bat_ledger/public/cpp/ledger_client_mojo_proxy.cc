@@ -6,6 +6,7 @@
 #include "brave/components/services/bat_ledger/public/cpp/ledger_client_mojo_proxy.h"
 
 #include "base/logging.h"
+#include "brave/components/services/bat_ledger/public/cpp/ledger_type_converters.h"
 #include "mojo/public/cpp/bindings/map.h"
 
 using std::placeholders::_1;
@@ -28,6 +29,14 @@ ledger::REWARDS_CATEGORY ToLedgerPublisherCategory(int32_t category) {
   return (ledger::REWARDS_CATEGORY)category;
 }
 
+ledger::ACTIVITY_MONTH ToLedgerPublisherMonth(int32_t month) {
+  return (ledger::ACTIVITY_MONTH)month;
+}
+
+ledger::ReportType ToLedgerReportType(int32_t type) {
+  return (ledger::ReportType)type;
+}
+
 ledger::Grant ToLedgerGrant(const std::string& grant_json) {
   ledger::Grant grant;
   grant.loadFromJson(grant_json);
@@ -281,14 +290,14 @@ void LedgerClientMojoProxy::OnLoadPanelPublisherInfo(
   delete holder;
 }
 
-void LedgerClientMojoProxy::LoadPanelPublisherInfo(const std::string& filter,
+void LedgerClientMojoProxy::LoadPanelPublisherInfo(
+    ledger::mojom::ActivityInfoFilterPtr filter,
     LoadPanelPublisherInfoCallback callback) {
   // deleted in OnLoadPanelPublisherInfo
   auto* holder = new CallbackHolder<LoadPanelPublisherInfoCallback>(
       AsWeakPtr(), std::move(callback));
-  ledger::ActivityInfoFilter publisher_info_filter;
-  publisher_info_filter.loadFromJson(filter);
-  ledger_client_->LoadPanelPublisherInfo(publisher_info_filter,
+  ledger_client_->LoadPanelPublisherInfo(
+      filter.To<ledger::ActivityInfoFilter>(),
       std::bind(LedgerClientMojoProxy::OnLoadPanelPublisherInfo,
         holder, _1, _2));
 }
@@ -424,6 +433,34 @@ void LedgerClientMojoProxy::SaveContributionInfo(const std::string& probi,
       ToLedgerPublisherCategory(category));
 }
 
+void LedgerClientMojoProxy::AddBalanceReportItem(int32_t month, int32_t year,
+    int32_t type, const std::string& probi) {
+  ledger_client_->AddBalanceReportItem(ToLedgerPublisherMonth(month), year,
+      ToLedgerReportType(type), probi);
+}
+
+// static
+void LedgerClientMojoProxy::OnBalanceReportsSaved(
+    CallbackHolder<SaveBalanceReportsCallback>* holder, int32_t result) {
+  if (holder->is_valid())
+    std::move(holder->get()).Run(ToLedgerResult(result));
+  delete holder;
+}
+
+void LedgerClientMojoProxy::SaveBalanceReports(
+    const base::flat_map<std::string, std::string>& reports,
+    SaveBalanceReportsCallback callback) {
+  std::map<std::string, ledger::BalanceReportInfo> ledger_reports;
+  for (const auto& report : reports) {
+    ledger_reports[report.first].loadFromJson(report.second);
+  }
+  // deleted in OnBalanceReportsSaved
+  auto* holder = new CallbackHolder<SaveBalanceReportsCallback>(
+      AsWeakPtr(), std::move(callback));
+  ledger_client_->SaveBalanceReports(ledger_reports,
+      std::bind(LedgerClientMojoProxy::OnBalanceReportsSaved, holder, _1));
+}
+
 void LedgerClientMojoProxy::SaveMediaPublisherInfo(
     const std::string& media_key, const std::string& publisher_id) {
   ledger_client_->SaveMediaPublisherInfo(media_key, publisher_id);
@@ -486,14 +523,12 @@ void LedgerClientMojoProxy::OnLoadActivityInfo(
 }
 
 void LedgerClientMojoProxy::LoadActivityInfo(
-    const std::string& filter,
+    ledger::mojom::ActivityInfoFilterPtr filter,
     LoadActivityInfoCallback callback) {
   // deleted in OnLoadActivityInfo
   auto* holder = new CallbackHolder<LoadActivityInfoCallback>(
       AsWeakPtr(), std::move(callback));
-  ledger::ActivityInfoFilter publisher_info_filter;
-  publisher_info_filter.loadFromJson(filter);
-  ledger_client_->LoadActivityInfo(publisher_info_filter,
+  ledger_client_->LoadActivityInfo(filter.To<ledger::ActivityInfoFilter>(),
       std::bind(LedgerClientMojoProxy::OnLoadActivityInfo, holder, _1, _2));
 }
 
@@ -549,18 +584,15 @@ void LedgerClientMojoProxy::OnGetActivityInfoList(
 
 void LedgerClientMojoProxy::GetActivityInfoList(uint32_t start,
     uint32_t limit,
-    const std::string& filter,
+    ledger::mojom::ActivityInfoFilterPtr filter,
     GetActivityInfoListCallback callback) {
   // deleted in OnGetActivityInfoList
   auto* holder = new CallbackHolder<GetActivityInfoListCallback>(
       AsWeakPtr(), std::move(callback));
 
-  ledger::ActivityInfoFilter publisher_info_filter;
-  publisher_info_filter.loadFromJson(filter);
-
   ledger_client_->GetActivityInfoList(start,
       limit,
-      publisher_info_filter,
+      filter.To<ledger::ActivityInfoFilter>(),
       std::bind(LedgerClientMojoProxy::OnGetActivityInfoList,
                 holder,
                 _1,
@@ -51,7 +51,7 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
       SavePublisherInfoCallback callback) override;
   void LoadPublisherInfo(const std::string& publisher_key,
       LoadPublisherInfoCallback callback) override;
-  void LoadPanelPublisherInfo(const std::string& filter,
+  void LoadPanelPublisherInfo(ledger::mojom::ActivityInfoFilterPtr filter,
       LoadPanelPublisherInfoCallback callback) override;
   void LoadMediaPublisherInfo(const std::string& media_key,
       LoadMediaPublisherInfoCallback callback) override;
@@ -76,6 +76,11 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
   void SaveContributionInfo(const std::string& probi, int32_t month,
       int32_t year, uint32_t date, const std::string& publisher_key,
       int32_t category) override;
+  void AddBalanceReportItem(int32_t month, int32_t year, int32_t type,
+      const std::string& probi) override;
+  void SaveBalanceReports(
+      const base::flat_map<std::string, std::string>& reports,
+      SaveBalanceReportsCallback callback) override;
   void SaveMediaPublisherInfo(const std::string& media_key,
       const std::string& publisher_id) override;
   void FetchGrants(const std::string& lang,
@@ -96,7 +101,7 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
 
   void SavePendingContribution(ledger::PendingContributionList list) override;
 
-  void LoadActivityInfo(const std::string& filter,
+  void LoadActivityInfo(ledger::mojom::ActivityInfoFilterPtr filter,
       LoadActivityInfoCallback callback) override;
 
   void SaveActivityInfo(ledger::PublisherInfoPtr publisher_info,
@@ -106,7 +111,7 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
 
   void GetActivityInfoList(uint32_t start,
                            uint32_t limit,
-                           const std::string& filter,
+                           ledger::mojom::ActivityInfoFilterPtr filter,
                            GetActivityInfoListCallback callback) override;
 
   void SaveNormalizedPublisherList(
@@ -209,6 +214,10 @@ class LedgerClientMojoProxy : public mojom::BatLedgerClient,
       CallbackHolder<OnRemoveRecurringCallback>* holder,
       int32_t result);
 
+  static void OnBalanceReportsSaved(
+      CallbackHolder<SaveBalanceReportsCallback>* holder,
+      int32_t result);
+
   static void OnLoadURL(
       CallbackHolder<LoadURLCallback>* holder,
       int32_t response_code, const std::string& response,
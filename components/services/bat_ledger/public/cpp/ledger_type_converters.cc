@@ -0,0 +1,91 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/public/cpp/ledger_type_converters.h"
+
+#include <utility>
+
+namespace mojo {
+
+// static
+ledger::mojom::VisitDataPtr
+TypeConverter<ledger::mojom::VisitDataPtr, ledger::VisitData>::Convert(
+    const ledger::VisitData& input) {
+  auto output = ledger::mojom::VisitData::New();
+  output->tld = input.tld;
+  output->domain = input.domain;
+  output->path = input.path;
+  output->tab_id = input.tab_id;
+  output->name = input.name;
+  output->url = input.url;
+  output->provider = input.provider;
+  output->favicon_url = input.favicon_url;
+  return output;
+}
+
+// static
+ledger::VisitData
+TypeConverter<ledger::VisitData, ledger::mojom::VisitDataPtr>::Convert(
+    const ledger::mojom::VisitDataPtr& input) {
+  ledger::VisitData output;
+  if (!input)
+    return output;
+
+  output.tld = input->tld;
+  output.domain = input->domain;
+  output.path = input->path;
+  output.tab_id = input->tab_id;
+  output.name = input->name;
+  output.url = input->url;
+  output.provider = input->provider;
+  output.favicon_url = input->favicon_url;
+  return output;
+}
+
+// static
+ledger::mojom::ActivityInfoFilterPtr
+TypeConverter<ledger::mojom::ActivityInfoFilterPtr,
+              ledger::ActivityInfoFilter>::Convert(
+    const ledger::ActivityInfoFilter& input) {
+  auto output = ledger::mojom::ActivityInfoFilter::New();
+  output->id = input.id;
+  output->excluded = input.excluded;
+  output->percent = input.percent;
+  for (const auto& order : input.order_by) {
+    output->order_by.push_back(
+        ledger::mojom::ActivityInfoFilterOrderPair::New(order.first,
+                                                        order.second));
+  }
+  output->min_duration = input.min_duration;
+  output->reconcile_stamp = input.reconcile_stamp;
+  output->non_verified = input.non_verified;
+  output->min_visits = input.min_visits;
+  return output;
+}
+
+// static
+ledger::ActivityInfoFilter
+TypeConverter<ledger::ActivityInfoFilter,
+              ledger::mojom::ActivityInfoFilterPtr>::Convert(
+    const ledger::mojom::ActivityInfoFilterPtr& input) {
+  ledger::ActivityInfoFilter output;
+  if (!input)
+    return output;
+
+  output.id = input->id;
+  output.excluded = static_cast<ledger::EXCLUDE_FILTER>(input->excluded);
+  output.percent = input->percent;
+  for (const auto& order : input->order_by) {
+    output.order_by.push_back(
+        std::make_pair(order->property_name, order->ascending));
+  }
+  output.min_duration = input->min_duration;
+  output.reconcile_stamp = input->reconcile_stamp;
+  output.non_verified = input->non_verified;
+  output.min_visits = input->min_visits;
+  return output;
+}
+
+}  // namespace mojo
@@ -0,0 +1,45 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_TYPE_CONVERTERS_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_TYPE_CONVERTERS_H_
+
+#include "bat/ledger/ledger.h"
+#include "bat/ledger/public/interfaces/ledger.mojom.h"
+#include "mojo/public/cpp/bindings/type_converter.h"
+
+// Conversions between the ledger library structs and the mojom structs that
+// carry them over the bat_ledger interface, so the hot paths don't have to
+// round-trip through JSON on each side of the process boundary.
+
+namespace mojo {
+
+template <>
+struct TypeConverter<ledger::mojom::VisitDataPtr, ledger::VisitData> {
+  static ledger::mojom::VisitDataPtr Convert(const ledger::VisitData& input);
+};
+
+template <>
+struct TypeConverter<ledger::VisitData, ledger::mojom::VisitDataPtr> {
+  static ledger::VisitData Convert(const ledger::mojom::VisitDataPtr& input);
+};
+
+template <>
+struct TypeConverter<ledger::mojom::ActivityInfoFilterPtr,
+                     ledger::ActivityInfoFilter> {
+  static ledger::mojom::ActivityInfoFilterPtr Convert(
+      const ledger::ActivityInfoFilter& input);
+};
+
+template <>
+struct TypeConverter<ledger::ActivityInfoFilter,
+                     ledger::mojom::ActivityInfoFilterPtr> {
+  static ledger::ActivityInfoFilter Convert(
+      const ledger::mojom::ActivityInfoFilterPtr& input);
+};
+
+}  // namespace mojo
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_LEDGER_PUBLIC_CPP_LEDGER_TYPE_CONVERTERS_H_
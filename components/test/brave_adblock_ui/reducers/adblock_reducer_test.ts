@@ -3,7 +3,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 /* global chrome */
 
-import adblockReducer from '../../../brave_adblock_ui/reducers/adblock_reducer'
+import adblockReducer, { getCustomFiltersSplice } from '../../../brave_adblock_ui/reducers/adblock_reducer'
 import * as actions from '../../../brave_adblock_ui/actions/adblock_actions'
 import { types } from '../../../brave_adblock_ui/constants/adblock_types'
 
@@ -13,6 +13,7 @@ describe('adblockReducer', () => {
     expect(assertion).toEqual({
       settings: {
         customFilters: '',
+        customFilterErrors: [],
         regionalLists: []
       },
       stats: {
@@ -31,6 +32,7 @@ describe('adblockReducer', () => {
       expect(assertion).toEqual({
         settings: {
           customFilters: '',
+        customFilterErrors: [],
           regionalLists: []
         },
         stats: {
@@ -40,4 +42,55 @@ describe('adblockReducer', () => {
       })
     })
   })
+
+  describe('getCustomFiltersSplice', () => {
+    it('finds an edited line', () => {
+      expect(getCustomFiltersSplice('a\nb\nc', 'a\nB\nc')).toEqual({
+        start: 1,
+        removed: ['b'],
+        inserted: ['B']
+      })
+    })
+
+    it('finds appended lines', () => {
+      expect(getCustomFiltersSplice('a', 'a\nb\nc')).toEqual({
+        start: 1,
+        removed: [],
+        inserted: ['b', 'c']
+      })
+    })
+
+    it('finds removed lines', () => {
+      expect(getCustomFiltersSplice('a\nb\nc\nd', 'a\nd')).toEqual({
+        start: 1,
+        removed: ['b', 'c'],
+        inserted: []
+      })
+    })
+  })
+
+  describe('ADBLOCK_ON_CUSTOM_FILTERS_SPLICED', () => {
+    let spy: jest.SpyInstance
+    beforeEach(() => {
+      spy = jest.spyOn(chrome, 'send')
+    })
+    afterEach(() => {
+      spy.mockRestore()
+    })
+
+    it('keeps errors for rules still in the list', () => {
+      const state = adblockReducer(undefined, actions.onGetCustomFilters('a$foo\nb'))
+      const assertion = adblockReducer(state,
+        actions.onCustomFiltersSpliced(true, [{ rule: 'a$foo', error: 'unknownOption' }]))
+      expect(assertion && assertion.settings.customFilterErrors).toEqual([
+        { rule: 'a$foo', error: 'unknownOption' }
+      ])
+      expect(spy).not.toBeCalled()
+    })
+
+    it('gets the custom filters again when the splice failed', () => {
+      adblockReducer(undefined, actions.onCustomFiltersSpliced(false, []))
+      expect(spy).toBeCalledWith('brave_adblock.getCustomFilters')
+    })
+  })
 })
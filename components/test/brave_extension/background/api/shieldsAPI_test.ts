@@ -151,6 +151,21 @@ describe('Shields API', () => {
     })
   })
 
+  describe('getShieldsState', () => {
+    it('resolves with the settings and blocked counts of the tab', (cb) => {
+      expect.assertions(2)
+      shieldsAPI.getShieldsState(2)
+        .then((state) => {
+          expect(state.id).toBe(2)
+          expect(state.blockedCounts.ads).toBe(1)
+          cb()
+        })
+        .catch((e: Error) => {
+          console.error(e.toString())
+        })
+    })
+  })
+
   describe('requestShieldPanelData', () => {
     let spy: jest.SpyInstance
     const tabId = 2
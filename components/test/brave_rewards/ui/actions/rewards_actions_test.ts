@@ -40,4 +40,15 @@ describe('rewards_actions', () => {
       }
     })
   })
+
+  it('onContributeListChanged', () => {
+    expect(actions.onContributeListChanged([], ['brave.com'])).toEqual({
+      type: types.ON_CONTRIBUTE_LIST_CHANGED,
+      meta: undefined,
+      payload: {
+        updated: [],
+        removed: ['brave.com']
+      }
+    })
+  })
 })
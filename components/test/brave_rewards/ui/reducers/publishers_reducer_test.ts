@@ -7,7 +7,94 @@ import reducers from '../../../../brave_rewards/resources/ui/reducers/index'
 import { types } from '../../../../brave_rewards/resources/ui/constants/rewards_types'
 import { defaultState } from '../../../../brave_rewards/resources/ui/storage'
 
+const getPublisher = (publisherKey: string, percentage: number): Rewards.Publisher => ({
+  publisherKey,
+  percentage,
+  verified: false,
+  excluded: 0,
+  url: `https://${publisherKey}`,
+  name: publisherKey,
+  provider: '',
+  favIcon: '',
+  id: publisherKey
+})
+
 describe('publishers reducer', () => {
+  describe('ON_CONTRIBUTE_LIST_CHANGED', () => {
+    it('updates changed rows and keeps the list sorted', () => {
+      const initialState = { ...defaultState }
+      initialState.autoContributeList = [
+        getPublisher('foo.com', 60),
+        getPublisher('bar.com', 40)
+      ]
+
+      const assertion = reducers({ rewardsData: initialState }, {
+        type: types.ON_CONTRIBUTE_LIST_CHANGED,
+        payload: {
+          updated: [getPublisher('bar.com', 70)],
+          removed: []
+        }
+      })
+
+      const expectedState: Rewards.State = { ...defaultState }
+      expectedState.autoContributeList = [
+        getPublisher('bar.com', 70),
+        getPublisher('foo.com', 60)
+      ]
+
+      expect(assertion).toEqual({
+        rewardsData: expectedState
+      })
+    })
+
+    it('adds new rows and drops removed ones', () => {
+      const initialState = { ...defaultState }
+      initialState.autoContributeList = [
+        getPublisher('foo.com', 60),
+        getPublisher('bar.com', 40)
+      ]
+
+      const assertion = reducers({ rewardsData: initialState }, {
+        type: types.ON_CONTRIBUTE_LIST_CHANGED,
+        payload: {
+          updated: [getPublisher('baz.com', 50)],
+          removed: ['foo.com']
+        }
+      })
+
+      const expectedState: Rewards.State = { ...defaultState }
+      expectedState.autoContributeList = [
+        getPublisher('baz.com', 50),
+        getPublisher('bar.com', 40)
+      ]
+
+      expect(assertion).toEqual({
+        rewardsData: expectedState
+      })
+    })
+
+    it('keeps the list on an empty payload', () => {
+      const initialState = { ...defaultState }
+      initialState.autoContributeList = [
+        getPublisher('foo.com', 60)
+      ]
+
+      const assertion = reducers({ rewardsData: initialState }, {
+        type: types.ON_CONTRIBUTE_LIST_CHANGED,
+        payload: {}
+      })
+
+      const expectedState: Rewards.State = { ...defaultState }
+      expectedState.autoContributeList = [
+        getPublisher('foo.com', 60)
+      ]
+
+      expect(assertion).toEqual({
+        rewardsData: expectedState
+      })
+    })
+  })
+
   describe('ON_EXCLUDED_LIST', () => {
     it('updates list', () => {
       const assertion = reducers(undefined, {
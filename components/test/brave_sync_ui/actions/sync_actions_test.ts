@@ -34,6 +34,28 @@ describe('sync_actions', () => {
     })
   })
 
+  it('onDevicesChanged', () => {
+    const changedDevices = [{
+      name: 'MIKE TYSON PC',
+      device_id: 1,
+      last_active: 0
+    }]
+    const deletedDeviceIds = ['2']
+    expect(actions.onDevicesChanged(changedDevices, deletedDeviceIds)).toEqual({
+      type: types.SYNC_ON_DEVICES_CHANGED,
+      meta: undefined,
+      payload: { changedDevices, deletedDeviceIds }
+    })
+  })
+
+  it('onSyncRecordsApplyProgress', () => {
+    expect(actions.onSyncRecordsApplyProgress(100, 1000)).toEqual({
+      type: types.SYNC_ON_RECORDS_APPLY_PROGRESS,
+      meta: undefined,
+      payload: { applied: 100, total: 1000 }
+    })
+  })
+
   it('onHaveSyncWords', () => {
     expect(actions.onHaveSyncWords('ameri do te karate')).toEqual({
       type: types.SYNC_ON_HAVE_SYNC_WORDS,
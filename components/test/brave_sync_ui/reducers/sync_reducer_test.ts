@@ -2,6 +2,10 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+import syncReducer from '../../../brave_sync/ui/reducers/sync_reducer'
+import * as actions from '../../../brave_sync/ui/actions/sync_actions'
+import { defaultState } from '../../../brave_sync/ui/storage'
+
 describe.skip('syncReducer', () => {
   it('should handle initial state', () => {
     // TODO
@@ -59,3 +63,58 @@ describe.skip('syncReducer', () => {
     // TODO
   })
 })
+
+describe('syncReducer device deltas', () => {
+  const state: Sync.State = {
+    ...defaultState,
+    devices: [
+      { name: 'laptop', id: 0, lastActive: 0 },
+      { name: 'phone', id: 1, lastActive: 0 }
+    ]
+  }
+
+  describe('SYNC_ON_DEVICES_CHANGED', () => {
+    it('adds created devices', () => {
+      const assertion = syncReducer(state, actions.onDevicesChanged([
+        { name: 'tablet', device_id: 2, last_active: 0 }
+      ], []))
+      expect(assertion && assertion.devices.map((device) => device.name))
+        .toEqual([ 'laptop', 'phone', 'tablet' ])
+    })
+
+    it('replaces updated devices', () => {
+      const assertion = syncReducer(state, actions.onDevicesChanged([
+        { name: 'new phone', device_id: 1, last_active: 0 }
+      ], []))
+      expect(assertion && assertion.devices.map((device) => device.name))
+        .toEqual([ 'laptop', 'new phone' ])
+    })
+
+    it('removes deleted devices', () => {
+      const assertion = syncReducer(state, actions.onDevicesChanged([], [ '0' ]))
+      expect(assertion && assertion.devices.map((device) => device.name))
+        .toEqual([ 'phone' ])
+    })
+  })
+})
+
+describe('syncReducer records apply progress', () => {
+  describe('SYNC_ON_RECORDS_APPLY_PROGRESS', () => {
+    it('keeps the progress while records are applied', () => {
+      const assertion = syncReducer(defaultState,
+        actions.onSyncRecordsApplyProgress(50, 200))
+      expect(assertion && assertion.recordsApplyProgress)
+        .toEqual({ applied: 50, total: 200 })
+    })
+
+    it('clears the progress once every record is applied', () => {
+      const state: Sync.State = {
+        ...defaultState,
+        recordsApplyProgress: { applied: 50, total: 200 }
+      }
+      const assertion = syncReducer(state,
+        actions.onSyncRecordsApplyProgress(200, 200))
+      expect(assertion && assertion.recordsApplyProgress).toBeUndefined()
+    })
+  })
+})
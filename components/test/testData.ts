@@ -105,6 +105,22 @@ export const blockedResource: BlockDetails = {
   subresource: 'https://www.brave.com/test'
 }
 
+export const blockedResources: BlockedResources = {
+  tabId: 2,
+  resources: [
+    { blockType: 'ads', subresource: 'https://www.brave.com/test' },
+    { blockType: 'javascript', subresource: 'https://www.brave.com/script.js' }
+  ],
+  counts: {
+    tabId: 2,
+    ads: 1,
+    trackers: 0,
+    httpsUpgrades: 0,
+    javascript: 1,
+    fingerprinting: 0
+  }
+}
+
 export const getMockChrome = () => {
   return {
     send: () => undefined,
@@ -169,6 +185,29 @@ export const getMockChrome = () => {
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
+      getShieldsState: function (tabId: number, cb: (state: object) => void) {
+        setImmediate(() => cb({
+          url: 'https://www.brave.com/test',
+          origin: 'https://www.brave.com',
+          hostname: 'www.brave.com',
+          id: tabId,
+          braveShields: 'block',
+          ads: 'block',
+          trackers: 'block',
+          httpUpgradableResources: 'block',
+          javascript: 'block',
+          fingerprinting: 'block',
+          cookies: 'block',
+          blockedCounts: {
+            tabId,
+            ads: 1,
+            trackers: 0,
+            httpsUpgrades: 0,
+            javascript: 0,
+            fingerprinting: 0
+          }
+        }))
+      },
       plugins: {
         setAsync: function () {
           return Promise.resolve()
@@ -19,3 +19,7 @@
 IPC_MESSAGE_ROUTED1(
     BraveFrameMsg_AllowScriptsOnce,
     std::vector<std::string> /* origins to allow scripts once */)
+
+// Tell a RenderFrame that the content setting rules of its process were just
+// replaced. Sent after the rules, on the same channel.
+IPC_MESSAGE_ROUTED0(BraveFrameMsg_ContentSettingRulesChanged)
@@ -9,12 +9,12 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/render_messages.h"
 #include "brave/content/common/frame_messages.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
-#include "components/content_settings/core/common/content_settings_utils.h"
 #include "content/public/renderer/render_frame.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "third_party/blink/public/mojom/permissions/permission.mojom-blink.h"
@@ -24,11 +24,26 @@
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "url/url_constants.h"
 
+namespace {
+
+// Short enough for the shields panel to look live, long enough that a page
+// retrying a script or probing canvas in a loop costs one IPC per interval.
+constexpr base::TimeDelta kSendBlockedContentDelay =
+    base::TimeDelta::FromMilliseconds(100);
+
+// Bumped on the render thread whenever the browser tells any frame that the
+// content setting rules, which all frames of the process share, changed.
+uint64_t g_content_setting_rules_version = 0;
+
+}  // namespace
+
 BraveContentSettingsObserver::BraveContentSettingsObserver(
     content::RenderFrame* render_frame,
     bool should_whitelist,
     service_manager::BinderRegistry* registry)
-    : ContentSettingsObserver(render_frame, should_whitelist, registry) {
+    : ContentSettingsObserver(render_frame, should_whitelist, registry),
+      document_urls_valid_(false),
+      decisions_cache_rules_version_(g_content_setting_rules_version) {
 }
 
 BraveContentSettingsObserver::~BraveContentSettingsObserver() {
@@ -39,6 +54,8 @@ bool BraveContentSettingsObserver::OnMessageReceived(
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(BraveContentSettingsObserver, message)
     IPC_MESSAGE_HANDLER(BraveFrameMsg_AllowScriptsOnce, OnAllowScriptsOnce)
+    IPC_MESSAGE_HANDLER(BraveFrameMsg_ContentSettingRulesChanged,
+                        OnContentSettingRulesChanged)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -46,9 +63,24 @@ bool BraveContentSettingsObserver::OnMessageReceived(
   return ContentSettingsObserver::OnMessageReceived(message);
 }
 
+void BraveContentSettingsObserver::OnContentSettingRulesChanged() {
+  ++g_content_setting_rules_version;
+}
+
 void BraveContentSettingsObserver::OnAllowScriptsOnce(
     const std::vector<std::string>& origins) {
-  preloaded_temporarily_allowed_scripts_ = std::move(origins);
+  std::vector<url::Origin> allowed_origins;
+  allowed_origins.reserve(origins.size());
+  for (const auto& origin : origins)
+    allowed_origins.push_back(url::Origin::Create(GURL(origin)));
+  preloaded_temporarily_allowed_scripts_ =
+      base::flat_set<url::Origin>(std::move(allowed_origins));
+}
+
+void BraveContentSettingsObserver::WillCommitProvisionalLoad() {
+  // Send what the outgoing document blocked while the browser still counts
+  // it against that page, before the commit resets its shields data.
+  SendBlockedContent();
 }
 
 void BraveContentSettingsObserver::DidCommitProvisionalLoad(
@@ -56,22 +88,94 @@ void BraveContentSettingsObserver::DidCommitProvisionalLoad(
   if (!is_same_document_navigation) {
     temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+    preloaded_temporarily_allowed_scripts_.clear();
+    UpdateDocumentURLs();
+    ClearDecisionsCache();
+    // Anything queued since WillCommitProvisionalLoad() came from the
+    // document that was replaced.
+    send_blocked_content_timer_.Stop();
+    pending_blocked_javascript_.clear();
+    pending_blocked_fingerprinting_.clear();
+    reported_blocked_javascript_.clear();
+    reported_blocked_fingerprinting_.clear();
   }
 
   ContentSettingsObserver::DidCommitProvisionalLoad(
       is_same_document_navigation, transition);
 }
 
+void BraveContentSettingsObserver::DidFinishLoad() {
+  SendBlockedContent();
+}
+
+void BraveContentSettingsObserver::ScheduleSendBlockedContent() {
+  if (!send_blocked_content_timer_.IsRunning()) {
+    send_blocked_content_timer_.Start(FROM_HERE, kSendBlockedContentDelay,
+        base::Bind(&BraveContentSettingsObserver::SendBlockedContent,
+                   base::Unretained(this)));
+  }
+}
+
+void BraveContentSettingsObserver::SendBlockedContent() {
+  send_blocked_content_timer_.Stop();
+  if (!pending_blocked_javascript_.empty()) {
+    Send(new BraveViewHostMsg_JavaScriptBlocked(routing_id(),
+        pending_blocked_javascript_));
+    pending_blocked_javascript_.clear();
+  }
+  if (!pending_blocked_fingerprinting_.empty()) {
+    Send(new BraveViewHostMsg_FingerprintingBlocked(routing_id(),
+        pending_blocked_fingerprinting_));
+    pending_blocked_fingerprinting_.clear();
+  }
+}
+
+bool BraveContentSettingsObserver::GetCachedDecision(
+    DecisionType type,
+    const GURL& secondary_url,
+    bool* allow) {
+  if (decisions_cache_rules_version_ != g_content_setting_rules_version) {
+    ClearDecisionsCache();
+    decisions_cache_rules_version_ = g_content_setting_rules_version;
+    return false;
+  }
+
+  auto it = decisions_cache_.find(
+      std::make_pair(type, secondary_url.GetOrigin()));
+  if (it == decisions_cache_.end())
+    return false;
+  *allow = it->second;
+  return true;
+}
+
+void BraveContentSettingsObserver::CacheDecision(
+    DecisionType type,
+    const GURL& secondary_url,
+    bool allow) {
+  // file: patterns may match on the path, so only origins are cached
+  if (secondary_url.SchemeIsFile() || !secondary_url.is_valid())
+    return;
+  decisions_cache_[std::make_pair(type, secondary_url.GetOrigin())] = allow;
+}
+
+void BraveContentSettingsObserver::ClearDecisionsCache() {
+  decisions_cache_.clear();
+}
+
 bool BraveContentSettingsObserver::IsScriptTemporilyAllowed(
     const GURL& script_url) {
   // check if scripts from this origin are temporily allowed or not
-  return base::ContainsKey(temporarily_allowed_scripts_,
-      script_url.GetOrigin().spec());
+  return !temporarily_allowed_scripts_.empty() &&
+      base::ContainsKey(temporarily_allowed_scripts_,
+                        url::Origin::Create(script_url));
 }
 
 void BraveContentSettingsObserver::BraveSpecificDidBlockJavaScript(
     const base::string16& details) {
-  Send(new BraveViewHostMsg_JavaScriptBlocked(routing_id(), details));
+  if (!reported_blocked_javascript_.insert(details).second)
+    return;
+  pending_blocked_javascript_.push_back(details);
+  ScheduleSendBlockedContent();
 }
 
 bool BraveContentSettingsObserver::AllowScript(
@@ -80,13 +184,11 @@ bool BraveContentSettingsObserver::AllowScript(
   // without calling `AllowScriptFromSource` first
   blocked_script_url_ = GURL::EmptyGURL();
 
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(
-      url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
+  const GURL& secondary_url = GetDocumentOriginURL();
 
   bool allow = ContentSettingsObserver::AllowScript(enabled_per_settings);
   allow = allow ||
-    IsBraveShieldsDown(frame, secondary_url) ||
+    IsBraveShieldsDown(secondary_url) ||
     IsScriptTemporilyAllowed(secondary_url);
 
   return allow;
@@ -106,7 +208,16 @@ bool BraveContentSettingsObserver::AllowScriptFromSource(
     const blink::WebURL& script_url) {
   const GURL secondary_url(script_url);
 
-  bool allow = ContentSettingsObserver::AllowScriptFromSource(
+  bool allow = false;
+  if (enabled_per_settings &&
+      GetCachedDecision(DECISION_SCRIPT, secondary_url, &allow)) {
+    if (!allow) {
+      blocked_script_url_ = secondary_url;
+    }
+    return allow;
+  }
+
+  allow = ContentSettingsObserver::AllowScriptFromSource(
       enabled_per_settings, script_url);
 
   // scripts with whitelisted protocols, such as chrome://extensions should
@@ -117,9 +228,13 @@ bool BraveContentSettingsObserver::AllowScriptFromSource(
 
   allow = allow ||
     should_white_list ||
-    IsBraveShieldsDown(render_frame()->GetWebFrame(), secondary_url) ||
+    IsBraveShieldsDown(secondary_url) ||
     IsScriptTemporilyAllowed(secondary_url);
 
+  if (enabled_per_settings) {
+    CacheDecision(DECISION_SCRIPT, secondary_url, allow);
+  }
+
   if (!allow) {
     blocked_script_url_ = secondary_url;
   }
@@ -129,7 +244,10 @@ bool BraveContentSettingsObserver::AllowScriptFromSource(
 
 void BraveContentSettingsObserver::DidBlockFingerprinting(
     const base::string16& details) {
-  Send(new BraveViewHostMsg_FingerprintingBlocked(routing_id(), details));
+  if (!reported_blocked_fingerprinting_.insert(details).second)
+    return;
+  pending_blocked_fingerprinting_.push_back(details);
+  ScheduleSendBlockedContent();
 }
 
 GURL BraveContentSettingsObserver::GetOriginOrURL(
@@ -145,41 +263,39 @@ GURL BraveContentSettingsObserver::GetOriginOrURL(
   return top_origin.GetURL();
 }
 
-ContentSetting BraveContentSettingsObserver::GetFPContentSettingFromRules(
-    const ContentSettingsForOneType& rules,
-    const blink::WebFrame* frame,
-    const GURL& secondary_url) {
-
-  if (rules.size() == 0)
-    return CONTENT_SETTING_DEFAULT;
-
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  for (const auto& rule : rules) {
-    ContentSettingsPattern secondary_pattern = rule.secondary_pattern;
-    if (rule.secondary_pattern ==
-        ContentSettingsPattern::FromString("https://firstParty/*")) {
-      secondary_pattern = ContentSettingsPattern::FromString(
-          "[*.]" + GetOriginOrURL(frame).HostNoBrackets());
-    }
+const GURL& BraveContentSettingsObserver::GetDocumentOriginURL() {
+  if (!document_urls_valid_)
+    UpdateDocumentURLs();
+  return document_origin_url_;
+}
 
-    if (rule.primary_pattern.Matches(primary_url) &&
-        (secondary_pattern == ContentSettingsPattern::Wildcard() ||
-         secondary_pattern.Matches(secondary_url))) {
-      return rule.GetContentSetting();
-    }
-  }
+GURL BraveContentSettingsObserver::GetPrimaryURL() {
+  if (!document_urls_valid_)
+    UpdateDocumentURLs();
+  // An opaque top origin falls back to the top document URL, which can
+  // change without a commit in this frame
+  if (top_origin_url_.is_empty())
+    return GetOriginOrURL(render_frame()->GetWebFrame());
+  return top_origin_url_;
+}
 
-  // for cases which are third party resources and doesn't match any existing
-  // rules, block them by default
-  return CONTENT_SETTING_BLOCK;
+void BraveContentSettingsObserver::UpdateDocumentURLs() {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  document_origin_url_ =
+      url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL();
+  const url::Origin top_origin(frame->Top()->GetSecurityOrigin());
+  top_origin_url_ = top_origin.opaque() ? GURL() : top_origin.GetURL();
+  document_urls_valid_ = true;
 }
 
 bool BraveContentSettingsObserver::IsBraveShieldsDown(
-    const blink::WebFrame* frame,
     const GURL& secondary_url) {
+  bool shields_down = false;
+  if (GetCachedDecision(DECISION_SHIELDS_DOWN, secondary_url, &shields_down))
+    return shields_down;
+
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
+  const GURL primary_url = GetPrimaryURL();
 
   if (content_setting_rules_) {
     for (const auto& rule : content_setting_rules_->brave_shields_rules) {
@@ -191,35 +307,39 @@ bool BraveContentSettingsObserver::IsBraveShieldsDown(
     }
   }
 
-  return setting == CONTENT_SETTING_BLOCK;
+  shields_down = setting == CONTENT_SETTING_BLOCK;
+  CacheDecision(DECISION_SHIELDS_DOWN, secondary_url, shields_down);
+  return shields_down;
 }
 
 bool BraveContentSettingsObserver::AllowFingerprinting(
     bool enabled_per_settings) {
   if (!enabled_per_settings)
     return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(
-      url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
+  const GURL& secondary_url = GetDocumentOriginURL();
+  if (IsBraveShieldsDown(secondary_url)) {
     return true;
   }
-  ContentSettingsForOneType rules;
+
+  bool allow = false;
+  if (GetCachedDecision(DECISION_FINGERPRINTING, secondary_url, &allow)) {
+    if (!allow) {
+      DidBlockFingerprinting(base::UTF8ToUTF16(secondary_url.spec()));
+    }
+    return allow;
+  }
+
   if (content_setting_rules_) {
-      rules = content_setting_rules_->fingerprinting_rules;
+    fingerprinting_rules_matcher_.Update(
+        content_setting_rules_->fingerprinting_rules);
+  } else {
+    fingerprinting_rules_matcher_.Update(ContentSettingsForOneType());
   }
-  ContentSettingPatternSource default_rule = ContentSettingPatternSource(
-      ContentSettingsPattern::Wildcard(),
-      ContentSettingsPattern::FromString("https://firstParty/*"),
-      base::Value::FromUniquePtrValue(
-          content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-      std::string(), false);
-  rules.push_back(default_rule);
-  ContentSetting setting =
-      GetFPContentSettingFromRules(rules, frame, secondary_url);
-  rules.pop_back();
-  bool allow = setting != CONTENT_SETTING_BLOCK;
+  ContentSetting setting = fingerprinting_rules_matcher_.GetContentSetting(
+      GetPrimaryURL(), secondary_url);
+  allow = setting != CONTENT_SETTING_BLOCK;
   allow = allow || IsWhitelistedForContentSettings();
+  CacheDecision(DECISION_FINGERPRINTING, secondary_url, allow);
 
   if (!allow) {
     DidBlockFingerprinting(base::UTF8ToUTF16(secondary_url.spec()));
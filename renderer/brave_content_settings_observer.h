@@ -5,10 +5,22 @@
 #ifndef BRAVE_RENDERER_CONTENT_SETTINGS_OBSERVER_H_
 #define BRAVE_RENDERER_CONTENT_SETTINGS_OBSERVER_H_
 
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_set.h"
 #include "base/strings/string16.h"
+#include "base/timer/timer.h"
+#include "brave/renderer/brave_fingerprinting_rules_matcher.h"
 #include "chrome/renderer/content_settings_observer.h"
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_types.h"
+#include "url/gurl.h"
+#include "url/origin.h"
 
 namespace blink {
 class WebLocalFrame;
@@ -40,34 +52,84 @@ class BraveContentSettingsObserver
     const base::string16& details);
 
  private:
+  // Decisions cached for the current document
+  enum DecisionType {
+    DECISION_SHIELDS_DOWN,
+    DECISION_SCRIPT,
+    DECISION_FINGERPRINTING,
+  };
+
   GURL GetOriginOrURL(const blink::WebFrame* frame);
 
-  ContentSetting GetFPContentSettingFromRules(
-      const ContentSettingsForOneType& rules,
-      const blink::WebFrame* frame,
-      const GURL& secondary_url);
+  // URLs every script and fingerprinting check is made against, worked out
+  // once per committed document rather than from the frame on each check.
+  const GURL& GetDocumentOriginURL();
+  GURL GetPrimaryURL();
+  void UpdateDocumentURLs();
 
-  bool IsBraveShieldsDown(
-      const blink::WebFrame* frame,
-      const GURL& secondary_url);
+  bool GetCachedDecision(DecisionType type,
+                         const GURL& secondary_url,
+                         bool* allow);
+  void CacheDecision(DecisionType type,
+                     const GURL& secondary_url,
+                     bool allow);
+  void ClearDecisionsCache();
+
+  bool IsBraveShieldsDown(const GURL& secondary_url);
 
   // RenderFrameObserver
   bool OnMessageReceived(const IPC::Message& message) override;
   void OnAllowScriptsOnce(const std::vector<std::string>& origins);
+  void OnContentSettingRulesChanged();
+  void WillCommitProvisionalLoad() override;
   void DidCommitProvisionalLoad(bool is_same_document_navigation,
                                 ui::PageTransition transition) override;
+  void DidFinishLoad() override;
+
+  // Blocked scripts and fingerprinting attempts are reported once per
+  // document, batched on a short timer, at the end of the load and before
+  // the next document commits.
+  void ScheduleSendBlockedContent();
+  void SendBlockedContent();
 
   bool IsScriptTemporilyAllowed(const GURL& script_url);
 
   // Origins of scripts which are temporary allowed for this frame in the
   // current load
-  base::flat_set<std::string> temporarily_allowed_scripts_;
+  base::flat_set<url::Origin> temporarily_allowed_scripts_;
 
   // cache blocked script url which will later be used in `DidNotAllowScript()`
   GURL blocked_script_url_;
 
   // temporary allowed script origins we preloaded for the next load
-  base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
+  base::flat_set<url::Origin> preloaded_temporarily_allowed_scripts_;
+
+  // Set once |document_origin_url_| and |top_origin_url_| are up to date
+  // for the current document
+  bool document_urls_valid_;
+  // Origin of the current document, as a URL
+  GURL document_origin_url_;
+  // Origin of the top frame, empty when it is opaque and the top document
+  // URL is used instead
+  GURL top_origin_url_;
+
+  BraveFingerprintingRulesMatcher fingerprinting_rules_matcher_;
+
+  // Keyed by the origin of the secondary url, so repeat checks for scripts
+  // and fingerprinting APIs from the same origin skip the rule scans
+  std::map<std::pair<DecisionType, GURL>, bool> decisions_cache_;
+  // Rules version the cached decisions were made with. The rules are
+  // overwritten in place by the render thread, so a newer version drops the
+  // cache.
+  uint64_t decisions_cache_rules_version_;
+
+  // Everything reported for the current document, and what is still waiting
+  // to be sent to the browser
+  base::flat_set<base::string16> reported_blocked_javascript_;
+  base::flat_set<base::string16> reported_blocked_fingerprinting_;
+  std::vector<base::string16> pending_blocked_javascript_;
+  std::vector<base::string16> pending_blocked_fingerprinting_;
+  base::OneShotTimer send_blocked_content_timer_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsObserver);
 };
@@ -0,0 +1,108 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/renderer/brave_fingerprinting_rules_matcher.h"
+
+#include "base/logging.h"
+#include "base/no_destructor.h"
+
+namespace {
+
+const ContentSettingsPattern& GetFirstPartyPlaceholder() {
+  static const base::NoDestructor<ContentSettingsPattern> pattern(
+      ContentSettingsPattern::FromString("https://firstParty/*"));
+  return *pattern;
+}
+
+}  // namespace
+
+BraveFingerprintingRulesMatcher::BraveFingerprintingRulesMatcher()
+    : built_(false),
+      last_setting_(CONTENT_SETTING_DEFAULT) {
+}
+
+BraveFingerprintingRulesMatcher::~BraveFingerprintingRulesMatcher() {
+}
+
+bool BraveFingerprintingRulesMatcher::IsBuiltFrom(
+    const ContentSettingsForOneType& rules) const {
+  // |rules_| also holds the appended first party rule
+  if (!built_ || rules_.size() != rules.size() + 1)
+    return false;
+
+  for (size_t i = 0; i < rules.size(); ++i) {
+    if (rules_[i].setting != rules[i].GetContentSetting() ||
+        rules_[i].primary_pattern != rules[i].primary_pattern ||
+        rules_[i].secondary_pattern != rules[i].secondary_pattern)
+      return false;
+  }
+  return true;
+}
+
+void BraveFingerprintingRulesMatcher::Update(
+    const ContentSettingsForOneType& rules) {
+  if (IsBuiltFrom(rules))
+    return;
+
+  const ContentSettingsPattern& placeholder = GetFirstPartyPlaceholder();
+  rules_.clear();
+  rules_.reserve(rules.size() + 1);
+  for (const auto& rule : rules) {
+    rules_.push_back({ rule.primary_pattern,
+                       rule.secondary_pattern,
+                       rule.secondary_pattern == placeholder,
+                       rule.GetContentSetting() });
+  }
+  rules_.push_back({ ContentSettingsPattern::Wildcard(),
+                     placeholder,
+                     true,
+                     CONTENT_SETTING_ALLOW });
+
+  built_ = true;
+  last_primary_url_ = GURL();
+  last_secondary_url_ = GURL();
+}
+
+const ContentSettingsPattern&
+BraveFingerprintingRulesMatcher::GetFirstPartyPattern(
+    const GURL& primary_url) {
+  const std::string host = primary_url.HostNoBrackets();
+  if (first_party_pattern_.IsValid() && host == first_party_host_)
+    return first_party_pattern_;
+
+  first_party_host_ = host;
+  first_party_pattern_ = ContentSettingsPattern::FromString("[*.]" + host);
+  return first_party_pattern_;
+}
+
+ContentSetting BraveFingerprintingRulesMatcher::GetContentSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url) {
+  DCHECK(built_);
+  if (!last_primary_url_.is_empty() &&
+      primary_url == last_primary_url_ &&
+      secondary_url == last_secondary_url_)
+    return last_setting_;
+
+  // for cases which are third party resources and doesn't match any existing
+  // rules, block them by default
+  ContentSetting setting = CONTENT_SETTING_BLOCK;
+  for (const auto& rule : rules_) {
+    const ContentSettingsPattern& secondary_pattern = rule.is_first_party ?
+        GetFirstPartyPattern(primary_url) : rule.secondary_pattern;
+
+    if (rule.primary_pattern.Matches(primary_url) &&
+        (secondary_pattern == ContentSettingsPattern::Wildcard() ||
+         secondary_pattern.Matches(secondary_url))) {
+      setting = rule.setting;
+      break;
+    }
+  }
+
+  last_primary_url_ = primary_url;
+  last_secondary_url_ = secondary_url;
+  last_setting_ = setting;
+  return setting;
+}
@@ -0,0 +1,64 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_RENDERER_BRAVE_FINGERPRINTING_RULES_MATCHER_H_
+#define BRAVE_RENDERER_BRAVE_FINGERPRINTING_RULES_MATCHER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "url/gurl.h"
+
+// Matches fingerprinting rules without parsing patterns per check. The rules
+// are copied once into a frame independent form, with the
+// "https://firstParty/*" placeholder flagged rather than compared, and the
+// resolved first party pattern is kept for the last top level host. A rule
+// allowing first party fingerprinting is always appended after |rules|.
+class BraveFingerprintingRulesMatcher {
+ public:
+  BraveFingerprintingRulesMatcher();
+  ~BraveFingerprintingRulesMatcher();
+
+  // Rebuilds the matcher when |rules| differ from the ones it was built from.
+  // The rules are updated in place by the render thread, so this compares
+  // the already parsed patterns rather than relying on a notification.
+  void Update(const ContentSettingsForOneType& rules);
+
+  // Returns the setting of the first rule matching |primary_url| and
+  // |secondary_url|, or CONTENT_SETTING_BLOCK for third party resources no
+  // rule matches.
+  ContentSetting GetContentSetting(const GURL& primary_url,
+                                   const GURL& secondary_url);
+
+ private:
+  struct Rule {
+    ContentSettingsPattern primary_pattern;
+    ContentSettingsPattern secondary_pattern;
+    bool is_first_party;
+    ContentSetting setting;
+  };
+
+  bool IsBuiltFrom(const ContentSettingsForOneType& rules) const;
+  const ContentSettingsPattern& GetFirstPartyPattern(const GURL& primary_url);
+
+  bool built_;
+  std::vector<Rule> rules_;
+
+  std::string first_party_host_;
+  ContentSettingsPattern first_party_pattern_;
+
+  // Fingerprinting checks repeat for the same document, so the last answer
+  // is kept until the urls or the rules change
+  GURL last_primary_url_;
+  GURL last_secondary_url_;
+  ContentSetting last_setting_;
+
+  DISALLOW_COPY_AND_ASSIGN(BraveFingerprintingRulesMatcher);
+};
+
+#endif  // BRAVE_RENDERER_BRAVE_FINGERPRINTING_RULES_MATCHER_H_
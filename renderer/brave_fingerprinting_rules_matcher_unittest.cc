@@ -0,0 +1,86 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/renderer/brave_fingerprinting_rules_matcher.h"
+
+#include <string>
+
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveFingerprintingRulesMatcherTest.*
+
+namespace {
+
+ContentSettingPatternSource CreateRule(const std::string& primary_pattern,
+                                       const std::string& secondary_pattern,
+                                       ContentSetting setting) {
+  return ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary_pattern),
+      ContentSettingsPattern::FromString(secondary_pattern),
+      base::Value::FromUniquePtrValue(
+          content_settings::ContentSettingToValue(setting)),
+      std::string(), false);
+}
+
+}  // namespace
+
+TEST(BraveFingerprintingRulesMatcherTest, AllowsFirstPartyByDefault) {
+  BraveFingerprintingRulesMatcher matcher;
+  matcher.Update(ContentSettingsForOneType());
+
+  const GURL primary_url("https://brave.com/");
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+      matcher.GetContentSetting(primary_url, GURL("https://brave.com/")));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+      matcher.GetContentSetting(primary_url,
+                                GURL("https://cdn.brave.com/")));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+      matcher.GetContentSetting(primary_url, GURL("https://example.com/")));
+
+  // The first party pattern follows the top level host
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+      matcher.GetContentSetting(GURL("https://example.com/"),
+                                GURL("https://example.com/")));
+}
+
+TEST(BraveFingerprintingRulesMatcherTest, UsesFirstMatchingRule) {
+  ContentSettingsForOneType rules;
+  rules.push_back(CreateRule("[*.]brave.com", "https://firstParty/*",
+                             CONTENT_SETTING_BLOCK));
+  rules.push_back(CreateRule("[*.]example.com", "*",
+                             CONTENT_SETTING_ALLOW));
+
+  BraveFingerprintingRulesMatcher matcher;
+  matcher.Update(rules);
+
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+      matcher.GetContentSetting(GURL("https://brave.com/"),
+                                GURL("https://brave.com/")));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+      matcher.GetContentSetting(GURL("https://example.com/"),
+                                GURL("https://tracker.com/")));
+}
+
+TEST(BraveFingerprintingRulesMatcherTest, RebuildsWhenRulesChange) {
+  ContentSettingsForOneType rules;
+  BraveFingerprintingRulesMatcher matcher;
+  matcher.Update(rules);
+
+  const GURL primary_url("https://brave.com/");
+  const GURL secondary_url("https://tracker.com/");
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+      matcher.GetContentSetting(primary_url, secondary_url));
+
+  rules.push_back(CreateRule("[*.]brave.com", "*", CONTENT_SETTING_ALLOW));
+  matcher.Update(rules);
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+      matcher.GetContentSetting(primary_url, secondary_url));
+
+  rules[0] = CreateRule("[*.]brave.com", "*", CONTENT_SETTING_BLOCK);
+  matcher.Update(rules);
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+      matcher.GetContentSetting(primary_url, secondary_url));
+}
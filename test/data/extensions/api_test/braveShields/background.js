@@ -10,5 +10,16 @@ chrome.test.runTests([
       chrome.test.fail();
     }
   },
+  function braveShieldsGetShieldsState() {
+    chrome.tabs.query({active: true, currentWindow: true}, (tabs) => {
+      chrome.braveShields.getShieldsState(tabs[0].id, (state) => {
+        if (state && state.id === tabs[0].id && state.blockedCounts) {
+          chrome.test.succeed();
+        } else {
+          chrome.test.fail();
+        }
+      });
+    });
+  },
 ]);
 
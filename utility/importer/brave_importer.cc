@@ -54,7 +54,7 @@
 
 using base::Time;
 
-BraveImporter::BraveImporter() {
+BraveImporter::BraveImporter() : session_store_parsed_(false) {
 }
 
 BraveImporter::~BraveImporter() {
@@ -64,10 +64,16 @@ void BraveImporter::StartImport(const importer::SourceProfile& source_profile,
     uint16_t items, ImporterBridge* bridge) {
   bridge_ = bridge;
   source_path_ = source_profile.source_path;
+  session_store_.reset();
+  session_store_parsed_ = false;
 
   // The order here is important!
   bridge_->NotifyStarted();
 
+  // Cookies are read concurrently with the items before them. Favicons are
+  // not imported from browser-laptop.
+  StartReadingItems(items & importer::COOKIES);
+
   // NOTE: Some data is always imported (not configurable by user)
   // If data isn't found, settings are cleared or defaulted.
   ImportRequiredItems();
@@ -108,14 +114,18 @@ void BraveImporter::StartImport(const importer::SourceProfile& source_profile,
     bridge_->NotifyItemEnded(importer::WINDOWS);
   }
 
-  if ((items & importer::LEDGER) && !cancelled()) {
-    // `ImportLedger` returns true if "importable"
-    if (ImportLedger()) {
-      // NOTE: RecoverWallet is async.
-      // Its handler will call NotifyItemEnded/NotifyEnded
-      bridge_->NotifyItemStarted(importer::LEDGER);
-      return;
-    }
+  // `ImportLedger` returns true if "importable"
+  const bool import_ledger =
+      (items & importer::LEDGER) && !cancelled() && ImportLedger();
+
+  // Every item has been read from the session store by now
+  session_store_.reset();
+
+  if (import_ledger) {
+    // NOTE: RecoverWallet is async.
+    // Its handler will call NotifyItemEnded/NotifyEnded
+    bridge_->NotifyItemStarted(importer::LEDGER);
+    return;
   }
 
   bridge_->NotifyEnded();
@@ -129,8 +139,7 @@ void BraveImporter::ImportRequiredItems() {
 }
 
 void BraveImporter::ImportHistory() {
-  base::Optional<base::Value> session_store_json = ParseBraveStateFile(
-      "session-store-1");
+  const base::Value* session_store_json = GetSessionStore();
   if (!session_store_json)
     return;
 
@@ -181,18 +190,17 @@ void BraveImporter::ImportHistory() {
 
 void BraveImporter::ParseBookmarks(
     std::vector<ImportedBookmarkEntry>* bookmarks) {
-  base::Optional<base::Value> session_store_json = ParseBraveStateFile(
-      "session-store-1");
+  const base::Value* session_store_json = GetSessionStore();
   if (!session_store_json)
     return;
 
-  base::Value* bookmark_folders_dict =
+  const base::Value* bookmark_folders_dict =
     session_store_json->FindKeyOfType("bookmarkFolders",
                                       base::Value::Type::DICTIONARY);
-  base::Value* bookmarks_dict =
+  const base::Value* bookmarks_dict =
     session_store_json->FindKeyOfType("bookmarks",
                                       base::Value::Type::DICTIONARY);
-  base::Value* bookmark_order_dict =
+  const base::Value* bookmark_order_dict =
     session_store_json->FindPathOfType({"cache", "bookmarkOrder"},
     base::Value::Type::DICTIONARY);
   if (!(bookmark_folders_dict && bookmarks_dict && bookmark_order_dict))
@@ -225,22 +233,22 @@ void BraveImporter::RecursiveReadBookmarksFolder(
   const std::string key,
   std::vector<base::string16> path,
   const bool in_toolbar,
-  base::Value* bookmark_folders_dict,
-  base::Value* bookmarks_dict,
-  base::Value* bookmark_order_dict,
+  const base::Value* bookmark_folders_dict,
+  const base::Value* bookmarks_dict,
+  const base::Value* bookmark_order_dict,
   std::vector<ImportedBookmarkEntry>* bookmarks) {
   // Add the name of the current folder to the path
   path.push_back(name);
 
-  base::Value* bookmark_order =
+  const base::Value* bookmark_order =
     bookmark_order_dict->FindKeyOfType(key, base::Value::Type::LIST);
   if (!bookmark_order)
     return;
 
-  for (auto& entry : bookmark_order->GetList()) {
-    base::Value* typeValue = entry.FindKeyOfType("type",
+  for (const auto& entry : bookmark_order->GetList()) {
+    const base::Value* typeValue = entry.FindKeyOfType("type",
         base::Value::Type::STRING);
-    base::Value* keyValue = entry.FindKeyOfType("key",
+    const base::Value* keyValue = entry.FindKeyOfType("key",
         base::Value::Type::STRING);
     if (!(typeValue && keyValue))
       continue;
@@ -249,13 +257,13 @@ void BraveImporter::RecursiveReadBookmarksFolder(
     auto key = keyValue->GetString();
 
     if (type == "bookmark-folder") {
-      base::Value* bookmark_folder =
+      const base::Value* bookmark_folder =
         bookmark_folders_dict->FindKeyOfType(key,
           base::Value::Type::DICTIONARY);
       if (!bookmark_folder)
         continue;
 
-      base::Value* titleValue = bookmark_folder->FindKeyOfType("title",
+      const base::Value* titleValue = bookmark_folder->FindKeyOfType("title",
           base::Value::Type::STRING);
       if (!titleValue)
         continue;
@@ -264,7 +272,7 @@ void BraveImporter::RecursiveReadBookmarksFolder(
 
       // Empty folders don't have a corresponding entry in bookmark_order_dict,
       // which provides an easy way to test whether a folder is empty.
-      base::Value* bookmark_order_entry =
+      const base::Value* bookmark_order_entry =
         bookmark_order_dict->FindKeyOfType(key, base::Value::Type::LIST);
 
       if (bookmark_order_entry) {
@@ -290,14 +298,14 @@ void BraveImporter::RecursiveReadBookmarksFolder(
         bookmarks->push_back(imported_bookmark_folder);
       }
     } else if (type == "bookmark") {
-      base::Value* bookmark =
+      const base::Value* bookmark =
         bookmarks_dict->FindKeyOfType(key, base::Value::Type::DICTIONARY);
       if (!bookmark)
         continue;
 
-      base::Value* titleValue = bookmark->FindKeyOfType("title",
+      const base::Value* titleValue = bookmark->FindKeyOfType("title",
           base::Value::Type::STRING);
-      base::Value* locationValue = bookmark->FindKeyOfType("location",
+      const base::Value* locationValue = bookmark->FindKeyOfType("location",
           base::Value::Type::STRING);
       if (!(titleValue && locationValue))
         continue;
@@ -347,19 +355,26 @@ base::Optional<base::Value> BraveImporter::ParseBraveStateFile(
   return session_store_json;
 }
 
+const base::Value* BraveImporter::GetSessionStore() {
+  if (!session_store_parsed_) {
+    session_store_ = ParseBraveStateFile("session-store-1");
+    session_store_parsed_ = true;
+  }
+  return session_store_ ? &*session_store_ : nullptr;
+}
+
 void BraveImporter::ImportStats() {
-  base::Optional<base::Value> session_store_json = ParseBraveStateFile(
-      "session-store-1");
+  const base::Value* session_store_json = GetSessionStore();
   if (!session_store_json)
     return;
 
-  base::Value* adblock_count =
+  const base::Value* adblock_count =
     session_store_json->FindPathOfType({"adblock", "count"},
                                        base::Value::Type::INTEGER);
-  base::Value* trackingProtection_count =
+  const base::Value* trackingProtection_count =
     session_store_json->FindPathOfType({"trackingProtection", "count"},
                                        base::Value::Type::INTEGER);
-  base::Value* httpsEverywhere_count =
+  const base::Value* httpsEverywhere_count =
     session_store_json->FindPathOfType({"httpsEverywhere", "count"},
                                        base::Value::Type::INTEGER);
 
@@ -624,8 +639,7 @@ bool ParsePinnedSites(BraveLedger* ledger,
 }
 
 bool BraveImporter::ImportLedger() {
-  base::Optional<base::Value> session_store_json = ParseBraveStateFile(
-      "session-store-1");
+  const base::Value* session_store_json = GetSessionStore();
   base::Optional<base::Value> ledger_state_json = ParseBraveStateFile(
       "ledger-state.json");
   if (!(session_store_json && ledger_state_json)) {
@@ -668,8 +682,7 @@ bool BraveImporter::ImportLedger() {
 }
 
 void BraveImporter::ImportReferral() {
-  base::Optional<base::Value> session_store_json = ParseBraveStateFile(
-      "session-store-1");
+  const base::Value* session_store_json = GetSessionStore();
   if (!session_store_json) {
     return;
   }
@@ -851,15 +864,14 @@ std::vector<ImportedBrowserTab> ParsePinnedTabs(
 }
 
 void BraveImporter::ImportWindows() {
-  base::Optional<base::Value> session_store_json = ParseBraveStateFile(
-      "session-store-1");
+  const base::Value* session_store_json = GetSessionStore();
   if (!session_store_json)
     return;
 
-  base::Value* perWindowState =
+  const base::Value* perWindowState =
     session_store_json->FindKeyOfType("perWindowState",
                                       base::Value::Type::LIST);
-  base::Value* pinnedSites =
+  const base::Value* pinnedSites =
     session_store_json->FindKeyOfType("pinnedSites",
                                       base::Value::Type::DICTIONARY);
   if (!(perWindowState && pinnedSites)) {
@@ -883,8 +895,7 @@ void BraveImporter::ImportWindows() {
 }
 
 void BraveImporter::ImportSettings() {
-  base::Optional<base::Value> session_store_json = ParseBraveStateFile(
-      "session-store-1");
+  const base::Value* session_store_json = GetSessionStore();
   if (!session_store_json) {
     return;
   }
@@ -44,17 +44,25 @@ class BraveImporter : public ChromeImporter {
   base::Optional<base::Value> ParseBraveStateFile(
     const std::string& filename);
 
+  // Returns session-store-1, which is read and parsed the first time an item
+  // needs it and then shared by every item imported, or nullptr if it could
+  // not be parsed.
+  const base::Value* GetSessionStore();
+
   void ParseBookmarks(std::vector<ImportedBookmarkEntry>* bookmarks);
   void RecursiveReadBookmarksFolder(
     const base::string16 name,
     const std::string key,
     std::vector<base::string16> path,
     const bool in_toolbar,
-    base::Value* bookmark_folders_dict,
-    base::Value* bookmarks_dict,
-    base::Value* bookmark_order_dict,
+    const base::Value* bookmark_folders_dict,
+    const base::Value* bookmarks_dict,
+    const base::Value* bookmark_order_dict,
     std::vector<ImportedBookmarkEntry>* bookmarks);
 
+  base::Optional<base::Value> session_store_;
+  bool session_store_parsed_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveImporter);
 };
 
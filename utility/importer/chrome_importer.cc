@@ -5,15 +5,23 @@
 
 #include "brave/utility/importer/chrome_importer.h"
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/run_loop.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/atomic_flag.h"
+#include "base/task/post_task.h"
 #include "base/values.h"
 #include "brave/utility/importer/brave_external_process_importer_bridge.h"
 #include "build/build_config.h"
@@ -57,12 +65,168 @@ base::nix::DesktopEnvironment ChromeImporter::GetDesktopEnvironment() {
 
 using base::Time;
 
-ChromeImporter::ChromeImporter() {
+namespace {
+
+// Each chunk is added to history by the browser as a single write
+const size_t kHistoryRowsPerChunk = 1000;
+
+// Multiple URLs can share the same favicon; this is a map
+// of URLs -> IconIDs that we load as a temporary step before
+// actually loading the icons.
+typedef std::map<int64_t, std::set<GURL>> FaviconMap;
+
+// Set on the import thread when the import is cancelled, and checked by the
+// reads running on the thread pool.
+using ReadCancelledFlag = base::RefCountedData<base::AtomicFlag>;
+
+// Loads the urls associated with the favicons into favicon_map
+void ImportFaviconURLs(sql::Database* db,
+                       const ReadCancelledFlag* cancelled,
+                       FaviconMap* favicon_map) {
+  const char query[] = "SELECT icon_id, page_url FROM icon_mapping;";
+  sql::Statement s(db->GetUniqueStatement(query));
+
+  while (s.Step() && !cancelled->data.IsSet()) {
+    int64_t icon_id = s.ColumnInt64(0);
+    GURL url = GURL(s.ColumnString(1));
+    (*favicon_map)[icon_id].insert(url);
+  }
+}
+
+// Loads and reencodes the individual favicons
+void LoadFaviconData(sql::Database* db,
+                     const FaviconMap& favicon_map,
+                     favicon_base::FaviconUsageDataList* favicons) {
+  const char query[] = "SELECT f.url, fb.image_data "
+                       "FROM favicons f "
+                       "JOIN favicon_bitmaps fb "
+                       "ON f.id = fb.icon_id "
+                       "WHERE f.id = ?;";
+  sql::Statement s(db->GetUniqueStatement(query));
+
+  if (!s.is_valid())
+    return;
+
+  for (FaviconMap::const_iterator i = favicon_map.begin();
+       i != favicon_map.end(); ++i) {
+    s.BindInt64(0, i->first);
+    if (s.Step()) {
+      favicon_base::FaviconUsageData usage;
+
+      usage.favicon_url = GURL(s.ColumnString(0));
+      if (!usage.favicon_url.is_valid())
+        continue;  // Don't bother importing favicons with invalid URLs.
+
+      std::vector<unsigned char> data;
+      s.ColumnBlobAsVector(1, &data);
+      if (data.empty())
+        continue;  // Data definitely invalid.
+
+      if (!importer::ReencodeFavicon(&data[0], data.size(), &usage.png_data))
+        continue;  // Unable to decode.
+
+      usage.urls = i->second;
+      favicons->push_back(usage);
+    }
+    s.Reset(true);
+  }
+}
+
+favicon_base::FaviconUsageDataList ReadFavicons(
+    const base::FilePath& source_path,
+    scoped_refptr<ReadCancelledFlag> cancelled) {
+  favicon_base::FaviconUsageDataList favicons;
+  base::FilePath favicons_path =
+    source_path.Append(
+      base::FilePath::StringType(FILE_PATH_LITERAL("Favicons")));
+  if (!base::PathExists(favicons_path))
+    return favicons;
+
+  sql::Database db;
+  if (!db.Open(favicons_path))
+    return favicons;
+
+  FaviconMap favicon_map;
+  ImportFaviconURLs(&db, cancelled.get(), &favicon_map);
+  if (!favicon_map.empty() && !cancelled->data.IsSet())
+    LoadFaviconData(&db, favicon_map, &favicons);
+  return favicons;
+}
+
+std::vector<net::CanonicalCookie> ReadCookies(
+    const base::FilePath& source_path,
+    scoped_refptr<ReadCancelledFlag> cancelled) {
+  std::vector<net::CanonicalCookie> cookies;
+  base::FilePath cookies_path =
+    source_path.Append(
+      base::FilePath::StringType(FILE_PATH_LITERAL("Cookies")));
+  if (!base::PathExists(cookies_path))
+    return cookies;
+
+  sql::Database db;
+  if (!db.Open(cookies_path))
+    return cookies;
+
+  const char query[] =
+    "SELECT creation_utc, host_key, name, value, encrypted_value, path, "
+    "expires_utc, is_secure, is_httponly, firstpartyonly, last_access_utc, "
+    "has_expires, is_persistent, priority FROM cookies";
+
+  sql::Statement s(db.GetUniqueStatement(query));
+
+  net::CookieCryptoDelegate* delegate =
+    cookie_config::GetCookieCryptoDelegate();
+#if defined(OS_LINUX)
+  OSCrypt::SetConfig(std::make_unique<os_crypt::Config>());
+#endif
+
+  while (s.Step() && !cancelled->data.IsSet()) {
+    std::string encrypted_value = s.ColumnString(4);
+    std::string value;
+    if (!encrypted_value.empty() && delegate) {
+      if (!delegate->DecryptString(encrypted_value, &value)) {
+        continue;
+      }
+    } else {
+      value = s.ColumnString(3);
+    }
+
+    auto cookie = net::CanonicalCookie(
+        s.ColumnString(2),                           // name
+        value,                                       // value
+        s.ColumnString(1),                           // domain
+        s.ColumnString(5),                           // path
+        Time::FromInternalValue(s.ColumnInt64(0)),   // creation_utc
+        Time::FromInternalValue(s.ColumnInt64(6)),   // expires_utc
+        Time::FromInternalValue(s.ColumnInt64(10)),  // last_access_utc
+        s.ColumnBool(7),                             // secure
+        s.ColumnBool(8),                             // http_only
+        static_cast<net::CookieSameSite>(s.ColumnInt(9)),    // samesite
+        static_cast<net::CookiePriority>(s.ColumnInt(13)));  // priority
+    if (cookie.IsCanonical()) {
+      cookies.push_back(cookie);
+    }
+  }
+
+  return cookies;
+}
+
+}  // namespace
+
+ChromeImporter::ChromeImporter()
+    : read_cancelled_(base::MakeRefCounted<ReadCancelledFlag>()),
+      favicons_read_state_(READ_NOT_STARTED),
+      cookies_read_state_(READ_NOT_STARTED) {
 }
 
 ChromeImporter::~ChromeImporter() {
 }
 
+void ChromeImporter::Cancel() {
+  Importer::Cancel();
+  read_cancelled_->data.Set();
+}
+
 void ChromeImporter::StartImport(const importer::SourceProfile& source_profile,
                                   uint16_t items,
                                   ImporterBridge* bridge) {
@@ -72,6 +236,9 @@ void ChromeImporter::StartImport(const importer::SourceProfile& source_profile,
   // The order here is important!
   bridge_->NotifyStarted();
 
+  // Favicons and cookies are read concurrently with the other items
+  StartReadingItems(items);
+
   if ((items & importer::HISTORY) && !cancelled()) {
     bridge_->NotifyItemStarted(importer::HISTORY);
     ImportHistory();
@@ -110,13 +277,15 @@ void ChromeImporter::ImportHistory() {
   if (!db.Open(history_path))
     return;
 
+  // One row per URL, last visited at its most recent qualifying visit
   const char query[] =
-    "SELECT u.url, u.title, v.visit_time, u.typed_count, u.visit_count "
+    "SELECT u.url, u.title, MAX(v.visit_time), u.typed_count, u.visit_count "
     "FROM urls u JOIN visits v ON u.id = v.url "
     "WHERE hidden = 0 "
     "AND (transition & ?) != 0 "  // CHAIN_END
-    "AND (transition & ?) NOT IN (?, ?, ?)";  // No SUBFRAME or
+    "AND (transition & ?) NOT IN (?, ?, ?) "  // No SUBFRAME or
                                               // KEYWORD_GENERATED
+    "GROUP BY u.id";
 
   sql::Statement s(db.GetUniqueStatement(query));
   s.BindInt(0, ui::PAGE_TRANSITION_CHAIN_END);
@@ -125,7 +294,10 @@ void ChromeImporter::ImportHistory() {
   s.BindInt(3, ui::PAGE_TRANSITION_MANUAL_SUBFRAME);
   s.BindInt(4, ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 
+  // Rows are sent in chunks as they are read, so that large profiles are
+  // neither held in memory at once nor written to history in one go
   std::vector<ImporterURLRow> rows;
+  rows.reserve(kHistoryRowsPerChunk);
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
 
@@ -138,6 +310,11 @@ void ChromeImporter::ImportHistory() {
     row.visit_count = s.ColumnInt(4);
 
     rows.push_back(row);
+
+    if (rows.size() == kHistoryRowsPerChunk) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      rows.clear();
+    }
   }
 
   if (!rows.empty() && !cancelled())
@@ -187,76 +364,17 @@ void ChromeImporter::ImportBookmarks() {
   }
 
   // Import favicons.
-  base::FilePath favicons_path =
-    source_path_.Append(
-      base::FilePath::StringType(FILE_PATH_LITERAL("Favicons")));
-  if (!base::PathExists(favicons_path))
-    return;
-
-  sql::Database db;
-  if (!db.Open(favicons_path))
-    return;
-
-  FaviconMap favicon_map;
-  ImportFaviconURLs(&db, &favicon_map);
+  favicon_base::FaviconUsageDataList favicons;
+  if (favicons_read_state_ != READ_NOT_STARTED) {
+    RunUntilRead(&favicons_read_state_);
+    favicons = std::move(favicons_);
+    favicons_read_state_ = READ_NOT_STARTED;
+  } else {
+    favicons = ReadFavicons(source_path_, read_cancelled_);
+  }
   // Write favicons into profile.
-  if (!favicon_map.empty() && !cancelled()) {
-    favicon_base::FaviconUsageDataList favicons;
-    LoadFaviconData(&db, favicon_map, &favicons);
+  if (!favicons.empty() && !cancelled())
     bridge_->SetFavicons(favicons);
-  }
-}
-
-void ChromeImporter::ImportFaviconURLs(
-  sql::Database* db,
-  FaviconMap* favicon_map) {
-  const char query[] = "SELECT icon_id, page_url FROM icon_mapping;";
-  sql::Statement s(db->GetUniqueStatement(query));
-
-  while (s.Step() && !cancelled()) {
-    int64_t icon_id = s.ColumnInt64(0);
-    GURL url = GURL(s.ColumnString(1));
-    (*favicon_map)[icon_id].insert(url);
-  }
-}
-
-void ChromeImporter::LoadFaviconData(
-    sql::Database* db,
-    const FaviconMap& favicon_map,
-    favicon_base::FaviconUsageDataList* favicons) {
-  const char query[] = "SELECT f.url, fb.image_data "
-                       "FROM favicons f "
-                       "JOIN favicon_bitmaps fb "
-                       "ON f.id = fb.icon_id "
-                       "WHERE f.id = ?;";
-  sql::Statement s(db->GetUniqueStatement(query));
-
-  if (!s.is_valid())
-    return;
-
-  for (FaviconMap::const_iterator i = favicon_map.begin();
-       i != favicon_map.end(); ++i) {
-    s.BindInt64(0, i->first);
-    if (s.Step()) {
-      favicon_base::FaviconUsageData usage;
-
-      usage.favicon_url = GURL(s.ColumnString(0));
-      if (!usage.favicon_url.is_valid())
-        continue;  // Don't bother importing favicons with invalid URLs.
-
-      std::vector<unsigned char> data;
-      s.ColumnBlobAsVector(1, &data);
-      if (data.empty())
-        continue;  // Data definitely invalid.
-
-      if (!importer::ReencodeFavicon(&data[0], data.size(), &usage.png_data))
-        continue;  // Unable to decode.
-
-      usage.urls = i->second;
-      favicons->push_back(usage);
-    }
-    s.Reset(true);
-  }
 }
 
 void ChromeImporter::RecursiveReadBookmarksFolder(
@@ -403,59 +521,59 @@ void ChromeImporter::ImportPasswords(const base::FilePath& prefs_filename) {
 }
 
 void ChromeImporter::ImportCookies() {
-  base::FilePath cookies_path =
-    source_path_.Append(
-      base::FilePath::StringType(FILE_PATH_LITERAL("Cookies")));
-  if (!base::PathExists(cookies_path))
-    return;
+  std::vector<net::CanonicalCookie> cookies;
+  if (cookies_read_state_ != READ_NOT_STARTED) {
+    RunUntilRead(&cookies_read_state_);
+    cookies = std::move(cookies_);
+    cookies_read_state_ = READ_NOT_STARTED;
+  } else {
+    cookies = ReadCookies(source_path_, read_cancelled_);
+  }
 
-  sql::Database db;
-  if (!db.Open(cookies_path))
-    return;
+  if (!cookies.empty() && !cancelled()) {
+    bridge_->SetCookies(cookies);
+  }
+}
 
-  const char query[] =
-    "SELECT creation_utc, host_key, name, value, encrypted_value, path, "
-    "expires_utc, is_secure, is_httponly, firstpartyonly, last_access_utc, "
-    "has_expires, is_persistent, priority FROM cookies";
+void ChromeImporter::StartReadingItems(uint16_t items) {
+  const base::TaskTraits traits = {
+      base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+      base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
 
-  sql::Statement s(db.GetUniqueStatement(query));
+  if (items & importer::FAVORITES) {
+    favicons_read_state_ = READ_PENDING;
+    base::PostTaskWithTraitsAndReplyWithResult(FROM_HERE, traits,
+        base::BindOnce(&ReadFavicons, source_path_, read_cancelled_),
+        base::BindOnce(&ChromeImporter::OnFaviconsRead, this));
+  }
 
-  net::CookieCryptoDelegate* delegate =
-    cookie_config::GetCookieCryptoDelegate();
-#if defined(OS_LINUX)
-  OSCrypt::SetConfig(std::make_unique<os_crypt::Config>());
-#endif
+  if (items & importer::COOKIES) {
+    cookies_read_state_ = READ_PENDING;
+    base::PostTaskWithTraitsAndReplyWithResult(FROM_HERE, traits,
+        base::BindOnce(&ReadCookies, source_path_, read_cancelled_),
+        base::BindOnce(&ChromeImporter::OnCookiesRead, this));
+  }
+}
 
-  std::vector<net::CanonicalCookie> cookies;
-  while (s.Step() && !cancelled()) {
-    std::string encrypted_value = s.ColumnString(4);
-    std::string value;
-    if (!encrypted_value.empty() && delegate) {
-      if (!delegate->DecryptString(encrypted_value, &value)) {
-        continue;
-      }
-    } else {
-      value = s.ColumnString(3);
-    }
+void ChromeImporter::OnFaviconsRead(
+    favicon_base::FaviconUsageDataList favicons) {
+  favicons_ = std::move(favicons);
+  favicons_read_state_ = READ_DONE;
+  if (read_done_closure_)
+    std::move(read_done_closure_).Run();
+}
 
-    auto cookie = net::CanonicalCookie(
-        s.ColumnString(2),                           // name
-        value,                                       // value
-        s.ColumnString(1),                           // domain
-        s.ColumnString(5),                           // path
-        Time::FromInternalValue(s.ColumnInt64(0)),   // creation_utc
-        Time::FromInternalValue(s.ColumnInt64(6)),   // expires_utc
-        Time::FromInternalValue(s.ColumnInt64(10)),  // last_access_utc
-        s.ColumnBool(7),                             // secure
-        s.ColumnBool(8),                             // http_only
-        static_cast<net::CookieSameSite>(s.ColumnInt(9)),    // samesite
-        static_cast<net::CookiePriority>(s.ColumnInt(13)));  // priority
-    if (cookie.IsCanonical()) {
-      cookies.push_back(cookie);
-    }
-  }
+void ChromeImporter::OnCookiesRead(std::vector<net::CanonicalCookie> cookies) {
+  cookies_ = std::move(cookies);
+  cookies_read_state_ = READ_DONE;
+  if (read_done_closure_)
+    std::move(read_done_closure_).Run();
+}
 
-  if (!cookies.empty() && !cancelled()) {
-    bridge_->SetCookies(cookies);
+void ChromeImporter::RunUntilRead(const ReadState* read_state) {
+  while (*read_state == READ_PENDING) {
+    base::RunLoop run_loop;
+    read_done_closure_ = run_loop.QuitClosure();
+    run_loop.Run();
   }
 }
@@ -7,28 +7,26 @@
 
 #include <stdint.h>
 
-#include <map>
-#include <set>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/compiler_specific.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/nix/xdg_util.h"
 #include "build/build_config.h"
 #include "chrome/utility/importer/importer.h"
 #include "components/favicon_base/favicon_usage_data.h"
+#include "net/cookies/canonical_cookie.h"
 
 struct ImportedBookmarkEntry;
 
 namespace base {
+class AtomicFlag;
 class DictionaryValue;
 }
 
-namespace sql {
-class Database;
-}
-
 class ChromeImporter : public Importer {
  public:
   ChromeImporter();
@@ -37,6 +35,7 @@ class ChromeImporter : public Importer {
   void StartImport(const importer::SourceProfile& source_profile,
                    uint16_t items,
                    ImporterBridge* bridge) override;
+  void Cancel() override;
 
  protected:
   ~ChromeImporter() override;
@@ -50,23 +49,25 @@ class ChromeImporter : public Importer {
 
   double chromeTimeToDouble(int64_t time);
 
+  // Starts reading the Favicons and Cookies files for |items| on the thread
+  // pool, so that they are read while other items are imported. The results
+  // are sent by ImportBookmarks and ImportCookies, which otherwise read the
+  // files themselves.
+  void StartReadingItems(uint16_t items);
+
   base::FilePath source_path_;
 
  private:
-  // Multiple URLs can share the same favicon; this is a map
-  // of URLs -> IconIDs that we load as a temporary step before
-  // actually loading the icons.
-  typedef std::map<int64_t, std::set<GURL>> FaviconMap;
+  enum ReadState {
+    READ_NOT_STARTED,
+    READ_PENDING,
+    READ_DONE,
+  };
 
-  // Loads the urls associated with the favicons into favicon_map;
-  void ImportFaviconURLs(
-    sql::Database* db,
-    FaviconMap* favicon_map);
-
-  // Loads and reencodes the individual favicons.
-  void LoadFaviconData(sql::Database* db,
-                       const FaviconMap& favicon_map,
-                       favicon_base::FaviconUsageDataList* favicons);
+  void OnFaviconsRead(favicon_base::FaviconUsageDataList favicons);
+  void OnCookiesRead(std::vector<net::CanonicalCookie> cookies);
+  // Runs tasks on the import thread until |read_state| is no longer pending.
+  void RunUntilRead(const ReadState* read_state);
 
   void RecursiveReadBookmarksFolder(
     const base::DictionaryValue* folder,
@@ -74,6 +75,13 @@ class ChromeImporter : public Importer {
     bool is_in_toolbar,
     std::vector<ImportedBookmarkEntry>* bookmarks);
 
+  scoped_refptr<base::RefCountedData<base::AtomicFlag>> read_cancelled_;
+  ReadState favicons_read_state_;
+  favicon_base::FaviconUsageDataList favicons_;
+  ReadState cookies_read_state_;
+  std::vector<net::CanonicalCookie> cookies_;
+  base::OnceClosure read_done_closure_;
+
   DISALLOW_COPY_AND_ASSIGN(ChromeImporter);
 };
 
@@ -11,6 +11,7 @@
 #include "base/files/scoped_temp_dir.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/path_service.h"
+#include "base/test/scoped_task_environment.h"
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/importer/imported_bookmark_entry.h"
 #include "chrome/common/importer/importer_data_types.h"
@@ -59,6 +60,8 @@ class ChromeImporterTest : public ::testing::Test {
     bridge_ = new BraveMockImporterBridge;
   }
 
+  // Items are read on the thread pool while others are imported
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
   base::ScopedTempDir temp_dir_;
   base::FilePath profile_dir_;
   importer::SourceProfile profile_;
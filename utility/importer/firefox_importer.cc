@@ -8,6 +8,8 @@
 
 #include "base/files/file_enumerator.h"
 #include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/logging.h"
 #include "base/macros.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -25,6 +27,12 @@ using base::Time;
 
 namespace brave {
 
+namespace {
+
+const size_t kCookiesPerBatch = 1000;
+
+}  // namespace
+
 FirefoxImporter::FirefoxImporter() {
 }
 
@@ -53,8 +61,30 @@ void FirefoxImporter::ImportCookies() {
     return;
   }
 
+  // Firefox may be running and writing to the database, with recent changes
+  // still in its write-ahead log. Reading a private copy of both neither
+  // contends with Firefox for locks nor misses changes not yet checkpointed.
+  base::ScopedTempDir snapshot_dir;
+  if (!snapshot_dir.CreateUniqueTempDir()) {
+    return;
+  }
+  base::FilePath snapshot = snapshot_dir.GetPath().AppendASCII(
+      "cookies.sqlite");
+  if (!base::CopyFile(file, snapshot)) {
+    LOG(ERROR) << "Could not copy " << file;
+    return;
+  }
+  base::FilePath wal_file(file.value() + FILE_PATH_LITERAL("-wal"));
+  if (base::PathExists(wal_file) &&
+      !base::CopyFile(wal_file,
+                      base::FilePath(snapshot.value() +
+                                     FILE_PATH_LITERAL("-wal")))) {
+    LOG(ERROR) << "Could not copy " << wal_file;
+    return;
+  }
+
   sql::Database db;
-  if (!db.Open(file)) {
+  if (!db.Open(snapshot)) {
     return;
   }
 
@@ -64,7 +94,9 @@ void FirefoxImporter::ImportCookies() {
 
   sql::Statement s(db.GetUniqueStatement(query));
 
+  // Cookies are sent in batches as they are read
   std::vector<net::CanonicalCookie> cookies;
+  cookies.reserve(kCookiesPerBatch);
   while (s.Step() && !cancelled()) {
     std::string domain(".");
     domain.append(s.ColumnString(0));
@@ -82,7 +114,7 @@ void FirefoxImporter::ImportCookies() {
     const Time expiry = Time::FromDoubleT(s.ColumnInt64(5));
     const Time last_accessed = Time::FromDoubleT(s.ColumnInt64(6) / 1000000);
     const Time creation = Time::FromDoubleT(s.ColumnInt64(7) / 1000000);
-    
+
     auto cookie = net::CanonicalCookie(
         s.ColumnString(1),  // name
         s.ColumnString(2),  // value
@@ -99,6 +131,11 @@ void FirefoxImporter::ImportCookies() {
     if (cookie.IsCanonical()) {
       cookies.push_back(cookie);
     }
+
+    if (cookies.size() == kCookiesPerBatch) {
+      bridge_->SetCookies(cookies);
+      cookies.clear();
+    }
   }
 
   if (!cookies.empty() && !cancelled()) {